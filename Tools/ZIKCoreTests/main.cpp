@@ -0,0 +1,101 @@
+//
+//  main.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+//  Test driver of the portable C++ core. It runs the ZIK_TEST cases of ZIKRouterTests, which also run in the XCTest bundle, so the core can be tested on macOS or Linux build machines without Xcode. Benchmarks run their measured block once.
+//
+//  Build and run with the zik-core-tests target of CMakeLists.txt:
+//  cmake -S . -B build && cmake --build build && ctest --test-dir build
+//
+//  Usage:
+//  zik-core-tests [filter ...]
+//  Only run tests whose "suite.name" contains one of the filters. Exit status is 1 when any test fails.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "ZIKCoreTest.h"
+
+using namespace zix::test;
+
+namespace {
+
+std::vector<CoreTest> &coreTests() {
+    static std::vector<CoreTest> tests;
+    return tests;
+}
+
+size_t failureCount = 0;
+
+bool matches(const std::string &name, int argc, const char *argv[]) {
+    if (argc <= 1) {
+        return true;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (name.find(argv[i]) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void zix::test::registerTest(const CoreTest &test) {
+    coreTests().push_back(test);
+}
+
+std::string zix::test::temporaryPath(const char *name) {
+    std::string directory = "/tmp";
+    const char *temporaryDirectory = getenv("TMPDIR");
+    if (temporaryDirectory && temporaryDirectory[0] != '\0') {
+        directory = temporaryDirectory;
+    }
+    if (directory.back() != '/') {
+        directory += '/';
+    }
+    return directory + name;
+}
+
+void zix::test::recordFailure(const char *file, int line, const std::string &description) {
+    failureCount++;
+    fprintf(stderr, "%s:%d: error: %s\n", file, line, description.c_str());
+}
+
+void zix::test::measure(const std::function<void()> &block) {
+    auto start = std::chrono::steady_clock::now();
+    block();
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "Measured %.3f ms.\n", milliseconds);
+}
+
+int main(int argc, const char *argv[]) {
+    size_t testCount = 0;
+    size_t failedTestCount = 0;
+    for (const CoreTest &test : coreTests()) {
+        std::string name = std::string(test.suite) + "." + test.name;
+        if (!matches(name, argc, argv)) {
+            continue;
+        }
+        size_t failures = failureCount;
+        auto start = std::chrono::steady_clock::now();
+        test.run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool passed = failureCount == failures;
+        fprintf(stderr, "Test Case '%s' %s (%.3f seconds).\n", name.c_str(), passed ? "passed" : "failed", seconds);
+        testCount++;
+        failedTestCount += !passed;
+    }
+    fprintf(stderr, "Executed %zu tests, %zu failed, with %zu failed assertions.\n", testCount, failedTestCount, failureCount);
+    return failedTestCount == 0 ? 0 : 1;
+}
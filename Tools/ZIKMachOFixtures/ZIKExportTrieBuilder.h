@@ -0,0 +1,160 @@
+//
+//  ZIKExportTrieBuilder.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKExportTrieBuilder_h
+#define ZIKExportTrieBuilder_h
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "ZIKMachOFixtureBuilder.h"
+#include "ZIKExportTrie.h"
+
+namespace zix {
+namespace test {
+
+/**
+ Build dyld export tries like the linker does: edges are compressed, nodes are laid out with parents before children, and child offsets are uleb128 values fixed by iterating until node sizes are stable.
+ */
+class ExportTrieBuilder {
+public:
+    void addSymbol(const std::string &name, uint64_t address, uint64_t flags = macho::EXPORT_SYMBOL_FLAGS_KIND_REGULAR) {
+        std::vector<uint8_t> terminal;
+        MachOFixtureBuilder::appendULEB128(terminal, flags);
+        MachOFixtureBuilder::appendULEB128(terminal, address);
+        addTerminal(name, terminal);
+    }
+
+    void addStubAndResolver(const std::string &name, uint64_t stub, uint64_t resolver) {
+        std::vector<uint8_t> terminal;
+        MachOFixtureBuilder::appendULEB128(terminal, macho::EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER);
+        MachOFixtureBuilder::appendULEB128(terminal, stub);
+        MachOFixtureBuilder::appendULEB128(terminal, resolver);
+        addTerminal(name, terminal);
+    }
+
+    /// Re-export a symbol from the dylib at library ordinal. `importName` is empty when the name is the same.
+    void addReexport(const std::string &name, uint32_t libraryOrdinal, const std::string &importName = std::string()) {
+        std::vector<uint8_t> terminal;
+        MachOFixtureBuilder::appendULEB128(terminal, macho::EXPORT_SYMBOL_FLAGS_REEXPORT);
+        MachOFixtureBuilder::appendULEB128(terminal, libraryOrdinal);
+        terminal.insert(terminal.end(), importName.begin(), importName.end());
+        terminal.push_back(0);
+        addTerminal(name, terminal);
+    }
+
+    /// Add raw terminal info for a name.
+    void addTerminal(const std::string &name, const std::vector<uint8_t> &terminal) {
+        Export exported = {name, terminal};
+        exports_.push_back(exported);
+    }
+
+    std::vector<uint8_t> build() const {
+        std::vector<Export> exports = exports_;
+        std::sort(exports.begin(), exports.end(), [](const Export &lhs, const Export &rhs) {
+            return lhs.name < rhs.name;
+        });
+        std::vector<Node> nodes(1);
+        buildNode(nodes, 0, exports, 0, exports.size(), 0);
+
+        // Offsets are uleb128, so node sizes depend on offsets
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            uint64_t offset = 0;
+            for (Node &node : nodes) {
+                if (node.offset != offset) {
+                    node.offset = offset;
+                    changed = true;
+                }
+                offset += nodeSize(nodes, node);
+            }
+        }
+        std::vector<uint8_t> trie;
+        for (const Node &node : nodes) {
+            MachOFixtureBuilder::appendULEB128(trie, node.terminal.size());
+            trie.insert(trie.end(), node.terminal.begin(), node.terminal.end());
+            trie.push_back(static_cast<uint8_t>(node.edges.size()));
+            for (const Edge &edge : node.edges) {
+                trie.insert(trie.end(), edge.label.begin(), edge.label.end());
+                trie.push_back(0);
+                MachOFixtureBuilder::appendULEB128(trie, nodes[edge.child].offset);
+            }
+        }
+        return trie;
+    }
+
+private:
+    struct Export {
+        std::string name;
+        std::vector<uint8_t> terminal;
+    };
+    struct Edge {
+        std::string label;
+        size_t child;
+    };
+    struct Node {
+        std::vector<uint8_t> terminal;
+        std::vector<Edge> edges;
+        uint64_t offset;
+    };
+
+    static size_t ulebSize(uint64_t value) {
+        std::vector<uint8_t> bytes;
+        MachOFixtureBuilder::appendULEB128(bytes, value);
+        return bytes.size();
+    }
+
+    static size_t nodeSize(const std::vector<Node> &nodes, const Node &node) {
+        size_t size = ulebSize(node.terminal.size()) + node.terminal.size() + 1;
+        for (const Edge &edge : node.edges) {
+            size += edge.label.size() + 1 + ulebSize(nodes[edge.child].offset);
+        }
+        return size;
+    }
+
+    /// Build node for sorted exports in [begin, end), which share the first `depth` characters.
+    static void buildNode(std::vector<Node> &nodes, size_t index, const std::vector<Export> &exports, size_t begin, size_t end, size_t depth) {
+        nodes[index].offset = 0;
+        size_t i = begin;
+        if (i < end && exports[i].name.size() == depth) {
+            nodes[index].terminal = exports[i].terminal;
+            i++;
+        }
+        while (i < end) {
+            // Names with the same next character go to one child
+            size_t groupEnd = i + 1;
+            while (groupEnd < end && exports[groupEnd].name[depth] == exports[i].name[depth]) {
+                groupEnd++;
+            }
+            size_t prefix = exports[i].name.size();
+            for (size_t j = i + 1; j < groupEnd; j++) {
+                size_t common = depth;
+                while (common < prefix && common < exports[j].name.size() && exports[j].name[common] == exports[i].name[common]) {
+                    common++;
+                }
+                prefix = common;
+            }
+            Edge edge = {exports[i].name.substr(depth, prefix - depth), nodes.size()};
+            nodes.push_back(Node());
+            nodes[index].edges.push_back(edge);
+            buildNode(nodes, edge.child, exports, i, groupEnd, prefix);
+            i = groupEnd;
+        }
+    }
+
+    std::vector<Export> exports_;
+};
+
+} // namespace test
+} // namespace zix
+
+#endif /* ZIKExportTrieBuilder_h */
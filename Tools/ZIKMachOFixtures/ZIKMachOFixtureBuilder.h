@@ -0,0 +1,517 @@
+//
+//  ZIKMachOFixtureBuilder.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKMachOFixtureBuilder_h
+#define ZIKMachOFixtureBuilder_h
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+namespace test {
+
+/**
+ Build synthetic Mach-O files for tests and benchmarks, so Mach-O parsers can be tested with precise layouts and broken files.
+
+ Usage:
+ 1. Add load commands and reserve sections.
+ 2. Call `layout()`, then section addresses and file offsets are fixed.
+ 3. Write section content, add symbols and linkedit data.
+ 4. Call `build()`.
+ */
+class MachOFixtureBuilder {
+public:
+    struct Symbol {
+        std::string name;
+        uint8_t type;
+        uint8_t sect;
+        uint16_t desc;
+        uint64_t value;
+    };
+
+    explicit MachOFixtureBuilder(bool is64Bit = true, uint32_t fileType = macho::MH_DYLIB, int32_t cpuType = 0x0100000c)
+    : is64Bit_(is64Bit), fileType_(fileType), cpuType_(cpuType), hasUUID_(false), laidOut_(false), headerPad_(0) {
+        memset(uuid_, 0, sizeof(uuid_));
+        addSegment("__TEXT");
+    }
+
+    void setUUID(const uint8_t uuid[16]) {
+        memcpy(uuid_, uuid, 16);
+        hasUUID_ = true;
+    }
+
+    void setInstallName(const std::string &installName) {
+        installName_ = installName;
+    }
+
+    void addDylib(const std::string &name, uint32_t cmd = macho::LC_LOAD_DYLIB) {
+        dylibs_.push_back(std::make_pair(cmd, name));
+    }
+
+    /// Add a raw load command. `payload` is the content after cmd and cmdsize.
+    void addRawLoadCommand(uint32_t cmd, const std::vector<uint8_t> &payload) {
+        rawCommands_.push_back(std::make_pair(cmd, payload));
+    }
+
+    /// Reserve a section with size. Return section id.
+    size_t reserveSection(const std::string &segname, const std::string &sectname, uint64_t size, uint32_t alignment = 8) {
+        size_t segmentIndex = addSegment(segname);
+        Section section;
+        section.segment = segmentIndex;
+        section.segname = segname;
+        section.sectname = sectname;
+        section.size = size;
+        section.alignment = alignment;
+        section.addr = 0;
+        section.offset = 0;
+        sections_.push_back(section);
+        return sections_.size() - 1;
+    }
+
+    /// Add vm size after the file content of a segment, like zero fill sections. It's not in the file, so large address ranges don't make large files. Call it before layout.
+    void addZeroFill(const std::string &segname, uint64_t size) {
+        segments_[addSegment(segname)].zeroFill += alignUp(size, 0x1000);
+    }
+
+    /// Fix addresses of segments and sections. Segments are laid out with 0x1000 page size in the order of creation, and __TEXT starts at file offset 0.
+    void layout() {
+        size_t commandsSize = estimatedCommandsSize();
+        headerPad_ = alignUp(headerSize() + commandsSize + 1024, 0x1000);
+        uint64_t vmaddr = is64Bit_ && fileType_ == macho::MH_EXECUTE ? 0x100000000ULL : 0;
+        uint64_t fileoff = 0;
+        for (size_t i = 0; i < segments_.size(); i++) {
+            Segment &segment = segments_[i];
+            segment.vmaddr = vmaddr;
+            segment.fileoff = fileoff;
+            uint64_t cursor = i == 0 ? headerPad_ : 0;
+            for (Section &section : sections_) {
+                if (section.segment != i) {
+                    continue;
+                }
+                cursor = alignUp(cursor, section.alignment);
+                section.addr = segment.vmaddr + cursor;
+                section.offset = static_cast<uint32_t>(segment.fileoff + cursor);
+                cursor += section.size;
+            }
+            segment.size = alignUp(cursor == 0 ? 1 : cursor, 0x1000);
+            vmaddr += segment.size + segment.zeroFill;
+            fileoff += segment.size;
+        }
+        linkeditVMAddr_ = vmaddr;
+        linkeditFileOffset_ = fileoff;
+        content_.assign(fileoff, 0);
+        laidOut_ = true;
+    }
+
+    uint64_t sectionAddress(size_t section) const { return sections_[section].addr; }
+    uint32_t sectionOffset(size_t section) const { return sections_[section].offset; }
+    uint64_t segmentAddress(const std::string &segname) const { return segments_[findSegment(segname)].vmaddr; }
+    uint64_t segmentFileOffset(const std::string &segname) const { return segments_[findSegment(segname)].fileoff; }
+    size_t segmentIndex(const std::string &segname) const { return findSegment(segname); }
+    uint64_t segmentAddressAtIndex(size_t index) const { return segments_[index].vmaddr; }
+    /// File offset where __LINKEDIT begins.
+    uint64_t linkeditFileOffset() const { return linkeditFileOffset_; }
+
+    /// Write bytes into a section.
+    void writeSection(size_t section, uint64_t offset, const void *bytes, size_t length) {
+        memcpy(&content_[sections_[section].offset + offset], bytes, length);
+    }
+
+    /// Write a pointer sized value into a section.
+    void writePointer(size_t section, uint64_t offset, uint64_t value) {
+        if (is64Bit_) {
+            writeSection(section, offset, &value, 8);
+        } else {
+            uint32_t value32 = static_cast<uint32_t>(value);
+            writeSection(section, offset, &value32, 4);
+        }
+    }
+
+    /// Write a C string into a section, return its vm address.
+    uint64_t writeCString(size_t section, uint64_t offset, const std::string &string) {
+        writeSection(section, offset, string.c_str(), string.size() + 1);
+        return sections_[section].addr + offset;
+    }
+
+    void addSymbol(const std::string &name, uint8_t type, uint8_t sect, uint64_t value, uint16_t desc = 0) {
+        Symbol symbol = {name, type, sect, desc, value};
+        symbols_.push_back(symbol);
+    }
+
+    /// Mark range of symbols for LC_DYSYMTAB.
+    void setDysymtab(uint32_t ilocalsym, uint32_t nlocalsym, uint32_t iextdefsym, uint32_t nextdefsym, uint32_t iundefsym, uint32_t nundefsym) {
+        dysymtab_.assign({ilocalsym, nlocalsym, iextdefsym, nextdefsym, iundefsym, nundefsym});
+    }
+
+    /// Add blob into __LINKEDIT, referenced by a linkedit load command, such as LC_DYLD_CHAINED_FIXUPS and LC_DYLD_EXPORTS_TRIE.
+    void setLinkeditData(uint32_t cmd, const std::vector<uint8_t> &data) {
+        linkeditData_.push_back(std::make_pair(cmd, data));
+    }
+
+    /// Set LC_DYLD_INFO_ONLY with rebase, bind, weak bind, lazy bind and export.
+    void setDyldInfo(const std::vector<uint8_t> &rebase, const std::vector<uint8_t> &bind, const std::vector<uint8_t> &weakBind, const std::vector<uint8_t> &lazyBind, const std::vector<uint8_t> &exports) {
+        dyldInfo_.clear();
+        dyldInfo_.push_back(rebase);
+        dyldInfo_.push_back(bind);
+        dyldInfo_.push_back(weakBind);
+        dyldInfo_.push_back(lazyBind);
+        dyldInfo_.push_back(exports);
+    }
+
+    std::vector<uint8_t> build() {
+        if (!laidOut_) {
+            layout();
+        }
+        std::vector<uint8_t> file = content_;
+        std::vector<uint8_t> linkedit;
+
+        std::vector<uint32_t> dyldInfoOffsets;
+        for (const std::vector<uint8_t> &data : dyldInfo_) {
+            dyldInfoOffsets.push_back(data.empty() ? 0 : static_cast<uint32_t>(linkeditFileOffset_ + linkedit.size()));
+            dyldInfoOffsets.push_back(static_cast<uint32_t>(data.size()));
+            appendAligned(linkedit, data);
+        }
+        std::vector<std::pair<uint32_t, std::pair<uint32_t, uint32_t>>> dataCommands;
+        for (const auto &data : linkeditData_) {
+            dataCommands.push_back(std::make_pair(data.first, std::make_pair(static_cast<uint32_t>(linkeditFileOffset_ + linkedit.size()), static_cast<uint32_t>(data.second.size()))));
+            appendAligned(linkedit, data.second);
+        }
+        uint32_t symoff = 0, stroff = 0, strsize = 0;
+        if (!symbols_.empty()) {
+            std::vector<uint8_t> strings(1, 0);
+            std::vector<uint8_t> nlists;
+            for (const Symbol &symbol : symbols_) {
+                uint32_t strx = static_cast<uint32_t>(strings.size());
+                strings.insert(strings.end(), symbol.name.begin(), symbol.name.end());
+                strings.push_back(0);
+                append(nlists, strx);
+                nlists.push_back(symbol.type);
+                nlists.push_back(symbol.sect);
+                append(nlists, symbol.desc);
+                if (is64Bit_) {
+                    append(nlists, symbol.value);
+                } else {
+                    append(nlists, static_cast<uint32_t>(symbol.value));
+                }
+            }
+            symoff = static_cast<uint32_t>(linkeditFileOffset_ + linkedit.size());
+            appendAligned(linkedit, nlists);
+            stroff = static_cast<uint32_t>(linkeditFileOffset_ + linkedit.size());
+            strsize = static_cast<uint32_t>(strings.size());
+            appendAligned(linkedit, strings);
+        }
+        file.insert(file.end(), linkedit.begin(), linkedit.end());
+
+        // Load commands
+        std::vector<uint8_t> commands;
+        uint32_t ncmds = 0;
+        for (size_t i = 0; i < segments_.size(); i++) {
+            appendSegment(commands, segments_[i], i);
+            ncmds++;
+        }
+        Segment linkeditSegment;
+        linkeditSegment.name = "__LINKEDIT";
+        linkeditSegment.vmaddr = linkeditVMAddr_;
+        linkeditSegment.fileoff = linkeditFileOffset_;
+        linkeditSegment.size = linkedit.size();
+        linkeditSegment.zeroFill = 0;
+        appendSegment(commands, linkeditSegment, SIZE_MAX);
+        ncmds++;
+        if (hasUUID_) {
+            append(commands, static_cast<uint32_t>(macho::LC_UUID));
+            append(commands, static_cast<uint32_t>(24));
+            commands.insert(commands.end(), uuid_, uuid_ + 16);
+            ncmds++;
+        }
+        if (!installName_.empty()) {
+            appendDylibCommand(commands, macho::LC_ID_DYLIB, installName_);
+            ncmds++;
+        }
+        for (const auto &dylib : dylibs_) {
+            appendDylibCommand(commands, dylib.first, dylib.second);
+            ncmds++;
+        }
+        if (!dyldInfo_.empty()) {
+            append(commands, static_cast<uint32_t>(macho::LC_DYLD_INFO_ONLY));
+            append(commands, static_cast<uint32_t>(48));
+            for (uint32_t value : dyldInfoOffsets) {
+                append(commands, value);
+            }
+            ncmds++;
+        }
+        for (const auto &data : dataCommands) {
+            append(commands, data.first);
+            append(commands, static_cast<uint32_t>(16));
+            append(commands, data.second.first);
+            append(commands, data.second.second);
+            ncmds++;
+        }
+        if (!symbols_.empty()) {
+            append(commands, static_cast<uint32_t>(macho::LC_SYMTAB));
+            append(commands, static_cast<uint32_t>(24));
+            append(commands, symoff);
+            append(commands, static_cast<uint32_t>(symbols_.size()));
+            append(commands, stroff);
+            append(commands, strsize);
+            ncmds++;
+        }
+        if (!dysymtab_.empty()) {
+            append(commands, static_cast<uint32_t>(macho::LC_DYSYMTAB));
+            append(commands, static_cast<uint32_t>(80));
+            for (uint32_t value : dysymtab_) {
+                append(commands, value);
+            }
+            for (int i = 0; i < 12; i++) {
+                append(commands, static_cast<uint32_t>(0));
+            }
+            ncmds++;
+        }
+        for (const auto &raw : rawCommands_) {
+            uint32_t cmdsize = static_cast<uint32_t>(alignUp(8 + raw.second.size(), is64Bit_ ? 8 : 4));
+            append(commands, raw.first);
+            append(commands, cmdsize);
+            commands.insert(commands.end(), raw.second.begin(), raw.second.end());
+            commands.resize(commands.size() + (cmdsize - 8 - raw.second.size()), 0);
+            ncmds++;
+        }
+
+        // Header
+        std::vector<uint8_t> header;
+        append(header, is64Bit_ ? static_cast<uint32_t>(macho::MH_MAGIC_64) : static_cast<uint32_t>(macho::MH_MAGIC));
+        append(header, static_cast<uint32_t>(is64Bit_ ? cpuType_ : (cpuType_ & ~0x01000000)));
+        append(header, static_cast<uint32_t>(0));
+        append(header, fileType_);
+        append(header, ncmds);
+        append(header, static_cast<uint32_t>(commands.size()));
+        append(header, static_cast<uint32_t>(0));
+        if (is64Bit_) {
+            append(header, static_cast<uint32_t>(0));
+        }
+        memcpy(&file[0], header.data(), header.size());
+        memcpy(&file[header.size()], commands.data(), commands.size());
+        return file;
+    }
+
+    /// Wrap thin images into a FAT file. Each pair is (cputype, image).
+    static std::vector<uint8_t> fat(const std::vector<std::pair<int32_t, std::vector<uint8_t>>> &slices) {
+        std::vector<uint8_t> file;
+        appendBigEndian(file, macho::FAT_MAGIC);
+        appendBigEndian(file, static_cast<uint32_t>(slices.size()));
+        uint32_t offset = static_cast<uint32_t>(alignUp(8 + 20 * slices.size(), 0x1000));
+        std::vector<uint32_t> offsets;
+        for (const auto &slice : slices) {
+            appendBigEndian(file, static_cast<uint32_t>(slice.first));
+            appendBigEndian(file, static_cast<uint32_t>(0));
+            appendBigEndian(file, offset);
+            appendBigEndian(file, static_cast<uint32_t>(slice.second.size()));
+            appendBigEndian(file, static_cast<uint32_t>(12));
+            offsets.push_back(offset);
+            offset = static_cast<uint32_t>(alignUp(offset + slice.second.size(), 0x1000));
+        }
+        for (size_t i = 0; i < slices.size(); i++) {
+            file.resize(offsets[i], 0);
+            file.insert(file.end(), slices[i].second.begin(), slices[i].second.end());
+        }
+        return file;
+    }
+
+    static void appendULEB128(std::vector<uint8_t> &data, uint64_t value) {
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            if (value != 0) {
+                byte |= 0x80;
+            }
+            data.push_back(byte);
+        } while (value != 0);
+    }
+
+    template <typename T>
+    static void append(std::vector<uint8_t> &data, T value) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+private:
+    struct Segment {
+        std::string name;
+        uint64_t vmaddr;
+        uint64_t fileoff;
+        uint64_t size;
+        /// Vm size after the file content.
+        uint64_t zeroFill;
+    };
+    struct Section {
+        size_t segment;
+        std::string segname;
+        std::string sectname;
+        uint64_t size;
+        uint32_t alignment;
+        uint64_t addr;
+        uint32_t offset;
+    };
+
+    static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static void appendBigEndian(std::vector<uint8_t> &data, uint32_t value) {
+        data.push_back(static_cast<uint8_t>(value >> 24));
+        data.push_back(static_cast<uint8_t>(value >> 16));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+        data.push_back(static_cast<uint8_t>(value));
+    }
+
+    void appendAligned(std::vector<uint8_t> &linkedit, const std::vector<uint8_t> &data) {
+        linkedit.insert(linkedit.end(), data.begin(), data.end());
+        linkedit.resize(alignUp(linkedit.size(), 8), 0);
+    }
+
+    size_t addSegment(const std::string &name) {
+        for (size_t i = 0; i < segments_.size(); i++) {
+            if (segments_[i].name == name) {
+                return i;
+            }
+        }
+        Segment segment = {name, 0, 0, 0, 0};
+        segments_.push_back(segment);
+        return segments_.size() - 1;
+    }
+
+    size_t findSegment(const std::string &name) const {
+        for (size_t i = 0; i < segments_.size(); i++) {
+            if (segments_[i].name == name) {
+                return i;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    size_t headerSize() const {
+        return is64Bit_ ? sizeof(macho::mach_header_64) : sizeof(macho::mach_header);
+    }
+
+    size_t estimatedCommandsSize() const {
+        size_t size = (segments_.size() + 1) * sizeof(macho::segment_command_64) + sections_.size() * sizeof(macho::section_64);
+        size += 24 + 48 + 24 + 80 + 16 * 8;
+        size += alignUp(24 + installName_.size() + 1, 8);
+        for (const auto &dylib : dylibs_) {
+            size += alignUp(24 + dylib.second.size() + 1, 8);
+        }
+        for (const auto &raw : rawCommands_) {
+            size += alignUp(8 + raw.second.size(), 8);
+        }
+        return size;
+    }
+
+    void appendName(std::vector<uint8_t> &data, const std::string &name) {
+        char buffer[16] = {0};
+        memcpy(buffer, name.data(), std::min(name.size(), sizeof(buffer)));
+        data.insert(data.end(), buffer, buffer + 16);
+    }
+
+    void appendSegment(std::vector<uint8_t> &commands, const Segment &segment, size_t segmentIndex) {
+        std::vector<const Section *> sections;
+        for (const Section &section : sections_) {
+            if (section.segment == segmentIndex) {
+                sections.push_back(&section);
+            }
+        }
+        if (is64Bit_) {
+            append(commands, static_cast<uint32_t>(macho::LC_SEGMENT_64));
+            append(commands, static_cast<uint32_t>(sizeof(macho::segment_command_64) + sections.size() * sizeof(macho::section_64)));
+            appendName(commands, segment.name);
+            append(commands, segment.vmaddr);
+            append(commands, segment.size + segment.zeroFill);
+            append(commands, segment.fileoff);
+            append(commands, segment.size);
+            append(commands, static_cast<int32_t>(segment.name == "__TEXT" ? 5 : 3));
+            append(commands, static_cast<int32_t>(segment.name == "__TEXT" ? 5 : 3));
+            append(commands, static_cast<uint32_t>(sections.size()));
+            append(commands, static_cast<uint32_t>(0));
+            for (const Section *section : sections) {
+                appendName(commands, section->sectname);
+                appendName(commands, section->segname);
+                append(commands, section->addr);
+                append(commands, section->size);
+                append(commands, section->offset);
+                append(commands, static_cast<uint32_t>(3));
+                for (int i = 0; i < 6; i++) {
+                    append(commands, static_cast<uint32_t>(0));
+                }
+            }
+        } else {
+            append(commands, static_cast<uint32_t>(macho::LC_SEGMENT));
+            append(commands, static_cast<uint32_t>(sizeof(macho::segment_command) + sections.size() * sizeof(macho::section)));
+            appendName(commands, segment.name);
+            append(commands, static_cast<uint32_t>(segment.vmaddr));
+            append(commands, static_cast<uint32_t>(segment.size + segment.zeroFill));
+            append(commands, static_cast<uint32_t>(segment.fileoff));
+            append(commands, static_cast<uint32_t>(segment.size));
+            append(commands, static_cast<int32_t>(segment.name == "__TEXT" ? 5 : 3));
+            append(commands, static_cast<int32_t>(segment.name == "__TEXT" ? 5 : 3));
+            append(commands, static_cast<uint32_t>(sections.size()));
+            append(commands, static_cast<uint32_t>(0));
+            for (const Section *section : sections) {
+                appendName(commands, section->sectname);
+                appendName(commands, section->segname);
+                append(commands, static_cast<uint32_t>(section->addr));
+                append(commands, static_cast<uint32_t>(section->size));
+                append(commands, section->offset);
+                append(commands, static_cast<uint32_t>(2));
+                for (int i = 0; i < 5; i++) {
+                    append(commands, static_cast<uint32_t>(0));
+                }
+            }
+        }
+    }
+
+    void appendDylibCommand(std::vector<uint8_t> &commands, uint32_t cmd, const std::string &name) {
+        uint32_t cmdsize = static_cast<uint32_t>(alignUp(24 + name.size() + 1, is64Bit_ ? 8 : 4));
+        append(commands, cmd);
+        append(commands, cmdsize);
+        append(commands, static_cast<uint32_t>(24));
+        append(commands, static_cast<uint32_t>(2));
+        append(commands, static_cast<uint32_t>(0x10000));
+        append(commands, static_cast<uint32_t>(0x10000));
+        commands.insert(commands.end(), name.begin(), name.end());
+        commands.resize(commands.size() + (cmdsize - 24 - name.size()), 0);
+    }
+
+    bool is64Bit_;
+    uint32_t fileType_;
+    int32_t cpuType_;
+    uint8_t uuid_[16];
+    bool hasUUID_;
+    std::string installName_;
+    std::vector<std::pair<uint32_t, std::string>> dylibs_;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> rawCommands_;
+    std::vector<Segment> segments_;
+    std::vector<Section> sections_;
+    std::vector<Symbol> symbols_;
+    std::vector<uint32_t> dysymtab_;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> linkeditData_;
+    std::vector<std::vector<uint8_t>> dyldInfo_;
+    bool laidOut_;
+    uint64_t headerPad_;
+    uint64_t linkeditVMAddr_;
+    uint64_t linkeditFileOffset_;
+    std::vector<uint8_t> content_;
+};
+
+} // namespace test
+} // namespace zix
+
+#endif /* ZIKMachOFixtureBuilder_h */
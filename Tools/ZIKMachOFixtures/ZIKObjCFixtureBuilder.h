@@ -0,0 +1,349 @@
+//
+//  ZIKObjCFixtureBuilder.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKObjCFixtureBuilder_h
+#define ZIKObjCFixtureBuilder_h
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include "ZIKMachOFixtureBuilder.h"
+#include "ZIKMachOFixups.h"
+
+namespace zix {
+namespace test {
+
+/**
+ Build Mach-O files containing objc classes, with pointers encoded as the linker does.
+
+ Classes are written into `__objc_classlist`, `__objc_data`, `__objc_const` and `__objc_classname`. Superclass is either a class in the image, or an imported `_OBJC_CLASS_$_` symbol.
+ */
+class ObjCFixtureBuilder {
+public:
+    enum PointerFormat {
+        /// Rebased pointers are vm addresses, and binds are described by bind opcodes in LC_DYLD_INFO_ONLY.
+        Classic,
+        Chained64,
+        Chained64Offset,
+        ChainedARM64E,
+        Chained32,
+    };
+
+    explicit ObjCFixtureBuilder(PointerFormat format, uint32_t fileType = macho::MH_DYLIB, int32_t cpuType = 0x0100000c)
+    : format_(format), builder_(format != Chained32, fileType, cpuType), classList_(0), classData_(0) {}
+
+    MachOFixtureBuilder &machO() { return builder_; }
+
+    /// Add a class whose superclass is a class in the image. Return index of the class.
+    size_t addClass(const std::string &name, size_t superclass, bool isSwift = false) {
+        Class cls = {name, superclass, std::string(), isSwift, 0};
+        classes_.push_back(cls);
+        return classes_.size() - 1;
+    }
+
+    /// Add a class whose superclass is imported from another image, or a root class when superclass name is empty. The superclass is imported from the dylib at libraryOrdinal.
+    size_t addClass(const std::string &name, const std::string &externalSuperclass, bool isSwift = false, int32_t libraryOrdinal = 1) {
+        Class cls = {name, SIZE_MAX, externalSuperclass, isSwift, libraryOrdinal};
+        classes_.push_back(cls);
+        return classes_.size() - 1;
+    }
+
+    /// Import a symbol without using it, such as a class referenced by code. Unused imports are lazy binds in classic format.
+    void addImport(const std::string &symbol, int32_t libraryOrdinal = 1) {
+        importIndex(symbol, libraryOrdinal);
+    }
+
+    std::vector<uint8_t> build() {
+        bool is64Bit = format_ != Chained32;
+        uint64_t pointerSize = is64Bit ? 8 : 4;
+        // Leave room for method lists after class_ro_t. Then 32-bit chains can't reach next pointer, and pages need multiple chain starts.
+        uint64_t roSize = is64Bit ? 72 : 160;
+        uint64_t namesSize = 0;
+        for (const Class &cls : classes_) {
+            namesSize += cls.name.size() + 1;
+        }
+        size_t classNames = builder_.reserveSection("__TEXT", "__objc_classname", std::max<uint64_t>(namesSize, 1), 1);
+        classList_ = builder_.reserveSection("__DATA_CONST", "__objc_classlist", std::max<uint64_t>(classes_.size() * pointerSize, pointerSize), 8);
+        size_t classRO = builder_.reserveSection("__DATA_CONST", "__objc_const", std::max<uint64_t>(classes_.size() * roSize, roSize), 8);
+        classData_ = builder_.reserveSection("__DATA", "__objc_data", std::max<uint64_t>(classes_.size() * 5 * pointerSize, pointerSize), 8);
+        builder_.layout();
+
+        uint64_t nameOffset = 0;
+        for (size_t i = 0; i < classes_.size(); i++) {
+            const Class &cls = classes_[i];
+            uint64_t nameAddress = builder_.writeCString(classNames, nameOffset, cls.name);
+            nameOffset += cls.name.size() + 1;
+            uint64_t classAddress = builder_.sectionAddress(classData_) + i * 5 * pointerSize;
+            uint64_t roAddress = builder_.sectionAddress(classRO) + i * roSize;
+            addRebase(classList_, i * pointerSize, classAddress);
+            if (cls.superclass != SIZE_MAX) {
+                addRebase(classData_, i * 5 * pointerSize + pointerSize, builder_.sectionAddress(classData_) + cls.superclass * 5 * pointerSize);
+            } else if (!cls.externalSuperclass.empty()) {
+                addBind(classData_, i * 5 * pointerSize + pointerSize, importIndex("_OBJC_CLASS_$_" + cls.externalSuperclass, cls.libraryOrdinal));
+            }
+            // Swift classes set FAST_IS_SWIFT_STABLE in data pointer
+            addRebase(classData_, i * 5 * pointerSize + 4 * pointerSize, roAddress | (cls.isSwift ? 2 : 0));
+            addRebase(classRO, i * roSize + (is64Bit ? 24 : 16), nameAddress);
+        }
+        encodePointers();
+        return builder_.build();
+    }
+
+private:
+    struct Class {
+        std::string name;
+        size_t superclass;
+        std::string externalSuperclass;
+        bool isSwift;
+        int32_t libraryOrdinal;
+    };
+
+    struct Import {
+        std::string symbol;
+        int32_t libraryOrdinal;
+    };
+
+    struct Pointer {
+        size_t section;
+        uint64_t offset;
+        uint64_t address;
+        bool bind;
+        uint64_t target;
+        uint32_t importIndex;
+    };
+
+    uint32_t importIndex(const std::string &symbol, int32_t libraryOrdinal) {
+        for (size_t i = 0; i < imports_.size(); i++) {
+            if (imports_[i].symbol == symbol && imports_[i].libraryOrdinal == libraryOrdinal) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        Import import = {symbol, libraryOrdinal};
+        imports_.push_back(import);
+        return static_cast<uint32_t>(imports_.size() - 1);
+    }
+
+    void addRebase(size_t section, uint64_t offset, uint64_t target) {
+        Pointer pointer = {section, offset, builder_.sectionAddress(section) + offset, false, target, 0};
+        pointers_.push_back(pointer);
+    }
+
+    void addBind(size_t section, uint64_t offset, uint32_t import) {
+        Pointer pointer = {section, offset, builder_.sectionAddress(section) + offset, true, 0, import};
+        pointers_.push_back(pointer);
+    }
+
+    size_t segmentIndexOfPointer(const Pointer &pointer) const {
+        return builder_.segmentIndex(pointer.section == classData_ ? "__DATA" : "__DATA_CONST");
+    }
+
+    void encodePointers() {
+        std::sort(pointers_.begin(), pointers_.end(), [](const Pointer &lhs, const Pointer &rhs) {
+            return lhs.address < rhs.address;
+        });
+        if (format_ == Classic) {
+            encodeClassic();
+        } else {
+            encodeChained();
+        }
+    }
+
+    void encodeClassic() {
+        std::vector<uint8_t> bind;
+        std::vector<bool> used(imports_.size(), false);
+        for (const Pointer &pointer : pointers_) {
+            if (!pointer.bind) {
+                builder_.writePointer(pointer.section, pointer.offset, pointer.target);
+                continue;
+            }
+            used[pointer.importIndex] = true;
+            size_t segmentIndex = segmentIndexOfPointer(pointer);
+            appendBindSymbol(bind, imports_[pointer.importIndex]);
+            appendBindAddress(bind, segmentIndex, pointer.address - builder_.segmentAddressAtIndex(segmentIndex));
+            bind.push_back(macho::BIND_OPCODE_DO_BIND);
+        }
+        bind.push_back(macho::BIND_OPCODE_DONE);
+        // Lazy binds are separated by DONE
+        std::vector<uint8_t> lazyBind;
+        size_t dataSegment = builder_.segmentIndex("__DATA");
+        for (size_t i = 0; i < imports_.size(); i++) {
+            if (used[i]) {
+                continue;
+            }
+            appendBindAddress(lazyBind, dataSegment, 0);
+            appendBindSymbol(lazyBind, imports_[i]);
+            lazyBind.push_back(macho::BIND_OPCODE_DO_BIND);
+            lazyBind.push_back(macho::BIND_OPCODE_DONE);
+        }
+        builder_.setDyldInfo(std::vector<uint8_t>(), bind, std::vector<uint8_t>(), lazyBind, std::vector<uint8_t>());
+    }
+
+    static void appendBindSymbol(std::vector<uint8_t> &bind, const Import &import) {
+        if (import.libraryOrdinal <= 0) {
+            bind.push_back(static_cast<uint8_t>(macho::BIND_OPCODE_SET_DYLIB_SPECIAL_IMM | (import.libraryOrdinal & macho::BIND_IMMEDIATE_MASK)));
+        } else if (import.libraryOrdinal <= macho::BIND_IMMEDIATE_MASK) {
+            bind.push_back(static_cast<uint8_t>(macho::BIND_OPCODE_SET_DYLIB_ORDINAL_IMM | import.libraryOrdinal));
+        } else {
+            bind.push_back(macho::BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB);
+            MachOFixtureBuilder::appendULEB128(bind, static_cast<uint64_t>(import.libraryOrdinal));
+        }
+        bind.push_back(macho::BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM);
+        bind.insert(bind.end(), import.symbol.begin(), import.symbol.end());
+        bind.push_back(0);
+        bind.push_back(macho::BIND_OPCODE_SET_TYPE_IMM | 1);
+    }
+
+    static void appendBindAddress(std::vector<uint8_t> &bind, size_t segmentIndex, uint64_t segmentOffset) {
+        bind.push_back(static_cast<uint8_t>(macho::BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB | segmentIndex));
+        MachOFixtureBuilder::appendULEB128(bind, segmentOffset);
+    }
+
+    uint16_t chainedPointerFormat() const {
+        switch (format_) {
+            case Chained64:
+                return macho::DYLD_CHAINED_PTR_64;
+            case Chained64Offset:
+                return macho::DYLD_CHAINED_PTR_64_OFFSET;
+            case ChainedARM64E:
+                return macho::DYLD_CHAINED_PTR_ARM64E;
+            default:
+                return macho::DYLD_CHAINED_PTR_32;
+        }
+    }
+
+    uint64_t encodeChainedPointer(const Pointer &pointer, uint64_t next) const {
+        uint64_t base = builder_.segmentAddress("__TEXT");
+        switch (format_) {
+            case Chained64:
+            case Chained64Offset:
+                if (pointer.bind) {
+                    return (1ULL << 63) | (next << 51) | pointer.importIndex;
+                }
+                return (next << 51) | (format_ == Chained64Offset ? pointer.target - base : pointer.target);
+            case ChainedARM64E:
+                if (pointer.bind) {
+                    return (1ULL << 62) | (next << 51) | pointer.importIndex;
+                }
+                if (pointer.section == classList_) {
+                    // Authenticated rebase with offset from the image
+                    return (1ULL << 63) | (next << 51) | (pointer.target - base);
+                }
+                return (next << 51) | pointer.target;
+            default:
+                if (pointer.bind) {
+                    return (1ULL << 31) | (next << 26) | pointer.importIndex;
+                }
+                return (next << 26) | pointer.target;
+        }
+    }
+
+    void encodeChained() {
+        const uint64_t pageSize = 0x1000;
+        bool is32Bit = format_ == Chained32;
+        uint64_t stride = format_ == ChainedARM64E ? 8 : 4;
+        uint64_t maxNext = format_ == ChainedARM64E ? 0x7ff : (is32Bit ? 0x1f : 0xfff);
+
+        // Chains of each page in each segment. A page of 32-bit image is split to multiple chains when next pointer is too far.
+        std::map<size_t, std::map<uint64_t, std::vector<std::vector<const Pointer *>>>> chains;
+        for (const Pointer &pointer : pointers_) {
+            size_t segmentIndex = segmentIndexOfPointer(pointer);
+            uint64_t segmentAddress = builder_.segmentAddressAtIndex(segmentIndex);
+            uint64_t page = (pointer.address - segmentAddress) / pageSize;
+            std::vector<std::vector<const Pointer *>> &pageChains = chains[segmentIndex][page];
+            if (pageChains.empty() || (pointer.address - pageChains.back().back()->address) / stride > maxNext) {
+                pageChains.push_back(std::vector<const Pointer *>());
+            }
+            pageChains.back().push_back(&pointer);
+        }
+        for (const auto &segment : chains) {
+            for (const auto &page : segment.second) {
+                for (const std::vector<const Pointer *> &chain : page.second) {
+                    for (size_t i = 0; i < chain.size(); i++) {
+                        uint64_t next = i + 1 < chain.size() ? (chain[i + 1]->address - chain[i]->address) / stride : 0;
+                        builder_.writePointer(chain[i]->section, chain[i]->offset, encodeChainedPointer(*chain[i], next));
+                    }
+                }
+            }
+        }
+
+        std::vector<uint8_t> blob;
+        macho::dyld_chained_fixups_header header = {0, 32, 0, 0, static_cast<uint32_t>(imports_.size()), macho::DYLD_CHAINED_IMPORT, 0};
+        blob.resize(32, 0);
+        // dyld_chained_starts_in_image
+        size_t segmentCount = builder_.segmentIndex("__DATA") + 2;
+        size_t startsInImage = blob.size();
+        MachOFixtureBuilder::append(blob, static_cast<uint32_t>(segmentCount));
+        blob.resize(blob.size() + segmentCount * 4, 0);
+        for (const auto &segment : chains) {
+            uint32_t infoOffset = static_cast<uint32_t>(alignUp(blob.size(), 8) - startsInImage);
+            blob.resize(alignUp(blob.size(), 8), 0);
+            memcpy(&blob[startsInImage + 4 + segment.first * 4], &infoOffset, 4);
+            uint16_t pageCount = static_cast<uint16_t>(segment.second.rbegin()->first + 1);
+            std::vector<uint16_t> pageStarts(pageCount, macho::DYLD_CHAINED_PTR_START_NONE);
+            std::vector<uint16_t> overflow;
+            uint64_t segmentAddress = builder_.segmentAddressAtIndex(segment.first);
+            for (const auto &page : segment.second) {
+                const std::vector<std::vector<const Pointer *>> &pageChains = page.second;
+                if (pageChains.size() == 1) {
+                    pageStarts[page.first] = static_cast<uint16_t>(pageChains[0][0]->address - segmentAddress - page.first * pageSize);
+                    continue;
+                }
+                pageStarts[page.first] = static_cast<uint16_t>(macho::DYLD_CHAINED_PTR_START_MULTI | (pageCount + overflow.size()));
+                for (size_t i = 0; i < pageChains.size(); i++) {
+                    uint16_t start = static_cast<uint16_t>(pageChains[i][0]->address - segmentAddress - page.first * pageSize);
+                    overflow.push_back(i + 1 == pageChains.size() ? (start | macho::DYLD_CHAINED_PTR_START_LAST) : start);
+                }
+            }
+            pageStarts.insert(pageStarts.end(), overflow.begin(), overflow.end());
+            MachOFixtureBuilder::append(blob, static_cast<uint32_t>(22 + pageStarts.size() * 2));
+            MachOFixtureBuilder::append(blob, static_cast<uint16_t>(pageSize));
+            MachOFixtureBuilder::append(blob, chainedPointerFormat());
+            MachOFixtureBuilder::append(blob, segmentAddress - builder_.segmentAddress("__TEXT"));
+            MachOFixtureBuilder::append(blob, static_cast<uint32_t>(is32Bit ? 0x00100000 : 0));
+            MachOFixtureBuilder::append(blob, pageCount);
+            for (uint16_t start : pageStarts) {
+                MachOFixtureBuilder::append(blob, start);
+            }
+        }
+        // Imports and symbols
+        blob.resize(alignUp(blob.size(), 4), 0);
+        header.imports_offset = static_cast<uint32_t>(blob.size());
+        std::vector<uint8_t> symbols(1, 0);
+        for (const Import &symbol : imports_) {
+            uint32_t import = (static_cast<uint32_t>(symbol.libraryOrdinal) & 0xff) | (static_cast<uint32_t>(symbols.size()) << 9);
+            MachOFixtureBuilder::append(blob, import);
+            symbols.insert(symbols.end(), symbol.symbol.begin(), symbol.symbol.end());
+            symbols.push_back(0);
+        }
+        header.symbols_offset = static_cast<uint32_t>(blob.size());
+        blob.insert(blob.end(), symbols.begin(), symbols.end());
+        memcpy(&blob[0], &header, sizeof(header));
+        builder_.setLinkeditData(macho::LC_DYLD_CHAINED_FIXUPS, blob);
+    }
+
+    static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    PointerFormat format_;
+    MachOFixtureBuilder builder_;
+    size_t classList_;
+    size_t classData_;
+    std::vector<Class> classes_;
+    std::vector<Import> imports_;
+    std::vector<Pointer> pointers_;
+};
+
+} // namespace test
+} // namespace zix
+
+#endif /* ZIKObjCFixtureBuilder_h */
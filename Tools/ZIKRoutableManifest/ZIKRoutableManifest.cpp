@@ -0,0 +1,219 @@
+//
+//  ZIKRoutableManifest.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKRoutableManifest.h"
+#include "ZIKSymbolIndex.h"
+#include "ZIKMangledNameClassifier.h"
+#include <stdio.h>
+#include <string.h>
+
+using namespace zix;
+
+namespace {
+
+const char *const ManifestName = "ZIKRoutableManifest";
+const int ManifestVersion = 1;
+const char *const RoutableModule = "ZRouter";
+/// Routable symbols contain one of them, the same as symbols checked by validators in ZRouter.
+const char *const RoutableSubstrings[] = {"RoutableService", "RoutableView"};
+
+const char *const EntryKinds[] = {"declaration", "routingType", "constrainedInitializer"};
+
+std::string hexString(uint64_t value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+std::string uuidString(const uint8_t uuid[16]) {
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X",
+             uuid[0], uuid[1], uuid[2], uuid[3], uuid[4], uuid[5], uuid[6], uuid[7],
+             uuid[8], uuid[9], uuid[10], uuid[11], uuid[12], uuid[13], uuid[14], uuid[15]);
+    return buffer;
+}
+
+std::string jsonString(const std::string &string) {
+    std::string result = "\"";
+    for (char c : string) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+            result += buffer;
+        } else {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+void appendMember(std::string &json, const char *key, const std::string &value, bool &first) {
+    if (!first) {
+        json += ", ";
+    }
+    first = false;
+    json += jsonString(key);
+    json += ": ";
+    json += jsonString(value);
+}
+
+bool isRoutableCandidate(const char *name, const MangledNameFilter &filter) {
+    for (const char *substring : RoutableSubstrings) {
+        if (strstr(name, substring) != nullptr) {
+            return filter.accepts(name);
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool RoutableManifest::addFile(const void *bytes, size_t size, int32_t cpuType, int32_t cpuSubtype, const std::string &path, std::string &error) {
+    std::vector<MachOFatSlice> slices;
+    if (!readFatSlices(bytes, size, slices)) {
+        if (size < sizeof(macho::mach_header)) {
+            error = "not a Mach-O file";
+            return false;
+        }
+        MachOFatSlice thin;
+        memcpy(&thin.cpuType, static_cast<const uint8_t *>(bytes) + 4, sizeof(int32_t));
+        memcpy(&thin.cpuSubtype, static_cast<const uint8_t *>(bytes) + 8, sizeof(int32_t));
+        thin.offset = 0;
+        thin.size = size;
+        slices.push_back(thin);
+    }
+    bool matched = false;
+    for (const MachOFatSlice &slice : slices) {
+        if (cpuType != AnyCPU && slice.cpuType != cpuType) {
+            continue;
+        }
+        if (cpuSubtype != AnyCPU && (slice.cpuSubtype & 0x00ffffff) != cpuSubtype) {
+            continue;
+        }
+        matched = true;
+        MachOImage image;
+        if (!image.parse(static_cast<const uint8_t *>(bytes) + slice.offset, static_cast<size_t>(slice.size), MachOImage::LayoutFile)) {
+            error = "invalid Mach-O image at offset " + hexString(slice.offset);
+            return false;
+        }
+        if (!addImage(image, path, error)) {
+            return false;
+        }
+    }
+    if (!matched) {
+        error = "no slice matches the architecture";
+        return false;
+    }
+    return true;
+}
+
+bool RoutableManifest::addImage(const MachOImage &image, const std::string &path, std::string &error) {
+    Image added;
+    added.path = path;
+    uint8_t uuid[16];
+    if (image.copyUUID(uuid)) {
+        added.uuid = uuidString(uuid);
+    }
+    images_.push_back(added);
+
+    MachOSymbolTable table;
+    if (!readSymbolTable(image, table)) {
+        // Stripped images don't have routable symbols to check
+        return true;
+    }
+    MangledNameFilter filter(ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor, RoutableModule);
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type;
+        uint8_t sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        if (name == nullptr) {
+            error = "invalid symbol name at index " + std::to_string(i);
+            return false;
+        }
+        if ((type & macho::N_STAB) != 0 || !isRoutableCandidate(name, filter)) {
+            continue;
+        }
+        if (!addedSymbols_.insert(std::make_pair(path, std::string(name))).second) {
+            continue;
+        }
+        RoutableManifestEntry entry;
+        RoutableSymbolParser::Result result = RoutableSymbolParser::parse(name, entry.symbol);
+        if (result == RoutableSymbolParser::Unsupported) {
+            unsupportedSymbols_.push_back(name);
+            continue;
+        }
+        if (result == RoutableSymbolParser::Ignored) {
+            continue;
+        }
+        entry.image = path;
+        entry.symbolName = name;
+        entry.defined = (type & macho::N_TYPE) != macho::N_UNDF;
+        entry.address = entry.defined ? value : 0;
+        entries_.push_back(entry);
+    }
+    return true;
+}
+
+std::string RoutableManifest::json() const {
+    std::string json = "{\n";
+    json += "  \"manifest\": " + jsonString(ManifestName) + ",\n";
+    json += "  \"version\": " + std::to_string(ManifestVersion) + ",\n";
+    json += std::string("  \"complete\": ") + (isComplete() ? "true" : "false") + ",\n";
+    json += "  \"images\": [";
+    for (size_t i = 0; i < images_.size(); i++) {
+        bool first = true;
+        json += i == 0 ? "\n    {" : ",\n    {";
+        appendMember(json, "path", images_[i].path, first);
+        appendMember(json, "uuid", images_[i].uuid, first);
+        json += "}";
+    }
+    json += images_.empty() ? "],\n" : "\n  ],\n";
+    json += "  \"entries\": [";
+    for (size_t i = 0; i < entries_.size(); i++) {
+        const RoutableManifestEntry &entry = entries_[i];
+        const RoutableSymbol &symbol = entry.symbol;
+        bool first = true;
+        json += i == 0 ? "\n    {" : ",\n    {";
+        appendMember(json, "kind", EntryKinds[symbol.kind], first);
+        appendMember(json, "routable", symbol.routable, first);
+        if (!symbol.protocolName.empty()) {
+            appendMember(json, "protocol", symbol.protocolName, first);
+        }
+        if (!symbol.module.empty()) {
+            appendMember(json, "module", symbol.module, first);
+        }
+        if (!symbol.signature.empty()) {
+            appendMember(json, "signature", symbol.signature, first);
+        }
+        appendMember(json, "image", entry.image, first);
+        appendMember(json, "symbol", entry.symbolName, first);
+        if (entry.defined) {
+            appendMember(json, "address", hexString(entry.address), first);
+        }
+        json += "}";
+    }
+    json += entries_.empty() ? "],\n" : "\n  ],\n";
+    json += "  \"unsupportedSymbols\": [";
+    for (size_t i = 0; i < unsupportedSymbols_.size(); i++) {
+        json += i == 0 ? "\n    " : ",\n    ";
+        json += jsonString(unsupportedSymbols_[i]);
+    }
+    json += unsupportedSymbols_.empty() ? "]\n" : "\n  ]\n";
+    json += "}\n";
+    return json;
+}
@@ -0,0 +1,93 @@
+//
+//  ZIKRoutableManifest.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKRoutableManifest_h
+#define ZIKRoutableManifest_h
+
+#include <set>
+#include <string>
+#include <vector>
+#include "ZIKMachOImage.h"
+#include "ZIKRoutableSymbolParser.h"
+
+namespace zix {
+
+/// A routable declaration or usage found by RoutableManifest, with its location in binaries.
+struct RoutableManifestEntry {
+    RoutableSymbol symbol;
+    /// Path of the file containing the symbol.
+    std::string image;
+    /// The symbol name in the symbol table.
+    std::string symbolName;
+    /// Whether the symbol is defined in the image. Undefined symbols are references to other images.
+    bool defined;
+    /// Address of defined symbols, in the first added slice of the file.
+    uint64_t address;
+};
+
+/**
+ Find routable declarations and usages in Mach-O files without running them, so ZRouter can validate routes at launch without demangling all symbols in the app.
+
+ It reads the same symbols as the validators in ZRouter: initializers in extensions of RoutableService, RoutableServiceModule, RoutableView and RoutableViewModule, and type metadata accessors of them. Add the app executable and all its frameworks, then write `json()` into the app bundle as `ZIKRoutableManifest.json`.
+ */
+class RoutableManifest {
+public:
+    /// Any cpu type or subtype.
+    static const int32_t AnyCPU = -1;
+
+    /// A slice of an added file.
+    struct Image {
+        std::string path;
+        /// LC_UUID as upper case hyphenated string. Empty when the image doesn't have LC_UUID.
+        std::string uuid;
+    };
+
+    /**
+     Add symbols in a thin or FAT Mach-O file.
+
+     @param bytes Content of the file.
+     @param size Size of the file.
+     @param cpuType Only read the slice with the cpu type in FAT file. Pass AnyCPU to read all slices.
+     @param cpuSubtype Only read the slice with the cpu subtype, without capability bits. Pass AnyCPU to ignore subtype.
+     @param path Path of the file, recorded as location of symbols.
+     @param error Reason of failure.
+     @return False when the file is not a valid Mach-O file, or no slice matches the cpu type.
+     */
+    bool addFile(const void *bytes, size_t size, int32_t cpuType, int32_t cpuSubtype, const std::string &path, std::string &error);
+
+    /// Add symbols in a thin image with file layout.
+    bool addImage(const MachOImage &image, const std::string &path, std::string &error);
+
+    const std::vector<Image> &images() const { return images_; }
+
+    /// Entries in the order of symbol tables. A symbol in several slices of a file is only added once.
+    const std::vector<RoutableManifestEntry> &entries() const { return entries_; }
+
+    /// Routable symbols using mangling not supported by RoutableSymbolParser.
+    const std::vector<std::string> &unsupportedSymbols() const { return unsupportedSymbols_; }
+
+    /// The manifest is complete when all routable symbols are parsed. ZRouter doesn't use incomplete manifests.
+    bool isComplete() const { return unsupportedSymbols_.empty(); }
+
+    /// The manifest as JSON, read by `zix_routableManifestEntries()`.
+    std::string json() const;
+
+private:
+    std::vector<Image> images_;
+    std::vector<RoutableManifestEntry> entries_;
+    std::vector<std::string> unsupportedSymbols_;
+    /// (path, symbol name) already added.
+    std::set<std::pair<std::string, std::string>> addedSymbols_;
+};
+
+} // namespace zix
+
+#endif /* ZIKRoutableManifest_h */
@@ -0,0 +1,1038 @@
+//
+//  ZIKRoutableSymbolParser.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKRoutableSymbolParser.h"
+#include <string.h>
+#include <deque>
+#include <vector>
+
+using namespace zix;
+
+namespace {
+
+const char *const RoutableModule = "ZRouter";
+const char *const RoutableTypeNames[] = {"RoutableService", "RoutableServiceModule", "RoutableView", "RoutableViewModule"};
+
+/// Module names printed by swift demangler for `So` and `SC`.
+const char *const ObjCModule = "__C";
+const char *const ClangImporterModule = "__C_Synthesized";
+const char *const StandardLibraryModule = "Swift";
+
+/// Limits from swift demangler.
+const size_t MaxNumWords = 26;
+const int MaxRepeatCount = 2048;
+/// Limit of nested nodes, in case of broken names.
+const size_t MaxNodeCount = 4096;
+
+struct StandardType {
+    char code;
+    char kind;
+    const char *name;
+};
+
+/// Standard substitutions `S<code>` of types in the Swift module.
+const StandardType StandardTypes[] = {
+    {'A', 'V', "AutoreleasingUnsafeMutablePointer"},
+    {'a', 'V', "Array"},
+    {'b', 'V', "Bool"},
+    {'D', 'V', "Dictionary"},
+    {'d', 'V', "Double"},
+    {'f', 'V', "Float"},
+    {'h', 'V', "Set"},
+    {'I', 'V', "DefaultIndices"},
+    {'i', 'V', "Int"},
+    {'J', 'V', "Character"},
+    {'N', 'V', "ClosedRange"},
+    {'n', 'V', "Range"},
+    {'O', 'V', "ObjectIdentifier"},
+    {'P', 'V', "UnsafePointer"},
+    {'p', 'V', "UnsafeMutablePointer"},
+    {'R', 'V', "UnsafeBufferPointer"},
+    {'r', 'V', "UnsafeMutableBufferPointer"},
+    {'S', 'V', "String"},
+    {'s', 'V', "Substring"},
+    {'u', 'V', "UInt"},
+    {'V', 'V', "UnsafeRawPointer"},
+    {'v', 'V', "UnsafeMutableRawPointer"},
+    {'W', 'V', "UnsafeRawBufferPointer"},
+    {'w', 'V', "UnsafeMutableRawBufferPointer"},
+    {'q', 'O', "Optional"},
+    {'B', 'P', "BinaryFloatingPoint"},
+    {'E', 'P', "Encodable"},
+    {'e', 'P', "Decodable"},
+    {'F', 'P', "FloatingPoint"},
+    {'G', 'P', "RandomNumberGenerator"},
+    {'H', 'P', "Hashable"},
+    {'j', 'P', "Numeric"},
+    {'K', 'P', "BidirectionalCollection"},
+    {'k', 'P', "RandomAccessCollection"},
+    {'L', 'P', "Comparable"},
+    {'l', 'P', "Collection"},
+    {'M', 'P', "MutableCollection"},
+    {'m', 'P', "RangeReplaceableCollection"},
+    {'Q', 'P', "Equatable"},
+    {'T', 'P', "Sequence"},
+    {'t', 'P', "IteratorProtocol"},
+    {'U', 'P', "UnsignedInteger"},
+    {'X', 'P', "RangeExpression"},
+    {'x', 'P', "Strideable"},
+    {'Y', 'P', "RawRepresentable"},
+    {'y', 'P', "StringProtocol"},
+    {'Z', 'P', "SignedInteger"},
+    {'z', 'P', "BinaryInteger"},
+};
+
+struct Node {
+    enum Kind {
+        Identifier,
+        Module,
+        /// Class, struct, enum, protocol or type alias. `code` is the mangling operator `C`, `V`, `O`, `P` or `a`. Children: [context].
+        Nominal,
+        /// Children: [nominal, arguments...].
+        BoundGeneric,
+        /// `code` is `p` for plain composition, `l` with AnyObject, `c` with superclass. Children: [protocols..., superclass].
+        ProtocolList,
+        GenericParam,
+        /// Children: [instance type].
+        Metatype,
+        /// Children: element types. Labels are in `labels`.
+        Tuple,
+        /// Children: [parameters, result]. `code` is `K` for throwing functions.
+        Function,
+        EmptyList,
+        FirstElementMarker,
+        ThrowsAnnotation,
+        /// `code` is `:` for conformance and superclass, `=` for same type, `l` for layout with `text` as layout name. Children: [subject, constraint].
+        Requirement,
+        /// Generic parameter counts are in `counts`. Children: requirements.
+        Signature,
+        /// Children: [module, extended type, signature].
+        Extension,
+        /// Children: [context, function type].
+        Initializer,
+        /// Children: [type].
+        MetadataAccessor,
+    };
+    Kind kind;
+    char code;
+    std::string text;
+    unsigned depth;
+    unsigned index;
+    std::vector<const Node *> children;
+    std::vector<std::string> labels;
+    std::vector<unsigned> counts;
+
+    bool isType() const {
+        switch (kind) {
+            case Nominal:
+            case BoundGeneric:
+            case ProtocolList:
+            case GenericParam:
+            case Metatype:
+            case Tuple:
+            case Function:
+                return true;
+            default:
+                return false;
+        }
+    }
+};
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isLowerLetter(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+bool isUpperLetter(char c) {
+    return c >= 'A' && c <= 'Z';
+}
+
+bool isWordStart(char c) {
+    return !isDigit(c) && c != '_' && c != 0;
+}
+
+bool isWordEnd(char c, char previous) {
+    return c == '_' || c == 0 || (!isUpperLetter(previous) && isUpperLetter(c));
+}
+
+/// Stack machine of swift demangler, only keeping operators needed by routable symbols.
+class Demangler {
+public:
+    Demangler(const char *text, size_t length, bool oldFunctionMangling) : text_(text), length_(length), pos_(0), oldFunctionMangling_(oldFunctionMangling) {}
+
+    /// Demangle the name after the mangling prefix. Return the top level entity, or nullptr when the mangling is not supported.
+    const Node *demangle() {
+        while (pos_ < length_) {
+            const Node *node = demangleOperator();
+            if (node == nullptr || nodes_.size() > MaxNodeCount) {
+                return nullptr;
+            }
+            stack_.push_back(node);
+        }
+        if (stack_.size() != 1) {
+            return nullptr;
+        }
+        const Node *entity = stack_.back();
+        if (entity->kind != Node::Initializer && entity->kind != Node::MetadataAccessor) {
+            return nullptr;
+        }
+        return entity;
+    }
+
+private:
+    char peekChar() const {
+        return pos_ < length_ ? text_[pos_] : 0;
+    }
+
+    char nextChar() {
+        return pos_ < length_ ? text_[pos_++] : 0;
+    }
+
+    bool nextIf(char c) {
+        if (peekChar() != c || c == 0) {
+            return false;
+        }
+        pos_++;
+        return true;
+    }
+
+    Node *createNode(Node::Kind kind, const std::string &text = std::string()) {
+        nodes_.push_back(Node());
+        Node *node = &nodes_.back();
+        node->kind = kind;
+        node->code = 0;
+        node->text = text;
+        node->depth = 0;
+        node->index = 0;
+        return node;
+    }
+
+    const Node *popNode() {
+        if (stack_.empty()) {
+            return nullptr;
+        }
+        const Node *node = stack_.back();
+        stack_.pop_back();
+        return node;
+    }
+
+    const Node *popNode(Node::Kind kind) {
+        if (stack_.empty() || stack_.back()->kind != kind) {
+            return nullptr;
+        }
+        return popNode();
+    }
+
+    const Node *popType() {
+        if (stack_.empty() || !stack_.back()->isType()) {
+            return nullptr;
+        }
+        return popNode();
+    }
+
+    const Node *popModule() {
+        if (const Node *identifier = popNode(Node::Identifier)) {
+            return createNode(Node::Module, identifier->text);
+        }
+        return popNode(Node::Module);
+    }
+
+    const Node *popContext() {
+        if (const Node *module = popModule()) {
+            return module;
+        }
+        if (stack_.empty()) {
+            return nullptr;
+        }
+        Node::Kind kind = stack_.back()->kind;
+        if (kind == Node::Nominal || kind == Node::Extension) {
+            return popNode();
+        }
+        return nullptr;
+    }
+
+    const Node *popProtocol() {
+        if (const Node *type = popType()) {
+            return type->kind == Node::Nominal && type->code == 'P' ? type : nullptr;
+        }
+        const Node *name = popNode(Node::Identifier);
+        const Node *context = popContext();
+        if (name == nullptr || context == nullptr) {
+            return nullptr;
+        }
+        Node *protocol = createNode(Node::Nominal, name->text);
+        protocol->code = 'P';
+        protocol->children.push_back(context);
+        return protocol;
+    }
+
+    int demangleNatural() {
+        if (!isDigit(peekChar())) {
+            return -1000;
+        }
+        int number = 0;
+        while (isDigit(peekChar())) {
+            int next = number * 10 + (nextChar() - '0');
+            if (next < number || next > (1 << 24)) {
+                return -1000;
+            }
+            number = next;
+        }
+        return number;
+    }
+
+    int demangleIndex() {
+        if (nextIf('_')) {
+            return 0;
+        }
+        if (isDigit(peekChar())) {
+            int number = demangleNatural();
+            if (number >= 0 && nextIf('_')) {
+                return number + 1;
+            }
+        }
+        return -1000;
+    }
+
+    const Node *demangleOperator() {
+        char c = nextChar();
+        switch (c) {
+            case 'A': return demangleMultiSubstitutions();
+            case 'C':
+            case 'V':
+            case 'O':
+            case 'P':
+            case 'a': return demangleNominalType(c);
+            case 'E': return demangleExtensionContext();
+            case 'G': return demangleBoundGenericType();
+            case 'K': return createNode(Node::ThrowsAnnotation);
+            case 'M': return nextIf('a') ? createWithPoppedType(Node::MetadataAccessor) : nullptr;
+            case 'R': return demangleGenericRequirement();
+            case 'S': return demangleStandardSubstitution();
+            case 'X': return demangleSpecialType();
+            case 'c': return popFunctionType();
+            case 'f': return demangleFunctionEntity();
+            case 'l': return demangleGenericSignature(false);
+            case 'm': return createWithPoppedType(Node::Metatype);
+            case 'p': return demangleProtocolList('p');
+            case 'q': return demangleGenericParamIndex();
+            case 'r': return demangleGenericSignature(true);
+            case 's': return createNode(Node::Module, StandardLibraryModule);
+            case 't': return popTuple();
+            case 'x': return createGenericParam(0, 0);
+            case 'y': return createNode(Node::EmptyList);
+            case '_': return createNode(Node::FirstElementMarker);
+            default:
+                if (isDigit(c)) {
+                    pos_--;
+                    return demangleIdentifier();
+                }
+                return nullptr;
+        }
+    }
+
+    const Node *demangleIdentifier() {
+        bool hasWordSubstitutions = false;
+        if (nextIf('0')) {
+            if (peekChar() == '0') {
+                // Punycode
+                return nullptr;
+            }
+            hasWordSubstitutions = true;
+        }
+        std::string identifier;
+        do {
+            while (hasWordSubstitutions && (isLowerLetter(peekChar()) || isUpperLetter(peekChar()))) {
+                char c = nextChar();
+                size_t wordIndex;
+                if (isLowerLetter(c)) {
+                    wordIndex = c - 'a';
+                } else {
+                    wordIndex = c - 'A';
+                    hasWordSubstitutions = false;
+                }
+                if (wordIndex >= words_.size()) {
+                    return nullptr;
+                }
+                identifier += words_[wordIndex];
+            }
+            if (nextIf('0')) {
+                break;
+            }
+            int count = demangleNatural();
+            if (count <= 0 || pos_ + count > length_) {
+                return nullptr;
+            }
+            const char *slice = text_ + pos_;
+            identifier.append(slice, count);
+            int wordStart = -1;
+            for (int i = 0; i <= count; i++) {
+                char c = i < count ? slice[i] : 0;
+                if (wordStart >= 0 && isWordEnd(c, slice[i - 1])) {
+                    if (i - wordStart >= 2 && words_.size() < MaxNumWords) {
+                        words_.push_back(std::string(slice + wordStart, i - wordStart));
+                    }
+                    wordStart = -1;
+                }
+                if (wordStart < 0 && isWordStart(c)) {
+                    wordStart = i;
+                }
+            }
+            pos_ += count;
+        } while (hasWordSubstitutions);
+        if (identifier.empty()) {
+            return nullptr;
+        }
+        const Node *node = createNode(Node::Identifier, identifier);
+        substitutions_.push_back(node);
+        return node;
+    }
+
+    const Node *demangleMultiSubstitutions() {
+        int repeatCount = -1;
+        while (true) {
+            char c = nextChar();
+            if (isLowerLetter(c)) {
+                const Node *node = pushMultiSubstitutions(repeatCount, c - 'a');
+                if (node == nullptr) {
+                    return nullptr;
+                }
+                stack_.push_back(node);
+                repeatCount = -1;
+                continue;
+            }
+            if (isUpperLetter(c)) {
+                return pushMultiSubstitutions(repeatCount, c - 'A');
+            }
+            if (c == '_') {
+                size_t index = static_cast<size_t>(repeatCount + 27);
+                return index < substitutions_.size() ? substitutions_[index] : nullptr;
+            }
+            if (c == 0) {
+                return nullptr;
+            }
+            pos_--;
+            repeatCount = demangleNatural();
+            if (repeatCount < 0) {
+                return nullptr;
+            }
+        }
+    }
+
+    const Node *pushMultiSubstitutions(int repeatCount, size_t index) {
+        if (index >= substitutions_.size() || repeatCount > MaxRepeatCount) {
+            return nullptr;
+        }
+        const Node *node = substitutions_[index];
+        while (repeatCount-- > 1) {
+            stack_.push_back(node);
+        }
+        return node;
+    }
+
+    const Node *demangleStandardSubstitution() {
+        char c = nextChar();
+        switch (c) {
+            case 'o': return createNode(Node::Module, ObjCModule);
+            case 'C': return createNode(Node::Module, ClangImporterModule);
+            case 'g': {
+                const Node *wrapped = popType();
+                if (wrapped == nullptr) {
+                    return nullptr;
+                }
+                Node *optional = createNode(Node::BoundGeneric);
+                optional->children.push_back(createStandardType('O', "Optional"));
+                optional->children.push_back(wrapped);
+                substitutions_.push_back(optional);
+                return optional;
+            }
+            case 0:
+                return nullptr;
+            default: {
+                pos_--;
+                int repeatCount = demangleNatural();
+                if (repeatCount > MaxRepeatCount) {
+                    return nullptr;
+                }
+                char code = nextChar();
+                for (const StandardType &type : StandardTypes) {
+                    if (type.code == code) {
+                        const Node *node = createStandardType(type.kind, type.name);
+                        while (repeatCount-- > 1) {
+                            stack_.push_back(node);
+                        }
+                        return node;
+                    }
+                }
+                // Concurrency types with `Sc` and unknown types
+                return nullptr;
+            }
+        }
+    }
+
+    const Node *createStandardType(char kind, const char *name) {
+        Node *type = createNode(Node::Nominal, name);
+        type->code = kind;
+        type->children.push_back(createNode(Node::Module, StandardLibraryModule));
+        return type;
+    }
+
+    const Node *createGenericParam(int depth, int index) {
+        if (depth < 0 || index < 0) {
+            return nullptr;
+        }
+        Node *param = createNode(Node::GenericParam);
+        param->depth = depth;
+        param->index = index;
+        return param;
+    }
+
+    const Node *createWithPoppedType(Node::Kind kind) {
+        const Node *type = popType();
+        if (type == nullptr) {
+            return nullptr;
+        }
+        Node *node = createNode(kind);
+        node->children.push_back(type);
+        return node;
+    }
+
+    const Node *demangleNominalType(char kind) {
+        const Node *name = popNode(Node::Identifier);
+        const Node *context = popContext();
+        if (name == nullptr || context == nullptr) {
+            return nullptr;
+        }
+        Node *type = createNode(Node::Nominal, name->text);
+        type->code = kind;
+        type->children.push_back(context);
+        substitutions_.push_back(type);
+        return type;
+    }
+
+    const Node *demangleExtensionContext() {
+        const Node *signature = popNode(Node::Signature);
+        const Node *module = popModule();
+        const Node *type = popNode(Node::Nominal);
+        if (module == nullptr || type == nullptr) {
+            return nullptr;
+        }
+        Node *extension = createNode(Node::Extension);
+        extension->children.push_back(module);
+        extension->children.push_back(type);
+        if (signature) {
+            extension->children.push_back(signature);
+        }
+        return extension;
+    }
+
+    const Node *demangleBoundGenericType() {
+        std::vector<const Node *> arguments;
+        while (const Node *type = popType()) {
+            arguments.insert(arguments.begin(), type);
+        }
+        // Arguments of generic parents are separated by `_`, they're not supported
+        if (popNode(Node::EmptyList) == nullptr) {
+            return nullptr;
+        }
+        const Node *nominal = popNode(Node::Nominal);
+        if (nominal == nullptr || arguments.empty()) {
+            return nullptr;
+        }
+        Node *type = createNode(Node::BoundGeneric);
+        type->children.push_back(nominal);
+        type->children.insert(type->children.end(), arguments.begin(), arguments.end());
+        substitutions_.push_back(type);
+        return type;
+    }
+
+    Node *demangleProtocolList(char kind) {
+        Node *list = createNode(Node::ProtocolList);
+        list->code = kind;
+        if (popNode(Node::EmptyList) == nullptr) {
+            bool isFirstElement = false;
+            do {
+                isFirstElement = popNode(Node::FirstElementMarker) != nullptr;
+                const Node *protocol = popProtocol();
+                if (protocol == nullptr) {
+                    return nullptr;
+                }
+                list->children.insert(list->children.begin(), protocol);
+            } while (!isFirstElement);
+        }
+        return list;
+    }
+
+    const Node *demangleSpecialType() {
+        char c = nextChar();
+        if (c == 'l') {
+            return demangleProtocolList('l');
+        }
+        if (c == 'c') {
+            const Node *superclass = popType();
+            if (superclass == nullptr) {
+                return nullptr;
+            }
+            Node *list = demangleProtocolList('c');
+            if (list == nullptr) {
+                return nullptr;
+            }
+            list->children.push_back(superclass);
+            return list;
+        }
+        return nullptr;
+    }
+
+    const Node *demangleGenericParamIndex() {
+        if (nextIf('d')) {
+            int depth = demangleIndex() + 1;
+            int index = demangleIndex();
+            return createGenericParam(depth, index);
+        }
+        if (nextIf('z')) {
+            return createGenericParam(0, 0);
+        }
+        return createGenericParam(0, demangleIndex() + 1);
+    }
+
+    const Node *demangleGenericRequirement() {
+        char kind;
+        switch (nextChar()) {
+            case 'b': kind = 'b'; break;
+            case 's': kind = 's'; break;
+            case 'l': kind = 'l'; break;
+            case 'c': case 'C': case 'B': case 't': case 'T': case 'S': case 'm': case 'M': case 'L': case 'p': case 'P': case 'Q':
+                // Requirements of associated types
+                return nullptr;
+            default:
+                kind = 'p';
+                pos_--;
+                break;
+        }
+        const Node *subject = demangleGenericParamIndex();
+        if (subject == nullptr) {
+            return nullptr;
+        }
+        Node *requirement = createNode(Node::Requirement);
+        requirement->children.push_back(subject);
+        const Node *constraint = nullptr;
+        switch (kind) {
+            case 'p':
+                requirement->code = ':';
+                constraint = popProtocol();
+                break;
+            case 'b':
+                requirement->code = ':';
+                constraint = popType();
+                break;
+            case 's':
+                requirement->code = '=';
+                constraint = popType();
+                break;
+            default: {
+                requirement->code = 'l';
+                const char *name = nullptr;
+                switch (nextChar()) {
+                    case 'U': name = "_UnknownLayout"; break;
+                    case 'R': name = "_RefCountedObject"; break;
+                    case 'N': name = "_NativeRefCountedObject"; break;
+                    case 'C': name = "AnyObject"; break;
+                    case 'D': name = "_NativeClass"; break;
+                    case 'T': name = "_Trivial"; break;
+                    default: return nullptr;
+                }
+                requirement->text = name;
+                return requirement;
+            }
+        }
+        if (constraint == nullptr) {
+            return nullptr;
+        }
+        requirement->children.push_back(constraint);
+        return requirement;
+    }
+
+    const Node *demangleGenericSignature(bool hasParamCounts) {
+        Node *signature = createNode(Node::Signature);
+        if (hasParamCounts) {
+            while (!nextIf('l')) {
+                int count = 0;
+                if (!nextIf('z')) {
+                    count = demangleIndex() + 1;
+                }
+                if (count < 0 || pos_ >= length_) {
+                    return nullptr;
+                }
+                signature->counts.push_back(count);
+            }
+        } else {
+            signature->counts.push_back(1);
+        }
+        while (const Node *requirement = popNode(Node::Requirement)) {
+            signature->children.insert(signature->children.begin(), requirement);
+        }
+        return signature;
+    }
+
+    const Node *popTuple() {
+        Node *tuple = createNode(Node::Tuple);
+        if (popNode(Node::EmptyList) == nullptr) {
+            bool isFirstElement = false;
+            do {
+                isFirstElement = popNode(Node::FirstElementMarker) != nullptr;
+                std::string label;
+                if (const Node *identifier = popNode(Node::Identifier)) {
+                    label = identifier->text;
+                }
+                const Node *type = popType();
+                if (type == nullptr) {
+                    return nullptr;
+                }
+                tuple->children.insert(tuple->children.begin(), type);
+                tuple->labels.insert(tuple->labels.begin(), label);
+            } while (!isFirstElement);
+        }
+        return tuple;
+    }
+
+    const Node *popFunctionParams() {
+        if (popNode(Node::EmptyList)) {
+            return createNode(Node::Tuple);
+        }
+        return popType();
+    }
+
+    const Node *popFunctionType() {
+        Node *function = createNode(Node::Function);
+        if (popNode(Node::ThrowsAnnotation)) {
+            function->code = 'K';
+        }
+        const Node *params = popFunctionParams();
+        const Node *result = popFunctionParams();
+        if (params == nullptr || result == nullptr) {
+            return nullptr;
+        }
+        function->children.push_back(params);
+        function->children.push_back(result);
+        return function;
+    }
+
+    /// Pop argument labels before the function type of an entity. They're not printed in routable symbols, only removed from the stack.
+    bool popFunctionParamLabels(const Node *function) {
+        // Functions without labels have `y` instead of labels, except functions without parameters
+        if (oldFunctionMangling_ || popNode(Node::EmptyList)) {
+            return true;
+        }
+        const Node *params = function->children[0];
+        size_t count = params->kind == Node::Tuple ? params->children.size() : 1;
+        for (size_t i = 0; i < count; i++) {
+            if (popNode(Node::Identifier) == nullptr && popNode(Node::FirstElementMarker) == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const Node *demangleFunctionEntity() {
+        char c = nextChar();
+        if (c != 'C' && c != 'c') {
+            return nullptr;
+        }
+        const Node *function = popNode(Node::Function);
+        if (function == nullptr || !popFunctionParamLabels(function)) {
+            return nullptr;
+        }
+        const Node *context = popContext();
+        if (context == nullptr) {
+            return nullptr;
+        }
+        Node *entity = createNode(Node::Initializer);
+        entity->children.push_back(context);
+        entity->children.push_back(function);
+        return entity;
+    }
+
+    const char *text_;
+    size_t length_;
+    size_t pos_;
+    /// Swift 4 mangles argument labels in the tuple of parameters, instead of before the function type.
+    bool oldFunctionMangling_;
+    std::deque<Node> nodes_;
+    std::vector<const Node *> stack_;
+    std::vector<const Node *> substitutions_;
+    std::vector<std::string> words_;
+};
+
+std::string genericParamName(unsigned depth, unsigned index) {
+    std::string name;
+    do {
+        name += static_cast<char>('A' + index % 26);
+        index /= 26;
+    } while (index);
+    if (depth != 0) {
+        name += std::to_string(depth);
+    }
+    return name;
+}
+
+void print(const Node *node, std::string &output);
+
+void printChildren(const std::vector<const Node *> &children, size_t begin, size_t end, const char *separator, std::string &output) {
+    for (size_t i = begin; i < end; i++) {
+        if (i > begin) {
+            output += separator;
+        }
+        print(children[i], output);
+    }
+}
+
+bool isSimpleType(const Node *type) {
+    switch (type->kind) {
+        case Node::Function:
+            return false;
+        case Node::ProtocolList:
+            return type->code == 'p' && type->children.size() <= 1;
+        default:
+            return true;
+    }
+}
+
+/// Print like NodePrinter of swift demangler with default options.
+void print(const Node *node, std::string &output) {
+    switch (node->kind) {
+        case Node::Identifier:
+        case Node::Module:
+            output += node->text;
+            break;
+        case Node::Nominal:
+            print(node->children[0], output);
+            output += '.';
+            output += node->text;
+            break;
+        case Node::BoundGeneric:
+            print(node->children[0], output);
+            output += '<';
+            printChildren(node->children, 1, node->children.size(), ", ", output);
+            output += '>';
+            break;
+        case Node::ProtocolList:
+            if (node->code == 'c') {
+                print(node->children.back(), output);
+                if (node->children.size() > 1) {
+                    output += " & ";
+                    printChildren(node->children, 0, node->children.size() - 1, " & ", output);
+                }
+            } else if (node->code == 'l') {
+                if (!node->children.empty()) {
+                    printChildren(node->children, 0, node->children.size(), " & ", output);
+                    output += " & ";
+                }
+                output += "Swift.AnyObject";
+            } else if (node->children.empty()) {
+                output += "Any";
+            } else {
+                printChildren(node->children, 0, node->children.size(), " & ", output);
+            }
+            break;
+        case Node::GenericParam:
+            output += genericParamName(node->depth, node->index);
+            break;
+        case Node::Metatype: {
+            const Node *instance = node->children[0];
+            bool simple = isSimpleType(instance);
+            if (!simple) {
+                output += '(';
+            }
+            print(instance, output);
+            if (!simple) {
+                output += ')';
+            }
+            output += instance->kind == Node::ProtocolList ? ".Protocol" : ".Type";
+            break;
+        }
+        case Node::Tuple:
+            output += '(';
+            for (size_t i = 0; i < node->children.size(); i++) {
+                if (i > 0) {
+                    output += ", ";
+                }
+                if (!node->labels[i].empty()) {
+                    output += node->labels[i];
+                    output += ": ";
+                }
+                print(node->children[i], output);
+            }
+            output += ')';
+            break;
+        case Node::Function: {
+            const Node *params = node->children[0];
+            if (params->kind != Node::Tuple) {
+                output += '(';
+            }
+            print(params, output);
+            if (params->kind != Node::Tuple) {
+                output += ')';
+            }
+            if (node->code == 'K') {
+                output += " throws";
+            }
+            output += " -> ";
+            print(node->children[1], output);
+            break;
+        }
+        case Node::Requirement:
+            print(node->children[0], output);
+            if (node->code == 'l') {
+                output += ": ";
+                output += node->text;
+            } else {
+                output += node->code == '=' ? " == " : ": ";
+                print(node->children[1], output);
+            }
+            break;
+        case Node::Signature:
+            output += '<';
+            for (size_t depth = 0; depth < node->counts.size(); depth++) {
+                if (depth != 0) {
+                    output += "><";
+                }
+                for (unsigned index = 0; index < node->counts[depth]; index++) {
+                    if (index != 0) {
+                        output += ", ";
+                    }
+                    if (index >= 128) {
+                        output += "...";
+                        break;
+                    }
+                    output += genericParamName(static_cast<unsigned>(depth), index);
+                }
+            }
+            if (!node->children.empty()) {
+                output += " where ";
+                printChildren(node->children, 0, node->children.size(), ", ", output);
+            }
+            output += '>';
+            break;
+        case Node::Extension:
+            output += "(extension in ";
+            print(node->children[0], output);
+            output += "):";
+            print(node->children[1], output);
+            if (node->children.size() > 2) {
+                print(node->children[2], output);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+std::string printed(const Node *node) {
+    std::string output;
+    print(node, output);
+    return output;
+}
+
+/// The routable type when the node is one of them, or nullptr.
+const char *routableTypeName(const Node *nominal) {
+    if (nominal->kind != Node::Nominal || nominal->code != 'V') {
+        return nullptr;
+    }
+    const Node *context = nominal->children[0];
+    if (context->kind != Node::Module || context->text != RoutableModule) {
+        return nullptr;
+    }
+    for (const char *name : RoutableTypeNames) {
+        if (nominal->text == name) {
+            return name;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+RoutableSymbolParser::Result RoutableSymbolParser::parse(const char *name, RoutableSymbol &symbol) {
+    if (name == nullptr) {
+        return Unsupported;
+    }
+    if (name[0] == '_' && (name[1] == '$' || name[1] == '_')) {
+        name++;
+    }
+    bool oldFunctionMangling = false;
+    if (strncmp(name, "$s", 2) == 0 || strncmp(name, "$S", 2) == 0) {
+        name += 2;
+    } else if (strncmp(name, "_T0", 3) == 0) {
+        name += 3;
+        oldFunctionMangling = true;
+    } else {
+        return Unsupported;
+    }
+    // Suffixes such as `.cold.1` are not part of the mangling
+    const char *suffix = strchr(name, '.');
+    size_t length = suffix ? static_cast<size_t>(suffix - name) : strlen(name);
+
+    Demangler demangler(name, length, oldFunctionMangling);
+    const Node *entity = demangler.demangle();
+    if (entity == nullptr) {
+        return Unsupported;
+    }
+
+    if (entity->kind == Node::MetadataAccessor) {
+        const Node *type = entity->children[0];
+        if (type->kind != Node::BoundGeneric || type->children.size() != 2) {
+            return Ignored;
+        }
+        const char *routable = routableTypeName(type->children[0]);
+        if (routable == nullptr) {
+            return Ignored;
+        }
+        symbol = RoutableSymbol();
+        symbol.kind = RoutableSymbol::RoutingType;
+        symbol.routable = routable;
+        symbol.protocolName = printed(type->children[1]);
+        return Parsed;
+    }
+
+    // Initializers in constrained extensions
+    const Node *extension = entity->children[0];
+    if (extension->kind != Node::Extension || extension->children.size() < 3) {
+        return Ignored;
+    }
+    const char *routable = routableTypeName(extension->children[1]);
+    if (routable == nullptr) {
+        return Ignored;
+    }
+    std::string module = extension->children[0]->text;
+    std::string signature = printed(extension->children[2]);
+    if (module == RoutableModule) {
+        symbol = RoutableSymbol();
+        symbol.kind = RoutableSymbol::ConstrainedInitializer;
+        symbol.routable = routable;
+        symbol.module = module;
+        symbol.signature = signature;
+        return Parsed;
+    }
+    const Node *result = entity->children[1]->children[1];
+    if (result->kind != Node::BoundGeneric || result->children.size() != 2 || routableTypeName(result->children[0]) != routable) {
+        return Ignored;
+    }
+    symbol = RoutableSymbol();
+    symbol.kind = RoutableSymbol::Declaration;
+    symbol.routable = routable;
+    symbol.protocolName = printed(result->children[1]);
+    symbol.module = module;
+    symbol.signature = signature;
+    return Parsed;
+}
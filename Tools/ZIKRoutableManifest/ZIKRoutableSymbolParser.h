@@ -0,0 +1,68 @@
+//
+//  ZIKRoutableSymbolParser.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKRoutableSymbolParser_h
+#define ZIKRoutableSymbolParser_h
+
+#include <string>
+
+namespace zix {
+
+/// A swift symbol declaring or using RoutableService, RoutableServiceModule, RoutableView or RoutableViewModule.
+struct RoutableSymbol {
+    enum Kind {
+        /// Initializer in a constrained extension of a routable type in another module, such as `extension RoutableService where Protocol == LoginServiceInput { init() {} }`. It declares the protocol as routable.
+        Declaration,
+        /// Type metadata accessor of a routable type with a generic argument, such as `RoutableService<LoginServiceInput>`. It's emitted where the type is used.
+        RoutingType,
+        /// Initializer in a constrained extension in ZRouter itself. Some of them are only used by wrong generic arguments.
+        ConstrainedInitializer,
+    };
+    Kind kind;
+    /// Name of the routable type, such as "RoutableService".
+    std::string routable;
+    /// Generic argument of the routable type, as printed by swift demangler, such as "MyApp.LoginServiceInput" or "__C.ZIKLoginServiceInput". Empty for constrained initializers.
+    std::string protocolName;
+    /// Module of the extension. Empty for routing types.
+    std::string module;
+    /// Generic signature of the extension, such as "<A where A == MyApp.LoginServiceInput>". Empty for routing types.
+    std::string signature;
+};
+
+/**
+ Read routable declarations and usages from swift mangled names, without swift runtime.
+
+ It's a subset of swift demangler, supporting types appearing in generic arguments and initializers of routable types: nominal types, protocol compositions, bound generic types, tuples, functions, metatypes, generic parameters and generic signatures. Names are printed the same as `swift_demangle` with default options.
+ */
+class RoutableSymbolParser {
+public:
+    enum Result {
+        /// The symbol is a routable declaration or usage.
+        Parsed,
+        /// The symbol is about a routable type, but doesn't declare or use a protocol, such as initializers of RoutableService itself.
+        Ignored,
+        /// The symbol uses mangling not supported by the parser.
+        Unsupported,
+    };
+
+    /**
+     Parse a symbol name.
+
+     @param name The symbol name, with or without the leading `_` of Mach-O symbols. Suffixes after `.` are ignored.
+     @param symbol The declaration or usage when it's parsed.
+     @return Parsed, Ignored or Unsupported.
+     */
+    static Result parse(const char *name, RoutableSymbol &symbol);
+};
+
+} // namespace zix
+
+#endif /* ZIKRoutableSymbolParser_h */
@@ -0,0 +1,143 @@
+//
+//  main.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+//  Command line tool finding routable declarations and usages of ZRouter in Mach-O binaries, and writing them as a manifest. Copy the manifest into the app bundle as ZIKRoutableManifest.json, then ZRouter validates routes with it instead of demangling symbols at launch. It doesn't depend on Apple's headers or swift runtime, so it can run on macOS or Linux build machines.
+//
+//  Build:
+//  c++ -std=c++11 -O2 -I ZIKRouter/Utilities/MachO -I ZIKRouter/Utilities/Debug -o zikrouter-manifest Tools/ZIKRoutableManifest/*.cpp ZIKRouter/Utilities/MachO/ZIKMachOImage.cpp ZIKRouter/Utilities/MachO/ZIKSymbolIndex.cpp ZIKRouter/Utilities/Debug/ZIKMangledNameClassifier.cpp
+//
+//  Usage:
+//  zikrouter-manifest [--arch arm64] [-o App.app/ZIKRoutableManifest.json] App.app/App App.app/Frameworks/A.framework/A ...
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "ZIKRoutableManifest.h"
+
+using namespace zix;
+
+namespace {
+
+struct Architecture {
+    const char *name;
+    int32_t cpuType;
+    int32_t cpuSubtype;
+};
+
+const Architecture Architectures[] = {
+    {"arm64", 0x0100000c, 0},
+    {"arm64e", 0x0100000c, 2},
+    {"arm64_32", 0x0200000c, 1},
+    {"armv7", 12, 9},
+    {"armv7s", 12, 11},
+    {"x86_64", 0x01000007, RoutableManifest::AnyCPU},
+    {"i386", 7, RoutableManifest::AnyCPU},
+};
+
+void printUsage() {
+    fprintf(stderr, "usage: zikrouter-manifest [--arch <arch>] [-o <output.json>] <binary>...\n");
+    fprintf(stderr, "  --arch  Only read the architecture in FAT binaries. Default is all architectures.\n");
+    fprintf(stderr, "  -o      Output file. Default is stdout.\n");
+}
+
+bool readFile(const char *path, std::vector<uint8_t> &content) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    content.clear();
+    uint8_t buffer[64 * 1024];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.insert(content.end(), buffer, buffer + length);
+    }
+    bool succeeded = ferror(file) == 0;
+    fclose(file);
+    return succeeded;
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    int32_t cpuType = RoutableManifest::AnyCPU;
+    int32_t cpuSubtype = RoutableManifest::AnyCPU;
+    const char *outputPath = nullptr;
+    std::vector<const char *> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        const char *argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argument, "--arch") == 0 && hasValue) {
+            const char *name = argv[++i];
+            bool found = false;
+            for (const Architecture &architecture : Architectures) {
+                if (strcmp(architecture.name, name) == 0) {
+                    cpuType = architecture.cpuType;
+                    cpuSubtype = architecture.cpuSubtype;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "error: unknown architecture %s\n", name);
+                return 1;
+            }
+        } else if (strcmp(argument, "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else if (strcmp(argument, "-h") == 0 || strcmp(argument, "--help") == 0) {
+            printUsage();
+            return 0;
+        } else if (argument[0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    RoutableManifest manifest;
+    for (const char *input : inputs) {
+        std::vector<uint8_t> content;
+        if (!readFile(input, content)) {
+            fprintf(stderr, "error: can't read %s\n", input);
+            return 1;
+        }
+        std::string error;
+        if (!manifest.addFile(content.data(), content.size(), cpuType, cpuSubtype, input, error)) {
+            fprintf(stderr, "error: %s: %s\n", input, error.c_str());
+            return 1;
+        }
+    }
+    for (const std::string &symbol : manifest.unsupportedSymbols()) {
+        fprintf(stderr, "warning: can't parse %s, the manifest is incomplete and ZRouter will search symbols at launch\n", symbol.c_str());
+    }
+
+    std::string json = manifest.json();
+    FILE *output = outputPath ? fopen(outputPath, "wb") : stdout;
+    if (output == nullptr) {
+        fprintf(stderr, "error: can't write %s\n", outputPath);
+        return 1;
+    }
+    bool succeeded = fwrite(json.data(), 1, json.size(), output) == json.size();
+    if (outputPath) {
+        succeeded = fclose(output) == 0 && succeeded;
+    }
+    if (!succeeded) {
+        fprintf(stderr, "error: can't write %s\n", outputPath ? outputPath : "stdout");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,219 @@
+//
+//  ZIKRouterIndexer.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKRouterIndexer.h"
+#include "ZIKMachOFixups.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace zix;
+
+namespace {
+
+const char *const ViewRouterClassName = "ZIKViewRouter";
+const char *const ServiceRouterClassName = "ZIKServiceRouter";
+const char *const ClassSymbolPrefix = "_OBJC_CLASS_$_";
+
+/// Segments containing __objc_classlist.
+const char *const ClassListSegments[] = {"__DATA", "__DATA_CONST", "__DATA_DIRTY"};
+
+/// Swift flags in low bits of class data pointer.
+const uint64_t ClassDataMask = ~static_cast<uint64_t>(7);
+
+/// Depth limit of superclass chain, in case of broken binaries with cycles.
+const size_t MaxClassDepth = 1024;
+
+std::string hexString(uint64_t value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+std::string quotedString(const std::string &string) {
+    std::string result = "\"";
+    for (char c : string) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+bool readRebasedPointer(const MachOFixups &fixups, uint64_t vmaddr, uint64_t &target) {
+    MachOFixup fixup;
+    if (!fixups.readPointer(vmaddr, fixup) || fixup.kind != MachOFixup::Rebase) {
+        return false;
+    }
+    target = fixup.target;
+    return true;
+}
+
+} // namespace
+
+bool RouterIndexer::addFile(const void *bytes, size_t size, int32_t cpuType, int32_t cpuSubtype, std::string &error) {
+    std::vector<MachOFatSlice> slices;
+    if (!readFatSlices(bytes, size, slices)) {
+        if (size < sizeof(macho::mach_header)) {
+            error = "not a Mach-O file";
+            return false;
+        }
+        MachOFatSlice thin;
+        memcpy(&thin.cpuType, static_cast<const uint8_t *>(bytes) + 4, sizeof(int32_t));
+        memcpy(&thin.cpuSubtype, static_cast<const uint8_t *>(bytes) + 8, sizeof(int32_t));
+        thin.offset = 0;
+        thin.size = size;
+        slices.push_back(thin);
+    }
+    bool matched = false;
+    for (const MachOFatSlice &slice : slices) {
+        if (cpuType != AnyCPU && slice.cpuType != cpuType) {
+            continue;
+        }
+        if (cpuSubtype != AnyCPU && (slice.cpuSubtype & 0x00ffffff) != cpuSubtype) {
+            continue;
+        }
+        matched = true;
+        MachOImage image;
+        if (!image.parse(static_cast<const uint8_t *>(bytes) + slice.offset, static_cast<size_t>(slice.size), MachOImage::LayoutFile)) {
+            error = "invalid Mach-O image at offset " + hexString(slice.offset);
+            return false;
+        }
+        if (!addImage(image, error)) {
+            return false;
+        }
+    }
+    if (!matched) {
+        error = "no slice matches the architecture";
+        return false;
+    }
+    return true;
+}
+
+bool RouterIndexer::addImage(const MachOImage &image, std::string &error) {
+    MachOFixups fixups;
+    if (!fixups.parse(image)) {
+        error = "invalid fixups";
+        return false;
+    }
+    uint64_t pointerSize = image.is64Bit() ? 8 : 4;
+    for (const char *segname : ClassListSegments) {
+        MachOSection section;
+        if (!image.findSection(segname, "__objc_classlist", section)) {
+            continue;
+        }
+        for (uint64_t offset = 0; offset + pointerSize <= section.size; offset += pointerSize) {
+            uint64_t classAddress;
+            if (!readRebasedPointer(fixups, section.addr + offset, classAddress) || classAddress == 0) {
+                error = "invalid class list entry at " + hexString(section.addr + offset);
+                return false;
+            }
+            std::string className;
+            if (!readClassName(image, fixups, classAddress, className)) {
+                error = "invalid class at " + hexString(classAddress);
+                return false;
+            }
+            std::string superclassName;
+            MachOFixup superclass;
+            if (!fixups.readPointer(classAddress + pointerSize, superclass)) {
+                error = "invalid superclass of " + className;
+                return false;
+            }
+            if (superclass.kind == MachOFixup::Bind) {
+                // Superclass in another image
+                const std::string &symbol = fixups.imports()[superclass.importIndex].name;
+                size_t prefixLength = strlen(ClassSymbolPrefix);
+                superclassName = symbol.compare(0, prefixLength, ClassSymbolPrefix) == 0 ? symbol.substr(prefixLength) : symbol;
+            } else if (superclass.target != 0 && !readClassName(image, fixups, superclass.target, superclassName)) {
+                error = "invalid superclass of " + className;
+                return false;
+            }
+            definedClasses_.insert(className);
+            superclasses_.insert(std::make_pair(className, superclassName));
+        }
+    }
+    return true;
+}
+
+bool RouterIndexer::readClassName(const MachOImage &image, const MachOFixups &fixups, uint64_t classAddress, std::string &name) const {
+    // class_t is {isa, superclass, cache, vtable, data}
+    uint64_t pointerSize = image.is64Bit() ? 8 : 4;
+    uint64_t data;
+    if (!readRebasedPointer(fixups, classAddress + pointerSize * 4, data) || data == 0) {
+        return false;
+    }
+    // Name of class_ro_t is after flags, instanceStart, instanceSize, (reserved,) and ivarLayout
+    uint64_t nameOffset = image.is64Bit() ? 24 : 16;
+    uint64_t nameAddress;
+    if (!readRebasedPointer(fixups, (data & ClassDataMask) + nameOffset, nameAddress)) {
+        return false;
+    }
+    const char *string = image.stringAtVMAddress(nameAddress);
+    if (string == nullptr || string[0] == '\0') {
+        return false;
+    }
+    name = string;
+    return true;
+}
+
+std::vector<IndexedRouter> RouterIndexer::routers() const {
+    std::vector<IndexedRouter> result;
+    for (const std::string &className : definedClasses_) {
+        if (className == ViewRouterClassName || className == ServiceRouterClassName) {
+            continue;
+        }
+        std::map<std::string, std::string>::const_iterator it = superclasses_.find(className);
+        for (size_t depth = 0; it != superclasses_.end() && depth < MaxClassDepth; depth++) {
+            const std::string &superclass = it->second;
+            if (superclass == ViewRouterClassName || superclass == ServiceRouterClassName) {
+                IndexedRouter router;
+                router.className = className;
+                router.kind = superclass == ViewRouterClassName ? IndexedRouter::View : IndexedRouter::Service;
+                result.push_back(router);
+                break;
+            }
+            it = superclasses_.find(superclass);
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const IndexedRouter &lhs, const IndexedRouter &rhs) {
+        return lhs.kind < rhs.kind;
+    });
+    return result;
+}
+
+std::string RouterIndexer::generateRegistrationSource(const std::vector<IndexedRouter> &routers, const std::string &functionName) {
+    std::string source;
+    source += "//\n";
+    source += "//  Generated by ZIKRouterIndexer. Do not edit.\n";
+    source += "//\n\n";
+    source += "#import <Foundation/Foundation.h>\n";
+    source += "#import <ZIKRouter/ZIKRouteRegistry.h>\n\n";
+    source += "/// Register routers found at build time. Set `ZIKRouteRegistry.autoRegister` to NO, and call it before UIApplicationMain.\n";
+    source += "void " + functionName + "(void);\n\n";
+    source += "static const char *const kZIKIndexedRouterClassNames[] = {\n";
+    const IndexedRouter::Kind kinds[] = {IndexedRouter::View, IndexedRouter::Service};
+    for (IndexedRouter::Kind kind : kinds) {
+        source += kind == IndexedRouter::View ? "    // View routers\n" : "    // Service routers\n";
+        for (const IndexedRouter &router : routers) {
+            if (router.kind == kind) {
+                source += "    " + quotedString(router.className) + ",\n";
+            }
+        }
+    }
+    source += "    NULL\n";
+    source += "};\n\n";
+    source += "void " + functionName + "(void) {\n";
+    source += "    [ZIKRouteRegistry registerRouterClassesWithNames:kZIKIndexedRouterClassNames count:" + std::to_string(routers.size()) + "];\n";
+    source += "}\n";
+    return source;
+}
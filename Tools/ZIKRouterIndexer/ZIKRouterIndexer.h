@@ -0,0 +1,83 @@
+//
+//  ZIKRouterIndexer.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKRouterIndexer_h
+#define ZIKRouterIndexer_h
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+
+class MachOFixups;
+
+/// A router class found by RouterIndexer.
+struct IndexedRouter {
+    enum Kind {
+        View,
+        Service,
+    };
+    /// Runtime name of the class. Swift classes use mangled names.
+    std::string className;
+    Kind kind;
+};
+
+/**
+ Find router classes in Mach-O files without running them.
+
+ Classes are read from `__objc_classlist`. The superclass of each class is either a class in the same image, or an imported `_OBJC_CLASS_$_` symbol, so superclasses in other binaries are resolved by name. Add the app executable and all its frameworks, then every subclass of ZIKViewRouter and ZIKServiceRouter can be found.
+ */
+class RouterIndexer {
+public:
+    /// Any cpu type or subtype.
+    static const int32_t AnyCPU = -1;
+
+    /**
+     Add classes in a thin or FAT Mach-O file.
+
+     @param bytes Content of the file.
+     @param size Size of the file.
+     @param cpuType Only read the slice with the cpu type in FAT file. Pass AnyCPU to read all slices.
+     @param cpuSubtype Only read the slice with the cpu subtype, without capability bits. Pass AnyCPU to ignore subtype.
+     @param error Reason of failure.
+     @return False when the file is not a valid Mach-O file, or no slice matches the cpu type.
+     */
+    bool addFile(const void *bytes, size_t size, int32_t cpuType, int32_t cpuSubtype, std::string &error);
+
+    /// Add classes in a thin image with file layout.
+    bool addImage(const MachOImage &image, std::string &error);
+
+    /// Router classes in all added files, sorted by kind and name. ZIKViewRouter and ZIKServiceRouter themselves are not included.
+    std::vector<IndexedRouter> routers() const;
+
+    /**
+     Generate objc source registering the routers with `+[ZIKRouteRegistry registerRouterClassesWithNames:count:]`.
+
+     @param routers Routers to register.
+     @param functionName Name of the generated C function.
+     @return Content of a .m file.
+     */
+    static std::string generateRegistrationSource(const std::vector<IndexedRouter> &routers, const std::string &functionName);
+
+private:
+    bool readClassName(const MachOImage &image, const MachOFixups &fixups, uint64_t classAddress, std::string &name) const;
+
+    /// Class name to superclass name. Root class has empty superclass name.
+    std::map<std::string, std::string> superclasses_;
+    std::set<std::string> definedClasses_;
+};
+
+} // namespace zix
+
+#endif /* ZIKRouterIndexer_h */
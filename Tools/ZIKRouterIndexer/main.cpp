@@ -0,0 +1,161 @@
+//
+//  main.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+//  Command line tool finding router classes in Mach-O binaries, and generating registration code for them. It doesn't depend on Apple's headers, so it can run on macOS or Linux build machines.
+//
+//  Build:
+//  c++ -std=c++11 -O2 -I ZIKRouter/Utilities/MachO -o zikrouter-indexer Tools/ZIKRouterIndexer/*.cpp ZIKRouter/Utilities/MachO/ZIKMachOImage.cpp ZIKRouter/Utilities/MachO/ZIKMachOFixups.cpp
+//
+//  Usage:
+//  zikrouter-indexer [--arch arm64] [--function ZIKRegisterIndexedRouters] [-o ZIKIndexedRouters.m] App.app/App App.app/Frameworks/A.framework/A ...
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "ZIKRouterIndexer.h"
+
+using namespace zix;
+
+namespace {
+
+struct Architecture {
+    const char *name;
+    int32_t cpuType;
+    int32_t cpuSubtype;
+};
+
+const Architecture Architectures[] = {
+    {"arm64", 0x0100000c, 0},
+    {"arm64e", 0x0100000c, 2},
+    {"arm64_32", 0x0200000c, 1},
+    {"armv7", 12, 9},
+    {"armv7s", 12, 11},
+    {"x86_64", 0x01000007, RouterIndexer::AnyCPU},
+    {"i386", 7, RouterIndexer::AnyCPU},
+};
+
+void printUsage() {
+    fprintf(stderr, "usage: zikrouter-indexer [--arch <arch>] [--function <name>] [-o <output.m>] <binary>...\n");
+    fprintf(stderr, "  --arch      Only read the architecture in FAT binaries. Default is all architectures.\n");
+    fprintf(stderr, "  --function  Name of generated registration function. Default is ZIKRegisterIndexedRouters.\n");
+    fprintf(stderr, "  -o          Output file. Default is stdout.\n");
+}
+
+bool readFile(const char *path, std::vector<uint8_t> &content) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    content.clear();
+    uint8_t buffer[64 * 1024];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.insert(content.end(), buffer, buffer + length);
+    }
+    bool succeeded = ferror(file) == 0;
+    fclose(file);
+    return succeeded;
+}
+
+bool isIdentifier(const std::string &name) {
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+        return false;
+    }
+    for (char c : name) {
+        bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    int32_t cpuType = RouterIndexer::AnyCPU;
+    int32_t cpuSubtype = RouterIndexer::AnyCPU;
+    std::string functionName = "ZIKRegisterIndexedRouters";
+    const char *outputPath = nullptr;
+    std::vector<const char *> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        const char *argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argument, "--arch") == 0 && hasValue) {
+            const char *name = argv[++i];
+            bool found = false;
+            for (const Architecture &architecture : Architectures) {
+                if (strcmp(architecture.name, name) == 0) {
+                    cpuType = architecture.cpuType;
+                    cpuSubtype = architecture.cpuSubtype;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "error: unknown architecture %s\n", name);
+                return 1;
+            }
+        } else if (strcmp(argument, "--function") == 0 && hasValue) {
+            functionName = argv[++i];
+            if (!isIdentifier(functionName)) {
+                fprintf(stderr, "error: invalid function name %s\n", functionName.c_str());
+                return 1;
+            }
+        } else if (strcmp(argument, "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else if (strcmp(argument, "-h") == 0 || strcmp(argument, "--help") == 0) {
+            printUsage();
+            return 0;
+        } else if (argument[0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    RouterIndexer indexer;
+    for (const char *input : inputs) {
+        std::vector<uint8_t> content;
+        if (!readFile(input, content)) {
+            fprintf(stderr, "error: can't read %s\n", input);
+            return 1;
+        }
+        std::string error;
+        if (!indexer.addFile(content.data(), content.size(), cpuType, cpuSubtype, error)) {
+            fprintf(stderr, "error: %s: %s\n", input, error.c_str());
+            return 1;
+        }
+    }
+
+    std::string source = RouterIndexer::generateRegistrationSource(indexer.routers(), functionName);
+    FILE *output = outputPath ? fopen(outputPath, "wb") : stdout;
+    if (output == nullptr) {
+        fprintf(stderr, "error: can't write %s\n", outputPath);
+        return 1;
+    }
+    bool succeeded = fwrite(source.data(), 1, source.size(), output) == source.size();
+    if (outputPath) {
+        succeeded = fclose(output) == 0 && succeeded;
+    }
+    if (!succeeded) {
+        fprintf(stderr, "error: can't write %s\n", outputPath ? outputPath : "stdout");
+        return 1;
+    }
+    return 0;
+}
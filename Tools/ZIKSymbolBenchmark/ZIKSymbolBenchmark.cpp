@@ -0,0 +1,646 @@
+//
+//  ZIKSymbolBenchmark.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKSymbolBenchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include "ZIKAddressIndex.h"
+#include "ZIKExportTrie.h"
+#include "ZIKExportTrieBuilder.h"
+#include "ZIKMachOFile.h"
+#include "ZIKMangledNameClassifier.h"
+#include "ZIKStringTableScanner.h"
+#include "ZIKSymbolEnumerator.h"
+#include "ZIKSymbolIndex.h"
+
+using namespace zix;
+using namespace zix::macho;
+using namespace zix::test;
+
+namespace {
+
+/// Names looked up one by one in each measurement.
+const size_t kLookupCount = 16;
+/// Names looked up together in batch lookup.
+const size_t kBatchSize = 64;
+/// Repeat fast lookups, so each measurement is long enough for the clock.
+const size_t kFastLookupRounds = 1000;
+/// Copies of the image scanned together when comparing serial and parallel scanning, like frameworks in an app.
+const size_t kScanImages = 8;
+
+const char *const Modules[] = {"AppCore", "ZRouter", "Networking", "FeatureFeed", "FeatureLogin", "FeatureProfile", "DesignSystem", "Storage", "Analytics", "MediaKit", "Payment", "ZIKRouter"};
+const char *const Words[] = {"User", "Feed", "Login", "Session", "Router", "View", "Controller", "Service", "Manager", "Cache", "Request", "Response", "Model", "Cell", "Item", "Store", "Provider", "Config", "Image", "Token", "Account", "Profile", "Comment", "Player"};
+const char *const Members[] = {"prepare", "load", "reload", "update", "configure", "perform", "handle", "make", "fetch", "cancel", "present", "dismiss", "title", "identifier", "delegate", "items", "count", "isEnabled"};
+const char *const MethodTypes[] = {"yyF", "SSyF", "ySiF", "yySbF", "11destinationyypSg_tF", "_7handlerySS_yyctF"};
+const char *const AccessorTypes[] = {"Sivg", "SSvg", "Sivs", "SbvM", "SSSgvpMV", "SayypGvg"};
+const char *const MetadataSuffixes[] = {"CMa", "CMn", "CN", "VMn", "VN", "CMo", "CMf", "OMn"};
+const char *const ConformanceSuffixes[] = {"VSQAAMc", "VSHAAWP", "Vs23CustomStringConvertibleAAMc", "CSeAAMc", "CSEAAWP"};
+
+size_t workerThreadCount() {
+    size_t count = std::thread::hardware_concurrency();
+    return count == 0 ? 2 : count;
+}
+
+/// ZIKApplyFunction running work on a thread for each core, like dispatch_apply_f.
+void threadApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    size_t threadCount = std::min(workerThreadCount(), iterations);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.push_back(std::thread([=]() {
+            for (size_t i = t; i < iterations; i += threadCount) {
+                work(context, i);
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+template <size_t N>
+const char *pick(const char *const (&list)[N], std::mt19937 &random) {
+    return list[random() % N];
+}
+
+/// Length prefixed identifier in mangled names.
+std::string identifier(const std::string &name) {
+    return std::to_string(name.size()) + name;
+}
+
+/// Generate symbol names with the distribution of an app binary.
+class NameGenerator {
+public:
+    enum Visibility {
+        Local,
+        Exported,
+        Undefined,
+    };
+
+    explicit NameGenerator(uint32_t seed) : random_(seed) {}
+
+    std::string next(size_t index, Visibility &visibility) {
+        std::string name;
+        do {
+            name = make(index, visibility);
+            // Names are unique in a linked image
+            if (names_.count(name) != 0) {
+                name += "_" + std::to_string(index);
+            }
+        } while (names_.count(name) != 0);
+        names_.insert(name);
+        return name;
+    }
+
+private:
+    std::string make(size_t index, Visibility &visibility) {
+        // Earlier modules have more symbols
+        std::string module = Modules[std::min(random_() % 12, random_() % 12)];
+        // Members of a type are near each other
+        std::string type = std::string(Words[(index / 40) % 24]) + Words[(index / 40 / 24 + random_() % 2) % 24];
+        if (index / 40 >= 24 * 24) {
+            type += std::to_string(index / 40 / 576);
+        }
+        std::string member = std::string(pick(Members, random_)) + (random_() % 3 == 0 ? pick(Words, random_) : "");
+        std::string prefix = "_$s" + identifier(module) + identifier(type);
+        uint32_t kind = random_() % 1000;
+        visibility = random_() % 2 == 0 ? Local : Exported;
+        if (kind < 300) {
+            return prefix + "C" + identifier(member) + pick(MethodTypes, random_);
+        }
+        if (kind < 420) {
+            return prefix + "V" + identifier(member) + pick(AccessorTypes, random_);
+        }
+        if (kind < 500) {
+            visibility = Exported;
+            return prefix + pick(MetadataSuffixes, random_);
+        }
+        if (kind < 560) {
+            visibility = Exported;
+            return prefix + pick(ConformanceSuffixes, random_);
+        }
+        if (kind < 660) {
+            visibility = Local;
+            return prefix + "C" + identifier(member) + "yyFyycfU" + (random_() % 2 ? "_" : "0_");
+        }
+        if (kind < 710) {
+            visibility = Local;
+            return prefix + "C" + identifier(member) + pick(MethodTypes, random_) + (random_() % 2 ? "Si_Tg5" : "SS_Tgq5");
+        }
+        if (kind < 750) {
+            // Swift 4.2
+            return "_$S" + identifier(module) + identifier(type) + "C" + identifier(member) + pick(MethodTypes, random_);
+        }
+        if (kind < 780) {
+            // Swift 4
+            return "_T0" + identifier(module) + identifier(type) + "C" + identifier(member) + "yyF";
+        }
+        if (kind < 850) {
+            switch (random_() % 4) {
+                case 0:
+                    visibility = Exported;
+                    return "_OBJC_CLASS_$_ZIK" + type;
+                case 1:
+                    visibility = Exported;
+                    return "_OBJC_METACLASS_$_ZIK" + type;
+                case 2:
+                    visibility = Local;
+                    return "-[ZIK" + type + " " + member + "]";
+                default:
+                    visibility = Exported;
+                    return "_OBJC_IVAR_$_ZIK" + type + "._" + member;
+            }
+        }
+        if (kind < 920) {
+            if (random_() % 2 == 0) {
+                visibility = Local;
+                return "___" + member + type + "_block_invoke_" + std::to_string(random_() % 8);
+            }
+            visibility = Exported;
+            return "_ZIK" + type + std::string(1, static_cast<char>(member[0] - 'a' + 'A')) + member.substr(1);
+        }
+        if (kind < 970) {
+            visibility = Undefined;
+            if (random_() % 2 == 0) {
+                return "_objc_" + member + type;
+            }
+            return "_$s10Foundation" + identifier(type) + "V" + identifier(member) + pick(AccessorTypes, random_);
+        }
+        // Router types and their conformances
+        visibility = Exported;
+        switch (random_() % 5) {
+            case 0:
+                return "_$s" + identifier(module) + identifier(type + "Router") + "C27registerRoutableDestinationyyFZ";
+            case 1:
+                return "_$s7ZRouter15RoutableServiceV" + identifier(module) + identifier(type + "Input") + "_pGMD";
+            case 2:
+                return "_$s7ZRouter15RoutableServiceVy" + identifier(module) + identifier(type + "Input") + "P_pGMa";
+            case 3:
+                // Initializer in extension declaring the routable protocol
+                return "_$s7ZRouter15RoutableServiceV" + identifier(module) + "AD" + identifier(type + "Input") + "P_pRszlEACyAeF_pGycfC";
+            default:
+                return "_$s7ZRouter12RoutableViewV" + identifier(module) + identifier(type + "ViewInput") + "_pGMD";
+        }
+    }
+
+    std::mt19937 random_;
+    std::unordered_set<std::string> names_;
+};
+
+/// Median of times of running the work, in milliseconds.
+template <typename Work>
+double medianMs(size_t iterations, Work work) {
+    std::vector<double> times;
+    for (size_t i = 0; i < iterations; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        work();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/// At most n different indexes evenly spread in [0, count), including the first and the last.
+std::vector<size_t> spreadIndexes(size_t count, size_t n) {
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < n && count > 0; i++) {
+        indexes.push_back(n == 1 ? count - 1 : i * (count - 1) / (n - 1));
+    }
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+    return indexes;
+}
+
+bool isDefined(uint8_t type) {
+    return (type & N_STAB) == 0 && (type & N_TYPE) == N_SECT;
+}
+
+/// Nearest defined symbol at or before the address, scanning all nlists.
+const char *nearestSymbol(const MachOSymbolTable &table, uint64_t address) {
+    const char *nearest = nullptr;
+    uint64_t nearestValue = 0;
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        if (name == nullptr || !isDefined(type) || value > address) {
+            continue;
+        }
+        if (nearest == nullptr || value > nearestValue) {
+            nearest = name;
+            nearestValue = value;
+        }
+    }
+    return nearest;
+}
+
+void appendField(std::string &json, const char *key, double value, bool last = false) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "      \"%s\": %.3f%s\n", key, value, last ? "" : ",");
+    json += buffer;
+}
+
+void appendField(std::string &json, const char *key, uint64_t value, bool last = false) {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "      \"%s\": %llu%s\n", key, static_cast<unsigned long long>(value), last ? "" : ",");
+    json += buffer;
+}
+
+} // namespace
+
+std::vector<MachOFixtureBuilder::Symbol> SymbolBenchmark::makeSymbols(size_t count, uint32_t seed) {
+    NameGenerator generator(seed);
+    std::mt19937 random(seed);
+    std::vector<MachOFixtureBuilder::Symbol> locals, exported, undefined;
+    uint64_t address = 0x4000;
+    for (size_t i = 0; i < count; i++) {
+        NameGenerator::Visibility visibility;
+        MachOFixtureBuilder::Symbol symbol;
+        symbol.name = generator.next(i, visibility);
+        symbol.desc = 0;
+        if (visibility == NameGenerator::Undefined) {
+            symbol.type = N_UNDF | N_EXT;
+            symbol.sect = 0;
+            symbol.value = 0;
+            undefined.push_back(symbol);
+            continue;
+        }
+        symbol.type = visibility == NameGenerator::Local ? N_SECT : (N_SECT | N_EXT);
+        symbol.sect = 1;
+        symbol.value = address;
+        // Functions are 16 to 512 bytes
+        address += 16 + (random() % 124) * 4;
+        (visibility == NameGenerator::Local ? locals : exported).push_back(symbol);
+    }
+    std::vector<MachOFixtureBuilder::Symbol> *sortedGroups[] = {&exported, &undefined};
+    for (std::vector<MachOFixtureBuilder::Symbol> *group : sortedGroups) {
+        std::sort(group->begin(), group->end(), [](const MachOFixtureBuilder::Symbol &lhs, const MachOFixtureBuilder::Symbol &rhs) {
+            return lhs.name < rhs.name;
+        });
+    }
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    symbols.reserve(count);
+    symbols.insert(symbols.end(), locals.begin(), locals.end());
+    symbols.insert(symbols.end(), exported.begin(), exported.end());
+    symbols.insert(symbols.end(), undefined.begin(), undefined.end());
+    return symbols;
+}
+
+std::vector<uint8_t> SymbolBenchmark::makeImage(const std::vector<MachOFixtureBuilder::Symbol> &symbols) {
+    MachOFixtureBuilder builder(true);
+    builder.setInstallName("@rpath/ZIKSymbolBenchmark.framework/ZIKSymbolBenchmark");
+    builder.reserveSection("__TEXT", "__text", 0x1000);
+    // Addresses of symbols are inside __TEXT, but only the first page is in the file, to keep files small
+    uint64_t endAddress = 0;
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        endAddress = std::max(endAddress, symbol.value + 0x200);
+    }
+    builder.addZeroFill("__TEXT", endAddress);
+    builder.layout();
+    ExportTrieBuilder trie;
+    uint32_t localCount = 0, exportedCount = 0, undefinedCount = 0;
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, symbol.value, symbol.desc);
+        if ((symbol.type & N_TYPE) == N_UNDF) {
+            undefinedCount++;
+        } else if ((symbol.type & N_EXT) != 0) {
+            exportedCount++;
+            trie.addSymbol(symbol.name, symbol.value);
+        } else {
+            localCount++;
+        }
+    }
+    builder.setDysymtab(0, localCount, localCount, exportedCount, localCount + exportedCount, undefinedCount);
+    builder.setLinkeditData(LC_DYLD_EXPORTS_TRIE, trie.build());
+    return builder.build();
+}
+
+std::string SymbolBenchmark::filePath(size_t count) const {
+    std::string directory = directory_;
+    if (directory.empty()) {
+        const char *temporary = getenv("TMPDIR");
+        directory = temporary != nullptr && temporary[0] != '\0' ? temporary : "/tmp";
+    }
+    if (directory[directory.size() - 1] != '/') {
+        directory += "/";
+    }
+    return directory + "ZIKSymbolBenchmark-" + std::to_string(getpid()) + "-" + std::to_string(count) + ".dylib";
+}
+
+bool SymbolBenchmark::run(size_t count, SymbolBenchmarkResult &result, std::string &error) const {
+    memset(&result, 0, sizeof(result));
+    result.symbols = count;
+    result.batchSize = kBatchSize;
+
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    std::vector<uint8_t> bytes;
+    result.generateMs = medianMs(1, [&]() {
+        symbols = makeSymbols(count, seed_);
+        bytes = makeImage(symbols);
+    });
+    result.fileBytes = bytes.size();
+    std::vector<size_t> definedIndexes;
+    std::vector<size_t> exportedIndexes;
+    for (size_t i = 0; i < symbols.size(); i++) {
+        const MachOFixtureBuilder::Symbol &symbol = symbols[i];
+        const char *name = symbol.name.c_str();
+        if (strncmp(name, "_$s", 3) == 0 || strncmp(name, "_$S", 3) == 0 || strncmp(name, "_T0", 3) == 0) {
+            result.swiftSymbols++;
+        }
+        if ((symbol.type & N_TYPE) == N_UNDF) {
+            result.undefinedSymbols++;
+            continue;
+        }
+        definedIndexes.push_back(i);
+        if ((symbol.type & N_EXT) != 0) {
+            result.exportedSymbols++;
+            exportedIndexes.push_back(i);
+        }
+    }
+
+    std::string path = filePath(count);
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "can't create " + path;
+        return false;
+    }
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = fclose(file) == 0 && written;
+    std::vector<uint8_t>().swap(bytes);
+    if (!written) {
+        remove(path.c_str());
+        error = "can't write " + path;
+        return false;
+    }
+
+    bool succeeded = false;
+    do {
+        MachOFile machO;
+        MachOSymbolTable table;
+        bool opened = true;
+        result.openMs = medianMs(iterations_, [&]() {
+            opened = machO.open(path.c_str(), MachOFile::HostCPU) && machO.readSymbolTable(table) && opened;
+        });
+        if (!opened) {
+            error = "can't read " + path;
+            break;
+        }
+        result.stringTableBytes = table.stringsSize;
+
+        // Single lookup
+        std::vector<size_t> lookups = spreadIndexes(symbols.size(), kLookupCount);
+        bool matched = true;
+        result.nlistLookupUs = medianMs(iterations_, [&]() {
+            for (size_t index : lookups) {
+                MachONameListItem item = {symbols[index].name.c_str(), 0, 0, 0, 0};
+                machONameList(table, 0, &item, 1);
+                matched = matched && item.name == nullptr && item.value == symbols[index].value;
+            }
+        }) * 1000 / lookups.size();
+
+        ExportTrie trie;
+        if (!trie.parse(machO.image())) {
+            error = "can't read export trie of " + path;
+            break;
+        }
+        std::vector<size_t> exportedLookups = spreadIndexes(exportedIndexes.size(), kLookupCount);
+        for (size_t &index : exportedLookups) {
+            index = exportedIndexes[index];
+        }
+        result.trieLookupNs = medianMs(iterations_, [&]() {
+            for (size_t round = 0; round < kFastLookupRounds; round++) {
+                for (size_t index : exportedLookups) {
+                    MachOExport found;
+                    matched = matched && trie.find(symbols[index].name.c_str(), found) && found.address == symbols[index].value;
+                }
+            }
+        }) * 1e6 / (kFastLookupRounds * exportedLookups.size());
+
+        SymbolIndex index;
+        result.indexBuildMs = medianMs(iterations_, [&]() {
+            index = SymbolIndex();
+            matched = index.build(machO.image()) && matched;
+        });
+        result.indexLookupNs = medianMs(iterations_, [&]() {
+            for (size_t round = 0; round < kFastLookupRounds; round++) {
+                for (size_t lookup : lookups) {
+                    const SymbolIndex::Entry *entry = index.find(symbols[lookup].name.c_str());
+                    matched = matched && entry != nullptr && entry->value == symbols[lookup].value;
+                }
+            }
+        }) * 1e6 / (kFastLookupRounds * lookups.size());
+
+        // Batch lookup
+        std::vector<size_t> batch = spreadIndexes(symbols.size(), kBatchSize);
+        std::vector<const char *> batchNames;
+        for (size_t lookup : batch) {
+            batchNames.push_back(symbols[lookup].name.c_str());
+        }
+        result.batchNlistMs = medianMs(iterations_, [&]() {
+            std::vector<MachONameListItem> items(batch.size());
+            for (size_t i = 0; i < batch.size(); i++) {
+                items[i].name = batchNames[i];
+            }
+            matched = machONameList(table, 0, items.data(), items.size()) == 0 && matched;
+        });
+        result.batchFindSymbolsMs = medianMs(iterations_, [&]() {
+            std::vector<SymbolIndex::Entry> entries(batch.size());
+            bool found[kBatchSize];
+            matched = findSymbols(table, batchNames.data(), batchNames.size(), entries.data(), found) == batch.size() && matched;
+        });
+
+        // Enumeration
+        SymbolNameEnumerator enumerator;
+        enumerator.addSymbolTable(table);
+        size_t enumerated = 0;
+        result.enumerateMs = medianMs(iterations_, [&]() {
+            enumerated = 0;
+            enumerator.enumerate(nullptr, SymbolNameEnumerator::Filter(), [&](size_t, const char *) {
+                enumerated++;
+                return true;
+            });
+        });
+        result.enumeratedNames = enumerated;
+        SymbolNameMatcher prefix({"_$s"}, ZIKSymbolNameMatchPrefix);
+        result.prefixEnumerateMs = medianMs(iterations_, [&]() {
+            enumerated = 0;
+            enumerator.enumerate(nullptr, &prefix, SymbolNameEnumerator::Filter(), [&](size_t, const char *) {
+                enumerated++;
+                return true;
+            });
+        });
+        result.prefixNames = enumerated;
+        SymbolNameMatcher substring({"RoutableService"}, ZIKSymbolNameMatchSubstring);
+        result.substringEnumerateMs = medianMs(iterations_, [&]() {
+            enumerated = 0;
+            enumerator.enumerate(nullptr, &substring, SymbolNameEnumerator::Filter(), [&](size_t, const char *) {
+                enumerated++;
+                return true;
+            });
+        });
+        result.substringNames = enumerated;
+
+        // Prefilter before demangling
+        std::vector<const char *> names;
+        names.reserve(result.enumeratedNames);
+        enumerator.enumerate(nullptr, SymbolNameEnumerator::Filter(), [&](size_t, const char *name) {
+            names.push_back(name);
+            return true;
+        });
+        MangledNameFilter swiftFilter(ZIKMangledNameKindAll, nullptr);
+        size_t swiftNames = 0;
+        result.classifyNs = medianMs(iterations_, [&]() {
+            swiftNames = 0;
+            for (const char *name : names) {
+                swiftNames += swiftFilter.accepts(name);
+            }
+        }) * 1e6 / std::max<size_t>(names.size(), 1);
+        result.swiftNames = swiftNames;
+        result.skippedDemangles = result.enumeratedNames - swiftNames;
+        // Symbols demangled by validators of ZRouter
+        MangledNameFilter validatorFilter(ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor, "ZRouter");
+        result.validatorEnumerateMs = medianMs(iterations_, [&]() {
+            enumerated = 0;
+            enumerator.enumerate(nullptr, &substring, [&](size_t, const char *name) {
+                return validatorFilter.accepts(name);
+            }, [&](size_t, const char *) {
+                enumerated++;
+                return true;
+            });
+        });
+        result.validatorCandidates = enumerated;
+        result.skippedValidatorDemangles = result.substringNames - enumerated;
+
+        // Serial and parallel scanning of several images
+        SymbolNameEnumerator scanner;
+        for (size_t i = 0; i < kScanImages; i++) {
+            scanner.addSymbolTable(table);
+        }
+        result.scanImages = kScanImages;
+        result.scanThreads = std::min(workerThreadCount(), kScanImages);
+        ZIKApplyFunction applies[] = {nullptr, threadApply};
+        double *scanMs[] = {&result.serialScanMs, &result.parallelScanMs};
+        size_t scanNames[2] = {0, 0};
+        for (size_t i = 0; i < 2; i++) {
+            *scanMs[i] = medianMs(iterations_, [&]() {
+                scanNames[i] = 0;
+                scanner.enumerate(applies[i], [&](size_t, const char *name) {
+                    return swiftFilter.accepts(name);
+                }, [&](size_t, const char *) {
+                    scanNames[i]++;
+                    return true;
+                });
+            });
+        }
+        result.scanNames = scanNames[0];
+        matched = matched && scanNames[0] == scanNames[1] && scanNames[0] == swiftNames * kScanImages;
+
+        // Reverse lookup of addresses inside defined symbols
+        std::vector<size_t> reverseLookups = spreadIndexes(definedIndexes.size(), kLookupCount);
+        for (size_t &lookup : reverseLookups) {
+            lookup = definedIndexes[lookup];
+        }
+        result.reverseLookupUs = medianMs(iterations_, [&]() {
+            for (size_t lookup : reverseLookups) {
+                const char *name = nearestSymbol(table, symbols[lookup].value + 8);
+                matched = matched && name != nullptr && symbols[lookup].name == name;
+            }
+        }) * 1000 / reverseLookups.size();
+        AddressIndex addressIndex;
+        result.reverseIndexBuildMs = medianMs(iterations_, [&]() {
+            addressIndex = AddressIndex();
+            matched = addressIndex.build(machO.image()) && matched;
+        });
+        result.reverseIndexEntries = addressIndex.count();
+        result.reverseIndexLookupNs = medianMs(iterations_, [&]() {
+            for (size_t round = 0; round < kFastLookupRounds; round++) {
+                for (size_t lookup : reverseLookups) {
+                    const AddressIndex::Entry *entry = addressIndex.find(symbols[lookup].value + 8);
+                    matched = matched && entry != nullptr && entry->address == symbols[lookup].value;
+                }
+            }
+        }) * 1e6 / (kFastLookupRounds * reverseLookups.size());
+        for (size_t lookup : reverseLookups) {
+            const AddressIndex::Entry *entry = addressIndex.find(symbols[lookup].value + 8);
+            matched = matched && entry != nullptr && symbols[lookup].name == addressIndex.name(*entry);
+        }
+
+        if (!matched) {
+            error = "wrong lookup result in " + path;
+            break;
+        }
+        succeeded = true;
+    } while (false);
+
+    if (!keepFiles_) {
+        remove(path.c_str());
+    }
+    return succeeded;
+}
+
+std::string SymbolBenchmark::json(const std::vector<SymbolBenchmarkResult> &results) const {
+    std::string json = "{\n";
+    json += "  \"benchmark\": \"ZIKSymbolBenchmark\",\n";
+    json += "  \"iterations\": " + std::to_string(iterations_) + ",\n";
+    json += "  \"seed\": " + std::to_string(seed_) + ",\n";
+    json += std::string("  \"vectorizedStringScan\": ") + (stringScanVectorized() ? "true" : "false") + ",\n";
+    json += "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const SymbolBenchmarkResult &result = results[i];
+        json += "    {\n";
+        appendField(json, "symbols", static_cast<uint64_t>(result.symbols));
+        appendField(json, "fileBytes", result.fileBytes);
+        appendField(json, "stringTableBytes", result.stringTableBytes);
+        appendField(json, "swiftSymbols", static_cast<uint64_t>(result.swiftSymbols));
+        appendField(json, "exportedSymbols", static_cast<uint64_t>(result.exportedSymbols));
+        appendField(json, "undefinedSymbols", static_cast<uint64_t>(result.undefinedSymbols));
+        appendField(json, "generateMs", result.generateMs);
+        appendField(json, "openMs", result.openMs);
+        appendField(json, "nlistLookupUs", result.nlistLookupUs);
+        appendField(json, "trieLookupNs", result.trieLookupNs);
+        appendField(json, "indexBuildMs", result.indexBuildMs);
+        appendField(json, "indexLookupNs", result.indexLookupNs);
+        appendField(json, "batchSize", static_cast<uint64_t>(result.batchSize));
+        appendField(json, "batchNlistMs", result.batchNlistMs);
+        appendField(json, "batchFindSymbolsMs", result.batchFindSymbolsMs);
+        appendField(json, "enumerateMs", result.enumerateMs);
+        appendField(json, "enumeratedNames", static_cast<uint64_t>(result.enumeratedNames));
+        appendField(json, "prefixEnumerateMs", result.prefixEnumerateMs);
+        appendField(json, "prefixNames", static_cast<uint64_t>(result.prefixNames));
+        appendField(json, "substringEnumerateMs", result.substringEnumerateMs);
+        appendField(json, "substringNames", static_cast<uint64_t>(result.substringNames));
+        appendField(json, "classifyNs", result.classifyNs);
+        appendField(json, "swiftNames", static_cast<uint64_t>(result.swiftNames));
+        appendField(json, "skippedDemangles", static_cast<uint64_t>(result.skippedDemangles));
+        appendField(json, "validatorEnumerateMs", result.validatorEnumerateMs);
+        appendField(json, "validatorCandidates", static_cast<uint64_t>(result.validatorCandidates));
+        appendField(json, "skippedValidatorDemangles", static_cast<uint64_t>(result.skippedValidatorDemangles));
+        appendField(json, "scanImages", static_cast<uint64_t>(result.scanImages));
+        appendField(json, "scanThreads", static_cast<uint64_t>(result.scanThreads));
+        appendField(json, "serialScanMs", result.serialScanMs);
+        appendField(json, "parallelScanMs", result.parallelScanMs);
+        appendField(json, "scanNames", static_cast<uint64_t>(result.scanNames));
+        appendField(json, "reverseLookupUs", result.reverseLookupUs);
+        appendField(json, "reverseIndexBuildMs", result.reverseIndexBuildMs);
+        appendField(json, "reverseIndexEntries", static_cast<uint64_t>(result.reverseIndexEntries));
+        appendField(json, "reverseIndexLookupNs", result.reverseIndexLookupNs, true);
+        json += i + 1 < results.size() ? "    },\n" : "    }\n";
+    }
+    json += "  ]\n}\n";
+    return json;
+}
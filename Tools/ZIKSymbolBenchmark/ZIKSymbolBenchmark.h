@@ -0,0 +1,130 @@
+//
+//  ZIKSymbolBenchmark.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKSymbolBenchmark_h
+#define ZIKSymbolBenchmark_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "ZIKMachOFixtureBuilder.h"
+
+namespace zix {
+
+/// Timings of the symbol tooling for one synthetic image. Times are medians of all iterations.
+struct SymbolBenchmarkResult {
+    size_t symbols;
+    uint64_t fileBytes;
+    uint64_t stringTableBytes;
+    /// Counts of kinds of generated symbols.
+    size_t swiftSymbols;
+    size_t exportedSymbols;
+    size_t undefinedSymbols;
+
+    double generateMs;
+    /// Map the file with MachOFile and read its symbol table.
+    double openMs;
+
+    /// Single lookup with a pass of machONameList, the same as ZIKFindSymbolInFile.
+    double nlistLookupUs;
+    /// Single lookup in the export trie.
+    double trieLookupNs;
+    /// Build a SymbolIndex, then single lookup in it.
+    double indexBuildMs;
+    double indexLookupNs;
+
+    /// Batch lookup of names in one pass, with machONameList and findSymbols.
+    size_t batchSize;
+    double batchNlistMs;
+    double batchFindSymbolsMs;
+
+    /// Enumerate all names, then names with a prefix and a substring.
+    double enumerateMs;
+    size_t enumeratedNames;
+    double prefixEnumerateMs;
+    size_t prefixNames;
+    double substringEnumerateMs;
+    size_t substringNames;
+
+    /// Classify each name with MangledNameFilter, as a prefilter before demangling.
+    double classifyNs;
+    /// Names classified as swift symbols. Other names are not demangled.
+    size_t swiftNames;
+    size_t skippedDemangles;
+    /// Enumerate names containing "RoutableService" which are initializers or type metadata accessors in ZRouter, like validators of ZRouter.
+    double validatorEnumerateMs;
+    size_t validatorCandidates;
+    /// Names containing "RoutableService" which are not demangled by validators.
+    size_t skippedValidatorDemangles;
+
+    /// Enumerate all names of several copies of the image with MangledNameFilter as the filter, serially and with a thread for each worker. The filter runs in workers, like demangling in zix_enumerateSwiftSymbolNameContaining.
+    size_t scanImages;
+    size_t scanThreads;
+    double serialScanMs;
+    double parallelScanMs;
+    size_t scanNames;
+
+    /// Find the nearest defined symbol at or before an address by scanning all nlists, like dladdr.
+    double reverseLookupUs;
+    /// Sort defined symbols into an AddressIndex, then binary search each address in it.
+    double reverseIndexBuildMs;
+    size_t reverseIndexEntries;
+    double reverseIndexLookupNs;
+};
+
+/**
+ Benchmark of ZIKFindSymbol and ZIKImageSymbol's portable cores, on synthetic Mach-O files read with the file backend, so it runs on macOS and Linux.
+
+ Symbols are generated with a fixed seed. Names follow the distribution of an app binary with Swift modules: mostly Swift 5 mangled names of methods, accessors, metadata, witness tables, closures and specializations, some Swift 4 names, Objective-C classes and methods, C functions, and a few router types. Like ld64 output, locals come first, then exported symbols and undefined symbols sorted by name, and exported symbols are also in an export trie.
+ */
+class SymbolBenchmark {
+public:
+    SymbolBenchmark() : iterations_(5), seed_(2018), directory_(), keepFiles_(false) {}
+
+    /// Times to run each measurement.
+    void setIterations(size_t iterations) { iterations_ = iterations == 0 ? 1 : iterations; }
+    void setSeed(uint32_t seed) { seed_ = seed; }
+    /// Directory for generated files. Default is TMPDIR or /tmp.
+    void setDirectory(const std::string &directory) { directory_ = directory; }
+    /// Keep generated files after running.
+    void setKeepFiles(bool keepFiles) { keepFiles_ = keepFiles; }
+
+    /// Generate symbols in the order of a linked image.
+    static std::vector<test::MachOFixtureBuilder::Symbol> makeSymbols(size_t count, uint32_t seed);
+
+    /// Build a 64 bit dylib with the symbols, LC_DYSYMTAB and export trie. Addresses of symbols are in __TEXT, mostly in zero fill, so they're not in the file.
+    static std::vector<uint8_t> makeImage(const std::vector<test::MachOFixtureBuilder::Symbol> &symbols);
+
+    /**
+     Generate an image with the count of symbols, write it to a file, and measure it.
+
+     @param count Count of symbols.
+     @param result Timings.
+     @param error Reason of failure.
+     @return False when the file can't be written or read.
+     */
+    bool run(size_t count, SymbolBenchmarkResult &result, std::string &error) const;
+
+    /// Results as JSON, for regression tracking.
+    std::string json(const std::vector<SymbolBenchmarkResult> &results) const;
+
+private:
+    std::string filePath(size_t count) const;
+
+    size_t iterations_;
+    uint32_t seed_;
+    std::string directory_;
+    bool keepFiles_;
+};
+
+} // namespace zix
+
+#endif /* ZIKSymbolBenchmark_h */
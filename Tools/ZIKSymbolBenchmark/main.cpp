@@ -0,0 +1,136 @@
+//
+//  main.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+//  Command line tool measuring the symbol tooling on synthetic Mach-O files. Files are read with the file backend, so it can run on macOS or Linux build machines, and results are written as JSON for regression tracking. Scanning of several images is measured serially and with a thread for each core, to compare serial and parallel scanning.
+//
+//  Build:
+//  c++ -std=c++11 -O2 -pthread -I ZIKRouter/Utilities/MachO -I ZIKRouter/Utilities/Debug -I Tools/ZIKMachOFixtures -o zik-symbol-benchmark Tools/ZIKSymbolBenchmark/*.cpp ZIKRouter/Utilities/MachO/ZIKMachOImage.cpp ZIKRouter/Utilities/MachO/ZIKMachOFile.cpp ZIKRouter/Utilities/MachO/ZIKSymbolIndex.cpp ZIKRouter/Utilities/MachO/ZIKExportTrie.cpp ZIKRouter/Utilities/MachO/ZIKSymbolEnumerator.cpp ZIKRouter/Utilities/MachO/ZIKStringTableScanner.cpp ZIKRouter/Utilities/MachO/ZIKAddressIndex.cpp ZIKRouter/Utilities/Debug/ZIKMangledNameClassifier.cpp
+//
+//  Usage:
+//  zik-symbol-benchmark [--sizes 10000,100000,1000000] [--iterations 5] [--seed 2018] [--directory /tmp] [--keep-files] [-o result.json]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "ZIKSymbolBenchmark.h"
+
+using namespace zix;
+
+namespace {
+
+void printUsage() {
+    fprintf(stderr, "usage: zik-symbol-benchmark [--sizes <n,n,...>] [--iterations <n>] [--seed <n>] [--directory <path>] [--keep-files] [-o <output.json>]\n");
+    fprintf(stderr, "  --sizes       Counts of symbols of generated images. Default is 10000,100000,1000000.\n");
+    fprintf(stderr, "  --iterations  Times to run each measurement. Medians are reported. Default is 5.\n");
+    fprintf(stderr, "  --seed        Seed of generated names. Default is 2018.\n");
+    fprintf(stderr, "  --directory   Directory for generated files. Default is TMPDIR or /tmp.\n");
+    fprintf(stderr, "  --keep-files  Don't remove generated files.\n");
+    fprintf(stderr, "  -o            Output file. Default is stdout.\n");
+}
+
+bool parseCount(const char *string, unsigned long long &value) {
+    char *end = nullptr;
+    value = strtoull(string, &end, 10);
+    return end != string && *end == '\0' && string[0] != '-';
+}
+
+bool parseSizes(const char *string, std::vector<size_t> &sizes) {
+    sizes.clear();
+    std::string list(string);
+    size_t begin = 0;
+    while (begin <= list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        unsigned long long size;
+        if (!parseCount(list.substr(begin, end - begin).c_str(), size) || size == 0) {
+            return false;
+        }
+        sizes.push_back(static_cast<size_t>(size));
+        begin = end + 1;
+    }
+    return !sizes.empty();
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    std::vector<size_t> sizes = {10000, 100000, 1000000};
+    SymbolBenchmark benchmark;
+    const char *outputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char *argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        unsigned long long value;
+        if (strcmp(argument, "--sizes") == 0 && hasValue) {
+            if (!parseSizes(argv[++i], sizes)) {
+                fprintf(stderr, "error: invalid sizes %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argument, "--iterations") == 0 && hasValue) {
+            if (!parseCount(argv[++i], value) || value == 0) {
+                fprintf(stderr, "error: invalid iterations %s\n", argv[i]);
+                return 1;
+            }
+            benchmark.setIterations(static_cast<size_t>(value));
+        } else if (strcmp(argument, "--seed") == 0 && hasValue) {
+            if (!parseCount(argv[++i], value)) {
+                fprintf(stderr, "error: invalid seed %s\n", argv[i]);
+                return 1;
+            }
+            benchmark.setSeed(static_cast<uint32_t>(value));
+        } else if (strcmp(argument, "--directory") == 0 && hasValue) {
+            benchmark.setDirectory(argv[++i]);
+        } else if (strcmp(argument, "--keep-files") == 0) {
+            benchmark.setKeepFiles(true);
+        } else if (strcmp(argument, "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else if (strcmp(argument, "-h") == 0 || strcmp(argument, "--help") == 0) {
+            printUsage();
+            return 0;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<SymbolBenchmarkResult> results;
+    for (size_t size : sizes) {
+        fprintf(stderr, "benchmarking %zu symbols...\n", size);
+        SymbolBenchmarkResult result;
+        std::string error;
+        if (!benchmark.run(size, result, error)) {
+            fprintf(stderr, "error: %s\n", error.c_str());
+            return 1;
+        }
+        results.push_back(result);
+    }
+
+    std::string json = benchmark.json(results);
+    FILE *output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (output == nullptr) {
+        fprintf(stderr, "error: can't write %s\n", outputPath);
+        return 1;
+    }
+    bool written = fwrite(json.data(), 1, json.size(), output) == json.size();
+    if (outputPath) {
+        written = fclose(output) == 0 && written;
+    }
+    if (!written) {
+        fprintf(stderr, "error: can't write %s\n", outputPath ? outputPath : "stdout");
+        return 1;
+    }
+    return 0;
+}
@@ -13,21 +13,103 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-/// Abstract registry for router classes and protocols. In consideration of performance, methods in registry are not thread safe.
+/// Posted in main thread after routers in an image loaded after registration are registered, such as a framework loaded with dlopen. Object is nil. Path of the image is in userInfo with key ZIKRouteRegistryImagePathKey, and registered router classes are with key ZIKRouteRegistryRouterClassesKey.
+FOUNDATION_EXTERN NSNotificationName const ZIKRouteRegistryDidRegisterLoadedImageNotification;
+/// NSString, path of the loaded image.
+FOUNDATION_EXTERN NSString *const ZIKRouteRegistryImagePathKey;
+/// NSArray<Class>, router classes registered from the loaded image.
+FOUNDATION_EXTERN NSString *const ZIKRouteRegistryRouterClassesKey;
+
+/// Abstract registry for router classes and protocols. Lookups and registration after +registerAll, such as deferred, lazy and loaded images' routers, are serialized with a lock. In consideration of performance, other methods in registry are not thread safe.
 @interface ZIKRouteRegistry : NSObject
 /// Whether auto register all routers when app launches. Default is YES. You can set this to NO before UIApplicationMain, and manually register your routers with +registerAll or call +registerRoutableDestination for each router.
 @property (nonatomic, class) BOOL autoRegister;
 /// Whether registration is finished.
 @property (nonatomic, class, readonly) BOOL registrationFinished;
+/// Whether to defer registration of routers returning YES from +canDeferRegistration. Default is NO. When it's YES, +registerAll registers other routers first, then registers deferrable routers in slices when main run loop is idle. If a router is not found before deferred registration is done, all pending routers are registered at once before the lookup returns. Set it before +registerAll.
+@property (nonatomic, class) BOOL deferredRegistrationEnabled;
+/// Time budget in seconds of each slice of deferred registration. A slice always registers at least one router. Default is 0.004.
+@property (nonatomic, class) NSTimeInterval deferredRegistrationSliceBudget;
+/// Whether some deferred routers are not registered yet.
+@property (nonatomic, class, readonly) BOOL hasPendingDeferredRegistration;
+/// File path of router discovery cache. Names of router classes in each image are cached with LC_UUID of the image, so next launch can find router classes by name instead of searching in unchanged images. Default is `Library/Caches/ZIKRouter/RouterDiscoveryCache` in app's container. Set it to nil to disable the cache. You should set it before +registerAll.
+@property (nonatomic, class, copy, nullable) NSString *discoveryCachePath;
 
 #pragma mark Manually Register
 
-/// Search all router classes and register.
+/// Search all router classes and register. Routers in images loaded later, such as frameworks loaded with dlopen, are registered in main queue after the images are loaded, without searching other images again. Use lazy routes to get routers as soon as dlopen returns.
 + (void)registerAll;
 
+/**
+ Call +registerAll in a background queue, so registration overlaps with launching before `application:didFinishLaunchingWithOptions:`. Lookups, +registerAll and +completeDeferredRegistration wait until it's done, so main thread only blocks when it needs routers before registration is finished.
+
+ Add `ZIKRouterBackgroundRegistration` with YES in Info.plist to start it automatically. When ZIKRouter is linked into the app executable, it starts as soon as ZIKRouter is initialized. When ZIKRouter is a framework, it's initialized before +load of classes in the app, so registration starts when the application's delegate is set, instead of registering synchronously. To start earlier, call it at the beginning of `main()`, or in a constructor function in the app executable.
+
+ `+registerRoutableDestination` of routers is called in background, so it must not use UIKit. Hooks for registered destination classes are installed in the registering thread, before registration is finished.
+ */
++ (void)registerAllInBackground;
+
+/// Block current thread until background registration is finished. It returns immediately when background registration is not running, or when it's called in the registering thread.
++ (void)waitForRegistration;
+
+/// Register all pending deferred routers now. It's thread safe. Return YES if any router is registered, or another thread was registering routers when it's waiting. Lookups call it when they don't find a router, so you only need it when you access routes without lookups, such as before enumerating routes in registry maps.
++ (BOOL)completeDeferredRegistration;
+
+/// Register all routers not registered yet, including deferred routers and routers in frozen route table. It's thread safe. Return YES if any router is registered. Lookups call it when they can't find a router by the keys in frozen route table, such as lookups of pure swift types.
++ (BOOL)completeRegistration;
+
 /// Notify that registration is finished, when you register routers by calling each router's +registerRoutableDestination. It's for rejecting any registration later and let routers call +_didFinishRegistration.
 + (void)notifyRegistrationFinished;
 
+/**
+ Register router classes with their names, then finish registration. It's for registration code generated by the offline indexer in `Tools/ZIKRouterIndexer`, which finds router classes in your binaries at build time, so app doesn't need to search router classes when launching. Routers in images loaded later are registered when the images are loaded, same as +registerAll. Set autoRegister to NO before calling it.
+
+ @param classNames Runtime names of router classes. Swift classes use mangled names, such as `_TtC6Module10TestRouter`.
+ @param count Count of names.
+ */
++ (void)registerRouterClassesWithNames:(const char *_Nonnull const *_Nonnull)classNames count:(NSUInteger)count;
+
+#pragma mark Frozen Route Table
+
+/**
+ Write routes of router classes in frameworks into a frozen route table file. App extensions in the same app group can use the table to skip searching router classes in shared frameworks.
+
+ Call it in main app after registration is finished, and write the file into the shared app group container. All router classes in each framework are listed. Routers registering ZIKRoute, factories or pure swift protocols in ZRouter are marked as eager, because their routes can't be found by key in the table. Routers in the main executable are not written.
+
+ @param path File path to write.
+ @return Whether the file is written.
+ */
++ (BOOL)writeFrozenRouteTableToPath:(NSString *)path;
+
+/**
+ Use a frozen route table in app extension. Call it before +registerAll, such as in `main()`. When registering, router classes in frameworks listed in the table are skipped, and they are registered lazily when they are discovered for the first time. Eager routers in these frameworks are still registered at launch. Lookups without keys in the table, such as lookups of pure swift types, register all routers in the table when they miss. Other images are searched as usual, and validations in DEBUG mode skip the listed frameworks.
+
+ The table is rejected when it's broken, or LC_UUID of any listed framework is different from the loaded one. Then registration falls back to searching all router classes.
+
+ @param path File path of the table written by +writeFrozenRouteTableToPath:.
+ @return Whether the table is accepted.
+ */
++ (BOOL)useFrozenRouteTableAtPath:(NSString *)path;
+
+#pragma mark Lazy Route
+
+/**
+ Register a destination protocol whose router is in a library not loaded at launch, such as a framework of a rarely used feature. The first lookup not finding the protocol loads the library with dlopen, registers the router, then finds the route again. Lookups of the same route in other threads wait for the loading, so the library is loaded only once.
+ 
+ The library is never unloaded. If loading fails, the lookup returns nil and the library is not loaded again. Pure swift protocols in ZRouter are not supported.
+ 
+ @param protocolName Runtime name of the destination protocol, same as NSStringFromProtocol().
+ @param libraryPath Path of the library for dlopen, such as `@rpath/Feature.framework/Feature`.
+ @param routerClassName Runtime name of the router class in the library. Swift classes can use `Module.Router`.
+ */
++ (void)registerLazyDestinationProtocol:(NSString *)protocolName libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName;
+
+/// Register a module config protocol whose router is in a library not loaded at launch. See +registerLazyDestinationProtocol:libraryPath:routerClassName:.
++ (void)registerLazyModuleProtocol:(NSString *)protocolName libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName;
+
+/// Register an identifier whose router is in a library not loaded at launch. See +registerLazyDestinationProtocol:libraryPath:routerClassName:.
++ (void)registerLazyIdentifier:(NSString *)identifier libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -25,11 +25,80 @@
 #import "ZIKRouterType.h"
 #import "ZIKImageSymbol.h"
 #import "NSString+Demangle.h"
+#import "ZIKFrozenRouteTable.h"
+#import "ZIKMachOImage.h"
+#import "ZIKRouterDiscoveryCache.h"
+#import "ZIKClassListScanner.h"
+#import "ZIKRegistrationScheduler.h"
+#import "ZIKReadinessBarrier.h"
+#import "ZIKLazyRouteLoader.h"
+#import <mach-o/dyld.h>
+#import <dlfcn.h>
+#import <pthread.h>
+#import <stdatomic.h>
+#if __has_include(<os/signpost.h>)
+#import <os/signpost.h>
+#endif
+
+NSNotificationName const ZIKRouteRegistryDidRegisterLoadedImageNotification = @"ZIKRouteRegistryDidRegisterLoadedImageNotification";
+NSString *const ZIKRouteRegistryImagePathKey = @"imagePath";
+NSString *const ZIKRouteRegistryRouterClassesKey = @"routerClasses";
 
 static NSMutableSet<Class> *_registries;
 static BOOL _autoRegister = YES;
 static BOOL _registrationFinished = NO;
 static CFMutableSetRef _factoryBlocks;
+/// The router class calling +registerRoutableDestination in current thread. It's thread local, because routers are registered in background registration, deferred slices and late registration at the same time.
+static __thread __unsafe_unretained Class _registeringRouterClass;
+/// key: adapter protocol, value: router class registering the adapter
+static CFMutableDictionaryRef _adapterToRouterMap;
+/// Router classes registering routes not listed by key in frozen route table, such as ZIKRoute, factories and pure swift protocols.
+static CFMutableSetRef _eagerRouterClasses;
+static ZIKFrozenRouteTableRef _frozenRouteTable;
+/// Header of the image at the index in frozen route table, or NULL when the image is not loaded.
+static const void **_frozenImages;
+/// Headers of images in frozen route table. Router classes in these images are registered lazily.
+static CFMutableSetRef _frozenImageHeaders;
+/// key: header of image in frozen route table, value: router classes in the image registered at launch.
+static CFMutableDictionaryRef _frozenEagerRouterClasses;
+/// Router classes registered lazily from frozen route table, or registered at launch.
+static CFMutableSetRef _frozenBoundRouterClasses;
+/// Whether all router classes in frozen route table are registered.
+static BOOL _frozenRoutesAllBound = NO;
+static NSString *_discoveryCachePath;
+static BOOL _discoveryCachePathIsSet = NO;
+/// Scanner for images loaded after registration. Images searched in +registerAll are marked as scanned.
+static ZIKLoadedImageScannerRef _loadedImageScanner;
+/// Whether router classes in loaded images are found in their class lists, or with objc runtime when class layout can't be read.
+static BOOL _loadedImageScannerReadsClassList = NO;
+static BOOL _deferredRegistrationEnabled = NO;
+static NSTimeInterval _deferredRegistrationSliceBudget = 0.004;
+/// Deferrable router classes not registered in +registerAll.
+static NSArray<Class> *_deferredRouterClasses;
+static ZIKRegistrationSchedulerRef _deferredRegistrationScheduler;
+static CFRunLoopObserverRef _deferredRegistrationObserver;
+/// Whether deferred routers are being registered. A router may look up other routers when it's registering, so the scheduler is only destroyed by the outermost call.
+static BOOL _registeringDeferredRouters = NO;
+/// Serializes registration after +registerAll, such as deferred slices in main thread and lookups completing deferred registration in other threads. It's recursive, because a router may look up other routers when it's registering.
+static pthread_mutex_t _registryLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+/// Thread registering a router after registration is finished, with the lock held. Registration is not finished in this thread, so the router can register its routes.
+static pthread_t _lateRegistrationThread;
+/// Lookups wait on it while routers are registered in background.
+static ZIKReadinessBarrierRef _registrationBarrier;
+/// Routes in libraries loaded at the first lookup.
+static ZIKLazyRouteLoaderRef _lazyRouteLoader;
+/// Router classes registered from images loaded after registration, or from lazy routes.
+static CFMutableSetRef _loadedImageRouterClasses;
+/// Whether routes may be registered when lookups miss: deferred routers, routers in frozen route table not bound yet, or lazy routes. Lookups only hold the registry lock when it's set.
+static atomic_bool _hasPendingRoutes;
+
+static void _registerRoutersInAddedImage(const struct mach_header *mh, intptr_t vmaddr_slide);
+static void _observeAddedImages(ZIKLoadedImageScannerRef scanner, BOOL canReadClassList);
+static void _waitForBackgroundRegistration(void);
+static void _registerLazyRouterClass(void *context, const ZIKLazyRoute *route, void *symbolAddress);
+static void _destroyDeferredRegistration(void);
+static BOOL _backgroundRegistrationEnabled(void);
+static void _updateHasPendingRoutes(void);
 
 @interface ZIKRouteRegistry()
 @property (nonatomic, class, readonly) NSMutableSet *registries;
@@ -50,6 +119,9 @@ static CFMutableSetRef _factoryBlocks;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         _factoryBlocks = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        _registrationBarrier = ZIKReadinessBarrierCreate();
+        _lazyRouteLoader = ZIKLazyRouteLoaderCreate(_registerLazyRouterClass, NULL);
+        _loadedImageRouterClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
         zix_replaceMethodWithMethod([XXApplication class], @selector(setDelegate:),
                                     self, @selector(ZIKRouteRegistry_hook_setDelegate:));
         zix_replaceMethodWithMethodType([XXStoryboard class], @selector(storyboardWithName:bundle:), true,
@@ -59,7 +131,12 @@ static CFMutableSetRef _factoryBlocks;
 
 + (void)ZIKRouteRegistry_hook_setDelegate:(id)delegate {
     if (ZIKRouteRegistry.autoRegister) {
-        [ZIKRouteRegistry registerAll];
+        if (_backgroundRegistrationEnabled()) {
+            // Launching continues, and lookups wait until registration is finished
+            [ZIKRouteRegistry registerAllInBackground];
+        } else {
+            [ZIKRouteRegistry registerAll];
+        }
     }
     [self ZIKRouteRegistry_hook_setDelegate:delegate];
 }
@@ -70,6 +147,9 @@ static CFMutableSetRef _factoryBlocks;
 + (NSStoryboard *)ZIKRouteRegistry_hook_storyboardWithName:(NSString *)name bundle:(nullable NSBundle *)storyboardBundleOrNil
 #endif
 {
+    for (Class registry in [ZIKRouteRegistry registries]) {
+        [registry willLoadStoryboard];
+    }
     if (ZIKRouteRegistry.autoRegister) {
         [ZIKRouteRegistry registerAll];
     }
@@ -101,40 +181,881 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (BOOL)registrationFinished {
-    return _registrationFinished;
+    return _registrationFinished && !pthread_equal(_lateRegistrationThread, pthread_self());
 }
 
 + (void)setRegistrationFinished:(BOOL)registrationFinished {
     _registrationFinished = registrationFinished;
 }
 
++ (BOOL)deferredRegistrationEnabled {
+    return _deferredRegistrationEnabled;
+}
+
++ (void)setDeferredRegistrationEnabled:(BOOL)deferredRegistrationEnabled {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set deferred registration after registration is already finished.");
+        return;
+    }
+    _deferredRegistrationEnabled = deferredRegistrationEnabled;
+}
+
++ (NSTimeInterval)deferredRegistrationSliceBudget {
+    return _deferredRegistrationSliceBudget;
+}
+
++ (void)setDeferredRegistrationSliceBudget:(NSTimeInterval)deferredRegistrationSliceBudget {
+    NSParameterAssert(deferredRegistrationSliceBudget >= 0);
+    _deferredRegistrationSliceBudget = MAX(deferredRegistrationSliceBudget, 0);
+}
+
++ (NSString *)discoveryCachePath {
+    if (_discoveryCachePathIsSet) {
+        return _discoveryCachePath;
+    }
+    NSString *cachesDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    return [[cachesDirectory stringByAppendingPathComponent:@"ZIKRouter"] stringByAppendingPathComponent:@"RouterDiscoveryCache"];
+}
+
++ (void)setDiscoveryCachePath:(NSString *)discoveryCachePath {
+    if (_registrationFinished) {
+        NSAssert(NO, @"Set discovery cache path after registration is already finished.");
+        return;
+    }
+    _discoveryCachePath = [discoveryCachePath copy];
+    _discoveryCachePathIsSet = YES;
+}
+
+/// Find router classes in the image from discovery cache. Return nil when the image is not in the cache, or any class is not found.
+static NSArray<Class> *_cachedRouterClassesInImage(ZIKRouterDiscoveryCacheRef cache, const void *imageHeader) {
+    uint8_t uuid[16];
+    if (cache == NULL || !ZIKMachOImageCopyUUID(imageHeader, uuid)) {
+        return nil;
+    }
+    const char *const *classNames = NULL;
+    uint32_t count = 0;
+    if (!ZIKRouterDiscoveryCacheLookup(cache, uuid, &classNames, &count)) {
+        return nil;
+    }
+    NSMutableArray<Class> *classes = [NSMutableArray arrayWithCapacity:count];
+    for (uint32_t i = 0; i < count; i++) {
+        Class aClass = objc_lookUpClass(classNames[i]);
+        if (aClass == nil) {
+            return nil;
+        }
+        [classes addObject:aClass];
+    }
+    return classes;
+}
+
+/// Write discovery cache in background, then destroy it.
+static void _writeDiscoveryCache(ZIKRouterDiscoveryCacheRef cache, NSString *path) {
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+        NSString *directory = [path stringByDeletingLastPathComponent];
+        [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:NULL];
+        ZIKRouterDiscoveryCacheWriteToFile(cache, path.fileSystemRepresentation);
+        ZIKRouterDiscoveryCacheDestroy(cache);
+    });
+}
+
 + (void)registerAll {
+    _waitForBackgroundRegistration();
     if (self.registrationFinished) {
         return;
     }
     NSSet *registries = [[self registries] copy];
-    if (zix_canEnumerateClassesInImage()) {
+    NSMutableArray<Class> *deferredRouterClasses = _deferredRegistrationEnabled ? [NSMutableArray array] : nil;
+    BOOL canEnumerateClassesInImage = zix_canEnumerateClassesInImage();
+    ZIKLoadedImageScannerRef loadedImageScanner = NULL;
+    if (canEnumerateClassesInImage) {
         // Fast enumeration
-        zix_enumerateClassesInMainBundleForParentClass([ZIKRouter class], ^(__unsafe_unretained Class  _Nonnull aClass) {
-            for (Class registry in registries) {
-                [registry handleEnumerateRouterClass:aClass];
+        CFSetRef frozenImageHeaders = _frozenImageHeaders;
+        NSString *cachePath = self.discoveryCachePath;
+        ZIKRouterDiscoveryCacheRef cache = NULL;
+        if (cachePath) {
+            cache = ZIKRouterDiscoveryCacheOpen(cachePath.fileSystemRepresentation, NULL);
+        }
+        ZIKRouterDiscoveryCacheRef updatedCache = cachePath ? ZIKRouterDiscoveryCacheCreate() : NULL;
+        __block BOOL cacheChanged = (cache == NULL);
+        loadedImageScanner = ZIKLoadedImageScannerCreate((__bridge const void *)[ZIKRouter class]);
+        zix_enumerateClassesInMainBundleImagesForParentClass([ZIKRouter class], ^NSArray<Class> *(const void * _Nonnull imageHeader, const char * _Nonnull imagePath) {
+            // Routers in frozen route table are registered when they're discovered, except routers registering routes not listed by key
+            NSArray<Class> *eagerRouterClasses = [self _eagerRouterClassesInFrozenImage:imageHeader];
+            if (eagerRouterClasses) {
+                return eagerRouterClasses;
+            }
+            return _cachedRouterClassesInImage(cache, imageHeader);
+        }, ^(const void * _Nonnull imageHeader, const char * _Nonnull imagePath, __unsafe_unretained Class  _Nonnull const * _Nullable classes, size_t count, bool cached) {
+            ZIKLoadedImageScannerMarkScanned(loadedImageScanner, imageHeader);
+            uint8_t uuid[16];
+            bool isFrozenImage = frozenImageHeaders != NULL && CFSetContainsValue(frozenImageHeaders, imageHeader);
+            if (updatedCache && !isFrozenImage && ZIKMachOImageCopyUUID(imageHeader, uuid)) {
+                const char **classNames = malloc((count + 1) * sizeof(char *));
+                for (size_t i = 0; i < count; i++) {
+                    classNames[i] = class_getName(classes[i]);
+                }
+                ZIKRouterDiscoveryCacheSetImage(updatedCache, uuid, classNames, (uint32_t)count);
+                free(classNames);
+                if (!cached) {
+                    cacheChanged = YES;
+                }
+            }
+            for (size_t i = 0; i < count; i++) {
+                Class aClass = classes[i];
+                if (deferredRouterClasses && [aClass canDeferRegistration]) {
+                    [deferredRouterClasses addObject:aClass];
+                    continue;
+                }
+                _registeringRouterClass = aClass;
+                for (Class registry in registries) {
+                    [registry handleEnumerateRouterClass:aClass];
+                }
             }
         });
+        if (cache && updatedCache && ZIKRouterDiscoveryCacheImageCount(cache) != ZIKRouterDiscoveryCacheImageCount(updatedCache)) {
+            // Some images are removed or changed
+            cacheChanged = YES;
+        }
+        ZIKRouterDiscoveryCacheDestroy(cache);
+        if (updatedCache && cacheChanged) {
+            _writeDiscoveryCache(updatedCache, cachePath);
+        } else {
+            ZIKRouterDiscoveryCacheDestroy(updatedCache);
+        }
     } else {
-        // Slow enumeration
-        zix_enumerateClassList(^(__unsafe_unretained Class class) {
+        // Slow enumeration can't skip images
+        [self _closeFrozenRouteTable];
+        zix_enumerateClassListForParentClass([ZIKRouter class], ^(__unsafe_unretained Class class) {
+            if (deferredRouterClasses && [class canDeferRegistration]) {
+                [deferredRouterClasses addObject:class];
+                return;
+            }
+            _registeringRouterClass = class;
             for (Class registry in registries) {
                 [registry handleEnumerateRouterClass:class];
             }
         });
     }
+    _registeringRouterClass = nil;
     
     self.registrationFinished = YES;
+    _observeAddedImages(loadedImageScanner, canEnumerateClassesInImage);
+    if ([self _scheduleDeferredRouterClasses:deferredRouterClasses]) {
+        // Registries finish registration after deferred routers are registered
+        return;
+    }
+    // Validations skip images in frozen route table, routers in them are not registered yet
+    for (Class registry in registries) {
+        [registry didFinishRegistration];
+    }
+}
+
+/// Register a router class after registration is finished. Registration is only reopened for current thread, other threads still see it as finished.
++ (void)_registerRouterClassLately:(Class)routerClass {
+    pthread_mutex_lock(&_registryLock);
+    // A router may register another router lazily when it looks up routes
+    pthread_t lateRegistrationThread = _lateRegistrationThread;
+    Class registeringRouterClass = _registeringRouterClass;
+    _lateRegistrationThread = pthread_self();
+    _registeringRouterClass = routerClass;
+    NSSet *registries = [[self registries] copy];
+    for (Class registry in registries) {
+        [registry handleEnumerateRouterClass:routerClass];
+    }
+    _registeringRouterClass = registeringRouterClass;
+    _lateRegistrationThread = lateRegistrationThread;
+    pthread_mutex_unlock(&_registryLock);
+}
+
+/// Register router classes found in an image loaded after registration, then post ZIKRouteRegistryDidRegisterLoadedImageNotification.
++ (void)_registerRouterClassesInLoadedImage:(const void **)classes count:(size_t)count imagePath:(NSString *)imagePath {
+    _waitForBackgroundRegistration();
+    NSMutableArray<Class> *routerClasses = [NSMutableArray arrayWithCapacity:count];
+    pthread_mutex_lock(&_registryLock);
+    for (size_t i = 0; i < count; i++) {
+        Class routerClass = (__bridge Class)classes[i];
+        // May be registered by a lazy route when the image was loaded in another thread
+        if (CFSetContainsValue(_loadedImageRouterClasses, (__bridge const void *)(routerClass))) {
+            continue;
+        }
+        CFSetAddValue(_loadedImageRouterClasses, (__bridge const void *)(routerClass));
+        [self _registerRouterClassLately:routerClass];
+        // Retain the class after it's realized by registration
+        [routerClasses addObject:routerClass];
+    }
+    pthread_mutex_unlock(&_registryLock);
+    [[NSNotificationCenter defaultCenter] postNotificationName:ZIKRouteRegistryDidRegisterLoadedImageNotification object:nil userInfo:@{ZIKRouteRegistryImagePathKey: imagePath, ZIKRouteRegistryRouterClassesKey: routerClasses}];
+}
+
+/**
+ Register routers in images loaded after registration, such as frameworks loaded with dlopen. It's called once when registration is finished, with any way of registration.
+
+ @param scanner Scanner with images searched by +registerAll marked as scanned. When it's NULL, a scanner is created and all loaded images are marked as scanned, because their routers are found in all classes or registered by names.
+ @param canReadClassList Whether class lists of images can be read directly.
+ */
+static void _observeAddedImages(ZIKLoadedImageScannerRef scanner, BOOL canReadClassList) {
+    if (scanner == NULL) {
+        scanner = ZIKLoadedImageScannerCreate((__bridge const void *)[ZIKRouter class]);
+        for (uint32_t i = 0, count = _dyld_image_count(); i < count; i++) {
+            ZIKLoadedImageScannerMarkScanned(scanner, _dyld_get_image_header(i));
+        }
+    }
+    _loadedImageScanner = scanner;
+    _loadedImageScannerReadsClassList = canReadClassList;
+    // Images loaded before are reported again in current thread, and they're already marked as scanned
+    _dyld_register_func_for_add_image(_registerRoutersInAddedImage);
+}
+
+/// Find router classes in an image with objc runtime. Caller should free it.
+static const void **_copyRouterClassesInImageWithRuntime(const char *path, size_t *count) {
+    *count = 0;
+    unsigned int classCount = 0;
+    const char **classNames = objc_copyClassNamesForImage(path, &classCount);
+    const void **classes = malloc(MAX(classCount, 1) * sizeof(void *));
+    Class routerClass = [ZIKRouter class];
+    for (unsigned int i = 0; i < classCount; i++) {
+        Class aClass = objc_getClass(classNames[i]);
+        if (aClass && zix_classIsSubclassOfClass(aClass, routerClass)) {
+            classes[(*count)++] = (__bridge const void *)(aClass);
+        }
+    }
+    free(classNames);
+    return classes;
+}
+
+/// Register router classes collected from an added image in main queue. When classes is NULL, router classes are found with objc runtime. Classes are freed.
+static void _registerRoutersInAddedImageInMainQueue(const void *header, const void **classes, size_t count) {
+    Dl_info info;
+    if (dladdr(header, &info) == 0 || info.dli_fname == NULL) {
+        free((void *)classes);
+        return;
+    }
+    const char *path = info.dli_fname;
+    if (strstr(path, "/System/Library/") != NULL ||
+        strstr(path, "/usr/") != NULL ||
+        strstr(path, ".dylib") != NULL) {
+        free((void *)classes);
+        return;
+    }
+    if (classes == NULL) {
+        classes = _copyRouterClassesInImageWithRuntime(path, &count);
+    }
+    if (count > 0) {
+        [ZIKRouteRegistry _registerRouterClassesInLoadedImage:classes count:count imagePath:@(path)];
+    }
+    free((void *)classes);
+}
+
+/// Callback of `_dyld_register_func_for_add_image`. Only the added image is scanned. It's called with dyld's lock held, so it only collects router classes from the class list, and registration runs in main queue, where routers can call dyld and objc runtime. Lazy routes get routers synchronously after dlopen.
+static void _registerRoutersInAddedImage(const struct mach_header *mh, intptr_t vmaddr_slide) {
+    if (_loadedImageScannerReadsClassList == NO) {
+        // objc runtime can't be used here, the image is scanned in main queue
+        if (ZIKLoadedImageScannerMarkScanned(_loadedImageScanner, mh)) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                _registerRoutersInAddedImageInMainQueue(mh, NULL, 0);
+            });
+        }
+        return;
+    }
+    size_t count = 0;
+    const void **classes = ZIKLoadedImageScannerCopySubclasses(_loadedImageScanner, mh, &count);
+    if (classes == NULL) {
+        return;
+    }
+    if (count == 0) {
+        free((void *)classes);
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        _registerRoutersInAddedImageInMainQueue(mh, classes, count);
+    });
+}
+
+#pragma mark Background Registration
+
+#if __has_include(<os/signpost.h>)
+static os_log_t _registrationLog(void) API_AVAILABLE(ios(12.0), macos(10.14), tvos(12.0), watchos(5.0)) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.zuik.ZIKRouter", "Registration");
+    });
+    return log;
+}
+#endif
+
+/// Wait on the barrier only when background registration is running in another thread. Blocked time is traced with signpost. In main thread, registries are notified of destination classes registered in other threads before it returns.
+static inline void _waitForBackgroundRegistration(void) {
+    if (ZIKReadinessBarrierIsRunning(_registrationBarrier)) {
+#if __has_include(<os/signpost.h>)
+        if (@available(iOS 12.0, macOS 10.14, tvOS 12.0, watchOS 5.0, *)) {
+            os_signpost_id_t signpostID = os_signpost_id_generate(_registrationLog());
+            os_signpost_interval_begin(_registrationLog(), signpostID, "Wait For Registration");
+            uint64_t blockedTime = ZIKReadinessBarrierWait(_registrationBarrier);
+            os_signpost_interval_end(_registrationLog(), signpostID, "Wait For Registration", "blocked %llu ns", blockedTime);
+        } else {
+            ZIKReadinessBarrierWait(_registrationBarrier);
+        }
+#else
+        ZIKReadinessBarrierWait(_registrationBarrier);
+#endif
+    }
+}
+
++ (void)registerAllInBackground {
+    if (_registrationFinished || !ZIKReadinessBarrierStart(_registrationBarrier)) {
+        return;
+    }
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+        ZIKReadinessBarrierEnterWorkerThread(_registrationBarrier);
+#if __has_include(<os/signpost.h>)
+        if (@available(iOS 12.0, macOS 10.14, tvOS 12.0, watchOS 5.0, *)) {
+            os_signpost_id_t signpostID = os_signpost_id_generate(_registrationLog());
+            os_signpost_interval_begin(_registrationLog(), signpostID, "Background Registration");
+            [ZIKRouteRegistry registerAll];
+            os_signpost_interval_end(_registrationLog(), signpostID, "Background Registration");
+        } else {
+            [ZIKRouteRegistry registerAll];
+        }
+#else
+        [ZIKRouteRegistry registerAll];
+#endif
+        ZIKReadinessBarrierMarkReady(_registrationBarrier);
+    });
+}
+
++ (void)waitForRegistration {
+    _waitForBackgroundRegistration();
+}
+
+/// Whether `ZIKRouterBackgroundRegistration` in Info.plist is YES.
+static BOOL _backgroundRegistrationEnabled(void) {
+    static BOOL enabled = NO;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        id value = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"ZIKRouterBackgroundRegistration"];
+        enabled = [value respondsToSelector:@selector(boolValue)] && [value boolValue];
+    });
+    return enabled;
+}
+
+/**
+ Start background registration when ZIKRouter is initialized, only when it's linked into the main executable. Constructors of the main executable run after +load of all its classes and after initializers of all frameworks, so routers in the app are ready.
+ 
+ Frameworks are initialized before the main executable, when +load of routers in the app is not called yet. So when ZIKRouter is a framework, background registration starts in -setDelegate: of the application instead.
+ */
+__attribute__((constructor)) static void _registerAllInBackgroundIfEnabled(void) {
+    if (!_backgroundRegistrationEnabled()) {
+        return;
+    }
+    Dl_info info;
+    if (dladdr((const void *)&_registerAllInBackgroundIfEnabled, &info) == 0 || info.dli_fbase != _dyld_get_image_header(0)) {
+        return;
+    }
+    [ZIKRouteRegistry registerAllInBackground];
+}
+
+#pragma mark Deferred Registration
+
++ (BOOL)hasPendingDeferredRegistration {
+    pthread_mutex_lock(&_registryLock);
+    BOOL pending = ZIKRegistrationSchedulerPendingCount(_deferredRegistrationScheduler) > 0;
+    pthread_mutex_unlock(&_registryLock);
+    return pending;
+}
+
+static void _registerDeferredRouterClass(void *context, size_t index) {
+    [ZIKRouteRegistry _registerRouterClassLately:_deferredRouterClasses[index]];
+}
+
+/// Register router classes in slices when main run loop is idle. Return NO if there is nothing to defer.
++ (BOOL)_scheduleDeferredRouterClasses:(nullable NSArray<Class> *)routerClasses {
+    if (routerClasses.count == 0) {
+        return NO;
+    }
+    pthread_mutex_lock(&_registryLock);
+    _deferredRouterClasses = [routerClasses copy];
+    uint64_t sliceBudget = (uint64_t)(_deferredRegistrationSliceBudget * NSEC_PER_SEC);
+    _deferredRegistrationScheduler = ZIKRegistrationSchedulerCreate(_deferredRouterClasses.count, sliceBudget, _registerDeferredRouterClass, NULL, NULL, NULL);
+    // Run after other observers such as rendering. Only observe default mode, so scrolling in tracking mode is not interrupted.
+    _deferredRegistrationObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true, INT_MAX, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        [ZIKRouteRegistry _runDeferredRegistrationSlice];
+    });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), _deferredRegistrationObserver, kCFRunLoopDefaultMode);
+    _updateHasPendingRoutes();
+    pthread_mutex_unlock(&_registryLock);
+    return YES;
+}
+
++ (void)_runDeferredRegistrationSlice {
+    _waitForBackgroundRegistration();
+    pthread_mutex_lock(&_registryLock);
+    if (_deferredRegistrationScheduler == NULL || _registeringDeferredRouters) {
+        pthread_mutex_unlock(&_registryLock);
+        return;
+    }
+    _registeringDeferredRouters = YES;
+    bool finished = ZIKRegistrationSchedulerRunSlice(_deferredRegistrationScheduler);
+    _registeringDeferredRouters = NO;
+    if (finished) {
+        _destroyDeferredRegistration();
+    }
+    pthread_mutex_unlock(&_registryLock);
+    if (finished) {
+        [self _didFinishDeferredRegistration];
+    } else {
+        // Run loop only reports waiting again after it's woken up
+        CFRunLoopWakeUp(CFRunLoopGetMain());
+    }
+}
+
++ (BOOL)completeDeferredRegistration {
+    _waitForBackgroundRegistration();
+    // When another thread holds the lock, it may be registering deferred routers, so lookups should search again
+    BOOL contended = pthread_mutex_trylock(&_registryLock) != 0;
+    if (contended) {
+        pthread_mutex_lock(&_registryLock);
+    }
+    if (_deferredRegistrationScheduler == NULL) {
+        pthread_mutex_unlock(&_registryLock);
+        return contended;
+    }
+    BOOL registering = _registeringDeferredRouters;
+    _registeringDeferredRouters = YES;
+    size_t count = ZIKRegistrationSchedulerFinish(_deferredRegistrationScheduler);
+    _registeringDeferredRouters = registering;
+    if (!registering) {
+        _destroyDeferredRegistration();
+    }
+    pthread_mutex_unlock(&_registryLock);
+    if (!registering) {
+        [ZIKRouteRegistry _didFinishDeferredRegistration];
+    }
+    return contended || count > 0;
+}
+
++ (BOOL)completeRegistration {
+    BOOL completed = [self completeDeferredRegistration];
+    BOOL bound = [self _bindAllFrozenRoutes];
+    return completed || bound;
+}
+
+/// Destroy the scheduler after all deferred routers are registered. It's called with the lock held, so it only runs once.
+static void _destroyDeferredRegistration(void) {
+    CFRunLoopObserverRef observer = _deferredRegistrationObserver;
+    _deferredRegistrationObserver = NULL;
+    CFRunLoopObserverInvalidate(observer);
+    if ([NSThread isMainThread]) {
+        CFRelease(observer);
+    } else {
+        // Main run loop may be calling the observer, which is waiting for the lock
+        dispatch_async(dispatch_get_main_queue(), ^{
+            CFRelease(observer);
+        });
+    }
+    ZIKRegistrationSchedulerDestroy(_deferredRegistrationScheduler);
+    _deferredRegistrationScheduler = NULL;
+    _deferredRouterClasses = nil;
+    _updateHasPendingRoutes();
+}
+
++ (void)_didFinishDeferredRegistration {
+    NSSet *registries = [[self registries] copy];
     for (Class registry in registries) {
         [registry didFinishRegistration];
     }
 }
 
+#pragma mark Frozen Route Table
+
++ (BOOL)writeFrozenRouteTableToPath:(NSString *)path {
+    NSParameterAssert(path);
+    if (!_registrationFinished) {
+        NSAssert(NO, @"Write frozen route table after registration is finished.");
+        return NO;
+    }
+    NSMutableDictionary<NSString *, NSValue *> *imageHeaders = [NSMutableDictionary dictionary];
+    for (uint32_t i = 0, count = _dyld_image_count(); i < count; i++) {
+        imageHeaders[@(_dyld_get_image_name(i))] = [NSValue valueWithPointer:_dyld_get_image_header(i)];
+    }
+    ZIKFrozenRouteTableBuilderRef builder = ZIKFrozenRouteTableBuilderCreate();
+    NSMutableDictionary<NSString *, NSNumber *> *imageIndexes = [NSMutableDictionary dictionary];
+    void(^addEntry)(Class, ZIKFrozenRouteKind, const char *, id) = ^(Class registry, ZIKFrozenRouteKind kind, const char *key, id route) {
+        // Only router classes in frameworks can be shared
+        if (key == NULL || route == nil || [route class] != route) {
+            return;
+        }
+        const char *imagePath = class_getImageName(route);
+        if (imagePath == NULL) {
+            return;
+        }
+        NSString *imageKey = @(imagePath);
+        NSNumber *index = imageIndexes[imageKey];
+        if (index == nil) {
+            uint32_t imageIndex = ZIKFrozenRouteTableNoImage;
+            const void *header = imageHeaders[imageKey].pointerValue;
+            const char *installName = header ? ZIKMachOImageInstallName(header) : NULL;
+            uint8_t uuid[16];
+            if (installName && ZIKMachOImageCopyUUID(header, uuid)) {
+                imageIndex = ZIKFrozenRouteTableBuilderAddImage(builder, installName, uuid);
+            }
+            index = @(imageIndex);
+            imageIndexes[imageKey] = index;
+        }
+        if (index.unsignedIntValue == ZIKFrozenRouteTableNoImage) {
+            return;
+        }
+        ZIKFrozenRouteTableBuilderAddEntry(builder, kind, class_getName(registry), key, class_getName(route), index.unsignedIntValue);
+    };
+    NSDictionary *adapterToRouterMap = (__bridge NSDictionary *)_adapterToRouterMap;
+    for (Class registry in [self registries]) {
+        [(__bridge NSDictionary *)[registry destinationProtocolToRouterMap] enumerateKeysAndObjectsUsingBlock:^(Protocol * _Nonnull protocol, id  _Nonnull route, BOOL * _Nonnull stop) {
+            addEntry(registry, ZIKFrozenRouteKindDestinationProtocol, protocol_getName(protocol), route);
+        }];
+        [(__bridge NSDictionary *)[registry moduleConfigProtocolToRouterMap] enumerateKeysAndObjectsUsingBlock:^(Protocol * _Nonnull protocol, id  _Nonnull route, BOOL * _Nonnull stop) {
+            addEntry(registry, ZIKFrozenRouteKindModuleProtocol, protocol_getName(protocol), route);
+        }];
+        [(__bridge NSDictionary *)[registry identifierToRouterMap] enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull identifier, id  _Nonnull route, BOOL * _Nonnull stop) {
+            addEntry(registry, ZIKFrozenRouteKindIdentifier, identifier.UTF8String, route);
+        }];
+        [(__bridge NSDictionary *)[registry destinationToRoutersMap] enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, NSSet * _Nonnull routes, BOOL * _Nonnull stop) {
+            for (id route in routes) {
+                addEntry(registry, ZIKFrozenRouteKindDestinationClass, class_getName(destinationClass), route);
+            }
+        }];
+        [(__bridge NSDictionary *)[registry destinationToExclusiveRouterMap] enumerateKeysAndObjectsUsingBlock:^(Class _Nonnull destinationClass, id  _Nonnull route, BOOL * _Nonnull stop) {
+            addEntry(registry, ZIKFrozenRouteKindDestinationClass, class_getName(destinationClass), route);
+        }];
+        [(__bridge NSDictionary *)[registry adapterToAdapteeMap] enumerateKeysAndObjectsUsingBlock:^(Protocol * _Nonnull adapter, Protocol * _Nonnull adaptee, BOOL * _Nonnull stop) {
+            addEntry(registry, ZIKFrozenRouteKindAdapter, protocol_getName(adapter), adapterToRouterMap[adapter]);
+        }];
+    }
+    // Lookups without keys in the table register all router classes of each image
+    NSSet *registries = [[self registries] copy];
+    zix_enumerateClassListForParentClass([ZIKRouter class], ^(__unsafe_unretained Class routerClass) {
+        for (Class registry in registries) {
+            if ([registry isRegisterableRouterClass:routerClass]) {
+                addEntry(registry, ZIKFrozenRouteKindRouterClass, class_getName(routerClass), routerClass);
+            }
+        }
+    });
+    for (Class routerClass in (__bridge NSSet *)_eagerRouterClasses) {
+        addEntry([ZIKRouteRegistry class], ZIKFrozenRouteKindEagerRouterClass, class_getName(routerClass), routerClass);
+    }
+    bool success = ZIKFrozenRouteTableBuilderWriteToFile(builder, path.fileSystemRepresentation);
+    ZIKFrozenRouteTableBuilderDestroy(builder);
+    return success;
+}
+
++ (BOOL)useFrozenRouteTableAtPath:(NSString *)path {
+    NSParameterAssert(path);
+    if (_registrationFinished) {
+        NSAssert(NO, @"Use frozen route table before registration is finished.");
+        return NO;
+    }
+    ZIKFrozenRouteTableError error;
+    ZIKFrozenRouteTableRef table = ZIKFrozenRouteTableOpen(path.fileSystemRepresentation, &error);
+    if (table == NULL) {
+        NSLog(@"ZIKRouter: frozen route table at %@ is rejected with error: %d.", path, error);
+        return NO;
+    }
+    NSMutableDictionary<NSString *, NSValue *> *loadedImages = [NSMutableDictionary dictionary];
+    for (uint32_t i = 0, count = _dyld_image_count(); i < count; i++) {
+        const char *imagePath = _dyld_get_image_name(i);
+        if (strstr(imagePath, "/System/Library/") != NULL || strstr(imagePath, "/usr/") != NULL) {
+            continue;
+        }
+        const void *header = _dyld_get_image_header(i);
+        const char *installName = ZIKMachOImageInstallName(header);
+        if (installName) {
+            loadedImages[@(installName)] = [NSValue valueWithPointer:header];
+        }
+    }
+    uint32_t imageCount = ZIKFrozenRouteTableImageCount(table);
+    const void **images = calloc(imageCount + 1, sizeof(void *));
+    for (uint32_t i = 0; i < imageCount; i++) {
+        uint8_t uuid[16];
+        const char *installName = ZIKFrozenRouteTableGetImage(table, i, uuid);
+        const void *header = loadedImages[@(installName)].pointerValue;
+        if (header == NULL) {
+            // This framework is not used in current process
+            continue;
+        }
+        uint8_t loadedUUID[16];
+        if (!ZIKMachOImageCopyUUID(header, loadedUUID) || memcmp(uuid, loadedUUID, sizeof(uuid)) != 0) {
+            NSLog(@"ZIKRouter: frozen route table at %@ is rejected, because %s is changed.", path, installName);
+            free(images);
+            ZIKFrozenRouteTableClose(table);
+            return NO;
+        }
+        images[i] = header;
+    }
+    [self _useFrozenRouteTable:table images:images];
+    return YES;
+}
+
+/// Use a validated table. `images` are headers of images at indexes in the table, NULL for images not loaded. The table and `images` are freed when the table is closed.
++ (void)_useFrozenRouteTable:(ZIKFrozenRouteTableRef)table images:(const void **)images {
+    [self _closeFrozenRouteTable];
+    CFMutableSetRef imageHeaders = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    for (uint32_t i = 0, count = ZIKFrozenRouteTableImageCount(table); i < count; i++) {
+        if (images[i]) {
+            CFSetAddValue(imageHeaders, images[i]);
+        }
+    }
+    CFMutableDictionaryRef eagerRouterClasses = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    CFMutableSetRef boundRouterClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    for (uint32_t i = 0, count = ZIKFrozenRouteTableEntryCount(table); i < count; i++) {
+        ZIKFrozenRouteEntry entry;
+        if (!ZIKFrozenRouteTableGetEntry(table, i, &entry) ||
+            entry.kind != ZIKFrozenRouteKindEagerRouterClass ||
+            entry.imageIndex == ZIKFrozenRouteTableNoImage ||
+            images[entry.imageIndex] == NULL) {
+            continue;
+        }
+        Class routerClass = objc_getClass(entry.value);
+        if (routerClass == nil) {
+            continue;
+        }
+        NSMutableArray<Class> *routerClasses = (__bridge NSMutableArray *)CFDictionaryGetValue(eagerRouterClasses, images[entry.imageIndex]);
+        if (routerClasses == nil) {
+            routerClasses = [NSMutableArray array];
+            CFDictionarySetValue(eagerRouterClasses, images[entry.imageIndex], (__bridge const void *)(routerClasses));
+        }
+        [routerClasses addObject:routerClass];
+        // Registered when its image is searched in +registerAll
+        CFSetAddValue(boundRouterClasses, (__bridge const void *)(routerClass));
+    }
+    _frozenRouteTable = table;
+    _frozenImages = images;
+    _frozenImageHeaders = imageHeaders;
+    _frozenEagerRouterClasses = eagerRouterClasses;
+    _frozenBoundRouterClasses = boundRouterClasses;
+    _frozenRoutesAllBound = NO;
+    _updateHasPendingRoutes();
+}
+
++ (void)_closeFrozenRouteTable {
+    if (_frozenRouteTable == NULL) {
+        return;
+    }
+    ZIKFrozenRouteTableClose(_frozenRouteTable);
+    _frozenRouteTable = NULL;
+    free(_frozenImages);
+    _frozenImages = NULL;
+    CFRelease(_frozenImageHeaders);
+    _frozenImageHeaders = NULL;
+    CFRelease(_frozenEagerRouterClasses);
+    _frozenEagerRouterClasses = NULL;
+    CFRelease(_frozenBoundRouterClasses);
+    _frozenBoundRouterClasses = NULL;
+    _updateHasPendingRoutes();
+}
+
+/// Router classes to register when searching an image in frozen route table. Return nil if the image is not in the table.
++ (nullable NSArray<Class> *)_eagerRouterClassesInFrozenImage:(const void *)imageHeader {
+    if (_frozenImageHeaders == NULL || !CFSetContainsValue(_frozenImageHeaders, imageHeader)) {
+        return nil;
+    }
+    NSArray<Class> *routerClasses = (__bridge NSArray *)CFDictionaryGetValue(_frozenEagerRouterClasses, imageHeader);
+    return routerClasses ?: @[];
+}
+
++ (BOOL)isAddressInFrozenImage:(const void *)address {
+    if (_frozenImageHeaders == NULL) {
+        return NO;
+    }
+    Dl_info info;
+    if (dladdr(address, &info) == 0) {
+        return NO;
+    }
+    return CFSetContainsValue(_frozenImageHeaders, info.dli_fbase);
+}
+
+/// Register the router class from frozen route table if it's not registered yet. Called with the lock held.
+static BOOL _bindFrozenRouterClass(const ZIKFrozenRouteEntry *entry) {
+    if (entry->imageIndex == ZIKFrozenRouteTableNoImage || _frozenImages[entry->imageIndex] == NULL) {
+        return NO;
+    }
+    Class routerClass = objc_getClass(entry->value);
+    if (routerClass == nil || CFSetContainsValue(_frozenBoundRouterClasses, (__bridge const void *)(routerClass))) {
+        return NO;
+    }
+    CFSetAddValue(_frozenBoundRouterClasses, (__bridge const void *)(routerClass));
+    [ZIKRouteRegistry _registerRouterClassLately:routerClass];
+    return YES;
+}
+
+/// Register router classes for the key in frozen route table. Return YES if any router is registered.
++ (BOOL)_bindFrozenRoutesForKind:(ZIKFrozenRouteKind)kind key:(const char *)key {
+    if (_frozenRouteTable == NULL || key == NULL) {
+        return NO;
+    }
+    pthread_mutex_lock(&_registryLock);
+    uint32_t first = 0;
+    uint32_t count = ZIKFrozenRouteTableLookup(_frozenRouteTable, kind, key, &first);
+    if (count == 0) {
+        pthread_mutex_unlock(&_registryLock);
+        return NO;
+    }
+    BOOL bound = NO;
+    const char *registryName = class_getName(self);
+    for (uint32_t i = first; i < first + count; i++) {
+        ZIKFrozenRouteEntry entry;
+        if (!ZIKFrozenRouteTableGetEntry(_frozenRouteTable, i, &entry) ||
+            strcmp(entry.registry, registryName) != 0) {
+            continue;
+        }
+        if (_bindFrozenRouterClass(&entry)) {
+            bound = YES;
+        }
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return bound;
+}
+
+/// Register all router classes in frozen route table, for lookups without keys in the table. Return YES if any router is registered.
++ (BOOL)_bindAllFrozenRoutes {
+    if (_frozenRouteTable == NULL) {
+        return NO;
+    }
+    pthread_mutex_lock(&_registryLock);
+    if (_frozenRoutesAllBound) {
+        pthread_mutex_unlock(&_registryLock);
+        return NO;
+    }
+    // Registering routers may look up other routers
+    _frozenRoutesAllBound = YES;
+    _updateHasPendingRoutes();
+    BOOL bound = NO;
+    for (uint32_t i = 0, count = ZIKFrozenRouteTableEntryCount(_frozenRouteTable); i < count; i++) {
+        ZIKFrozenRouteEntry entry;
+        if (!ZIKFrozenRouteTableGetEntry(_frozenRouteTable, i, &entry) ||
+            entry.kind != ZIKFrozenRouteKindRouterClass) {
+            continue;
+        }
+        if (_bindFrozenRouterClass(&entry)) {
+            bound = YES;
+        }
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return bound;
+}
+
+#pragma mark Lazy Route
+
++ (void)_registerLazyRouteForKind:(ZIKFrozenRouteKind)kind key:(NSString *)key libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName {
+    NSParameterAssert(key.length > 0);
+    NSParameterAssert(libraryPath.length > 0);
+    NSParameterAssert(routerClassName.length > 0);
+    // Resolve objc class symbol to check the router is in the library. Swift names like `Module.Router` have no such symbol, they are found by name after loading.
+    NSString *symbol = nil;
+    if ([routerClassName rangeOfString:@"."].location == NSNotFound) {
+        symbol = [@"OBJC_CLASS_$_" stringByAppendingString:routerClassName];
+    }
+    BOOL added = ZIKLazyRouteLoaderAddRoute(_lazyRouteLoader, kind, key.UTF8String, libraryPath.UTF8String, routerClassName.UTF8String, symbol.UTF8String);
+    NSAssert2(added, @"Lazy route (%@) is already registered, can't register it with library (%@).", key, libraryPath);
+    (void)added;
+    _updateHasPendingRoutes();
+}
+
++ (void)registerLazyDestinationProtocol:(NSString *)protocolName libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName {
+    [self _registerLazyRouteForKind:ZIKFrozenRouteKindDestinationProtocol key:protocolName libraryPath:libraryPath routerClassName:routerClassName];
+}
+
++ (void)registerLazyModuleProtocol:(NSString *)protocolName libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName {
+    [self _registerLazyRouteForKind:ZIKFrozenRouteKindModuleProtocol key:protocolName libraryPath:libraryPath routerClassName:routerClassName];
+}
+
++ (void)registerLazyIdentifier:(NSString *)identifier libraryPath:(NSString *)libraryPath routerClassName:(NSString *)routerClassName {
+    [self _registerLazyRouteForKind:ZIKFrozenRouteKindIdentifier key:identifier libraryPath:libraryPath routerClassName:routerClassName];
+}
+
+/// Callback of lazy route loader after dlopen. Routers in frameworks may already be registered by the add image callback, otherwise register the router of the route now. It's called with the registry lock held.
+static void _registerLazyRouterClass(void *context, const ZIKLazyRoute *route, void *symbolAddress) {
+    Class routerClass = symbolAddress ? (__bridge Class)symbolAddress : NSClassFromString(@(route->routerName));
+    if (routerClass == nil) {
+        NSLog(@"ZIKRouter: router class (%s) of lazy route (%s) is not found in library (%s).", route->routerName, route->key, route->libraryPath);
+        return;
+    }
+    if (CFSetContainsValue(_loadedImageRouterClasses, (__bridge const void *)(routerClass))) {
+        return;
+    }
+    CFSetAddValue(_loadedImageRouterClasses, (__bridge const void *)(routerClass));
+    [ZIKRouteRegistry _registerRouterClassLately:routerClass];
+}
+
+/// Load library of the lazy route. Return YES if it's loaded now and the lookup should be retried.
++ (BOOL)_loadLazyRouteForKind:(ZIKFrozenRouteKind)kind key:(const char *)key {
+    if (key == NULL || ZIKLazyRouteLoaderRouteCount(_lazyRouteLoader) == 0) {
+        return NO;
+    }
+    ZIKLazyRouteStatus status = ZIKLazyRouteLoaderLoad(_lazyRouteLoader, kind, key, NULL);
+    if (status == ZIKLazyRouteStatusFailed) {
+        NSLog(@"ZIKRouter: failed to load lazy route (%s): %s", key, ZIKLazyRouteLoaderGetError(_lazyRouteLoader, kind, key));
+    }
+    return status == ZIKLazyRouteStatusLoaded;
+}
+
+/// Update `_hasPendingRoutes` after deferred registration, frozen route table or lazy routes change. Lazy routes keep it set, because their libraries are only loaded when lookups miss.
+static void _updateHasPendingRoutes(void) {
+    bool pending = _deferredRegistrationScheduler != NULL ||
+    (_frozenRouteTable != NULL && !_frozenRoutesAllBound) ||
+    ZIKLazyRouteLoaderRouteCount(_lazyRouteLoader) > 0;
+    atomic_store_explicit(&_hasPendingRoutes, pending, memory_order_release);
+}
+
+/// Register routers of the key from frozen route table or lazy routes. Called with the lock held. Return YES if any router is registered.
++ (BOOL)_registerPendingRoutesForKind:(ZIKFrozenRouteKind)kind key:(const char *)key {
+    BOOL bound = [self _bindFrozenRoutesForKind:kind key:key];
+    BOOL loaded = [self _loadLazyRouteForKind:kind key:key];
+    return bound || loaded;
+}
+
+/// Register routers not registered yet for the destination class and its superclasses, from deferred registration, frozen route table or lazy routes. It's called once after a lookup misses in all registered routes and easy routes. Return YES if the lookup should be retried.
++ (BOOL)_registerPendingRoutesForDestinationClass:(Class)destinationClass {
+    // Lazy route loader calls back in the loading thread, so hold the lock before loading. Other threads wait for the lock instead of waiting in the loader.
+    pthread_mutex_lock(&_registryLock);
+    BOOL registered = [ZIKRouteRegistry completeDeferredRegistration];
+    for (Class aClass = destinationClass; aClass && [self isDestinationClassRoutable:aClass]; aClass = class_getSuperclass(aClass)) {
+        if ([self _registerPendingRoutesForKind:ZIKFrozenRouteKindDestinationClass key:class_getName(aClass)]) {
+            registered = YES;
+        }
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return registered;
+}
+
+/// Register routers not registered yet for the identifier. It's called once after a lookup misses in all registered routes and easy routes. Return YES if the lookup should be retried.
++ (BOOL)_registerPendingRoutesForIdentifier:(NSString *)identifier {
+    pthread_mutex_lock(&_registryLock);
+    BOOL completed = [ZIKRouteRegistry completeDeferredRegistration];
+    BOOL registered = [self _registerPendingRoutesForKind:ZIKFrozenRouteKindIdentifier key:identifier.UTF8String];
+    pthread_mutex_unlock(&_registryLock);
+    return completed || registered;
+}
+
+/// Register routers not registered yet for the protocol and the protocols it adapts. It's called once after a lookup misses in all registered routes, easy routes, swift adapters and adaptees. Return YES if the lookup should be retried.
++ (BOOL)_registerPendingRoutesForProtocol:(Protocol *)protocol kind:(ZIKFrozenRouteKind)kind {
+    pthread_mutex_lock(&_registryLock);
+    BOOL registered = [ZIKRouteRegistry completeDeferredRegistration];
+    CFDictionaryRef adapterToAdapteeMap = self.adapterToAdapteeMap;
+    NSMutableSet<Protocol *> *visitedProtocols = [NSMutableSet set];
+    // Adapters registered now may adapt protocols whose routers are not registered yet
+    for (Protocol *adapter = protocol; adapter && ![visitedProtocols containsObject:adapter]; adapter = (__bridge Protocol *)CFDictionaryGetValue(adapterToAdapteeMap, (__bridge const void *)(adapter))) {
+        [visitedProtocols addObject:adapter];
+        const char *key = protocol_getName(adapter);
+        if ([self _registerPendingRoutesForKind:kind key:key]) {
+            registered = YES;
+        }
+        if ([self _registerPendingRoutesForKind:ZIKFrozenRouteKindAdapter key:key]) {
+            registered = YES;
+        }
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return registered;
+}
+
 #pragma mark Discover
 
 + (ZIKRoute *)easyRouteForDestinationClass:(Class)destinationClass factory:(id(^)(ZIKPerformRouteConfiguration * _Nonnull config, __kindof ZIKRouter * _Nonnull router))factory {
@@ -299,6 +1220,20 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (nullable ZIKRouterType *)routerToRegisteredDestinationClass:(Class)destinationClass {
+    _waitForBackgroundRegistration();
+    if (!atomic_load_explicit(&_hasPendingRoutes, memory_order_acquire)) {
+        return [self _routerToRegisteredDestinationClass:destinationClass];
+    }
+    pthread_mutex_lock(&_registryLock);
+    ZIKRouterType *routerType = [self _routerToRegisteredDestinationClass:destinationClass];
+    if (routerType == nil && [self _registerPendingRoutesForDestinationClass:destinationClass]) {
+        routerType = [self _routerToRegisteredDestinationClass:destinationClass];
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToRegisteredDestinationClass:(Class)destinationClass {
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
     CFMutableDictionaryRef destinationToDefaultRouterMap = self.destinationToDefaultRouterMap;
     CFDictionaryRef destinationToExclusiveRouterMap = self.destinationToExclusiveRouterMap;
@@ -326,6 +1261,20 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (nullable ZIKRouterType *)routerToDestination:(Protocol *)destinationProtocol {
+    _waitForBackgroundRegistration();
+    if (!atomic_load_explicit(&_hasPendingRoutes, memory_order_acquire)) {
+        return [self _routerToDestination:destinationProtocol];
+    }
+    pthread_mutex_lock(&_registryLock);
+    ZIKRouterType *routerType = [self _routerToDestination:destinationProtocol];
+    if (routerType == nil && [self _registerPendingRoutesForProtocol:destinationProtocol kind:ZIKFrozenRouteKindDestinationProtocol]) {
+        routerType = [self _routerToDestination:destinationProtocol];
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToDestination:(Protocol *)destinationProtocol {
     NSParameterAssert(destinationProtocol);
     NSAssert(self.destinationProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
     if (!destinationProtocol) {
@@ -376,6 +1325,20 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (nullable ZIKRouterType *)routerToModule:(Protocol *)configProtocol {
+    _waitForBackgroundRegistration();
+    if (!atomic_load_explicit(&_hasPendingRoutes, memory_order_acquire)) {
+        return [self _routerToModule:configProtocol];
+    }
+    pthread_mutex_lock(&_registryLock);
+    ZIKRouterType *routerType = [self _routerToModule:configProtocol];
+    if (routerType == nil && [self _registerPendingRoutesForProtocol:configProtocol kind:ZIKFrozenRouteKindModuleProtocol]) {
+        routerType = [self _routerToModule:configProtocol];
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToModule:(Protocol *)configProtocol {
     NSParameterAssert(configProtocol);
     NSAssert(self.moduleConfigProtocolToRouterMap != nil, @"Didn't register any protocol yet.");
     if (!configProtocol) {
@@ -426,6 +1389,20 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (nullable ZIKRouterType *)routerToIdentifier:(NSString *)identifier {
+    _waitForBackgroundRegistration();
+    if (!atomic_load_explicit(&_hasPendingRoutes, memory_order_acquire)) {
+        return [self _routerToIdentifier:identifier];
+    }
+    pthread_mutex_lock(&_registryLock);
+    ZIKRouterType *routerType = [self _routerToIdentifier:identifier];
+    if (routerType == nil && identifier && [self _registerPendingRoutesForIdentifier:identifier]) {
+        routerType = [self _routerToIdentifier:identifier];
+    }
+    pthread_mutex_unlock(&_registryLock);
+    return routerType;
+}
+
++ (nullable ZIKRouterType *)_routerToIdentifier:(NSString *)identifier {
     if (identifier == nil) {
         return nil;
     }
@@ -437,11 +1414,20 @@ static CFMutableSetRef _factoryBlocks;
 }
 
 + (void)enumerateRoutersForDestinationClass:(Class)destinationClass handler:(void(^)(ZIKRouterType * route))handler {
+    _waitForBackgroundRegistration();
     NSAssert([self isDestinationClassRoutable:destinationClass], @"destination class (%@) should conforms to ZIKRoutableView or ZIKRoutableService.", NSStringFromClass(destinationClass));
     NSParameterAssert(handler);
     if (!destinationClass) {
         return;
     }
+    // Collect routes with the lock held when routes may be registered, and call handler without it
+    NSMutableArray<ZIKRouterType *> *routerTypes = [NSMutableArray array];
+    BOOL locked = atomic_load_explicit(&_hasPendingRoutes, memory_order_acquire);
+    if (locked) {
+        pthread_mutex_lock(&_registryLock);
+        // All routers of the class are enumerated, so pending routes are registered before searching
+        [self _registerPendingRoutesForDestinationClass:destinationClass];
+    }
     CFDictionaryRef destinationToExclusiveRouterMap = self.destinationToExclusiveRouterMap;
     CFDictionaryRef destinationToRoutersMap = self.destinationToRoutersMap;
     while (destinationClass) {
@@ -452,23 +1438,29 @@ static CFMutableSetRef _factoryBlocks;
         if (route) {
             ZIKRouterType *r = [self _routerTypeForObject:route];
             if (r) {
-                handler(r);
+                [routerTypes addObject:r];
             }
         } else {
             CFMutableSetRef routers = (CFMutableSetRef)CFDictionaryGetValue(destinationToRoutersMap, (__bridge const void *)(destinationClass));
             NSSet *routes = (__bridge NSSet *)(routers);
             [routes enumerateObjectsUsingBlock:^(id  _Nonnull route, BOOL * _Nonnull stop) {
-                if (handler) {
-                    ZIKRouterType *r = [self _routerTypeForObject:route];
-                    if (r) {
-                        handler(r);
-                    }
+                ZIKRouterType *r = [self _routerTypeForObject:route];
+                if (r) {
+                    [routerTypes addObject:r];
                 }
             }];
         }
         
         destinationClass = class_getSuperclass(destinationClass);
     }
+    if (locked) {
+        pthread_mutex_unlock(&_registryLock);
+    }
+    if (handler) {
+        for (ZIKRouterType *r in routerTypes) {
+            handler(r);
+        }
+    }
 }
 
 #pragma mark Register
@@ -490,6 +1482,7 @@ static __attribute__((always_inline)) void _registerDestinationClassWithRoute(Cl
         CFDictionarySetValue(destinationToRoutersMap, (__bridge const void *)(destinationClass), routers);
     }
     CFSetAddValue(routers, (__bridge const void *)(routeObject));
+    [registry didRegisterDestinationClass:destinationClass];
     
 #if ZIKROUTER_CHECK
     CFMutableSetRef destinations = (CFMutableSetRef)CFDictionaryGetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject));
@@ -517,6 +1510,7 @@ static __attribute__((always_inline)) void _registerExclusiveDestinationClassWit
     NSCAssert2(!CFDictionaryGetValue([registry destinationToDefaultFactoryMap], (__bridge const void *)(destinationClass)), @"destinationClass (%@) already registered with `registerXXX:forMakingXXX:making:` or `registerXXX:forMakingXXX:factory:`, check and remove them. You shall only use this exclusive router (%@) for this destinationClass.", NSStringFromClass(destinationClass), routeObject);
     
     CFDictionaryAddValue([registry destinationToExclusiveRouterMap], (__bridge const void *)(destinationClass), (__bridge const void *)(routeObject));
+    [registry didRegisterDestinationClass:destinationClass];
     
 #if ZIKROUTER_CHECK
     CFMutableSetRef destinations = (CFMutableSetRef)CFDictionaryGetValue([registry _check_routerToDestinationsMap], (__bridge const void *)(routeObject));
@@ -582,6 +1576,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register destination protocol (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), NSStringFromProtocol(destinationProtocol), destinationClass);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
     CFSetAddValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass {
@@ -596,6 +1592,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
               (self.destinationToExclusiveRouterMap && !CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass))), @"There is a registered exclusive router (%@), can't register identifier (%@) for this destinationClass (%@).",CFDictionaryGetValue(self.destinationToExclusiveRouterMap, (__bridge const void *)(destinationClass)), identifier, destinationClass);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
     CFSetAddValue(self.runtimeFactoryDestinationClasses, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass factoryBlock:(id _Nullable(^ _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))block {
@@ -610,6 +1608,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol, (void *)block);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerModuleProtocol:(Protocol *)configProtocol forMakingDestination:(Class)destinationClass factoryBlock:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^ _Nonnull)(void))block {
@@ -627,6 +1627,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)configProtocol, (void *)block);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)configProtocol, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass factoryBlock:(id _Nullable(^ _Nonnull)(ZIKPerformRouteConfiguration * _Nonnull))block {
@@ -643,6 +1645,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToFactoryMap, (CFStringRef)identifier, (__bridge const void *)block);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass configFactoryBlock:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *(^ _Nonnull)(void))block {
@@ -663,6 +1667,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier, (__bridge const void *)block);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)block);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(*)(ZIKPerformRouteConfiguration * _Nonnull))function {
@@ -678,6 +1684,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.destinationProtocolToFactoryMap, (__bridge const void *)destinationProtocol, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.destinationProtocolToDestinationMap, (__bridge const void *)destinationProtocol, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerModuleProtocol:(Protocol *)configProtocol forMakingDestination:(Class)destinationClass factoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function {
@@ -696,6 +1704,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.moduleConfigProtocolToFactoryMap, (__bridge const void *)configProtocol, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.moduleConfigProtocolToDestinationMap, (__bridge const void *)configProtocol, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass factoryFunction:(id _Nullable(*)(ZIKPerformRouteConfiguration * _Nonnull))function {
@@ -713,6 +1723,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToFactoryMap, (CFStringRef)identifier, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerIdentifier:(NSString *)identifier forMakingDestination:(Class)destinationClass configFactoryFunction:(ZIKPerformRouteConfiguration<ZIKConfigurationMakeable> *_Nonnull(* _Nonnull)(void))function {
@@ -734,6 +1746,8 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     CFDictionaryAddValue(self.identifierToConfigFactoryMap, (CFStringRef)identifier, (void *)function);
     CFDictionaryAddValue(self.destinationToDefaultConfigFactoryMap, (__bridge const void *)destinationClass, (void *)function);
     CFDictionaryAddValue(self.identifierToDestinationMap, (CFStringRef)identifier, (__bridge const void *)destinationClass);
+    _recordEagerRouter();
+    [self didRegisterDestinationClass:destinationClass];
 }
 
 + (void)registerDestination:(Class)destinationClass router:(Class)routerClass {
@@ -763,49 +1777,91 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
 
 + (void)registerDestination:(Class)destinationClass route:(ZIKRoute *)route {
     NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    _recordEagerRouter();
     _registerDestinationClassWithRoute(destinationClass, route, self);
 }
 
 + (void)registerExclusiveDestination:(Class)destinationClass route:(ZIKRoute *)route {
     NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    _recordEagerRouter();
     _registerExclusiveDestinationClassWithRoute(destinationClass, route, self);
 }
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol route:(ZIKRoute *)route {
     NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    _recordEagerRouter();
     _registerDestinationProtocolWithRoute(destinationProtocol, route, self);
 }
 
 + (void)registerModuleProtocol:(Protocol *)configProtocol route:(ZIKRoute *)route {
     NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    _recordEagerRouter();
     _registerModuleProtocolWithRoute(configProtocol, route, self);
 }
 
 + (void)registerIdentifier:(NSString *)identifier route:(ZIKRoute *)route {
     NSParameterAssert([route isKindOfClass:[ZIKRoute class]]);
+    _recordEagerRouter();
     _registerIdentifierWithRoute(identifier, route, self);
 }
 
+/// Record the router registering routes not listed by key in frozen route table, so it's registered at launch when its image is in the table.
+static void _recordEagerRouter(void) {
+    Class registeringRouterClass = _registeringRouterClass;
+    if (registeringRouterClass == nil) {
+        return;
+    }
+    pthread_mutex_lock(&_registryLock);
+    if (_eagerRouterClasses == NULL) {
+        _eagerRouterClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    CFSetAddValue(_eagerRouterClasses, (__bridge const void *)(registeringRouterClass));
+    pthread_mutex_unlock(&_registryLock);
+}
+
++ (void)markRegisteringRouterEager {
+    _recordEagerRouter();
+}
+
+/// Record the router registering the adapter, for writing frozen route table.
+static void _recordAdapterRouter(Protocol *adapterProtocol) {
+    Class registeringRouterClass = _registeringRouterClass;
+    if (registeringRouterClass == nil) {
+        return;
+    }
+    pthread_mutex_lock(&_registryLock);
+    if (_adapterToRouterMap == NULL) {
+        _adapterToRouterMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    CFDictionarySetValue(_adapterToRouterMap, (__bridge const void *)(adapterProtocol), (__bridge const void *)(registeringRouterClass));
+    pthread_mutex_unlock(&_registryLock);
+}
+
 + (void)registerDestinationAdapter:(Protocol *)adapterProtocol forAdaptee:(Protocol *)adapteeProtocol {
     NSAssert2(CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) already register with router (%@)", NSStringFromProtocol(adapterProtocol), CFDictionaryGetValue(self.destinationProtocolToRouterMap, (__bridge const void *)(adapterProtocol)));
     NSAssert3(CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) can't register adaptee (%@),  already register another adaptee (%@)", NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol), CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)));
     CFDictionarySetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol), (__bridge const void *)(adapteeProtocol));
+    _recordAdapterRouter(adapterProtocol);
 }
 
 + (void)registerModuleAdapter:(Protocol *)adapterProtocol forAdaptee:(Protocol *)adapteeProtocol {
     NSAssert2(CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) already register with router (%@)", NSStringFromProtocol(adapterProtocol), CFDictionaryGetValue(self.moduleConfigProtocolToRouterMap, (__bridge const void *)(adapterProtocol)));
     NSAssert3(CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)) == nil, @"Adapter (%@) can't register adaptee (%@),  already register another adaptee (%@)", NSStringFromProtocol(adapterProtocol), NSStringFromProtocol(adapteeProtocol), CFDictionaryGetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol)));
     CFDictionarySetValue(self.adapterToAdapteeMap, (__bridge const void *)(adapterProtocol), (__bridge const void *)(adapteeProtocol));
+    _recordAdapterRouter(adapterProtocol);
 }
 
 #pragma mark Manually Register
 
 + (void)notifyRegistrationFinished {
     NSAssert(self.autoRegister == NO, @"Only use -notifyRegistrationFinished for manually registration.");
+    _waitForBackgroundRegistration();
     if (_registrationFinished) {
         NSAssert(NO, @"Registration is already finished.");
         return;
     }
+    // Routers in frozen route table are registered manually too
+    [self _closeFrozenRouteTable];
     self.registrationFinished = YES;
     
     NSSet *registries = [[self registries] copy];
@@ -814,6 +1870,43 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     }
 }
 
++ (void)registerRouterClassesWithNames:(const char *const *)classNames count:(NSUInteger)count {
+    _waitForBackgroundRegistration();
+    if (_registrationFinished) {
+        NSAssert(NO, @"Registration is already finished.");
+        return;
+    }
+    // Generated code lists router classes in all images
+    [self _closeFrozenRouteTable];
+    NSSet *registries = [[self registries] copy];
+    NSMutableArray<Class> *deferredRouterClasses = _deferredRegistrationEnabled ? [NSMutableArray array] : nil;
+    for (NSUInteger i = 0; i < count; i++) {
+        Class routerClass = objc_lookUpClass(classNames[i]);
+        if (routerClass == nil) {
+            NSAssert(NO, @"Router class (%s) in generated registration code is not found. The registration code is outdated, generate it again.", classNames[i]);
+            continue;
+        }
+        if (deferredRouterClasses && [routerClass canDeferRegistration]) {
+            [deferredRouterClasses addObject:routerClass];
+            continue;
+        }
+        _registeringRouterClass = routerClass;
+        for (Class registry in registries) {
+            [registry handleEnumerateRouterClass:routerClass];
+        }
+    }
+    _registeringRouterClass = nil;
+    self.registrationFinished = YES;
+    _observeAddedImages(NULL, zix_canEnumerateClassesInImage());
+    if ([self _scheduleDeferredRouterClasses:deferredRouterClasses]) {
+        return;
+    }
+    
+    for (Class registry in registries) {
+        [registry didFinishRegistration];
+    }
+}
+
 #pragma mark Check
 
 + (BOOL)validateDestinationConformance:(Class)destinationClass forRouter:(ZIKRouter *)router protocol:(Protocol **)protocol {
@@ -949,6 +2042,14 @@ static __attribute__((always_inline)) void _registerIdentifierWithRoute(NSString
     
 }
 
++ (void)didRegisterDestinationClass:(Class)destinationClass {
+    
+}
+
++ (void)willLoadStoryboard {
+    
+}
+
 + (void)didFinishRegistration {
     
 }
@@ -86,6 +86,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, class, readonly) CFMutableDictionaryRef adapterToAdapteeMap;
 
 + (void)handleEnumerateRouterClass:(Class)aClass;
+/// Invoked after a destination class is registered with a router, a route or a factory. It's called synchronously in the registering thread, which may be a background thread. Default implementation does nothing.
++ (void)didRegisterDestinationClass:(Class)destinationClass;
+/// Invoked before a storyboard is loaded with +storyboardWithName:bundle:. Default implementation does nothing.
++ (void)willLoadStoryboard;
 + (void)didFinishRegistration;
 
 /// Whether the class can be registered into this registry.
@@ -119,6 +123,9 @@ NS_ASSUME_NONNULL_BEGIN
 + (void)registerDestinationAdapter:(Protocol *)adapterProtocol forAdaptee:(Protocol *)adapteeProtocol;
 + (void)registerModuleAdapter:(Protocol *)adapterProtocol forAdaptee:(Protocol *)adapteeProtocol;
 
+/// Mark the router calling +registerRoutableDestination as registering routes not listed by key in frozen route table, such as pure swift protocols in ZRouter. It's registered at launch even if its image is in the table.
++ (void)markRegisteringRouterEager;
+
 
 
 + (void)registerDestinationProtocol:(Protocol *)destinationProtocol forMakingDestination:(Class)destinationClass;
@@ -140,6 +147,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark Check
 
+/// Whether the address is in an image of frozen route table. Routers in these images are not registered at launch, validations should skip classes and protocols in them. They were validated in the app writing the table.
++ (BOOL)isAddressInFrozenImage:(const void *)address;
 // Validate whether the destination conforms to all destination protocols of the router. Only available when ZIKROUTER_CHECK is true.
 + (BOOL)validateDestinationConformance:(Class)destinationClass forRouter:(ZIKRouter *)router protocol:(Protocol *_Nullable*_Nullable)protocol;
 // Validate all registered view classes of this router class, return the class when the validater return false. Only available when ZIKROUTER_CHECK is true.
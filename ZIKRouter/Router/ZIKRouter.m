@@ -561,6 +561,10 @@ NSErrorDomain const ZIKRouteErrorDomain = @"ZIKRouteErrorDomain";
     return NO;
 }
 
++ (BOOL)canDeferRegistration {
+    return NO;
+}
+
 - (void)performRouteOnDestination:(id)destination configuration:(ZIKPerformRouteConfiguration *)configuration {
     NSAssert(NO, @"Router: %@ must override %@!",[self class],NSStringFromSelector(_cmd));
     [self prepareDestinationForPerforming];
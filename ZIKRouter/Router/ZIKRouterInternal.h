@@ -112,6 +112,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// Whether this router is an adapter for another router.
 + (BOOL)isAdapter;
 
+/// Whether registration of this router can be deferred until main run loop is idle, when ZIKRouteRegistry.deferredRegistrationEnabled is YES. Return YES for routers not used when app launches. Default is NO.
++ (BOOL)canDeferRegistration;
+
 #pragma mark Custom Route State Control
 
 /// Maintain the route state when you implement custom route or remove route by overriding -performRouteOnDestination:configuration: or -removeDestination:removeConfiguration:.
@@ -277,6 +277,8 @@ static NSMutableArray<Class> *_routerClasses;
 
 + (void)enumerateAllServiceRouters:(void(NS_NOESCAPE ^)(Class _Nullable routerClass, ZIKServiceRoute * _Nullable route))handler {
     static NSSet *cachedAllRouters;
+    // Routers in maps are incomplete before deferred routers and routers in frozen route table are registered
+    [self completeRegistration];
     NSSet *routers;
     if ([self registrationFinished] && cachedAllRouters && cachedAllRouters.count > 0) {
         routers = cachedAllRouters;
@@ -318,8 +320,15 @@ static NSMutableArray<Class> *_routerClasses;
             return;
         }
         if (class_conformsToProtocol(class, @protocol(ZIKRoutableService))) {
+            if ([self isAddressInFrozenImage:(__bridge const void *)(class)]) {
+                return;
+            }
             [_routableDestinations addObject:class];
         } else if (zix_classIsSubclassOfClass(class, [ZIKServiceRouter class])) {
+            // Routers in frozen route table are registered lazily
+            if ([self isAddressInFrozenImage:(__bridge const void *)(class)]) {
+                return;
+            }
             if (!(zix_classSelfImplementingMethod(class, @selector(registerRoutableDestination), true) ||
                   [class isAbstractRouter])) {
                 [errorDescription appendFormat:@"\n\n❌Router(%@) must override +registerRoutableDestination to register destination.", class];
@@ -367,7 +376,7 @@ static NSMutableArray<Class> *_routerClasses;
 + (void)_checkAllRoutableProtocols {
     NSMutableString *errorDescription = [NSMutableString string];
     zix_enumerateProtocolList(^(Protocol *protocol) {
-        if (protocol) {
+        if (protocol && ![self isAddressInFrozenImage:(__bridge const void *)(protocol)]) {
             NSString *error = [self _checkProtocol:protocol];
             if (error) {
                 [errorDescription appendString:error];
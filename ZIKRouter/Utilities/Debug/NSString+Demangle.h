@@ -11,6 +11,7 @@
 
 
 #import <Foundation/Foundation.h>
+#import "ZIKDemangleCache.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -34,6 +35,9 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSString *)demangledAsSimplifiedSwift;
 
+/// Hits and misses of the cache used by `demangledAsSwift` and `demangledAsSimplifiedSwift`. Demangled names are cached, so repeated symbols are demangled only once. All fields are 0 when swift is not used.
++ (ZIKDemangleCacheStatistics)swiftDemangleCacheStatistics;
+
 @end
 
 #endif
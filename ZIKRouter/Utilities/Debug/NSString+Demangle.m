@@ -15,38 +15,61 @@
 
 #import <dlfcn.h>
 
-static const char *demangleAsSwiftString(const char *name) {
-    typedef char *(*swift_demangle_ft)(const char *mangledName, size_t mangledNameLength, char *outputBuffer, size_t *outputBufferSize, uint32_t flags);
-    static swift_demangle_ft swift_demangle_f;
+/// Max count of cached names. Validation demangles thousands of symbols, and many of them are repeated.
+static const size_t ZIKSwiftDemangleCacheCapacity = 4096;
+
+static ZIKDemangleCacheRef swiftDemangleCache(void) {
+    static ZIKDemangleCacheRef cache;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        swift_demangle_f = (swift_demangle_ft) dlsym(RTLD_DEFAULT, "swift_demangle");
+        ZIKDemangleFunction swift_demangle_f = (ZIKDemangleFunction) dlsym(RTLD_DEFAULT, "swift_demangle");
+        if (swift_demangle_f) {
+            cache = ZIKDemangleCacheCreate(swift_demangle_f, ZIKSwiftDemangleCacheCapacity);
+        }
     });
-    
-    if (swift_demangle_f) {
-        return swift_demangle_f(name, strlen(name), 0, 0, 0);
+    return cache;
+}
+
+static NSString *demangleAsSwiftString(const char *name) {
+    ZIKDemangleCacheRef cache = swiftDemangleCache();
+    if (cache == NULL || name == NULL) {
+        return nil;
+    }
+    size_t length = 0;
+    char *demangled = ZIKDemangleCacheCopyDemangledName(cache, name, &length);
+    if (demangled == NULL) {
+        return nil;
     }
-    return name;
+    NSString *string = [[NSString alloc] initWithBytesNoCopy:demangled length:length encoding:NSUTF8StringEncoding freeWhenDone:YES];
+    if (string == nil) {
+        //The buffer is not freed when the string can't be created
+        free(demangled);
+    }
+    return string;
 }
 
 @implementation NSString (Demangle)
 
 - (NSString *)demangledAsSwift {
-    const char *demangledString = demangleAsSwiftString(self.UTF8String);
+    NSString *demangledString = demangleAsSwiftString(self.UTF8String);
     if (demangledString) {
-        return @(demangledString);
+        return demangledString;
     }
     return self;
 }
 
 - (NSString *)demangledAsSimplifiedSwift {
-    const char *demangledString = demangleAsSwiftString(self.UTF8String);
+    NSString *demangledString = demangleAsSwiftString(self.UTF8String);
     if (demangledString) {
-        return @(demangledString);
+        return demangledString;
     }
     return self;
 }
 
++ (ZIKDemangleCacheStatistics)swiftDemangleCacheStatistics {
+    return ZIKDemangleCacheGetStatistics(swiftDemangleCache());
+}
+
 @end
 
 #endif
@@ -0,0 +1,133 @@
+//
+//  ZIKDemangleCache.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKDemangleCache.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace zix;
+
+struct ZIKDemangleCache {
+    DemangleCache cache;
+
+    ZIKDemangleCache(ZIKDemangleFunction demangle, size_t capacity) : cache(demangle, capacity) {}
+};
+
+DemangleCache::DemangleCache(ZIKDemangleFunction demangle, size_t capacity)
+: demangle_(demangle), capacity_(capacity == 0 ? 1 : capacity), hits_(0), misses_(0), evictions_(0) {
+    index_.reserve(capacity_);
+}
+
+bool DemangleCache::demangle(const char *name, std::string &demangled) {
+    if (name == nullptr) {
+        return false;
+    }
+    SymbolName key = {name, strlen(name)};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_map<SymbolName, EntryIterator, SymbolNameHash, SymbolNameEqual>::iterator it = index_.find(key);
+        if (it != index_.end()) {
+            hits_++;
+            // Move to the front
+            entries_.splice(entries_.begin(), entries_, it->second);
+            if (!it->second->succeeded) {
+                return false;
+            }
+            demangled = it->second->demangled;
+            return true;
+        }
+        misses_++;
+    }
+
+    Entry entry;
+    entry.mangled.assign(name, key.length);
+    entry.succeeded = false;
+    if (demangle_) {
+        char *result = demangle_(name, key.length, nullptr, nullptr, 0);
+        if (result != nullptr) {
+            entry.demangled = result;
+            entry.succeeded = true;
+            free(result);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry &cached = insert(std::move(entry));
+    if (!cached.succeeded) {
+        return false;
+    }
+    demangled = cached.demangled;
+    return true;
+}
+
+const DemangleCache::Entry &DemangleCache::insert(Entry &&entry) {
+    SymbolName key = {entry.mangled.c_str(), entry.mangled.size()};
+    std::unordered_map<SymbolName, EntryIterator, SymbolNameHash, SymbolNameEqual>::iterator it = index_.find(key);
+    if (it != index_.end()) {
+        return *it->second;
+    }
+    if (entries_.size() >= capacity_) {
+        const Entry &last = entries_.back();
+        SymbolName lastKey = {last.mangled.c_str(), last.mangled.size()};
+        index_.erase(lastKey);
+        entries_.pop_back();
+        evictions_++;
+    }
+    entries_.push_front(std::move(entry));
+    // Strings in list nodes are not moved again, so the key stays valid
+    SymbolName newKey = {entries_.front().mangled.c_str(), entries_.front().mangled.size()};
+    index_.insert(std::make_pair(newKey, entries_.begin()));
+    return entries_.front();
+}
+
+ZIKDemangleCacheStatistics DemangleCache::statistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ZIKDemangleCacheStatistics statistics = {hits_, misses_, evictions_, entries_.size(), capacity_};
+    return statistics;
+}
+
+void DemangleCache::removeAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+}
+
+ZIKDemangleCacheRef ZIKDemangleCacheCreate(ZIKDemangleFunction demangle, size_t capacity) {
+    return new ZIKDemangleCache(demangle, capacity);
+}
+
+void ZIKDemangleCacheDestroy(ZIKDemangleCacheRef cache) {
+    delete cache;
+}
+
+char *ZIKDemangleCacheCopyDemangledName(ZIKDemangleCacheRef cache, const char *name, size_t *length) {
+    std::string demangled;
+    if (cache == nullptr || !cache->cache.demangle(name, demangled)) {
+        return nullptr;
+    }
+    char *copy = static_cast<char *>(malloc(demangled.size() + 1));
+    if (copy == nullptr) {
+        return nullptr;
+    }
+    memcpy(copy, demangled.c_str(), demangled.size() + 1);
+    if (length) {
+        *length = demangled.size();
+    }
+    return copy;
+}
+
+ZIKDemangleCacheStatistics ZIKDemangleCacheGetStatistics(ZIKDemangleCacheRef cache) {
+    if (cache == nullptr) {
+        ZIKDemangleCacheStatistics statistics = {0, 0, 0, 0, 0};
+        return statistics;
+    }
+    return cache->cache.statistics();
+}
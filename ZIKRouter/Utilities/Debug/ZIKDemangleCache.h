@@ -0,0 +1,121 @@
+//
+//  ZIKDemangleCache.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKDemangleCache_h
+#define ZIKDemangleCache_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Signature of `swift_demangle`. It returns a `malloc`'d string when `outputBuffer` is NULL, or NULL when the name can't be demangled.
+typedef char *(*ZIKDemangleFunction)(const char *mangledName, size_t mangledNameLength, char *outputBuffer, size_t *outputBufferSize, uint32_t flags);
+
+/// Bounded cache of mangled name → demangled name.
+typedef struct ZIKDemangleCache *ZIKDemangleCacheRef;
+
+typedef struct {
+    /// Lookups answered by the cache, including names that can't be demangled.
+    uint64_t hits;
+    /// Lookups calling the demangle function.
+    uint64_t misses;
+    /// Names removed when the cache is full.
+    uint64_t evictions;
+    /// Count of cached names.
+    size_t count;
+    /// Max count of cached names.
+    size_t capacity;
+} ZIKDemangleCacheStatistics;
+
+/**
+ Create a cache.
+
+ @param demangle The demangle function, such as `swift_demangle` found with `dlsym`.
+ @param capacity Max count of cached names. The least recently used name is removed when it's full.
+ */
+extern ZIKDemangleCacheRef ZIKDemangleCacheCreate(ZIKDemangleFunction demangle, size_t capacity);
+
+extern void ZIKDemangleCacheDestroy(ZIKDemangleCacheRef cache);
+
+/**
+ Demangle a name, calling the demangle function only when the name is not cached. It's thread safe.
+
+ @param cache The cache.
+ @param name The mangled name.
+ @param length Length of the returned string. Can be NULL.
+ @return A `malloc`'d copy of the demangled name, the caller must free it. NULL when the name can't be demangled.
+ */
+extern char *ZIKDemangleCacheCopyDemangledName(ZIKDemangleCacheRef cache, const char *name, size_t *length);
+
+extern ZIKDemangleCacheStatistics ZIKDemangleCacheGetStatistics(ZIKDemangleCacheRef cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "ZIKSymbolIndex.h"
+
+namespace zix {
+
+/**
+ Least recently used cache of mangled name → demangled name, keyed by hash of the C string. Names that can't be demangled are cached too, so Objective-C and C names are not passed to the demangle function again.
+
+ Buffers returned by the demangle function are freed after copying. The function is called without the lock, so slow demangling doesn't block lookups in other threads.
+ */
+class DemangleCache {
+public:
+    DemangleCache(ZIKDemangleFunction demangle, size_t capacity);
+
+    /// Demangle the name. Return false when it can't be demangled.
+    bool demangle(const char *name, std::string &demangled);
+
+    ZIKDemangleCacheStatistics statistics();
+
+    void removeAll();
+
+private:
+    struct Entry {
+        std::string mangled;
+        std::string demangled;
+        bool succeeded;
+    };
+    typedef std::list<Entry>::iterator EntryIterator;
+
+    /// Add an entry as the most recently used one. Return the cached entry when another thread added the same name.
+    const Entry &insert(Entry &&entry);
+
+    ZIKDemangleFunction demangle_;
+    size_t capacity_;
+    std::mutex mutex_;
+    /// The most recently used entry is at the front.
+    std::list<Entry> entries_;
+    /// Keys point to mangled names in entries_.
+    std::unordered_map<SymbolName, EntryIterator, SymbolNameHash, SymbolNameEqual> index_;
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKDemangleCache_h */
@@ -13,14 +13,18 @@
 #define FindSymbol_hpp
 
 #include <stdio.h>
+#include <stdint.h>
 
 #if DEBUG
 
 typedef const void *ZIKImageRef;
 
-/// Get beginning address of a loaded image.
+/// Get beginning address of the first loaded image whose path ends with `file`. Paths are recorded once and kept up to date with dyld callbacks, and results are cached.
 extern ZIKImageRef ZIKGetImageByName(const char *file);
 
+/// Same as ZIKGetImageByName, also get the slide of the image.
+extern ZIKImageRef ZIKGetImageAndSlideByName(const char *file, intptr_t *slide);
+
 /**
  Find function pointer address of a symbol in the loaded image. You can get static function's address which not supported by dlsym().
  @note
@@ -32,6 +36,16 @@ extern ZIKImageRef ZIKGetImageByName(const char *file);
  */
 extern void *ZIKFindSymbol(ZIKImageRef image, const char *name);
 
+/**
+ Find addresses of several symbols in the loaded image at once. It's faster than finding them one by one.
+
+ @param image The image to search in, pass NULL to search in all images.
+ @param count Count of names.
+ @param names The symbols to completely match. Need to add `_` when finding a C function name.
+ @param values Addresses of the symbols, NULL when a symbol was not found. An array with count items.
+ */
+extern void ZIKFindSymbols(ZIKImageRef image, size_t count, const char *const names[], void *values[]);
+
 /**
  Find function pointer address of a symbol in the loaded image. You can get static function's address which not supported by dlsym().
  @note
@@ -43,7 +57,16 @@ extern void *ZIKFindSymbol(ZIKImageRef image, const char *name);
  */
 extern void *ZIKFindSymbol(ZIKImageRef image, bool(^matchingBlock)(const char *));
 
-/// Get symbol of a address.
+/**
+ Find a symbol in LC_SYMTAB of a Mach-O file without loading it, such as a dSYM keeping local symbols stripped from the app. FAT file uses the slice of the current architecture.
+
+ @param path Path of the thin or FAT Mach-O file.
+ @param name The symbol to completely match.
+ @return Vm address of the symbol in the file, without slide. 0 when the file is invalid or the symbol was not found.
+ */
+extern uint64_t ZIKFindSymbolInFile(const char *path, const char *name);
+
+/// Get symbol of a address. It is the nearest symbol at or before the address in its image, including local symbols, without the leading `_` like dladdr. Symbols of each image are sorted by address on first use, so later lookups are binary searches.
 extern const char *ZIKSymbolNameForAddress(void *address);
 
 /// Get image file path of a address.
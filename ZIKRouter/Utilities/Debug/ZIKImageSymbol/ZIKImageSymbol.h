@@ -36,6 +36,16 @@ typedef const void *ZIKImageRef;
  */
 + (void *)findSymbolInImage:(_Nullable ZIKImageRef)image name:(const char *)symbolName;
 
+/**
+ Find addresses of several symbols in the loaded image at once. It's faster than finding them one by one.
+ 
+ @param image The image to search in, pass NULL to search in all images.
+ @param symbolNames The symbols to find. Need to add `_` when finding a C function name.
+ @param count Count of symbolNames.
+ @param values Addresses of the symbols, NULL when a symbol was not found. An array with count items.
+ */
++ (void)findSymbolsInImage:(_Nullable ZIKImageRef)image names:(const char *_Nonnull const *_Nonnull)symbolNames count:(NSUInteger)count values:(void *_Nullable *_Nonnull)values;
+
 /**
  Find function pointer address of a symbol in the loaded image. You can get static function's address which not supported by dlsym().
  @note
@@ -47,7 +57,7 @@ typedef const void *ZIKImageRef;
  */
 + (void *)findSymbolInImage:(_Nullable ZIKImageRef)image matching:(BOOL(^)(const char *symbolName))matchingBlock;
 
-/// Get symbol of a address.
+/// Get symbol of a address. It is the nearest symbol at or before the address in its image, including local symbols.
 + (nullable NSString *)symbolNameForAddress:(void *)address;
 
 /// Get image file path of a address.
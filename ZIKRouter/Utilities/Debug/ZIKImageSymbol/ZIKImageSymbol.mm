@@ -42,6 +42,12 @@
     return symbol;
 }
 
++ (void)findSymbolsInImage:(ZIKImageRef)image names:(const char * const *)symbolNames count:(NSUInteger)count values:(void **)values {
+    NSParameterAssert(symbolNames);
+    NSParameterAssert(values);
+    ZIKFindSymbols(image, count, symbolNames, values);
+}
+
 + (void *)findSymbolInImage:(ZIKImageRef)image matching:(BOOL(^)(const char *symbolName))matchingBlock {
     NSParameterAssert(matchingBlock);
     void *symbol = ZIKFindSymbol(image, ^bool(const char *symbolName) {
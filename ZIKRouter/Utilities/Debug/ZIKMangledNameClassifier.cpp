@@ -0,0 +1,271 @@
+//
+//  ZIKMangledNameClassifier.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKMangledNameClassifier.h"
+#include <string.h>
+
+using namespace zix;
+
+namespace {
+
+bool hasPrefix(const char *name, size_t length, const char *prefix) {
+    size_t prefixLength = strlen(prefix);
+    return length >= prefixLength && memcmp(name, prefix, prefixLength) == 0;
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isLetter(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/// Legacy names start with `_T` and an entity operator, such as `_TF` for functions and `_Tt` for types.
+bool isLegacyOperator(char c) {
+    return c != '\0' && strchr("FtMWvTLoZ", c) != nullptr;
+}
+
+/// `Tg5`, `Tgq5`, `TG5`, `Ts5`, `Tp5`.
+bool isSpecialization(const char *body, size_t length) {
+    size_t i = length;
+    if (i == 0 || !isDigit(body[i - 1])) {
+        return false;
+    }
+    while (i > 0 && isDigit(body[i - 1])) {
+        i--;
+    }
+    // An optional flag of specialization, such as `q` of `Tgq5`
+    if (i >= 3 && body[i - 1] >= 'a' && body[i - 1] <= 'z' && body[i - 3] == 'T' && strchr("gGsp", body[i - 2]) != nullptr) {
+        return true;
+    }
+    return i >= 2 && body[i - 2] == 'T' && strchr("gGsp", body[i - 1]) != nullptr;
+}
+
+/// `fU_`, `fU0_`, `fu_`.
+bool isClosure(const char *body, size_t length) {
+    if (length < 3 || body[length - 1] != '_') {
+        return false;
+    }
+    size_t i = length - 1;
+    while (i > 0 && isDigit(body[i - 1])) {
+        i--;
+    }
+    return i >= 2 && (body[i - 1] == 'U' || body[i - 1] == 'u') && body[i - 2] == 'f';
+}
+
+/// `vg`, `vs`, `vM`, `ig`, `vau`...
+bool isAccessor(const char *body, size_t length) {
+    if (length < 2) {
+        return false;
+    }
+    char previous = body[length - 2];
+    char last = body[length - 1];
+    // Addressors
+    if (length >= 3 && (body[length - 3] == 'v' || body[length - 3] == 'i') && (previous == 'a' || previous == 'l') && (last == 'u' || last == 'o')) {
+        return true;
+    }
+    return (previous == 'v' || previous == 'i') && strchr("gsMmrwW", last) != nullptr;
+}
+
+ZIKMangledNameKind kindOfOperators(const char *body, size_t length) {
+    if (isSpecialization(body, length)) {
+        return ZIKMangledNameKindSpecialization;
+    }
+    if (isClosure(body, length)) {
+        return ZIKMangledNameKindClosure;
+    }
+    // Static members end with `Z`
+    if (length >= 2 && body[length - 1] == 'Z') {
+        length--;
+        if (body[length - 1] == 'F') {
+            return ZIKMangledNameKindFunction;
+        }
+        return isAccessor(body, length) ? ZIKMangledNameKindAccessor : ZIKMangledNameKindOther;
+    }
+    if (length < 2) {
+        return ZIKMangledNameKindOther;
+    }
+    char previous = body[length - 2];
+    char last = body[length - 1];
+    switch (previous) {
+        case 'M':
+            switch (last) {
+                case 'a':
+                    return ZIKMangledNameKindTypeMetadataAccessor;
+                case 'D':
+                    return ZIKMangledNameKindTypeMetadataCache;
+                case 'n':
+                    return ZIKMangledNameKindNominalTypeDescriptor;
+                case 'p':
+                    return ZIKMangledNameKindProtocolDescriptor;
+                case 'c':
+                    return ZIKMangledNameKindProtocolConformanceDescriptor;
+                case 'f':
+                    return ZIKMangledNameKindTypeMetadata;
+                default:
+                    return ZIKMangledNameKindOther;
+            }
+        case 'W':
+            return last == 'P' ? ZIKMangledNameKindProtocolWitnessTable : ZIKMangledNameKindOther;
+        case 'f':
+            return last == 'C' || last == 'c' ? ZIKMangledNameKindInitializer : ZIKMangledNameKindOther;
+        case 'T':
+            if (isLetter(last)) {
+                return ZIKMangledNameKindThunk;
+            }
+            break;
+        default:
+            break;
+    }
+    if (isAccessor(body, length)) {
+        return ZIKMangledNameKindAccessor;
+    }
+    switch (last) {
+        case 'F':
+            return ZIKMangledNameKindFunction;
+        case 'N':
+            return ZIKMangledNameKindTypeMetadata;
+        default:
+            return ZIKMangledNameKindOther;
+    }
+}
+
+/// Read the module at the start of the entity. Return false when it can't be read without demangling.
+bool readModule(const char *body, size_t length, const char *&module, size_t &moduleLength) {
+    if (length == 0) {
+        return false;
+    }
+    if (body[0] == 's') {
+        module = "Swift";
+        moduleLength = 5;
+        return true;
+    }
+    if (body[0] == 'S') {
+        if (length < 2 || !isLetter(body[1])) {
+            return false;
+        }
+        if (body[1] == 'o') {
+            module = "__C";
+        } else if (body[1] == 'C') {
+            module = "__C_Synthesized";
+        } else {
+            // Standard types, such as `SS` of String and `Si` of Int
+            module = "Swift";
+        }
+        moduleLength = strlen(module);
+        return true;
+    }
+    // Identifiers starting with `0` have word substitutions or punycode
+    if (body[0] < '1' || body[0] > '9') {
+        return false;
+    }
+    size_t i = 0;
+    size_t count = 0;
+    while (i < length && isDigit(body[i]) && count < length) {
+        count = count * 10 + static_cast<size_t>(body[i] - '0');
+        i++;
+    }
+    if (count == 0 || count > length - i) {
+        return false;
+    }
+    module = body + i;
+    moduleLength = count;
+    return true;
+}
+
+bool isCandidate(const char *name, size_t length, uint32_t kinds, const char *module, size_t moduleLength) {
+    ZIKMangledNameInfo info;
+    if (!classifyMangledName(name, length, info)) {
+        return false;
+    }
+    if ((info.kind & kinds) == 0) {
+        return false;
+    }
+    if (moduleLength == 0 || info.module == nullptr) {
+        return true;
+    }
+    return info.moduleLength == moduleLength && memcmp(info.module, module, moduleLength) == 0;
+}
+
+} // namespace
+
+bool zix::classifyMangledName(const char *name, size_t length, ZIKMangledNameInfo &info) {
+    info.mangling = ZIKSwiftManglingNone;
+    info.kind = ZIKMangledNameKindOther;
+    info.module = nullptr;
+    info.moduleLength = 0;
+    if (name == nullptr) {
+        return false;
+    }
+    // Mach-O symbols have a leading `_`
+    if (length > 1 && name[0] == '_' && (name[1] == '$' || name[1] == '_')) {
+        name++;
+        length--;
+    }
+    size_t prefixLength;
+    if (hasPrefix(name, length, "$s")) {
+        info.mangling = ZIKSwiftMangling5;
+        prefixLength = 2;
+    } else if (hasPrefix(name, length, "$S")) {
+        info.mangling = ZIKSwiftMangling4_2;
+        prefixLength = 2;
+    } else if (hasPrefix(name, length, "_T0")) {
+        info.mangling = ZIKSwiftMangling4;
+        prefixLength = 3;
+    } else if (length > 2 && hasPrefix(name, length, "_T") && isLegacyOperator(name[2])) {
+        // Operators of legacy mangling are not read
+        info.mangling = ZIKSwiftManglingLegacy;
+        return true;
+    } else {
+        return false;
+    }
+
+    const char *body = name + prefixLength;
+    size_t bodyLength = length - prefixLength;
+    // Suffixes added by compiler and linker, such as `.cold.1` and `.llvm.123`
+    const char *suffix = static_cast<const char *>(memchr(body, '.', bodyLength));
+    if (suffix) {
+        bodyLength = static_cast<size_t>(suffix - body);
+    }
+    info.kind = kindOfOperators(body, bodyLength);
+    if (!readModule(body, bodyLength, info.module, info.moduleLength)) {
+        info.module = nullptr;
+        info.moduleLength = 0;
+    }
+    return true;
+}
+
+MangledNameFilter::MangledNameFilter(uint32_t kinds, const char *module) : kinds_(kinds), module_(module ? module : "") {}
+
+bool MangledNameFilter::accepts(const char *name) const {
+    return name != nullptr && accepts(name, strlen(name));
+}
+
+bool MangledNameFilter::accepts(const char *name, size_t length) const {
+    return isCandidate(name, length, kinds_, module_.data(), module_.size());
+}
+
+bool ZIKClassifyMangledName(const char *name, ZIKMangledNameInfo *info) {
+    ZIKMangledNameInfo result;
+    bool swift = classifyMangledName(name, name ? strlen(name) : 0, result);
+    if (info) {
+        *info = result;
+    }
+    return swift;
+}
+
+bool ZIKMangledNameIsCandidate(const char *name, uint32_t kinds, const char *module) {
+    if (name == nullptr) {
+        return false;
+    }
+    return isCandidate(name, strlen(name), kinds, module, module ? strlen(module) : 0);
+}
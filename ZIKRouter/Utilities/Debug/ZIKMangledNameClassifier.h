@@ -0,0 +1,132 @@
+//
+//  ZIKMangledNameClassifier.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKMangledNameClassifier_h
+#define ZIKMangledNameClassifier_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Mangling of a symbol name, from its prefix.
+typedef enum {
+    /// C, C++ or Objective-C symbol.
+    ZIKSwiftManglingNone,
+    /// `_T`, before Swift 4.
+    ZIKSwiftManglingLegacy,
+    /// `_T0`, Swift 4.
+    ZIKSwiftMangling4,
+    /// `$S`, Swift 4.2.
+    ZIKSwiftMangling4_2,
+    /// `$s`, Swift 5 and later.
+    ZIKSwiftMangling5,
+} ZIKSwiftMangling;
+
+/// Kind of a swift symbol, from operators at the end of its mangled name. Values can be combined as a mask.
+typedef enum {
+    /// Unknown operators, legacy mangling, and symbols not listed below, such as deinitializers and property descriptors.
+    ZIKMangledNameKindOther                         = 1 << 0,
+    /// `F`, `FZ`: function or method.
+    ZIKMangledNameKindFunction                      = 1 << 1,
+    /// `fC`, `fc`: initializer.
+    ZIKMangledNameKindInitializer                   = 1 << 2,
+    /// `vg`, `vs`, `vM`, `ig`...: getter, setter, modify and other accessors of variables and subscripts.
+    ZIKMangledNameKindAccessor                      = 1 << 3,
+    /// `fU_`, `fu_`: closure.
+    ZIKMangledNameKindClosure                       = 1 << 4,
+    /// `N`, `Mf`: type metadata.
+    ZIKMangledNameKindTypeMetadata                  = 1 << 5,
+    /// `Ma`: type metadata accessor.
+    ZIKMangledNameKindTypeMetadataAccessor          = 1 << 6,
+    /// `MD`: demangling cache variable of type metadata.
+    ZIKMangledNameKindTypeMetadataCache             = 1 << 7,
+    /// `Mn`: nominal type descriptor.
+    ZIKMangledNameKindNominalTypeDescriptor         = 1 << 8,
+    /// `Mp`: protocol descriptor.
+    ZIKMangledNameKindProtocolDescriptor            = 1 << 9,
+    /// `Mc`: protocol conformance descriptor.
+    ZIKMangledNameKindProtocolConformanceDescriptor = 1 << 10,
+    /// `WP`: protocol witness table.
+    ZIKMangledNameKindProtocolWitnessTable          = 1 << 11,
+    /// `TA`, `To`, `TW`, `Tq`...: thunks, method descriptors and merged functions.
+    ZIKMangledNameKindThunk                         = 1 << 12,
+    /// `Tg5`, `Tgq5`, `TG5`, `Ts5`: generic specialization.
+    ZIKMangledNameKindSpecialization                = 1 << 13,
+    ZIKMangledNameKindAll                           = (1 << 14) - 1,
+} ZIKMangledNameKind;
+
+typedef struct {
+    ZIKSwiftMangling mangling;
+    /// ZIKMangledNameKindOther when it's not a swift symbol.
+    ZIKMangledNameKind kind;
+    /// Module of the outermost entity, such as "ZRouter", "Swift" or "__C". Not null terminated. NULL when it can't be read without demangling.
+    const char *module;
+    size_t moduleLength;
+} ZIKMangledNameInfo;
+
+/**
+ Classify a symbol name by reading its mangled form only. It doesn't demangle the name, so it's cheap enough for every symbol in an image.
+
+ @param name The symbol name, with or without the leading `_` of Mach-O symbols.
+ @param info Mangling, kind and module of the name. Can be NULL.
+ @return True when it's a swift symbol.
+ */
+extern bool ZIKClassifyMangledName(const char *name, ZIKMangledNameInfo *info);
+
+/**
+ Whether a symbol is a swift symbol of the kinds in the module, so it's worth demangling. Names whose module can't be read are candidates of any module.
+
+ @param name The symbol name.
+ @param kinds Mask of ZIKMangledNameKind.
+ @param module Module of the outermost entity. NULL for any module.
+ */
+extern bool ZIKMangledNameIsCandidate(const char *name, uint32_t kinds, const char *module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <string>
+
+namespace zix {
+
+/**
+ Read the mangling prefix, the operators at the end, and the first module of a symbol name.
+
+ Operators are matched after removing suffixes such as `.cold.1` and a trailing `Z` of static members. The module is read from the identifier or the standard substitution (`s`, `S*`, `So`, `SC`) right after the prefix. Identifiers with word substitutions or punycode, and legacy names, have no module.
+ */
+bool classifyMangledName(const char *name, size_t length, ZIKMangledNameInfo &info);
+
+/// Prefilter of symbols before demangling, keeping swift symbols of some kinds in a module.
+class MangledNameFilter {
+public:
+    /// Pass ZIKMangledNameKindAll for all kinds, and nullptr or an empty module for all modules.
+    MangledNameFilter(uint32_t kinds, const char *module);
+
+    bool accepts(const char *name) const;
+    bool accepts(const char *name, size_t length) const;
+
+private:
+    uint32_t kinds_;
+    std::string module_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKMangledNameClassifier_h */
@@ -0,0 +1,95 @@
+//
+//  ZIKTypeMatchCache.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKTypeMatchCache.h"
+
+using namespace zix;
+
+struct ZIKTypeMatchCache {
+    TypeMatchCache cache;
+};
+
+size_t TypeMatchCache::KeyHash::operator()(const Key &key) const {
+    // Pointers are aligned, mix high bits into low bits used by buckets
+    uint64_t source = reinterpret_cast<uintptr_t>(key.sourceType);
+    uint64_t target = reinterpret_cast<uintptr_t>(key.targetType);
+    uint64_t hash = (source ^ (target * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+bool TypeMatchCache::get(const void *sourceType, const void *targetType, bool &isTargetType) {
+    Key key = {sourceType, targetType};
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<Key, bool, KeyHash>::const_iterator it = results_.find(key);
+    if (it == results_.end()) {
+        misses_++;
+        return false;
+    }
+    hits_++;
+    isTargetType = it->second;
+    return true;
+}
+
+void TypeMatchCache::set(const void *sourceType, const void *targetType, bool isTargetType) {
+    Key key = {sourceType, targetType};
+    std::lock_guard<std::mutex> lock(mutex_);
+    results_[key] = isTargetType;
+}
+
+ZIKTypeMatchCacheStatistics TypeMatchCache::statistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ZIKTypeMatchCacheStatistics statistics = {hits_, misses_, results_.size()};
+    return statistics;
+}
+
+void TypeMatchCache::removeAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    results_.clear();
+}
+
+ZIKTypeMatchCacheRef ZIKTypeMatchCacheCreate(void) {
+    return new ZIKTypeMatchCache();
+}
+
+void ZIKTypeMatchCacheDestroy(ZIKTypeMatchCacheRef cache) {
+    delete cache;
+}
+
+bool ZIKTypeMatchCacheGet(ZIKTypeMatchCacheRef cache, const void *sourceType, const void *targetType, bool *isTargetType) {
+    bool result;
+    if (cache == nullptr || !cache->cache.get(sourceType, targetType, result)) {
+        return false;
+    }
+    if (isTargetType) {
+        *isTargetType = result;
+    }
+    return true;
+}
+
+void ZIKTypeMatchCacheSet(ZIKTypeMatchCacheRef cache, const void *sourceType, const void *targetType, bool isTargetType) {
+    if (cache) {
+        cache->cache.set(sourceType, targetType, isTargetType);
+    }
+}
+
+void ZIKTypeMatchCacheRemoveAll(ZIKTypeMatchCacheRef cache) {
+    if (cache) {
+        cache->cache.removeAll();
+    }
+}
+
+ZIKTypeMatchCacheStatistics ZIKTypeMatchCacheGetStatistics(ZIKTypeMatchCacheRef cache) {
+    if (cache == nullptr) {
+        ZIKTypeMatchCacheStatistics statistics = {0, 0, 0};
+        return statistics;
+    }
+    return cache->cache.statistics();
+}
@@ -0,0 +1,110 @@
+//
+//  ZIKTypeMatchCache.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKTypeMatchCache_h
+#define ZIKTypeMatchCache_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Cache of (source type, target type) → whether source type is target type.
+typedef struct ZIKTypeMatchCache *ZIKTypeMatchCacheRef;
+
+typedef struct {
+    /// Lookups answered by the cache.
+    uint64_t hits;
+    /// Lookups of pairs not in the cache.
+    uint64_t misses;
+    /// Count of cached pairs.
+    size_t count;
+} ZIKTypeMatchCacheStatistics;
+
+extern ZIKTypeMatchCacheRef ZIKTypeMatchCacheCreate(void);
+
+extern void ZIKTypeMatchCacheDestroy(ZIKTypeMatchCacheRef cache);
+
+/**
+ Get the cached result of a pair of types. It's thread safe.
+
+ @param cache The cache.
+ @param sourceType Pointer identifying the source type, such as a class or type metadata.
+ @param targetType Pointer identifying the target type.
+ @param isTargetType The cached result. Not changed when the pair is not cached.
+ @return False when the pair is not cached.
+ */
+extern bool ZIKTypeMatchCacheGet(ZIKTypeMatchCacheRef cache, const void *sourceType, const void *targetType, bool *isTargetType);
+
+/// Cache the result of a pair of types. It's thread safe.
+extern void ZIKTypeMatchCacheSet(ZIKTypeMatchCacheRef cache, const void *sourceType, const void *targetType, bool isTargetType);
+
+/// Remove all cached pairs, when results may change, such as after loading an image with new protocol conformances.
+extern void ZIKTypeMatchCacheRemoveAll(ZIKTypeMatchCacheRef cache);
+
+extern ZIKTypeMatchCacheStatistics ZIKTypeMatchCacheGetStatistics(ZIKTypeMatchCacheRef cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <unordered_map>
+
+namespace zix {
+
+/**
+ Cache of results of type checking, keyed by the pair of type pointers. Types are never deallocated, so pointers are stable keys.
+
+ Results are computed by callers without the lock. When two threads check the same pair, both compute it and the same result is stored.
+ */
+class TypeMatchCache {
+public:
+    TypeMatchCache() : hits_(0), misses_(0) {}
+
+    bool get(const void *sourceType, const void *targetType, bool &isTargetType);
+
+    void set(const void *sourceType, const void *targetType, bool isTargetType);
+
+    ZIKTypeMatchCacheStatistics statistics();
+
+    void removeAll();
+
+private:
+    struct Key {
+        const void *sourceType;
+        const void *targetType;
+
+        bool operator==(const Key &other) const {
+            return sourceType == other.sourceType && targetType == other.targetType;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<Key, bool, KeyHash> results_;
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKTypeMatchCache_h */
@@ -0,0 +1,232 @@
+//
+//  ZIKAddressIndex.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKAddressIndex.h"
+#include <string.h>
+#include <algorithm>
+
+using namespace zix;
+using namespace zix::macho;
+
+void zix::readSegmentRanges(const MachOImage &image, std::vector<AddressRange> &ranges) {
+    ranges.clear();
+    image.enumerateSegments([&](const MachOSegment &segment) {
+        if (segment.vmsize == 0 || strcmp(segment.name, "__PAGEZERO") == 0 || strcmp(segment.name, "__LINKEDIT") == 0) {
+            return true;
+        }
+        if (segment.vmaddr + segment.vmsize < segment.vmaddr) {
+            return true;
+        }
+        AddressRange range = {segment.vmaddr, segment.vmaddr + segment.vmsize};
+        ranges.push_back(range);
+        return true;
+    });
+    std::sort(ranges.begin(), ranges.end(), [](const AddressRange &lhs, const AddressRange &rhs) {
+        return lhs.start < rhs.start;
+    });
+}
+
+/// The sorted range containing the address, or nullptr.
+static const AddressRange *rangeContainingAddress(const std::vector<AddressRange> &ranges, uint64_t address) {
+    std::vector<AddressRange>::const_iterator it = std::upper_bound(ranges.begin(), ranges.end(), address, [](uint64_t value, const AddressRange &range) {
+        return value < range.start;
+    });
+    if (it == ranges.begin()) {
+        return nullptr;
+    }
+    --it;
+    return address < it->end ? &*it : nullptr;
+}
+
+bool zix::rangesContainAddress(const std::vector<AddressRange> &ranges, uint64_t address) {
+    return rangeContainingAddress(ranges, address) != nullptr;
+}
+
+bool AddressIndex::build(const MachOImage &image) {
+    entries_.clear();
+    segments_.clear();
+    strings_ = nullptr;
+    MachOSymbolTable table;
+    if (!readSymbolTable(image, table)) {
+        return false;
+    }
+    slide_ = image.slide();
+    strings_ = table.strings;
+    readSegmentRanges(image, segments_);
+
+    struct Candidate {
+        uint64_t address;
+        uint32_t nameOffset;
+        uint32_t index;
+        bool external;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(table.count);
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        // Only symbols in sections have addresses. Debug symbols also have N_SECT bits
+        if (name == nullptr || name[0] == '\0' || (type & N_STAB) != 0 || (type & N_TYPE) != N_SECT) {
+            continue;
+        }
+        Candidate candidate = {value, static_cast<uint32_t>(name - table.strings), i, (type & N_EXT) != 0};
+        candidates.push_back(candidate);
+    }
+    // Keys are unique, so the order doesn't depend on the sort
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &lhs, const Candidate &rhs) {
+        if (lhs.address != rhs.address) {
+            return lhs.address < rhs.address;
+        }
+        if (lhs.external != rhs.external) {
+            return lhs.external;
+        }
+        return lhs.index < rhs.index;
+    });
+    entries_.reserve(candidates.size());
+    for (const Candidate &candidate : candidates) {
+        // Keep the first one of each address
+        if (!entries_.empty() && entries_.back().address == candidate.address) {
+            continue;
+        }
+        Entry entry = {candidate.address, candidate.nameOffset};
+        entries_.push_back(entry);
+    }
+    entries_.shrink_to_fit();
+    return true;
+}
+
+const AddressIndex::Entry *AddressIndex::find(uint64_t address) const {
+    const AddressRange *segment = rangeContainingAddress(segments_, address);
+    if (segment == nullptr) {
+        return nullptr;
+    }
+    std::vector<Entry>::const_iterator it = std::upper_bound(entries_.begin(), entries_.end(), address, [](uint64_t value, const Entry &entry) {
+        return value < entry.address;
+    });
+    if (it == entries_.begin()) {
+        return nullptr;
+    }
+    --it;
+    // A symbol in a previous segment is not the owner of the address, such as the last function for an address in __DATA
+    if (it->address < segment->start) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+const std::vector<AddressRange> &AddressIndexCache::segmentsOfLoadedImage(const void *header) {
+    std::unordered_map<const void *, std::vector<AddressRange>>::iterator it = segments_.find(header);
+    if (it != segments_.end()) {
+        return it->second;
+    }
+    // Only load commands are read, it's cheap enough to do with the lock
+    std::vector<AddressRange> &ranges = segments_[header];
+    MachOImage image;
+    if (image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded)) {
+        readSegmentRanges(image, ranges);
+        for (AddressRange &range : ranges) {
+            range.start += static_cast<uint64_t>(image.slide());
+            range.end += static_cast<uint64_t>(image.slide());
+        }
+    }
+    return ranges;
+}
+
+const void *AddressIndexCache::imageContainingAddress(const void *const *headers, size_t count, uint64_t address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < count; i++) {
+        if (headers[i] != nullptr && rangesContainAddress(segmentsOfLoadedImage(headers[i]), address)) {
+            return headers[i];
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const AddressIndex> AddressIndexCache::indexForLoadedImage(const void *header) {
+    if (header == nullptr) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_map<const void *, std::shared_ptr<const AddressIndex>>::iterator it = indexes_.find(header);
+        if (it != indexes_.end()) {
+            return it->second;
+        }
+    }
+    // Build without the lock, so lookups in other images are not blocked
+    std::shared_ptr<AddressIndex> index;
+    MachOImage image;
+    if (image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded)) {
+        index = std::make_shared<AddressIndex>();
+        if (!index->build(image)) {
+            index = nullptr;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread may have built it at the same time
+    return indexes_.insert(std::make_pair(header, std::shared_ptr<const AddressIndex>(index))).first->second;
+}
+
+void AddressIndexCache::removeImage(const void *header) {
+    // Destroyed after unlocking
+    std::shared_ptr<const AddressIndex> index;
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_.erase(header);
+    std::unordered_map<const void *, std::shared_ptr<const AddressIndex>>::iterator it = indexes_.find(header);
+    if (it != indexes_.end()) {
+        index = it->second;
+        indexes_.erase(it);
+    }
+}
+
+size_t AddressIndexCache::imageCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return indexes_.size();
+}
+
+AddressIndexCache &AddressIndexCache::shared() {
+    // Never destroyed, so lookups in other threads during exit are safe
+    static AddressIndexCache *cache = new AddressIndexCache();
+    return *cache;
+}
+
+const void *ZIKAddressIndexImageContainingAddress(const void *const *headers, size_t count, uintptr_t address) {
+    if (headers == nullptr) {
+        return nullptr;
+    }
+    return AddressIndexCache::shared().imageContainingAddress(headers, count, address);
+}
+
+ZIKSymbolIndexStatus ZIKAddressIndexFindInLoadedImage(const void *header, uintptr_t address, ZIKAddressIndexSymbol *symbol) {
+    if (header == nullptr) {
+        return ZIKSymbolIndexStatusNotFound;
+    }
+    std::shared_ptr<const AddressIndex> index = AddressIndexCache::shared().indexForLoadedImage(header);
+    if (index == nullptr) {
+        return ZIKSymbolIndexStatusUnavailable;
+    }
+    const AddressIndex::Entry *entry = index->find(static_cast<uint64_t>(address) - static_cast<uint64_t>(index->slide()));
+    if (entry == nullptr) {
+        return ZIKSymbolIndexStatusNotFound;
+    }
+    if (symbol) {
+        symbol->name = index->name(*entry);
+        symbol->address = static_cast<uintptr_t>(entry->address + index->slide());
+    }
+    return ZIKSymbolIndexStatusFound;
+}
+
+void ZIKAddressIndexRemoveLoadedImage(const void *header) {
+    AddressIndexCache::shared().removeImage(header);
+}
@@ -0,0 +1,150 @@
+//
+//  ZIKAddressIndex.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKAddressIndex_h
+#define ZIKAddressIndex_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ZIKSymbolIndex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    /// Name in LC_SYMTAB, with the leading `_` of C names. It points into the string table of the image.
+    const char *name;
+    /// Address of the symbol with slide of the image.
+    uintptr_t address;
+} ZIKAddressIndexSymbol;
+
+/**
+ Find the loaded image containing an address. Segments of each image are read once and cached, so it doesn't parse all images again for each address.
+
+ @param headers Headers of loaded images, such as `_dyld_get_image_header()`.
+ @param count Count of headers.
+ @param address The address with slide.
+ @return Header of the image, NULL when the address is not in any segment of the images. __LINKEDIT is not counted.
+ */
+extern const void *ZIKAddressIndexImageContainingAddress(const void *const *headers, size_t count, uintptr_t address);
+
+/**
+ Find the nearest symbol at or before an address in LC_SYMTAB of an image mapped by dyld, including local symbols. `dladdr` only sees exported symbols and scans them for each address, while here all defined symbols of the image are sorted by address on first use, then each address is a binary search.
+
+ @param header Header of the loaded image containing the address.
+ @param address The address with slide.
+ @param symbol The found symbol. Can be NULL.
+ @return Not found when the address is out of the image or before all symbols. Unavailable when the image doesn't have a readable symbol table.
+ */
+extern ZIKSymbolIndexStatus ZIKAddressIndexFindInLoadedImage(const void *header, uintptr_t address, ZIKAddressIndexSymbol *symbol);
+
+/// Remove the index and segments of an image. Call it when the image is unloaded, because the index refers to its string table, and another image may be loaded at the same address.
+extern void ZIKAddressIndexRemoveLoadedImage(const void *header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+
+/// A range of vm addresses, [start, end).
+struct AddressRange {
+    uint64_t start;
+    uint64_t end;
+};
+
+/// Ranges of segments with code or data, sorted by address. Values are without slide. __PAGEZERO, __LINKEDIT and empty segments are skipped.
+void readSegmentRanges(const MachOImage &image, std::vector<AddressRange> &ranges);
+
+/// Whether the address is in any of the sorted ranges.
+bool rangesContainAddress(const std::vector<AddressRange> &ranges, uint64_t address);
+
+/**
+ Reverse index of address → symbol of an image. It's an array of (address, name offset) sorted by address, with all defined symbols in sections, including local symbols. Debug symbols, absolute and undefined symbols are skipped.
+
+ When several symbols have the same address, such as aliases, an external symbol is preferred over a local one, then the first one in the symbol table. Names are not copied, so the index is only valid while the image is mapped.
+ */
+class AddressIndex {
+public:
+    struct Entry {
+        /// n_value without slide.
+        uint64_t address;
+        /// n_strx of the symbol.
+        uint32_t nameOffset;
+    };
+
+    AddressIndex() : strings_(nullptr), slide_(0) {}
+
+    /// Sort all defined symbols of the image by address. Return false when the image doesn't have a readable symbol table.
+    bool build(const MachOImage &image);
+
+    /// Find the nearest symbol at or before the address (without slide). Return nullptr when the address is out of segments of the image or before all symbols.
+    const Entry *find(uint64_t address) const;
+
+    /// Name of an entry in the string table.
+    const char *name(const Entry &entry) const { return strings_ + entry.nameOffset; }
+
+    size_t count() const { return entries_.size(); }
+    const std::vector<Entry> &entries() const { return entries_; }
+
+    /// Slide of the indexed image. It's 0 for file layout.
+    intptr_t slide() const { return slide_; }
+
+private:
+    std::vector<Entry> entries_;
+    std::vector<AddressRange> segments_;
+    const char *strings_;
+    intptr_t slide_;
+};
+
+/**
+ Reverse indexes of loaded images by header. Segments of an image are read when it's first checked for an address, and its index is built on first lookup in it. Both must be removed when the image is unloaded.
+ */
+class AddressIndexCache {
+public:
+    /// Find the image containing the address (with slide) among headers. Return nullptr when not found.
+    const void *imageContainingAddress(const void *const *headers, size_t count, uint64_t address);
+
+    /// Get index of a loaded image, building it if needed. Return nullptr when the image doesn't have a readable symbol table.
+    std::shared_ptr<const AddressIndex> indexForLoadedImage(const void *header);
+
+    void removeImage(const void *header);
+
+    size_t imageCount();
+
+    /// Cache used by the C functions.
+    static AddressIndexCache &shared();
+
+private:
+    /// Segments with slide.
+    const std::vector<AddressRange> &segmentsOfLoadedImage(const void *header);
+
+    std::mutex mutex_;
+    std::unordered_map<const void *, std::vector<AddressRange>> segments_;
+    /// nullptr for images without symbol table, so they're not parsed again.
+    std::unordered_map<const void *, std::shared_ptr<const AddressIndex>> indexes_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKAddressIndex_h */
@@ -0,0 +1,338 @@
+//
+//  ZIKClassListScanner.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKClassListScanner.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace zix;
+
+bool zix::findClassList(const MachOImage &image, ClassList &classList) {
+    classList.classes = nullptr;
+    classList.count = 0;
+    // Class pointers in the list are only valid in current process.
+    if (!image.isValid() || image.layout() != MachOImage::LayoutLoaded || image.is64Bit() != (sizeof(void *) == 8)) {
+        return false;
+    }
+    static const char *const segments[] = {"__DATA", "__DATA_CONST", "__DATA_DIRTY"};
+    for (size_t i = 0; i < sizeof(segments) / sizeof(segments[0]); i++) {
+        MachOSection section;
+        if (!image.findSection(segments[i], "__objc_classlist", section)) {
+            continue;
+        }
+        const void *content = image.contentOfSection(section);
+        if (content == nullptr) {
+            return false;
+        }
+        classList.classes = static_cast<const uintptr_t *>(content);
+        classList.count = static_cast<size_t>(section.size / sizeof(uintptr_t));
+        return true;
+    }
+    return false;
+}
+
+bool zix::classIsSubclassOfClass(uintptr_t cls, uintptr_t parentClass) {
+    if (cls == 0 || parentClass == 0) {
+        return false;
+    }
+    // Layout of objc class: isa, superclass, ...
+    uintptr_t superclass = reinterpret_cast<const uintptr_t *>(cls)[1];
+    while (superclass) {
+        if (superclass == parentClass) {
+            return true;
+        }
+        superclass = reinterpret_cast<const uintptr_t *>(superclass)[1];
+    }
+    return false;
+}
+
+namespace {
+
+/// Max count of probing in memo table before giving up.
+const size_t MaxMemoProbes = 32;
+
+/// Max count of recorded classes in a superclass chain.
+const size_t MaxMemoPathLength = 64;
+
+size_t memoIndex(uintptr_t cls) {
+    // Classes are aligned, so low bits are useless.
+    uint64_t hash = static_cast<uint64_t>(cls >> 3) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+} // namespace
+
+SubclassMemo::SubclassMemo(uintptr_t parentClass, size_t capacity, ZIKSuperclassFunction superclassFunction)
+: parentClass_(parentClass), superclassFunction_(superclassFunction) {
+    // Keep load factor under 0.5, with ancestors outside of the checked classes.
+    size_t tableSize = 64;
+    while (tableSize < capacity * 2 && tableSize < (SIZE_MAX >> 2)) {
+        tableSize <<= 1;
+    }
+    mask_ = tableSize - 1;
+    entries_.reset(new std::atomic<uintptr_t>[tableSize]());
+}
+
+uintptr_t SubclassMemo::superclassOf(uintptr_t cls) const {
+    if (superclassFunction_) {
+        return reinterpret_cast<uintptr_t>(superclassFunction_(reinterpret_cast<const void *>(cls)));
+    }
+    // Layout of objc class: isa, superclass, ...
+    return reinterpret_cast<const uintptr_t *>(cls)[1];
+}
+
+SubclassMemo::Verdict SubclassMemo::lookup(uintptr_t cls) const {
+    size_t index = memoIndex(cls);
+    for (size_t i = 0; i < MaxMemoProbes; i++) {
+        uintptr_t entry = entries_[(index + i) & mask_].load(std::memory_order_relaxed);
+        if (entry == 0) {
+            return Unknown;
+        }
+        if ((entry & ~VerdictMask) == cls) {
+            return static_cast<Verdict>(entry & VerdictMask);
+        }
+    }
+    return Unknown;
+}
+
+void SubclassMemo::record(uintptr_t cls, Verdict verdict) {
+    size_t index = memoIndex(cls);
+    for (size_t i = 0; i < MaxMemoProbes; i++) {
+        std::atomic<uintptr_t> &slot = entries_[(index + i) & mask_];
+        uintptr_t entry = slot.load(std::memory_order_relaxed);
+        if (entry == 0) {
+            // Class and verdict are written in one word, so another thread either reads the whole entry or nothing. If another thread overwrites the slot, this class is just not recorded.
+            slot.store(cls | verdict, std::memory_order_relaxed);
+            return;
+        }
+        if ((entry & ~VerdictMask) == cls) {
+            return;
+        }
+    }
+}
+
+bool SubclassMemo::isSubclass(uintptr_t cls) {
+    if (cls == 0 || parentClass_ == 0 || cls == parentClass_) {
+        return false;
+    }
+    uintptr_t path[MaxMemoPathLength];
+    size_t pathLength = 0;
+    // Most checked classes are leaves, so only ancestors are recorded. A class is recorded when it's found as an ancestor of another class.
+    uintptr_t current = superclassOf(cls);
+    Verdict verdict;
+    while (true) {
+        if (current == 0) {
+            verdict = NotInherited;
+            break;
+        }
+        if (current == parentClass_) {
+            verdict = Inherited;
+            break;
+        }
+        Verdict recorded = lookup(current);
+        if (recorded != Unknown) {
+            verdict = recorded;
+            break;
+        }
+        if (pathLength < MaxMemoPathLength && (current & VerdictMask) == 0) {
+            path[pathLength++] = current;
+        }
+        current = superclassOf(current);
+    }
+    // Every class below the stopping point has the same verdict
+    for (size_t i = 0; i < pathLength; i++) {
+        record(path[i], verdict);
+    }
+    return verdict == Inherited;
+}
+
+ClassListScanner::ClassListScanner(uintptr_t parentClass, size_t chunkSize)
+: parentClass_(parentClass), chunkSize_(chunkSize > 0 ? chunkSize : DefaultChunkSize), classCount_(0), memo_(nullptr) {
+}
+
+size_t ClassListScanner::addClassList(const ClassList &classList) {
+    size_t list = resultCounts_.size();
+    resultCounts_.push_back(0);
+    classCount_ += classList.count;
+    for (size_t start = 0; start < classList.count; start += chunkSize_) {
+        Chunk chunk;
+        chunk.list = list;
+        chunk.classes = classList.classes + start;
+        chunk.count = classList.count - start < chunkSize_ ? classList.count - start : chunkSize_;
+        chunks_.push_back(chunk);
+    }
+    return list;
+}
+
+void ClassListScanner::scanChunk(void *context, size_t index) {
+    ClassListScanner *scanner = static_cast<ClassListScanner *>(context);
+    Chunk &chunk = scanner->chunks_[index];
+    chunk.results.clear();
+    for (size_t i = 0; i < chunk.count; i++) {
+        uintptr_t cls = chunk.classes[i];
+        if (scanner->memo_->isSubclass(cls)) {
+            chunk.results.push_back(cls);
+        }
+    }
+}
+
+void ClassListScanner::scan(ZIKApplyFunction apply) {
+    SubclassMemo memo(parentClass_, classCount_);
+    memo_ = &memo;
+    // Dispatching a single chunk costs more than scanning it.
+    if (apply != nullptr && chunks_.size() > 1) {
+        apply(chunks_.size(), this, scanChunk);
+    } else {
+        for (size_t i = 0; i < chunks_.size(); i++) {
+            scanChunk(this, i);
+        }
+    }
+    memo_ = nullptr;
+    results_.clear();
+    resultCounts_.assign(resultCounts_.size(), 0);
+    for (size_t i = 0; i < chunks_.size(); i++) {
+        resultCounts_[chunks_[i].list] += chunks_[i].results.size();
+        results_.insert(results_.end(), chunks_[i].results.begin(), chunks_[i].results.end());
+    }
+}
+
+const void **ZIKClassListCopySubclasses(const void *const *headers, size_t imageCount, const void *parentClass, ZIKApplyFunction apply, size_t *imageClassCounts, size_t *count) {
+    ClassListScanner scanner(reinterpret_cast<uintptr_t>(parentClass));
+    std::vector<size_t> imageLists(imageCount, SIZE_MAX);
+    for (size_t i = 0; i < imageCount; i++) {
+        MachOImage image;
+        if (!image.parse(headers[i], SIZE_MAX, MachOImage::LayoutLoaded)) {
+            continue;
+        }
+        ClassList classList;
+        if (findClassList(image, classList)) {
+            imageLists[i] = scanner.addClassList(classList);
+        }
+    }
+    scanner.scan(apply);
+    if (imageClassCounts) {
+        for (size_t i = 0; i < imageCount; i++) {
+            imageClassCounts[i] = imageLists[i] == SIZE_MAX ? 0 : scanner.resultCounts()[imageLists[i]];
+        }
+    }
+    const std::vector<uintptr_t> &results = scanner.results();
+    if (count) {
+        *count = results.size();
+    }
+    const void **classes = static_cast<const void **>(malloc(results.size() > 0 ? results.size() * sizeof(void *) : 1));
+    if (classes == nullptr) {
+        if (count) {
+            *count = 0;
+        }
+        return nullptr;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        classes[i] = reinterpret_cast<const void *>(results[i]);
+    }
+    return classes;
+}
+
+LoadedImageScanner::LoadedImageScanner(uintptr_t parentClass, size_t memoCapacity)
+: memo_(parentClass, memoCapacity) {
+}
+
+bool LoadedImageScanner::markScanned(const void *header) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scannedImages_.insert(header).second;
+}
+
+bool LoadedImageScanner::isScanned(const void *header) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scannedImages_.count(header) > 0;
+}
+
+bool LoadedImageScanner::scanImage(const void *header, std::vector<uintptr_t> &classes) {
+    if (header == nullptr || !markScanned(header)) {
+        return false;
+    }
+    MachOImage image;
+    ClassList classList;
+    if (!image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded) || !findClassList(image, classList)) {
+        return true;
+    }
+    // A single image is small, so it's scanned serially in the thread loading it.
+    for (size_t i = 0; i < classList.count; i++) {
+        if (memo_.isSubclass(classList.classes[i])) {
+            classes.push_back(classList.classes[i]);
+        }
+    }
+    return true;
+}
+
+struct ZIKSubclassMemo {
+    SubclassMemo memo;
+
+    ZIKSubclassMemo(const void *parentClass, size_t capacity, ZIKSuperclassFunction getSuperclass)
+    : memo(reinterpret_cast<uintptr_t>(parentClass), capacity, getSuperclass) {}
+};
+
+ZIKSubclassMemoRef ZIKSubclassMemoCreate(const void *parentClass, size_t capacity, ZIKSuperclassFunction getSuperclass) {
+    return new ZIKSubclassMemo(parentClass, capacity, getSuperclass);
+}
+
+bool ZIKSubclassMemoIsSubclass(ZIKSubclassMemoRef memo, const void *cls) {
+    if (memo == nullptr) {
+        return false;
+    }
+    return memo->memo.isSubclass(reinterpret_cast<uintptr_t>(cls));
+}
+
+void ZIKSubclassMemoDestroy(ZIKSubclassMemoRef memo) {
+    delete memo;
+}
+
+struct ZIKLoadedImageScanner {
+    LoadedImageScanner scanner;
+
+    explicit ZIKLoadedImageScanner(const void *parentClass)
+    : scanner(reinterpret_cast<uintptr_t>(parentClass)) {}
+};
+
+ZIKLoadedImageScannerRef ZIKLoadedImageScannerCreate(const void *parentClass) {
+    return new ZIKLoadedImageScanner(parentClass);
+}
+
+bool ZIKLoadedImageScannerMarkScanned(ZIKLoadedImageScannerRef scanner, const void *header) {
+    if (scanner == nullptr) {
+        return false;
+    }
+    return scanner->scanner.markScanned(header);
+}
+
+const void **ZIKLoadedImageScannerCopySubclasses(ZIKLoadedImageScannerRef scanner, const void *header, size_t *count) {
+    if (count) {
+        *count = 0;
+    }
+    std::vector<uintptr_t> results;
+    if (scanner == nullptr || !scanner->scanner.scanImage(header, results)) {
+        return nullptr;
+    }
+    const void **classes = static_cast<const void **>(malloc(results.size() > 0 ? results.size() * sizeof(void *) : 1));
+    if (classes == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        classes[i] = reinterpret_cast<const void *>(results[i]);
+    }
+    if (count) {
+        *count = results.size();
+    }
+    return classes;
+}
+
+void ZIKLoadedImageScannerDestroy(ZIKLoadedImageScannerRef scanner) {
+    delete scanner;
+}
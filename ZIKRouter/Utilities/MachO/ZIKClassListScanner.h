@@ -0,0 +1,236 @@
+//
+//  ZIKClassListScanner.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKClassListScanner_h
+#define ZIKClassListScanner_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Run `work` for each index in [0, iterations), maybe concurrently, and return after all work is done. Such as a wrapper of `dispatch_apply_f`.
+typedef void (*ZIKApplyFunction)(size_t iterations, void *context, void (*work)(void *context, size_t index));
+
+/**
+ Find subclasses of the parent class in `__objc_classlist` of loaded images. The class lists are split into chunks and scanned with `apply`.
+
+ @param headers Headers of images mapped by dyld.
+ @param imageCount Count of images.
+ @param parentClass The parent class.
+ @param apply Function to run chunks. Pass NULL to scan serially.
+ @param imageClassCounts Count of found classes in each image. Pass NULL if not needed, or an array with imageCount items.
+ @param count Count of found classes.
+ @return Found classes in the order of images, then in the order of class list. Caller should free it.
+ */
+extern const void **ZIKClassListCopySubclasses(const void *const *headers, size_t imageCount, const void *parentClass, ZIKApplyFunction apply, size_t *imageClassCounts, size_t *count);
+
+/// Memo of subclass checking for a parent class.
+typedef struct ZIKSubclassMemo *ZIKSubclassMemoRef;
+
+/// Get superclass of a class, such as `class_getSuperclass`.
+typedef const void *(*ZIKSuperclassFunction)(const void *cls);
+
+/**
+ Create a memo for checking subclasses of the parent class. Sibling classes share most of their ancestors, so the verdict of each visited class is recorded, and every ancestor is resolved at most once. It's thread safe.
+
+ @param parentClass The parent class.
+ @param capacity Expected count of classes to check. Classes beyond the capacity are still checked correctly, but may not be recorded.
+ @param getSuperclass Function to get superclass. Pass NULL to read superclass pointer from objc class directly, then classes may be unrealized.
+ */
+extern ZIKSubclassMemoRef ZIKSubclassMemoCreate(const void *parentClass, size_t capacity, ZIKSuperclassFunction getSuperclass);
+
+/// Check whether a class is a subclass of the parent class of the memo.
+extern bool ZIKSubclassMemoIsSubclass(ZIKSubclassMemoRef memo, const void *cls);
+
+extern void ZIKSubclassMemoDestroy(ZIKSubclassMemoRef memo);
+
+/// Scanner for images loaded after launch.
+typedef struct ZIKLoadedImageScanner *ZIKLoadedImageScannerRef;
+
+/**
+ Create a scanner finding subclasses of the parent class in images one by one, such as images reported by `_dyld_register_func_for_add_image`. Each image is only scanned once, and verdicts of ancestors are kept between images. It's thread safe.
+
+ @param parentClass The parent class.
+ */
+extern ZIKLoadedImageScannerRef ZIKLoadedImageScannerCreate(const void *parentClass);
+
+/// Mark an image as scanned, when its classes are already found in other ways. Return false if it's already scanned.
+extern bool ZIKLoadedImageScannerMarkScanned(ZIKLoadedImageScannerRef scanner, const void *header);
+
+/**
+ Find subclasses of the parent class in `__objc_classlist` of an image mapped by dyld.
+
+ @param scanner The scanner.
+ @param header Header of the image.
+ @param count Count of found classes.
+ @return Found classes in the order of class list, or NULL when the image is already scanned. Caller should free it.
+ */
+extern const void **ZIKLoadedImageScannerCopySubclasses(ZIKLoadedImageScannerRef scanner, const void *header, size_t *count);
+
+extern void ZIKLoadedImageScannerDestroy(ZIKLoadedImageScannerRef scanner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+
+/// `__objc_classlist` of an image. Each item is a pointer to objc class.
+struct ClassList {
+    const uintptr_t *classes;
+    size_t count;
+};
+
+/// Find `__objc_classlist` in __DATA, __DATA_CONST or __DATA_DIRTY of a loaded image.
+bool findClassList(const MachOImage &image, ClassList &classList);
+
+/// Check whether a class is a subclass of the parent class by walking superclass pointers. The class must be in memory.
+bool classIsSubclassOfClass(uintptr_t cls, uintptr_t parentClass);
+
+/**
+ Memo of subclass checking for a parent class. The verdict of every class on the walked superclass chain is recorded, so sibling classes stop walking at their first checked ancestor.
+
+ Verdicts are stored in low bits of class pointers in a lock free open addressing table with fixed capacity, so it can be shared by concurrent scanning. When the table is full or racing threads write the same slot, some classes are not recorded, and they're just checked again by walking.
+ */
+class SubclassMemo {
+public:
+    /**
+     @param parentClass The parent class.
+     @param capacity Expected count of classes to check.
+     @param superclassFunction Function to get superclass. Pass nullptr to read superclass pointer from objc class directly.
+     */
+    SubclassMemo(uintptr_t parentClass, size_t capacity, ZIKSuperclassFunction superclassFunction = nullptr);
+
+    /// Same result as `classIsSubclassOfClass`.
+    bool isSubclass(uintptr_t cls);
+
+    uintptr_t parentClass() const { return parentClass_; }
+
+private:
+    /// Objc classes are aligned to pointer size, so low 2 bits of class pointers are used for verdict.
+    enum Verdict : uintptr_t {
+        Unknown = 0,
+        NotInherited = 1,
+        Inherited = 2,
+        VerdictMask = 3,
+    };
+
+    SubclassMemo(const SubclassMemo &) = delete;
+    SubclassMemo &operator=(const SubclassMemo &) = delete;
+
+    uintptr_t superclassOf(uintptr_t cls) const;
+    Verdict lookup(uintptr_t cls) const;
+    void record(uintptr_t cls, Verdict verdict);
+
+    uintptr_t parentClass_;
+    ZIKSuperclassFunction superclassFunction_;
+    size_t mask_;
+    std::unique_ptr<std::atomic<uintptr_t>[]> entries_;
+};
+
+/**
+ Scan class lists of many images for subclasses of a parent class.
+
+ Class lists are split into chunks, and each chunk collects its own results, so chunks can be scanned concurrently without locks. Results are concatenated in the order of chunks, so the result is the same as serial scanning. Chunks share a SubclassMemo, so common ancestors are resolved once in a scan.
+ */
+class ClassListScanner {
+public:
+    /// Default max count of classes in a chunk.
+    static const size_t DefaultChunkSize = 1024;
+
+    explicit ClassListScanner(uintptr_t parentClass, size_t chunkSize = DefaultChunkSize);
+
+    /// Add a class list. Class lists are scanned in the order of adding. Return index of the class list.
+    size_t addClassList(const ClassList &classList);
+
+    /// Scan all chunks with the apply function, or serially when apply is NULL.
+    void scan(ZIKApplyFunction apply);
+
+    size_t chunkCount() const { return chunks_.size(); }
+
+    /// Found classes after scanning.
+    const std::vector<uintptr_t> &results() const { return results_; }
+
+    /// Count of found classes in each class list after scanning.
+    const std::vector<size_t> &resultCounts() const { return resultCounts_; }
+
+private:
+    struct Chunk {
+        size_t list;
+        const uintptr_t *classes;
+        size_t count;
+        std::vector<uintptr_t> results;
+    };
+
+    static void scanChunk(void *context, size_t index);
+
+    uintptr_t parentClass_;
+    size_t chunkSize_;
+    size_t classCount_;
+    SubclassMemo *memo_;
+    std::vector<Chunk> chunks_;
+    std::vector<uintptr_t> results_;
+    std::vector<size_t> resultCounts_;
+};
+
+/**
+ Scan images loaded after launch one by one, without scanning other images again.
+
+ dyld reports all loaded images when registering an add image callback, so images already scanned at launch should be marked first. Found classes of an image are only returned once. The memo is shared by all images, so ancestors in images loaded before are not walked again.
+ */
+class LoadedImageScanner {
+public:
+    /// Default capacity of the memo.
+    static const size_t DefaultMemoCapacity = 4096;
+
+    explicit LoadedImageScanner(uintptr_t parentClass, size_t memoCapacity = DefaultMemoCapacity);
+
+    /// Mark an image as scanned. Return false if it's already scanned.
+    bool markScanned(const void *header);
+
+    /**
+     Scan the image if it's not scanned yet.
+
+     @param header Header of an image mapped by dyld.
+     @param classes Found classes are appended to it.
+     @return False if the image is already scanned.
+     */
+    bool scanImage(const void *header, std::vector<uintptr_t> &classes);
+
+    bool isScanned(const void *header) const;
+
+private:
+    LoadedImageScanner(const LoadedImageScanner &) = delete;
+    LoadedImageScanner &operator=(const LoadedImageScanner &) = delete;
+
+    SubclassMemo memo_;
+    mutable std::mutex mutex_;
+    std::set<const void *> scannedImages_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKClassListScanner_h */
@@ -0,0 +1,235 @@
+//
+//  ZIKExportTrie.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKExportTrie.h"
+#include <string.h>
+
+using namespace zix;
+using namespace zix::macho;
+
+bool ExportTrie::readULEB128(const uint8_t *&cursor, const uint8_t *end, uint64_t &value) {
+    uint64_t result = 0;
+    unsigned shift = 0;
+    const uint8_t *p = cursor;
+    while (true) {
+        if (p >= end) {
+            return false;
+        }
+        uint8_t byte = *p++;
+        uint64_t bits = byte & 0x7f;
+        if (shift >= 64 && bits != 0) {
+            return false;
+        }
+        if (shift == 63 && bits > 1) {
+            return false;
+        }
+        if (shift < 64) {
+            result |= bits << shift;
+        }
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    cursor = p;
+    value = result;
+    return true;
+}
+
+bool ExportTrie::parse(const MachOImage &image) {
+    bytes_ = nullptr;
+    size_ = 0;
+    uint64_t offset;
+    uint64_t size;
+    const linkedit_data_command *exportsTrie = reinterpret_cast<const linkedit_data_command *>(image.findLoadCommand(LC_DYLD_EXPORTS_TRIE, sizeof(linkedit_data_command)));
+    if (exportsTrie != nullptr) {
+        offset = exportsTrie->dataoff;
+        size = exportsTrie->datasize;
+    } else {
+        const dyld_info_command *dyldInfo = reinterpret_cast<const dyld_info_command *>(image.findLoadCommand(LC_DYLD_INFO_ONLY, sizeof(dyld_info_command)));
+        if (dyldInfo == nullptr) {
+            dyldInfo = reinterpret_cast<const dyld_info_command *>(image.findLoadCommand(LC_DYLD_INFO, sizeof(dyld_info_command)));
+        }
+        if (dyldInfo == nullptr) {
+            return false;
+        }
+        offset = dyldInfo->export_off;
+        size = dyldInfo->export_size;
+    }
+    if (size == 0) {
+        return false;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(image.contentAtFileOffset(offset, size));
+    if (bytes == nullptr) {
+        return false;
+    }
+    bytes_ = bytes;
+    size_ = static_cast<size_t>(size);
+    return true;
+}
+
+static bool readTerminal(const uint8_t *cursor, const uint8_t *end, MachOExport &result) {
+    uint64_t flags;
+    if (!ExportTrie::readULEB128(cursor, end, flags)) {
+        return false;
+    }
+    result.flags = flags;
+    result.address = 0;
+    result.resolver = 0;
+    result.reexportOrdinal = 0;
+    result.reexportName = "";
+    if (flags & EXPORT_SYMBOL_FLAGS_REEXPORT) {
+        uint64_t ordinal;
+        if (!ExportTrie::readULEB128(cursor, end, ordinal) || ordinal > INT32_MAX) {
+            return false;
+        }
+        const void *terminator = cursor < end ? memchr(cursor, '\0', static_cast<size_t>(end - cursor)) : nullptr;
+        if (terminator == nullptr) {
+            return false;
+        }
+        result.reexportOrdinal = static_cast<int32_t>(ordinal);
+        result.reexportName = reinterpret_cast<const char *>(cursor);
+        return true;
+    }
+    if (!ExportTrie::readULEB128(cursor, end, result.address)) {
+        return false;
+    }
+    if ((flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) && !ExportTrie::readULEB128(cursor, end, result.resolver)) {
+        return false;
+    }
+    return true;
+}
+
+bool ExportTrie::find(const char *name, MachOExport &result) const {
+    if (!isValid() || name == nullptr) {
+        return false;
+    }
+    const uint8_t *end = bytes_ + size_;
+    const uint8_t *node = bytes_;
+    const char *remaining = name;
+    // Each step consumes at least one character, because empty edges are rejected, so walking never loops
+    while (true) {
+        const uint8_t *cursor = node;
+        uint64_t terminalSize;
+        if (!readULEB128(cursor, end, terminalSize) || terminalSize > static_cast<uint64_t>(end - cursor)) {
+            return false;
+        }
+        if (*remaining == '\0' && terminalSize != 0) {
+            return readTerminal(cursor, cursor + terminalSize, result);
+        }
+        cursor += terminalSize;
+        if (cursor >= end) {
+            return false;
+        }
+        uint8_t childCount = *cursor++;
+        uint64_t childOffset = 0;
+        for (uint8_t i = 0; i < childCount; i++) {
+            const char *matched = remaining;
+            bool mismatched = false;
+            const uint8_t *edge = cursor;
+            while (cursor < end && *cursor != '\0') {
+                if (!mismatched) {
+                    if (static_cast<char>(*cursor) == *matched) {
+                        matched++;
+                    } else {
+                        mismatched = true;
+                    }
+                }
+                cursor++;
+            }
+            if (cursor >= end || cursor == edge) {
+                return false;
+            }
+            cursor++;
+            uint64_t offset;
+            if (!readULEB128(cursor, end, offset)) {
+                return false;
+            }
+            if (!mismatched) {
+                childOffset = offset;
+                remaining = matched;
+                break;
+            }
+        }
+        if (childOffset == 0) {
+            return false;
+        }
+        if (childOffset >= size_) {
+            return false;
+        }
+        node = bytes_ + childOffset;
+    }
+}
+
+const char *zix::dependentDylibName(const MachOImage &image, int32_t ordinal) {
+    if (ordinal <= 0) {
+        return nullptr;
+    }
+    const char *name = nullptr;
+    int32_t index = 0;
+    image.enumerateLoadCommands([&](const load_command *lc) {
+        if (lc->cmd != LC_LOAD_DYLIB && lc->cmd != LC_LOAD_WEAK_DYLIB && lc->cmd != LC_REEXPORT_DYLIB && lc->cmd != LC_LOAD_UPWARD_DYLIB && lc->cmd != LC_LAZY_LOAD_DYLIB) {
+            return true;
+        }
+        if (++index != ordinal) {
+            return true;
+        }
+        const dylib_command *command = reinterpret_cast<const dylib_command *>(lc);
+        if (lc->cmdsize < sizeof(dylib_command) || command->name_offset < sizeof(dylib_command) || command->name_offset >= command->cmdsize) {
+            return false;
+        }
+        const char *dylibName = reinterpret_cast<const char *>(command) + command->name_offset;
+        // The name must be terminated inside the load command.
+        if (memchr(dylibName, '\0', command->cmdsize - command->name_offset) != nullptr) {
+            name = dylibName;
+        }
+        return false;
+    });
+    return name;
+}
+
+ZIKExportTrieStatus ZIKExportTrieFindInLoadedImage(const void *header, const char *name, ZIKExportTrieEntry *entry) {
+    if (header == nullptr || name == nullptr) {
+        return ZIKExportTrieStatusNotFound;
+    }
+    MachOImage image;
+    ExportTrie trie;
+    if (!image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded) || !trie.parse(image)) {
+        return ZIKExportTrieStatusUnavailable;
+    }
+    MachOExport exported;
+    if (!trie.find(name, exported)) {
+        return ZIKExportTrieStatusNotFound;
+    }
+    ZIKExportTrieStatus status = ZIKExportTrieStatusFound;
+    uintptr_t address = 0;
+    const char *reexportDylib = nullptr;
+    const char *reexportName = nullptr;
+    if (exported.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) {
+        reexportDylib = dependentDylibName(image, exported.reexportOrdinal);
+        if (reexportDylib == nullptr) {
+            return ZIKExportTrieStatusNotFound;
+        }
+        reexportName = exported.reexportName[0] != '\0' ? exported.reexportName : name;
+        status = ZIKExportTrieStatusReexport;
+    } else if ((exported.flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE) {
+        address = static_cast<uintptr_t>(exported.address);
+    } else {
+        address = reinterpret_cast<uintptr_t>(header) + static_cast<uintptr_t>(exported.address);
+    }
+    if (entry) {
+        entry->address = address;
+        entry->flags = exported.flags;
+        entry->reexportDylib = reexportDylib;
+        entry->reexportName = reexportName;
+    }
+    return status;
+}
@@ -0,0 +1,129 @@
+//
+//  ZIKExportTrie.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKExportTrie_h
+#define ZIKExportTrie_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    /// The name is not exported. It may still be a local symbol in LC_SYMTAB.
+    ZIKExportTrieStatusNotFound = 0,
+    ZIKExportTrieStatusFound,
+    /// The name is re-exported from another dylib. Find `reexportName` in `reexportDylib`.
+    ZIKExportTrieStatusReexport,
+    /// The image doesn't have an export trie.
+    ZIKExportTrieStatusUnavailable,
+} ZIKExportTrieStatus;
+
+typedef struct {
+    /// Address with slide of the image. For absolute symbols, it's the value.
+    uintptr_t address;
+    /// EXPORT_SYMBOL_FLAGS_*.
+    uint64_t flags;
+    /// Install name of the dylib for re-export.
+    const char *reexportDylib;
+    /// Name in the re-exported dylib. It's the searched name when the symbol is not renamed.
+    const char *reexportName;
+} ZIKExportTrieEntry;
+
+/**
+ Find an exported symbol in the export trie (LC_DYLD_EXPORTS_TRIE or LC_DYLD_INFO) of an image mapped by dyld. It only walks nodes along the name, without reading the symbol table.
+
+ @param header Header of the loaded image.
+ @param name The symbol to completely match, such as `_swift_conformsToProtocol`.
+ @param entry The found symbol. Can be NULL.
+ */
+extern ZIKExportTrieStatus ZIKExportTrieFindInLoadedImage(const void *header, const char *name, ZIKExportTrieEntry *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include "ZIKMachOImage.h"
+
+namespace zix {
+namespace macho {
+
+enum : uint64_t {
+    EXPORT_SYMBOL_FLAGS_KIND_MASK = 0x03,
+    EXPORT_SYMBOL_FLAGS_KIND_REGULAR = 0x00,
+    EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL = 0x01,
+    EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE = 0x02,
+    EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION = 0x04,
+    EXPORT_SYMBOL_FLAGS_REEXPORT = 0x08,
+    EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER = 0x10,
+};
+
+} // namespace macho
+
+/// Terminal info of an exported symbol.
+struct MachOExport {
+    uint64_t flags;
+    /// Offset from the mach header for regular and thread local symbols, or the value for absolute symbols. For stub and resolver, it's offset of the stub.
+    uint64_t address;
+    /// Offset of the resolver for stub and resolver.
+    uint64_t resolver;
+    /// Library ordinal of the dylib for re-export.
+    int32_t reexportOrdinal;
+    /// Name in the re-exported dylib, pointing into the trie. Empty when it's the same name.
+    const char *reexportName;
+};
+
+/**
+ Walker of dyld export trie. Each lookup reads only the nodes along the name, so it's O(length of name) whatever the count of symbols.
+
+ Every read is checked against the size of the trie, and uleb128 values must fit in 64 bits. Edges with empty label are rejected, so each step consumes the name and broken tries never crash or loop.
+ */
+class ExportTrie {
+public:
+    ExportTrie() : bytes_(nullptr), size_(0) {}
+    ExportTrie(const uint8_t *bytes, size_t size) : bytes_(bytes), size_(size) {}
+
+    /// Locate the trie in either layout. Return false when the image doesn't have it or it's out of the image.
+    bool parse(const MachOImage &image);
+
+    bool isValid() const { return bytes_ != nullptr && size_ > 0; }
+
+    /// Find an exported name. Return false when it's not exported or the trie is broken.
+    bool find(const char *name, MachOExport &result) const;
+
+    /**
+     Read uleb128 with bounds check.
+
+     @param cursor Position to read. It's advanced after the value.
+     @param end End of the buffer.
+     @param value The value.
+     @return False when the value is truncated or doesn't fit in 64 bits.
+     */
+    static bool readULEB128(const uint8_t *&cursor, const uint8_t *end, uint64_t &value);
+
+private:
+    const uint8_t *bytes_;
+    size_t size_;
+};
+
+/// Install name of the dependent dylib at library ordinal, starting from 1. Return nullptr when the ordinal is out of range.
+const char *dependentDylibName(const MachOImage &image, int32_t ordinal);
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKExportTrie_h */
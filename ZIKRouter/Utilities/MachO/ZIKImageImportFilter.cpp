@@ -0,0 +1,171 @@
+//
+//  ZIKImageImportFilter.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKImageImportFilter.h"
+#include "ZIKMachOFixups.h"
+#include <string.h>
+
+using namespace zix;
+using namespace zix::macho;
+
+namespace {
+
+const char *const ClassSymbolPrefix = "_OBJC_CLASS_$_";
+
+/// Special library ordinals in fixups.
+enum : int32_t {
+    SelfLibraryOrdinal = 0,
+    MainExecutableOrdinal = -1,
+    FlatLookupOrdinal = -2,
+    WeakLookupOrdinal = -3,
+};
+
+bool isDependentDylibCommand(uint32_t cmd) {
+    return cmd == LC_LOAD_DYLIB || cmd == LC_LOAD_WEAK_DYLIB || cmd == LC_REEXPORT_DYLIB || cmd == LC_LOAD_UPWARD_DYLIB || cmd == LC_LAZY_LOAD_DYLIB;
+}
+
+/// Name in a dylib command, or empty string when it's broken.
+std::string dylibName(const load_command *lc) {
+    if (lc->cmdsize < sizeof(dylib_command)) {
+        return std::string();
+    }
+    const dylib_command *command = reinterpret_cast<const dylib_command *>(lc);
+    if (command->name_offset < sizeof(dylib_command) || command->name_offset >= command->cmdsize) {
+        return std::string();
+    }
+    const char *name = reinterpret_cast<const char *>(command) + command->name_offset;
+    size_t maxLength = command->cmdsize - command->name_offset;
+    if (memchr(name, '\0', maxLength) == nullptr) {
+        return std::string();
+    }
+    return name;
+}
+
+} // namespace
+
+ImageImportFilter::ImageImportFilter(const std::vector<std::string> &rootClassNames) : executable_(SIZE_MAX) {
+    for (const std::string &name : rootClassNames) {
+        rootClassSymbols_.insert(ClassSymbolPrefix + name);
+    }
+}
+
+size_t ImageImportFilter::addImage(const MachOImage &image, bool definesRootClasses) {
+    size_t index = images_.size();
+    images_.push_back(Image());
+    Image &added = images_.back();
+    added.isExecutable = image.isValid() && image.fileType() == MH_EXECUTE;
+    added.candidate = definesRootClasses;
+    if (!image.isValid()) {
+        added.candidate = true;
+        return index;
+    }
+    const char *installName = image.installName();
+    if (installName) {
+        added.installName = installName;
+        installNames_.insert(std::make_pair(added.installName, index));
+    }
+    if (added.isExecutable && executable_ == SIZE_MAX) {
+        executable_ = index;
+    }
+    image.enumerateLoadCommands([&](const load_command *lc) {
+        if (isDependentDylibCommand(lc->cmd)) {
+            added.dependencies.push_back(dylibName(lc));
+            if (lc->cmd == LC_REEXPORT_DYLIB) {
+                added.reexportOrdinals.push_back(static_cast<int32_t>(added.dependencies.size()));
+            }
+        }
+        return true;
+    });
+    if (added.candidate) {
+        return index;
+    }
+    MachOFixups fixups;
+    if (!fixups.parseImports(image)) {
+        added.candidate = true;
+        return index;
+    }
+    size_t prefixLength = strlen(ClassSymbolPrefix);
+    for (const MachOImport &import : fixups.imports()) {
+        if (import.name.compare(0, prefixLength, ClassSymbolPrefix) != 0) {
+            continue;
+        }
+        if (rootClassSymbols_.count(import.name) > 0) {
+            added.candidate = true;
+            break;
+        }
+        if (import.libraryOrdinal != SelfLibraryOrdinal) {
+            added.classImportOrdinals.insert(import.libraryOrdinal);
+        }
+    }
+    return index;
+}
+
+size_t ImageImportFilter::imageForOrdinal(const Image &image, int32_t ordinal) const {
+    if (ordinal == MainExecutableOrdinal) {
+        return executable_;
+    }
+    if (ordinal <= 0 || static_cast<size_t>(ordinal) > image.dependencies.size()) {
+        return SIZE_MAX;
+    }
+    std::map<std::string, size_t>::const_iterator it = installNames_.find(image.dependencies[ordinal - 1]);
+    return it == installNames_.end() ? SIZE_MAX : it->second;
+}
+
+void ImageImportFilter::resolve() {
+    // Classes may be found in any image with flat lookup
+    for (Image &image : images_) {
+        if (image.classImportOrdinals.count(FlatLookupOrdinal) > 0 || image.classImportOrdinals.count(WeakLookupOrdinal) > 0) {
+            image.candidate = true;
+        }
+    }
+    // Dependencies are usually after their dependents in dyld's image list, so propagate until nothing changes
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (Image &image : images_) {
+            if (image.candidate) {
+                continue;
+            }
+            std::vector<int32_t> ordinals(image.classImportOrdinals.begin(), image.classImportOrdinals.end());
+            ordinals.insert(ordinals.end(), image.reexportOrdinals.begin(), image.reexportOrdinals.end());
+            for (int32_t ordinal : ordinals) {
+                size_t dependency = imageForOrdinal(image, ordinal);
+                if (dependency != SIZE_MAX && images_[dependency].candidate) {
+                    image.candidate = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void ZIKImageImportFilterFindCandidates(const void *const *headers, size_t imageCount, const void *definingHeader, const char *const *rootClassNames, size_t rootClassCount, bool *results) {
+    std::vector<std::string> names(rootClassNames, rootClassNames + rootClassCount);
+    ImageImportFilter filter(names);
+    bool hasDefiningImage = false;
+    for (size_t i = 0; i < imageCount; i++) {
+        MachOImage image;
+        image.parse(headers[i], SIZE_MAX, MachOImage::LayoutLoaded);
+        filter.addImage(image, headers[i] == definingHeader);
+        hasDefiningImage = hasDefiningImage || headers[i] == definingHeader;
+    }
+    // Classes imported from the defining image are resolved with its install name
+    if (definingHeader && !hasDefiningImage) {
+        MachOImage image;
+        image.parse(definingHeader, SIZE_MAX, MachOImage::LayoutLoaded);
+        filter.addImage(image, true);
+    }
+    filter.resolve();
+    for (size_t i = 0; i < imageCount; i++) {
+        results[i] = filter.isCandidate(i);
+    }
+}
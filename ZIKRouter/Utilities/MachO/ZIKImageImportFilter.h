@@ -0,0 +1,104 @@
+//
+//  ZIKImageImportFilter.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKImageImportFilter_h
+#define ZIKImageImportFilter_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Check which loaded images may contain subclasses of root classes, by imported symbols in their fixups, without reading any class.
+
+ @param headers Headers of images mapped by dyld.
+ @param imageCount Count of images.
+ @param definingHeader Header of the image defining root classes. Pass NULL if it's not loaded.
+ @param rootClassNames Names of root classes, such as `ZIKViewRouter` and `ZIKServiceRouter`.
+ @param rootClassCount Count of root class names.
+ @param results Whether each image may contain subclasses. An array with imageCount items.
+ */
+extern void ZIKImageImportFilterFindCandidates(const void *const *headers, size_t imageCount, const void *definingHeader, const char *const *rootClassNames, size_t rootClassCount, bool *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+
+/**
+ Find images that may contain subclasses of root classes.
+
+ A class subclassing a class in another image binds its superclass pointer to the `_OBJC_CLASS_$_` symbol of the superclass. So an image may contain subclasses only when it defines a root class, imports a root class, or imports a class from another image that may contain subclasses. Imports are read from chained fixups or bind opcodes, which are much smaller than class lists. Library ordinals of imports are resolved with install names of added images, and candidates are propagated until nothing changes, so the order of images doesn't matter.
+
+ Images re-exporting a candidate are also candidates, because symbols of an umbrella framework are bound to the umbrella. Images whose fixups can't be read, and images importing classes with flat namespace lookup, are always candidates.
+ */
+class ImageImportFilter {
+public:
+    /// @param rootClassNames Names of root classes without `_OBJC_CLASS_$_` prefix.
+    explicit ImageImportFilter(const std::vector<std::string> &rootClassNames);
+
+    /**
+     Add an image.
+
+     @param image A parsed image with either layout.
+     @param definesRootClasses Whether the image defines root classes.
+     @return Index of the image.
+     */
+    size_t addImage(const MachOImage &image, bool definesRootClasses);
+
+    /// Propagate candidates through imports. Call it after adding all images.
+    void resolve();
+
+    /// Whether the image may contain subclasses after resolving.
+    bool isCandidate(size_t index) const { return images_[index].candidate; }
+
+    size_t imageCount() const { return images_.size(); }
+
+private:
+    struct Image {
+        std::string installName;
+        bool isExecutable;
+        /// Install names of dependent dylibs in the order of library ordinals.
+        std::vector<std::string> dependencies;
+        /// Library ordinals of re-exported dylibs.
+        std::vector<int32_t> reexportOrdinals;
+        /// Library ordinals of imported classes.
+        std::set<int32_t> classImportOrdinals;
+        bool candidate;
+    };
+
+    /// Index of the image providing symbols for the library ordinal, or SIZE_MAX.
+    size_t imageForOrdinal(const Image &image, int32_t ordinal) const;
+
+    std::set<std::string> rootClassSymbols_;
+    std::vector<Image> images_;
+    std::map<std::string, size_t> installNames_;
+    size_t executable_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKImageImportFilter_h */
@@ -0,0 +1,135 @@
+//
+//  ZIKImageNameTable.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKImageNameTable.h"
+
+using namespace zix;
+
+struct ZIKImageNameTable {
+    ImageNameTable table;
+};
+
+bool ImageNameTable::pathHasSuffix(const std::string &path, const std::string &suffix) {
+    return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void ImageNameTable::addImage(const void *header, const char *path, intptr_t slide) {
+    if (header == nullptr || path == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Image &image : images_) {
+        if (image.header == header) {
+            return;
+        }
+    }
+    Image image = {header, slide, path};
+    images_.push_back(image);
+    // The new image is after all images, so it only matters to names not found yet
+    for (auto &name : names_) {
+        if (name.second.header == nullptr && pathHasSuffix(image.path, name.first)) {
+            name.second.header = header;
+            name.second.slide = slide;
+        }
+    }
+}
+
+void ImageNameTable::removeImage(const void *header) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool removed = false;
+    for (auto it = images_.begin(); it != images_.end(); ++it) {
+        if (it->header == header) {
+            images_.erase(it);
+            removed = true;
+            break;
+        }
+    }
+    if (!removed) {
+        return;
+    }
+    // Names resolved to the image may match a later image
+    for (auto &name : names_) {
+        if (name.second.header == header) {
+            name.second = search(name.first);
+        }
+    }
+}
+
+ImageNameTable::Result ImageNameTable::search(const std::string &name) const {
+    for (const Image &image : images_) {
+        if (pathHasSuffix(image.path, name)) {
+            Result result = {image.header, image.slide};
+            return result;
+        }
+    }
+    Result result = {nullptr, 0};
+    return result;
+}
+
+bool ImageNameTable::find(const char *name, const void *&header, intptr_t &slide) {
+    if (name == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key(name);
+    auto it = names_.find(key);
+    if (it == names_.end()) {
+        it = names_.insert(std::make_pair(key, search(key))).first;
+    }
+    if (it->second.header == nullptr) {
+        return false;
+    }
+    header = it->second.header;
+    slide = it->second.slide;
+    return true;
+}
+
+size_t ImageNameTable::imageCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return images_.size();
+}
+
+size_t ImageNameTable::cachedNameCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
+
+ZIKImageNameTableRef ZIKImageNameTableCreate(void) {
+    return new ZIKImageNameTable();
+}
+
+void ZIKImageNameTableDestroy(ZIKImageNameTableRef table) {
+    delete table;
+}
+
+void ZIKImageNameTableAddImage(ZIKImageNameTableRef table, const void *header, const char *path, intptr_t slide) {
+    if (table) {
+        table->table.addImage(header, path, slide);
+    }
+}
+
+void ZIKImageNameTableRemoveImage(ZIKImageNameTableRef table, const void *header) {
+    if (table) {
+        table->table.removeImage(header);
+    }
+}
+
+const void *ZIKImageNameTableFind(ZIKImageNameTableRef table, const char *name, intptr_t *slide) {
+    const void *header = nullptr;
+    intptr_t imageSlide = 0;
+    if (table == nullptr || !table->table.find(name, header, imageSlide)) {
+        return nullptr;
+    }
+    if (slide) {
+        *slide = imageSlide;
+    }
+    return header;
+}
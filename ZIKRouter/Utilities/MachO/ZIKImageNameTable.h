@@ -0,0 +1,106 @@
+//
+//  ZIKImageNameTable.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKImageNameTable_h
+#define ZIKImageNameTable_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Paths of loaded images, for finding images by name.
+typedef struct ZIKImageNameTable *ZIKImageNameTableRef;
+
+extern ZIKImageNameTableRef ZIKImageNameTableCreate(void);
+
+extern void ZIKImageNameTableDestroy(ZIKImageNameTableRef table);
+
+/// Add a loaded image, such as in callback of `_dyld_register_func_for_add_image`. Images must be added in the order of loading.
+extern void ZIKImageNameTableAddImage(ZIKImageNameTableRef table, const void *header, const char *path, intptr_t slide);
+
+/// Remove an unloaded image, such as in callback of `_dyld_register_func_for_remove_image`.
+extern void ZIKImageNameTableRemoveImage(ZIKImageNameTableRef table, const void *header);
+
+/**
+ Find the first loaded image whose path ends with the name.
+
+ @param table The table.
+ @param name Suffix of the image path, such as "libswiftCore.dylib" or "ZRouter.framework/ZRouter".
+ @param slide Slide of the found image. Can be NULL.
+ @return Header of the image, or NULL when not found.
+ */
+extern const void *ZIKImageNameTableFind(ZIKImageNameTableRef table, const char *name, intptr_t *slide);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zix {
+
+/**
+ Find loaded images by suffix of their paths, with the same result as comparing paths of all images in the order of loading.
+
+ Results of names are memoized, including names not found. When an image is added, it's after all images, so it can only change results of names not found yet. When an image is removed, only names resolved to it are searched again. It's thread safe.
+ */
+class ImageNameTable {
+public:
+    void addImage(const void *header, const char *path, intptr_t slide);
+
+    void removeImage(const void *header);
+
+    /// Find the first image whose path ends with the name. Return false when not found.
+    bool find(const char *name, const void *&header, intptr_t &slide);
+
+    size_t imageCount();
+
+    /// Count of memoized names.
+    size_t cachedNameCount();
+
+    static bool pathHasSuffix(const std::string &path, const std::string &suffix);
+
+private:
+    struct Image {
+        const void *header;
+        intptr_t slide;
+        std::string path;
+    };
+
+    /// Result of a name. Header is nullptr when not found.
+    struct Result {
+        const void *header;
+        intptr_t slide;
+    };
+
+    /// The first matched image in images_.
+    Result search(const std::string &name) const;
+
+    std::mutex mutex_;
+    /// Images in the order of loading. Removed images are erased.
+    std::vector<Image> images_;
+    std::unordered_map<std::string, Result> names_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKImageNameTable_h */
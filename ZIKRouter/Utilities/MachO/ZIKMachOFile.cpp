@@ -0,0 +1,222 @@
+//
+//  ZIKMachOFile.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKMachOFile.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace zix;
+using namespace zix::macho;
+
+struct ZIKMachOFile {
+    MachOFile file;
+};
+
+MachOFile::MachOFile()
+: bytes_(nullptr), size_(0), mapped_(false), slice_(), image_(), error_(ZIKMachOFileErrorNone) {
+}
+
+MachOFile::~MachOFile() {
+    close();
+}
+
+int32_t MachOFile::hostCPUType() {
+#if defined(__x86_64__)
+    return CPU_TYPE_X86_64;
+#elif defined(__i386__)
+    return CPU_TYPE_X86;
+#elif defined(__aarch64__) || defined(__arm64__)
+    return CPU_TYPE_ARM64;
+#elif defined(__arm__)
+    return CPU_TYPE_ARM;
+#else
+    return 0;
+#endif
+}
+
+bool MachOFile::open(const char *path, int32_t cpuType) {
+    close();
+    error_ = ZIKMachOFileErrorOpen;
+    if (path == nullptr) {
+        return false;
+    }
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size <= 0) {
+        ::close(fd);
+        error_ = ZIKMachOFileErrorNotMachO;
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void *bytes = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (bytes == MAP_FAILED) {
+        return false;
+    }
+    bytes_ = static_cast<const uint8_t *>(bytes);
+    size_ = size;
+    mapped_ = true;
+    if (!selectSlice(cpuType)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MachOFile::openBytes(const void *bytes, size_t size, int32_t cpuType) {
+    close();
+    bytes_ = static_cast<const uint8_t *>(bytes);
+    size_ = size;
+    if (!selectSlice(cpuType)) {
+        bytes_ = nullptr;
+        size_ = 0;
+        return false;
+    }
+    return true;
+}
+
+void MachOFile::close() {
+    if (mapped_) {
+        munmap(const_cast<uint8_t *>(bytes_), size_);
+    }
+    bytes_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    slice_ = MachOFatSlice();
+    image_ = MachOImage();
+}
+
+bool MachOFile::selectSlice(int32_t cpuType) {
+    if (bytes_ == nullptr || size_ < sizeof(uint32_t)) {
+        error_ = ZIKMachOFileErrorNotMachO;
+        return false;
+    }
+    std::vector<MachOFatSlice> slices;
+    bool thin = !readFatSlices(bytes_, size_, slices);
+    if (!thin) {
+        int32_t selectedType = cpuType == HostCPU ? hostCPUType() : cpuType;
+        const MachOFatSlice *selected = nullptr;
+        for (const MachOFatSlice &slice : slices) {
+            if (slice.cpuType == selectedType) {
+                selected = &slice;
+                break;
+            }
+        }
+        if (selected == nullptr && cpuType == HostCPU && !slices.empty()) {
+            selected = &slices.front();
+        }
+        if (selected == nullptr) {
+            error_ = ZIKMachOFileErrorNoMatchingArch;
+            return false;
+        }
+        slice_ = *selected;
+    } else {
+        // FAT header is always big endian
+        uint32_t fatMagic = static_cast<uint32_t>(bytes_[0]) << 24 | static_cast<uint32_t>(bytes_[1]) << 16 | static_cast<uint32_t>(bytes_[2]) << 8 | bytes_[3];
+        if (fatMagic == FAT_MAGIC || fatMagic == FAT_MAGIC_64) {
+            // Broken FAT header, or slices out of the file
+            error_ = ZIKMachOFileErrorNotMachO;
+            return false;
+        }
+        uint32_t magic;
+        memcpy(&magic, bytes_, sizeof(magic));
+        if (magic != MH_MAGIC && magic != MH_MAGIC_64 && magic != MH_CIGAM && magic != MH_CIGAM_64) {
+            error_ = ZIKMachOFileErrorNotMachO;
+            return false;
+        }
+        slice_.offset = 0;
+        slice_.size = size_;
+        slice_.cpuType = 0;
+        slice_.cpuSubtype = 0;
+    }
+    if (!image_.parse(bytes_ + slice_.offset, static_cast<size_t>(slice_.size), MachOImage::LayoutFile)) {
+        error_ = ZIKMachOFileErrorInvalidImage;
+        return false;
+    }
+    if (thin) {
+        slice_.cpuType = image_.cpuType();
+        if (cpuType != HostCPU && slice_.cpuType != cpuType) {
+            image_ = MachOImage();
+            error_ = ZIKMachOFileErrorNoMatchingArch;
+            return false;
+        }
+    }
+    error_ = ZIKMachOFileErrorNone;
+    return true;
+}
+
+size_t zix::machONameList(const MachOSymbolTable &table, intptr_t slide, MachONameListItem *list, size_t nreq) {
+    size_t result = nreq;
+    size_t pending = 0;
+    for (size_t item = 0; item < nreq; item++) {
+        if (list[item].name != nullptr) {
+            pending++;
+        }
+    }
+    for (uint32_t m = 0; m < table.count && pending > 0; m++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(m, name, type, sect, desc, value);
+        if (name == nullptr || name == table.strings || (type & N_STAB) != 0) {
+            continue;
+        }
+        for (size_t item = 0; item < nreq; item++) {
+            MachONameListItem &p = list[item];
+            if (p.name == nullptr || strcmp(p.name, name) != 0) {
+                continue;
+            }
+            p.name = nullptr;
+            p.value = value != 0 ? static_cast<uintptr_t>(value + slide) : 0;
+            p.type = type;
+            p.sect = sect;
+            p.desc = static_cast<int16_t>(desc);
+            result--;
+            pending--;
+            break;
+        }
+    }
+    return result;
+}
+
+ZIKMachOFileRef ZIKMachOFileOpen(const char *path, int32_t cpuType, ZIKMachOFileError *error) {
+    ZIKMachOFileRef file = new ZIKMachOFile();
+    if (!file->file.open(path, cpuType)) {
+        if (error) {
+            *error = file->file.error();
+        }
+        delete file;
+        return NULL;
+    }
+    if (error) {
+        *error = ZIKMachOFileErrorNone;
+    }
+    return file;
+}
+
+void ZIKMachOFileClose(ZIKMachOFileRef file) {
+    delete file;
+}
+
+int32_t ZIKMachOFileCPUType(ZIKMachOFileRef file) {
+    return file ? file->file.slice().cpuType : 0;
+}
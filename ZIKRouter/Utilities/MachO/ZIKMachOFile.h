@@ -0,0 +1,185 @@
+//
+//  ZIKMachOFile.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKMachOFile_h
+#define ZIKMachOFile_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ZIKMachOFileErrorNone = 0,
+    /// The file can't be opened or mapped.
+    ZIKMachOFileErrorOpen,
+    /// The file is neither a thin Mach-O nor a FAT file, or the FAT header is broken.
+    ZIKMachOFileErrorNotMachO,
+    /// No slice matches the cpu type.
+    ZIKMachOFileErrorNoMatchingArch,
+    /// The selected slice is not a valid Mach-O image of the host byte order.
+    ZIKMachOFileErrorInvalidImage,
+} ZIKMachOFileError;
+
+/// Select the slice of the host architecture in FAT file, or the only image in thin file.
+#define ZIKMachOFileHostCPU (-1)
+
+/// A Mach-O file mapped with mmap.
+typedef struct ZIKMachOFile *ZIKMachOFileRef;
+
+/**
+ Map a thin or FAT Mach-O file, and select a slice.
+
+ @param path Path of the file.
+ @param cpuType Cpu type of the slice, such as 0x0100000c for arm64. Pass ZIKMachOFileHostCPU for the host architecture, then the first slice is used when no slice matches.
+ @param error Reason of failure. Can be NULL.
+ @return The file, or NULL when failed. Close it with ZIKMachOFileClose.
+ */
+extern ZIKMachOFileRef ZIKMachOFileOpen(const char *path, int32_t cpuType, ZIKMachOFileError *error);
+
+extern void ZIKMachOFileClose(ZIKMachOFileRef file);
+
+/// Cpu type of the selected slice.
+extern int32_t ZIKMachOFileCPUType(ZIKMachOFileRef file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include "ZIKMachOImage.h"
+#include "ZIKSymbolIndex.h"
+
+namespace zix {
+namespace macho {
+
+enum : int32_t {
+    CPU_ARCH_ABI64 = 0x01000000,
+    CPU_TYPE_X86 = 7,
+    CPU_TYPE_X86_64 = CPU_TYPE_X86 | CPU_ARCH_ABI64,
+    CPU_TYPE_ARM = 12,
+    CPU_TYPE_ARM64 = CPU_TYPE_ARM | CPU_ARCH_ABI64,
+};
+
+} // namespace macho
+
+/**
+ A thin image in a Mach-O file on disk, as the file backend of MachOImage. The file is mapped read only, and the selected slice is parsed with file layout, so segments, sections, symbol table and string table are read the same way as images mapped by dyld.
+ */
+class MachOFile {
+public:
+    static const int32_t HostCPU = ZIKMachOFileHostCPU;
+
+    MachOFile();
+    ~MachOFile();
+    MachOFile(const MachOFile &) = delete;
+    MachOFile &operator=(const MachOFile &) = delete;
+
+    /**
+     Map a file and select a slice.
+
+     @param path Path of the file.
+     @param cpuType Cpu type of the slice, or HostCPU.
+     @return False when failed, see `error()`.
+     */
+    bool open(const char *path, int32_t cpuType);
+
+    /// Select a slice in the content of a file. The bytes are not copied, they must be alive while using the image.
+    bool openBytes(const void *bytes, size_t size, int32_t cpuType);
+
+    /// Unmap the file.
+    void close();
+
+    ZIKMachOFileError error() const { return error_; }
+
+    /// The selected slice, valid after opened.
+    const MachOImage &image() const { return image_; }
+    const MachOFatSlice &slice() const { return slice_; }
+
+    /// Symbol table and string table of the selected slice.
+    bool readSymbolTable(MachOSymbolTable &table) const { return zix::readSymbolTable(image_, table); }
+
+    /// Cpu type of the running process.
+    static int32_t hostCPUType();
+
+private:
+    bool selectSlice(int32_t cpuType);
+
+    const uint8_t *bytes_;
+    size_t size_;
+    bool mapped_;
+    MachOFatSlice slice_;
+    MachOImage image_;
+    ZIKMachOFileError error_;
+};
+
+/// A symbol to find with machONameList, the same as `struct nlist` used by `nlist(3)`.
+struct MachONameListItem {
+    /// Name to find. It's set to nullptr when found.
+    const char *name;
+    uint8_t type;
+    uint8_t sect;
+    int16_t desc;
+    /// Value with slide. Undefined symbols stay 0.
+    uintptr_t value;
+};
+
+/**
+ Find symbols in a symbol table by names, like `nlist(3)`. Debug symbols are skipped, and the first symbol with the name wins.
+
+ @param table Symbol table of a loaded image or a file.
+ @param slide Slide added to found values. Pass 0 for files.
+ @param list Items to find. Items with nullptr name are skipped, such as items found in other images.
+ @param nreq Count of items.
+ @return nreq minus count of items found by this call.
+ */
+size_t machONameList(const MachOSymbolTable &table, intptr_t slide, MachONameListItem *list, size_t nreq);
+
+/**
+ Find symbols in a symbol table with a matching function. Matched symbols fill items in order, until all items are filled. Names of items are ignored.
+
+ @param matching Function or block with `bool(const char *name)`. Return true if the name is matched.
+ @return Count of items not filled.
+ */
+template <typename Matching>
+size_t machONameList(const MachOSymbolTable &table, intptr_t slide, MachONameListItem *list, size_t nreq, Matching matching) {
+    size_t filled = 0;
+    for (uint32_t m = 0; m < table.count && filled < nreq; m++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(m, name, type, sect, desc, value);
+        if (name == nullptr || name == table.strings || (type & macho::N_STAB) != 0) {
+            continue;
+        }
+        if (!matching(name)) {
+            continue;
+        }
+        MachONameListItem &p = list[filled++];
+        p.name = nullptr;
+        p.value = value != 0 ? static_cast<uintptr_t>(value + slide) : 0;
+        p.type = type;
+        p.sect = sect;
+        p.desc = static_cast<int16_t>(desc);
+    }
+    return nreq - filled;
+}
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKMachOFile_h */
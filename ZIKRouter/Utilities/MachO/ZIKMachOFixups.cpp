@@ -0,0 +1,571 @@
+//
+//  ZIKMachOFixups.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKMachOFixups.h"
+#include <string.h>
+
+using namespace zix;
+using namespace zix::macho;
+
+namespace {
+
+/// Reader of bytes with bounds check.
+class ByteReader {
+public:
+    ByteReader(const uint8_t *bytes, size_t size) : cursor_(bytes), end_(bytes + size), failed_(false) {}
+
+    bool atEnd() const { return cursor_ >= end_; }
+    bool failed() const { return failed_; }
+
+    uint8_t readByte() {
+        if (cursor_ >= end_) {
+            failed_ = true;
+            return 0;
+        }
+        return *cursor_++;
+    }
+
+    uint64_t readULEB128() {
+        uint64_t result = 0;
+        unsigned shift = 0;
+        while (true) {
+            uint8_t byte = readByte();
+            if (failed_) {
+                return 0;
+            }
+            if (shift < 64) {
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            }
+            shift += 7;
+            if ((byte & 0x80) == 0) {
+                return result;
+            }
+        }
+    }
+
+    int64_t readSLEB128() {
+        int64_t result = 0;
+        unsigned shift = 0;
+        uint8_t byte;
+        do {
+            byte = readByte();
+            if (failed_) {
+                return 0;
+            }
+            if (shift < 64) {
+                result |= static_cast<int64_t>(static_cast<uint64_t>(byte & 0x7f) << shift);
+            }
+            shift += 7;
+        } while (byte & 0x80);
+        if (shift < 64 && (byte & 0x40)) {
+            result |= static_cast<int64_t>(~0ULL << shift);
+        }
+        return result;
+    }
+
+    const char *readCString() {
+        const void *terminator = memchr(cursor_, '\0', static_cast<size_t>(end_ - cursor_));
+        if (cursor_ >= end_ || terminator == nullptr) {
+            failed_ = true;
+            return "";
+        }
+        const char *string = reinterpret_cast<const char *>(cursor_);
+        cursor_ = static_cast<const uint8_t *>(terminator) + 1;
+        return string;
+    }
+
+private:
+    const uint8_t *cursor_;
+    const uint8_t *end_;
+    bool failed_;
+};
+
+template <typename T>
+T readValue(const uint8_t *bytes) {
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+int64_t signExtend(uint64_t value, unsigned bits) {
+    uint64_t sign = 1ULL << (bits - 1);
+    return static_cast<int64_t>((value ^ sign) - sign);
+}
+
+} // namespace
+
+MachOFixups::MachOFixups() : image_(nullptr), hasChainedFixups_(false), pointerFormat_(0), importsOnly_(false) {
+}
+
+bool MachOFixups::parse(const MachOImage &image) {
+    return parse(image, false);
+}
+
+bool MachOFixups::parseImports(const MachOImage &image) {
+    return parse(image, true);
+}
+
+bool MachOFixups::parse(const MachOImage &image, bool importsOnly) {
+    image_ = &image;
+    segments_.clear();
+    hasChainedFixups_ = false;
+    pointerFormat_ = 0;
+    importsOnly_ = importsOnly;
+    imports_.clear();
+    importIndexes_.clear();
+    fixups_.clear();
+    if (!image.isValid()) {
+        return false;
+    }
+    image.enumerateSegments([&](const MachOSegment &segment) {
+        segments_.push_back(segment);
+        return true;
+    });
+    const load_command *chainedFixups = image.findLoadCommand(LC_DYLD_CHAINED_FIXUPS, sizeof(linkedit_data_command));
+    if (chainedFixups) {
+        return parseChainedFixups(reinterpret_cast<const linkedit_data_command *>(chainedFixups));
+    }
+    const load_command *dyldInfo = image.findLoadCommand(LC_DYLD_INFO_ONLY, sizeof(dyld_info_command));
+    if (dyldInfo == nullptr) {
+        dyldInfo = image.findLoadCommand(LC_DYLD_INFO, sizeof(dyld_info_command));
+    }
+    if (dyldInfo) {
+        return parseDyldInfo(reinterpret_cast<const dyld_info_command *>(dyldInfo));
+    }
+    return true;
+}
+
+// MARK: Chained Fixups
+
+bool MachOFixups::parseChainedFixups(const linkedit_data_command *command) {
+    const uint8_t *fixups = static_cast<const uint8_t *>(image_->contentAtFileOffset(command->dataoff, command->datasize));
+    if (fixups == nullptr || command->datasize < sizeof(dyld_chained_fixups_header)) {
+        return false;
+    }
+    hasChainedFixups_ = true;
+    if (!parseChainedImports(fixups, command->datasize)) {
+        return false;
+    }
+    if (importsOnly_ || image_->layout() != MachOImage::LayoutFile) {
+        return true;
+    }
+    return walkChains(fixups, command->datasize);
+}
+
+bool MachOFixups::parseChainedImports(const uint8_t *fixups, uint32_t size) {
+    dyld_chained_fixups_header header = readValue<dyld_chained_fixups_header>(fixups);
+    // Only uncompressed symbols are supported
+    if (header.fixups_version != 0 || header.symbols_format != 0) {
+        return false;
+    }
+    uint32_t importSize;
+    switch (header.imports_format) {
+        case DYLD_CHAINED_IMPORT:
+            importSize = 4;
+            break;
+        case DYLD_CHAINED_IMPORT_ADDEND:
+            importSize = 8;
+            break;
+        case DYLD_CHAINED_IMPORT_ADDEND64:
+            importSize = 16;
+            break;
+        default:
+            return false;
+    }
+    if (header.imports_offset > size || header.imports_count > (size - header.imports_offset) / importSize || header.symbols_offset > size) {
+        return false;
+    }
+    const char *symbols = reinterpret_cast<const char *>(fixups + header.symbols_offset);
+    uint32_t symbolsSize = size - header.symbols_offset;
+    imports_.reserve(header.imports_count);
+    for (uint32_t i = 0; i < header.imports_count; i++) {
+        const uint8_t *import = fixups + header.imports_offset + i * importSize;
+        uint32_t nameOffset;
+        MachOImport result;
+        if (header.imports_format == DYLD_CHAINED_IMPORT_ADDEND64) {
+            uint64_t value = readValue<uint64_t>(import);
+            // Only the last few values are special ordinals
+            uint64_t ordinal = value & 0xffff;
+            result.libraryOrdinal = static_cast<int32_t>(ordinal > 0xfff0 ? signExtend(ordinal, 16) : static_cast<int64_t>(ordinal));
+            result.weakImport = (value >> 16) & 1;
+            nameOffset = static_cast<uint32_t>(value >> 32);
+        } else {
+            uint32_t value = readValue<uint32_t>(import);
+            uint32_t ordinal = value & 0xff;
+            result.libraryOrdinal = static_cast<int32_t>(ordinal > 0xf0 ? signExtend(ordinal, 8) : static_cast<int64_t>(ordinal));
+            result.weakImport = (value >> 8) & 1;
+            nameOffset = value >> 9;
+        }
+        if (nameOffset >= symbolsSize || memchr(symbols + nameOffset, '\0', symbolsSize - nameOffset) == nullptr) {
+            return false;
+        }
+        result.name = symbols + nameOffset;
+        imports_.push_back(result);
+    }
+    return true;
+}
+
+bool MachOFixups::walkChains(const uint8_t *fixups, uint32_t size) {
+    dyld_chained_fixups_header header = readValue<dyld_chained_fixups_header>(fixups);
+    if (header.starts_offset == 0) {
+        return true;
+    }
+    if (header.starts_offset > size - sizeof(uint32_t)) {
+        return false;
+    }
+    const uint8_t *startsInImage = fixups + header.starts_offset;
+    uint32_t startsSize = size - header.starts_offset;
+    uint32_t segmentCount = readValue<uint32_t>(startsInImage);
+    if (segmentCount > (startsSize - sizeof(uint32_t)) / sizeof(uint32_t)) {
+        return false;
+    }
+    // Layout of dyld_chained_starts_in_segment
+    const uint32_t pageStartOffset = 22;
+    for (uint32_t i = 0; i < segmentCount; i++) {
+        uint32_t segmentInfoOffset = readValue<uint32_t>(startsInImage + sizeof(uint32_t) * (i + 1));
+        if (segmentInfoOffset == 0) {
+            continue;
+        }
+        if (i >= segments_.size() || segmentInfoOffset > startsSize || startsSize - segmentInfoOffset < pageStartOffset) {
+            return false;
+        }
+        const uint8_t *startsInSegment = startsInImage + segmentInfoOffset;
+        uint32_t infoSize = readValue<uint32_t>(startsInSegment);
+        uint16_t pageSize = readValue<uint16_t>(startsInSegment + 4);
+        uint16_t pointerFormat = readValue<uint16_t>(startsInSegment + 6);
+        uint32_t maxValidPointer = readValue<uint32_t>(startsInSegment + 16);
+        uint16_t pageCount = readValue<uint16_t>(startsInSegment + 20);
+        if (infoSize > startsSize - segmentInfoOffset || infoSize < pageStartOffset || (infoSize - pageStartOffset) / 2 < pageCount || pageSize == 0) {
+            return false;
+        }
+        uint32_t pageStartCount = (infoSize - pageStartOffset) / 2;
+        if (pointerFormat_ == 0) {
+            pointerFormat_ = pointerFormat;
+        }
+        const MachOSegment &segment = segments_[i];
+        for (uint16_t page = 0; page < pageCount; page++) {
+            uint16_t start = readValue<uint16_t>(startsInSegment + pageStartOffset + page * 2);
+            if (start == DYLD_CHAINED_PTR_START_NONE) {
+                continue;
+            }
+            uint64_t pageOffset = static_cast<uint64_t>(page) * pageSize;
+            if (pointerFormat == DYLD_CHAINED_PTR_32 && (start & DYLD_CHAINED_PTR_START_MULTI)) {
+                // A page of 32-bit image may have multiple chains, listed in overflow starts.
+                uint32_t index = start & ~DYLD_CHAINED_PTR_START_MULTI;
+                while (true) {
+                    if (index >= pageStartCount) {
+                        return false;
+                    }
+                    uint16_t chainStart = readValue<uint16_t>(startsInSegment + pageStartOffset + index * 2);
+                    if (!walkChain(segment, pointerFormat, pageOffset + (chainStart & ~DYLD_CHAINED_PTR_START_LAST), maxValidPointer)) {
+                        return false;
+                    }
+                    if (chainStart & DYLD_CHAINED_PTR_START_LAST) {
+                        break;
+                    }
+                    index++;
+                }
+                continue;
+            }
+            if (!walkChain(segment, pointerFormat, pageOffset + start, maxValidPointer)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool MachOFixups::walkChain(const MachOSegment &segment, uint16_t pointerFormat, uint64_t offsetInSegment, uint32_t maxValidPointer) {
+    bool is32Bit = pointerFormat == DYLD_CHAINED_PTR_32;
+    uint64_t pointerSize = is32Bit ? 4 : 8;
+    uint64_t stride;
+    switch (pointerFormat) {
+        case DYLD_CHAINED_PTR_ARM64E:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND24:
+            stride = 8;
+            break;
+        case DYLD_CHAINED_PTR_64:
+        case DYLD_CHAINED_PTR_64_OFFSET:
+        case DYLD_CHAINED_PTR_32:
+            stride = 4;
+            break;
+        default:
+            return false;
+    }
+    uint64_t offset = offsetInSegment;
+    // Each step moves forward, so the chain ends in filesize / stride steps.
+    for (uint64_t steps = 0; steps <= segment.filesize / stride; steps++) {
+        if (offset > segment.filesize || segment.filesize - offset < pointerSize) {
+            return false;
+        }
+        const uint8_t *location = static_cast<const uint8_t *>(image_->contentAtFileOffset(segment.fileoff + offset, pointerSize));
+        if (location == nullptr) {
+            return false;
+        }
+        uint64_t raw = is32Bit ? readValue<uint32_t>(location) : readValue<uint64_t>(location);
+        MachOFixup fixup;
+        uint64_t next = 0;
+        if (!decodeChainedPointer(pointerFormat, raw, maxValidPointer, fixup, next)) {
+            return false;
+        }
+        fixups_[segment.vmaddr + offset] = fixup;
+        if (next == 0) {
+            return true;
+        }
+        offset += next * stride;
+    }
+    return false;
+}
+
+bool MachOFixups::decodeChainedPointer(uint16_t pointerFormat, uint64_t raw, uint32_t maxValidPointer, MachOFixup &fixup, uint64_t &next) const {
+    uint64_t base = image_->preferredLoadAddress();
+    fixup.target = 0;
+    fixup.importIndex = 0;
+    fixup.addend = 0;
+    bool bind = false;
+    uint32_t ordinal = 0;
+    switch (pointerFormat) {
+        case DYLD_CHAINED_PTR_64:
+        case DYLD_CHAINED_PTR_64_OFFSET: {
+            next = (raw >> 51) & 0xfff;
+            bind = raw >> 63;
+            if (bind) {
+                ordinal = raw & 0xffffff;
+                fixup.addend = (raw >> 24) & 0xff;
+            } else {
+                uint64_t target = raw & 0xfffffffffULL;
+                uint64_t high8 = (raw >> 36) & 0xff;
+                fixup.target = (high8 << 56) | (pointerFormat == DYLD_CHAINED_PTR_64_OFFSET ? base + target : target);
+            }
+            break;
+        }
+        case DYLD_CHAINED_PTR_ARM64E:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND:
+        case DYLD_CHAINED_PTR_ARM64E_USERLAND24: {
+            next = (raw >> 51) & 0x7ff;
+            bool auth = raw >> 63;
+            bind = (raw >> 62) & 1;
+            if (bind) {
+                ordinal = pointerFormat == DYLD_CHAINED_PTR_ARM64E_USERLAND24 ? (raw & 0xffffff) : (raw & 0xffff);
+                if (!auth) {
+                    fixup.addend = signExtend((raw >> 32) & 0x7ffff, 19);
+                }
+            } else if (auth) {
+                // Authenticated rebase target is always an offset from the image.
+                fixup.target = base + (raw & 0xffffffffULL);
+            } else {
+                uint64_t target = raw & 0x7ffffffffffULL;
+                uint64_t high8 = (raw >> 43) & 0xff;
+                fixup.target = (high8 << 56) | (pointerFormat == DYLD_CHAINED_PTR_ARM64E ? target : base + target);
+            }
+            break;
+        }
+        case DYLD_CHAINED_PTR_32: {
+            next = (raw >> 26) & 0x1f;
+            bind = (raw >> 31) & 1;
+            if (bind) {
+                ordinal = raw & 0xfffff;
+                fixup.addend = (raw >> 20) & 0x3f;
+            } else {
+                uint64_t target = raw & 0x3ffffff;
+                if (target > maxValidPointer) {
+                    // Non-pointer value stored in a chain
+                    uint64_t bias = (0x04000000 + static_cast<uint64_t>(maxValidPointer)) / 2;
+                    target -= bias;
+                }
+                fixup.target = target;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    if (bind) {
+        if (ordinal >= imports_.size()) {
+            return false;
+        }
+        fixup.kind = MachOFixup::Bind;
+        fixup.importIndex = ordinal;
+    } else {
+        fixup.kind = MachOFixup::Rebase;
+    }
+    return true;
+}
+
+// MARK: Dyld Info
+
+bool MachOFixups::parseDyldInfo(const dyld_info_command *command) {
+    if (command->bind_size > 0) {
+        const uint8_t *bind = static_cast<const uint8_t *>(image_->contentAtFileOffset(command->bind_off, command->bind_size));
+        if (bind == nullptr || !runBindOpcodes(bind, command->bind_size, false)) {
+            return false;
+        }
+    }
+    if (command->lazy_bind_size > 0) {
+        const uint8_t *lazyBind = static_cast<const uint8_t *>(image_->contentAtFileOffset(command->lazy_bind_off, command->lazy_bind_size));
+        if (lazyBind == nullptr || !runBindOpcodes(lazyBind, command->lazy_bind_size, true)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MachOFixups::runBindOpcodes(const uint8_t *opcodes, uint32_t size, bool lazy) {
+    ByteReader reader(opcodes, size);
+    uint64_t pointerSize = image_->is64Bit() ? 8 : 4;
+    int32_t libraryOrdinal = 0;
+    const char *symbol = nullptr;
+    bool weakImport = false;
+    int64_t addend = 0;
+    uint32_t segmentIndex = 0;
+    uint64_t segmentOffset = 0;
+    bool hasSegment = false;
+
+    auto bind = [&]() -> bool {
+        if (symbol == nullptr || !hasSegment || segmentIndex >= segments_.size()) {
+            return false;
+        }
+        uint32_t importIndex = addImport(symbol, libraryOrdinal, weakImport);
+        if (!lazy && !importsOnly_) {
+            MachOFixup fixup;
+            fixup.kind = MachOFixup::Bind;
+            fixup.target = 0;
+            fixup.importIndex = importIndex;
+            fixup.addend = addend;
+            fixups_[segments_[segmentIndex].vmaddr + segmentOffset] = fixup;
+        }
+        return true;
+    };
+
+    while (!reader.atEnd()) {
+        uint8_t byte = reader.readByte();
+        uint8_t opcode = byte & BIND_OPCODE_MASK;
+        uint8_t immediate = byte & BIND_IMMEDIATE_MASK;
+        switch (opcode) {
+            case BIND_OPCODE_DONE:
+                // Lazy binds are separated by DONE
+                if (!lazy) {
+                    return true;
+                }
+                break;
+            case BIND_OPCODE_SET_DYLIB_ORDINAL_IMM:
+                libraryOrdinal = immediate;
+                break;
+            case BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB:
+                libraryOrdinal = static_cast<int32_t>(reader.readULEB128());
+                break;
+            case BIND_OPCODE_SET_DYLIB_SPECIAL_IMM:
+                libraryOrdinal = immediate == 0 ? 0 : static_cast<int8_t>(BIND_OPCODE_MASK | immediate);
+                break;
+            case BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM:
+                symbol = reader.readCString();
+                weakImport = (immediate & BIND_SYMBOL_FLAGS_WEAK_IMPORT) != 0;
+                break;
+            case BIND_OPCODE_SET_TYPE_IMM:
+                break;
+            case BIND_OPCODE_SET_ADDEND_SLEB:
+                addend = reader.readSLEB128();
+                break;
+            case BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+                segmentIndex = immediate;
+                segmentOffset = reader.readULEB128();
+                hasSegment = true;
+                break;
+            case BIND_OPCODE_ADD_ADDR_ULEB:
+                segmentOffset += reader.readULEB128();
+                break;
+            case BIND_OPCODE_DO_BIND:
+                if (!bind()) {
+                    return false;
+                }
+                segmentOffset += pointerSize;
+                break;
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB:
+                if (!bind()) {
+                    return false;
+                }
+                segmentOffset += reader.readULEB128() + pointerSize;
+                break;
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED:
+                if (!bind()) {
+                    return false;
+                }
+                segmentOffset += immediate * pointerSize + pointerSize;
+                break;
+            case BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB: {
+                uint64_t count = reader.readULEB128();
+                uint64_t skip = reader.readULEB128();
+                if (reader.failed() || count > size * 8ULL) {
+                    return false;
+                }
+                for (uint64_t i = 0; i < count; i++) {
+                    if (!bind()) {
+                        return false;
+                    }
+                    segmentOffset += skip + pointerSize;
+                }
+                break;
+            }
+            default:
+                // BIND_OPCODE_THREADED is only used by old arm64e binaries, which are not supported.
+                return false;
+        }
+        if (reader.failed()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t MachOFixups::addImport(const std::string &name, int32_t libraryOrdinal, bool weakImport) {
+    std::pair<std::string, int32_t> key(name, libraryOrdinal);
+    std::map<std::pair<std::string, int32_t>, uint32_t>::const_iterator it = importIndexes_.find(key);
+    if (it != importIndexes_.end()) {
+        return it->second;
+    }
+    MachOImport import;
+    import.name = name;
+    import.libraryOrdinal = libraryOrdinal;
+    import.weakImport = weakImport;
+    uint32_t index = static_cast<uint32_t>(imports_.size());
+    imports_.push_back(import);
+    importIndexes_[key] = index;
+    return index;
+}
+
+// MARK: Reading
+
+const MachOFixup *MachOFixups::fixupAt(uint64_t vmaddr) const {
+    std::map<uint64_t, MachOFixup>::const_iterator it = fixups_.find(vmaddr);
+    return it == fixups_.end() ? nullptr : &it->second;
+}
+
+bool MachOFixups::readPointer(uint64_t vmaddr, MachOFixup &fixup) const {
+    if (image_ == nullptr) {
+        return false;
+    }
+    size_t pointerSize = image_->is64Bit() ? 8 : 4;
+    const uint8_t *content = static_cast<const uint8_t *>(image_->contentAtVMAddress(vmaddr, pointerSize));
+    if (content == nullptr) {
+        return false;
+    }
+    const MachOFixup *found = fixupAt(vmaddr);
+    if (found) {
+        fixup = *found;
+        return true;
+    }
+    fixup.kind = MachOFixup::Rebase;
+    fixup.target = pointerSize == 8 ? readValue<uint64_t>(content) : readValue<uint32_t>(content);
+    fixup.importIndex = 0;
+    fixup.addend = 0;
+    return true;
+}
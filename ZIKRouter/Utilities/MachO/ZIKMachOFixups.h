@@ -0,0 +1,169 @@
+//
+//  ZIKMachOFixups.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKMachOFixups_h
+#define ZIKMachOFixups_h
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+namespace macho {
+
+enum : uint16_t {
+    DYLD_CHAINED_PTR_ARM64E = 1,
+    DYLD_CHAINED_PTR_64 = 2,
+    DYLD_CHAINED_PTR_32 = 3,
+    DYLD_CHAINED_PTR_64_OFFSET = 6,
+    DYLD_CHAINED_PTR_ARM64E_USERLAND = 9,
+    DYLD_CHAINED_PTR_ARM64E_USERLAND24 = 12,
+};
+
+enum : uint16_t {
+    DYLD_CHAINED_PTR_START_NONE = 0xffff,
+    DYLD_CHAINED_PTR_START_MULTI = 0x8000,
+    DYLD_CHAINED_PTR_START_LAST = 0x8000,
+};
+
+enum : uint32_t {
+    DYLD_CHAINED_IMPORT = 1,
+    DYLD_CHAINED_IMPORT_ADDEND = 2,
+    DYLD_CHAINED_IMPORT_ADDEND64 = 3,
+};
+
+struct dyld_chained_fixups_header {
+    uint32_t fixups_version;
+    uint32_t starts_offset;
+    uint32_t imports_offset;
+    uint32_t symbols_offset;
+    uint32_t imports_count;
+    uint32_t imports_format;
+    uint32_t symbols_format;
+};
+
+enum : uint8_t {
+    BIND_OPCODE_MASK = 0xf0,
+    BIND_IMMEDIATE_MASK = 0x0f,
+    BIND_OPCODE_DONE = 0x00,
+    BIND_OPCODE_SET_DYLIB_ORDINAL_IMM = 0x10,
+    BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB = 0x20,
+    BIND_OPCODE_SET_DYLIB_SPECIAL_IMM = 0x30,
+    BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM = 0x40,
+    BIND_OPCODE_SET_TYPE_IMM = 0x50,
+    BIND_OPCODE_SET_ADDEND_SLEB = 0x60,
+    BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB = 0x70,
+    BIND_OPCODE_ADD_ADDR_ULEB = 0x80,
+    BIND_OPCODE_DO_BIND = 0x90,
+    BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB = 0xa0,
+    BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED = 0xb0,
+    BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB = 0xc0,
+    BIND_OPCODE_THREADED = 0xd0,
+    BIND_SYMBOL_FLAGS_WEAK_IMPORT = 0x1,
+};
+
+} // namespace macho
+
+/// An imported symbol of a Mach-O image.
+struct MachOImport {
+    std::string name;
+    /// Ordinal of the dylib in load commands, starting from 1. 0 is self, and negative values are special ordinals.
+    int32_t libraryOrdinal;
+    bool weakImport;
+};
+
+/// A pointer to fix up when the image is loaded.
+struct MachOFixup {
+    enum Kind {
+        /// Pointer to a vm address in the image.
+        Rebase,
+        /// Pointer to an imported symbol.
+        Bind,
+    };
+    Kind kind;
+    /// Target vm address (without slide) for rebase.
+    uint64_t target;
+    /// Index in imports for bind.
+    uint32_t importIndex;
+    int64_t addend;
+};
+
+/**
+ Fixups of a Mach-O file, from LC_DYLD_CHAINED_FIXUPS or bind opcodes in LC_DYLD_INFO.
+
+ Pointers in a Mach-O file are not the real values. With chained fixups, each pointer is encoded with its target or import ordinal. With dyld info, a rebased pointer is the unslid vm address, and a bound pointer is described by bind opcodes. `readPointer` hides the difference.
+ */
+class MachOFixups {
+public:
+    MachOFixups();
+
+    /**
+     Parse fixups of an image. Chains are only walked for file layout, because dyld overwrites chains in loaded images. Imports are available for both layouts.
+
+     @return False when fixup info is broken. An image without fixup info is valid.
+     */
+    bool parse(const MachOImage &image);
+
+    /// Only parse imports, without walking chains or collecting fixups. It's much cheaper than `parse`, and works for both layouts.
+    bool parseImports(const MachOImage &image);
+
+    bool hasChainedFixups() const { return hasChainedFixups_; }
+
+    /// Pointer format of the first segment with chained fixups. 0 if there's no chained fixups.
+    uint16_t chainedPointerFormat() const { return pointerFormat_; }
+
+    /// Imported symbols. For dyld info, they're collected from bind and lazy bind opcodes.
+    const std::vector<MachOImport> &imports() const { return imports_; }
+
+    /// All fixups keyed by vm address. Lazy binds are not included.
+    const std::map<uint64_t, MachOFixup> &fixups() const { return fixups_; }
+
+    /// Find the fixup at a vm address.
+    const MachOFixup *fixupAt(uint64_t vmaddr) const;
+
+    /**
+     Read a pointer in the image and resolve it.
+
+     @param vmaddr Vm address of the pointer.
+     @param fixup Resolved pointer. When there's no fixup at the address, it's a rebase with the raw value, such as null pointer.
+     @return False when the address is out of the image.
+     */
+    bool readPointer(uint64_t vmaddr, MachOFixup &fixup) const;
+
+private:
+    bool parse(const MachOImage &image, bool importsOnly);
+    bool parseChainedFixups(const macho::linkedit_data_command *command);
+    bool parseChainedImports(const uint8_t *fixups, uint32_t size);
+    bool walkChains(const uint8_t *fixups, uint32_t size);
+    bool walkChain(const MachOSegment &segment, uint16_t pointerFormat, uint64_t offsetInSegment, uint32_t maxValidPointer);
+    bool decodeChainedPointer(uint16_t pointerFormat, uint64_t raw, uint32_t maxValidPointer, MachOFixup &fixup, uint64_t &next) const;
+    bool parseDyldInfo(const macho::dyld_info_command *command);
+    bool runBindOpcodes(const uint8_t *opcodes, uint32_t size, bool lazy);
+    uint32_t addImport(const std::string &name, int32_t libraryOrdinal, bool weakImport);
+
+    const MachOImage *image_;
+    std::vector<MachOSegment> segments_;
+    bool hasChainedFixups_;
+    uint16_t pointerFormat_;
+    bool importsOnly_;
+    std::vector<MachOImport> imports_;
+    std::map<std::pair<std::string, int32_t>, uint32_t> importIndexes_;
+    std::map<uint64_t, MachOFixup> fixups_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKMachOFixups_h */
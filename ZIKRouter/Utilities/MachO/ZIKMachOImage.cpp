@@ -0,0 +1,371 @@
+//
+//  ZIKMachOImage.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKMachOImage.h"
+#include <string.h>
+
+using namespace zix;
+using namespace zix::macho;
+
+static void copySegmentName(char dest[17], const char src[16]) {
+    memcpy(dest, src, 16);
+    dest[16] = '\0';
+}
+
+MachOImage::MachOImage()
+: base_(nullptr), size_(0), layout_(LayoutFile), header_(nullptr), is64Bit_(false), commands_(nullptr), ncmds_(0), textVMAddr_(0), slide_(0) {
+}
+
+bool MachOImage::parse(const void *base, size_t size, Layout layout) {
+    header_ = nullptr;
+    if (base == nullptr || size < sizeof(macho::mach_header)) {
+        return false;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(base);
+    uint32_t magic;
+    memcpy(&magic, bytes, sizeof(magic));
+    bool is64Bit;
+    size_t headerSize;
+    if (magic == MH_MAGIC_64) {
+        is64Bit = true;
+        headerSize = sizeof(macho::mach_header_64);
+    } else if (magic == MH_MAGIC) {
+        is64Bit = false;
+        headerSize = sizeof(macho::mach_header);
+    } else {
+        // FAT file or different byte order.
+        return false;
+    }
+    if (size < headerSize) {
+        return false;
+    }
+    const macho::mach_header *header = reinterpret_cast<const macho::mach_header *>(bytes);
+    if (header->sizeofcmds > size - headerSize) {
+        return false;
+    }
+    // Validate all load commands, so enumerating never goes out of the commands area.
+    const uint8_t *commands = bytes + headerSize;
+    uint32_t remaining = header->sizeofcmds;
+    const uint8_t *command = commands;
+    uint64_t textVMAddr = 0;
+    bool foundText = false;
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        if (remaining < sizeof(macho::load_command)) {
+            return false;
+        }
+        const macho::load_command *lc = reinterpret_cast<const macho::load_command *>(command);
+        if (lc->cmdsize < sizeof(macho::load_command) || lc->cmdsize > remaining || lc->cmdsize % 4 != 0) {
+            return false;
+        }
+        if (lc->cmd == LC_SEGMENT_64) {
+            if (!is64Bit || lc->cmdsize < sizeof(segment_command_64)) {
+                return false;
+            }
+            const segment_command_64 *seg = reinterpret_cast<const segment_command_64 *>(lc);
+            if (seg->nsects > (lc->cmdsize - sizeof(segment_command_64)) / sizeof(section_64)) {
+                return false;
+            }
+            if (!foundText && strncmp(seg->segname, "__TEXT", 16) == 0) {
+                foundText = true;
+                textVMAddr = seg->vmaddr;
+            }
+        } else if (lc->cmd == LC_SEGMENT) {
+            if (is64Bit || lc->cmdsize < sizeof(segment_command)) {
+                return false;
+            }
+            const segment_command *seg = reinterpret_cast<const segment_command *>(lc);
+            if (seg->nsects > (lc->cmdsize - sizeof(segment_command)) / sizeof(macho::section)) {
+                return false;
+            }
+            if (!foundText && strncmp(seg->segname, "__TEXT", 16) == 0) {
+                foundText = true;
+                textVMAddr = seg->vmaddr;
+            }
+        }
+        remaining -= lc->cmdsize;
+        command += lc->cmdsize;
+    }
+
+    base_ = bytes;
+    size_ = size;
+    layout_ = layout;
+    is64Bit_ = is64Bit;
+    commands_ = commands;
+    ncmds_ = header->ncmds;
+    textVMAddr_ = textVMAddr;
+    slide_ = layout == LayoutLoaded ? static_cast<intptr_t>(reinterpret_cast<uintptr_t>(bytes) - static_cast<uintptr_t>(textVMAddr)) : 0;
+    header_ = header;
+    return true;
+}
+
+int32_t MachOImage::cpuType() const {
+    return header_ ? static_cast<const macho::mach_header *>(header_)->cputype : 0;
+}
+
+uint32_t MachOImage::fileType() const {
+    return header_ ? static_cast<const macho::mach_header *>(header_)->filetype : 0;
+}
+
+const load_command *MachOImage::findLoadCommand(uint32_t cmd, uint32_t minSize) const {
+    const load_command *found = nullptr;
+    enumerateLoadCommands([&](const load_command *lc) {
+        if (lc->cmd != cmd) {
+            return true;
+        }
+        if (lc->cmdsize >= minSize) {
+            found = lc;
+        }
+        return false;
+    });
+    return found;
+}
+
+bool MachOImage::copyUUID(uint8_t uuid[16]) const {
+    const uuid_command *command = reinterpret_cast<const uuid_command *>(findLoadCommand(LC_UUID, sizeof(uuid_command)));
+    if (command == nullptr) {
+        return false;
+    }
+    memcpy(uuid, command->uuid, 16);
+    return true;
+}
+
+const char *MachOImage::installName() const {
+    const dylib_command *command = reinterpret_cast<const dylib_command *>(findLoadCommand(LC_ID_DYLIB, sizeof(dylib_command)));
+    if (command == nullptr || command->name_offset < sizeof(dylib_command) || command->name_offset >= command->cmdsize) {
+        return nullptr;
+    }
+    const char *name = reinterpret_cast<const char *>(command) + command->name_offset;
+    // The name must be terminated inside the load command.
+    if (memchr(name, '\0', command->cmdsize - command->name_offset) == nullptr) {
+        return nullptr;
+    }
+    return name;
+}
+
+bool MachOImage::segmentFromCommand(const load_command *lc, MachOSegment &segment) const {
+    if (lc->cmd == LC_SEGMENT_64) {
+        const segment_command_64 *seg = reinterpret_cast<const segment_command_64 *>(lc);
+        copySegmentName(segment.name, seg->segname);
+        segment.vmaddr = seg->vmaddr;
+        segment.vmsize = seg->vmsize;
+        segment.fileoff = seg->fileoff;
+        segment.filesize = seg->filesize;
+        return true;
+    }
+    if (lc->cmd == LC_SEGMENT) {
+        const segment_command *seg = reinterpret_cast<const segment_command *>(lc);
+        copySegmentName(segment.name, seg->segname);
+        segment.vmaddr = seg->vmaddr;
+        segment.vmsize = seg->vmsize;
+        segment.fileoff = seg->fileoff;
+        segment.filesize = seg->filesize;
+        return true;
+    }
+    return false;
+}
+
+bool MachOImage::findSegment(const char *segname, MachOSegment &segment) const {
+    bool found = false;
+    enumerateSegments([&](const MachOSegment &seg) {
+        if (strcmp(seg.name, segname) != 0) {
+            return true;
+        }
+        segment = seg;
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+bool MachOImage::findSection(const char *segname, const char *sectname, MachOSection &section) const {
+    bool found = false;
+    enumerateLoadCommands([&](const load_command *lc) {
+        if (lc->cmd == LC_SEGMENT_64) {
+            const segment_command_64 *seg = reinterpret_cast<const segment_command_64 *>(lc);
+            if (strncmp(seg->segname, segname, 16) != 0) {
+                return true;
+            }
+            const section_64 *sects = reinterpret_cast<const section_64 *>(seg + 1);
+            for (uint32_t i = 0; i < seg->nsects; i++) {
+                if (strncmp(sects[i].sectname, sectname, 16) == 0) {
+                    copySegmentName(section.segname, sects[i].segname);
+                    copySegmentName(section.sectname, sects[i].sectname);
+                    section.addr = sects[i].addr;
+                    section.size = sects[i].size;
+                    section.offset = sects[i].offset;
+                    found = true;
+                    return false;
+                }
+            }
+        } else if (lc->cmd == LC_SEGMENT) {
+            const segment_command *seg = reinterpret_cast<const segment_command *>(lc);
+            if (strncmp(seg->segname, segname, 16) != 0) {
+                return true;
+            }
+            const macho::section *sects = reinterpret_cast<const macho::section *>(seg + 1);
+            for (uint32_t i = 0; i < seg->nsects; i++) {
+                if (strncmp(sects[i].sectname, sectname, 16) == 0) {
+                    copySegmentName(section.segname, sects[i].segname);
+                    copySegmentName(section.sectname, sects[i].sectname);
+                    section.addr = sects[i].addr;
+                    section.size = sects[i].size;
+                    section.offset = sects[i].offset;
+                    found = true;
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    return found;
+}
+
+bool MachOImage::validRange(uint64_t offset, uint64_t length) const {
+    return offset <= size_ && length <= size_ - offset;
+}
+
+const void *MachOImage::contentAtVMAddress(uint64_t vmaddr, uint64_t length) const {
+    if (header_ == nullptr) {
+        return nullptr;
+    }
+    if (layout_ == LayoutLoaded) {
+        return reinterpret_cast<const void *>(static_cast<uintptr_t>(vmaddr) + slide_);
+    }
+    const void *content = nullptr;
+    enumerateSegments([&](const MachOSegment &segment) {
+        if (vmaddr < segment.vmaddr || vmaddr - segment.vmaddr >= segment.filesize) {
+            return true;
+        }
+        uint64_t delta = vmaddr - segment.vmaddr;
+        if (length > segment.filesize - delta) {
+            return false;
+        }
+        uint64_t offset = segment.fileoff + delta;
+        if (validRange(offset, length)) {
+            content = base_ + offset;
+        }
+        return false;
+    });
+    return content;
+}
+
+const void *MachOImage::contentAtFileOffset(uint64_t fileoff, uint64_t length) const {
+    if (header_ == nullptr) {
+        return nullptr;
+    }
+    if (layout_ == LayoutFile) {
+        return validRange(fileoff, length) ? base_ + fileoff : nullptr;
+    }
+    const void *content = nullptr;
+    enumerateSegments([&](const MachOSegment &segment) {
+        if (fileoff < segment.fileoff || fileoff - segment.fileoff >= segment.filesize) {
+            return true;
+        }
+        uint64_t delta = fileoff - segment.fileoff;
+        if (length <= segment.filesize - delta) {
+            content = reinterpret_cast<const void *>(static_cast<uintptr_t>(segment.vmaddr + delta) + slide_);
+        }
+        return false;
+    });
+    return content;
+}
+
+const void *MachOImage::contentOfSection(const MachOSection &section) const {
+    if (layout_ == LayoutLoaded) {
+        return contentAtVMAddress(section.addr, section.size);
+    }
+    return contentAtFileOffset(section.offset, section.size);
+}
+
+const char *MachOImage::stringAtVMAddress(uint64_t vmaddr) const {
+    if (header_ == nullptr) {
+        return nullptr;
+    }
+    if (layout_ == LayoutLoaded) {
+        return static_cast<const char *>(contentAtVMAddress(vmaddr, 1));
+    }
+    const char *string = nullptr;
+    enumerateSegments([&](const MachOSegment &segment) {
+        if (vmaddr < segment.vmaddr || vmaddr - segment.vmaddr >= segment.filesize) {
+            return true;
+        }
+        uint64_t delta = vmaddr - segment.vmaddr;
+        uint64_t offset = segment.fileoff + delta;
+        uint64_t length = segment.filesize - delta;
+        if (validRange(offset, length) && memchr(base_ + offset, '\0', static_cast<size_t>(length)) != nullptr) {
+            string = reinterpret_cast<const char *>(base_ + offset);
+        }
+        return false;
+    });
+    return string;
+}
+
+static uint32_t readBigEndian32(const uint8_t *bytes) {
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) | (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+}
+
+static uint64_t readBigEndian64(const uint8_t *bytes) {
+    return (static_cast<uint64_t>(readBigEndian32(bytes)) << 32) | readBigEndian32(bytes + 4);
+}
+
+bool zix::readFatSlices(const void *bytes, size_t size, std::vector<MachOFatSlice> &slices) {
+    slices.clear();
+    const uint8_t *file = static_cast<const uint8_t *>(bytes);
+    if (file == nullptr || size < 8) {
+        return false;
+    }
+    // FAT header is always big endian.
+    uint32_t magic = readBigEndian32(file);
+    if (magic != FAT_MAGIC && magic != FAT_MAGIC_64) {
+        return false;
+    }
+    bool is64Bit = magic == FAT_MAGIC_64;
+    size_t archSize = is64Bit ? 32 : 20;
+    uint32_t count = readBigEndian32(file + 4);
+    if (count > (size - 8) / archSize) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *arch = file + 8 + i * archSize;
+        MachOFatSlice slice;
+        slice.cpuType = static_cast<int32_t>(readBigEndian32(arch));
+        slice.cpuSubtype = static_cast<int32_t>(readBigEndian32(arch + 4));
+        if (is64Bit) {
+            slice.offset = readBigEndian64(arch + 8);
+            slice.size = readBigEndian64(arch + 16);
+        } else {
+            slice.offset = readBigEndian32(arch + 8);
+            slice.size = readBigEndian32(arch + 12);
+        }
+        if (slice.offset > size || slice.size > size - slice.offset) {
+            slices.clear();
+            return false;
+        }
+        slices.push_back(slice);
+    }
+    return true;
+}
+
+bool ZIKMachOImageCopyUUID(const void *header, uint8_t uuid[16]) {
+    MachOImage image;
+    if (!image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded)) {
+        return false;
+    }
+    return image.copyUUID(uuid);
+}
+
+const char *ZIKMachOImageInstallName(const void *header) {
+    MachOImage image;
+    if (!image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded)) {
+        return nullptr;
+    }
+    return image.installName();
+}
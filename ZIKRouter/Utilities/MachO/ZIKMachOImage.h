@@ -0,0 +1,379 @@
+//
+//  ZIKMachOImage.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKMachOImage_h
+#define ZIKMachOImage_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Copy LC_UUID of an image mapped by dyld.
+
+ @param header Header of the loaded image, such as `_dyld_get_image_header()`.
+ @param uuid Buffer for the 16 bytes uuid.
+ @return False when the image doesn't have LC_UUID.
+ */
+extern bool ZIKMachOImageCopyUUID(const void *header, uint8_t uuid[16]);
+
+/// Get install name in LC_ID_DYLIB of an image mapped by dyld. Return NULL when the image is not a dylib.
+extern const char *ZIKMachOImageInstallName(const void *header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+// Portable Mach-O reader. It doesn't depend on <mach-o/loader.h>, so it can also parse Mach-O files on other platforms.
+
+#include <vector>
+
+namespace zix {
+namespace macho {
+
+enum : uint32_t {
+    MH_MAGIC = 0xfeedface,
+    MH_CIGAM = 0xcefaedfe,
+    MH_MAGIC_64 = 0xfeedfacf,
+    MH_CIGAM_64 = 0xcffaedfe,
+    FAT_MAGIC = 0xcafebabe,
+    FAT_CIGAM = 0xbebafeca,
+    FAT_MAGIC_64 = 0xcafebabf,
+    FAT_CIGAM_64 = 0xbfbafeca,
+};
+
+enum : uint32_t {
+    MH_EXECUTE = 0x2,
+    MH_DYLIB = 0x6,
+    MH_BUNDLE = 0x8,
+};
+
+enum : uint32_t {
+    LC_REQ_DYLD = 0x80000000,
+    LC_SEGMENT = 0x1,
+    LC_SYMTAB = 0x2,
+    LC_DYSYMTAB = 0xb,
+    LC_LOAD_DYLIB = 0xc,
+    LC_ID_DYLIB = 0xd,
+    LC_LOAD_WEAK_DYLIB = 0x18 | LC_REQ_DYLD,
+    LC_SEGMENT_64 = 0x19,
+    LC_UUID = 0x1b,
+    LC_REEXPORT_DYLIB = 0x1f | LC_REQ_DYLD,
+    LC_LAZY_LOAD_DYLIB = 0x20,
+    LC_DYLD_INFO = 0x22,
+    LC_DYLD_INFO_ONLY = 0x22 | LC_REQ_DYLD,
+    LC_LOAD_UPWARD_DYLIB = 0x23 | LC_REQ_DYLD,
+    LC_DYLD_EXPORTS_TRIE = 0x33 | LC_REQ_DYLD,
+    LC_DYLD_CHAINED_FIXUPS = 0x34 | LC_REQ_DYLD,
+};
+
+struct mach_header {
+    uint32_t magic;
+    int32_t cputype;
+    int32_t cpusubtype;
+    uint32_t filetype;
+    uint32_t ncmds;
+    uint32_t sizeofcmds;
+    uint32_t flags;
+};
+
+struct mach_header_64 {
+    uint32_t magic;
+    int32_t cputype;
+    int32_t cpusubtype;
+    uint32_t filetype;
+    uint32_t ncmds;
+    uint32_t sizeofcmds;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct load_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+};
+
+struct segment_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    char segname[16];
+    uint32_t vmaddr;
+    uint32_t vmsize;
+    uint32_t fileoff;
+    uint32_t filesize;
+    int32_t maxprot;
+    int32_t initprot;
+    uint32_t nsects;
+    uint32_t flags;
+};
+
+struct segment_command_64 {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    char segname[16];
+    uint64_t vmaddr;
+    uint64_t vmsize;
+    uint64_t fileoff;
+    uint64_t filesize;
+    int32_t maxprot;
+    int32_t initprot;
+    uint32_t nsects;
+    uint32_t flags;
+};
+
+struct section {
+    char sectname[16];
+    char segname[16];
+    uint32_t addr;
+    uint32_t size;
+    uint32_t offset;
+    uint32_t align;
+    uint32_t reloff;
+    uint32_t nreloc;
+    uint32_t flags;
+    uint32_t reserved1;
+    uint32_t reserved2;
+};
+
+struct section_64 {
+    char sectname[16];
+    char segname[16];
+    uint64_t addr;
+    uint64_t size;
+    uint32_t offset;
+    uint32_t align;
+    uint32_t reloff;
+    uint32_t nreloc;
+    uint32_t flags;
+    uint32_t reserved1;
+    uint32_t reserved2;
+    uint32_t reserved3;
+};
+
+struct dylib_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    uint32_t name_offset;
+    uint32_t timestamp;
+    uint32_t current_version;
+    uint32_t compatibility_version;
+};
+
+struct uuid_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    uint8_t uuid[16];
+};
+
+struct linkedit_data_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    uint32_t dataoff;
+    uint32_t datasize;
+};
+
+struct dyld_info_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    uint32_t rebase_off;
+    uint32_t rebase_size;
+    uint32_t bind_off;
+    uint32_t bind_size;
+    uint32_t weak_bind_off;
+    uint32_t weak_bind_size;
+    uint32_t lazy_bind_off;
+    uint32_t lazy_bind_size;
+    uint32_t export_off;
+    uint32_t export_size;
+};
+
+struct symtab_command {
+    uint32_t cmd;
+    uint32_t cmdsize;
+    uint32_t symoff;
+    uint32_t nsyms;
+    uint32_t stroff;
+    uint32_t strsize;
+};
+
+struct nlist {
+    uint32_t n_strx;
+    uint8_t n_type;
+    uint8_t n_sect;
+    int16_t n_desc;
+    uint32_t n_value;
+};
+
+struct nlist_64 {
+    uint32_t n_strx;
+    uint8_t n_type;
+    uint8_t n_sect;
+    uint16_t n_desc;
+    uint64_t n_value;
+};
+
+enum : uint8_t {
+    N_STAB = 0xe0,
+    N_PEXT = 0x10,
+    N_TYPE = 0x0e,
+    N_EXT = 0x01,
+};
+
+enum : uint8_t {
+    N_UNDF = 0x0,
+    N_ABS = 0x2,
+    N_SECT = 0xe,
+    N_INDR = 0xa,
+};
+
+} // namespace macho
+
+/// Segment info of a Mach-O image.
+struct MachOSegment {
+    char name[17];
+    uint64_t vmaddr;
+    uint64_t vmsize;
+    uint64_t fileoff;
+    uint64_t filesize;
+};
+
+/// Section info of a Mach-O image.
+struct MachOSection {
+    char segname[17];
+    char sectname[17];
+    uint64_t addr;
+    uint64_t size;
+    uint32_t offset;
+};
+
+/// A slice in a FAT file.
+struct MachOFatSlice {
+    int32_t cpuType;
+    int32_t cpuSubtype;
+    uint64_t offset;
+    uint64_t size;
+};
+
+/// Read slices of a FAT file. Return false when it's not a FAT file, or any slice is out of the file.
+bool readFatSlices(const void *bytes, size_t size, std::vector<MachOFatSlice> &slices);
+
+/**
+ A read only view of a thin Mach-O image in memory. It never copies or modifies the image.
+
+ There're 2 layouts:
+ - File: the bytes of a Mach-O file (or a slice in a FAT file). Every access is checked against `size`, and vm addresses are translated to file offsets with segment load commands.
+ - Loaded: an image already mapped by dyld. Vm addresses are translated with the slide, which is calculated from the address of the header.
+ */
+class MachOImage {
+public:
+    enum Layout {
+        LayoutFile,
+        LayoutLoaded,
+    };
+
+    MachOImage();
+
+    /**
+     Parse the header and validate all load commands.
+
+     @param base Beginning of the image.
+     @param size Size of the image. Pass SIZE_MAX for a loaded image when its size is unknown.
+     @param layout Layout of the image.
+     @return False when it's not a valid thin Mach-O image of the host byte order.
+     */
+    bool parse(const void *base, size_t size, Layout layout);
+
+    bool isValid() const { return header_ != nullptr; }
+    bool is64Bit() const { return is64Bit_; }
+    Layout layout() const { return layout_; }
+    const uint8_t *base() const { return base_; }
+    size_t size() const { return size_; }
+    int32_t cpuType() const;
+    uint32_t fileType() const;
+    intptr_t slide() const { return slide_; }
+
+    /// Enumerate validated load commands. The handler returns false to stop.
+    template <typename Handler>
+    void enumerateLoadCommands(Handler handler) const {
+        const uint8_t *command = commands_;
+        for (uint32_t i = 0; i < ncmds_; i++) {
+            const macho::load_command *lc = reinterpret_cast<const macho::load_command *>(command);
+            if (!handler(lc)) {
+                return;
+            }
+            command += lc->cmdsize;
+        }
+    }
+
+    /// Find the first load command with the type. Return nullptr if not found or the command is smaller than `minSize`.
+    const macho::load_command *findLoadCommand(uint32_t cmd, uint32_t minSize) const;
+
+    bool copyUUID(uint8_t uuid[16]) const;
+
+    /// Install name in LC_ID_DYLIB. Return nullptr when it's not a dylib.
+    const char *installName() const;
+
+    bool findSegment(const char *segname, MachOSegment &segment) const;
+    bool findSection(const char *segname, const char *sectname, MachOSection &section) const;
+
+    /// Enumerate all segments. The handler returns false to stop.
+    template <typename Handler>
+    void enumerateSegments(Handler handler) const {
+        enumerateLoadCommands([&](const macho::load_command *lc) {
+            MachOSegment segment;
+            if (!segmentFromCommand(lc, segment)) {
+                return true;
+            }
+            return handler(segment);
+        });
+    }
+
+    /// Get content at the vm address (without slide). Return nullptr when the range is out of the image.
+    const void *contentAtVMAddress(uint64_t vmaddr, uint64_t length) const;
+
+    /// Get content at the file offset. For loaded image, the offset is translated through segments, so it can access content in __LINKEDIT.
+    const void *contentAtFileOffset(uint64_t fileoff, uint64_t length) const;
+
+    /// Get content of a section. Return nullptr when the section doesn't exist or is out of the image.
+    const void *contentOfSection(const MachOSection &section) const;
+
+    /// Get a C string at the vm address (without slide). For file layout, return nullptr when the string is not terminated inside its segment.
+    const char *stringAtVMAddress(uint64_t vmaddr) const;
+
+    /// Vm address (without slide) of __TEXT segment.
+    uint64_t preferredLoadAddress() const { return textVMAddr_; }
+
+private:
+    bool segmentFromCommand(const macho::load_command *lc, MachOSegment &segment) const;
+    bool validRange(uint64_t offset, uint64_t length) const;
+
+    const uint8_t *base_;
+    size_t size_;
+    Layout layout_;
+    const void *header_;
+    bool is64Bit_;
+    const uint8_t *commands_;
+    uint32_t ncmds_;
+    uint64_t textVMAddr_;
+    intptr_t slide_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKMachOImage_h */
@@ -0,0 +1,198 @@
+//
+//  ZIKStringTableScanner.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKStringTableScanner.h"
+#include <string.h>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ZIKStringScanSSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ZIKStringScanNEON 1
+#endif
+
+using namespace zix;
+using namespace zix::macho;
+
+bool zix::stringScanVectorized() {
+#if defined(ZIKStringScanSSE2) || defined(ZIKStringScanNEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Compare the pattern at a candidate whose first and last bytes already match.
+static inline bool matchesMiddle(const char *bytes, size_t position, const char *pattern, size_t length) {
+    return length <= 2 || memcmp(bytes + position + 1, pattern + 1, length - 2) == 0;
+}
+
+static void findPatternOffsetsScalar(const char *bytes, size_t from, size_t size, const char *pattern, size_t length, std::vector<uint32_t> &offsets) {
+    const char first = pattern[0];
+    const char last = pattern[length - 1];
+    for (size_t i = from; i + length <= size; i++) {
+        if (bytes[i] == first && bytes[i + length - 1] == last && matchesMiddle(bytes, i, pattern, length)) {
+            offsets.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void zix::findPatternOffsets(const char *bytes, size_t size, const char *pattern, size_t length, std::vector<uint32_t> &offsets, bool vectorized) {
+    if (bytes == nullptr || pattern == nullptr || length == 0 || size < length) {
+        return;
+    }
+    size_t i = 0;
+#if defined(ZIKStringScanSSE2)
+    if (vectorized) {
+        const __m128i first = _mm_set1_epi8(pattern[0]);
+        const __m128i last = _mm_set1_epi8(pattern[length - 1]);
+        // Both loads of a block must be inside the bytes
+        for (; i + length + 15 <= size; i += 16) {
+            __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+            __m128i lastBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i + length - 1));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, firstBlock), _mm_cmpeq_epi8(last, lastBlock))));
+            while (mask != 0) {
+                size_t position = i + __builtin_ctz(mask);
+                if (matchesMiddle(bytes, position, pattern, length)) {
+                    offsets.push_back(static_cast<uint32_t>(position));
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+#elif defined(ZIKStringScanNEON)
+    if (vectorized) {
+        const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(pattern[0]));
+        const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(pattern[length - 1]));
+        for (; i + length + 15 <= size; i += 16) {
+            uint8x16_t firstBlock = vld1q_u8(reinterpret_cast<const uint8_t *>(bytes + i));
+            uint8x16_t lastBlock = vld1q_u8(reinterpret_cast<const uint8_t *>(bytes + i + length - 1));
+            uint8x16_t matched = vandq_u8(vceqq_u8(first, firstBlock), vceqq_u8(last, lastBlock));
+            // NEON has no movemask. Narrowing keeps 4 bits for each byte
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matched), 4)), 0);
+            while (mask != 0) {
+                unsigned byte = static_cast<unsigned>(__builtin_ctzll(mask)) >> 2;
+                size_t position = i + byte;
+                if (matchesMiddle(bytes, position, pattern, length)) {
+                    offsets.push_back(static_cast<uint32_t>(position));
+                }
+                mask &= ~(0xfULL << (byte * 4));
+            }
+        }
+    }
+#else
+    (void)vectorized;
+#endif
+    // The tail, or all bytes without SIMD
+    findPatternOffsetsScalar(bytes, i, size, pattern, length, offsets);
+}
+
+SymbolNameMatcher::SymbolNameMatcher(const std::vector<std::string> &patterns, ZIKSymbolNameMatch match)
+: match_(match), matchesAll_(false) {
+    for (const std::string &pattern : patterns) {
+        // Names can't contain '\0', so only the part before it matters, the same as comparing C strings
+        std::string string(pattern.c_str());
+        if (string.empty()) {
+            matchesAll_ = true;
+        }
+        if (std::find(patterns_.begin(), patterns_.end(), string) == patterns_.end()) {
+            patterns_.push_back(string);
+        }
+    }
+}
+
+bool SymbolNameMatcher::matches(const char *name) const {
+    if (name == nullptr) {
+        return false;
+    }
+    for (const std::string &pattern : patterns_) {
+        if (match_ == ZIKSymbolNameMatchPrefix ? strncmp(name, pattern.c_str(), pattern.size()) == 0 : strstr(name, pattern.c_str()) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SymbolNameMatcher::markMatchedOffsets(const MachOSymbolTable &table, std::vector<uint64_t> &bits, bool vectorized) const {
+    if (table.strings == nullptr || table.stringsSize == 0 || patterns_.empty()) {
+        return false;
+    }
+    bits.assign((table.stringsSize + 63) / 64, 0);
+    if (matchesAll_) {
+        bits.assign(bits.size(), ~0ULL);
+        return true;
+    }
+    bool marked = false;
+    std::vector<uint32_t> offsets;
+    for (const std::string &pattern : patterns_) {
+        offsets.clear();
+        findPatternOffsets(table.strings, table.stringsSize, pattern.data(), pattern.size(), offsets, vectorized);
+        marked = marked || !offsets.empty();
+        // Mark offsets from the start of the string to each occurrence. Bytes before `scanned` are already searched for '\0'
+        uint32_t begin = 0;
+        uint32_t scanned = 0;
+        for (uint32_t offset : offsets) {
+            for (uint32_t p = offset; p > scanned; p--) {
+                if (table.strings[p - 1] == '\0') {
+                    begin = p;
+                    break;
+                }
+            }
+            scanned = offset;
+            for (uint32_t p = begin; p <= offset; p++) {
+                bits[p / 64] |= 1ULL << (p % 64);
+            }
+            // Following occurrences in the same string only need to mark offsets after this one
+            begin = offset + 1;
+        }
+    }
+    return marked;
+}
+
+void SymbolNameMatcher::findSymbols(const MachOSymbolTable &table, std::vector<uint32_t> &indexes, bool vectorized) const {
+    if (match_ == ZIKSymbolNameMatchPrefix) {
+        findSymbolsWithPrefixes(table, indexes);
+        return;
+    }
+    std::vector<uint64_t> bits;
+    if (!markMatchedOffsets(table, bits, vectorized)) {
+        return;
+    }
+    for (uint32_t i = 0; i < table.count; i++) {
+        uint32_t strx = table.is64Bit ? static_cast<const nlist_64 *>(table.symbols)[i].n_strx : static_cast<const nlist *>(table.symbols)[i].n_strx;
+        if (strx < table.stringsSize && (bits[strx / 64] >> (strx % 64) & 1) != 0) {
+            indexes.push_back(i);
+        }
+    }
+}
+
+void SymbolNameMatcher::findSymbolsWithPrefixes(const MachOSymbolTable &table, std::vector<uint32_t> &indexes) const {
+    if (table.strings == nullptr || table.stringsSize == 0 || patterns_.empty()) {
+        return;
+    }
+    for (uint32_t i = 0; i < table.count; i++) {
+        uint32_t strx = table.is64Bit ? static_cast<const nlist_64 *>(table.symbols)[i].n_strx : static_cast<const nlist *>(table.symbols)[i].n_strx;
+        if (strx >= table.stringsSize) {
+            continue;
+        }
+        const char *name = table.strings + strx;
+        size_t available = table.stringsSize - strx;
+        for (const std::string &pattern : patterns_) {
+            // Patterns have no '\0', so a name shorter than a pattern differs at its terminator. The bound keeps memcmp inside the string table
+            if (pattern.size() <= available && memcmp(name, pattern.data(), pattern.size()) == 0) {
+                indexes.push_back(i);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+//
+//  ZIKStringTableScanner.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKStringTableScanner_h
+#define ZIKStringTableScanner_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// How symbol names are matched with patterns.
+typedef enum {
+    /// Names starting with a pattern, such as "_$s", "_$S", "_T0" or "_$s7ZRouter".
+    ZIKSymbolNameMatchPrefix,
+    /// Names containing a pattern, such as "RoutableService".
+    ZIKSymbolNameMatchSubstring,
+} ZIKSymbolNameMatch;
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <string>
+#include <vector>
+#include "ZIKSymbolIndex.h"
+
+namespace zix {
+
+/// Whether findPatternOffsets uses SSE2 or NEON in this build.
+bool stringScanVectorized();
+
+/**
+ Find all occurrences of a pattern in bytes. Candidates are positions where both the first and the last byte of the pattern match, compared 16 bytes at a time with SSE2 or NEON, then the whole pattern is compared at candidates.
+
+ @param bytes Bytes to scan, such as a string table.
+ @param size Size of bytes.
+ @param pattern The pattern. It must not be empty.
+ @param length Length of the pattern.
+ @param offsets Offsets of occurrences are appended in ascending order.
+ @param vectorized Pass false to use the scalar loop, which is also used when SIMD is not available.
+ */
+void findPatternOffsets(const char *bytes, size_t size, const char *pattern, size_t length, std::vector<uint32_t> &offsets, bool vectorized = true);
+
+/**
+ Find symbols whose names match any of the patterns, with the same result as fetching each nlist and comparing its name with `strncmp` or `strstr`.
+
+ Prefixes are anchored at n_strx, so each nlist is checked with a bounded `memcmp` of its first bytes, which is cheaper than scanning the whole string table. Substrings can be anywhere, so the string table is scanned directly with findPatternOffsets. An occurrence matches all string offsets from the start of its string, because a linker may point several symbols into one string. Matched offsets are kept in a bitmap of the string table, then only n_strx of nlists is checked against it, and names of other symbols are never read. When nothing in the string table matches, nlists are not read at all.
+ */
+class SymbolNameMatcher {
+public:
+    SymbolNameMatcher(const std::vector<std::string> &patterns, ZIKSymbolNameMatch match);
+
+    /// Whether the name matches, with `strncmp` or `strstr`.
+    bool matches(const char *name) const;
+
+    /**
+     Find symbols whose names match.
+
+     @param table The symbol table.
+     @param indexes Indexes of matched symbols are appended in the order of the symbol table. Debug symbols are included.
+     @param vectorized Pass false to scan the string table for substrings with the scalar loop. Prefixes don't scan the string table.
+     */
+    void findSymbols(const MachOSymbolTable &table, std::vector<uint32_t> &indexes, bool vectorized = true) const;
+
+private:
+    /// Set bits of string offsets matching the substrings. Return false when nothing matches.
+    bool markMatchedOffsets(const MachOSymbolTable &table, std::vector<uint64_t> &bits, bool vectorized) const;
+    /// Compare the start of each symbol's name with the prefixes.
+    void findSymbolsWithPrefixes(const MachOSymbolTable &table, std::vector<uint32_t> &indexes) const;
+
+    std::vector<std::string> patterns_;
+    ZIKSymbolNameMatch match_;
+    /// A pattern is empty, so all names match.
+    bool matchesAll_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKStringTableScanner_h */
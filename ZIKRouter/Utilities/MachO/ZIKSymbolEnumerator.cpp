@@ -0,0 +1,159 @@
+//
+//  ZIKSymbolEnumerator.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKSymbolEnumerator.h"
+
+using namespace zix;
+using namespace zix::macho;
+
+/// Symbols scanned between checks of the stop flag.
+static const uint32_t kStopCheckInterval = 1024;
+
+size_t SymbolNameEnumerator::addSymbolTable(const MachOSymbolTable &table) {
+    Image image;
+    image.table = table;
+    image.finished = false;
+    images_.push_back(image);
+    return images_.size() - 1;
+}
+
+void SymbolNameEnumerator::scanImage(void *context, size_t index) {
+    SymbolNameEnumerator *enumerator = static_cast<SymbolNameEnumerator *>(context);
+    Image &image = enumerator->images_[index];
+    const MachOSymbolTable &table = image.table;
+    const Filter &filter = *enumerator->filter_;
+    std::vector<uint32_t> matched;
+    if (enumerator->matcher_ != nullptr) {
+        enumerator->matcher_->findSymbols(table, matched);
+    }
+    uint32_t count = enumerator->matcher_ != nullptr ? static_cast<uint32_t>(matched.size()) : table.count;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i % kStopCheckInterval == 0 && enumerator->stopped_.load(std::memory_order_relaxed)) {
+            image.names.clear();
+            break;
+        }
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(enumerator->matcher_ != nullptr ? matched[i] : i, name, type, sect, desc, value);
+        if (name == nullptr || name[0] == '\0' || (type & N_STAB) != 0) {
+            continue;
+        }
+        if (filter && !filter(index, name)) {
+            continue;
+        }
+        image.names.push_back(name);
+    }
+    enumerator->finishImage(index);
+}
+
+void SymbolNameEnumerator::finishImage(size_t index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    images_[index].finished = true;
+    if (std::this_thread::get_id() != caller_) {
+        // The calling thread delivers this image when it finishes its own work or when apply returns
+        return;
+    }
+    deliverFinishedImages(lock);
+}
+
+void SymbolNameEnumerator::deliverFinishedImages(std::unique_lock<std::mutex> &lock) {
+    while (nextImage_ < images_.size() && images_[nextImage_].finished && !stopped_.load(std::memory_order_relaxed)) {
+        size_t delivered = nextImage_;
+        Image &image = images_[delivered];
+        // Workers only touch their own images, so names can be read without the lock
+        lock.unlock();
+        for (const char *name : image.names) {
+            if (!(*handler_)(delivered, name)) {
+                stopped_.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+        std::vector<const char *>().swap(image.names);
+        lock.lock();
+        nextImage_++;
+    }
+}
+
+bool SymbolNameEnumerator::enumerate(ZIKApplyFunction apply, const Filter &filter, const Handler &handler) {
+    return enumerate(apply, nullptr, filter, handler);
+}
+
+bool SymbolNameEnumerator::enumerate(ZIKApplyFunction apply, const SymbolNameMatcher *matcher, const Filter &filter, const Handler &handler) {
+    matcher_ = matcher;
+    filter_ = &filter;
+    handler_ = &handler;
+    nextImage_ = 0;
+    caller_ = std::this_thread::get_id();
+    stopped_.store(false);
+    for (Image &image : images_) {
+        image.names.clear();
+        image.finished = false;
+    }
+    // Dispatching a single image costs more than scanning it.
+    if (apply != nullptr && images_.size() > 1) {
+        apply(images_.size(), this, scanImage);
+        // Images finished by other threads after the calling thread's last image
+        std::unique_lock<std::mutex> lock(mutex_);
+        deliverFinishedImages(lock);
+    } else {
+        for (size_t i = 0; i < images_.size() && !stopped_.load(); i++) {
+            scanImage(this, i);
+        }
+    }
+    matcher_ = nullptr;
+    filter_ = nullptr;
+    handler_ = nullptr;
+    caller_ = std::thread::id();
+    return !stopped_.load();
+}
+
+static bool enumerateSymbolNames(const void *const *headers, size_t imageCount, ZIKApplyFunction apply, const SymbolNameMatcher *matcher, void *context, ZIKSymbolNameFilter filter, ZIKSymbolNameHandler handler) {
+    if (headers == nullptr || handler == nullptr) {
+        return true;
+    }
+    SymbolNameEnumerator enumerator;
+    std::vector<size_t> imageIndexes;
+    for (size_t i = 0; i < imageCount; i++) {
+        MachOImage image;
+        MachOSymbolTable table;
+        if (!image.parse(headers[i], SIZE_MAX, MachOImage::LayoutLoaded) || !readSymbolTable(image, table)) {
+            continue;
+        }
+        enumerator.addSymbolTable(table);
+        imageIndexes.push_back(i);
+    }
+    SymbolNameEnumerator::Filter imageFilter;
+    if (filter != nullptr) {
+        imageFilter = [&](size_t index, const char *name) {
+            return filter(context, imageIndexes[index], name);
+        };
+    }
+    return enumerator.enumerate(apply, matcher, imageFilter, [&](size_t index, const char *name) {
+        return handler(context, imageIndexes[index], name);
+    });
+}
+
+bool ZIKEnumerateSymbolNamesInLoadedImages(const void *const *headers, size_t imageCount, ZIKApplyFunction apply, void *context, ZIKSymbolNameFilter filter, ZIKSymbolNameHandler handler) {
+    return enumerateSymbolNames(headers, imageCount, apply, nullptr, context, filter, handler);
+}
+
+bool ZIKEnumerateMatchedSymbolNamesInLoadedImages(const void *const *headers, size_t imageCount, ZIKApplyFunction apply, const char *const *patterns, size_t patternCount, ZIKSymbolNameMatch match, void *context, ZIKSymbolNameFilter filter, ZIKSymbolNameHandler handler) {
+    std::vector<std::string> patternList;
+    for (size_t i = 0; patterns != nullptr && i < patternCount; i++) {
+        if (patterns[i] != nullptr) {
+            patternList.push_back(patterns[i]);
+        }
+    }
+    SymbolNameMatcher matcher(patternList, match);
+    return enumerateSymbolNames(headers, imageCount, apply, &matcher, context, filter, handler);
+}
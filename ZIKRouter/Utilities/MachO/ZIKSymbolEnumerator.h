@@ -0,0 +1,128 @@
+//
+//  ZIKSymbolEnumerator.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKSymbolEnumerator_h
+#define ZIKSymbolEnumerator_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ZIKClassListScanner.h"
+#include "ZIKStringTableScanner.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Filter of symbol names. It's called concurrently on worker threads, but only one worker handles an image. Return true to keep the name.
+typedef bool (*ZIKSymbolNameFilter)(void *context, size_t imageIndex, const char *name);
+
+/// Handler of kept names. It's called on the thread calling the enumeration, in the order of images and then symbol tables. Return false to stop.
+typedef bool (*ZIKSymbolNameHandler)(void *context, size_t imageIndex, const char *name);
+
+/**
+ Enumerate symbol names in LC_SYMTAB of images mapped by dyld. Each image is filtered by one worker into its own buffer, and buffers are delivered to the handler on the calling thread in the order of images. When apply also runs workers on the calling thread, as dispatch_apply does, finished buffers are delivered between its workers, otherwise after apply returns. Debug symbols and empty names are skipped.
+
+ @param headers Headers of the loaded images.
+ @param imageCount Count of images.
+ @param apply Function to run workers. Pass NULL to enumerate serially.
+ @param context Context for filter and handler.
+ @param filter Filter running in workers. Pass NULL to keep all names.
+ @param handler Handler for kept names.
+ @return False when the handler stopped the enumeration.
+ */
+extern bool ZIKEnumerateSymbolNamesInLoadedImages(const void *const *headers, size_t imageCount, ZIKApplyFunction apply, void *context, ZIKSymbolNameFilter filter, ZIKSymbolNameHandler handler);
+
+/**
+ Same as ZIKEnumerateSymbolNamesInLoadedImages, but only names matching any of the patterns are passed to filter and handler. Prefixes are compared at the start of each name with `memcmp`. Workers scan string tables for substrings with SIMD, and only read nlists of matched strings, instead of comparing the name of each nlist.
+
+ @param patterns Prefixes or substrings of names.
+ @param patternCount Count of patterns.
+ @param match How names are matched with patterns.
+ */
+extern bool ZIKEnumerateMatchedSymbolNamesInLoadedImages(const void *const *headers, size_t imageCount, ZIKApplyFunction apply, const char *const *patterns, size_t patternCount, ZIKSymbolNameMatch match, void *context, ZIKSymbolNameFilter filter, ZIKSymbolNameHandler handler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ZIKSymbolIndex.h"
+
+namespace zix {
+
+/**
+ Enumerate symbol names of several images with one worker for each image.
+
+ Workers filter names into buffers of their images. Only the thread calling enumerate delivers: when it finishes a worker, buffers of finished images following the last delivered image are handed to the handler, and the rest are handed over after apply returns. So names are delivered on the calling thread in a deterministic order whatever the order of workers. When the handler returns false, a stop flag is set, and all workers check it while scanning and return early.
+ */
+class SymbolNameEnumerator {
+public:
+    /// Called in workers. Return true to keep the name.
+    typedef std::function<bool(size_t imageIndex, const char *name)> Filter;
+    /// Called on the thread calling enumerate, in order. Return false to stop.
+    typedef std::function<bool(size_t imageIndex, const char *name)> Handler;
+
+    SymbolNameEnumerator() : matcher_(nullptr), filter_(nullptr), handler_(nullptr), nextImage_(0), stopped_(false) {}
+
+    /// Add a symbol table. Return the image index passed to filter and handler.
+    size_t addSymbolTable(const MachOSymbolTable &table);
+
+    size_t imageCount() const { return images_.size(); }
+
+    /**
+     Enumerate names of all added images.
+
+     @param apply Function to run workers. Pass NULL to enumerate serially.
+     @param filter Filter for names. Can be empty to keep all names.
+     @param handler Handler for kept names.
+     @return False when the handler stopped the enumeration.
+     */
+    bool enumerate(ZIKApplyFunction apply, const Filter &filter, const Handler &handler);
+
+    /// Same as enumerate(apply, filter, handler), but only names matched by the matcher are passed to filter and handler.
+    bool enumerate(ZIKApplyFunction apply, const SymbolNameMatcher *matcher, const Filter &filter, const Handler &handler);
+
+private:
+    struct Image {
+        MachOSymbolTable table;
+        std::vector<const char *> names;
+        bool finished;
+    };
+
+    static void scanImage(void *context, size_t index);
+    /// Mark the image as finished, then deliver finished images in order if it's on the calling thread.
+    void finishImage(size_t index);
+    /// Deliver finished images following the last delivered image. Called with the lock held.
+    void deliverFinishedImages(std::unique_lock<std::mutex> &lock);
+
+    std::vector<Image> images_;
+    const SymbolNameMatcher *matcher_;
+    const Filter *filter_;
+    const Handler *handler_;
+    std::mutex mutex_;
+    size_t nextImage_;
+    /// Thread calling enumerate, the only thread calling the handler.
+    std::thread::id caller_;
+    std::atomic<bool> stopped_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKSymbolEnumerator_h */
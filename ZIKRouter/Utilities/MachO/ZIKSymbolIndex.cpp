@@ -0,0 +1,264 @@
+//
+//  ZIKSymbolIndex.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKSymbolIndex.h"
+#include <string.h>
+#include <algorithm>
+
+using namespace zix;
+using namespace zix::macho;
+
+void MachOSymbolTable::symbolAtIndex(uint32_t index, const char *&name, uint8_t &type, uint8_t &sect, uint16_t &desc, uint64_t &value) const {
+    uint32_t strx;
+    if (is64Bit) {
+        const nlist_64 *symbol = static_cast<const nlist_64 *>(symbols) + index;
+        strx = symbol->n_strx;
+        type = symbol->n_type;
+        sect = symbol->n_sect;
+        desc = symbol->n_desc;
+        value = symbol->n_value;
+    } else {
+        const nlist *symbol = static_cast<const nlist *>(symbols) + index;
+        strx = symbol->n_strx;
+        type = symbol->n_type;
+        sect = symbol->n_sect;
+        desc = static_cast<uint16_t>(symbol->n_desc);
+        value = symbol->n_value;
+    }
+    // The string table ends with '\0', so any string inside it is terminated
+    name = strx < stringsSize ? strings + strx : nullptr;
+}
+
+bool zix::readSymbolTable(const MachOImage &image, MachOSymbolTable &table) {
+    const symtab_command *symtab = reinterpret_cast<const symtab_command *>(image.findLoadCommand(LC_SYMTAB, sizeof(symtab_command)));
+    if (symtab == nullptr) {
+        return false;
+    }
+    uint64_t symbolSize = image.is64Bit() ? sizeof(nlist_64) : sizeof(nlist);
+    const void *symbols = image.contentAtFileOffset(symtab->symoff, symbolSize * symtab->nsyms);
+    const char *strings = static_cast<const char *>(image.contentAtFileOffset(symtab->stroff, symtab->strsize));
+    if ((symbols == nullptr && symtab->nsyms > 0) || strings == nullptr) {
+        return false;
+    }
+    uint32_t stringsSize = symtab->strsize;
+    // Cut the unterminated tail
+    while (stringsSize > 0 && strings[stringsSize - 1] != '\0') {
+        stringsSize--;
+    }
+    table.symbols = symbols;
+    table.count = symtab->nsyms;
+    table.is64Bit = image.is64Bit();
+    table.strings = strings;
+    table.stringsSize = stringsSize;
+    return true;
+}
+
+size_t SymbolNameHash::operator()(const SymbolName &name) const {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < name.length; i++) {
+        hash ^= static_cast<uint8_t>(name.string[i]);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool SymbolNameEqual::operator()(const SymbolName &lhs, const SymbolName &rhs) const {
+    return lhs.length == rhs.length && memcmp(lhs.string, rhs.string, lhs.length) == 0;
+}
+
+bool SymbolIndex::build(const MachOImage &image) {
+    entries_.clear();
+    MachOSymbolTable table;
+    if (!readSymbolTable(image, table)) {
+        return false;
+    }
+    slide_ = image.slide();
+    entries_.reserve(table.count);
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *string;
+        Entry entry;
+        table.symbolAtIndex(i, string, entry.type, entry.sect, entry.desc, entry.value);
+        if (string == nullptr || string == table.strings || (entry.type & N_STAB) != 0) {
+            continue;
+        }
+        SymbolName name = {string, strlen(string)};
+        // Keep the first one
+        entries_.insert(std::make_pair(name, entry));
+    }
+    return true;
+}
+
+const SymbolIndex::Entry *SymbolIndex::find(const char *name) const {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    SymbolName key = {name, strlen(name)};
+    std::unordered_map<SymbolName, Entry, SymbolNameHash, SymbolNameEqual>::const_iterator it = entries_.find(key);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+size_t zix::findSymbols(const MachOSymbolTable &table, const char *const *names, size_t count, SymbolIndex::Entry *entries, bool *found) {
+    // Name → index of its first occurrence in names
+    std::unordered_map<SymbolName, size_t, SymbolNameHash, SymbolNameEqual> requests;
+    requests.reserve(count);
+    size_t minLength = SIZE_MAX;
+    size_t maxLength = 0;
+    for (size_t i = 0; i < count; i++) {
+        found[i] = false;
+        if (names[i] == nullptr) {
+            continue;
+        }
+        SymbolName name = {names[i], strlen(names[i])};
+        if (requests.insert(std::make_pair(name, i)).second) {
+            minLength = std::min(minLength, name.length);
+            maxLength = std::max(maxLength, name.length);
+        }
+    }
+    size_t remaining = requests.size();
+    for (uint32_t i = 0; i < table.count && remaining > 0; i++) {
+        const char *string;
+        SymbolIndex::Entry entry;
+        table.symbolAtIndex(i, string, entry.type, entry.sect, entry.desc, entry.value);
+        if (string == nullptr || string == table.strings || (entry.type & N_STAB) != 0) {
+            continue;
+        }
+        // Most symbols are filtered by length, without hashing
+        size_t length = strnlen(string, maxLength + 1);
+        if (length < minLength || length > maxLength) {
+            continue;
+        }
+        SymbolName name = {string, length};
+        std::unordered_map<SymbolName, size_t, SymbolNameHash, SymbolNameEqual>::iterator it = requests.find(name);
+        if (it == requests.end() || found[it->second]) {
+            continue;
+        }
+        entries[it->second] = entry;
+        found[it->second] = true;
+        remaining--;
+    }
+    size_t foundCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (names[i] == nullptr) {
+            continue;
+        }
+        SymbolName name = {names[i], strlen(names[i])};
+        size_t first = requests[name];
+        if (found[first]) {
+            entries[i] = entries[first];
+            found[i] = true;
+            foundCount++;
+        }
+    }
+    return foundCount;
+}
+
+std::shared_ptr<const SymbolIndex> SymbolIndexCache::indexForLoadedImage(const void *header) {
+    if (header == nullptr) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_map<const void *, std::shared_ptr<const SymbolIndex>>::iterator it = indexes_.find(header);
+        if (it != indexes_.end()) {
+            return it->second;
+        }
+    }
+    // Build without the lock, so lookups in other images are not blocked
+    std::shared_ptr<SymbolIndex> index;
+    MachOImage image;
+    if (image.parse(header, SIZE_MAX, MachOImage::LayoutLoaded)) {
+        index = std::make_shared<SymbolIndex>();
+        if (!index->build(image)) {
+            index = nullptr;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Another thread may have built it at the same time
+    return indexes_.insert(std::make_pair(header, std::shared_ptr<const SymbolIndex>(index))).first->second;
+}
+
+void SymbolIndexCache::removeImage(const void *header) {
+    // Destroyed after unlocking
+    std::shared_ptr<const SymbolIndex> index;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<const void *, std::shared_ptr<const SymbolIndex>>::iterator it = indexes_.find(header);
+    if (it != indexes_.end()) {
+        index = it->second;
+        indexes_.erase(it);
+    }
+}
+
+size_t SymbolIndexCache::imageCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return indexes_.size();
+}
+
+SymbolIndexCache &SymbolIndexCache::shared() {
+    // Never destroyed, so lookups in other threads during exit are safe
+    static SymbolIndexCache *cache = new SymbolIndexCache();
+    return *cache;
+}
+
+ZIKSymbolIndexStatus ZIKSymbolIndexFindInLoadedImage(const void *header, const char *name, ZIKSymbolIndexEntry *entry) {
+    if (header == nullptr || name == nullptr) {
+        return ZIKSymbolIndexStatusNotFound;
+    }
+    std::shared_ptr<const SymbolIndex> index = SymbolIndexCache::shared().indexForLoadedImage(header);
+    if (index == nullptr) {
+        return ZIKSymbolIndexStatusUnavailable;
+    }
+    const SymbolIndex::Entry *found = index->find(name);
+    if (found == nullptr) {
+        return ZIKSymbolIndexStatusNotFound;
+    }
+    if (entry) {
+        entry->address = found->value == 0 ? 0 : static_cast<uintptr_t>(found->value + index->slide());
+        entry->type = found->type;
+        entry->sect = found->sect;
+        entry->desc = found->desc;
+    }
+    return ZIKSymbolIndexStatusFound;
+}
+
+ZIKSymbolIndexStatus ZIKSymbolIndexFindSymbolsInLoadedImage(const void *header, const char *const *names, size_t count, ZIKSymbolIndexEntry *entries, bool *found) {
+    for (size_t i = 0; i < count; i++) {
+        found[i] = false;
+    }
+    if (header == nullptr) {
+        return ZIKSymbolIndexStatusNotFound;
+    }
+    std::shared_ptr<const SymbolIndex> index = SymbolIndexCache::shared().indexForLoadedImage(header);
+    if (index == nullptr) {
+        return ZIKSymbolIndexStatusUnavailable;
+    }
+    bool foundAll = true;
+    for (size_t i = 0; i < count; i++) {
+        const SymbolIndex::Entry *entry = index->find(names[i]);
+        if (entry == nullptr) {
+            foundAll = false;
+            continue;
+        }
+        entries[i].address = entry->value == 0 ? 0 : static_cast<uintptr_t>(entry->value + index->slide());
+        entries[i].type = entry->type;
+        entries[i].sect = entry->sect;
+        entries[i].desc = entry->desc;
+        found[i] = true;
+    }
+    return foundAll ? ZIKSymbolIndexStatusFound : ZIKSymbolIndexStatusNotFound;
+}
+
+void ZIKSymbolIndexRemoveLoadedImage(const void *header) {
+    SymbolIndexCache::shared().removeImage(header);
+}
@@ -0,0 +1,173 @@
+//
+//  ZIKSymbolIndex.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKSymbolIndex_h
+#define ZIKSymbolIndex_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    /// The symbol is not in the symbol table.
+    ZIKSymbolIndexStatusNotFound = 0,
+    ZIKSymbolIndexStatusFound,
+    /// The image doesn't have a readable symbol table. Search it in other ways.
+    ZIKSymbolIndexStatusUnavailable,
+} ZIKSymbolIndexStatus;
+
+typedef struct {
+    /// n_value with slide of the image. Undefined symbols are 0.
+    uintptr_t address;
+    uint8_t type;
+    uint8_t sect;
+    uint16_t desc;
+} ZIKSymbolIndexEntry;
+
+/**
+ Find a symbol in LC_SYMTAB of an image mapped by dyld. Symbols of the image are indexed by name on first use, so later lookups don't scan the symbol table again.
+
+ @param header Header of the loaded image, such as `_dyld_get_image_header()`.
+ @param name The symbol to completely match.
+ @param entry The found symbol. Can be NULL.
+ */
+extern ZIKSymbolIndexStatus ZIKSymbolIndexFindInLoadedImage(const void *header, const char *name, ZIKSymbolIndexEntry *entry);
+
+/**
+ Find symbols in LC_SYMTAB of an image mapped by dyld, with one lookup of the index for all names.
+
+ @param header Header of the loaded image.
+ @param names Symbols to completely match.
+ @param count Count of names.
+ @param entries Found symbols. An array with count items.
+ @param found Whether each name is found. An array with count items.
+ @return Unavailable when the image doesn't have a readable symbol table, otherwise found when all names are found.
+ */
+extern ZIKSymbolIndexStatus ZIKSymbolIndexFindSymbolsInLoadedImage(const void *header, const char *const *names, size_t count, ZIKSymbolIndexEntry *entries, bool *found);
+
+/// Remove the index of an image. Call it when the image is unloaded, because the index refers to its string table, and another image may be loaded at the same address.
+extern void ZIKSymbolIndexRemoveLoadedImage(const void *header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "ZIKMachOImage.h"
+
+namespace zix {
+
+/// LC_SYMTAB of an image.
+struct MachOSymbolTable {
+    const void *symbols;
+    uint32_t count;
+    bool is64Bit;
+    const char *strings;
+    uint32_t stringsSize;
+
+    /// Read nlist at index. Return name nullptr when its string is out of the string table.
+    void symbolAtIndex(uint32_t index, const char *&name, uint8_t &type, uint8_t &sect, uint16_t &desc, uint64_t &value) const;
+};
+
+/// Locate LC_SYMTAB in either layout. Return false when the image doesn't have it or it's out of the image.
+bool readSymbolTable(const MachOImage &image, MachOSymbolTable &table);
+
+/// A name in a string table, with its length.
+struct SymbolName {
+    const char *string;
+    size_t length;
+};
+
+struct SymbolNameHash {
+    size_t operator()(const SymbolName &name) const;
+};
+
+struct SymbolNameEqual {
+    bool operator()(const SymbolName &lhs, const SymbolName &rhs) const;
+};
+
+/**
+ Hash index of symbol name → nlist of an image, skipping debug symbols. Names are not copied, they point into the string table of the image, so the index is only valid while the image is mapped.
+
+ When a name appears more than once, the first one in the symbol table is kept, the same as scanning the table.
+ */
+class SymbolIndex {
+public:
+    struct Entry {
+        uint64_t value;
+        uint8_t type;
+        uint8_t sect;
+        uint16_t desc;
+    };
+
+    SymbolIndex() : slide_(0) {}
+
+    /// Index all symbols in the image. Return false when the image doesn't have a readable symbol table.
+    bool build(const MachOImage &image);
+
+    /// Find a symbol by name. Values are without slide.
+    const Entry *find(const char *name) const;
+
+    size_t count() const { return entries_.size(); }
+
+    /// Slide of the indexed image. It's 0 for file layout.
+    intptr_t slide() const { return slide_; }
+
+private:
+    std::unordered_map<SymbolName, Entry, SymbolNameHash, SymbolNameEqual> entries_;
+    intptr_t slide_;
+};
+
+/**
+ Find symbols with a single pass over the symbol table, without building an index. Requested names are hashed, and the pass stops when all names are found. It's much cheaper than building an index when only a few names are needed.
+
+ @param names Symbols to completely match. Duplicated names are allowed.
+ @param count Count of names.
+ @param entries Found symbols. Values are without slide. An array with count items.
+ @param found Whether each name is found. An array with count items.
+ @return Count of found names.
+ */
+size_t findSymbols(const MachOSymbolTable &table, const char *const *names, size_t count, SymbolIndex::Entry *entries, bool *found);
+
+/**
+ Indexes of loaded images by header. An index is built on first use of the image, and must be removed when the image is unloaded.
+ */
+class SymbolIndexCache {
+public:
+    /// Get index of a loaded image, building it if needed. Return nullptr when the image doesn't have a readable symbol table.
+    std::shared_ptr<const SymbolIndex> indexForLoadedImage(const void *header);
+
+    void removeImage(const void *header);
+
+    size_t imageCount();
+
+    /// Cache used by the C functions.
+    static SymbolIndexCache &shared();
+
+private:
+    std::mutex mutex_;
+    /// nullptr for images without symbol table, so they're not parsed again.
+    std::unordered_map<const void *, std::shared_ptr<const SymbolIndex>> indexes_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKSymbolIndex_h */
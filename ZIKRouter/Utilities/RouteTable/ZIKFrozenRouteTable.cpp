@@ -0,0 +1,470 @@
+//
+//  ZIKFrozenRouteTable.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKFrozenRouteTable.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct TableHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    /// FNV-1a of bytes after header.
+    uint32_t checksum;
+    uint64_t fileSize;
+    uint32_t imageCount;
+    uint32_t imagesOffset;
+    uint32_t entryCount;
+    uint32_t entriesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t reserved[4];
+};
+
+struct ImageRecord {
+    uint32_t nameOffset;
+    uint8_t uuid[16];
+};
+
+struct EntryRecord {
+    uint32_t keyHash;
+    uint16_t kind;
+    uint16_t imageIndex;
+    uint32_t keyOffset;
+    uint32_t valueOffset;
+    uint32_t registryOffset;
+};
+
+static_assert(sizeof(TableHeader) == 64, "Header size is part of the file format");
+static_assert(sizeof(ImageRecord) == 20, "Image record size is part of the file format");
+static_assert(sizeof(EntryRecord) == 20, "Entry record size is part of the file format");
+
+uint32_t fnv1a(const uint8_t *bytes, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t hashString(const char *string) {
+    return fnv1a(reinterpret_cast<const uint8_t *>(string), strlen(string));
+}
+
+bool entryLess(const EntryRecord &lhs, uint16_t kind, uint32_t keyHash) {
+    return std::tie(lhs.kind, lhs.keyHash) < std::tie(kind, keyHash);
+}
+
+} // namespace
+
+struct ZIKFrozenRouteTable {
+    const uint8_t *bytes;
+    size_t size;
+    /// Whether bytes are mmapped by the table.
+    bool mapped;
+    const TableHeader *header;
+    const ImageRecord *images;
+    const EntryRecord *entries;
+    const char *strings;
+
+    const char *stringAt(uint32_t offset) const {
+        return strings + offset;
+    }
+};
+
+static ZIKFrozenRouteTableError validateTable(const uint8_t *bytes, size_t size, ZIKFrozenRouteTable &table) {
+    if (size < sizeof(TableHeader)) {
+        return ZIKFrozenRouteTableErrorTruncated;
+    }
+    const TableHeader *header = reinterpret_cast<const TableHeader *>(bytes);
+    if (header->magic != ZIKFrozenRouteTableMagic) {
+        return ZIKFrozenRouteTableErrorBadMagic;
+    }
+    if (header->version != ZIKFrozenRouteTableVersion) {
+        return ZIKFrozenRouteTableErrorVersionMismatch;
+    }
+    if (header->headerSize != sizeof(TableHeader)) {
+        return ZIKFrozenRouteTableErrorCorrupted;
+    }
+    if (header->fileSize > size) {
+        return ZIKFrozenRouteTableErrorTruncated;
+    }
+    if (header->fileSize != size) {
+        return ZIKFrozenRouteTableErrorCorrupted;
+    }
+    if (fnv1a(bytes + sizeof(TableHeader), size - sizeof(TableHeader)) != header->checksum) {
+        return ZIKFrozenRouteTableErrorCorrupted;
+    }
+    uint64_t imagesEnd = static_cast<uint64_t>(header->imagesOffset) + static_cast<uint64_t>(header->imageCount) * sizeof(ImageRecord);
+    uint64_t entriesEnd = static_cast<uint64_t>(header->entriesOffset) + static_cast<uint64_t>(header->entryCount) * sizeof(EntryRecord);
+    uint64_t stringsEnd = static_cast<uint64_t>(header->stringsOffset) + header->stringsSize;
+    if (header->imagesOffset < sizeof(TableHeader) || header->imagesOffset % 4 != 0 || imagesEnd > size ||
+        header->entriesOffset < sizeof(TableHeader) || header->entriesOffset % 4 != 0 || entriesEnd > size ||
+        header->stringsOffset < sizeof(TableHeader) || stringsEnd > size ||
+        header->imageCount > ZIKFrozenRouteTableNoImage) {
+        return ZIKFrozenRouteTableErrorCorrupted;
+    }
+    const char *strings = reinterpret_cast<const char *>(bytes + header->stringsOffset);
+    if (header->stringsSize == 0 || strings[header->stringsSize - 1] != '\0') {
+        return ZIKFrozenRouteTableErrorCorrupted;
+    }
+    const ImageRecord *images = reinterpret_cast<const ImageRecord *>(bytes + header->imagesOffset);
+    for (uint32_t i = 0; i < header->imageCount; i++) {
+        if (images[i].nameOffset >= header->stringsSize) {
+            return ZIKFrozenRouteTableErrorCorrupted;
+        }
+    }
+    const EntryRecord *entries = reinterpret_cast<const EntryRecord *>(bytes + header->entriesOffset);
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const EntryRecord &entry = entries[i];
+        if (entry.keyOffset >= header->stringsSize ||
+            entry.valueOffset >= header->stringsSize ||
+            entry.registryOffset >= header->stringsSize ||
+            (entry.imageIndex != ZIKFrozenRouteTableNoImage && entry.imageIndex >= header->imageCount)) {
+            return ZIKFrozenRouteTableErrorCorrupted;
+        }
+        // Lookup depends on the order.
+        if (i > 0 && entryLess(entry, entries[i - 1].kind, entries[i - 1].keyHash)) {
+            return ZIKFrozenRouteTableErrorCorrupted;
+        }
+    }
+    table.bytes = bytes;
+    table.size = size;
+    table.header = header;
+    table.images = images;
+    table.entries = entries;
+    table.strings = strings;
+    return ZIKFrozenRouteTableErrorNone;
+}
+
+ZIKFrozenRouteTableRef ZIKFrozenRouteTableCreateWithBytes(const void *bytes, size_t size, ZIKFrozenRouteTableError *error) {
+    ZIKFrozenRouteTable table = {};
+    ZIKFrozenRouteTableError result = bytes ? validateTable(static_cast<const uint8_t *>(bytes), size, table) : ZIKFrozenRouteTableErrorIO;
+    if (error) {
+        *error = result;
+    }
+    if (result != ZIKFrozenRouteTableErrorNone) {
+        return NULL;
+    }
+    return new ZIKFrozenRouteTable(table);
+}
+
+ZIKFrozenRouteTableRef ZIKFrozenRouteTableOpen(const char *path, ZIKFrozenRouteTableError *error) {
+    if (error) {
+        *error = ZIKFrozenRouteTableErrorIO;
+    }
+    if (path == NULL) {
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    if (st.st_size <= 0) {
+        close(fd);
+        if (error) {
+            *error = ZIKFrozenRouteTableErrorTruncated;
+        }
+        return NULL;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void *bytes = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (bytes == MAP_FAILED) {
+        return NULL;
+    }
+    ZIKFrozenRouteTableRef table = ZIKFrozenRouteTableCreateWithBytes(bytes, size, error);
+    if (table == NULL) {
+        munmap(bytes, size);
+        return NULL;
+    }
+    table->mapped = true;
+    return table;
+}
+
+void ZIKFrozenRouteTableClose(ZIKFrozenRouteTableRef table) {
+    if (table == NULL) {
+        return;
+    }
+    if (table->mapped) {
+        munmap(const_cast<uint8_t *>(table->bytes), table->size);
+    }
+    delete table;
+}
+
+uint32_t ZIKFrozenRouteTableImageCount(ZIKFrozenRouteTableRef table) {
+    return table ? table->header->imageCount : 0;
+}
+
+const char *ZIKFrozenRouteTableGetImage(ZIKFrozenRouteTableRef table, uint32_t index, uint8_t uuid[16]) {
+    if (table == NULL || index >= table->header->imageCount) {
+        return NULL;
+    }
+    const ImageRecord &image = table->images[index];
+    if (uuid) {
+        memcpy(uuid, image.uuid, 16);
+    }
+    return table->stringAt(image.nameOffset);
+}
+
+uint32_t ZIKFrozenRouteTableEntryCount(ZIKFrozenRouteTableRef table) {
+    return table ? table->header->entryCount : 0;
+}
+
+bool ZIKFrozenRouteTableGetEntry(ZIKFrozenRouteTableRef table, uint32_t index, ZIKFrozenRouteEntry *entry) {
+    if (table == NULL || entry == NULL || index >= table->header->entryCount) {
+        return false;
+    }
+    const EntryRecord &record = table->entries[index];
+    entry->kind = static_cast<ZIKFrozenRouteKind>(record.kind);
+    entry->registry = table->stringAt(record.registryOffset);
+    entry->key = table->stringAt(record.keyOffset);
+    entry->value = table->stringAt(record.valueOffset);
+    entry->imageIndex = record.imageIndex;
+    return true;
+}
+
+uint32_t ZIKFrozenRouteTableLookup(ZIKFrozenRouteTableRef table, ZIKFrozenRouteKind kind, const char *key, uint32_t *first) {
+    if (table == NULL || key == NULL) {
+        return 0;
+    }
+    uint16_t entryKind = static_cast<uint16_t>(kind);
+    uint32_t keyHash = hashString(key);
+    const EntryRecord *begin = table->entries;
+    const EntryRecord *end = begin + table->header->entryCount;
+    const EntryRecord *lower = std::lower_bound(begin, end, 0, [&](const EntryRecord &entry, int) {
+        return entryLess(entry, entryKind, keyHash);
+    });
+    // Entries with the same hash are sorted by key, so entries with the same key are continuous.
+    const EntryRecord *matched = nullptr;
+    uint32_t count = 0;
+    for (const EntryRecord *entry = lower; entry < end && entry->kind == entryKind && entry->keyHash == keyHash; entry++) {
+        if (strcmp(table->stringAt(entry->keyOffset), key) != 0) {
+            if (matched) {
+                break;
+            }
+            continue;
+        }
+        if (matched == nullptr) {
+            matched = entry;
+        }
+        count++;
+    }
+    if (first && matched) {
+        *first = static_cast<uint32_t>(matched - begin);
+    }
+    return count;
+}
+
+// MARK: Writer
+
+struct ZIKFrozenRouteTableBuilder {
+    struct Image {
+        std::string name;
+        uint8_t uuid[16];
+    };
+    struct Entry {
+        uint16_t kind;
+        uint32_t keyHash;
+        std::string key;
+        std::string registry;
+        std::string value;
+        uint32_t imageIndex;
+
+        bool operator<(const Entry &other) const {
+            return std::tie(kind, keyHash, key, registry, value) < std::tie(other.kind, other.keyHash, other.key, other.registry, other.value);
+        }
+        bool operator==(const Entry &other) const {
+            return kind == other.kind && key == other.key && registry == other.registry && value == other.value;
+        }
+    };
+    std::vector<Image> images;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, uint32_t> imageIndexes;
+
+    std::vector<uint8_t> serialize();
+};
+
+std::vector<uint8_t> ZIKFrozenRouteTableBuilder::serialize() {
+    std::vector<Entry> sorted = entries;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> stringOffsets;
+    auto addString = [&](const std::string &string) -> uint32_t {
+        auto found = stringOffsets.find(string);
+        if (found != stringOffsets.end()) {
+            return found->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.append(string);
+        strings.push_back('\0');
+        stringOffsets.emplace(string, offset);
+        return offset;
+    };
+    // Empty string at offset 0.
+    addString("");
+
+    std::vector<ImageRecord> imageRecords;
+    for (const Image &image : images) {
+        ImageRecord record = {};
+        record.nameOffset = addString(image.name);
+        memcpy(record.uuid, image.uuid, 16);
+        imageRecords.push_back(record);
+    }
+    std::vector<EntryRecord> entryRecords;
+    for (const Entry &entry : sorted) {
+        EntryRecord record = {};
+        record.keyHash = entry.keyHash;
+        record.kind = entry.kind;
+        record.imageIndex = static_cast<uint16_t>(entry.imageIndex);
+        record.keyOffset = addString(entry.key);
+        record.valueOffset = addString(entry.value);
+        record.registryOffset = addString(entry.registry);
+        entryRecords.push_back(record);
+    }
+
+    TableHeader header = {};
+    header.magic = ZIKFrozenRouteTableMagic;
+    header.version = ZIKFrozenRouteTableVersion;
+    header.headerSize = sizeof(TableHeader);
+    header.imageCount = static_cast<uint32_t>(imageRecords.size());
+    header.imagesOffset = sizeof(TableHeader);
+    header.entryCount = static_cast<uint32_t>(entryRecords.size());
+    header.entriesOffset = header.imagesOffset + header.imageCount * sizeof(ImageRecord);
+    header.stringsOffset = header.entriesOffset + header.entryCount * sizeof(EntryRecord);
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    header.fileSize = header.stringsOffset + header.stringsSize;
+
+    std::vector<uint8_t> bytes(header.fileSize);
+    if (!imageRecords.empty()) {
+        memcpy(bytes.data() + header.imagesOffset, imageRecords.data(), imageRecords.size() * sizeof(ImageRecord));
+    }
+    if (!entryRecords.empty()) {
+        memcpy(bytes.data() + header.entriesOffset, entryRecords.data(), entryRecords.size() * sizeof(EntryRecord));
+    }
+    memcpy(bytes.data() + header.stringsOffset, strings.data(), strings.size());
+    header.checksum = fnv1a(bytes.data() + sizeof(TableHeader), bytes.size() - sizeof(TableHeader));
+    memcpy(bytes.data(), &header, sizeof(TableHeader));
+    return bytes;
+}
+
+ZIKFrozenRouteTableBuilderRef ZIKFrozenRouteTableBuilderCreate(void) {
+    return new ZIKFrozenRouteTableBuilder();
+}
+
+void ZIKFrozenRouteTableBuilderDestroy(ZIKFrozenRouteTableBuilderRef builder) {
+    delete builder;
+}
+
+uint32_t ZIKFrozenRouteTableBuilderAddImage(ZIKFrozenRouteTableBuilderRef builder, const char *installName, const uint8_t uuid[16]) {
+    if (builder == NULL || installName == NULL || uuid == NULL) {
+        return ZIKFrozenRouteTableNoImage;
+    }
+    auto found = builder->imageIndexes.find(installName);
+    if (found != builder->imageIndexes.end()) {
+        return found->second;
+    }
+    if (builder->images.size() >= ZIKFrozenRouteTableNoImage) {
+        return ZIKFrozenRouteTableNoImage;
+    }
+    ZIKFrozenRouteTableBuilder::Image image;
+    image.name = installName;
+    memcpy(image.uuid, uuid, 16);
+    uint32_t index = static_cast<uint32_t>(builder->images.size());
+    builder->images.push_back(image);
+    builder->imageIndexes.emplace(installName, index);
+    return index;
+}
+
+void ZIKFrozenRouteTableBuilderAddEntry(ZIKFrozenRouteTableBuilderRef builder, ZIKFrozenRouteKind kind, const char *registry, const char *key, const char *value, uint32_t imageIndex) {
+    if (builder == NULL || registry == NULL || key == NULL || value == NULL) {
+        return;
+    }
+    if (imageIndex != ZIKFrozenRouteTableNoImage && imageIndex >= builder->images.size()) {
+        return;
+    }
+    ZIKFrozenRouteTableBuilder::Entry entry;
+    entry.kind = static_cast<uint16_t>(kind);
+    entry.keyHash = hashString(key);
+    entry.key = key;
+    entry.registry = registry;
+    entry.value = value;
+    entry.imageIndex = imageIndex;
+    builder->entries.push_back(entry);
+}
+
+void *ZIKFrozenRouteTableBuilderCopyBytes(ZIKFrozenRouteTableBuilderRef builder, size_t *size) {
+    if (builder == NULL) {
+        return NULL;
+    }
+    std::vector<uint8_t> bytes = builder->serialize();
+    void *buffer = malloc(bytes.size());
+    if (buffer == NULL) {
+        return NULL;
+    }
+    memcpy(buffer, bytes.data(), bytes.size());
+    if (size) {
+        *size = bytes.size();
+    }
+    return buffer;
+}
+
+bool ZIKFrozenRouteTableBuilderWriteToFile(ZIKFrozenRouteTableBuilderRef builder, const char *path) {
+    if (builder == NULL || path == NULL) {
+        return false;
+    }
+    std::vector<uint8_t> bytes = builder->serialize();
+    std::string tempPath = std::string(path) + ".tmp." + std::to_string(getpid());
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+        if (result <= 0) {
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    bool synced = fsync(fd) == 0;
+    if (close(fd) != 0 || !synced) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    if (rename(tempPath.c_str(), path) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
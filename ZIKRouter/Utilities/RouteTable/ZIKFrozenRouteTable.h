@@ -0,0 +1,129 @@
+//
+//  ZIKFrozenRouteTable.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKFrozenRouteTable_h
+#define ZIKFrozenRouteTable_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ Frozen route table is a read only file of registered routes, written by main app and mmapped by app extensions in the same app group, so extensions can skip searching router classes in shared frameworks.
+
+ File layout (host byte order, all offsets are from the beginning of the file):
+ - Header: magic, version, checksum of the body, file size, and offsets of other parts.
+ - Images: install name and LC_UUID of each image containing routers. Reader should validate uuid with loaded images, and reject the whole table when mismatched.
+ - Entries: sorted by (kind, key hash, key), so lookup is a binary search without parsing the whole file.
+ - Strings: NUL terminated strings referenced by images and entries.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZIKFrozenRouteTableMagic 0x544b495a // 'ZIKT'
+#define ZIKFrozenRouteTableVersion 2
+/// Router class is not in any image in the table.
+#define ZIKFrozenRouteTableNoImage 0xffff
+
+typedef enum {
+    ZIKFrozenRouteKindDestinationProtocol = 1,
+    ZIKFrozenRouteKindModuleProtocol = 2,
+    ZIKFrozenRouteKindIdentifier = 3,
+    ZIKFrozenRouteKindDestinationClass = 4,
+    /// Key is adapter protocol, value is the router class registering the adapter.
+    ZIKFrozenRouteKindAdapter = 5,
+    /// Every router class in the image, key and value are the router class name. Lookups without a key, such as lookups of swift types, register all of them.
+    ZIKFrozenRouteKindRouterClass = 6,
+    /// Router class registering routes not listed by key, such as ZIKRoute, factories and pure swift protocols. Key and value are the router class name. It's registered at launch even though its image is in the table.
+    ZIKFrozenRouteKindEagerRouterClass = 7,
+} ZIKFrozenRouteKind;
+
+typedef enum {
+    ZIKFrozenRouteTableErrorNone = 0,
+    /// Failed to open, read or write the file.
+    ZIKFrozenRouteTableErrorIO,
+    /// File is smaller than its header declares.
+    ZIKFrozenRouteTableErrorTruncated,
+    /// Not a frozen route table, or written with a different byte order.
+    ZIKFrozenRouteTableErrorBadMagic,
+    /// Written by another version of ZIKRouter.
+    ZIKFrozenRouteTableErrorVersionMismatch,
+    /// Checksum mismatch or invalid offsets.
+    ZIKFrozenRouteTableErrorCorrupted,
+} ZIKFrozenRouteTableError;
+
+typedef struct ZIKFrozenRouteTable *ZIKFrozenRouteTableRef;
+typedef struct ZIKFrozenRouteTableBuilder *ZIKFrozenRouteTableBuilderRef;
+
+typedef struct {
+    ZIKFrozenRouteKind kind;
+    /// Name of the registry class, such as `ZIKServiceRouteRegistry`.
+    const char *registry;
+    /// Protocol name, identifier, destination class name or router class name.
+    const char *key;
+    /// Router class name.
+    const char *value;
+    /// Index of image containing the router class, or ZIKFrozenRouteTableNoImage.
+    uint32_t imageIndex;
+} ZIKFrozenRouteEntry;
+
+// MARK: Reader
+
+/// Open and validate a table with mmap. Return NULL when failed.
+extern ZIKFrozenRouteTableRef ZIKFrozenRouteTableOpen(const char *path, ZIKFrozenRouteTableError *error);
+
+/// Validate a table in memory, without copying it. The bytes must be alive before closing the table.
+extern ZIKFrozenRouteTableRef ZIKFrozenRouteTableCreateWithBytes(const void *bytes, size_t size, ZIKFrozenRouteTableError *error);
+
+extern void ZIKFrozenRouteTableClose(ZIKFrozenRouteTableRef table);
+
+extern uint32_t ZIKFrozenRouteTableImageCount(ZIKFrozenRouteTableRef table);
+
+/// Get install name and uuid of image at index. Return NULL when index is out of bounds.
+extern const char *ZIKFrozenRouteTableGetImage(ZIKFrozenRouteTableRef table, uint32_t index, uint8_t uuid[16]);
+
+extern uint32_t ZIKFrozenRouteTableEntryCount(ZIKFrozenRouteTableRef table);
+
+extern bool ZIKFrozenRouteTableGetEntry(ZIKFrozenRouteTableRef table, uint32_t index, ZIKFrozenRouteEntry *entry);
+
+/**
+ Find entries with the kind and key.
+
+ @param first First index of matched entries.
+ @return Count of matched entries. Matched entries are continuous.
+ */
+extern uint32_t ZIKFrozenRouteTableLookup(ZIKFrozenRouteTableRef table, ZIKFrozenRouteKind kind, const char *key, uint32_t *first);
+
+// MARK: Writer
+
+extern ZIKFrozenRouteTableBuilderRef ZIKFrozenRouteTableBuilderCreate(void);
+
+extern void ZIKFrozenRouteTableBuilderDestroy(ZIKFrozenRouteTableBuilderRef builder);
+
+/// Add an image, return its index. Same install name returns the same index.
+extern uint32_t ZIKFrozenRouteTableBuilderAddImage(ZIKFrozenRouteTableBuilderRef builder, const char *installName, const uint8_t uuid[16]);
+
+/// Add an entry. Duplicated entries are ignored.
+extern void ZIKFrozenRouteTableBuilderAddEntry(ZIKFrozenRouteTableBuilderRef builder, ZIKFrozenRouteKind kind, const char *registry, const char *key, const char *value, uint32_t imageIndex);
+
+/// Write to a temporary file then rename it to the path, so readers never see a partial file.
+extern bool ZIKFrozenRouteTableBuilderWriteToFile(ZIKFrozenRouteTableBuilderRef builder, const char *path);
+
+/// Serialize into a malloc buffer. Caller should free it.
+extern void *ZIKFrozenRouteTableBuilderCopyBytes(ZIKFrozenRouteTableBuilderRef builder, size_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZIKFrozenRouteTable_h */
@@ -0,0 +1,176 @@
+//
+//  ZIKLazyRouteLoader.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKLazyRouteLoader.h"
+#include <dlfcn.h>
+
+using namespace zix;
+
+bool LazyRouteLoader::addRoute(uint32_t kind, const char *key, const char *libraryPath, const char *routerName, const char *symbol) {
+    if (key == nullptr || libraryPath == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key entryKey(kind, key);
+    if (entries_.find(entryKey) != entries_.end()) {
+        return false;
+    }
+    std::unique_ptr<Entry> entry(new Entry());
+    entry->key = key;
+    entry->libraryPath = libraryPath;
+    entry->routerName = routerName ? routerName : "";
+    entry->symbol = symbol ? symbol : "";
+    entry->hasSymbol = symbol != nullptr;
+    entry->state = Pending;
+    entry->symbolAddress = nullptr;
+    entries_[entryKey] = std::move(entry);
+    return true;
+}
+
+ZIKLazyRouteStatus LazyRouteLoader::load(uint32_t kind, const char *key, void **symbolAddress) {
+    if (key == nullptr) {
+        return ZIKLazyRouteStatusNotFound;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::map<Key, std::unique_ptr<Entry>>::iterator it = entries_.find(Key(kind, key));
+    if (it == entries_.end()) {
+        return ZIKLazyRouteStatusNotFound;
+    }
+    Entry *entry = it->second.get();
+    switch (entry->state) {
+        case Loaded:
+            if (symbolAddress) {
+                *symbolAddress = entry->symbolAddress;
+            }
+            return ZIKLazyRouteStatusAlreadyLoaded;
+        case Failed:
+            return ZIKLazyRouteStatusFailed;
+        case Loading:
+            if (entry->loadingThread == std::this_thread::get_id()) {
+                return ZIKLazyRouteStatusLoading;
+            }
+            condition_.wait(lock, [entry] {
+                return entry->state != Loading;
+            });
+            if (entry->state != Loaded) {
+                return ZIKLazyRouteStatusFailed;
+            }
+            if (symbolAddress) {
+                *symbolAddress = entry->symbolAddress;
+            }
+            return ZIKLazyRouteStatusLoaded;
+        case Pending:
+            break;
+    }
+    entry->state = Loading;
+    entry->loadingThread = std::this_thread::get_id();
+    lock.unlock();
+
+    // Load without the lock, so other keys can load in parallel, and the callback can look up other keys
+    std::string error;
+    void *address = nullptr;
+    void *handle = dlopen(entry->libraryPath.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    if (handle == nullptr) {
+        const char *message = dlerror();
+        error = message ? message : "dlopen failed";
+    } else if (entry->hasSymbol) {
+        dlerror();
+        address = dlsym(handle, entry->symbol.c_str());
+        if (address == nullptr) {
+            const char *message = dlerror();
+            error = message ? message : "dlsym failed";
+        }
+    }
+    bool succeeded = error.empty();
+    if (succeeded && loaded_) {
+        ZIKLazyRoute route;
+        route.kind = kind;
+        route.key = entry->key.c_str();
+        route.libraryPath = entry->libraryPath.c_str();
+        route.routerName = entry->routerName.c_str();
+        route.symbol = entry->hasSymbol ? entry->symbol.c_str() : nullptr;
+        loaded_(context_, &route, address);
+    }
+
+    lock.lock();
+    entry->symbolAddress = address;
+    entry->error = error;
+    entry->state = succeeded ? Loaded : Failed;
+    entry->loadingThread = std::thread::id();
+    lock.unlock();
+    condition_.notify_all();
+    if (!succeeded) {
+        return ZIKLazyRouteStatusFailed;
+    }
+    if (symbolAddress) {
+        *symbolAddress = address;
+    }
+    return ZIKLazyRouteStatusLoaded;
+}
+
+const char *LazyRouteLoader::error(uint32_t kind, const char *key) {
+    if (key == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<Key, std::unique_ptr<Entry>>::iterator it = entries_.find(Key(kind, key));
+    if (it == entries_.end() || it->second->state != Failed) {
+        return nullptr;
+    }
+    return it->second->error.c_str();
+}
+
+size_t LazyRouteLoader::routeCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+struct ZIKLazyRouteLoader {
+    LazyRouteLoader loader;
+
+    ZIKLazyRouteLoader(ZIKLazyRouteLoadedFunction loaded, void *context) : loader(loaded, context) {}
+};
+
+ZIKLazyRouteLoaderRef ZIKLazyRouteLoaderCreate(ZIKLazyRouteLoadedFunction loaded, void *context) {
+    return new ZIKLazyRouteLoader(loaded, context);
+}
+
+bool ZIKLazyRouteLoaderAddRoute(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key, const char *libraryPath, const char *routerName, const char *symbol) {
+    if (loader == nullptr) {
+        return false;
+    }
+    return loader->loader.addRoute(kind, key, libraryPath, routerName, symbol);
+}
+
+ZIKLazyRouteStatus ZIKLazyRouteLoaderLoad(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key, void **symbolAddress) {
+    if (loader == nullptr) {
+        return ZIKLazyRouteStatusNotFound;
+    }
+    return loader->loader.load(kind, key, symbolAddress);
+}
+
+const char *ZIKLazyRouteLoaderGetError(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key) {
+    if (loader == nullptr) {
+        return nullptr;
+    }
+    return loader->loader.error(kind, key);
+}
+
+size_t ZIKLazyRouteLoaderRouteCount(ZIKLazyRouteLoaderRef loader) {
+    if (loader == nullptr) {
+        return 0;
+    }
+    return loader->loader.routeCount();
+}
+
+void ZIKLazyRouteLoaderDestroy(ZIKLazyRouteLoaderRef loader) {
+    delete loader;
+}
@@ -0,0 +1,138 @@
+//
+//  ZIKLazyRouteLoader.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKLazyRouteLoader_h
+#define ZIKLazyRouteLoader_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ Lazy routes map a route key to a library not loaded at launch. The first lookup of the key loads the library with dlopen, resolves a symbol with dlsym, and lets the caller register routers in it. Libraries are never closed, because registered classes live in them.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    /// No lazy route for the key.
+    ZIKLazyRouteStatusNotFound = 0,
+    /// Library is loaded by this call, or by another thread this call waited for.
+    ZIKLazyRouteStatusLoaded,
+    /// Library was loaded by an earlier call.
+    ZIKLazyRouteStatusAlreadyLoaded,
+    /// Library is being loaded in current thread, such as a lookup in the loaded callback.
+    ZIKLazyRouteStatusLoading,
+    /// dlopen or dlsym failed. Loading is not retried.
+    ZIKLazyRouteStatusFailed,
+} ZIKLazyRouteStatus;
+
+typedef struct {
+    /// Kind of the key, such as ZIKFrozenRouteKind.
+    uint32_t kind;
+    /// Protocol name or identifier.
+    const char *key;
+    /// Path passed to dlopen.
+    const char *libraryPath;
+    /// Router class name.
+    const char *routerName;
+    /// Symbol to resolve with dlsym after loading, or NULL.
+    const char *symbol;
+} ZIKLazyRoute;
+
+/// Called once for each route after its library is loaded, in the loading thread. Threads waiting for the route are released after it returns.
+typedef void (*ZIKLazyRouteLoadedFunction)(void *context, const ZIKLazyRoute *route, void *symbolAddress);
+
+typedef struct ZIKLazyRouteLoader *ZIKLazyRouteLoaderRef;
+
+extern ZIKLazyRouteLoaderRef ZIKLazyRouteLoaderCreate(ZIKLazyRouteLoadedFunction loaded, void *context);
+
+/// Add a lazy route. Return false if the key already has a lazy route. `symbol` can be NULL.
+extern bool ZIKLazyRouteLoaderAddRoute(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key, const char *libraryPath, const char *routerName, const char *symbol);
+
+/// Load the library of the key if it's not loaded yet. Concurrent calls for the same key load it only once. `symbolAddress` is set when the status is loaded or already loaded, and can be NULL.
+extern ZIKLazyRouteStatus ZIKLazyRouteLoaderLoad(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key, void **symbolAddress);
+
+/// Message of dlerror when loading the key failed, or NULL. Valid until the loader is destroyed.
+extern const char *ZIKLazyRouteLoaderGetError(ZIKLazyRouteLoaderRef loader, uint32_t kind, const char *key);
+
+extern size_t ZIKLazyRouteLoaderRouteCount(ZIKLazyRouteLoaderRef loader);
+
+extern void ZIKLazyRouteLoaderDestroy(ZIKLazyRouteLoaderRef loader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace zix {
+
+/**
+ Loads libraries of lazy routes with a once guard for each key. Only the first caller of a key calls dlopen, other threads calling with the same key wait for it, and later calls only take the lock to read the state.
+ */
+class LazyRouteLoader {
+public:
+    LazyRouteLoader(ZIKLazyRouteLoadedFunction loaded, void *context) : loaded_(loaded), context_(context) {}
+
+    bool addRoute(uint32_t kind, const char *key, const char *libraryPath, const char *routerName, const char *symbol);
+
+    ZIKLazyRouteStatus load(uint32_t kind, const char *key, void **symbolAddress);
+
+    const char *error(uint32_t kind, const char *key);
+
+    size_t routeCount();
+
+private:
+    enum State {
+        Pending,
+        Loading,
+        Loaded,
+        Failed,
+    };
+
+    struct Entry {
+        std::string key;
+        std::string libraryPath;
+        std::string routerName;
+        std::string symbol;
+        bool hasSymbol;
+        State state;
+        std::thread::id loadingThread;
+        void *symbolAddress;
+        std::string error;
+    };
+
+    typedef std::pair<uint32_t, std::string> Key;
+
+    ZIKLazyRouteLoadedFunction loaded_;
+    void *context_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    // Entries are never removed, so strings of routes passed to the callback stay valid
+    std::map<Key, std::unique_ptr<Entry>> entries_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKLazyRouteLoader_h */
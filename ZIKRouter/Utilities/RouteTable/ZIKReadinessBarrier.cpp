@@ -0,0 +1,110 @@
+//
+//  ZIKReadinessBarrier.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKReadinessBarrier.h"
+#include <chrono>
+
+using namespace zix;
+
+bool ReadinessBarrier::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int expected = Idle;
+    return state_.compare_exchange_strong(expected, Running, std::memory_order_acq_rel);
+}
+
+void ReadinessBarrier::enterWorkerThread() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    worker_ = std::this_thread::get_id();
+}
+
+void ReadinessBarrier::markReady() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_.load(std::memory_order_relaxed) != Running) {
+            return;
+        }
+        // Release writes of the work to threads loading the state
+        state_.store(Ready, std::memory_order_release);
+        worker_ = std::thread::id();
+    }
+    condition_.notify_all();
+}
+
+uint64_t ReadinessBarrier::waitSlow() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (state_.load(std::memory_order_acquire) != Running || worker_ == std::this_thread::get_id()) {
+        return 0;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    condition_.wait(lock, [this] {
+        return state_.load(std::memory_order_acquire) != Running;
+    });
+    uint64_t blocked = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    blockedCount_.fetch_add(1, std::memory_order_relaxed);
+    blockedTime_.fetch_add(blocked, std::memory_order_relaxed);
+    return blocked;
+}
+
+struct ZIKReadinessBarrier {
+    ReadinessBarrier barrier;
+};
+
+ZIKReadinessBarrierRef ZIKReadinessBarrierCreate(void) {
+    return new ZIKReadinessBarrier();
+}
+
+bool ZIKReadinessBarrierStart(ZIKReadinessBarrierRef barrier) {
+    if (barrier == nullptr) {
+        return false;
+    }
+    return barrier->barrier.start();
+}
+
+void ZIKReadinessBarrierEnterWorkerThread(ZIKReadinessBarrierRef barrier) {
+    if (barrier == nullptr) {
+        return;
+    }
+    barrier->barrier.enterWorkerThread();
+}
+
+void ZIKReadinessBarrierMarkReady(ZIKReadinessBarrierRef barrier) {
+    if (barrier == nullptr) {
+        return;
+    }
+    barrier->barrier.markReady();
+}
+
+bool ZIKReadinessBarrierIsRunning(ZIKReadinessBarrierRef barrier) {
+    if (barrier == nullptr) {
+        return false;
+    }
+    return barrier->barrier.state() == ReadinessBarrier::Running;
+}
+
+uint64_t ZIKReadinessBarrierWait(ZIKReadinessBarrierRef barrier) {
+    if (barrier == nullptr) {
+        return 0;
+    }
+    return barrier->barrier.wait();
+}
+
+void ZIKReadinessBarrierGetBlockedStatistics(ZIKReadinessBarrierRef barrier, size_t *blockedCount, uint64_t *blockedTime) {
+    if (blockedCount) {
+        *blockedCount = barrier ? barrier->barrier.blockedCount() : 0;
+    }
+    if (blockedTime) {
+        *blockedTime = barrier ? barrier->barrier.blockedTime() : 0;
+    }
+}
+
+void ZIKReadinessBarrierDestroy(ZIKReadinessBarrierRef barrier) {
+    delete barrier;
+}
@@ -0,0 +1,113 @@
+//
+//  ZIKReadinessBarrier.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKReadinessBarrier_h
+#define ZIKReadinessBarrier_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ZIKReadinessBarrier *ZIKReadinessBarrierRef;
+
+extern ZIKReadinessBarrierRef ZIKReadinessBarrierCreate(void);
+
+/// Mark work as started. Call it before dispatching the work, so other threads wait for it as soon as it returns. Return NO if it's already started.
+extern bool ZIKReadinessBarrierStart(ZIKReadinessBarrierRef barrier);
+
+/// Call it in the thread doing the work, so the work can call functions waiting for it.
+extern void ZIKReadinessBarrierEnterWorkerThread(ZIKReadinessBarrierRef barrier);
+
+/// Mark work as done and wake up waiting threads.
+extern void ZIKReadinessBarrierMarkReady(ZIKReadinessBarrierRef barrier);
+
+/// Whether work is started and not done yet.
+extern bool ZIKReadinessBarrierIsRunning(ZIKReadinessBarrierRef barrier);
+
+/// Block until work is done, if it's running in another thread. Return nanoseconds blocked.
+extern uint64_t ZIKReadinessBarrierWait(ZIKReadinessBarrierRef barrier);
+
+/// Count of waits that blocked, and total nanoseconds blocked.
+extern void ZIKReadinessBarrierGetBlockedStatistics(ZIKReadinessBarrierRef barrier, size_t *blockedCount, uint64_t *blockedTime);
+
+extern void ZIKReadinessBarrierDestroy(ZIKReadinessBarrierRef barrier);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace zix {
+
+/**
+ Let threads wait for work running in another thread, such as registration in a background queue.
+
+ Waiting is a single atomic load once the work is done, or when it's never started. Only threads arriving while the work is running take the lock and sleep on a condition variable, which is backed by futex or ulock of the kernel. The thread doing the work never blocks on itself, so the work can call functions waiting for it.
+ */
+class ReadinessBarrier {
+public:
+    enum State : int {
+        Idle = 0,
+        Running,
+        Ready,
+    };
+
+    ReadinessBarrier() : state_(Idle), blockedCount_(0), blockedTime_(0) {}
+
+    /// Mark work as started. Return false if it's already started.
+    bool start();
+
+    /// Let current thread do the work without blocking on itself.
+    void enterWorkerThread();
+
+    /// Mark work as done and wake up waiting threads.
+    void markReady();
+
+    State state() const { return static_cast<State>(state_.load(std::memory_order_acquire)); }
+
+    /// Block until work is done, if it's running in another thread. Return nanoseconds blocked.
+    uint64_t wait() {
+        if (state_.load(std::memory_order_acquire) != Running) {
+            return 0;
+        }
+        return waitSlow();
+    }
+
+    size_t blockedCount() const { return blockedCount_.load(std::memory_order_relaxed); }
+
+    uint64_t blockedTime() const { return blockedTime_.load(std::memory_order_relaxed); }
+
+private:
+    uint64_t waitSlow();
+
+    std::atomic<int> state_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread::id worker_;
+    std::atomic<size_t> blockedCount_;
+    std::atomic<uint64_t> blockedTime_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKReadinessBarrier_h */
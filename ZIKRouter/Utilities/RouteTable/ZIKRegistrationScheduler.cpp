@@ -0,0 +1,102 @@
+//
+//  ZIKRegistrationScheduler.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKRegistrationScheduler.h"
+#include <chrono>
+
+using namespace zix;
+
+RegistrationScheduler::RegistrationScheduler(size_t workCount, uint64_t sliceBudget, ZIKRegistrationWorkFunction work, void *workContext, ZIKRegistrationClockFunction clock, void *clockContext)
+: workCount_(work != nullptr ? workCount : 0), sliceBudget_(sliceBudget), work_(work), workContext_(workContext), clock_(clock), clockContext_(clockContext), next_(0), sliceCount_(0), measuredTime_(0), measuredCount_(0) {
+}
+
+uint64_t RegistrationScheduler::now() const {
+    if (clock_) {
+        return clock_(clockContext_);
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool RegistrationScheduler::runSlice() {
+    if (isFinished()) {
+        return true;
+    }
+    sliceCount_++;
+    uint64_t start = now();
+    uint64_t current = start;
+    bool first = true;
+    while (!isFinished()) {
+        if (!first) {
+            uint64_t elapsed = current - start;
+            uint64_t averageCost = measuredTime_ / measuredCount_;
+            if (elapsed >= sliceBudget_ || averageCost > sliceBudget_ - elapsed) {
+                break;
+            }
+        }
+        first = false;
+        size_t index = next_++;
+        work_(workContext_, index);
+        // Ignore a clock going backwards
+        uint64_t end = now();
+        if (end > current) {
+            measuredTime_ += end - current;
+            current = end;
+        }
+        measuredCount_++;
+    }
+    return isFinished();
+}
+
+size_t RegistrationScheduler::finish() {
+    size_t count = 0;
+    while (!isFinished()) {
+        size_t index = next_++;
+        work_(workContext_, index);
+        count++;
+    }
+    return count;
+}
+
+struct ZIKRegistrationScheduler {
+    RegistrationScheduler scheduler;
+
+    ZIKRegistrationScheduler(size_t workCount, uint64_t sliceBudget, ZIKRegistrationWorkFunction work, void *workContext, ZIKRegistrationClockFunction clock, void *clockContext)
+    : scheduler(workCount, sliceBudget, work, workContext, clock, clockContext) {}
+};
+
+ZIKRegistrationSchedulerRef ZIKRegistrationSchedulerCreate(size_t workCount, uint64_t sliceBudget, ZIKRegistrationWorkFunction work, void *workContext, ZIKRegistrationClockFunction clock, void *clockContext) {
+    return new ZIKRegistrationScheduler(workCount, sliceBudget, work, workContext, clock, clockContext);
+}
+
+bool ZIKRegistrationSchedulerRunSlice(ZIKRegistrationSchedulerRef scheduler) {
+    if (scheduler == nullptr) {
+        return true;
+    }
+    return scheduler->scheduler.runSlice();
+}
+
+size_t ZIKRegistrationSchedulerFinish(ZIKRegistrationSchedulerRef scheduler) {
+    if (scheduler == nullptr) {
+        return 0;
+    }
+    return scheduler->scheduler.finish();
+}
+
+size_t ZIKRegistrationSchedulerPendingCount(ZIKRegistrationSchedulerRef scheduler) {
+    if (scheduler == nullptr) {
+        return 0;
+    }
+    return scheduler->scheduler.pendingCount();
+}
+
+void ZIKRegistrationSchedulerDestroy(ZIKRegistrationSchedulerRef scheduler) {
+    delete scheduler;
+}
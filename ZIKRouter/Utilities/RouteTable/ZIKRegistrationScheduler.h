@@ -0,0 +1,106 @@
+//
+//  ZIKRegistrationScheduler.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKRegistrationScheduler_h
+#define ZIKRegistrationScheduler_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Monotonic time in nanoseconds.
+typedef uint64_t (*ZIKRegistrationClockFunction)(void *context);
+
+/// Do the work at the index, such as registering a router class.
+typedef void (*ZIKRegistrationWorkFunction)(void *context, size_t index);
+
+typedef struct ZIKRegistrationScheduler *ZIKRegistrationSchedulerRef;
+
+/**
+ Create a scheduler running work items in time-boxed slices.
+
+ @param workCount Count of work items.
+ @param sliceBudget Time budget of each slice in nanoseconds.
+ @param work Function doing the work item at an index.
+ @param workContext Context passed to work.
+ @param clock Clock function. Pass NULL to use the monotonic clock of system.
+ @param clockContext Context passed to clock.
+ */
+extern ZIKRegistrationSchedulerRef ZIKRegistrationSchedulerCreate(size_t workCount, uint64_t sliceBudget, ZIKRegistrationWorkFunction work, void *workContext, ZIKRegistrationClockFunction clock, void *clockContext);
+
+/// Run a slice of pending work items. Return whether all work items are done.
+extern bool ZIKRegistrationSchedulerRunSlice(ZIKRegistrationSchedulerRef scheduler);
+
+/// Run all pending work items now. Return count of work items run.
+extern size_t ZIKRegistrationSchedulerFinish(ZIKRegistrationSchedulerRef scheduler);
+
+extern size_t ZIKRegistrationSchedulerPendingCount(ZIKRegistrationSchedulerRef scheduler);
+
+extern void ZIKRegistrationSchedulerDestroy(ZIKRegistrationSchedulerRef scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+namespace zix {
+
+/**
+ Run work items in order, in slices limited by a time budget.
+
+ A slice always runs at least one item, so it makes progress even when an item costs more than the budget. Later items in the slice only run when the average cost of done items still fits in the remaining budget, so a slice rarely exceeds its budget.
+
+ Work items are claimed before running. So a work item can call finish(), such as when a router looks up another router not registered yet, and the remaining items run in the nested call. Not thread safe.
+ */
+class RegistrationScheduler {
+public:
+    RegistrationScheduler(size_t workCount, uint64_t sliceBudget, ZIKRegistrationWorkFunction work, void *workContext, ZIKRegistrationClockFunction clock = nullptr, void *clockContext = nullptr);
+
+    /// Run a slice. Return whether all work items are done.
+    bool runSlice();
+
+    /// Run all pending work items. Return count of work items run.
+    size_t finish();
+
+    bool isFinished() const { return next_ >= workCount_; }
+
+    size_t pendingCount() const { return workCount_ - next_; }
+
+    /// Count of slices run, not including finish().
+    size_t sliceCount() const { return sliceCount_; }
+
+private:
+    uint64_t now() const;
+
+    size_t workCount_;
+    uint64_t sliceBudget_;
+    ZIKRegistrationWorkFunction work_;
+    void *workContext_;
+    ZIKRegistrationClockFunction clock_;
+    void *clockContext_;
+    /// Index of the next work item to claim.
+    size_t next_;
+    size_t sliceCount_;
+    /// Time and count of work items run in slices, for estimating cost of next item.
+    uint64_t measuredTime_;
+    size_t measuredCount_;
+};
+
+} // namespace zix
+
+#endif
+
+#endif /* ZIKRegistrationScheduler_h */
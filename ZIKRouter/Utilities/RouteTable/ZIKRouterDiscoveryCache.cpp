@@ -0,0 +1,334 @@
+//
+//  ZIKRouterDiscoveryCache.cpp
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#include "ZIKRouterDiscoveryCache.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    /// FNV-1a of bytes after header.
+    uint32_t checksum;
+    uint32_t fileSize;
+    uint32_t imageCount;
+    uint32_t reserved[3];
+};
+
+struct ImageRecord {
+    uint8_t uuid[16];
+    uint32_t classCount;
+    /// Size of NUL terminated class names, without padding.
+    uint32_t namesSize;
+};
+
+static_assert(sizeof(CacheHeader) == 32, "Header size is part of the file format");
+static_assert(sizeof(ImageRecord) == 24, "Image record size is part of the file format");
+
+uint32_t fnv1a(const uint8_t *bytes, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+size_t alignedSize(size_t size) {
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+typedef std::array<uint8_t, 16> UUID;
+
+UUID makeUUID(const uint8_t uuid[16]) {
+    UUID result;
+    memcpy(result.data(), uuid, 16);
+    return result;
+}
+
+struct ImageClasses {
+    /// NUL terminated class names.
+    std::vector<char> names;
+    /// Pointers into names. Moving the vector of names doesn't change its buffer.
+    std::vector<const char *> classNames;
+
+    void setNames(const char *const *classNames, uint32_t count) {
+        names.clear();
+        for (uint32_t i = 0; i < count; i++) {
+            names.insert(names.end(), classNames[i], classNames[i] + strlen(classNames[i]) + 1);
+        }
+        updatePointers(count);
+    }
+
+    void updatePointers(uint32_t count) {
+        classNames.clear();
+        classNames.reserve(count);
+        size_t offset = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            classNames.push_back(names.data() + offset);
+            offset += strlen(names.data() + offset) + 1;
+        }
+    }
+};
+
+} // namespace
+
+struct ZIKRouterDiscoveryCache {
+    std::map<UUID, ImageClasses> images;
+
+    std::vector<uint8_t> serialize() const;
+};
+
+std::vector<uint8_t> ZIKRouterDiscoveryCache::serialize() const {
+    std::vector<uint8_t> bytes(sizeof(CacheHeader), 0);
+    for (std::map<UUID, ImageClasses>::const_iterator it = images.begin(); it != images.end(); ++it) {
+        ImageRecord record;
+        memcpy(record.uuid, it->first.data(), 16);
+        record.classCount = static_cast<uint32_t>(it->second.classNames.size());
+        record.namesSize = static_cast<uint32_t>(it->second.names.size());
+        const uint8_t *recordBytes = reinterpret_cast<const uint8_t *>(&record);
+        bytes.insert(bytes.end(), recordBytes, recordBytes + sizeof(record));
+        bytes.insert(bytes.end(), it->second.names.begin(), it->second.names.end());
+        bytes.resize(alignedSize(bytes.size()), 0);
+    }
+    CacheHeader header = {};
+    header.magic = ZIKRouterDiscoveryCacheMagic;
+    header.version = ZIKRouterDiscoveryCacheVersion;
+    header.fileSize = static_cast<uint32_t>(bytes.size());
+    header.imageCount = static_cast<uint32_t>(images.size());
+    header.checksum = fnv1a(bytes.data() + sizeof(CacheHeader), bytes.size() - sizeof(CacheHeader));
+    memcpy(bytes.data(), &header, sizeof(header));
+    return bytes;
+}
+
+static ZIKRouterDiscoveryCacheError parseCache(const uint8_t *bytes, size_t size, ZIKRouterDiscoveryCache &cache) {
+    if (size < sizeof(uint32_t)) {
+        return ZIKRouterDiscoveryCacheErrorTruncated;
+    }
+    CacheHeader header = {};
+    memcpy(&header.magic, bytes, sizeof(header.magic));
+    if (header.magic != ZIKRouterDiscoveryCacheMagic) {
+        return ZIKRouterDiscoveryCacheErrorBadMagic;
+    }
+    if (size < sizeof(CacheHeader)) {
+        return ZIKRouterDiscoveryCacheErrorTruncated;
+    }
+    memcpy(&header, bytes, sizeof(header));
+    if (header.version != ZIKRouterDiscoveryCacheVersion) {
+        return ZIKRouterDiscoveryCacheErrorVersionMismatch;
+    }
+    if (header.fileSize > size) {
+        return ZIKRouterDiscoveryCacheErrorTruncated;
+    }
+    if (header.fileSize < sizeof(CacheHeader) || header.fileSize != size) {
+        return ZIKRouterDiscoveryCacheErrorCorrupted;
+    }
+    if (fnv1a(bytes + sizeof(CacheHeader), size - sizeof(CacheHeader)) != header.checksum) {
+        return ZIKRouterDiscoveryCacheErrorCorrupted;
+    }
+    size_t offset = sizeof(CacheHeader);
+    for (uint32_t i = 0; i < header.imageCount; i++) {
+        if (size - offset < sizeof(ImageRecord)) {
+            return ZIKRouterDiscoveryCacheErrorCorrupted;
+        }
+        ImageRecord record;
+        memcpy(&record, bytes + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.namesSize > size - offset) {
+            return ZIKRouterDiscoveryCacheErrorCorrupted;
+        }
+        const char *names = reinterpret_cast<const char *>(bytes + offset);
+        // Names must be exactly classCount non-empty NUL terminated strings.
+        uint32_t nameCount = 0;
+        size_t nameStart = 0;
+        for (size_t j = 0; j < record.namesSize; j++) {
+            if (names[j] != '\0') {
+                continue;
+            }
+            if (j == nameStart) {
+                return ZIKRouterDiscoveryCacheErrorCorrupted;
+            }
+            nameCount++;
+            nameStart = j + 1;
+        }
+        if (nameCount != record.classCount || nameStart != record.namesSize) {
+            return ZIKRouterDiscoveryCacheErrorCorrupted;
+        }
+        UUID uuid = makeUUID(record.uuid);
+        if (cache.images.count(uuid) > 0) {
+            return ZIKRouterDiscoveryCacheErrorCorrupted;
+        }
+        ImageClasses &image = cache.images[uuid];
+        image.names.assign(names, names + record.namesSize);
+        image.updatePointers(record.classCount);
+        offset = alignedSize(offset + record.namesSize);
+        if (offset > size) {
+            return ZIKRouterDiscoveryCacheErrorCorrupted;
+        }
+    }
+    if (offset != size) {
+        return ZIKRouterDiscoveryCacheErrorCorrupted;
+    }
+    return ZIKRouterDiscoveryCacheErrorNone;
+}
+
+ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheCreate(void) {
+    return new ZIKRouterDiscoveryCache();
+}
+
+ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheCreateWithBytes(const void *bytes, size_t size, ZIKRouterDiscoveryCacheError *error) {
+    ZIKRouterDiscoveryCacheRef cache = new ZIKRouterDiscoveryCache();
+    ZIKRouterDiscoveryCacheError result = bytes ? parseCache(static_cast<const uint8_t *>(bytes), size, *cache) : ZIKRouterDiscoveryCacheErrorIO;
+    if (error) {
+        *error = result;
+    }
+    if (result != ZIKRouterDiscoveryCacheErrorNone) {
+        delete cache;
+        return NULL;
+    }
+    return cache;
+}
+
+ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheOpen(const char *path, ZIKRouterDiscoveryCacheError *error) {
+    if (error) {
+        *error = ZIKRouterDiscoveryCacheErrorIO;
+    }
+    if (path == NULL) {
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    // The cache is small, reading it is cheaper than mapping it.
+    std::vector<uint8_t> bytes(st.st_size > 0 ? static_cast<size_t>(st.st_size) : 0);
+    size_t length = 0;
+    while (length < bytes.size()) {
+        ssize_t result = read(fd, bytes.data() + length, bytes.size() - length);
+        if (result < 0) {
+            close(fd);
+            return NULL;
+        }
+        if (result == 0) {
+            break;
+        }
+        length += static_cast<size_t>(result);
+    }
+    close(fd);
+    return ZIKRouterDiscoveryCacheCreateWithBytes(bytes.data(), length, error);
+}
+
+void ZIKRouterDiscoveryCacheDestroy(ZIKRouterDiscoveryCacheRef cache) {
+    delete cache;
+}
+
+uint32_t ZIKRouterDiscoveryCacheImageCount(ZIKRouterDiscoveryCacheRef cache) {
+    return cache ? static_cast<uint32_t>(cache->images.size()) : 0;
+}
+
+bool ZIKRouterDiscoveryCacheLookup(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16], const char *const **classNames, uint32_t *count) {
+    if (cache == NULL || uuid == NULL) {
+        return false;
+    }
+    std::map<UUID, ImageClasses>::const_iterator it = cache->images.find(makeUUID(uuid));
+    if (it == cache->images.end()) {
+        return false;
+    }
+    if (classNames) {
+        *classNames = it->second.classNames.data();
+    }
+    if (count) {
+        *count = static_cast<uint32_t>(it->second.classNames.size());
+    }
+    return true;
+}
+
+void ZIKRouterDiscoveryCacheSetImage(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16], const char *const *classNames, uint32_t count) {
+    if (cache == NULL || uuid == NULL || (classNames == NULL && count > 0)) {
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        // Empty name can't be written
+        if (classNames[i] == NULL || classNames[i][0] == '\0') {
+            return;
+        }
+    }
+    cache->images[makeUUID(uuid)].setNames(classNames, count);
+}
+
+void ZIKRouterDiscoveryCacheRemoveImage(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16]) {
+    if (cache == NULL || uuid == NULL) {
+        return;
+    }
+    cache->images.erase(makeUUID(uuid));
+}
+
+void *ZIKRouterDiscoveryCacheCopyBytes(ZIKRouterDiscoveryCacheRef cache, size_t *size) {
+    if (cache == NULL) {
+        return NULL;
+    }
+    std::vector<uint8_t> bytes = cache->serialize();
+    void *buffer = malloc(bytes.size());
+    if (buffer == NULL) {
+        return NULL;
+    }
+    memcpy(buffer, bytes.data(), bytes.size());
+    if (size) {
+        *size = bytes.size();
+    }
+    return buffer;
+}
+
+bool ZIKRouterDiscoveryCacheWriteToFile(ZIKRouterDiscoveryCacheRef cache, const char *path) {
+    if (cache == NULL || path == NULL) {
+        return false;
+    }
+    std::vector<uint8_t> bytes = cache->serialize();
+    std::string tempPath = std::string(path) + ".tmp." + std::to_string(getpid());
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+        if (result <= 0) {
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    if (close(fd) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    if (rename(tempPath.c_str(), path) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,88 @@
+//
+//  ZIKRouterDiscoveryCache.h
+//  ZIKRouter
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  This source code is licensed under the MIT-style license found in the
+//  LICENSE file in the root directory of this source tree.
+//
+
+#ifndef ZIKRouterDiscoveryCache_h
+#define ZIKRouterDiscoveryCache_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ Router discovery cache stores names of router classes found in each image, keyed by LC_UUID of the image. Router classes in an image only change when the binary changes, so next launch can look up router classes by name, instead of scanning class list of the image.
+
+ File layout (host byte order):
+ - Header: magic, version, checksum of the body, file size and image count.
+ - Images sorted by uuid: uuid, class count, size of names, and NUL terminated class names padded to 4 bytes.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZIKRouterDiscoveryCacheMagic 0x434b495a // 'ZIKC'
+#define ZIKRouterDiscoveryCacheVersion 1
+
+typedef enum {
+    ZIKRouterDiscoveryCacheErrorNone = 0,
+    /// Failed to open, read or write the file.
+    ZIKRouterDiscoveryCacheErrorIO,
+    /// File is smaller than its header declares.
+    ZIKRouterDiscoveryCacheErrorTruncated,
+    /// Not a discovery cache, or written with a different byte order.
+    ZIKRouterDiscoveryCacheErrorBadMagic,
+    /// Written by another version of ZIKRouter.
+    ZIKRouterDiscoveryCacheErrorVersionMismatch,
+    /// Checksum mismatch or invalid records.
+    ZIKRouterDiscoveryCacheErrorCorrupted,
+} ZIKRouterDiscoveryCacheError;
+
+typedef struct ZIKRouterDiscoveryCache *ZIKRouterDiscoveryCacheRef;
+
+/// Create an empty cache.
+extern ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheCreate(void);
+
+/// Parse and validate a cache. Bytes are copied.
+extern ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheCreateWithBytes(const void *bytes, size_t size, ZIKRouterDiscoveryCacheError *error);
+
+/// Read and validate a cache file. Return NULL when failed.
+extern ZIKRouterDiscoveryCacheRef ZIKRouterDiscoveryCacheOpen(const char *path, ZIKRouterDiscoveryCacheError *error);
+
+extern void ZIKRouterDiscoveryCacheDestroy(ZIKRouterDiscoveryCacheRef cache);
+
+extern uint32_t ZIKRouterDiscoveryCacheImageCount(ZIKRouterDiscoveryCacheRef cache);
+
+/**
+ Find router class names of the image with uuid.
+
+ @param classNames Class names, valid until the image is changed or the cache is destroyed.
+ @param count Count of class names.
+ @return Whether the image is in the cache.
+ */
+extern bool ZIKRouterDiscoveryCacheLookup(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16], const char *const **classNames, uint32_t *count);
+
+/// Set router class names of the image with uuid, replacing old names.
+extern void ZIKRouterDiscoveryCacheSetImage(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16], const char *const *classNames, uint32_t count);
+
+/// Remove the image with uuid.
+extern void ZIKRouterDiscoveryCacheRemoveImage(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16]);
+
+/// Write to a temporary file then rename it to the path, so readers never see a partial file.
+extern bool ZIKRouterDiscoveryCacheWriteToFile(ZIKRouterDiscoveryCacheRef cache, const char *path);
+
+/// Serialize into a malloc buffer. Caller should free it.
+extern void *ZIKRouterDiscoveryCacheCopyBytes(ZIKRouterDiscoveryCacheRef cache, size_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZIKRouterDiscoveryCache_h */
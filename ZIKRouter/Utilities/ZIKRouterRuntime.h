@@ -53,6 +53,9 @@ FOUNDATION_EXTERN bool zix_replaceMethodWithMethodType(Class originalClass, SEL
 /// Enumerate all classes.
 FOUNDATION_EXTERN void zix_enumerateClassList(void(^handler)(Class aClass));
 
+/// Enumerate subclasses of the parent class in all classes. Verdicts of checked classes are recorded during enumeration, so common ancestors of classes are only checked once.
+FOUNDATION_EXTERN void zix_enumerateClassListForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
+
 /// Enumerate all protocols.
 FOUNDATION_EXTERN void zix_enumerateProtocolList(void(^handler)(Protocol *protocol));
 
@@ -78,7 +81,7 @@ FOUNDATION_EXTERN Protocol *_Nullable zix_objcProtocol(id protocol);
 FOUNDATION_EXTERN BOOL zix_canEnumerateClassesInImage(void);
 
 /**
- Enumerate all subclasses of the parent class in app read from section `__objc_classlist`. It's much faster than `objc_copyClassList` because it won't realize these subclasses.
+ Enumerate all subclasses of the parent class in app read from section `__objc_classlist`. It's much faster than `objc_copyClassList` because it won't realize these subclasses. Images not importing the parent class, or any class from images that may contain subclasses, are skipped without reading their class lists.
  @warning
  Those classes may not be realized yet. If you use OC runtime functions with the class that will access class_rw_t (such as `class_copyIvarList`), it will crash because class_rw_t is not initialized yet. You can try to trigger `realizeClass()` by method finding (such as `class_getMethodImplementation` or just perform some method).
 
@@ -87,4 +90,16 @@ FOUNDATION_EXTERN BOOL zix_canEnumerateClassesInImage(void);
  */
 FOUNDATION_EXTERN void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass));
 
+/// Same with zix_enumerateClassesInMainBundleForParentClass, but you can skip some images. Images are skipped when imageFilter returns false.
+FOUNDATION_EXTERN void zix_enumerateClassesInMainBundleForParentClassWithImageFilter(Class parentClass, bool(^_Nullable imageFilter)(const void *imageHeader, const char *imagePath), void(^handler)(__unsafe_unretained Class aClass));
+
+/**
+ Same with zix_enumerateClassesInMainBundleForParentClass, but subclasses are handled per image, in the order of images. Images can provide cached classes to skip scanning their class lists.
+
+ @param parentClass Parent class for enumeration
+ @param cachedClasses Return classes of the image to skip scanning it, or nil to scan it.
+ @param handler Handler subclasses in an image. Classes are not retained, because scanned classes may not be realized yet. `cached` is true when classes are returned by cachedClasses.
+ */
+FOUNDATION_EXTERN void zix_enumerateClassesInMainBundleImagesForParentClass(Class parentClass, NSArray<Class> *_Nullable(^_Nullable cachedClasses)(const void *imageHeader, const char *imagePath), void(^handler)(const void *imageHeader, const char *imagePath, __unsafe_unretained Class _Nonnull const *_Nullable classes, size_t count, bool cached));
+
 NS_ASSUME_NONNULL_END
@@ -137,6 +137,22 @@ void zix_enumerateClassList(void(^handler)(Class aClass)) {
     free(classes);
 }
 
+static const void *superclassOfClass(const void *aClass) {
+    return (__bridge const void *)class_getSuperclass((__bridge Class)aClass);
+}
+
+void zix_enumerateClassListForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    NSCParameterAssert(parentClass);
+    NSCParameterAssert(handler);
+    ZIKSubclassMemoRef memo = ZIKSubclassMemoCreate((__bridge const void *)parentClass, (size_t)objc_getClassList(NULL, 0), superclassOfClass);
+    zix_enumerateClassList(^(__unsafe_unretained Class aClass) {
+        if (ZIKSubclassMemoIsSubclass(memo, (__bridge const void *)aClass)) {
+            handler(aClass);
+        }
+    });
+    ZIKSubclassMemoDestroy(memo);
+}
+
 void zix_enumerateProtocolList(void(^handler)(Protocol *protocol)) {
     NSCParameterAssert(handler);
     unsigned int outCount;
@@ -335,6 +351,8 @@ class_ro_t *ro_of_class(class_t *cls) {
 
 #import <mach-o/getsect.h>
 #include <mach-o/dyld.h>
+#import "ZIKClassListScanner.h"
+#import "ZIKImageImportFilter.h"
 
 #ifndef __LP64__
 typedef struct mach_header mach_header_xx;
@@ -401,62 +419,102 @@ BOOL zix_canEnumerateClassesInImage() {
     return YES;
 }
 
-static void enumerateClassesInImage(const mach_header_xx *mh, void(^handler)(Class __unsafe_unretained aClass)) {
+static void applyConcurrently(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    dispatch_apply_f(iterations, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), context, work);
+}
+
+void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+    zix_enumerateClassesInMainBundleForParentClassWithImageFilter(parentClass, nil, handler);
+}
+
+void zix_enumerateClassesInMainBundleForParentClassWithImageFilter(Class parentClass, bool(^imageFilter)(const void *imageHeader, const char *imagePath), void(^handler)(__unsafe_unretained Class aClass)) {
     if (handler == nil) {
         return;
     }
-#ifndef __LP64__
-    const struct section *section = getsectbynamefromheader(mh, "__DATA", "__objc_classlist");
-    if (section == NULL) {
-        return;
-    }
-    uint32_t size = section->size;
-#else
-    const struct section_64 *section = getsectbynamefromheader_64(mh, "__DATA", "__objc_classlist");
-    if (section == NULL) {
-        return;
-    }
-    uint64_t size = section->size;
-#endif
-    char *imageBaseAddress = (char *)mh;
-    Class *classReferences = (Class *)(void *)(imageBaseAddress + ((uintptr_t)section->offset&0xffffffff));
-    for (unsigned long i = 0; i < size/sizeof(void *); i++) {
-        Class aClass = classReferences[i];
-        if (aClass) {
-            handler(aClass);
+    zix_enumerateClassesInMainBundleImagesForParentClass(parentClass, ^NSArray<Class> *(const void *imageHeader, const char *imagePath) {
+        if (imageFilter && !imageFilter(imageHeader, imagePath)) {
+            return @[];
         }
-    }
-}
-
-static bool classIsSubclassOfClass(class_t *cls, class_t *parentClass) {
-    if (cls == NULL || parentClass == NULL) {
-        return false;
-    }
-    const class_t *superclass = cls->superclass;
-    while (superclass) {
-        if (superclass == parentClass) {
-            return true;
+        return nil;
+    }, ^(const void *imageHeader, const char *imagePath, __unsafe_unretained Class const *classes, size_t count, bool cached) {
+        for (size_t i = 0; i < count; i++) {
+            handler(classes[i]);
         }
-        superclass = superclass->superclass;
-    }
-    return false;
+    });
 }
 
-void zix_enumerateClassesInMainBundleForParentClass(Class parentClass, void(^handler)(__unsafe_unretained Class aClass)) {
+void zix_enumerateClassesInMainBundleImagesForParentClass(Class parentClass, NSArray<Class> *(^cachedClasses)(const void *imageHeader, const char *imagePath), void(^handler)(const void *imageHeader, const char *imagePath, __unsafe_unretained Class const *classes, size_t count, bool cached)) {
     if (handler == nil) {
         return;
     }
-    struct class_t *parent = (__bridge struct class_t *)(parentClass);
+    NSMutableData *headers = [NSMutableData data];
+    NSMutableArray<NSString *> *paths = [NSMutableArray array];
+    // Classes of each image, or NSNull when the image should be scanned
+    NSMutableArray *imageClasses = [NSMutableArray array];
+    NSMutableData *scannedHeaders = [NSMutableData data];
     enumerateImages(^(const mach_header_xx *mh, const char *path) {
         if (strstr(path, "/System/Library/") != NULL ||
             strstr(path, "/usr/") != NULL ||
             strstr(path, ".dylib") != NULL) {
             return;
         }
-        enumerateClassesInImage(mh, ^(__unsafe_unretained Class aClass) {
-            if (classIsSubclassOfClass((__bridge class_t *)(aClass), parent)) {
-                handler(aClass);
-            }
-        });
+        NSArray<Class> *classes = cachedClasses ? cachedClasses(mh, path) : nil;
+        if (classes == nil) {
+            [scannedHeaders appendBytes:&mh length:sizeof(mh)];
+        }
+        [headers appendBytes:&mh length:sizeof(mh)];
+        [paths addObject:@(path)];
+        [imageClasses addObject:classes ?: [NSNull null]];
     });
+    // Skip images not importing any class that may be a subclass, before reading their class lists
+    size_t scannedCount = scannedHeaders.length / sizeof(void *);
+    bool *candidates = calloc(scannedCount + 1, sizeof(bool));
+    Dl_info info;
+    const void *definingHeader = dladdr((__bridge const void *)parentClass, &info) ? info.dli_fbase : NULL;
+    const char *rootClassName = class_getName(parentClass);
+    NSMutableData *candidateHeaders = [NSMutableData data];
+    if (candidates) {
+        ZIKImageImportFilterFindCandidates((const void *const *)scannedHeaders.bytes, scannedCount, definingHeader, &rootClassName, 1, candidates);
+        for (size_t i = 0; i < scannedCount; i++) {
+            if (candidates[i]) {
+                [candidateHeaders appendBytes:(const void *const *)scannedHeaders.bytes + i length:sizeof(void *)];
+            }
+        }
+    }
+    // Scan class lists concurrently, then call handler serially in image order
+    size_t candidateCount = candidateHeaders.length / sizeof(void *);
+    size_t *imageClassCounts = calloc(candidateCount + 1, sizeof(size_t));
+    size_t count = 0;
+    const void **classes = ZIKClassListCopySubclasses((const void *const *)candidateHeaders.bytes, candidateCount, (__bridge const void *)parentClass, applyConcurrently, imageClassCounts, &count);
+    if (candidates == NULL || classes == NULL || imageClassCounts == NULL) {
+        free(candidates);
+        free((void *)classes);
+        free(imageClassCounts);
+        return;
+    }
+    const void *const *imageHeaders = headers.bytes;
+    size_t scannedIndex = 0;
+    size_t candidateIndex = 0;
+    size_t classIndex = 0;
+    for (NSUInteger i = 0; i < imageClasses.count; i++) {
+        id cached = imageClasses[i];
+        if (cached != [NSNull null]) {
+            NSArray<Class> *cachedImageClasses = cached;
+            __unsafe_unretained Class *buffer = (__unsafe_unretained Class *)calloc(cachedImageClasses.count + 1, sizeof(Class));
+            [cachedImageClasses getObjects:buffer range:NSMakeRange(0, cachedImageClasses.count)];
+            handler(imageHeaders[i], paths[i].UTF8String, buffer, cachedImageClasses.count, true);
+            free(buffer);
+            continue;
+        }
+        if (!candidates[scannedIndex++]) {
+            handler(imageHeaders[i], paths[i].UTF8String, NULL, 0, false);
+            continue;
+        }
+        size_t imageClassCount = imageClassCounts[candidateIndex++];
+        handler(imageHeaders[i], paths[i].UTF8String, (__unsafe_unretained Class *)(void *)(classes + classIndex), imageClassCount, false);
+        classIndex += imageClassCount;
+    }
+    free(candidates);
+    free((void *)classes);
+    free(imageClassCounts);
 }
@@ -32,6 +32,8 @@ NS_ASSUME_NONNULL_BEGIN
  _swift_typeIsTargetType(SwiftEnum.self, SwiftEnumProtocol.self)
  @endcode
  
+ Results are cached by the pair of types, so checking registered types again in validations is only a lookup. The cache is cleared when new images are loaded.
+ 
  @since Swift 3.2
  
  @param sourceType Any type of swift class, objc class, swift struct, swift enum, swift function, swift tuple, objc protocol, swift protocol.
@@ -40,6 +42,9 @@ NS_ASSUME_NONNULL_BEGIN
  */
 FOUNDATION_EXTERN bool _swift_typeIsTargetType(id sourceType, id targetType);
 
+/// Remove results cached by `_swift_typeIsTargetType`. Call it after adding protocols to classes at runtime. Only available in DEBUG mode.
+FOUNDATION_EXTERN void zix_removeCachedTypeMatches(void);
+
 /**
  Enumerate symbols in images from app's bundle. Only available in DEBUG mode.
  @discussion
@@ -47,10 +52,66 @@ FOUNDATION_EXTERN bool _swift_typeIsTargetType(id sourceType, id targetType);
  @warning
  It uses private API in libswiftCore.dylib, and these code won't be compiled in release mode.
  
+ The handler is called on the current thread, in the order of images.
+ 
  @param handler  Handler for each mangled symbol name, return false to stop. `demangledAsSwift` is for demangling a mangled swift symbol, when `simplified` is true, the demangled symbol will strip module name, extension name and `where` clauses in the swift symbol.
  */
 FOUNDATION_EXTERN void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified)));
 
+/**
+ Enumerate symbols containing the substring in images from app's bundle. Only available in DEBUG mode.
+ @discussion
+ Same as `zix_enumerateSymbolName`, but the substring is searched in string tables of the images, and only symbols of matched strings are read. Matched names of an image are demangled before they are passed to the handler, so `demangledAsSwift(name, false)` in the handler is only a lookup.
+ 
+ @param substring Substring of mangled symbol names, such as "RoutableService".
+ @param handler Handler for each mangled symbol name containing the substring, return false to stop.
+ */
+FOUNDATION_EXTERN void zix_enumerateSymbolNameContaining(const char *substring, bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified)));
+
+/// Kinds of swift symbols, read from operators at the end of mangled names without demangling.
+typedef NS_OPTIONS(uint32_t, ZIKSwiftSymbolKind) {
+    /// Unknown operators, symbols in legacy mangling before Swift 4, and symbols not listed below.
+    ZIKSwiftSymbolKindOther                         = 1 << 0,
+    ZIKSwiftSymbolKindFunction                      = 1 << 1,
+    ZIKSwiftSymbolKindInitializer                   = 1 << 2,
+    /// Getter, setter and other accessors of variables and subscripts.
+    ZIKSwiftSymbolKindAccessor                      = 1 << 3,
+    ZIKSwiftSymbolKindClosure                       = 1 << 4,
+    ZIKSwiftSymbolKindTypeMetadata                  = 1 << 5,
+    ZIKSwiftSymbolKindTypeMetadataAccessor          = 1 << 6,
+    /// Demangling cache variable of type metadata.
+    ZIKSwiftSymbolKindTypeMetadataCache             = 1 << 7,
+    ZIKSwiftSymbolKindNominalTypeDescriptor         = 1 << 8,
+    ZIKSwiftSymbolKindProtocolDescriptor            = 1 << 9,
+    ZIKSwiftSymbolKindProtocolConformanceDescriptor = 1 << 10,
+    ZIKSwiftSymbolKindProtocolWitnessTable          = 1 << 11,
+    /// Thunks, method descriptors and merged functions.
+    ZIKSwiftSymbolKindThunk                         = 1 << 12,
+    ZIKSwiftSymbolKindSpecialization                = 1 << 13,
+    ZIKSwiftSymbolKindAll                           = (1 << 14) - 1,
+};
+
+/**
+ Enumerate swift symbols of some kinds in images from app's bundle. Only available in DEBUG mode.
+ @discussion
+ Same as `zix_enumerateSymbolNameContaining`, but names are classified by their mangling prefix, operators at the end and the module, before demangling them. Only swift symbols of the kinds whose outermost entity is in the module are demangled and passed to the handler, so C, Objective-C and other swift symbols are never demangled. Names whose module can't be read without demangling are passed to the handler.
+ 
+ @param substring Substring of mangled symbol names, such as "RoutableService". NULL for all names.
+ @param module Module of the outermost entity, such as "ZRouter" for `ZRouter.RoutableService<T>` and its extensions. NULL for all modules.
+ @param kinds Kinds of symbols to enumerate.
+ @param handler Handler for each mangled symbol name, return false to stop.
+ */
+FOUNDATION_EXTERN void zix_enumerateSwiftSymbolNameContaining(const char *_Nullable substring, const char *_Nullable module, ZIKSwiftSymbolKind kinds, bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified)));
+
+/**
+ Entries in the routable manifest generated by `zikrouter-manifest` from Tools/ZIKRoutableManifest. Only available in DEBUG mode.
+ @discussion
+ The manifest is read from the path in environment variable `ZIKROUTER_ROUTABLE_MANIFEST`, or `ZIKRoutableManifest.json` in main bundle. It's only used when it's complete, and all images loaded from app's bundle have their uuid in the manifest, so a manifest generated from old binaries is ignored.
+
+ @return Dictionaries with keys "kind", "routable", "protocol", "module", "signature", "image", "symbol" and "address". Nil when there is no valid manifest, then routes should be validated by enumerating symbols.
+ */
+FOUNDATION_EXTERN NSArray<NSDictionary<NSString *, NSString *> *> *_Nullable zix_routableManifestEntries(void);
+
 FOUNDATION_EXTERN bool zix_hasDynamicLibrary(NSString *libName);
 
 /// Generate code for importing routers when manually registering routers.
@@ -17,6 +17,12 @@
 #import "ZIKImageSymbol.h"
 #import <objc/runtime.h>
 #import "NSString+Demangle.h"
+#import "ZIKSymbolEnumerator.h"
+#import "ZIKMangledNameClassifier.h"
+#import "ZIKTypeMatchCache.h"
+#import "ZIKMachOImage.h"
+#include <mach-o/dyld.h>
+#include <stdatomic.h>
 
 @interface NSString (ZIXContainsString)
 - (BOOL)zix_containsString:(NSString *)str;
@@ -168,13 +174,30 @@ typedef struct {
     TargetMetadata *metadata;
 } SwiftValueHeader;
 
-static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, TargetMetadata *targetType) {
-    static TargetMetadata*(*_swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *) = NULL;
+typedef struct {
+    TargetMetadata*(*swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *);
+    uintptr_t(*swift_conformsToProtocol)(TargetMetadata *, uintptr_t);
+    TargetMetadata*(*swift_getObjCClassMetadata)(void *);
+} SwiftRuntimeFunctions;
+
+///Functions in libswiftCore.dylib, found together with one search
+static const SwiftRuntimeFunctions *swiftRuntimeFunctions(void) {
+    static SwiftRuntimeFunctions functions;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
+        const char *names[] = {"_swift_dynamicCastMetatype", "_swift_conformsToProtocol", "_swift_getObjCClassMetadata"};
+        void *values[3] = {NULL, NULL, NULL};
         ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-        _swift_dynamicCastMetatype = (TargetMetadata*(*)(TargetMetadata *, TargetMetadata *))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_dynamicCastMetatype"];
+        [ZIKImageSymbol findSymbolsInImage:libswiftCoreImage names:names count:3 values:values];
+        functions.swift_dynamicCastMetatype = (TargetMetadata*(*)(TargetMetadata *, TargetMetadata *))values[0];
+        functions.swift_conformsToProtocol = (uintptr_t(*)(TargetMetadata *, uintptr_t))values[1];
+        functions.swift_getObjCClassMetadata = (TargetMetadata*(*)(void *))values[2];
     });
+    return &functions;
+}
+
+static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, TargetMetadata *targetType) {
+    TargetMetadata*(*_swift_dynamicCastMetatype)(TargetMetadata *, TargetMetadata *) = swiftRuntimeFunctions()->swift_dynamicCastMetatype;
     if (!_swift_dynamicCastMetatype) {
         return NULL;
     }
@@ -182,12 +205,7 @@ static TargetMetadata *swift_dynamicCastMetatype(TargetMetadata *sourceType, Tar
 }
 
 static bool swift_conformsToProtocols(bool isSourceClassPointer, TargetMetadata *type, ExistentialTypeMetadata *existentialType) {
-    static uintptr_t(*_swift_conformsToProtocol)(TargetMetadata *, uintptr_t) = NULL;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-        _swift_conformsToProtocol = (uintptr_t(*)(TargetMetadata *, uintptr_t))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_conformsToProtocol"];
-    });
+    uintptr_t(*_swift_conformsToProtocol)(TargetMetadata *, uintptr_t) = swiftRuntimeFunctions()->swift_conformsToProtocol;
     if (_swift_conformsToProtocol == NULL) {
         return false;
     }
@@ -383,6 +401,48 @@ static bool swift_conformsToProtocols(bool isSourceClassPointer, TargetMetadata
     return true;
 }
 
+typedef struct {
+    Class swiftObject;
+    Class swiftObjectSwift5;
+    Class swiftValue;
+    Class swiftValueSwift5;
+    Class protocol;
+    SEL swiftValueSelector;
+    SEL swiftTypeMetadataSelector;
+} SwiftBridgingClasses;
+
+///Classes of bridged swift types, they're the same in the process
+static const SwiftBridgingClasses *swiftBridgingClasses(void) {
+    static SwiftBridgingClasses classes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        classes.swiftObject = NSClassFromString(@"SwiftObject");
+        classes.swiftObjectSwift5 = NSClassFromString(@"Swift._SwiftObject");
+        classes.swiftValue = NSClassFromString(@"_SwiftValue");
+        classes.swiftValueSwift5 = NSClassFromString(@"__SwiftValue");
+        classes.protocol = NSClassFromString(@"Protocol");
+        classes.swiftValueSelector = NSSelectorFromString(@"_swiftValue");
+        classes.swiftTypeMetadataSelector = NSSelectorFromString(@"_swiftTypeMetadata");
+    });
+    return &classes;
+}
+
+///Results of `_swift_typeIsTargetType`
+static ZIKTypeMatchCacheRef sharedTypeMatchCache(void) {
+    static ZIKTypeMatchCacheRef cache;
+    static atomic_uint imageCount;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = ZIKTypeMatchCacheCreate();
+    });
+    //Images loaded later may add protocol conformances to checked types
+    uint32_t count = _dyld_image_count();
+    if (atomic_exchange(&imageCount, count) != count) {
+        ZIKTypeMatchCacheRemoveAll(cache);
+    }
+    return cache;
+}
+
 static BOOL object_is_class(id obj) {
     if ([obj class] == obj) {
         return YES;
@@ -393,33 +453,34 @@ static BOOL object_is_class(id obj) {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
 
-bool _swift_typeIsTargetType(id sourceType, id targetType) {
+static bool typeIsTargetType(id sourceType, id targetType) {
+    const SwiftBridgingClasses *classes = swiftBridgingClasses();
     //swift class or swift object
-    BOOL isSourceSwiftObjectType = [sourceType isKindOfClass:NSClassFromString(@"SwiftObject")] || [sourceType isKindOfClass:NSClassFromString(@"Swift._SwiftObject")];
-    BOOL isTargetSwiftObjectType = [targetType isKindOfClass:NSClassFromString(@"SwiftObject")] || [targetType isKindOfClass:NSClassFromString(@"Swift._SwiftObject")];
+    BOOL isSourceSwiftObjectType = [sourceType isKindOfClass:classes->swiftObject] || [sourceType isKindOfClass:classes->swiftObjectSwift5];
+    BOOL isTargetSwiftObjectType = [targetType isKindOfClass:classes->swiftObject] || [targetType isKindOfClass:classes->swiftObjectSwift5];
     //swift struct or swift enum or swift protocol
-    BOOL isSourceSwiftValueType = [sourceType isKindOfClass:NSClassFromString(@"_SwiftValue")] || [sourceType isKindOfClass:NSClassFromString(@"__SwiftValue")];
-    BOOL isTargetSwiftValueType = [targetType isKindOfClass:NSClassFromString(@"_SwiftValue")] || [targetType isKindOfClass:NSClassFromString(@"__SwiftValue")];
+    BOOL isSourceSwiftValueType = [sourceType isKindOfClass:classes->swiftValue] || [sourceType isKindOfClass:classes->swiftValueSwift5];
+    BOOL isTargetSwiftValueType = [targetType isKindOfClass:classes->swiftValue] || [targetType isKindOfClass:classes->swiftValueSwift5];
     BOOL isSourceSwiftType = isSourceSwiftObjectType || isSourceSwiftValueType;
     BOOL isTargetSwiftType = isTargetSwiftObjectType || isTargetSwiftValueType;
     
     if (isSourceSwiftValueType && isTargetSwiftValueType == NO) {
         return false;
     }
-    if ([sourceType isKindOfClass:NSClassFromString(@"Protocol")]) {
+    if ([sourceType isKindOfClass:classes->protocol]) {
         if (isTargetSwiftType) {
             return false;
         }
-        if ([targetType isKindOfClass:NSClassFromString(@"Protocol")]) {
+        if ([targetType isKindOfClass:classes->protocol]) {
             return protocol_conformsToProtocol(sourceType, targetType);
         } else {
-            if (targetType == NSClassFromString(@"Protocol")) {
+            if (targetType == classes->protocol) {
                 return true;
             }
             return false;
         }
     }
-    if ([targetType isKindOfClass:NSClassFromString(@"Protocol")]) {
+    if ([targetType isKindOfClass:classes->protocol]) {
         if (object_is_class(sourceType)) {
             return [sourceType conformsToProtocol:targetType];
         }
@@ -496,12 +557,7 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
             //For pure objc class, can't check conformance with swift_conformsToProtocols, need to use swift type metadata of this class as sourceTypeMetadata, or just search protocol witness table for this class
             if (object_is_class(sourceType) && isSourceSwiftObjectType == NO &&
                 [[NSStringFromClass(sourceType) demangledAsSwift] zix_containsString:@"."] == NO) {
-                static TargetMetadata *(*swift_getObjCClassMetadata)(void*);
-                static dispatch_once_t onceToken;
-                dispatch_once(&onceToken, ^{
-                    ZIKImageRef libswiftCoreImage = [ZIKImageSymbol imageByName:"libswiftCore.dylib"];
-                    swift_getObjCClassMetadata = (TargetMetadata*(*)(void*))[ZIKImageSymbol findSymbolInImage:libswiftCoreImage name:"_swift_getObjCClassMetadata"];
-                });
+                TargetMetadata *(*swift_getObjCClassMetadata)(void*) = swiftRuntimeFunctions()->swift_getObjCClassMetadata;
                 if (swift_getObjCClassMetadata) {
                     // type is MetadataKindObjCClassWrapper
                     sourceTypeMetadata = swift_getObjCClassMetadata((__bridge void *)(sourceType));
@@ -511,7 +567,7 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
         }
     } else {
         //objc protocol
-        if ([targetType isKindOfClass:NSClassFromString(@"Protocol")] == NO) {
+        if ([targetType isKindOfClass:classes->protocol] == NO) {
             return false;
         }
         targetTypeMetadata = (__bridge TargetMetadata *)targetType;
@@ -522,52 +578,267 @@ bool _swift_typeIsTargetType(id sourceType, id targetType) {
     return result;
 }
 
+///Pointer identifying a type in the cache, or NULL when it's not a type. Swift types are boxed in a new value for each call, so use their type metadata, tagged in the lowest bit because they're checked differently from classes.
+static const void *typeMatchKey(id type, const SwiftBridgingClasses *classes) {
+    if ([type isKindOfClass:classes->swiftValue] || [type isKindOfClass:classes->swiftValueSwift5]) {
+        if (![type respondsToSelector:classes->swiftValueSelector] || ![type respondsToSelector:classes->swiftTypeMetadataSelector]) {
+            return NULL;
+        }
+        TargetMetadata *metadata = (__bridge TargetMetadata *)[type performSelector:classes->swiftTypeMetadataSelector];
+        if (metadata == NULL) {
+            return NULL;
+        }
+        MetadataKind kind = metadata->Kind;
+        //Swift struct or enum instance, not a type
+        if (kind != MetadataKindMetatype && kind != MetadataKindExistentialMetatype && kind != MetadataKindMetatype_old && kind != MetadataKindExistentialMetatype_old) {
+            return NULL;
+        }
+        SwiftValueHeader *opaqueValue = (__bridge SwiftValueHeader *)[type performSelector:classes->swiftValueSelector];
+        return (const void *)((uintptr_t)opaqueValue->metadata | 1);
+    }
+    if (type != nil && (object_is_class(type) || [type isKindOfClass:classes->protocol])) {
+        return (__bridge const void *)type;
+    }
+    return NULL;
+}
+
+bool _swift_typeIsTargetType(id sourceType, id targetType) {
+    const SwiftBridgingClasses *classes = swiftBridgingClasses();
+    const void *sourceKey = typeMatchKey(sourceType, classes);
+    const void *targetKey = typeMatchKey(targetType, classes);
+    if (sourceKey == NULL || targetKey == NULL) {
+        return typeIsTargetType(sourceType, targetType);
+    }
+    ZIKTypeMatchCacheRef cache = sharedTypeMatchCache();
+    bool result;
+    if (ZIKTypeMatchCacheGet(cache, sourceKey, targetKey, &result)) {
+        return result;
+    }
+    result = typeIsTargetType(sourceType, targetType);
+    ZIKTypeMatchCacheSet(cache, sourceKey, targetKey, result);
+    return result;
+}
+
 #pragma clang diagnostic pop
 
+void zix_removeCachedTypeMatches(void) {
+    ZIKTypeMatchCacheRemoveAll(sharedTypeMatchCache());
+}
+
 bool zix_hasDynamicLibrary(NSString *libName) {
     const void *image = [ZIKImageSymbol imageByName:libName.UTF8String];
     return image != NULL;
 }
 
-void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified))) {
+static NSString *demangledSymbolName(const char *mangledName, bool simplified) {
+    NSString *name = nil;
+    if (mangledName == NULL) {
+        return name;
+    }
+    name = [NSString stringWithUTF8String:mangledName];
+    if ([name hasPrefix:@"_"]) {
+        name = [name substringFromIndex:1];
+    }
+    if (ZIKClassifyMangledName(mangledName, NULL) == false) {
+        //C and Objective-C symbols can't be demangled
+        return name;
+    }
+    NSString *demangled;
+    if (simplified) {
+        demangled = [name demangledAsSimplifiedSwift];
+    } else {
+        demangled = [name demangledAsSwift];
+    }
+    if (demangled) {
+        return demangled;
+    }
+    return name;
+}
+
+typedef struct {
+    //Demangled names of each image, keyed by address of the mangled name. Each dictionary is filled by the filter before its image is delivered
+    __unsafe_unretained NSArray<NSMutableDictionary<NSValue *, NSString *> *> *demangledNames;
+    //Image being delivered
+    size_t currentImage;
+    __unsafe_unretained bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified));
+    __unsafe_unretained NSString *(^demangledAsSwift)(const char *mangledName, bool simplified);
+    //Kinds of swift symbols to keep, 0 to keep all names
+    uint32_t kinds;
+    const char *module;
+} ZIXSymbolEnumeration;
+
+_Static_assert((uint32_t)ZIKSwiftSymbolKindInitializer == ZIKMangledNameKindInitializer &&
+               (uint32_t)ZIKSwiftSymbolKindTypeMetadataAccessor == ZIKMangledNameKindTypeMetadataAccessor &&
+               (uint32_t)ZIKSwiftSymbolKindSpecialization == ZIKMangledNameKindSpecialization &&
+               (uint32_t)ZIKSwiftSymbolKindAll == ZIKMangledNameKindAll, "ZIKSwiftSymbolKind must be the same as ZIKMangledNameKind");
+
+static bool filterSymbolName(void *context, size_t imageIndex, const char *name) {
+    //Names are already matched with the substring
+    ZIXSymbolEnumeration *enumeration = (ZIXSymbolEnumeration *)context;
+    if (enumeration->kinds != 0 && ZIKMangledNameIsCandidate(name, enumeration->kinds, enumeration->module) == false) {
+        //Don't demangle symbols of other kinds or modules
+        return false;
+    }
+    @autoreleasepool {
+        NSString *demangled = demangledSymbolName(name, false);
+        if (demangled) {
+            enumeration->demangledNames[imageIndex][[NSValue valueWithPointer:name]] = demangled;
+        }
+    }
+    return true;
+}
+
+static bool handleSymbolName(void *context, size_t imageIndex, const char *name) {
+    ZIXSymbolEnumeration *enumeration = (ZIXSymbolEnumeration *)context;
+    if (enumeration->demangledNames && imageIndex != enumeration->currentImage) {
+        //The previous image is delivered, release its names
+        [enumeration->demangledNames[enumeration->currentImage] removeAllObjects];
+    }
+    enumeration->currentImage = imageIndex;
+    @autoreleasepool {
+        return enumeration->handler(name, enumeration->demangledAsSwift);
+    }
+}
+
+static void enumerateSymbolName(const char *substring, const char *module, uint32_t kinds, bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified))) {
     if (handler == nil) {
         return;
     }
-    NSString *(^demangledAsSwift)(const char *, bool) = ^(const char *mangledName, bool simplified) {
-        NSString *name = nil;
-        if (mangledName == NULL) {
-            return name;
+    uint32_t imageCount = _dyld_image_count();
+    const void **headers = malloc(MAX(imageCount, 1) * sizeof(void *));
+    if (headers == NULL) {
+        return;
+    }
+    __block size_t count = 0;
+    [ZIKImageSymbol enumerateImages:^BOOL(ZIKImageRef  _Nonnull image, NSString * _Nonnull path) {
+        if ([path zix_containsString:@"/System/Library/"] == YES ||
+            [path zix_containsString:@"/usr/"] == YES ||
+            ([path zix_containsString:@"libswift"] && [path zix_containsString:@".dylib"])) {
+            return YES;
         }
-        name = [NSString stringWithUTF8String:mangledName];
-        if ([name hasPrefix:@"_"]) {
-            name = [name substringFromIndex:1];
+        if (count < imageCount) {
+            headers[count++] = image;
         }
-        NSString *demangled;
-        if (simplified) {
-            demangled = [name demangledAsSimplifiedSwift];
-        } else {
-            demangled = [name demangledAsSwift];
+        return YES;
+    }];
+    
+    //Names kept by the filter are demangled before the handler is called
+    bool filters = substring != NULL || kinds != 0;
+    NSMutableArray<NSMutableDictionary<NSValue *, NSString *> *> *demangledNames = nil;
+    if (filters) {
+        demangledNames = [NSMutableArray arrayWithCapacity:count];
+        for (size_t i = 0; i < count; i++) {
+            [demangledNames addObject:[NSMutableDictionary dictionary]];
         }
-        if (demangled) {
-            return demangled;
+    }
+    ZIXSymbolEnumeration enumeration = {demangledNames, 0, handler, nil, kinds, module};
+    ZIXSymbolEnumeration *enumerationRef = &enumeration;
+    NSString *(^demangledAsSwift)(const char *, bool) = ^(const char *mangledName, bool simplified) {
+        if (mangledName && !simplified && enumerationRef->demangledNames) {
+            NSString *demangled = enumerationRef->demangledNames[enumerationRef->currentImage][[NSValue valueWithPointer:mangledName]];
+            if (demangled) {
+                return demangled;
+            }
         }
-        return name;
+        return demangledSymbolName(mangledName, simplified);
     };
-    
-    [ZIKImageSymbol enumerateImages:^BOOL(ZIKImageRef  _Nonnull image, NSString * _Nonnull path) {
-        if ([path zix_containsString:@"/System/Library/"] == YES ||
-            [path zix_containsString:@"/usr/"] == YES ||
-            ([path zix_containsString:@"libswift"] && [path zix_containsString:@".dylib"])) {
+    enumeration.demangledAsSwift = demangledAsSwift;
+    //Images are scanned serially: the handler must run on the current thread, and parallel scanning measured slower than serial scanning
+    if (substring) {
+        ZIKEnumerateMatchedSymbolNamesInLoadedImages(headers, count, NULL, &substring, 1, ZIKSymbolNameMatchSubstring, &enumeration, filterSymbolName, handleSymbolName);
+    } else {
+        ZIKEnumerateSymbolNamesInLoadedImages(headers, count, NULL, &enumeration, filters ? filterSymbolName : NULL, handleSymbolName);
+    }
+    free(headers);
+}
+
+void zix_enumerateSymbolName(bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified))) {
+    enumerateSymbolName(NULL, NULL, 0, handler);
+}
+
+void zix_enumerateSymbolNameContaining(const char *substring, bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified))) {
+    NSCParameterAssert(substring);
+    if (substring == NULL) {
+        return;
+    }
+    enumerateSymbolName(substring, NULL, 0, handler);
+}
+
+void zix_enumerateSwiftSymbolNameContaining(const char *substring, const char *module, ZIKSwiftSymbolKind kinds, bool(^handler)(const char *name, NSString *(^demangledAsSwift)(const char *mangledName, bool simplified))) {
+    if ((kinds & ZIKSwiftSymbolKindAll) == 0) {
+        return;
+    }
+    enumerateSymbolName(substring, module, kinds & ZIKSwiftSymbolKindAll, handler);
+}
+
+static NSArray<NSDictionary<NSString *, NSString *> *> *loadRoutableManifestEntries(void) {
+    NSString *path = [[NSProcessInfo processInfo] environment][@"ZIKROUTER_ROUTABLE_MANIFEST"];
+    if (path.length == 0) {
+        path = [[NSBundle mainBundle] pathForResource:@"ZIKRoutableManifest" ofType:@"json"];
+    }
+    if (path == nil) {
+        return nil;
+    }
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if (data == nil) {
+        return nil;
+    }
+    NSDictionary *manifest = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    if ([manifest isKindOfClass:[NSDictionary class]] == NO ||
+        [manifest[@"version"] isEqual:@1] == NO ||
+        [manifest[@"complete"] isEqual:@YES] == NO) {
+        NSLog(@"ZIKRouter: ignore invalid or incomplete routable manifest at %@", path);
+        return nil;
+    }
+    NSArray *images = manifest[@"images"];
+    NSArray *entries = manifest[@"entries"];
+    if ([images isKindOfClass:[NSArray class]] == NO || [entries isKindOfClass:[NSArray class]] == NO) {
+        return nil;
+    }
+    NSMutableSet<NSString *> *uuids = [NSMutableSet set];
+    for (NSDictionary *image in images) {
+        if ([image isKindOfClass:[NSDictionary class]] && [image[@"uuid"] isKindOfClass:[NSString class]]) {
+            [uuids addObject:image[@"uuid"]];
+        }
+    }
+    //The manifest must be generated from binaries currently loaded from app's bundle
+    NSString *bundlePath = [[NSBundle mainBundle] bundlePath];
+    __block NSString *staleImage = nil;
+    [ZIKImageSymbol enumerateImages:^BOOL(ZIKImageRef  _Nonnull image, NSString * _Nonnull imagePath) {
+        if ([imagePath hasPrefix:bundlePath] == NO) {
             return YES;
         }
-        void *value = [ZIKImageSymbol findSymbolInImage:image matching:^BOOL(const char * _Nonnull symbolName) {
-            return !handler(symbolName, demangledAsSwift);
-        }];
-        if (value != NULL) {
+        uint8_t uuid[16];
+        if (ZIKMachOImageCopyUUID(image, uuid) == false) {
+            return YES;
+        }
+        NSString *uuidString = [[[NSUUID alloc] initWithUUIDBytes:uuid] UUIDString];
+        if ([uuids containsObject:uuidString] == NO) {
+            staleImage = imagePath;
             return NO;
         }
         return YES;
     }];
+    if (staleImage) {
+        NSLog(@"ZIKRouter: ignore routable manifest at %@, it's not generated from %@", path, staleImage);
+        return nil;
+    }
+    NSMutableArray<NSDictionary<NSString *, NSString *> *> *validEntries = [NSMutableArray arrayWithCapacity:entries.count];
+    for (NSDictionary *entry in entries) {
+        if ([entry isKindOfClass:[NSDictionary class]] && [entry[@"kind"] isKindOfClass:[NSString class]]) {
+            [validEntries addObject:entry];
+        }
+    }
+    return validEntries;
+}
+
+NSArray<NSDictionary<NSString *, NSString *> *> *zix_routableManifestEntries(void) {
+    static NSArray<NSDictionary<NSString *, NSString *> *> *entries;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        entries = loadRoutableManifestEntries();
+    });
+    return entries;
 }
 
 #import "ZIKRouterInternal.h"
@@ -17,6 +17,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (BOOL)isDestinationClass:(Class)destinationClass registeredWithRouter:(Class)routerClass;
 
+/// Hook methods of view controller and segue for storyboard. Called when hooks of ZIKViewRouterHookGroupStoryboard are installed.
++ (void)installStoryboardHooks;
+
 @end
 
 NS_ASSUME_NONNULL_END
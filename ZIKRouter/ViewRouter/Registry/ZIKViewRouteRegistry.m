@@ -74,6 +74,9 @@ static NSMutableArray<Class> *_routerClasses;
     _check_routerToDestinationsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
     _check_routerToDestinationProtocolsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
 #endif
+}
+
++ (void)installStoryboardHooks {
     zix_replaceMethodWithMethod([XXViewController class], @selector(initWithCoder:), self, @selector(ZIKViewRouteRegistry_hook_initWithCoder:));
     zix_replaceMethodWithMethod([XXStoryboardSegue class], @selector(initWithIdentifier:source:destination:), self, @selector(ZIKViewRouteRegistry_hook_initWithIdentifier:source:destination:));
 }
@@ -247,6 +250,15 @@ static NSMutableArray<Class> *_routerClasses;
     }
 }
 
++ (void)didRegisterDestinationClass:(Class)destinationClass {
+    _ZIKViewRouterInstallHooksForDestinationClass(destinationClass);
+}
+
++ (void)willLoadStoryboard {
+    //Segue hooks are only needed after app uses storyboard
+    _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupStoryboard);
+}
+
 + (void)didFinishRegistration {
 #if ZIKROUTER_CHECK
     [self _searchAllRoutersAndDestinations];
@@ -306,6 +318,8 @@ static NSMutableArray<Class> *_routerClasses;
 
 + (void)enumerateAllViewRouters:(void(NS_NOESCAPE ^)(Class _Nullable routerClass, ZIKViewRoute * _Nullable route))handler {
     static NSSet *cachedAllRouters;
+    // Routers in maps are incomplete before deferred routers and routers in frozen route table are registered
+    [self completeRegistration];
     NSSet *routers;
     if ([self registrationFinished] && cachedAllRouters && cachedAllRouters.count > 0) {
         routers = cachedAllRouters;
@@ -348,12 +362,19 @@ static NSMutableArray<Class> *_routerClasses;
         }
         if (zix_classIsSubclassOfClass(class, [XXResponder class])) {
             if (class_conformsToProtocol(class, @protocol(ZIKRoutableView))) {
+                if ([self isAddressInFrozenImage:(__bridge const void *)(class)]) {
+                    return;
+                }
                 if (!(zix_classIsSubclassOfClass(class, [XXView class]) || class == [XXView class] || zix_classIsSubclassOfClass(class, [XXViewController class]) || class == [XXViewController class])) {
                     [errorDescription appendFormat:@"\n\n❌%@ should not conform to ZIKRoutableView. ZIKRoutableView only supports UIView/NSView and UIViewController/NSViewController", class];
                 }
                 [_routableDestinations addObject:class];
             }
         } else if (zix_classIsSubclassOfClass(class, [ZIKViewRouter class])) {
+            // Routers in frozen route table are registered lazily
+            if ([self isAddressInFrozenImage:(__bridge const void *)(class)]) {
+                return;
+            }
             if (!(zix_classSelfImplementingMethod(class, @selector(registerRoutableDestination), true) ||
                   [class isAbstractRouter])) {
                 [errorDescription appendFormat:@"\n\n❌Router(%@) must override +registerRoutableDestination to register destination.", class];
@@ -429,7 +450,7 @@ static NSMutableArray<Class> *_routerClasses;
 + (void)_checkAllRoutableProtocols {
     NSMutableString *errorDescription = [NSMutableString string];
     zix_enumerateProtocolList(^(Protocol *protocol) {
-        if (protocol) {
+        if (protocol && ![self isAddressInFrozenImage:(__bridge const void *)(protocol)]) {
             NSString *error = [self _checkProtocol:protocol];
             if (error) {
                 [errorDescription appendString:error];
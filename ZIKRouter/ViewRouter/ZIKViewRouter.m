@@ -73,76 +73,12 @@ static NSMutableSet *g_finishingXXViewRouters;
     g_preparingXXViewRouters = [NSMutableSet set];
     g_finishingXXViewRouters = [NSMutableSet set];
     
-    Class ZIKViewRouterClass = [ZIKViewRouter class];
-    Class XXViewControllerClass = [XXViewController class];
-    Class XXStoryboardSegueClass = [XXStoryboardSegue class];
-    
-#if ZIK_HAS_UIKIT
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(willMoveToParentViewController:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToParentViewController:));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(didMoveToParentViewController:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToParentViewController:));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillAppear:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillAppear:));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidAppear:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidAppear:));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillDisappear:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear:));
-    if (NSClassFromString(@"SLComposeServiceViewController")) {
-        //fix SLComposeServiceViewController doesn't call -[super viewWillDisappear:]
-        zix_replaceMethodWithMethod(NSClassFromString(@"SLComposeServiceViewController"), @selector(viewWillDisappear:),
-                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear:));
-    }
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear:));
-    
-    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToSuperview:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
-    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToSuperview),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
-    zix_replaceMethodWithMethod([XXView class], @selector(willMoveToWindow:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
-    zix_replaceMethodWithMethod([XXView class], @selector(didMoveToWindow),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
-#else
+#if !ZIK_HAS_UIKIT
     [[NSNotificationCenter defaultCenter] addObserverForName:NSWindowWillCloseNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
         [ZIKViewRouter handleWindowWillCloseNotification:note];
     }];
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(presentViewController:animator:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_presentViewController:animator:));
-    zix_replaceMethodWithMethod([NSWindow class], @selector(setContentViewController:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_setContentViewController:));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillAppear),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillAppear));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidAppear),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidAppear));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillDisappear),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear));
-    
-    zix_replaceMethodWithMethod([XXView class], @selector(viewWillMoveToSuperview:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
-    zix_replaceMethodWithMethod([XXView class], @selector(viewDidMoveToSuperview),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
-    zix_replaceMethodWithMethod([XXView class], @selector(viewWillMoveToWindow:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
-    zix_replaceMethodWithMethod([XXView class], @selector(viewDidMoveToWindow),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
-#endif
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidLoad),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidLoad));
-    zix_replaceMethodWithMethod(XXViewControllerClass, @selector(prepareForSegue:sender:),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_prepareForSegue:sender:));
-    zix_replaceMethodWithMethod(XXStoryboardSegueClass, @selector(perform),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_seguePerform));
-#if ZIK_HAS_UIKIT
-    zix_replaceMethodWithMethod([UIStoryboard class], @selector(instantiateInitialViewController),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_instantiateInitialViewController));
-#else
-    zix_replaceMethodWithMethod([NSStoryboard class], @selector(instantiateInitialController),
-                                ZIKViewRouterClass, @selector(ZIKViewRouter_hook_instantiateInitialViewController));
 #endif
+    //Hooks of UIKit / AppKit are installed when they're first needed, see _ZIKViewRouterInstallHooks()
 }
 
 + (void)_didFinishRegistration {
@@ -255,6 +191,9 @@ static NSMutableSet *g_finishingXXViewRouters;
         [self _validateDestinationConformance:destination];
     }
 #endif
+    if (destination) {
+        _ZIKViewRouterInstallHooksForDestinationClass([destination class]);
+    }
     [super attachDestination:destination];
 }
 
@@ -4323,6 +4262,145 @@ static  ZIKViewRouterType *_Nullable _routerTypeToRegisteredView(Class viewClass
 
 @end
 
+#pragma mark Hook
+
+static BOOL _viewControllerHooksInstalled = NO;
+static BOOL _viewHooksInstalled = NO;
+static BOOL _storyboardHooksInstalled = NO;
+
+static void _installViewControllerHooks(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        Class ZIKViewRouterClass = [ZIKViewRouter class];
+        Class XXViewControllerClass = [XXViewController class];
+#if ZIK_HAS_UIKIT
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(willMoveToParentViewController:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToParentViewController:));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(didMoveToParentViewController:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToParentViewController:));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillAppear:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillAppear:));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidAppear:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidAppear:));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillDisappear:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear:));
+        if (NSClassFromString(@"SLComposeServiceViewController")) {
+            //fix SLComposeServiceViewController doesn't call -[super viewWillDisappear:]
+            zix_replaceMethodWithMethod(NSClassFromString(@"SLComposeServiceViewController"), @selector(viewWillDisappear:),
+                                        ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear:));
+        }
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear:));
+#else
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(presentViewController:animator:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_presentViewController:animator:));
+        zix_replaceMethodWithMethod([NSWindow class], @selector(setContentViewController:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_setContentViewController:));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillAppear),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillAppear));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidAppear),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidAppear));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewWillDisappear),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewWillDisappear));
+        zix_replaceMethodWithMethod(XXViewControllerClass, @selector(viewDidDisappear),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidDisappear));
+#endif
+        _viewControllerHooksInstalled = YES;
+    });
+}
+
+static void _installViewHooks(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        Class ZIKViewRouterClass = [ZIKViewRouter class];
+        Class XXViewClass = [XXView class];
+#if ZIK_HAS_UIKIT
+        zix_replaceMethodWithMethod(XXViewClass, @selector(willMoveToSuperview:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(didMoveToSuperview),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(willMoveToWindow:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(didMoveToWindow),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
+#else
+        zix_replaceMethodWithMethod(XXViewClass, @selector(viewWillMoveToSuperview:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToSuperview:));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(viewDidMoveToSuperview),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToSuperview));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(viewWillMoveToWindow:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_willMoveToWindow:));
+        zix_replaceMethodWithMethod(XXViewClass, @selector(viewDidMoveToWindow),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_didMoveToWindow));
+#endif
+        //Prepare UIView destination added to a superview not on screen when the view controller is loaded
+        zix_replaceMethodWithMethod([XXViewController class], @selector(viewDidLoad),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_viewDidLoad));
+        _viewHooksInstalled = YES;
+    });
+}
+
+static void _installStoryboardHooks(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        Class ZIKViewRouterClass = [ZIKViewRouter class];
+        zix_replaceMethodWithMethod([XXViewController class], @selector(prepareForSegue:sender:),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_prepareForSegue:sender:));
+        zix_replaceMethodWithMethod([XXStoryboardSegue class], @selector(perform),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_seguePerform));
+#if ZIK_HAS_UIKIT
+        zix_replaceMethodWithMethod([UIStoryboard class], @selector(instantiateInitialViewController),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_instantiateInitialViewController));
+#else
+        zix_replaceMethodWithMethod([NSStoryboard class], @selector(instantiateInitialController),
+                                    ZIKViewRouterClass, @selector(ZIKViewRouter_hook_instantiateInitialViewController));
+#endif
+        [ZIKViewRouteRegistry installStoryboardHooks];
+        _storyboardHooksInstalled = YES;
+    });
+}
+
+void _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroup groups) {
+    if ((_ZIKViewRouterInstalledHookGroups() & groups) == groups) {
+        return;
+    }
+    if (groups & (ZIKViewRouterHookGroupViewController | ZIKViewRouterHookGroupView)) {
+        //UIView destination also needs view controller's hooks to find its performer
+        _installViewControllerHooks();
+    }
+    if (groups & ZIKViewRouterHookGroupView) {
+        _installViewHooks();
+    }
+    if (groups & ZIKViewRouterHookGroupStoryboard) {
+        _installStoryboardHooks();
+    }
+}
+
+void _ZIKViewRouterInstallHooksForDestinationClass(Class destinationClass) {
+    if (_viewHooksInstalled) {
+        return;
+    }
+    if (zix_classIsSubclassOfClass(destinationClass, [XXViewController class])) {
+        _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupViewController);
+    } else {
+        _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupViewController | ZIKViewRouterHookGroupView);
+    }
+}
+
+ZIKViewRouterHookGroup _ZIKViewRouterInstalledHookGroups(void) {
+    ZIKViewRouterHookGroup groups = 0;
+    if (_viewControllerHooksInstalled) {
+        groups |= ZIKViewRouterHookGroupViewController;
+    }
+    if (_viewHooksInstalled) {
+        groups |= ZIKViewRouterHookGroupView;
+    }
+    if (_storyboardHooksInstalled) {
+        groups |= ZIKViewRouterHookGroupStoryboard;
+    }
+    return groups;
+}
+
 void _registerViewProtocolWithSwiftFactory(Protocol<ZIKViewRoutable> *viewProtocol, Class viewClass, ZIKViewFactoryBlock block) {
     NSCAssert(!ZIKViewRouteRegistry.registrationFinished, @"Only register in +registerRoutableDestination.");
     [ZIKViewRouteRegistry registerDestinationProtocol:viewProtocol forMakingDestination:viewClass factoryBlock:(id)block];
@@ -329,6 +329,26 @@ FOUNDATION_EXTERN void _registerViewIdentifierWithSwiftFactory(NSString *identif
 
 FOUNDATION_EXTERN void _registerViewModuleIdentifierWithSwiftFactory(NSString *identifier, Class viewClass, id(^block)(void));
 
+/// Groups of system methods hooked by ZIKViewRouter. Hooks are not installed in +load, each group is installed once when it's first needed, so views not using router don't pay for hooks.
+typedef NS_OPTIONS(NSUInteger, ZIKViewRouterHookGroup) {
+    /// Appearance and containment of view controller. Installed when the first view destination is registered or performed.
+    ZIKViewRouterHookGroupViewController = 1 << 0,
+    /// Superview and window changes of view. Installed when the first UIView / NSView destination is registered or performed.
+    ZIKViewRouterHookGroupView           = 1 << 1,
+    /// Segue and storyboard instantiation. Installed when the first storyboard is loaded.
+    ZIKViewRouterHookGroupStoryboard     = 1 << 2,
+    ZIKViewRouterHookGroupAll            = ZIKViewRouterHookGroupViewController | ZIKViewRouterHookGroupView | ZIKViewRouterHookGroupStoryboard
+};
+
+/// Install hook groups not installed yet. Can be called in any thread.
+FOUNDATION_EXTERN void _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroup groups);
+
+/// Install hook groups required by the destination class.
+FOUNDATION_EXTERN void _ZIKViewRouterInstallHooksForDestinationClass(Class destinationClass);
+
+/// Hook groups already installed.
+FOUNDATION_EXTERN ZIKViewRouterHookGroup _ZIKViewRouterInstalledHookGroups(void);
+
 NS_ASSUME_NONNULL_END
 
 #endif
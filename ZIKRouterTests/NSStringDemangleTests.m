@@ -0,0 +1,34 @@
+//
+//  NSStringDemangleTests.m
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "NSString+Demangle.h"
+
+@interface NSStringDemangleTests : XCTestCase
+@end
+
+@implementation NSStringDemangleTests
+
+- (void)testDemangleCache {
+    ZIKDemangleCacheStatistics before = [NSString swiftDemangleCacheStatistics];
+    if (before.capacity == 0) {
+        // Swift runtime is not loaded
+        XCTAssertEqualObjects([@"$s7ZRouter6RouterC" demangledAsSwift], @"$s7ZRouter6RouterC");
+        return;
+    }
+    NSString *demangled = [@"$s7ZRouter6RouterC" demangledAsSwift];
+    XCTAssertEqualObjects(demangled, @"ZRouter.Router");
+    for (int i = 0; i < 100; i++) {
+        XCTAssertEqualObjects([@"$s7ZRouter6RouterC" demangledAsSwift], demangled);
+    }
+    XCTAssertEqualObjects([@"ZIKViewRouter" demangledAsSwift], @"ZIKViewRouter");
+    ZIKDemangleCacheStatistics after = [NSString swiftDemangleCacheStatistics];
+    XCTAssertTrue(after.hits - before.hits >= 100);
+}
+
+@end
@@ -0,0 +1,280 @@
+//
+//  ZIKAddressIndexTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKAddressIndex.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t N_SECT_EXT = macho::N_SECT | macho::N_EXT;
+
+/// A dylib with __TEXT,__text and __DATA,__data. Vm addresses start from 0, so it can also be used as a loaded image at its own address. Values of symbols in section 1 and 2 are offsets from __text and __data.
+struct AddressFixture {
+    std::vector<uint8_t> file;
+    uint64_t text;
+    uint64_t data;
+    uint64_t dataSegmentEnd;
+};
+
+static AddressFixture addressImage(bool is64Bit, const std::vector<MachOFixtureBuilder::Symbol> &symbols, uint64_t textZeroFill = 0) {
+    MachOFixtureBuilder builder(is64Bit);
+    size_t text = builder.reserveSection("__TEXT", "__text", 0x100);
+    size_t data = builder.reserveSection("__DATA", "__data", 0x40);
+    if (textZeroFill > 0) {
+        builder.addZeroFill("__TEXT", textZeroFill);
+    }
+    builder.layout();
+    AddressFixture fixture;
+    fixture.text = builder.sectionAddress(text);
+    fixture.data = builder.sectionAddress(data);
+    fixture.dataSegmentEnd = builder.segmentAddress("__DATA") + 0x1000;
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        // Sections are laid out before adding symbols
+        uint64_t value = symbol.sect == 2 ? fixture.data + symbol.value : (symbol.sect == 1 ? fixture.text + symbol.value : symbol.value);
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, value, symbol.desc);
+    }
+    fixture.file = builder.build();
+    return fixture;
+}
+
+/// Nearest symbol at or before the address in the same segment, scanning every nlist.
+static const char *linearNearest(const MachOSymbolTable &table, const std::vector<AddressRange> &segments, uint64_t address) {
+    const AddressRange *segment = nullptr;
+    for (const AddressRange &range : segments) {
+        if (address >= range.start && address < range.end) {
+            segment = &range;
+        }
+    }
+    if (segment == nullptr) {
+        return nullptr;
+    }
+    const char *nearest = nullptr;
+    uint64_t nearestValue = 0;
+    bool nearestExternal = false;
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        if (name == nullptr || name[0] == '\0' || (type & macho::N_STAB) != 0 || (type & macho::N_TYPE) != macho::N_SECT) {
+            continue;
+        }
+        if (value > address || value < segment->start) {
+            continue;
+        }
+        bool external = (type & macho::N_EXT) != 0;
+        if (nearest == nullptr || value > nearestValue || (value == nearestValue && external && !nearestExternal)) {
+            nearest = name;
+            nearestValue = value;
+            nearestExternal = external;
+        }
+    }
+    return nearest;
+}
+
+static void checkIndexWith64Bit(bool is64Bit) {
+    AddressFixture fixture = addressImage(is64Bit, {
+        {"_exported", N_SECT_EXT, 1, 0, 0x10},
+        {"_static_function", macho::N_SECT, 1, 0, 0x40},
+        {"_debug.o", macho::N_STAB, 1, 0, 0x50},
+        {"_undefined", macho::N_UNDF | macho::N_EXT, 0, 0, 0x60},
+        {"_absolute", macho::N_ABS | macho::N_EXT, 0, 0, 0x70},
+        {"", macho::N_SECT, 1, 0, 0x80},
+        {"_local_alias", macho::N_SECT, 1, 0, 0x90},
+        {"_exported_alias", N_SECT_EXT, 1, 0, 0x90},
+        {"_second_alias", N_SECT_EXT, 1, 0, 0x90},
+        {"_global_data", N_SECT_EXT, 2, 0, 0x8},
+    });
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(fixture.file.data(), fixture.file.size(), MachOImage::LayoutFile));
+    AddressIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), 4);
+    ZIK_ASSERT_EQUAL(index.slide(), 0);
+
+    // Sorted by address
+    for (size_t i = 1; i < index.entries().size(); i++) {
+        ZIK_ASSERT_TRUE(index.entries()[i - 1].address < index.entries()[i].address);
+    }
+
+    const AddressIndex::Entry *entry = index.find(fixture.text + 0x10);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_exported") == 0);
+    entry = index.find(fixture.text + 0x3f);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_exported") == 0);
+    // Local symbols are found
+    entry = index.find(fixture.text + 0x44);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_static_function") == 0);
+    ZIK_ASSERT_EQUAL(entry->address, fixture.text + 0x40);
+    // Debug, undefined, absolute and unnamed symbols are skipped
+    entry = index.find(fixture.text + 0x88);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_static_function") == 0);
+    // The first external alias is preferred
+    entry = index.find(fixture.text + 0x90);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_exported_alias") == 0);
+    entry = index.find(fixture.data + 0x10);
+    ZIK_ASSERT_TRUE(entry != nullptr && strcmp(index.name(*entry), "_global_data") == 0);
+
+    // Before all symbols
+    ZIK_ASSERT_TRUE(index.find(fixture.text) == nullptr);
+    // In __DATA before its first symbol, the last function in __TEXT is not the owner
+    ZIK_ASSERT_TRUE(index.find(fixture.data) == nullptr);
+    // Out of the image, and in __LINKEDIT
+    ZIK_ASSERT_TRUE(index.find(fixture.dataSegmentEnd) == nullptr);
+    ZIK_ASSERT_TRUE(index.find(fixture.dataSegmentEnd + 0x10) == nullptr);
+    ZIK_ASSERT_TRUE(index.find(UINT64_MAX) == nullptr);
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testIndex64) {
+    checkIndexWith64Bit(true);
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testIndex32) {
+    checkIndexWith64Bit(false);
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testImageWithoutSymbolTable) {
+    AddressFixture fixture = addressImage(true, {});
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(fixture.file.data(), fixture.file.size(), MachOImage::LayoutFile));
+    AddressIndex index;
+    ZIK_ASSERT_FALSE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), 0);
+    ZIK_ASSERT_TRUE(index.find(fixture.text) == nullptr);
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testSegmentRanges) {
+    AddressFixture fixture = addressImage(true, {{"_main", N_SECT_EXT, 1, 0, 0}}, 0x5000);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(fixture.file.data(), fixture.file.size(), MachOImage::LayoutFile));
+    std::vector<AddressRange> ranges;
+    readSegmentRanges(image, ranges);
+    // __TEXT with zero fill and __DATA, without __LINKEDIT
+    ZIK_ASSERT_EQUAL(ranges.size(), 2);
+    ZIK_ASSERT_EQUAL(ranges[0].start, 0);
+    ZIK_ASSERT_EQUAL(ranges[0].end, fixture.data & ~0xfffULL);
+    ZIK_ASSERT_EQUAL(ranges[1].start, fixture.data & ~0xfffULL);
+    ZIK_ASSERT_EQUAL(ranges[1].end, fixture.dataSegmentEnd);
+    ZIK_ASSERT_TRUE(rangesContainAddress(ranges, 0));
+    ZIK_ASSERT_TRUE(rangesContainAddress(ranges, fixture.text + 0x5000));
+    ZIK_ASSERT_TRUE(rangesContainAddress(ranges, fixture.dataSegmentEnd - 1));
+    ZIK_ASSERT_FALSE(rangesContainAddress(ranges, fixture.dataSegmentEnd));
+    ZIK_ASSERT_FALSE(rangesContainAddress({}, 0));
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testSameAsLinearScan) {
+    // Many symbols in a large __TEXT, with aliases and gaps
+    std::mt19937 random(2018);
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    uint64_t offset = 0x10;
+    for (size_t i = 0; i < 5000; i++) {
+        uint8_t type = random() % 3 == 0 ? static_cast<uint8_t>(macho::N_SECT) : N_SECT_EXT;
+        if (random() % 50 == 0) {
+            type = macho::N_STAB;
+        }
+        MachOFixtureBuilder::Symbol symbol = {"_symbol" + std::to_string(i), type, 1, 0, offset};
+        symbols.push_back(symbol);
+        if (random() % 10 != 0) {
+            offset += 4 + (random() % 64) * 4;
+        }
+    }
+    std::shuffle(symbols.begin(), symbols.end(), random);
+    AddressFixture fixture = addressImage(true, symbols, offset + 0x1000);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(fixture.file.data(), fixture.file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    std::vector<AddressRange> segments;
+    readSegmentRanges(image, segments);
+    AddressIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+
+    for (size_t i = 0; i < 3000; i++) {
+        uint64_t address = random() % (fixture.dataSegmentEnd + 0x100);
+        const AddressIndex::Entry *entry = index.find(address);
+        const char *expected = linearNearest(table, segments, address);
+        ZIK_ASSERT_EQUAL(entry == nullptr, expected == nullptr);
+        if (entry != nullptr && expected != nullptr) {
+            ZIK_ASSERT_TRUE(strcmp(index.name(*entry), expected) == 0);
+        }
+    }
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testLoadedImageCache) {
+    AddressFixture fixture = addressImage(sizeof(void *) == 8, {{"_main", N_SECT_EXT, 1, 0, 0x10}, {"_helper", macho::N_SECT, 1, 0, 0x20}});
+    const void *header = fixture.file.data();
+    uintptr_t slide = reinterpret_cast<uintptr_t>(header);
+    AddressIndexCache cache;
+    std::shared_ptr<const AddressIndex> index = cache.indexForLoadedImage(header);
+    ZIK_ASSERT_TRUE(index != nullptr);
+    ZIK_ASSERT_EQUAL(index->slide(), static_cast<intptr_t>(slide));
+    ZIK_ASSERT_EQUAL(index->count(), 2);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 1);
+    // Built only once
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(header) == index);
+
+    AddressFixture other = addressImage(sizeof(void *) == 8, {{"_other", N_SECT_EXT, 1, 0, 0x10}});
+    const void *headers[] = {other.file.data(), header};
+    ZIK_ASSERT_TRUE(cache.imageContainingAddress(headers, 2, slide + fixture.text + 0x24) == header);
+    ZIK_ASSERT_TRUE(cache.imageContainingAddress(headers, 2, reinterpret_cast<uintptr_t>(other.file.data()) + other.text) == other.file.data());
+    ZIK_ASSERT_TRUE(cache.imageContainingAddress(headers, 1, slide + fixture.text) == nullptr);
+    ZIK_ASSERT_TRUE(cache.imageContainingAddress(headers, 2, slide + fixture.dataSegmentEnd) == nullptr);
+
+    // Another image is loaded at the same address after unloading
+    cache.removeImage(header);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 0);
+    ZIK_ASSERT_TRUE(other.file.size() <= fixture.file.size());
+    memcpy(fixture.file.data(), other.file.data(), other.file.size());
+    std::shared_ptr<const AddressIndex> newIndex = cache.indexForLoadedImage(header);
+    ZIK_ASSERT_TRUE(newIndex != nullptr);
+    ZIK_ASSERT_EQUAL(newIndex->count(), 1);
+    ZIK_ASSERT_TRUE(strcmp(newIndex->name(newIndex->entries()[0]), "_other") == 0);
+
+    // Images without symbol table are cached too
+    AddressFixture stripped = addressImage(sizeof(void *) == 8, {});
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(stripped.file.data()) == nullptr);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 2);
+    uint32_t garbage = 0;
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(&garbage) == nullptr);
+    const void *garbageHeaders[] = {&garbage};
+    ZIK_ASSERT_TRUE(cache.imageContainingAddress(garbageHeaders, 1, reinterpret_cast<uintptr_t>(&garbage)) == nullptr);
+}
+
+ZIK_TEST(ZIKAddressIndexTests, testFindInLoadedImage) {
+    AddressFixture fixture = addressImage(sizeof(void *) == 8, {{"_main", N_SECT_EXT, 1, 0, 0x10}, {"_helper", macho::N_SECT, 1, 0, 0x20}});
+    const void *header = fixture.file.data();
+    uintptr_t slide = reinterpret_cast<uintptr_t>(header);
+    const void *headers[] = {header};
+    ZIK_ASSERT_TRUE(ZIKAddressIndexImageContainingAddress(headers, 1, slide + fixture.text + 0x28) == header);
+    ZIK_ASSERT_TRUE(ZIKAddressIndexImageContainingAddress(NULL, 1, slide + fixture.text) == NULL);
+
+    ZIKAddressIndexSymbol symbol;
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(header, slide + fixture.text + 0x28, &symbol), ZIKSymbolIndexStatusFound);
+    ZIK_ASSERT_TRUE(strcmp(symbol.name, "_helper") == 0);
+    ZIK_ASSERT_EQUAL(symbol.address, slide + fixture.text + 0x20);
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(header, slide + fixture.text + 0x10, &symbol), ZIKSymbolIndexStatusFound);
+    ZIK_ASSERT_TRUE(strcmp(symbol.name, "_main") == 0);
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(header, slide + fixture.text, &symbol), ZIKSymbolIndexStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(header, slide + fixture.dataSegmentEnd, &symbol), ZIKSymbolIndexStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(header, slide + fixture.text + 0x10, NULL), ZIKSymbolIndexStatusFound);
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(NULL, slide + fixture.text + 0x10, &symbol), ZIKSymbolIndexStatusNotFound);
+
+    AddressFixture stripped = addressImage(sizeof(void *) == 8, {});
+    ZIK_ASSERT_EQUAL(ZIKAddressIndexFindInLoadedImage(stripped.file.data(), reinterpret_cast<uintptr_t>(stripped.file.data()) + stripped.text, &symbol), ZIKSymbolIndexStatusUnavailable);
+    ZIKAddressIndexRemoveLoadedImage(header);
+    ZIKAddressIndexRemoveLoadedImage(stripped.file.data());
+}
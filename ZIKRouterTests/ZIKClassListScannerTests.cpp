@@ -0,0 +1,521 @@
+//
+//  ZIKClassListScannerTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKClassListScanner.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+/// Fake objc classes in memory. Each class is {isa, superclass, cache, vtable, bits}.
+class FakeClasses {
+public:
+    static const size_t ClassSize = 5;
+
+    explicit FakeClasses(size_t capacity) : storage_(capacity * ClassSize, 0), count_(0) {}
+
+    uintptr_t addClass(uintptr_t superclass) {
+        uintptr_t *cls = &storage_[count_ * ClassSize];
+        count_++;
+        cls[1] = superclass;
+        return reinterpret_cast<uintptr_t>(cls);
+    }
+
+private:
+    std::vector<uintptr_t> storage_;
+    size_t count_;
+};
+
+/// Build a class graph like a 4-ary heap, so every class shares ancestors with its siblings. Return classes in shuffled order.
+static std::vector<uintptr_t> buildClassGraph(FakeClasses &classes, size_t count) {
+    std::vector<uintptr_t> graph;
+    for (size_t i = 0; i < count; i++) {
+        graph.push_back(classes.addClass(i == 0 ? 0 : graph[(i - 1) / 4]));
+    }
+    std::mt19937 random(20261018);
+    std::shuffle(graph.begin(), graph.end(), random);
+    return graph;
+}
+
+static size_t superclassCallCount = 0;
+
+static const void *countingSuperclass(const void *cls) {
+    superclassCallCount++;
+    return reinterpret_cast<const void *const *>(cls)[1];
+}
+
+/// Build a dylib whose loaded content can be read at its own address.
+static std::vector<uint8_t> classListImage(const std::vector<uintptr_t> &classes, const char *segname = "__DATA") {
+    MachOFixtureBuilder builder(sizeof(void *) == 8);
+    size_t section = builder.reserveSection(segname, "__objc_classlist", classes.size() * sizeof(void *), sizeof(void *));
+    builder.layout();
+    for (size_t i = 0; i < classes.size(); i++) {
+        builder.writePointer(section, i * sizeof(void *), classes[i]);
+    }
+    return builder.build();
+}
+
+/// Run chunks in reverse order, to check that results don't depend on the order of running.
+static void reverseApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    for (size_t i = iterations; i > 0; i--) {
+        work(context, i - 1);
+    }
+}
+
+static void threadApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    size_t threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) {
+        threadCount = 2;
+    }
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.push_back(std::thread([=]() {
+            for (size_t i = t; i < iterations; i += threadCount) {
+                work(context, i);
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testSubclass) {
+    FakeClasses classes(8);
+    uintptr_t root = classes.addClass(0);
+    uintptr_t parent = classes.addClass(root);
+    uintptr_t child = classes.addClass(parent);
+    uintptr_t grandchild = classes.addClass(child);
+    uintptr_t other = classes.addClass(root);
+
+    ZIK_ASSERT_TRUE(classIsSubclassOfClass(child, parent));
+    ZIK_ASSERT_TRUE(classIsSubclassOfClass(grandchild, parent));
+    ZIK_ASSERT_FALSE(classIsSubclassOfClass(parent, parent));
+    ZIK_ASSERT_FALSE(classIsSubclassOfClass(other, parent));
+    ZIK_ASSERT_FALSE(classIsSubclassOfClass(root, parent));
+    ZIK_ASSERT_FALSE(classIsSubclassOfClass(0, parent));
+    ZIK_ASSERT_FALSE(classIsSubclassOfClass(child, 0));
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testSubclassMemo) {
+    FakeClasses classes(4096);
+    std::vector<uintptr_t> graph = buildClassGraph(classes, 4000);
+    const size_t parentIndexes[] = {0, 1, 5, 100, 3999};
+    for (size_t parentIndex : parentIndexes) {
+        uintptr_t parent = graph[parentIndex];
+        SubclassMemo memo(parent, graph.size());
+        // Check twice, the second time is answered by memo
+        for (int round = 0; round < 2; round++) {
+            for (uintptr_t cls : graph) {
+                ZIK_ASSERT_EQUAL(memo.isSubclass(cls), classIsSubclassOfClass(cls, parent));
+            }
+        }
+        ZIK_ASSERT_FALSE(memo.isSubclass(parent));
+        ZIK_ASSERT_FALSE(memo.isSubclass(0));
+    }
+
+    // Shared by threads, and capacity is much smaller than class count
+    uintptr_t parent = graph[7];
+    SubclassMemo memo(parent, 16);
+    std::vector<uint8_t> verdicts(graph.size() * 4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t i = 0; i < graph.size(); i++) {
+                verdicts[t * graph.size() + i] = memo.isSubclass(graph[i]);
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < 4; t++) {
+        for (size_t i = 0; i < graph.size(); i++) {
+            ZIK_ASSERT_EQUAL(verdicts[t * graph.size() + i] != 0, classIsSubclassOfClass(graph[i], parent));
+        }
+    }
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testSubclassMemoResolvesAncestorsOnce) {
+    FakeClasses classes(128);
+    uintptr_t root = classes.addClass(0);
+    uintptr_t parent = classes.addClass(root);
+    uintptr_t base = classes.addClass(parent);
+    std::vector<uintptr_t> children;
+    for (size_t i = 0; i < 100; i++) {
+        children.push_back(classes.addClass(base));
+    }
+    superclassCallCount = 0;
+    ZIKSubclassMemoRef memo = ZIKSubclassMemoCreate(reinterpret_cast<const void *>(parent), children.size(), countingSuperclass);
+    for (uintptr_t child : children) {
+        ZIK_ASSERT_TRUE(ZIKSubclassMemoIsSubclass(memo, reinterpret_cast<const void *>(child)));
+    }
+    // The first child walks to parent, then other children stop at base.
+    ZIK_ASSERT_EQUAL(superclassCallCount, (size_t)(2 + children.size() - 1));
+    ZIK_ASSERT_FALSE(ZIKSubclassMemoIsSubclass(memo, reinterpret_cast<const void *>(root)));
+    ZIK_ASSERT_FALSE(ZIKSubclassMemoIsSubclass(memo, reinterpret_cast<const void *>(parent)));
+    ZIK_ASSERT_TRUE(ZIKSubclassMemoIsSubclass(memo, reinterpret_cast<const void *>(base)));
+    ZIKSubclassMemoDestroy(memo);
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testFindClassList) {
+    FakeClasses classes(4);
+    uintptr_t root = classes.addClass(0);
+    std::vector<uintptr_t> list = {root, classes.addClass(root), classes.addClass(root)};
+    const char *segments[] = {"__DATA", "__DATA_CONST", "__DATA_DIRTY"};
+    for (const char *segname : segments) {
+        std::vector<uint8_t> bytes = classListImage(list, segname);
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(bytes.data(), bytes.size(), MachOImage::LayoutLoaded));
+        ClassList classList;
+        ZIK_ASSERT_TRUE(findClassList(image, classList));
+        ZIK_ASSERT_EQUAL(classList.count, list.size());
+        ZIK_ASSERT_TRUE(memcmp(classList.classes, list.data(), list.size() * sizeof(uintptr_t)) == 0);
+    }
+
+    // Class pointers in a file are not usable
+    std::vector<uint8_t> bytes = classListImage(list);
+    MachOImage fileImage;
+    ZIK_ASSERT_TRUE(fileImage.parse(bytes.data(), bytes.size(), MachOImage::LayoutFile));
+    ClassList classList;
+    ZIK_ASSERT_FALSE(findClassList(fileImage, classList));
+
+    // Image without class list
+    MachOFixtureBuilder builder(sizeof(void *) == 8);
+    builder.reserveSection("__DATA", "__data", 16);
+    std::vector<uint8_t> empty = builder.build();
+    MachOImage emptyImage;
+    ZIK_ASSERT_TRUE(emptyImage.parse(empty.data(), empty.size(), MachOImage::LayoutLoaded));
+    ZIK_ASSERT_FALSE(findClassList(emptyImage, classList));
+    ZIK_ASSERT_EQUAL(classList.count, (size_t)0);
+
+    // Pointer size is different from current process
+    MachOFixtureBuilder otherBuilder(sizeof(void *) != 8);
+    otherBuilder.reserveSection("__DATA", "__objc_classlist", 16);
+    std::vector<uint8_t> other = otherBuilder.build();
+    MachOImage otherImage;
+    ZIK_ASSERT_TRUE(otherImage.parse(other.data(), other.size(), MachOImage::LayoutLoaded));
+    ZIK_ASSERT_FALSE(findClassList(otherImage, classList));
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testChunks) {
+    FakeClasses classes(2600);
+    uintptr_t root = classes.addClass(0);
+    std::vector<uintptr_t> list(2500, root);
+    ClassList classList = {list.data(), list.size()};
+
+    ClassListScanner scanner(root, 1024);
+    scanner.addClassList(classList);
+    ZIK_ASSERT_EQUAL(scanner.chunkCount(), (size_t)3);
+    scanner.addClassList(ClassList{list.data(), 1024});
+    ZIK_ASSERT_EQUAL(scanner.chunkCount(), (size_t)4);
+    scanner.addClassList(ClassList{list.data(), 0});
+    ZIK_ASSERT_EQUAL(scanner.chunkCount(), (size_t)4);
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testDeterministicOrder) {
+    FakeClasses classes(4096);
+    uintptr_t root = classes.addClass(0);
+    uintptr_t parent = classes.addClass(root);
+    std::vector<std::vector<uintptr_t>> lists(5);
+    std::vector<uintptr_t> expected;
+    for (size_t i = 0; i < lists.size(); i++) {
+        for (size_t j = 0; j < 300 * (i + 1); j++) {
+            uintptr_t cls;
+            if (j % 3 == 0) {
+                cls = classes.addClass(parent);
+                expected.push_back(cls);
+            } else if (j % 7 == 0) {
+                // Empty slot
+                cls = 0;
+            } else {
+                cls = classes.addClass(root);
+            }
+            lists[i].push_back(cls);
+        }
+    }
+
+    ZIKApplyFunction applies[] = {NULL, reverseApply, threadApply};
+    for (ZIKApplyFunction apply : applies) {
+        ClassListScanner scanner(parent, 64);
+        for (const std::vector<uintptr_t> &list : lists) {
+            scanner.addClassList(ClassList{list.data(), list.size()});
+        }
+        scanner.scan(apply);
+        ZIK_ASSERT_TRUE(scanner.results() == expected);
+        // Scan again
+        scanner.scan(apply);
+        ZIK_ASSERT_TRUE(scanner.results() == expected);
+    }
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testCopySubclasses) {
+    FakeClasses classes(16);
+    uintptr_t root = classes.addClass(0);
+    uintptr_t parent = classes.addClass(root);
+    uintptr_t a = classes.addClass(parent);
+    uintptr_t b = classes.addClass(a);
+    uintptr_t c = classes.addClass(parent);
+    std::vector<uint8_t> image1 = classListImage({root, b, parent});
+    std::vector<uint8_t> image2 = classListImage({c, a}, "__DATA_CONST");
+    std::vector<uint8_t> invalid(64, 0);
+    const void *headers[] = {image1.data(), invalid.data(), image2.data()};
+
+    ZIKApplyFunction applies[] = {NULL, reverseApply, threadApply};
+    for (ZIKApplyFunction apply : applies) {
+        size_t count = 0;
+        size_t imageClassCounts[3] = {9, 9, 9};
+        const void **found = ZIKClassListCopySubclasses(headers, 3, reinterpret_cast<const void *>(parent), apply, imageClassCounts, &count);
+        ZIK_ASSERT_TRUE(found != NULL);
+        ZIK_ASSERT_EQUAL(count, (size_t)3);
+        ZIK_ASSERT_TRUE(found[0] == reinterpret_cast<const void *>(b));
+        ZIK_ASSERT_TRUE(found[1] == reinterpret_cast<const void *>(c));
+        ZIK_ASSERT_TRUE(found[2] == reinterpret_cast<const void *>(a));
+        ZIK_ASSERT_EQUAL(imageClassCounts[0], (size_t)1);
+        ZIK_ASSERT_EQUAL(imageClassCounts[1], (size_t)0);
+        ZIK_ASSERT_EQUAL(imageClassCounts[2], (size_t)2);
+        free(found);
+    }
+
+    size_t count = 1;
+    const void **found = ZIKClassListCopySubclasses(headers, 0, reinterpret_cast<const void *>(parent), NULL, NULL, &count);
+    ZIK_ASSERT_TRUE(found != NULL);
+    ZIK_ASSERT_EQUAL(count, (size_t)0);
+    free(found);
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testLoadedImageScanner) {
+    FakeClasses classes(16);
+    uintptr_t root = classes.addClass(0);
+    uintptr_t parent = classes.addClass(root);
+    uintptr_t a = classes.addClass(parent);
+    uintptr_t b = classes.addClass(a);
+    uintptr_t c = classes.addClass(parent);
+    uintptr_t d = classes.addClass(b);
+    std::vector<uint8_t> launchImage = classListImage({root, parent, a});
+    std::vector<uint8_t> loadedImage = classListImage({c, root, d, b}, "__DATA_CONST");
+    std::vector<uint8_t> emptyImage = classListImage({});
+
+    LoadedImageScanner scanner(parent);
+    ZIK_ASSERT_TRUE(scanner.markScanned(launchImage.data()));
+    ZIK_ASSERT_FALSE(scanner.markScanned(launchImage.data()));
+
+    // dyld reports images loaded at launch again
+    std::vector<uintptr_t> found;
+    ZIK_ASSERT_FALSE(scanner.scanImage(launchImage.data(), found));
+    ZIK_ASSERT_TRUE(found.empty());
+
+    ZIK_ASSERT_FALSE(scanner.isScanned(loadedImage.data()));
+    ZIK_ASSERT_TRUE(scanner.scanImage(loadedImage.data(), found));
+    ZIK_ASSERT_TRUE(scanner.isScanned(loadedImage.data()));
+    std::vector<uintptr_t> expected = {c, d, b};
+    ZIK_ASSERT_TRUE(found == expected);
+
+    // Found classes are only returned once
+    found.clear();
+    ZIK_ASSERT_FALSE(scanner.scanImage(loadedImage.data(), found));
+    ZIK_ASSERT_TRUE(found.empty());
+
+    ZIK_ASSERT_TRUE(scanner.scanImage(emptyImage.data(), found));
+    ZIK_ASSERT_TRUE(found.empty());
+    ZIK_ASSERT_FALSE(scanner.scanImage(nullptr, found));
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testLoadedImageScannerMatchesFullScan) {
+    const size_t imageCount = 8;
+    FakeClasses classes(imageCount * 200 + 1);
+    std::vector<uintptr_t> graph = buildClassGraph(classes, imageCount * 200);
+    std::sort(graph.begin(), graph.end());
+    uintptr_t parent = graph[2];
+    std::mt19937 random(7);
+    std::shuffle(graph.begin(), graph.end(), random);
+    std::vector<std::vector<uint8_t>> images;
+    std::vector<const void *> headers;
+    for (size_t i = 0; i < imageCount; i++) {
+        images.push_back(classListImage(std::vector<uintptr_t>(graph.begin() + i * 200, graph.begin() + (i + 1) * 200)));
+    }
+    for (const std::vector<uint8_t> &image : images) {
+        headers.push_back(image.data());
+    }
+    size_t imageClassCounts[imageCount];
+    size_t total = 0;
+    const void **all = ZIKClassListCopySubclasses(headers.data(), imageCount, reinterpret_cast<const void *>(parent), NULL, imageClassCounts, &total);
+    ZIK_ASSERT_TRUE(all != NULL);
+    ZIK_ASSERT_TRUE(total > 0);
+
+    // Half of images are scanned at launch, and others are loaded later
+    ZIKLoadedImageScannerRef scanner = ZIKLoadedImageScannerCreate(reinterpret_cast<const void *>(parent));
+    size_t offset = 0;
+    for (size_t i = 0; i < imageCount; i++) {
+        if (i < imageCount / 2) {
+            ZIKLoadedImageScannerMarkScanned(scanner, headers[i]);
+            offset += imageClassCounts[i];
+            continue;
+        }
+        size_t count = 0;
+        const void **found = ZIKLoadedImageScannerCopySubclasses(scanner, headers[i], &count);
+        ZIK_ASSERT_TRUE(found != NULL);
+        ZIK_ASSERT_EQUAL(count, imageClassCounts[i]);
+        ZIK_ASSERT_TRUE(std::equal(found, found + count, all + offset));
+        offset += count;
+        free(found);
+    }
+    ZIK_ASSERT_EQUAL(offset, total);
+
+    for (size_t i = 0; i < imageCount; i++) {
+        size_t count = 1;
+        ZIK_ASSERT_TRUE(ZIKLoadedImageScannerCopySubclasses(scanner, headers[i], &count) == NULL);
+        ZIK_ASSERT_EQUAL(count, (size_t)0);
+        // Images found with objc runtime are marked by the caller
+        ZIK_ASSERT_FALSE(ZIKLoadedImageScannerMarkScanned(scanner, headers[i]));
+    }
+    std::vector<uint8_t> laterImage = classListImage(std::vector<uintptr_t>());
+    ZIK_ASSERT_TRUE(ZIKLoadedImageScannerMarkScanned(scanner, laterImage.data()));
+    ZIK_ASSERT_FALSE(ZIKLoadedImageScannerMarkScanned(scanner, laterImage.data()));
+    ZIKLoadedImageScannerDestroy(scanner);
+    free(all);
+}
+
+/// Images loaded by concurrent dlopen are reported in different threads.
+ZIK_TEST(ZIKClassListScannerTests, testLoadedImageScannerConcurrentImages) {
+    const size_t imageCount = 16;
+    FakeClasses classes(imageCount * 100 + 1);
+    std::vector<uintptr_t> graph = buildClassGraph(classes, imageCount * 100);
+    std::sort(graph.begin(), graph.end());
+    uintptr_t parent = graph[1];
+    std::mt19937 random(3);
+    std::shuffle(graph.begin(), graph.end(), random);
+    std::vector<std::vector<uint8_t>> images;
+    size_t expectedCount = 0;
+    for (size_t i = 0; i < imageCount; i++) {
+        std::vector<uintptr_t> list(graph.begin() + i * 100, graph.begin() + (i + 1) * 100);
+        for (uintptr_t cls : list) {
+            expectedCount += classIsSubclassOfClass(cls, parent) ? 1 : 0;
+        }
+        images.push_back(classListImage(list));
+    }
+
+    LoadedImageScanner scanner(parent, 64);
+    std::vector<std::vector<uintptr_t>> results(4);
+    std::vector<size_t> scannedCounts(4, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&, t]() {
+            // Every thread tries every image, but each image is scanned by one thread
+            for (size_t i = 0; i < imageCount; i++) {
+                if (scanner.scanImage(images[(i + t * 4) % imageCount].data(), results[t])) {
+                    scannedCounts[t]++;
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    size_t scannedCount = 0;
+    std::vector<uintptr_t> found;
+    for (size_t t = 0; t < 4; t++) {
+        scannedCount += scannedCounts[t];
+        found.insert(found.end(), results[t].begin(), results[t].end());
+    }
+    ZIK_ASSERT_EQUAL(scannedCount, imageCount);
+    ZIK_ASSERT_EQUAL(found.size(), expectedCount);
+    std::sort(found.begin(), found.end());
+    ZIK_ASSERT_TRUE(std::unique(found.begin(), found.end()) == found.end());
+    for (uintptr_t cls : found) {
+        ZIK_ASSERT_TRUE(classIsSubclassOfClass(cls, parent));
+    }
+}
+
+/// 60 images with 5000 classes in each image. Routers are 1% of classes, and all classes are 6 levels deep.
+static void scanBenchmarkWithApply(ZIKApplyFunction apply) {
+    const size_t imageCount = 60;
+    const size_t classCount = 5000;
+    const size_t depth = 6;
+    FakeClasses classes(imageCount * classCount + depth + 1);
+    uintptr_t parent = classes.addClass(0);
+    uintptr_t base = classes.addClass(0);
+    for (size_t i = 0; i < depth - 2; i++) {
+        base = classes.addClass(base);
+    }
+    std::vector<std::vector<uint8_t>> images;
+    std::vector<const void *> headers;
+    size_t expected = 0;
+    for (size_t i = 0; i < imageCount; i++) {
+        std::vector<uintptr_t> list;
+        for (size_t j = 0; j < classCount; j++) {
+            if (j % 100 == 0) {
+                list.push_back(classes.addClass(parent));
+                expected++;
+            } else {
+                list.push_back(classes.addClass(base));
+            }
+        }
+        images.push_back(classListImage(list));
+    }
+    for (const std::vector<uint8_t> &image : images) {
+        headers.push_back(image.data());
+    }
+    measure([&] {
+        size_t count = 0;
+        const void **found = ZIKClassListCopySubclasses(headers.data(), headers.size(), reinterpret_cast<const void *>(parent), apply, NULL, &count);
+        ZIK_ASSERT_EQUAL(count, expected);
+        free(found);
+    });
+}
+
+/// 50k classes in a 4-ary tree, about 8 levels deep.
+ZIK_TEST(ZIKClassListScannerTests, testPerformanceSubclassCheck) {
+    FakeClasses classes(50000);
+    std::vector<uintptr_t> graph = buildClassGraph(classes, 50000);
+    // Classes are allocated in the order of creation
+    std::sort(graph.begin(), graph.end());
+    uintptr_t parent = graph[1];
+    uintptr_t deepParent = graph[5];
+    std::shuffle(graph.begin(), graph.end(), std::mt19937(1));
+    measure([&] {
+        size_t found = 0;
+        for (uintptr_t cls : graph) {
+            found += classIsSubclassOfClass(cls, parent) + classIsSubclassOfClass(cls, deepParent);
+        }
+        ZIK_ASSERT_TRUE(found > 0);
+    });
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testPerformanceSubclassMemo) {
+    FakeClasses classes(50000);
+    std::vector<uintptr_t> graph = buildClassGraph(classes, 50000);
+    // Classes are allocated in the order of creation
+    std::sort(graph.begin(), graph.end());
+    uintptr_t parent = graph[1];
+    uintptr_t deepParent = graph[5];
+    std::shuffle(graph.begin(), graph.end(), std::mt19937(1));
+    measure([&] {
+        SubclassMemo memo(parent, graph.size());
+        SubclassMemo deepMemo(deepParent, graph.size());
+        size_t found = 0;
+        for (uintptr_t cls : graph) {
+            found += memo.isSubclass(cls) + deepMemo.isSubclass(cls);
+        }
+        ZIK_ASSERT_TRUE(found > 0);
+    });
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testPerformanceSerialScan) {
+    scanBenchmarkWithApply(NULL);
+}
+
+ZIK_TEST(ZIKClassListScannerTests, testPerformanceConcurrentScan) {
+    scanBenchmarkWithApply(threadApply);
+}
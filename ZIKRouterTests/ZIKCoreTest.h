@@ -0,0 +1,113 @@
+//
+//  ZIKCoreTest.h
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+//  Tests of the portable C++ core. They run in the XCTest bundle, where ZIKCoreTest.mm adds each test as a method of the XCTestCase subclass named after its suite, and in zik-core-tests, the test driver of Tools/ZIKCoreTests built by CMakeLists.txt.
+//
+
+#ifndef ZIKCoreTest_h
+#define ZIKCoreTest_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace zix {
+namespace test {
+
+/// A test case of the portable core, registered with ZIK_TEST.
+struct CoreTest {
+    const char *suite;
+    const char *name;
+    void (*run)();
+};
+
+/// Add a test to the tests of its suite. Called when ZIK_TEST is statically initialized.
+void registerTest(const CoreTest &test);
+
+struct CoreTestRegistration {
+    CoreTestRegistration(const char *suite, const char *name, void (*run)()) {
+        registerTest({suite, name, run});
+    }
+};
+
+/// Path of a file in the temporary directory.
+std::string temporaryPath(const char *name);
+
+/// Record a failed assertion of the running test.
+void recordFailure(const char *file, int line, const std::string &description);
+
+/// Measure the duration of a block, same as -[XCTestCase measureBlock:]. zik-core-tests runs the block once and prints its duration.
+void measure(const std::function<void()> &block);
+
+/// Describe values in failure messages. Numbers, enums, strings and pointers are printed.
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value, std::string>::type describe(const T &value) {
+    return std::to_string(value);
+}
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value, std::string>::type describe(const T &value) {
+    return std::to_string(static_cast<typename std::underlying_type<T>::type>(value));
+}
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_enum<T>::value, std::string>::type describe(const T &) {
+    return "value";
+}
+inline std::string describe(const std::string &value) { return "\"" + value + "\""; }
+inline std::string describe(const char *value) { return value ? "\"" + std::string(value) + "\"" : "NULL"; }
+inline std::string describe(bool value) { return value ? "true" : "false"; }
+inline std::string describe(std::nullptr_t) { return "NULL"; }
+template <typename T>
+std::string describe(T *value) {
+    return value ? "pointer " + std::to_string(reinterpret_cast<uintptr_t>(value)) : "NULL";
+}
+
+template <typename A, typename B>
+void assertCompare(bool passed, const A &a, const B &b, const char *expression, const char *file, int line) {
+    if (!passed) {
+        recordFailure(file, line, std::string(expression) + " (" + describe(a) + " vs " + describe(b) + ")");
+    }
+}
+
+} // namespace test
+} // namespace zix
+
+/// Define and register a test. Same as a test method of XCTestCase: `ZIK_TEST(ZIKSymbolIndexTests, testLookup) { ... }`.
+#define ZIK_TEST(suite, name) \
+    static void suite##_##name(); \
+    static zix::test::CoreTestRegistration suite##_##name##_registration(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+// Assertions don't stop the test, like XCTAssert.
+#define ZIK_ASSERT_TRUE(condition) \
+    do { if (!(condition)) zix::test::recordFailure(__FILE__, __LINE__, #condition); } while (0)
+#define ZIK_ASSERT_FALSE(condition) \
+    do { if (condition) zix::test::recordFailure(__FILE__, __LINE__, "!(" #condition ")"); } while (0)
+#define ZIK_ASSERT_NULL(value) \
+    do { if ((value) != nullptr) zix::test::recordFailure(__FILE__, __LINE__, #value " == NULL"); } while (0)
+#define ZIK_ASSERT_NOT_NULL(value) \
+    do { if ((value) == nullptr) zix::test::recordFailure(__FILE__, __LINE__, #value " != NULL"); } while (0)
+// Values of different integer types are compared like XCTAssertEqual, without warnings of sign comparison.
+#define ZIK_ASSERT_COMPARE(a, b, op) \
+    do { \
+        const auto &_zikA = (a); \
+        const auto &_zikB = (b); \
+        _Pragma("GCC diagnostic push") \
+        _Pragma("GCC diagnostic ignored \"-Wsign-compare\"") \
+        bool _zikPassed = _zikA op _zikB; \
+        _Pragma("GCC diagnostic pop") \
+        zix::test::assertCompare(_zikPassed, _zikA, _zikB, #a " " #op " " #b, __FILE__, __LINE__); \
+    } while (0)
+#define ZIK_ASSERT_EQUAL(a, b) ZIK_ASSERT_COMPARE(a, b, ==)
+#define ZIK_ASSERT_NOT_EQUAL(a, b) ZIK_ASSERT_COMPARE(a, b, !=)
+#define ZIK_ASSERT_GREATER_THAN(a, b) ZIK_ASSERT_COMPARE(a, b, >)
+#define ZIK_ASSERT_GREATER_THAN_OR_EQUAL(a, b) ZIK_ASSERT_COMPARE(a, b, >=)
+#define ZIK_ASSERT_LESS_THAN(a, b) ZIK_ASSERT_COMPARE(a, b, <)
+#define ZIK_ASSERT_LESS_THAN_OR_EQUAL(a, b) ZIK_ASSERT_COMPARE(a, b, <=)
+
+#endif /* ZIKCoreTest_h */
@@ -0,0 +1,48 @@
+//
+//  ZIKCoreTest.mm
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <objc/runtime.h>
+#include "ZIKCoreTest.h"
+
+using namespace zix::test;
+
+/// Test case running a test of ZIK_TEST.
+static XCTestCase *runningTestCase = nil;
+
+void zix::test::registerTest(const CoreTest &test) {
+    Class testClass = objc_getClass(test.suite);
+    if (testClass == Nil) {
+        testClass = objc_allocateClassPair([XCTestCase class], test.suite, 0);
+        objc_registerClassPair(testClass);
+    }
+    NSCAssert([testClass isSubclassOfClass:[XCTestCase class]], @"Suite %s of core test %s is not a test case.", test.suite, test.name);
+    void (*run)() = test.run;
+    IMP imp = imp_implementationWithBlock(^(XCTestCase *testCase) {
+        runningTestCase = testCase;
+        run();
+        runningTestCase = nil;
+    });
+    BOOL added = class_addMethod(testClass, sel_registerName(test.name), imp, "v@:");
+    NSCAssert(added, @"Core test %s is already defined in %s.", test.name, test.suite);
+    (void)added;
+}
+
+std::string zix::test::temporaryPath(const char *name) {
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:@(name)].fileSystemRepresentation;
+}
+
+void zix::test::recordFailure(const char *file, int line, const std::string &description) {
+    [runningTestCase recordFailureWithDescription:@(description.c_str()) inFile:@(file) atLine:line expected:YES];
+}
+
+void zix::test::measure(const std::function<void()> &block) {
+    [runningTestCase measureBlock:^{
+        block();
+    }];
+}
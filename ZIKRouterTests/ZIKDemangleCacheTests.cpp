@@ -0,0 +1,218 @@
+//
+//  ZIKDemangleCacheTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKDemangleCache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace zix;
+
+/// Calls of fakeDemangle.
+static std::atomic<size_t> demangleCalls(0);
+
+/// Size of buffers returned by fakeDemangle. Large buffers make leaks obvious.
+static const size_t fakeBufferSize = 4096;
+
+/// Demangle names with `$s` prefix into "demangled <name>", like `swift_demangle` returning a `malloc`'d buffer.
+static char *fakeDemangle(const char *mangledName, size_t mangledNameLength, char *, size_t *, uint32_t) {
+    demangleCalls++;
+    const char *name = mangledName[0] == '_' ? mangledName + 1 : mangledName;
+    if (strncmp(name, "$s", 2) != 0) {
+        return NULL;
+    }
+    std::string demangled = "demangled " + std::string(mangledName, mangledNameLength);
+    char *buffer = static_cast<char *>(malloc(std::max(fakeBufferSize, demangled.size() + 1)));
+    memcpy(buffer, demangled.c_str(), demangled.size() + 1);
+    return buffer;
+}
+
+/// Bytes allocated with malloc and not freed. 0 when the allocator has no statistics.
+static size_t allocatedBytes() {
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testDemangle) {
+    demangleCalls = 0;
+    DemangleCache cache(fakeDemangle, 16);
+    std::string demangled;
+    ZIK_ASSERT_TRUE(cache.demangle("_$s7ZRouter6RouterC", demangled));
+    ZIK_ASSERT_TRUE(demangled == "demangled _$s7ZRouter6RouterC");
+    ZIK_ASSERT_TRUE(cache.demangle("_$s7ZRouter6RouterC", demangled));
+    ZIK_ASSERT_TRUE(demangled == "demangled _$s7ZRouter6RouterC");
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 1);
+
+    // Names that can't be demangled are cached too
+    demangled = "unchanged";
+    ZIK_ASSERT_FALSE(cache.demangle("_OBJC_CLASS_$_ZIKViewRouter", demangled));
+    ZIK_ASSERT_FALSE(cache.demangle("_OBJC_CLASS_$_ZIKViewRouter", demangled));
+    ZIK_ASSERT_TRUE(demangled == "unchanged");
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 2);
+    ZIK_ASSERT_FALSE(cache.demangle(NULL, demangled));
+
+    ZIKDemangleCacheStatistics statistics = cache.statistics();
+    ZIK_ASSERT_EQUAL(statistics.hits, 2);
+    ZIK_ASSERT_EQUAL(statistics.misses, 2);
+    ZIK_ASSERT_EQUAL(statistics.evictions, 0);
+    ZIK_ASSERT_EQUAL(statistics.count, 2);
+    ZIK_ASSERT_EQUAL(statistics.capacity, 16);
+
+    cache.removeAll();
+    ZIK_ASSERT_EQUAL(cache.statistics().count, 0);
+    ZIK_ASSERT_TRUE(cache.demangle("_$s7ZRouter6RouterC", demangled));
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 3);
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testNamesWithSameHashPrefix) {
+    // Keys compare whole names, not only hashes or prefixes
+    DemangleCache cache(fakeDemangle, 16);
+    std::string demangled;
+    ZIK_ASSERT_TRUE(cache.demangle("$s1A", demangled));
+    ZIK_ASSERT_TRUE(cache.demangle("$s1A1B", demangled));
+    ZIK_ASSERT_TRUE(demangled == "demangled $s1A1B");
+    ZIK_ASSERT_TRUE(cache.demangle("$s1A", demangled));
+    ZIK_ASSERT_TRUE(demangled == "demangled $s1A");
+    ZIK_ASSERT_EQUAL(cache.statistics().count, 2);
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testLeastRecentlyUsedEviction) {
+    demangleCalls = 0;
+    DemangleCache cache(fakeDemangle, 3);
+    std::string demangled;
+    cache.demangle("$s1A", demangled);
+    cache.demangle("$s1B", demangled);
+    cache.demangle("$s1C", demangled);
+    // A is used again, so B is the least recently used one
+    cache.demangle("$s1A", demangled);
+    cache.demangle("$s1D", demangled);
+    ZIK_ASSERT_EQUAL(cache.statistics().evictions, 1);
+    ZIK_ASSERT_EQUAL(cache.statistics().count, 3);
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 4);
+
+    cache.demangle("$s1A", demangled);
+    cache.demangle("$s1C", demangled);
+    cache.demangle("$s1D", demangled);
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 4);
+    ZIK_ASSERT_TRUE(cache.demangle("$s1B", demangled));
+    ZIK_ASSERT_TRUE(demangled == "demangled $s1B");
+    ZIK_ASSERT_EQUAL(demangleCalls.load(), 5);
+    ZIK_ASSERT_EQUAL(cache.statistics().evictions, 2);
+
+    // Capacity is at least 1
+    DemangleCache single(fakeDemangle, 0);
+    ZIK_ASSERT_TRUE(single.demangle("$s1A", demangled));
+    ZIK_ASSERT_TRUE(single.demangle("$s1B", demangled));
+    ZIK_ASSERT_EQUAL(single.statistics().count, 1);
+    ZIK_ASSERT_EQUAL(single.statistics().capacity, 1);
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testCFunctions) {
+    ZIKDemangleCacheRef cache = ZIKDemangleCacheCreate(fakeDemangle, 8);
+    size_t length = 0;
+    char *demangled = ZIKDemangleCacheCopyDemangledName(cache, "_$s4main3FooV", &length);
+    ZIK_ASSERT_TRUE(demangled != NULL && strcmp(demangled, "demangled _$s4main3FooV") == 0);
+    ZIK_ASSERT_EQUAL(length, strlen("demangled _$s4main3FooV"));
+    free(demangled);
+    demangled = ZIKDemangleCacheCopyDemangledName(cache, "_$s4main3FooV", NULL);
+    ZIK_ASSERT_TRUE(demangled != NULL && strcmp(demangled, "demangled _$s4main3FooV") == 0);
+    free(demangled);
+    ZIK_ASSERT_TRUE(ZIKDemangleCacheCopyDemangledName(cache, "_main", &length) == NULL);
+    ZIK_ASSERT_TRUE(ZIKDemangleCacheCopyDemangledName(NULL, "_$s4main3FooV", &length) == NULL);
+
+    ZIKDemangleCacheStatistics statistics = ZIKDemangleCacheGetStatistics(cache);
+    ZIK_ASSERT_EQUAL(statistics.hits, 1);
+    ZIK_ASSERT_EQUAL(statistics.misses, 2);
+    ZIK_ASSERT_EQUAL(statistics.count, 2);
+    ZIK_ASSERT_EQUAL(ZIKDemangleCacheGetStatistics(NULL).capacity, 0);
+    ZIKDemangleCacheDestroy(cache);
+
+    // Without demangle function, nothing can be demangled
+    cache = ZIKDemangleCacheCreate(NULL, 8);
+    ZIK_ASSERT_TRUE(ZIKDemangleCacheCopyDemangledName(cache, "_$s4main3FooV", &length) == NULL);
+    ZIKDemangleCacheDestroy(cache);
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testConcurrentLookups) {
+    DemangleCache cache(fakeDemangle, 256);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> wrongResults(0);
+    const size_t lookupsPerThread = 5000;
+    for (size_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&cache, &wrongResults, t, lookupsPerThread]() {
+            std::string demangled;
+            for (size_t i = 0; i < lookupsPerThread; i++) {
+                // Threads share most names, so they race on the same entries. The names fit in the cache, so there are hits even when threads run one after another.
+                std::string name = (i % 7 == 0 ? "_objc" : "_$s") + std::to_string((i * 31 + t) % 200);
+                bool succeeded = cache.demangle(name.c_str(), demangled);
+                if (succeeded != (i % 7 != 0) || (succeeded && demangled != "demangled " + name)) {
+                    wrongResults++;
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    ZIK_ASSERT_EQUAL(wrongResults.load(), 0);
+    ZIKDemangleCacheStatistics statistics = cache.statistics();
+    ZIK_ASSERT_EQUAL(statistics.hits + statistics.misses, 4 * lookupsPerThread);
+    ZIK_ASSERT_TRUE(statistics.count <= 256);
+    ZIK_ASSERT_TRUE(statistics.hits > 0);
+}
+
+ZIK_TEST(ZIKDemangleCacheTests, testMemoryStaysFlat) {
+    // 100k demangles of a working set larger than the cache, so names are demangled, cached and evicted all the time
+    DemangleCache cache(fakeDemangle, 1024);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 4096; i++) {
+        names.push_back("_$s12SyntheticApp6Module" + std::to_string(i) + "C4nameSSvg");
+    }
+    std::string demangled;
+    size_t succeeded = 0;
+    // Fill the cache first, so later allocations are only replacements
+    for (size_t i = 0; i < 10000; i++) {
+        succeeded += cache.demangle(names[(i * 7919) % names.size()].c_str(), demangled);
+    }
+    size_t baseline = allocatedBytes();
+    for (size_t i = 10000; i < 100000; i++) {
+        // Most lookups are in a hot subset, like repeated symbols in validation
+        const std::string &name = i % 4 == 0 ? names[(i * 7919) % names.size()] : names[i % 512];
+        succeeded += cache.demangle(name.c_str(), demangled);
+    }
+    size_t allocated = allocatedBytes();
+    size_t growth = allocated > baseline ? allocated - baseline : 0;
+    ZIK_ASSERT_EQUAL(succeeded, 100000);
+    // A leaked buffer of each miss would be hundreds of megabytes
+    ZIK_ASSERT_LESS_THAN(growth, 1024 * 1024);
+
+    ZIKDemangleCacheStatistics statistics = cache.statistics();
+    ZIK_ASSERT_EQUAL(statistics.hits + statistics.misses, 100000);
+    ZIK_ASSERT_TRUE(statistics.hits > statistics.misses);
+    ZIK_ASSERT_TRUE(statistics.evictions > 0);
+    ZIK_ASSERT_EQUAL(statistics.count, 1024);
+    fprintf(stderr, "Demangle cache: %llu hits, %llu misses, %llu evictions, %.1f%% hit rate\n", (unsigned long long)statistics.hits, (unsigned long long)statistics.misses, (unsigned long long)statistics.evictions, 100.0 * statistics.hits / (statistics.hits + statistics.misses));
+}
@@ -0,0 +1,309 @@
+//
+//  ZIKExportTrieTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKExportTrie.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include "ZIKExportTrieBuilder.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static bool readULEB128(const std::vector<uint8_t> &bytes, uint64_t &value, size_t &length) {
+    const uint8_t *cursor = bytes.data();
+    bool result = ExportTrie::readULEB128(cursor, bytes.data() + bytes.size(), value);
+    length = static_cast<size_t>(cursor - bytes.data());
+    return result;
+}
+
+/// A dylib with export trie in LC_DYLD_EXPORTS_TRIE, or in LC_DYLD_INFO_ONLY. It can also be used as a loaded image at its own address.
+static std::vector<uint8_t> exportImage(const std::vector<uint8_t> &trie, bool dyldInfo, const std::vector<std::pair<std::string, uint32_t>> &dylibs = {}) {
+    MachOFixtureBuilder builder(sizeof(void *) == 8);
+    builder.setInstallName("/usr/lib/libExport.dylib");
+    for (const std::pair<std::string, uint32_t> &dylib : dylibs) {
+        builder.addDylib(dylib.first, dylib.second);
+    }
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    if (dyldInfo) {
+        builder.setDyldInfo({}, {}, {}, {}, trie);
+    } else {
+        builder.setLinkeditData(macho::LC_DYLD_EXPORTS_TRIE, trie);
+    }
+    return builder.build();
+}
+
+// MARK: uleb128
+
+ZIK_TEST(ZIKExportTrieTests, testULEB128) {
+    uint64_t value;
+    size_t length;
+    ZIK_ASSERT_TRUE(readULEB128({0x00}, value, length));
+    ZIK_ASSERT_EQUAL(value, 0);
+    ZIK_ASSERT_EQUAL(length, 1);
+    ZIK_ASSERT_TRUE(readULEB128({0x7f}, value, length));
+    ZIK_ASSERT_EQUAL(value, 0x7f);
+    ZIK_ASSERT_TRUE(readULEB128({0x80, 0x01}, value, length));
+    ZIK_ASSERT_EQUAL(value, 0x80);
+    ZIK_ASSERT_EQUAL(length, 2);
+    ZIK_ASSERT_TRUE(readULEB128({0xe5, 0x8e, 0x26, 0xff}, value, length));
+    ZIK_ASSERT_EQUAL(value, 624485);
+    ZIK_ASSERT_EQUAL(length, 3);
+
+    std::vector<uint64_t> values = {0, 1, 127, 128, 16383, 16384, 0xffffffff, 0x100000000ULL, UINT64_MAX};
+    for (uint64_t expected : values) {
+        std::vector<uint8_t> bytes;
+        MachOFixtureBuilder::appendULEB128(bytes, expected);
+        ZIK_ASSERT_TRUE(readULEB128(bytes, value, length));
+        ZIK_ASSERT_EQUAL(value, expected);
+        ZIK_ASSERT_EQUAL(length, bytes.size());
+    }
+}
+
+ZIK_TEST(ZIKExportTrieTests, testULEB128EdgeCases) {
+    uint64_t value;
+    size_t length;
+    // Max value in 10 bytes
+    ZIK_ASSERT_TRUE(readULEB128({0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01}, value, length));
+    ZIK_ASSERT_EQUAL(value, UINT64_MAX);
+    // 65 bits
+    ZIK_ASSERT_FALSE(readULEB128({0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02}, value, length));
+    ZIK_ASSERT_FALSE(readULEB128({0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01}, value, length));
+    // Overlong encodings with zero padding are valid
+    ZIK_ASSERT_TRUE(readULEB128({0x85, 0x80, 0x80, 0x00}, value, length));
+    ZIK_ASSERT_EQUAL(value, 5);
+    ZIK_ASSERT_EQUAL(length, 4);
+    ZIK_ASSERT_TRUE(readULEB128({0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00}, value, length));
+    ZIK_ASSERT_EQUAL(value, 0);
+    // Truncated
+    ZIK_ASSERT_FALSE(readULEB128({}, value, length));
+    ZIK_ASSERT_FALSE(readULEB128({0x80}, value, length));
+    ZIK_ASSERT_FALSE(readULEB128({0xff, 0xff}, value, length));
+    // The cursor is not advanced when failed
+    ZIK_ASSERT_EQUAL(length, 0);
+}
+
+// MARK: Trie
+
+ZIK_TEST(ZIKExportTrieTests, testFindInTrie) {
+    ExportTrieBuilder builder;
+    builder.addSymbol("_foo", 0x1000);
+    builder.addSymbol("_foobar", 0x1010);
+    builder.addSymbol("_food", 0x1020, macho::EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION);
+    builder.addSymbol("_bar", 0x1030);
+    builder.addSymbol("_tlv", 0x2000, macho::EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL);
+    builder.addSymbol("_absolute", 0xdeadbeef, macho::EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE);
+    builder.addStubAndResolver("_resolved", 0x1040, 0x1050);
+    std::vector<uint8_t> bytes = builder.build();
+    ExportTrie trie(bytes.data(), bytes.size());
+
+    MachOExport result;
+    ZIK_ASSERT_TRUE(trie.find("_foo", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1000);
+    ZIK_ASSERT_EQUAL(result.flags, 0);
+    ZIK_ASSERT_TRUE(trie.find("_foobar", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1010);
+    ZIK_ASSERT_TRUE(trie.find("_food", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1020);
+    ZIK_ASSERT_EQUAL(result.flags, macho::EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION);
+    ZIK_ASSERT_TRUE(trie.find("_bar", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1030);
+    ZIK_ASSERT_TRUE(trie.find("_tlv", result));
+    ZIK_ASSERT_EQUAL(result.flags & macho::EXPORT_SYMBOL_FLAGS_KIND_MASK, macho::EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL);
+    ZIK_ASSERT_TRUE(trie.find("_absolute", result));
+    ZIK_ASSERT_EQUAL(result.address, 0xdeadbeef);
+    ZIK_ASSERT_TRUE(trie.find("_resolved", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1040);
+    ZIK_ASSERT_EQUAL(result.resolver, 0x1050);
+
+    ZIK_ASSERT_FALSE(trie.find("_fo", result));
+    ZIK_ASSERT_FALSE(trie.find("_foob", result));
+    ZIK_ASSERT_FALSE(trie.find("_foobarx", result));
+    ZIK_ASSERT_FALSE(trie.find("foo", result));
+    ZIK_ASSERT_FALSE(trie.find("_", result));
+    ZIK_ASSERT_FALSE(trie.find("", result));
+    ZIK_ASSERT_FALSE(trie.find(nullptr, result));
+}
+
+ZIK_TEST(ZIKExportTrieTests, testReexports) {
+    ExportTrieBuilder builder;
+    builder.addReexport("_strlen", 1);
+    builder.addReexport("_renamed", 2, "_original");
+    std::vector<uint8_t> bytes = builder.build();
+    ExportTrie trie(bytes.data(), bytes.size());
+
+    MachOExport result;
+    ZIK_ASSERT_TRUE(trie.find("_strlen", result));
+    ZIK_ASSERT_TRUE(result.flags & macho::EXPORT_SYMBOL_FLAGS_REEXPORT);
+    ZIK_ASSERT_EQUAL(result.reexportOrdinal, 1);
+    ZIK_ASSERT_EQUAL(strcmp(result.reexportName, ""), 0);
+    ZIK_ASSERT_TRUE(trie.find("_renamed", result));
+    ZIK_ASSERT_EQUAL(result.reexportOrdinal, 2);
+    ZIK_ASSERT_EQUAL(strcmp(result.reexportName, "_original"), 0);
+}
+
+ZIK_TEST(ZIKExportTrieTests, testLargeTrie) {
+    // Child offsets and terminal sizes need multi-byte uleb128
+    ExportTrieBuilder builder;
+    const size_t count = 5000;
+    for (size_t i = 0; i < count; i++) {
+        builder.addSymbol("_$s7Feature" + std::to_string(i) + "C4nameSSvg", 0x100000000ULL + i * 16);
+    }
+    std::string longName(300, 'x');
+    builder.addReexport("_long", 3, longName);
+    std::vector<uint8_t> bytes = builder.build();
+    ZIK_ASSERT_TRUE(bytes.size() > 0x4000);
+    ExportTrie trie(bytes.data(), bytes.size());
+
+    MachOExport result;
+    for (size_t i = 0; i < count; i += 7) {
+        ZIK_ASSERT_TRUE(trie.find(("_$s7Feature" + std::to_string(i) + "C4nameSSvg").c_str(), result));
+        ZIK_ASSERT_EQUAL(result.address, 0x100000000ULL + i * 16);
+    }
+    ZIK_ASSERT_FALSE(trie.find("_$s7Feature5000C4nameSSvg", result));
+    ZIK_ASSERT_TRUE(trie.find("_long", result));
+    ZIK_ASSERT_EQUAL(std::string(result.reexportName), longName);
+}
+
+ZIK_TEST(ZIKExportTrieTests, testTruncatedTrie) {
+    ExportTrieBuilder builder;
+    for (size_t i = 0; i < 50; i++) {
+        builder.addSymbol("_symbol" + std::to_string(i), 0x1000 + i);
+    }
+    builder.addReexport("_reexport", 1, "_other");
+    std::vector<uint8_t> bytes = builder.build();
+    // Copy each prefix, so reading beyond it is detected by address sanitizer
+    for (size_t size = 0; size < bytes.size(); size++) {
+        std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+        ExportTrie trie(truncated.data(), truncated.size());
+        MachOExport result;
+        trie.find("_symbol49", result);
+        trie.find("_reexport", result);
+    }
+}
+
+ZIK_TEST(ZIKExportTrieTests, testBrokenTrie) {
+    MachOExport result;
+    // Root -> "_a" -> root
+    std::vector<uint8_t> cycle = {0x00, 0x01, '_', 'a', 0x00, 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(cycle.data(), cycle.size()).find("_a_a_a", result));
+    // Node whose child is itself
+    std::vector<uint8_t> selfLoop = {0x00, 0x01, '_', 0x00, 0x05, 0x00, 0x01, 'a', 0x00, 0x05};
+    ZIK_ASSERT_FALSE(ExportTrie(selfLoop.data(), selfLoop.size()).find("_aaaa", result));
+    // Empty edge label never consumes the name
+    std::vector<uint8_t> emptyEdge = {0x00, 0x01, 0x00, 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(emptyEdge.data(), emptyEdge.size()).find("_a", result));
+    // Child offset out of trie
+    std::vector<uint8_t> outOfRange = {0x00, 0x01, '_', 'a', 0x00, 0x7f};
+    ZIK_ASSERT_FALSE(ExportTrie(outOfRange.data(), outOfRange.size()).find("_a", result));
+    // Child count larger than edges
+    std::vector<uint8_t> missingEdges = {0x00, 0x09, '_', 'a', 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(missingEdges.data(), missingEdges.size()).find("_b", result));
+    // Terminal size larger than trie
+    std::vector<uint8_t> largeTerminal = {0x00, 0x01, '_', 'a', 0x00, 0x06, 0x10, 0x00, 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(largeTerminal.data(), largeTerminal.size()).find("_a", result));
+    // Terminal with truncated address
+    std::vector<uint8_t> badTerminal = {0x00, 0x01, '_', 'a', 0x00, 0x06, 0x02, 0x00, 0x80, 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(badTerminal.data(), badTerminal.size()).find("_a", result));
+    // Re-export name not terminated in terminal
+    std::vector<uint8_t> badReexport = {0x00, 0x01, '_', 'a', 0x00, 0x06, 0x03, 0x08, 0x01, 'x', 0x00};
+    ZIK_ASSERT_FALSE(ExportTrie(badReexport.data(), badReexport.size()).find("_a", result));
+    // The same terminal with correct size
+    std::vector<uint8_t> goodReexport = {0x00, 0x01, '_', 'a', 0x00, 0x06, 0x04, 0x08, 0x01, 'x', 0x00, 0x00};
+    ZIK_ASSERT_TRUE(ExportTrie(goodReexport.data(), goodReexport.size()).find("_a", result));
+    ZIK_ASSERT_EQUAL(strcmp(result.reexportName, "x"), 0);
+
+    ZIK_ASSERT_FALSE(ExportTrie().find("_a", result));
+}
+
+// MARK: Image
+
+static void checkImageWithDyldInfo(bool dyldInfo) {
+    ExportTrieBuilder builder;
+    builder.addSymbol("_main", 0x1000);
+    builder.addSymbol("_absolute", 0x42, macho::EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE);
+    builder.addReexport("_strlen", 2);
+    builder.addReexport("_renamed", 2, "_original");
+    builder.addReexport("_broken", 9);
+    std::vector<uint8_t> file = exportImage(builder.build(), dyldInfo, {{"/usr/lib/libobjc.A.dylib", macho::LC_LOAD_DYLIB}, {"/usr/lib/system/libsystem_c.dylib", macho::LC_REEXPORT_DYLIB}});
+
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    ExportTrie trie;
+    ZIK_ASSERT_TRUE(trie.parse(image));
+    MachOExport result;
+    ZIK_ASSERT_TRUE(trie.find("_main", result));
+    ZIK_ASSERT_EQUAL(result.address, 0x1000);
+    ZIK_ASSERT_EQUAL(strcmp(dependentDylibName(image, 1), "/usr/lib/libobjc.A.dylib"), 0);
+    ZIK_ASSERT_EQUAL(strcmp(dependentDylibName(image, 2), "/usr/lib/system/libsystem_c.dylib"), 0);
+    ZIK_ASSERT_TRUE(dependentDylibName(image, 0) == nullptr);
+    ZIK_ASSERT_TRUE(dependentDylibName(image, 3) == nullptr);
+
+    const void *header = file.data();
+    ZIKExportTrieEntry entry;
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_main", &entry), ZIKExportTrieStatusFound);
+    ZIK_ASSERT_EQUAL(entry.address, reinterpret_cast<uintptr_t>(header) + 0x1000);
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_absolute", &entry), ZIKExportTrieStatusFound);
+    ZIK_ASSERT_EQUAL(entry.address, 0x42);
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_strlen", &entry), ZIKExportTrieStatusReexport);
+    ZIK_ASSERT_EQUAL(strcmp(entry.reexportDylib, "/usr/lib/system/libsystem_c.dylib"), 0);
+    ZIK_ASSERT_EQUAL(strcmp(entry.reexportName, "_strlen"), 0);
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_renamed", &entry), ZIKExportTrieStatusReexport);
+    ZIK_ASSERT_EQUAL(strcmp(entry.reexportName, "_original"), 0);
+    // Library ordinal out of range
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_broken", &entry), ZIKExportTrieStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_local", &entry), ZIKExportTrieStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(header, "_main", NULL), ZIKExportTrieStatusFound);
+}
+
+ZIK_TEST(ZIKExportTrieTests, testImageWithExportsTrie) {
+    checkImageWithDyldInfo(false);
+}
+
+ZIK_TEST(ZIKExportTrieTests, testImageWithDyldInfo) {
+    checkImageWithDyldInfo(true);
+}
+
+ZIK_TEST(ZIKExportTrieTests, testImageWithoutTrie) {
+    std::vector<uint8_t> file = exportImage({}, false);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    ExportTrie trie;
+    ZIK_ASSERT_FALSE(trie.parse(image));
+    ZIK_ASSERT_EQUAL(ZIKExportTrieFindInLoadedImage(file.data(), "_main", NULL), ZIKExportTrieStatusUnavailable);
+
+    // Trie out of the file
+    ExportTrieBuilder builder;
+    builder.addSymbol("_main", 0x1000);
+    std::vector<uint8_t> bytes = builder.build();
+    file = exportImage(bytes, false);
+    file.resize(file.size() - 8);
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    ZIK_ASSERT_FALSE(trie.parse(image));
+}
+
+ZIK_TEST(ZIKExportTrieTests, testPerformanceTrieLookup) {
+    ExportTrieBuilder builder;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 200000; i++) {
+        names.push_back("_$s12SyntheticApp6Module" + std::to_string(i) + "C4nameSSvg");
+        builder.addSymbol(names.back(), 0x4000 + i * 16);
+    }
+    std::vector<uint8_t> bytes = builder.build();
+    ExportTrie trie(bytes.data(), bytes.size());
+    measure([&] {
+        MachOExport result;
+        for (size_t i = 0; i < names.size(); i += 10) {
+            ZIK_ASSERT_TRUE(trie.find(names[i].c_str(), result));
+        }
+    });
+}
@@ -0,0 +1,175 @@
+//
+//  ZIKFrozenRouteTableTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKFrozenRouteTable.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <stdio.h>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t kUUIDA[16] = {0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf};
+static const uint8_t kUUIDB[16] = {0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf};
+
+static std::vector<uint8_t> tableBytes() {
+    ZIKFrozenRouteTableBuilderRef builder = ZIKFrozenRouteTableBuilderCreate();
+    uint32_t imageA = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/A.framework/A", kUUIDA);
+    uint32_t imageB = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/B.framework/B", kUUIDB);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindDestinationProtocol, "ZIKServiceRouteRegistry", "AServiceInput", "AServiceRouter", imageA);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindModuleProtocol, "ZIKServiceRouteRegistry", "AServiceModuleInput", "AServiceModuleRouter", imageA);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindIdentifier, "ZIKViewRouteRegistry", "com.zuik.viewController.b", "BViewRouter", imageB);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindDestinationClass, "ZIKViewRouteRegistry", "BViewController", "BViewRouter", imageB);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindDestinationClass, "ZIKViewRouteRegistry", "BViewController", "BSubviewRouter", imageB);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindAdapter, "ZIKServiceRouteRegistry", "AServiceAdapter", "AServiceAdapterRouter", ZIKFrozenRouteTableNoImage);
+    // Duplicated entry
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindDestinationProtocol, "ZIKServiceRouteRegistry", "AServiceInput", "AServiceRouter", imageA);
+    size_t size = 0;
+    uint8_t *bytes = (uint8_t *)ZIKFrozenRouteTableBuilderCopyBytes(builder, &size);
+    ZIKFrozenRouteTableBuilderDestroy(builder);
+    std::vector<uint8_t> result(bytes, bytes + size);
+    free(bytes);
+    return result;
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testLookup) {
+    std::vector<uint8_t> bytes = tableBytes();
+    ZIKFrozenRouteTableError error;
+    ZIKFrozenRouteTableRef table = ZIKFrozenRouteTableCreateWithBytes(bytes.data(), bytes.size(), &error);
+    ZIK_ASSERT_TRUE(table != NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorNone);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableImageCount(table) == 2);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableEntryCount(table) == 6);
+
+    uint8_t uuid[16];
+    ZIK_ASSERT_TRUE(strcmp(ZIKFrozenRouteTableGetImage(table, 1, uuid), "@rpath/B.framework/B") == 0);
+    ZIK_ASSERT_TRUE(memcmp(uuid, kUUIDB, 16) == 0);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableGetImage(table, 2, uuid) == NULL);
+
+    uint32_t first = 0;
+    ZIKFrozenRouteEntry entry;
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindDestinationProtocol, "AServiceInput", &first) == 1);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableGetEntry(table, first, &entry));
+    ZIK_ASSERT_TRUE(strcmp(entry.value, "AServiceRouter") == 0);
+    ZIK_ASSERT_TRUE(strcmp(entry.registry, "ZIKServiceRouteRegistry") == 0);
+    ZIK_ASSERT_TRUE(entry.imageIndex == 0);
+
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindDestinationClass, "BViewController", &first) == 2);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableGetEntry(table, first, &entry));
+    ZIK_ASSERT_TRUE(strcmp(entry.value, "BSubviewRouter") == 0);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableGetEntry(table, first + 1, &entry));
+    ZIK_ASSERT_TRUE(strcmp(entry.value, "BViewRouter") == 0);
+
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindAdapter, "AServiceAdapter", &first) == 1);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableGetEntry(table, first, &entry));
+    ZIK_ASSERT_TRUE(entry.imageIndex == ZIKFrozenRouteTableNoImage);
+
+    // Same key with different kind
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindModuleProtocol, "AServiceInput", &first) == 0);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindIdentifier, "not.exist", &first) == 0);
+    ZIKFrozenRouteTableClose(table);
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testWriteAndOpenFile) {
+    std::string path = temporaryPath("ZIKFrozenRouteTableTests.table");
+    ZIKFrozenRouteTableBuilderRef builder = ZIKFrozenRouteTableBuilderCreate();
+    uint32_t image = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/A.framework/A", kUUIDA);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindIdentifier, "ZIKServiceRouteRegistry", "a", "AServiceRouter", image);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableBuilderWriteToFile(builder, path.c_str()));
+    ZIKFrozenRouteTableBuilderDestroy(builder);
+
+    ZIKFrozenRouteTableError error;
+    ZIKFrozenRouteTableRef table = ZIKFrozenRouteTableOpen(path.c_str(), &error);
+    ZIK_ASSERT_TRUE(table != NULL);
+    uint32_t first = 0;
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableLookup(table, ZIKFrozenRouteKindIdentifier, "a", &first) == 1);
+    ZIKFrozenRouteTableClose(table);
+    remove(path.c_str());
+
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableOpen(path.c_str(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorIO);
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testTruncation) {
+    std::vector<uint8_t> bytes = tableBytes();
+    ZIKFrozenRouteTableError error;
+    for (size_t size : {(size_t)0, (size_t)16, (size_t)63, (size_t)64, bytes.size() / 2, bytes.size() - 1}) {
+        ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(bytes.data(), size, &error) == NULL);
+        ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorTruncated);
+    }
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testCorruption) {
+    std::vector<uint8_t> bytes = tableBytes();
+    ZIKFrozenRouteTableError error;
+    // Flipping any byte after header breaks checksum.
+    for (size_t i = 64; i < bytes.size(); i++) {
+        std::vector<uint8_t> corrupted = bytes;
+        corrupted[i] ^= 0x5a;
+        ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(corrupted.data(), corrupted.size(), &error) == NULL);
+        ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorCorrupted);
+    }
+    // Extra bytes
+    std::vector<uint8_t> extended = bytes;
+    extended.push_back(0);
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(extended.data(), extended.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorCorrupted);
+
+    // Offsets out of bounds are rejected even with valid checksum.
+    std::vector<uint8_t> invalidOffset = bytes;
+    uint32_t entryCount = 1000;
+    memcpy(&invalidOffset[32], &entryCount, sizeof(entryCount));
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(invalidOffset.data(), invalidOffset.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorCorrupted);
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testVersionMismatch) {
+    std::vector<uint8_t> bytes = tableBytes();
+    ZIKFrozenRouteTableError error;
+    std::vector<uint8_t> newer = bytes;
+    uint32_t version = ZIKFrozenRouteTableVersion + 1;
+    memcpy(&newer[4], &version, sizeof(version));
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(newer.data(), newer.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorVersionMismatch);
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] ^= 0xff;
+    ZIK_ASSERT_TRUE(ZIKFrozenRouteTableCreateWithBytes(badMagic.data(), badMagic.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKFrozenRouteTableErrorBadMagic);
+}
+
+ZIK_TEST(ZIKFrozenRouteTableTests, testImageUUIDAndInstallName) {
+    MachOFixtureBuilder builder;
+    builder.setUUID(kUUIDA);
+    builder.setInstallName("@rpath/A.framework/A");
+    builder.addDylib("/usr/lib/libobjc.A.dylib");
+    std::vector<uint8_t> file = builder.build();
+
+    uint8_t uuid[16];
+    ZIK_ASSERT_TRUE(ZIKMachOImageCopyUUID(file.data(), uuid));
+    ZIK_ASSERT_TRUE(memcmp(uuid, kUUIDA, 16) == 0);
+    ZIK_ASSERT_TRUE(strcmp(ZIKMachOImageInstallName(file.data()), "@rpath/A.framework/A") == 0);
+
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    ZIK_ASSERT_TRUE(image.fileType() == macho::MH_DYLIB);
+
+    // Image without LC_UUID and LC_ID_DYLIB
+    MachOFixtureBuilder executable(true, macho::MH_EXECUTE);
+    std::vector<uint8_t> executableFile = executable.build();
+    ZIK_ASSERT_TRUE(!ZIKMachOImageCopyUUID(executableFile.data(), uuid));
+    ZIK_ASSERT_TRUE(ZIKMachOImageInstallName(executableFile.data()) == NULL);
+
+    // Load command out of bounds
+    std::vector<uint8_t> broken = file;
+    uint32_t sizeofcmds = 0x100000;
+    memcpy(&broken[20], &sizeofcmds, sizeof(sizeofcmds));
+    ZIK_ASSERT_TRUE(!image.parse(broken.data(), broken.size(), MachOImage::LayoutFile));
+}
@@ -0,0 +1,378 @@
+//
+//  ZIKImageImportFilterTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKImageImportFilter.h"
+#include "ZIKClassListScanner.h"
+#include "ZIKMachOFixups.h"
+#include "ZIKMachOImage.h"
+#include "ZIKObjCFixtureBuilder.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const char *const ZIKRouterInstallName = "@rpath/ZIKRouter.framework/ZIKRouter";
+static const char *const FoundationInstallName = "/System/Library/Frameworks/Foundation.framework/Foundation";
+
+static std::vector<std::string> routerRootClasses() {
+    return {"ZIKViewRouter", "ZIKServiceRouter"};
+}
+
+/// A framework with one class. Imports are `(symbol, library ordinal)`, and ordinals refer to dependencies.
+static std::vector<uint8_t> frameworkImage(ObjCFixtureBuilder::PointerFormat format, const std::string &installName, const std::vector<std::string> &dependencies, const std::vector<std::pair<std::string, int32_t>> &imports, uint32_t fileType = macho::MH_DYLIB) {
+    ObjCFixtureBuilder builder(format, fileType);
+    if (!installName.empty()) {
+        builder.machO().setInstallName(installName);
+    }
+    for (const std::string &dependency : dependencies) {
+        builder.machO().addDylib(dependency);
+    }
+    builder.addClass("Local" + std::to_string(imports.size()), "");
+    for (const std::pair<std::string, int32_t> &import : imports) {
+        builder.addImport(import.first, import.second);
+    }
+    return builder.build();
+}
+
+/// Fake objc classes in memory. Each class is {isa, superclass, cache, vtable, bits}.
+class FakeClasses {
+public:
+    explicit FakeClasses(size_t capacity) : storage_(capacity * 5, 0), count_(0) {}
+
+    uintptr_t addClass(uintptr_t superclass) {
+        uintptr_t *cls = &storage_[count_ * 5];
+        count_++;
+        cls[1] = superclass;
+        return reinterpret_cast<uintptr_t>(cls);
+    }
+
+private:
+    std::vector<uintptr_t> storage_;
+    size_t count_;
+};
+
+/// Chained fixups with imports only. Pointers are already fixed up in loaded images.
+static std::vector<uint8_t> importsOnlyFixups(const std::vector<std::pair<std::string, int32_t>> &imports) {
+    std::vector<uint8_t> blob(sizeof(macho::dyld_chained_fixups_header), 0);
+    macho::dyld_chained_fixups_header header = {0, static_cast<uint32_t>(blob.size()), 0, 0, static_cast<uint32_t>(imports.size()), macho::DYLD_CHAINED_IMPORT, 0};
+    // dyld_chained_starts_in_image without segments
+    MachOFixtureBuilder::append(blob, static_cast<uint32_t>(0));
+    header.imports_offset = static_cast<uint32_t>(blob.size());
+    std::vector<uint8_t> symbols(1, 0);
+    for (const std::pair<std::string, int32_t> &import : imports) {
+        uint32_t value = (static_cast<uint32_t>(import.second) & 0xff) | (static_cast<uint32_t>(symbols.size()) << 9);
+        MachOFixtureBuilder::append(blob, value);
+        symbols.insert(symbols.end(), import.first.begin(), import.first.end());
+        symbols.push_back(0);
+    }
+    header.symbols_offset = static_cast<uint32_t>(blob.size());
+    blob.insert(blob.end(), symbols.begin(), symbols.end());
+    memcpy(&blob[0], &header, sizeof(header));
+    return blob;
+}
+
+/// A dylib whose loaded content can be read at its own address, with class list and imports.
+static std::vector<uint8_t> loadedImage(const std::string &installName, const std::vector<std::string> &dependencies, const std::vector<uintptr_t> &classes, const std::vector<std::pair<std::string, int32_t>> &imports) {
+    MachOFixtureBuilder builder(sizeof(void *) == 8);
+    builder.setInstallName(installName);
+    for (const std::string &dependency : dependencies) {
+        builder.addDylib(dependency);
+    }
+    size_t section = builder.reserveSection("__DATA_CONST", "__objc_classlist", classes.size() * sizeof(void *), sizeof(void *));
+    builder.layout();
+    for (size_t i = 0; i < classes.size(); i++) {
+        builder.writePointer(section, i * sizeof(void *), classes[i]);
+    }
+    builder.setLinkeditData(macho::LC_DYLD_CHAINED_FIXUPS, importsOnlyFixups(imports));
+    return builder.build();
+}
+
+/// A synthetic app with 60 images and 5000 classes in each image. Only 6 feature frameworks import router classes, and 1% of their classes are routers. All classes are 6 levels deep.
+struct SyntheticApp {
+    static const size_t ImageCount = 60;
+    static const size_t ClassCount = 5000;
+    static const size_t FeatureCount = 6;
+
+    SyntheticApp() : classes(ImageCount * ClassCount + 8), routerCount(0) {
+        parent = classes.addClass(0);
+        uintptr_t viewRouter = classes.addClass(parent);
+        uintptr_t base = classes.addClass(0);
+        for (size_t i = 0; i < 4; i++) {
+            base = classes.addClass(base);
+        }
+        images.push_back(loadedImage(ZIKRouterInstallName, {FoundationInstallName}, {parent, viewRouter}, {{"_OBJC_CLASS_$_NSObject", 1}}));
+        routerCount++;
+        for (size_t i = 1; i < ImageCount; i++) {
+            bool isFeature = i <= FeatureCount;
+            std::vector<uintptr_t> list;
+            for (size_t j = 0; j < ClassCount; j++) {
+                if (isFeature && j % 100 == 0) {
+                    list.push_back(classes.addClass(viewRouter));
+                    routerCount++;
+                } else {
+                    list.push_back(classes.addClass(base));
+                }
+            }
+            std::vector<std::pair<std::string, int32_t>> imports = {{"_OBJC_CLASS_$_NSObject", 1}, {"_OBJC_CLASS_$_NSString", 1}, {"_objc_msgSend", 2}};
+            if (isFeature) {
+                imports.push_back({"_OBJC_CLASS_$_ZIKViewRouter", 3});
+            }
+            std::string installName = "@rpath/Pod" + std::to_string(i) + ".framework/Pod" + std::to_string(i);
+            images.push_back(loadedImage(installName, {FoundationInstallName, "/usr/lib/libobjc.A.dylib", ZIKRouterInstallName}, list, imports));
+        }
+        for (const std::vector<uint8_t> &image : images) {
+            headers.push_back(image.data());
+        }
+    }
+
+    FakeClasses classes;
+    uintptr_t parent;
+    size_t routerCount;
+    std::vector<std::vector<uint8_t>> images;
+    std::vector<const void *> headers;
+};
+
+ZIK_TEST(ZIKImageImportFilterTests, testParseImports) {
+    ObjCFixtureBuilder::PointerFormat formats[] = {ObjCFixtureBuilder::Classic, ObjCFixtureBuilder::Chained64, ObjCFixtureBuilder::Chained32};
+    for (ObjCFixtureBuilder::PointerFormat format : formats) {
+        ObjCFixtureBuilder builder(format);
+        builder.addClass("FeatureRouter", "ZIKViewRouter", false, 2);
+        builder.addImport("_OBJC_CLASS_$_Utility", 200);
+        builder.addImport("_OBJC_CLASS_$_Plugin", -2);
+        std::vector<uint8_t> bytes = builder.build();
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(bytes.data(), bytes.size(), MachOImage::LayoutFile));
+        MachOFixups fixups;
+        ZIK_ASSERT_TRUE(fixups.parseImports(image));
+        ZIK_ASSERT_TRUE(fixups.fixups().empty());
+        ZIK_ASSERT_EQUAL(fixups.imports().size(), (size_t)3);
+        for (const MachOImport &import : fixups.imports()) {
+            if (import.name == "_OBJC_CLASS_$_ZIKViewRouter") {
+                ZIK_ASSERT_EQUAL(import.libraryOrdinal, 2);
+            } else if (import.name == "_OBJC_CLASS_$_Utility") {
+                ZIK_ASSERT_EQUAL(import.libraryOrdinal, 200);
+            } else {
+                ZIK_ASSERT_TRUE(import.name == "_OBJC_CLASS_$_Plugin");
+                ZIK_ASSERT_EQUAL(import.libraryOrdinal, -2);
+            }
+        }
+        // Full parsing finds the same imports
+        MachOFixups fullFixups;
+        ZIK_ASSERT_TRUE(fullFixups.parse(image));
+        ZIK_ASSERT_EQUAL(fullFixups.imports().size(), (size_t)3);
+        ZIK_ASSERT_FALSE(fullFixups.fixups().empty());
+    }
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testRouterImports) {
+    ObjCFixtureBuilder::PointerFormat formats[] = {ObjCFixtureBuilder::Classic, ObjCFixtureBuilder::Chained64, ObjCFixtureBuilder::Chained32};
+    for (ObjCFixtureBuilder::PointerFormat format : formats) {
+        std::vector<uint8_t> router = frameworkImage(format, ZIKRouterInstallName, {FoundationInstallName}, {});
+        std::vector<uint8_t> feature = frameworkImage(format, "@rpath/Feature.framework/Feature", {FoundationInstallName, ZIKRouterInstallName}, {{"_OBJC_CLASS_$_ZIKViewRouter", 2}});
+        std::vector<uint8_t> service = frameworkImage(format, "@rpath/Service.framework/Service", {FoundationInstallName}, {{"_OBJC_CLASS_$_ZIKServiceRouter", 7}});
+        std::vector<uint8_t> utility = frameworkImage(format, "@rpath/Utility.framework/Utility", {FoundationInstallName}, {{"_OBJC_CLASS_$_NSString", 1}, {"_ZIKViewRouter", 1}});
+
+        ImageImportFilter filter(routerRootClasses());
+        const std::vector<uint8_t> *images[] = {&router, &feature, &service, &utility};
+        for (const std::vector<uint8_t> *bytes : images) {
+            MachOImage image;
+            ZIK_ASSERT_TRUE(image.parse(bytes->data(), bytes->size(), MachOImage::LayoutFile));
+            filter.addImage(image, bytes == &router);
+        }
+        filter.resolve();
+        ZIK_ASSERT_EQUAL(filter.imageCount(), (size_t)4);
+        ZIK_ASSERT_TRUE(filter.isCandidate(0));
+        ZIK_ASSERT_TRUE(filter.isCandidate(1));
+        // Root classes are matched by name, even when the ordinal can't be resolved
+        ZIK_ASSERT_TRUE(filter.isCandidate(2));
+        // Only class symbols count
+        ZIK_ASSERT_FALSE(filter.isCandidate(3));
+    }
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testSubclassOfRouterInOtherImage) {
+    ObjCFixtureBuilder::PointerFormat format = ObjCFixtureBuilder::Chained64;
+    std::vector<uint8_t> router = frameworkImage(format, ZIKRouterInstallName, {}, {});
+    std::vector<uint8_t> base = frameworkImage(format, "@rpath/Base.framework/Base", {ZIKRouterInstallName}, {{"_OBJC_CLASS_$_ZIKViewRouteAdapter", 1}});
+    std::vector<uint8_t> feature = frameworkImage(format, "@rpath/Feature.framework/Feature", {FoundationInstallName, "@rpath/Base.framework/Base"}, {{"_OBJC_CLASS_$_BaseRouter", 2}});
+    std::vector<uint8_t> utility = frameworkImage(format, "@rpath/Utility.framework/Utility", {}, {});
+    std::vector<uint8_t> other = frameworkImage(format, "@rpath/Other.framework/Other", {"@rpath/Utility.framework/Utility"}, {{"_OBJC_CLASS_$_UtilityObject", 1}, {"_OBJC_CLASS_$_Local", 0}});
+
+    // Dependents are before their dependencies, as in dyld's image list
+    ImageImportFilter filter(routerRootClasses());
+    const std::vector<uint8_t> *images[] = {&feature, &other, &base, &utility, &router};
+    for (const std::vector<uint8_t> *bytes : images) {
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(bytes->data(), bytes->size(), MachOImage::LayoutFile));
+        filter.addImage(image, bytes == &router);
+    }
+    filter.resolve();
+    ZIK_ASSERT_TRUE(filter.isCandidate(0));
+    ZIK_ASSERT_FALSE(filter.isCandidate(1));
+    ZIK_ASSERT_TRUE(filter.isCandidate(2));
+    ZIK_ASSERT_FALSE(filter.isCandidate(3));
+    ZIK_ASSERT_TRUE(filter.isCandidate(4));
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testSpecialOrdinals) {
+    ObjCFixtureBuilder::PointerFormat format = ObjCFixtureBuilder::Classic;
+    std::vector<uint8_t> router = frameworkImage(format, ZIKRouterInstallName, {}, {});
+    std::vector<uint8_t> app = frameworkImage(format, "", {ZIKRouterInstallName}, {{"_OBJC_CLASS_$_ZIKViewRouter", 1}}, macho::MH_EXECUTE);
+    std::vector<uint8_t> plugin = frameworkImage(format, "", {}, {{"_OBJC_CLASS_$_AppRouter", -1}}, macho::MH_BUNDLE);
+    std::vector<uint8_t> flat = frameworkImage(format, "@rpath/Flat.framework/Flat", {}, {{"_OBJC_CLASS_$_Anything", -2}});
+    std::vector<uint8_t> selfImport = frameworkImage(format, "@rpath/Self.framework/Self", {}, {{"_OBJC_CLASS_$_Self", 0}});
+
+    ImageImportFilter filter(routerRootClasses());
+    const std::vector<uint8_t> *images[] = {&plugin, &flat, &selfImport, &app, &router};
+    for (const std::vector<uint8_t> *bytes : images) {
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(bytes->data(), bytes->size(), MachOImage::LayoutFile));
+        filter.addImage(image, bytes == &router);
+    }
+    filter.resolve();
+    // Classes from main executable
+    ZIK_ASSERT_TRUE(filter.isCandidate(0));
+    // Flat lookup can find classes in any image
+    ZIK_ASSERT_TRUE(filter.isCandidate(1));
+    ZIK_ASSERT_FALSE(filter.isCandidate(2));
+    ZIK_ASSERT_TRUE(filter.isCandidate(3));
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testReexportedRouterFramework) {
+    ObjCFixtureBuilder::PointerFormat format = ObjCFixtureBuilder::Chained64Offset;
+    std::vector<uint8_t> router = frameworkImage(format, ZIKRouterInstallName, {}, {});
+    ObjCFixtureBuilder umbrellaBuilder(format);
+    umbrellaBuilder.machO().setInstallName("@rpath/Umbrella.framework/Umbrella");
+    umbrellaBuilder.machO().addDylib(FoundationInstallName);
+    umbrellaBuilder.machO().addDylib(ZIKRouterInstallName, macho::LC_REEXPORT_DYLIB);
+    std::vector<uint8_t> umbrella = umbrellaBuilder.build();
+    // Symbols of ZIKRouter are bound to the umbrella
+    std::vector<uint8_t> feature = frameworkImage(format, "@rpath/Feature.framework/Feature", {"@rpath/Umbrella.framework/Umbrella"}, {{"_OBJC_CLASS_$_ZIKViewRouteAdapter", 1}});
+
+    ImageImportFilter filter(routerRootClasses());
+    const std::vector<uint8_t> *images[] = {&feature, &umbrella, &router};
+    for (const std::vector<uint8_t> *bytes : images) {
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(bytes->data(), bytes->size(), MachOImage::LayoutFile));
+        filter.addImage(image, bytes == &router);
+    }
+    filter.resolve();
+    ZIK_ASSERT_TRUE(filter.isCandidate(0));
+    ZIK_ASSERT_TRUE(filter.isCandidate(1));
+    ZIK_ASSERT_TRUE(filter.isCandidate(2));
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testBrokenImages) {
+    ObjCFixtureBuilder builder(ObjCFixtureBuilder::Chained64);
+    builder.addClass("Router", "ZIKViewRouter");
+    std::vector<uint8_t> bytes = builder.build();
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(bytes.data(), bytes.size(), MachOImage::LayoutFile));
+    // Break fixups version
+    const macho::linkedit_data_command *command = reinterpret_cast<const macho::linkedit_data_command *>(image.findLoadCommand(macho::LC_DYLD_CHAINED_FIXUPS, sizeof(macho::linkedit_data_command)));
+    ZIK_ASSERT_TRUE(command != NULL);
+    bytes[command->dataoff] = 0xff;
+    ZIK_ASSERT_TRUE(image.parse(bytes.data(), bytes.size(), MachOImage::LayoutFile));
+
+    ImageImportFilter filter(routerRootClasses());
+    filter.addImage(image, false);
+    filter.addImage(MachOImage(), false);
+    filter.resolve();
+    ZIK_ASSERT_TRUE(filter.isCandidate(0));
+    ZIK_ASSERT_TRUE(filter.isCandidate(1));
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testFindCandidatesInLoadedImages) {
+    FakeClasses classes(8);
+    uintptr_t parent = classes.addClass(0);
+    uintptr_t router = classes.addClass(parent);
+    uintptr_t other = classes.addClass(0);
+    std::vector<uint8_t> routerImage = loadedImage(ZIKRouterInstallName, {}, {parent}, {});
+    std::vector<uint8_t> feature = loadedImage("@rpath/Feature.framework/Feature", {ZIKRouterInstallName}, {router}, {{"_OBJC_CLASS_$_ZIKRouter", 1}});
+    std::vector<uint8_t> utility = loadedImage("@rpath/Utility.framework/Utility", {FoundationInstallName}, {other}, {{"_OBJC_CLASS_$_NSObject", 1}});
+    const char *rootClassNames[] = {"ZIKRouter"};
+    bool results[2] = {false, true};
+
+    // The defining image is not in the list
+    const void *headers[] = {feature.data(), utility.data()};
+    ZIKImageImportFilterFindCandidates(headers, 2, routerImage.data(), rootClassNames, 0, results);
+    ZIK_ASSERT_TRUE(results[0]);
+    ZIK_ASSERT_FALSE(results[1]);
+
+    ZIKImageImportFilterFindCandidates(headers, 2, NULL, rootClassNames, 1, results);
+    ZIK_ASSERT_TRUE(results[0]);
+    ZIK_ASSERT_FALSE(results[1]);
+}
+
+ZIK_TEST(ZIKImageImportFilterTests, testSyntheticAppFindsAllRouters) {
+    SyntheticApp app;
+    bool candidates[SyntheticApp::ImageCount];
+    const char *rootClassNames[] = {"ZIKViewRouter", "ZIKServiceRouter"};
+    ZIKImageImportFilterFindCandidates(app.headers.data(), app.headers.size(), app.headers[0], rootClassNames, 2, candidates);
+    std::vector<const void *> candidateHeaders;
+    for (size_t i = 0; i < SyntheticApp::ImageCount; i++) {
+        ZIK_ASSERT_EQUAL(candidates[i], i <= SyntheticApp::FeatureCount);
+        if (candidates[i]) {
+            candidateHeaders.push_back(app.headers[i]);
+        }
+    }
+    size_t count = 0;
+    const void **found = ZIKClassListCopySubclasses(candidateHeaders.data(), candidateHeaders.size(), reinterpret_cast<const void *>(app.parent), NULL, NULL, &count);
+    ZIK_ASSERT_EQUAL(count, app.routerCount);
+    size_t allCount = 0;
+    const void **all = ZIKClassListCopySubclasses(app.headers.data(), app.headers.size(), reinterpret_cast<const void *>(app.parent), NULL, NULL, &allCount);
+    ZIK_ASSERT_EQUAL(allCount, count);
+    ZIK_ASSERT_TRUE(std::equal(found, found + count, all));
+    free(found);
+    free(all);
+}
+
+/// Scan all 60 images, as before filtering.
+ZIK_TEST(ZIKImageImportFilterTests, testPerformanceScanAllImages) {
+    SyntheticApp app;
+    measure([&] {
+        size_t count = 0;
+        const void **found = ZIKClassListCopySubclasses(app.headers.data(), app.headers.size(), reinterpret_cast<const void *>(app.parent), NULL, NULL, &count);
+        ZIK_ASSERT_EQUAL(count, app.routerCount);
+        free(found);
+    });
+}
+
+/// Filter 60 images by imports, then scan 7 candidates.
+ZIK_TEST(ZIKImageImportFilterTests, testPerformanceFilterThenScan) {
+    SyntheticApp app;
+    const char *rootClassNames[] = {"ZIKViewRouter", "ZIKServiceRouter"};
+    measure([&] {
+        bool candidates[SyntheticApp::ImageCount];
+        ZIKImageImportFilterFindCandidates(app.headers.data(), app.headers.size(), app.headers[0], rootClassNames, 2, candidates);
+        std::vector<const void *> candidateHeaders;
+        for (size_t i = 0; i < SyntheticApp::ImageCount; i++) {
+            if (candidates[i]) {
+                candidateHeaders.push_back(app.headers[i]);
+            }
+        }
+        size_t count = 0;
+        const void **found = ZIKClassListCopySubclasses(candidateHeaders.data(), candidateHeaders.size(), reinterpret_cast<const void *>(app.parent), NULL, NULL, &count);
+        ZIK_ASSERT_EQUAL(count, app.routerCount);
+        free(found);
+    });
+}
+
+/// Only the filter.
+ZIK_TEST(ZIKImageImportFilterTests, testPerformanceFilter) {
+    SyntheticApp app;
+    const char *rootClassNames[] = {"ZIKViewRouter", "ZIKServiceRouter"};
+    measure([&] {
+        bool candidates[SyntheticApp::ImageCount];
+        ZIKImageImportFilterFindCandidates(app.headers.data(), app.headers.size(), app.headers[0], rootClassNames, 2, candidates);
+        ZIK_ASSERT_TRUE(candidates[1]);
+    });
+}
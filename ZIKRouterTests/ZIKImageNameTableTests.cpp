@@ -0,0 +1,208 @@
+//
+//  ZIKImageNameTableTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKImageNameTable.h"
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+/// Fake header of an image.
+static const void *header(uintptr_t index) {
+    return reinterpret_cast<const void *>(0x100000000 + index * 0x10000);
+}
+
+/// Compare all paths in order, like ZIKGetImageByName without cache.
+static const void *linearFind(const std::vector<std::pair<const void *, std::string>> &images, const std::string &name) {
+    for (const auto &image : images) {
+        if (ImageNameTable::pathHasSuffix(image.second, name)) {
+            return image.first;
+        }
+    }
+    return nullptr;
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testSuffix) {
+    ZIK_ASSERT_TRUE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "libswiftCore.dylib"));
+    ZIK_ASSERT_TRUE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "Core.dylib"));
+    ZIK_ASSERT_TRUE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "swift/libswiftCore.dylib"));
+    ZIK_ASSERT_TRUE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "/usr/lib/swift/libswiftCore.dylib"));
+    ZIK_ASSERT_TRUE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", ""));
+    ZIK_ASSERT_FALSE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "libswiftCore"));
+    ZIK_ASSERT_FALSE(ImageNameTable::pathHasSuffix("/usr/lib/swift/libswiftCore.dylib", "libswiftcore.dylib"));
+    ZIK_ASSERT_FALSE(ImageNameTable::pathHasSuffix("Core.dylib", "/usr/lib/swift/libswiftCore.dylib"));
+    ZIK_ASSERT_FALSE(ImageNameTable::pathHasSuffix("", "a"));
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testFindFirstImageInOrder) {
+    ImageNameTable table;
+    table.addImage(header(0), "/var/containers/Bundle/Application/A/Demo.app/Demo", 0x1000);
+    table.addImage(header(1), "/var/containers/Bundle/Application/A/Demo.app/Frameworks/ZRouter.framework/ZRouter", 0x2000);
+    table.addImage(header(2), "/var/containers/Bundle/Application/A/Demo.app/Frameworks/libswiftCore.dylib", 0x3000);
+    table.addImage(header(3), "/usr/lib/swift/libswiftCore.dylib", 0x4000);
+    table.addImage(header(4), "/System/Library/Frameworks/Foundation.framework/Foundation", 0x5000);
+    ZIK_ASSERT_EQUAL(table.imageCount(), 5);
+
+    const void *found = nullptr;
+    intptr_t slide = 0;
+    ZIK_ASSERT_TRUE(table.find("libswiftCore.dylib", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(2));
+    ZIK_ASSERT_EQUAL(slide, 0x3000);
+    ZIK_ASSERT_TRUE(table.find("/usr/lib/swift/libswiftCore.dylib", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(3));
+    ZIK_ASSERT_TRUE(table.find("ZRouter", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(1));
+    ZIK_ASSERT_TRUE(table.find("ZRouter.framework/ZRouter", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(1));
+    ZIK_ASSERT_TRUE(table.find("Demo", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(0));
+    // Empty name matches the first image, the same as comparing suffix
+    ZIK_ASSERT_TRUE(table.find("", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(0));
+    ZIK_ASSERT_FALSE(table.find("UIKit", found, slide));
+    ZIK_ASSERT_FALSE(table.find("zrouter", found, slide));
+    ZIK_ASSERT_FALSE(table.find(nullptr, found, slide));
+    ZIK_ASSERT_EQUAL(table.cachedNameCount(), 8);
+
+    // Cached results are the same
+    ZIK_ASSERT_TRUE(table.find("libswiftCore.dylib", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(2));
+    ZIK_ASSERT_EQUAL(table.cachedNameCount(), 8);
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testAddAndRemoveImages) {
+    ImageNameTable table;
+    table.addImage(header(0), "/app/Demo", 0);
+    const void *found = nullptr;
+    intptr_t slide = 0;
+    ZIK_ASSERT_FALSE(table.find("Plugin.framework/Plugin", found, slide));
+    ZIK_ASSERT_FALSE(table.find("Plugin", found, slide));
+
+    // Names not found before are found in the new image
+    table.addImage(header(1), "/app/Frameworks/Plugin.framework/Plugin", 0x1000);
+    ZIK_ASSERT_TRUE(table.find("Plugin.framework/Plugin", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(1));
+    ZIK_ASSERT_EQUAL(slide, 0x1000);
+    // A later image doesn't replace the first one
+    table.addImage(header(2), "/app/Frameworks/Other.framework/Plugin", 0x2000);
+    ZIK_ASSERT_TRUE(table.find("Plugin", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(1));
+    // Adding the same header again is ignored
+    table.addImage(header(1), "/app/Frameworks/Moved.framework/Moved", 0x3000);
+    ZIK_ASSERT_EQUAL(table.imageCount(), 3);
+
+    // Names resolved to the removed image fall back to the next image
+    table.removeImage(header(1));
+    ZIK_ASSERT_EQUAL(table.imageCount(), 2);
+    ZIK_ASSERT_TRUE(table.find("Plugin", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(2));
+    ZIK_ASSERT_EQUAL(slide, 0x2000);
+    ZIK_ASSERT_FALSE(table.find("Plugin.framework/Plugin", found, slide));
+    table.removeImage(header(2));
+    ZIK_ASSERT_FALSE(table.find("Plugin", found, slide));
+    ZIK_ASSERT_TRUE(table.find("Demo", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(0));
+    // Removing unknown images does nothing
+    table.removeImage(header(9));
+    ZIK_ASSERT_EQUAL(table.imageCount(), 1);
+
+    // Another image loaded at the address of an unloaded image is after all images
+    table.addImage(header(1), "/app/Frameworks/Plugin.framework/Plugin", 0x4000);
+    ZIK_ASSERT_TRUE(table.find("Plugin", found, slide));
+    ZIK_ASSERT_EQUAL(found, header(1));
+    ZIK_ASSERT_EQUAL(slide, 0x4000);
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testMatchesLinearSearch) {
+    std::mt19937 random(42);
+    const char *directories[] = {"/app/", "/app/Frameworks/", "/usr/lib/", "/usr/lib/swift/", "/System/Library/Frameworks/"};
+    const char *names[] = {"Demo", "ZRouter", "ZIKRouter", "libswiftCore.dylib", "libswiftFoundation.dylib", "Router", "Core.dylib", "libobjc.A.dylib"};
+    ImageNameTable table;
+    std::vector<std::pair<const void *, std::string>> images;
+    uintptr_t nextHeader = 0;
+    for (size_t step = 0; step < 5000; step++) {
+        uint32_t action = random() % 10;
+        if (action < 3 || images.empty()) {
+            std::string path = std::string(directories[random() % 5]) + names[random() % 8];
+            const void *added = header(nextHeader++ % 64);
+            bool exists = false;
+            for (const auto &image : images) {
+                exists = exists || image.first == added;
+            }
+            table.addImage(added, path.c_str(), 0);
+            if (!exists) {
+                images.push_back(std::make_pair(added, path));
+            }
+        } else if (action < 5) {
+            size_t index = random() % images.size();
+            table.removeImage(images[index].first);
+            images.erase(images.begin() + index);
+        } else {
+            std::string name = names[random() % 8];
+            if (random() % 2 == 0) {
+                name = std::string(directories[random() % 5]).substr(1) + name;
+            }
+            const void *found = nullptr;
+            intptr_t slide = 0;
+            bool result = table.find(name.c_str(), found, slide);
+            const void *expected = linearFind(images, name);
+            ZIK_ASSERT_EQUAL(result, expected != nullptr);
+            ZIK_ASSERT_EQUAL(result ? found : nullptr, expected);
+        }
+    }
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testConcurrentAccess) {
+    ZIKImageNameTableRef table = ZIKImageNameTableCreate();
+    ZIKImageNameTableAddImage(table, header(0), "/app/Demo", 0x10);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([=]() {
+            for (uintptr_t i = 1; i < 500; i++) {
+                std::string path = "/app/Frameworks/F" + std::to_string(t) + "_" + std::to_string(i);
+                ZIKImageNameTableAddImage(table, header(t * 1000 + i), path.c_str(), 0);
+                ZIKImageNameTableFind(table, ("F" + std::to_string(t) + "_" + std::to_string(i - 1)).c_str(), NULL);
+                if (i % 3 == 0) {
+                    ZIKImageNameTableRemoveImage(table, header(t * 1000 + i));
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    intptr_t slide = 0;
+    ZIK_ASSERT_EQUAL(ZIKImageNameTableFind(table, "Demo", &slide), header(0));
+    ZIK_ASSERT_EQUAL(slide, 0x10);
+    ZIK_ASSERT_TRUE(ZIKImageNameTableFind(table, "F0_1", NULL) == header(1));
+    ZIK_ASSERT_TRUE(ZIKImageNameTableFind(table, "F0_3", NULL) == NULL);
+    ZIK_ASSERT_TRUE(ZIKImageNameTableFind(NULL, "Demo", NULL) == NULL);
+    ZIKImageNameTableDestroy(table);
+}
+
+ZIK_TEST(ZIKImageNameTableTests, testPerformanceCachedLookup) {
+    ImageNameTable table;
+    for (uintptr_t i = 0; i < 600; i++) {
+        std::string path = "/System/Library/Frameworks/Framework" + std::to_string(i) + ".framework/Framework" + std::to_string(i);
+        table.addImage(header(i), path.c_str(), 0);
+    }
+    table.addImage(header(600), "/usr/lib/swift/libswiftCore.dylib", 0);
+    measure([&] {
+        const void *found = nullptr;
+        intptr_t slide = 0;
+        for (size_t i = 0; i < 100000; i++) {
+            table.find("libswiftCore.dylib", found, slide);
+        }
+        ZIK_ASSERT_EQUAL(found, header(600));
+    });
+}
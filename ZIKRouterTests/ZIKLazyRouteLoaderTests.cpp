@@ -0,0 +1,248 @@
+//
+//  ZIKLazyRouteLoaderTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKLazyRouteLoader.h"
+#include <atomic>
+#include <chrono>
+#include <dlfcn.h>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#ifdef __APPLE__
+#include <TargetConditionals.h>
+#endif
+
+using namespace zix;
+
+#ifdef __APPLE__
+static const char *const SystemLibraryPath = "/usr/lib/libSystem.B.dylib";
+#else
+static const char *const SystemLibraryPath = "libc.so.6";
+#endif
+
+/// Records callbacks, like registry registering routers in the loaded library.
+struct LoadRecorder {
+    std::atomic<int> loadedCount{0};
+    std::atomic<bool> registered{false};
+    std::mutex mutex;
+    std::string routerName;
+    void *symbolAddress = nullptr;
+    int sleepMilliseconds = 0;
+    LazyRouteLoader *loader = nullptr;
+    /// Key looked up again in the callback.
+    const char *nestedKey = nullptr;
+    ZIKLazyRouteStatus nestedStatus = ZIKLazyRouteStatusNotFound;
+};
+
+static void recordLoaded(void *context, const ZIKLazyRoute *route, void *symbolAddress) {
+    LoadRecorder *recorder = static_cast<LoadRecorder *>(context);
+    {
+        std::lock_guard<std::mutex> lock(recorder->mutex);
+        recorder->routerName = route->routerName;
+        recorder->symbolAddress = symbolAddress;
+    }
+    if (recorder->sleepMilliseconds > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(recorder->sleepMilliseconds));
+    }
+    if (recorder->nestedKey) {
+        recorder->nestedStatus = recorder->loader->load(1, recorder->nestedKey, nullptr);
+    }
+    recorder->loadedCount++;
+    recorder->registered.store(true);
+}
+
+#if !defined(__APPLE__) || TARGET_OS_OSX
+/// Build a small shared object with a compiler on the host. Return an empty string if there is no compiler.
+static std::string buildFixtureLibrary(const char *name) {
+    const char *compiler = getenv("CC");
+    if (compiler == nullptr || compiler[0] == '\0') {
+        compiler = "cc";
+    }
+    std::string directory = "/tmp";
+    const char *temporaryDirectory = getenv("TMPDIR");
+    if (temporaryDirectory && temporaryDirectory[0] != '\0') {
+        directory = temporaryDirectory;
+    }
+    std::string base = directory + "/" + name + "_" + std::to_string(getpid());
+    std::string source = base + ".c";
+    std::string library = base + ".so";
+    FILE *file = fopen(source.c_str(), "w");
+    if (file == nullptr) {
+        return std::string();
+    }
+    fputs("#include <unistd.h>\n"
+          "int ZIKLazyFixtureLoadCount = 0;\n"
+          "__attribute__((constructor)) static void ZIKLazyFixtureLoad(void) {\n"
+          "    usleep(20000);\n"
+          "    ZIKLazyFixtureLoadCount++;\n"
+          "}\n", file);
+    fclose(file);
+    std::string command = std::string(compiler) + " -shared -fPIC -o " + library + " " + source + " 2>/dev/null";
+    int result = system(command.c_str());
+    unlink(source.c_str());
+    if (result != 0) {
+        return std::string();
+    }
+    return library;
+}
+#endif
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testAddRoute) {
+    LazyRouteLoader loader(nullptr, nullptr);
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "FeatureViewInput", SystemLibraryPath, "FeatureViewRouter", nullptr));
+    ZIK_ASSERT_FALSE(loader.addRoute(1, "FeatureViewInput", SystemLibraryPath, "OtherRouter", nullptr));
+    // Same key of another kind is another route
+    ZIK_ASSERT_TRUE(loader.addRoute(3, "FeatureViewInput", SystemLibraryPath, "FeatureViewRouter", nullptr));
+    ZIK_ASSERT_FALSE(loader.addRoute(1, nullptr, SystemLibraryPath, "FeatureViewRouter", nullptr));
+    ZIK_ASSERT_FALSE(loader.addRoute(1, "Missing", nullptr, "FeatureViewRouter", nullptr));
+    ZIK_ASSERT_EQUAL(loader.routeCount(), 2u);
+    ZIK_ASSERT_EQUAL(loader.load(1, "Unknown", nullptr), ZIKLazyRouteStatusNotFound);
+    ZIK_ASSERT_EQUAL(loader.load(2, "FeatureViewInput", nullptr), ZIKLazyRouteStatusNotFound);
+}
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testLoadSystemLibrary) {
+    LoadRecorder recorder;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "StringService", SystemLibraryPath, "StringRouter", "strlen"));
+    void *handle = dlopen(SystemLibraryPath, RTLD_NOW);
+    void *expected = dlsym(handle, "strlen");
+    void *address = nullptr;
+    ZIK_ASSERT_EQUAL(loader.load(1, "StringService", &address), ZIKLazyRouteStatusLoaded);
+    ZIK_ASSERT_EQUAL(address, expected);
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 1);
+    ZIK_ASSERT_TRUE(recorder.routerName == "StringRouter");
+    ZIK_ASSERT_EQUAL(recorder.symbolAddress, address);
+
+    // Later lookups don't load again
+    address = nullptr;
+    ZIK_ASSERT_EQUAL(loader.load(1, "StringService", &address), ZIKLazyRouteStatusAlreadyLoaded);
+    ZIK_ASSERT_EQUAL(address, expected);
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 1);
+    ZIK_ASSERT_TRUE(loader.error(1, "StringService") == nullptr);
+    dlclose(handle);
+}
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testLoadWithoutSymbol) {
+    LoadRecorder recorder;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(loader.addRoute(3, "feature://page", SystemLibraryPath, "PageRouter", nullptr));
+    void *address = &recorder;
+    ZIK_ASSERT_EQUAL(loader.load(3, "feature://page", &address), ZIKLazyRouteStatusLoaded);
+    ZIK_ASSERT_TRUE(address == nullptr);
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 1);
+}
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testFailedLoadIsNotRetried) {
+    LoadRecorder recorder;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "MissingLibrary", "/nonexistent/ZIKLazyFeature.framework/ZIKLazyFeature", "MissingRouter", nullptr));
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "MissingSymbol", SystemLibraryPath, "MissingRouter", "ZIKLazyRouteMissingSymbol"));
+    ZIK_ASSERT_EQUAL(loader.load(1, "MissingLibrary", nullptr), ZIKLazyRouteStatusFailed);
+    ZIK_ASSERT_EQUAL(loader.load(1, "MissingSymbol", nullptr), ZIKLazyRouteStatusFailed);
+    ZIK_ASSERT_TRUE(loader.error(1, "MissingLibrary") != nullptr);
+    ZIK_ASSERT_TRUE(loader.error(1, "MissingSymbol") != nullptr);
+    ZIK_ASSERT_EQUAL(loader.load(1, "MissingLibrary", nullptr), ZIKLazyRouteStatusFailed);
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 0);
+}
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testLookupInLoadedCallback) {
+    LoadRecorder recorder;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    recorder.loader = &loader;
+    recorder.nestedKey = "ReentrantService";
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "ReentrantService", SystemLibraryPath, "ReentrantRouter", nullptr));
+    // Looking up the loading key in the loading thread returns instead of waiting for itself
+    ZIK_ASSERT_EQUAL(loader.load(1, "ReentrantService", nullptr), ZIKLazyRouteStatusLoaded);
+    ZIK_ASSERT_EQUAL(recorder.nestedStatus, ZIKLazyRouteStatusLoading);
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 1);
+}
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testConcurrentLoadsWaitForRegistration) {
+    LoadRecorder recorder;
+    recorder.sleepMilliseconds = 30;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "ConcurrentService", SystemLibraryPath, "ConcurrentRouter", "strlen"));
+    const size_t threadCount = 8;
+    std::vector<ZIKLazyRouteStatus> statuses(threadCount, ZIKLazyRouteStatusNotFound);
+    std::vector<int> registeredWhenReturned(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.push_back(std::thread([&, i] {
+            statuses[i] = loader.load(1, "ConcurrentService", nullptr);
+            registeredWhenReturned[i] = recorder.registered.load();
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 1);
+    for (size_t i = 0; i < threadCount; i++) {
+        // Threads arriving after loading see it's already loaded
+        ZIK_ASSERT_TRUE(statuses[i] == ZIKLazyRouteStatusLoaded || statuses[i] == ZIKLazyRouteStatusAlreadyLoaded);
+        ZIK_ASSERT_TRUE(registeredWhenReturned[i]);
+    }
+}
+
+#if !defined(__APPLE__) || TARGET_OS_OSX
+ZIK_TEST(ZIKLazyRouteLoaderTests, testLoadBuiltLibraryOnce) {
+    std::string library = buildFixtureLibrary("ZIKLazyRouteFixture");
+    if (library.empty()) {
+        fprintf(stderr, "Skip %s, no compiler to build fixture library\n", __func__);
+        return;
+    }
+    LoadRecorder recorder;
+    LazyRouteLoader loader(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(loader.addRoute(1, "FixtureService", library.c_str(), "FixtureRouter", "ZIKLazyFixtureLoadCount"));
+    ZIK_ASSERT_TRUE(loader.addRoute(3, "fixture", library.c_str(), "FixtureRouter", "ZIKLazyFixtureLoadCount"));
+    std::vector<std::thread> threads;
+    std::vector<void *> addresses(6, nullptr);
+    for (size_t i = 0; i < addresses.size(); i++) {
+        threads.push_back(std::thread([&, i] {
+            loader.load(i % 2 ? 3 : 1, i % 2 ? "fixture" : "FixtureService", &addresses[i]);
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    // Each key is loaded once, and the library's constructor runs once
+    ZIK_ASSERT_EQUAL(recorder.loadedCount.load(), 2);
+    int *loadCount = static_cast<int *>(addresses[0]);
+    ZIK_ASSERT_TRUE(loadCount != nullptr);
+    for (void *address : addresses) {
+        ZIK_ASSERT_EQUAL(address, (void *)loadCount);
+    }
+    if (loadCount) {
+        ZIK_ASSERT_EQUAL(*loadCount, 1);
+    }
+    unlink(library.c_str());
+}
+#endif
+
+ZIK_TEST(ZIKLazyRouteLoaderTests, testCAPI) {
+    LoadRecorder recorder;
+    ZIKLazyRouteLoaderRef loader = ZIKLazyRouteLoaderCreate(recordLoaded, &recorder);
+    ZIK_ASSERT_TRUE(ZIKLazyRouteLoaderAddRoute(loader, 2, "StringModule", SystemLibraryPath, "StringRouter", "strlen"));
+    ZIK_ASSERT_FALSE(ZIKLazyRouteLoaderAddRoute(loader, 2, "StringModule", SystemLibraryPath, "StringRouter", "strlen"));
+    ZIK_ASSERT_EQUAL(ZIKLazyRouteLoaderRouteCount(loader), 1u);
+    void *address = nullptr;
+    ZIK_ASSERT_EQUAL(ZIKLazyRouteLoaderLoad(loader, 2, "StringModule", &address), ZIKLazyRouteStatusLoaded);
+    ZIK_ASSERT_TRUE(address != nullptr);
+    ZIK_ASSERT_EQUAL(ZIKLazyRouteLoaderLoad(loader, 2, "StringModule", nullptr), ZIKLazyRouteStatusAlreadyLoaded);
+    ZIK_ASSERT_TRUE(ZIKLazyRouteLoaderGetError(loader, 2, "StringModule") == nullptr);
+    ZIKLazyRouteLoaderDestroy(loader);
+
+    ZIK_ASSERT_FALSE(ZIKLazyRouteLoaderAddRoute(NULL, 2, "StringModule", SystemLibraryPath, "StringRouter", NULL));
+    ZIK_ASSERT_EQUAL(ZIKLazyRouteLoaderLoad(NULL, 2, "StringModule", NULL), ZIKLazyRouteStatusNotFound);
+    ZIK_ASSERT_TRUE(ZIKLazyRouteLoaderGetError(NULL, 2, "StringModule") == nullptr);
+    ZIK_ASSERT_EQUAL(ZIKLazyRouteLoaderRouteCount(NULL), 0u);
+}
@@ -0,0 +1,324 @@
+//
+//  ZIKMachOFileTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKMachOFile.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t N_SECT_EXT = macho::N_SECT | macho::N_EXT;
+
+/// A dylib with symbols in __TEXT. Its vm addresses start from 0, so it's also a loaded image at its own address.
+static std::vector<uint8_t> symbolImage(bool is64Bit, int32_t cpuType, const std::vector<MachOFixtureBuilder::Symbol> &symbols) {
+    MachOFixtureBuilder builder(is64Bit, macho::MH_DYLIB, cpuType);
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, symbol.value, symbol.desc);
+    }
+    return builder.build();
+}
+
+static std::vector<MachOFixtureBuilder::Symbol> commonSymbols(const std::string &arch) {
+    return {
+        {"_main", N_SECT_EXT, 1, 0, 0x1000},
+        {"_static_function", macho::N_SECT, 1, 0, 0x1010},
+        {"_debug.o", macho::N_STAB, 0, 0, 0x1020},
+        {"_undefined", macho::N_UNDF | macho::N_EXT, 0, 0x0100, 0},
+        {"_only_" + arch, N_SECT_EXT, 1, 0, 0x1030},
+        {"_main", macho::N_SECT, 1, 0, 0x1040},
+    };
+}
+
+/// Write bytes to a file in the temporary directory, and return its path.
+static std::string writeFixtureFile(const char *name, const std::vector<uint8_t> &bytes) {
+    std::string directory = "/tmp";
+    const char *temporaryDirectory = getenv("TMPDIR");
+    if (temporaryDirectory && temporaryDirectory[0] != '\0') {
+        directory = temporaryDirectory;
+    }
+    std::string path = directory + "/" + name + "_" + std::to_string(getpid());
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return std::string();
+    }
+    if (!bytes.empty()) {
+        fwrite(bytes.data(), 1, bytes.size(), file);
+    }
+    fclose(file);
+    return path;
+}
+
+static uint64_t findValue(const MachOSymbolTable &table, const char *name) {
+    MachONameListItem item = {name, 0, 0, 0, 0};
+    if (machONameList(table, 0, &item, 1) != 0) {
+        return 0;
+    }
+    return item.value;
+}
+
+ZIK_TEST(ZIKMachOFileTests, testThin64BitFile) {
+    std::vector<uint8_t> bytes = symbolImage(true, macho::CPU_TYPE_ARM64, commonSymbols("arm64"));
+    std::string path = writeFixtureFile("ZIKMachOFileTests_thin", bytes);
+    ZIK_ASSERT_FALSE(path.empty());
+
+    MachOFile file;
+    ZIK_ASSERT_TRUE(file.open(path.c_str(), MachOFile::HostCPU));
+    ZIK_ASSERT_EQUAL(file.error(), ZIKMachOFileErrorNone);
+    ZIK_ASSERT_TRUE(file.image().isValid());
+    ZIK_ASSERT_TRUE(file.image().is64Bit());
+    ZIK_ASSERT_EQUAL(file.image().layout(), MachOImage::LayoutFile);
+    ZIK_ASSERT_EQUAL(file.image().size(), bytes.size());
+    ZIK_ASSERT_EQUAL(file.slice().offset, 0);
+    ZIK_ASSERT_EQUAL(file.slice().cpuType, macho::CPU_TYPE_ARM64);
+
+    MachOSection section;
+    ZIK_ASSERT_TRUE(file.image().findSection("__TEXT", "__text", section));
+    ZIK_ASSERT_EQUAL(section.size, 0x100);
+    MachOSegment linkedit;
+    ZIK_ASSERT_TRUE(file.image().findSegment("__LINKEDIT", linkedit));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(file.readSymbolTable(table));
+    ZIK_ASSERT_EQUAL(table.count, 6);
+    ZIK_ASSERT_TRUE(table.is64Bit);
+    ZIK_ASSERT_TRUE(table.strings > reinterpret_cast<const char *>(file.image().base()));
+
+    ZIK_ASSERT_EQUAL(findValue(table, "_main"), 0x1000);
+    ZIK_ASSERT_EQUAL(findValue(table, "_static_function"), 0x1010);
+    ZIK_ASSERT_EQUAL(findValue(table, "_only_arm64"), 0x1030);
+    ZIK_ASSERT_EQUAL(findValue(table, "_debug.o"), 0);
+    ZIK_ASSERT_EQUAL(findValue(table, "_not_exist"), 0);
+
+    // A thin file only has its own architecture
+    MachOFile x86;
+    ZIK_ASSERT_FALSE(x86.open(path.c_str(), macho::CPU_TYPE_X86_64));
+    ZIK_ASSERT_EQUAL(x86.error(), ZIKMachOFileErrorNoMatchingArch);
+    ZIK_ASSERT_FALSE(x86.image().isValid());
+    MachOFile arm64;
+    ZIK_ASSERT_TRUE(arm64.open(path.c_str(), macho::CPU_TYPE_ARM64));
+
+    ZIKMachOFileError error;
+    ZIKMachOFileRef ref = ZIKMachOFileOpen(path.c_str(), ZIKMachOFileHostCPU, &error);
+    ZIK_ASSERT_TRUE(ref != NULL);
+    ZIK_ASSERT_EQUAL(error, ZIKMachOFileErrorNone);
+    ZIK_ASSERT_EQUAL(ZIKMachOFileCPUType(ref), macho::CPU_TYPE_ARM64);
+    ZIKMachOFileClose(ref);
+    unlink(path.c_str());
+}
+
+ZIK_TEST(ZIKMachOFileTests, testFatFile) {
+    std::vector<uint8_t> bytes = MachOFixtureBuilder::fat({
+        std::make_pair(static_cast<int32_t>(macho::CPU_TYPE_ARM), symbolImage(false, macho::CPU_TYPE_ARM, commonSymbols("armv7"))),
+        std::make_pair(static_cast<int32_t>(macho::CPU_TYPE_ARM64), symbolImage(true, macho::CPU_TYPE_ARM64, commonSymbols("arm64"))),
+        std::make_pair(static_cast<int32_t>(macho::CPU_TYPE_X86_64), symbolImage(true, macho::CPU_TYPE_X86_64, commonSymbols("x86_64"))),
+    });
+    std::string path = writeFixtureFile("ZIKMachOFileTests_fat", bytes);
+
+    struct {
+        int32_t cpuType;
+        bool is64Bit;
+        const char *symbol;
+        const char *otherSymbol;
+    } archs[] = {
+        {macho::CPU_TYPE_ARM, false, "_only_armv7", "_only_arm64"},
+        {macho::CPU_TYPE_ARM64, true, "_only_arm64", "_only_x86_64"},
+        {macho::CPU_TYPE_X86_64, true, "_only_x86_64", "_only_armv7"},
+    };
+    for (const auto &arch : archs) {
+        MachOFile file;
+        ZIK_ASSERT_TRUE(file.open(path.c_str(), arch.cpuType));
+        ZIK_ASSERT_EQUAL(file.slice().cpuType, arch.cpuType);
+        ZIK_ASSERT_TRUE(file.slice().offset > 0);
+        ZIK_ASSERT_EQUAL(file.image().is64Bit(), arch.is64Bit);
+        ZIK_ASSERT_EQUAL(file.image().cpuType(), arch.cpuType);
+        MachOSymbolTable table;
+        ZIK_ASSERT_TRUE(file.readSymbolTable(table));
+        ZIK_ASSERT_EQUAL(table.is64Bit, arch.is64Bit);
+        ZIK_ASSERT_EQUAL(findValue(table, "_main"), 0x1000);
+        ZIK_ASSERT_EQUAL(findValue(table, arch.symbol), 0x1030);
+        ZIK_ASSERT_EQUAL(findValue(table, arch.otherSymbol), 0);
+    }
+
+    MachOFile host;
+    ZIK_ASSERT_TRUE(host.open(path.c_str(), MachOFile::HostCPU));
+    int32_t hostCPUType = MachOFile::hostCPUType();
+    if (hostCPUType == macho::CPU_TYPE_ARM64 || hostCPUType == macho::CPU_TYPE_X86_64 || hostCPUType == macho::CPU_TYPE_ARM) {
+        ZIK_ASSERT_EQUAL(host.slice().cpuType, hostCPUType);
+    } else {
+        // Fall back to the first slice
+        ZIK_ASSERT_EQUAL(host.slice().cpuType, macho::CPU_TYPE_ARM);
+    }
+
+    MachOFile x86;
+    ZIK_ASSERT_FALSE(x86.open(path.c_str(), macho::CPU_TYPE_X86));
+    ZIK_ASSERT_EQUAL(x86.error(), ZIKMachOFileErrorNoMatchingArch);
+
+    // The same views from bytes in memory
+    MachOFile memory;
+    ZIK_ASSERT_TRUE(memory.openBytes(bytes.data(), bytes.size(), macho::CPU_TYPE_ARM64));
+    ZIK_ASSERT_EQUAL(memory.image().base(), bytes.data() + memory.slice().offset);
+    unlink(path.c_str());
+}
+
+ZIK_TEST(ZIKMachOFileTests, testMalformedFiles) {
+    MachOFile file;
+    ZIK_ASSERT_FALSE(file.open("/path/not/exist", MachOFile::HostCPU));
+    ZIK_ASSERT_EQUAL(file.error(), ZIKMachOFileErrorOpen);
+    ZIKMachOFileError error = ZIKMachOFileErrorNone;
+    ZIK_ASSERT_TRUE(ZIKMachOFileOpen("/path/not/exist", ZIKMachOFileHostCPU, &error) == NULL);
+    ZIK_ASSERT_EQUAL(error, ZIKMachOFileErrorOpen);
+
+    std::vector<uint8_t> thin = symbolImage(true, macho::CPU_TYPE_ARM64, commonSymbols("arm64"));
+    std::vector<uint8_t> text(64, 'a');
+    std::vector<uint8_t> truncated(thin.begin(), thin.begin() + 40);
+    std::vector<uint8_t> swapped = thin;
+    std::reverse(swapped.begin(), swapped.begin() + 4);
+    std::vector<uint8_t> brokenCommands = thin;
+    // sizeofcmds larger than the file
+    uint32_t sizeofcmds = static_cast<uint32_t>(thin.size());
+    memcpy(&brokenCommands[20], &sizeofcmds, sizeof(sizeofcmds));
+    std::vector<uint8_t> fat = MachOFixtureBuilder::fat({std::make_pair(static_cast<int32_t>(macho::CPU_TYPE_ARM64), thin)});
+    std::vector<uint8_t> fatOutOfFile(fat.begin(), fat.end() - 16);
+    std::vector<uint8_t> fatHeaderOnly(fat.begin(), fat.begin() + 8);
+    std::vector<uint8_t> fatWithoutSlices = {0xca, 0xfe, 0xba, 0xbe, 0, 0, 0, 0};
+    std::vector<uint8_t> fatWithBrokenSlice = fat;
+    memset(&fatWithBrokenSlice[0x1000], 0, 4);
+
+    struct {
+        const char *name;
+        std::vector<uint8_t> bytes;
+        ZIKMachOFileError error;
+    } cases[] = {
+        {"empty", std::vector<uint8_t>(), ZIKMachOFileErrorNotMachO},
+        {"text", text, ZIKMachOFileErrorNotMachO},
+        {"magic_only", std::vector<uint8_t>(thin.begin(), thin.begin() + 4), ZIKMachOFileErrorInvalidImage},
+        {"truncated", truncated, ZIKMachOFileErrorInvalidImage},
+        {"swapped", swapped, ZIKMachOFileErrorInvalidImage},
+        {"broken_commands", brokenCommands, ZIKMachOFileErrorInvalidImage},
+        {"fat_out_of_file", fatOutOfFile, ZIKMachOFileErrorNotMachO},
+        {"fat_header_only", fatHeaderOnly, ZIKMachOFileErrorNotMachO},
+        {"fat_without_slices", fatWithoutSlices, ZIKMachOFileErrorNoMatchingArch},
+        {"fat_broken_slice", fatWithBrokenSlice, ZIKMachOFileErrorInvalidImage},
+    };
+    for (const auto &testCase : cases) {
+        std::string path = writeFixtureFile((std::string("ZIKMachOFileTests_") + testCase.name).c_str(), testCase.bytes);
+        MachOFile malformed;
+        ZIK_ASSERT_FALSE(malformed.open(path.c_str(), MachOFile::HostCPU));
+        ZIK_ASSERT_EQUAL(malformed.error(), testCase.error);
+        ZIK_ASSERT_FALSE(malformed.image().isValid());
+        ZIK_ASSERT_TRUE(ZIKMachOFileOpen(path.c_str(), ZIKMachOFileHostCPU, NULL) == NULL);
+        unlink(path.c_str());
+    }
+}
+
+ZIK_TEST(ZIKMachOFileTests, testSymbolTableOutOfFile) {
+    MachOFixtureBuilder builder(true);
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    builder.addSymbol("_main", N_SECT_EXT, 1, 0x1000);
+    std::vector<uint8_t> bytes = builder.build();
+    MachOFile file;
+    // The string table at the end is cut
+    ZIK_ASSERT_TRUE(file.openBytes(bytes.data(), bytes.size() - 8, MachOFile::HostCPU));
+    MachOSymbolTable table;
+    ZIK_ASSERT_FALSE(file.readSymbolTable(table));
+}
+
+ZIK_TEST(ZIKMachOFileTests, testNameListOnBothBackends) {
+    std::vector<uint8_t> bytes = symbolImage(sizeof(void *) == 8, sizeof(void *) == 8 ? macho::CPU_TYPE_ARM64 : macho::CPU_TYPE_ARM, commonSymbols("arm64"));
+    MachOFile file;
+    ZIK_ASSERT_TRUE(file.openBytes(bytes.data(), bytes.size(), MachOFile::HostCPU));
+    MachOImage loaded;
+    ZIK_ASSERT_TRUE(loaded.parse(bytes.data(), SIZE_MAX, MachOImage::LayoutLoaded));
+    ZIK_ASSERT_EQUAL(loaded.slide(), reinterpret_cast<intptr_t>(bytes.data()));
+
+    MachOSymbolTable fileTable;
+    MachOSymbolTable loadedTable;
+    ZIK_ASSERT_TRUE(file.readSymbolTable(fileTable));
+    ZIK_ASSERT_TRUE(readSymbolTable(loaded, loadedTable));
+    ZIK_ASSERT_EQUAL(fileTable.count, loadedTable.count);
+    ZIK_ASSERT_EQUAL(fileTable.strings, loadedTable.strings);
+
+    const char *names[] = {"_main", "_not_exist", "_undefined", "_static_function", "_main"};
+    MachONameListItem fileItems[5];
+    MachONameListItem loadedItems[5];
+    for (size_t i = 0; i < 5; i++) {
+        MachONameListItem item = {names[i], 0, 0, 0, 0};
+        fileItems[i] = item;
+        loadedItems[i] = item;
+    }
+    // Returns nreq minus found count, like MSMachONameList_
+    ZIK_ASSERT_EQUAL(machONameList(fileTable, 0, fileItems, 5), 1);
+    ZIK_ASSERT_EQUAL(machONameList(loadedTable, loaded.slide(), loadedItems, 5), 1);
+    for (size_t i = 0; i < 5; i++) {
+        ZIK_ASSERT_EQUAL(fileItems[i].name, loadedItems[i].name);
+        ZIK_ASSERT_EQUAL(fileItems[i].type, loadedItems[i].type);
+        ZIK_ASSERT_EQUAL(fileItems[i].desc, loadedItems[i].desc);
+        if (fileItems[i].value == 0) {
+            // Undefined symbols are not slid
+            ZIK_ASSERT_EQUAL(loadedItems[i].value, 0);
+        } else {
+            ZIK_ASSERT_EQUAL(loadedItems[i].value, fileItems[i].value + loaded.slide());
+        }
+    }
+    ZIK_ASSERT_TRUE(fileItems[1].name != nullptr);
+    ZIK_ASSERT_TRUE(fileItems[2].name == nullptr);
+    ZIK_ASSERT_EQUAL(fileItems[2].value, 0);
+    ZIK_ASSERT_EQUAL(fileItems[2].desc, 0x0100);
+    // Each symbol fills one item, so the duplicated name gets the next symbol with the name
+    ZIK_ASSERT_EQUAL(fileItems[0].value, 0x1000);
+    ZIK_ASSERT_EQUAL(fileItems[0].type, N_SECT_EXT);
+    ZIK_ASSERT_EQUAL(fileItems[4].value, 0x1040);
+    ZIK_ASSERT_EQUAL(fileItems[4].type, macho::N_SECT);
+    // Found items are skipped in later calls
+    ZIK_ASSERT_EQUAL(machONameList(fileTable, 0, fileItems, 5), 5);
+}
+
+ZIK_TEST(ZIKMachOFileTests, testMatchingNameList) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    for (size_t i = 0; i < 100; i++) {
+        MachOFixtureBuilder::Symbol symbol = {"_symbol" + std::to_string(i), N_SECT_EXT, 1, 0, 0x2000 + i * 16};
+        symbols.push_back(symbol);
+    }
+    std::vector<uint8_t> bytes = symbolImage(true, macho::CPU_TYPE_ARM64, symbols);
+    MachOFile file;
+    ZIK_ASSERT_TRUE(file.openBytes(bytes.data(), bytes.size(), MachOFile::HostCPU));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(file.readSymbolTable(table));
+
+    MachONameListItem items[3];
+    memset(items, 0, sizeof(items));
+    size_t called = 0;
+    size_t result = machONameList(table, 0, items, 3, [&](const char *name) {
+        called++;
+        return strncmp(name, "_symbol9", 8) == 0;
+    });
+    ZIK_ASSERT_EQUAL(result, 0);
+    // Stops after all items are filled
+    ZIK_ASSERT_EQUAL(called, 92);
+    ZIK_ASSERT_EQUAL(items[0].value, 0x2000 + 9 * 16);
+    ZIK_ASSERT_EQUAL(items[1].value, 0x2000 + 90 * 16);
+    ZIK_ASSERT_EQUAL(items[2].value, 0x2000 + 91 * 16);
+
+    MachONameListItem item;
+    memset(&item, 0, sizeof(item));
+    ZIK_ASSERT_EQUAL(machONameList(table, 0, &item, 1, [](const char *) {
+        return false;
+    }), 1);
+}
@@ -0,0 +1,183 @@
+//
+//  ZIKMangledNameClassifierTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKMangledNameClassifier.h"
+#include "ZIKSymbolBenchmark.h"
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+/// A symbol name with its expected classification. Module is NULL when it can't be read.
+struct MangledNameCase {
+    const char *name;
+    ZIKSwiftMangling mangling;
+    ZIKMangledNameKind kind;
+    const char *module;
+};
+
+/// Symbols in Mach-O files of Swift apps, with the leading `_`.
+static const MangledNameCase corpus[] = {
+    // Symbols of RoutableService and RoutableView used by validators
+    {"_$s7ZRouter15RoutableServiceVy5MyApp12LoginServiceP_pGMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"_$s7ZRouter21RoutableServiceModuleVy5MyApp18LoginModuleConfigP_pGMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"_$s7ZRouter12RoutableViewVy5MyApp13LoginViewInputP_pGMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"_$s7ZRouter15RoutableServiceV5MyAppAD12LoginServiceP_pRszlEACyAeF_pGycfC", ZIKSwiftMangling5, ZIKMangledNameKindInitializer, "ZRouter"},
+    {"_$s7ZRouter12RoutableViewV5MyAppAD13LoginViewInputP_pRszlEACyAeF_pGycfC", ZIKSwiftMangling5, ZIKMangledNameKindInitializer, "ZRouter"},
+    {"_$s7ZRouter15RoutableServiceVy5MyApp12LoginServiceP_pGMD", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataCache, "ZRouter"},
+    {"_$s7ZRouter15RoutableServiceVMn", ZIKSwiftMangling5, ZIKMangledNameKindNominalTypeDescriptor, "ZRouter"},
+    {"_$s7ZRouter15RoutableServiceVMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    // Types
+    {"_$s7ZRouter6RouterCN", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadata, "ZRouter"},
+    {"_$s7ZRouter6RouterCMf", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadata, "ZRouter"},
+    {"_$s7ZRouter6RouterCMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"_$s7ZRouter6RouterCMn", ZIKSwiftMangling5, ZIKMangledNameKindNominalTypeDescriptor, "ZRouter"},
+    {"_$s5MyApp12LoginServiceMp", ZIKSwiftMangling5, ZIKMangledNameKindProtocolDescriptor, "MyApp"},
+    {"_$s5MyApp4UserVSQAAMc", ZIKSwiftMangling5, ZIKMangledNameKindProtocolConformanceDescriptor, "MyApp"},
+    {"_$s5MyApp4UserVSQAAWP", ZIKSwiftMangling5, ZIKMangledNameKindProtocolWitnessTable, "MyApp"},
+    {"_$s5MyApp4UserVs23CustomStringConvertibleAAMc", ZIKSwiftMangling5, ZIKMangledNameKindProtocolConformanceDescriptor, "MyApp"},
+    // Functions and accessors
+    {"_$s5MyApp6LoaderC4loadyyF", ZIKSwiftMangling5, ZIKMangledNameKindFunction, "MyApp"},
+    {"_$s5MyApp6LoaderC6sharedACvgZ", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp6LoaderC4makeACyFZ", ZIKSwiftMangling5, ZIKMangledNameKindFunction, "MyApp"},
+    {"_$s5MyApp6LoaderC5titleSSvg", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp6LoaderC5titleSSvs", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp6LoaderC5titleSSvM", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp6LoaderC5countSivau", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp4ListVyS2icig", ZIKSwiftMangling5, ZIKMangledNameKindAccessor, "MyApp"},
+    {"_$s5MyApp6LoaderCACycfc", ZIKSwiftMangling5, ZIKMangledNameKindInitializer, "MyApp"},
+    {"_$s5MyApp6LoaderCfD", ZIKSwiftMangling5, ZIKMangledNameKindOther, "MyApp"},
+    {"_$s5MyApp6LoaderC5titleSSvpMV", ZIKSwiftMangling5, ZIKMangledNameKindOther, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyFyycfU_", ZIKSwiftMangling5, ZIKMangledNameKindClosure, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyFyycfU0_", ZIKSwiftMangling5, ZIKMangledNameKindClosure, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyF.cold.1", ZIKSwiftMangling5, ZIKMangledNameKindFunction, "MyApp"},
+    // Thunks and specializations
+    {"_$s5MyApp6LoaderC4loadyyFTo", ZIKSwiftMangling5, ZIKMangledNameKindThunk, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyFTq", ZIKSwiftMangling5, ZIKMangledNameKindThunk, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyFTA", ZIKSwiftMangling5, ZIKMangledNameKindThunk, "MyApp"},
+    {"_$s5MyApp4UserVSQAASQ2eeoiySbx_xtFZTW", ZIKSwiftMangling5, ZIKMangledNameKindThunk, "MyApp"},
+    {"_$s5MyApp6LoaderC4loadyyFTm", ZIKSwiftMangling5, ZIKMangledNameKindThunk, "MyApp"},
+    {"_$sSa6appendyyxnFSi_Tg5", ZIKSwiftMangling5, ZIKMangledNameKindSpecialization, "Swift"},
+    {"_$s5MyApp6LoaderC4loadyyxlFSS_Tgq5", ZIKSwiftMangling5, ZIKMangledNameKindSpecialization, "MyApp"},
+    // Modules from substitutions
+    {"_$sSS10FoundationE4data5usingAA4DataVSgAcDE8EncodingV_SbtF", ZIKSwiftMangling5, ZIKMangledNameKindFunction, "Swift"},
+    {"_$ss5Int32VN", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadata, "Swift"},
+    {"_$sSo8NSObjectC5MyAppE4loadyyF", ZIKSwiftMangling5, ZIKMangledNameKindFunction, "__C"},
+    {"_$sSo17NSFileAttributeKeyaMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "__C"},
+    {"_$sSC11CGRectEdgeOMn", ZIKSwiftMangling5, ZIKMangledNameKindNominalTypeDescriptor, "__C_Synthesized"},
+    // Identifiers with word substitutions or punycode have no module
+    {"_$s0A4TestCN", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadata, NULL},
+    {"_$s00MyApp_chdFgaN", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadata, NULL},
+    // Older manglings
+    {"_$S7ZRouter15RoutableServiceVy5MyApp12LoginServiceP_pGMa", ZIKSwiftMangling4_2, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"__T07ZRouter15RoutableServiceVy5MyApp12LoginService_pGMa", ZIKSwiftMangling4, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"__T05MyApp6LoaderC4loadyyF", ZIKSwiftMangling4, ZIKMangledNameKindFunction, "MyApp"},
+    {"__TFC5MyApp6Loader4loadfT_T_", ZIKSwiftManglingLegacy, ZIKMangledNameKindOther, NULL},
+    {"__TtC5MyApp6Loader", ZIKSwiftManglingLegacy, ZIKMangledNameKindOther, NULL},
+    // Without the leading `_`
+    {"$s7ZRouter6RouterCMa", ZIKSwiftMangling5, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    {"_T07ZRouter6RouterCMa", ZIKSwiftMangling4, ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"},
+    // Not swift
+    {"_OBJC_CLASS_$_ZIKViewRouter", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"_OBJC_METACLASS_$__TtC7ZRouter6Router", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"-[ZIKViewRouter performPath:]", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"+[ZIKRouteRegistry load]", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"_ZIKServiceRouterToIdentifier", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"___ZIKRouter_block_invoke_2", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"__ZN3zix11SymbolIndex5buildERKNS_5macho10MachOImageE", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"_Tfoo", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"_main", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"_", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+    {"", ZIKSwiftManglingNone, ZIKMangledNameKindOther, NULL},
+};
+
+ZIK_TEST(ZIKMangledNameClassifierTests, testCorpus) {
+    for (const MangledNameCase &item : corpus) {
+        ZIKMangledNameInfo info;
+        bool swift = ZIKClassifyMangledName(item.name, &info);
+        ZIK_ASSERT_EQUAL(swift, item.mangling != ZIKSwiftManglingNone);
+        ZIK_ASSERT_EQUAL(info.mangling, item.mangling);
+        ZIK_ASSERT_EQUAL(info.kind, item.kind);
+        if (item.module) {
+            ZIK_ASSERT_TRUE(info.module != NULL && std::string(info.module, info.moduleLength) == item.module);
+        } else {
+            ZIK_ASSERT_TRUE(info.module == NULL);
+            ZIK_ASSERT_EQUAL(info.moduleLength, 0);
+        }
+    }
+    ZIK_ASSERT_FALSE(ZIKClassifyMangledName(NULL, NULL));
+    ZIK_ASSERT_TRUE(ZIKClassifyMangledName("_$s7ZRouter6RouterCN", NULL));
+}
+
+ZIK_TEST(ZIKMangledNameClassifierTests, testLengthLimitsName) {
+    // Module identifiers longer than the name are not read
+    ZIKMangledNameInfo info;
+    ZIK_ASSERT_TRUE(classifyMangledName("_$s99ZRouterC", strlen("_$s99ZRouterC"), info));
+    ZIK_ASSERT_TRUE(info.module == NULL);
+    const char *name = "_$s7ZRouter6RouterCMaXYZ";
+    ZIK_ASSERT_TRUE(classifyMangledName(name, strlen(name) - 3, info));
+    ZIK_ASSERT_EQUAL(info.kind, ZIKMangledNameKindTypeMetadataAccessor);
+    ZIK_ASSERT_TRUE(classifyMangledName(name, 5, info));
+    ZIK_ASSERT_TRUE(info.module == NULL);
+}
+
+ZIK_TEST(ZIKMangledNameClassifierTests, testValidatorCandidates) {
+    // Names demangled by validators of ZRouter
+    MangledNameFilter filter(ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor, "ZRouter");
+    size_t candidates = 0;
+    for (const MangledNameCase &item : corpus) {
+        bool expected = item.mangling != ZIKSwiftManglingNone &&
+            (item.kind & (ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor)) != 0 &&
+            (item.module == NULL || strcmp(item.module, "ZRouter") == 0);
+        ZIK_ASSERT_EQUAL(filter.accepts(item.name), expected);
+        ZIK_ASSERT_EQUAL(ZIKMangledNameIsCandidate(item.name, ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor, "ZRouter"), expected);
+        candidates += expected;
+    }
+    ZIK_ASSERT_EQUAL(candidates, 11);
+    ZIK_ASSERT_TRUE(filter.accepts("_$s7ZRouter15RoutableServiceVy5MyApp12LoginServiceP_pGMa"));
+    ZIK_ASSERT_FALSE(filter.accepts("_$s7ZRouter15RoutableServiceVy5MyApp12LoginServiceP_pGMD"));
+    ZIK_ASSERT_FALSE(filter.accepts("_$s5MyApp6LoaderCACycfc"));
+    ZIK_ASSERT_FALSE(filter.accepts(NULL));
+
+    // Legacy names are always swift, but their kinds are unknown
+    ZIK_ASSERT_TRUE(ZIKMangledNameIsCandidate("__TtC5MyApp6Loader", ZIKMangledNameKindOther, "ZRouter"));
+    ZIK_ASSERT_FALSE(ZIKMangledNameIsCandidate("__TtC5MyApp6Loader", ZIKMangledNameKindInitializer, "ZRouter"));
+    // All modules
+    ZIK_ASSERT_TRUE(ZIKMangledNameIsCandidate("_$s5MyApp6LoaderCACycfc", ZIKMangledNameKindInitializer, NULL));
+    ZIK_ASSERT_TRUE(MangledNameFilter(ZIKMangledNameKindAll, "").accepts("_$s5MyApp6LoaderCfD"));
+    ZIK_ASSERT_FALSE(MangledNameFilter(ZIKMangledNameKindAll, NULL).accepts("_OBJC_CLASS_$_ZIKViewRouter"));
+}
+
+ZIK_TEST(ZIKMangledNameClassifierTests, testBenchmarkSymbols) {
+    // Prefilter never drops a swift symbol that validators would demangle
+    std::vector<MachOFixtureBuilder::Symbol> symbols = SymbolBenchmark::makeSymbols(20000, 2018);
+    MangledNameFilter swift(ZIKMangledNameKindAll, NULL);
+    MangledNameFilter validator(ZIKMangledNameKindInitializer | ZIKMangledNameKindTypeMetadataAccessor, "ZRouter");
+    size_t swiftNames = 0, routableNames = 0, candidates = 0;
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        const std::string &name = symbol.name;
+        bool isSwift = name.compare(0, 3, "_$s") == 0 || name.compare(0, 3, "_$S") == 0 || name.compare(0, 3, "_T0") == 0;
+        ZIK_ASSERT_EQUAL(swift.accepts(name.c_str()), isSwift);
+        swiftNames += isSwift;
+        if (name.find("RoutableService") == std::string::npos) {
+            continue;
+        }
+        routableNames++;
+        bool accepted = validator.accepts(name.c_str());
+        bool expected = name.compare(0, 11, "_$s7ZRouter") == 0 && (name.compare(name.size() - 2, 2, "Ma") == 0 || name.compare(name.size() - 2, 2, "fC") == 0);
+        ZIK_ASSERT_EQUAL(accepted, expected);
+        candidates += accepted;
+    }
+    ZIK_ASSERT_GREATER_THAN(swiftNames, 0);
+    ZIK_ASSERT_LESS_THAN(swiftNames, symbols.size());
+    ZIK_ASSERT_GREATER_THAN(candidates, 0);
+    ZIK_ASSERT_LESS_THAN(candidates, routableNames);
+}
@@ -0,0 +1,147 @@
+//
+//  ZIKReadinessBarrierTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKReadinessBarrier.h"
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace zix;
+
+ZIK_TEST(ZIKReadinessBarrierTests, testIdleBarrierDoesNotBlock) {
+    ReadinessBarrier barrier;
+    ZIK_ASSERT_EQUAL(barrier.state(), ReadinessBarrier::Idle);
+    ZIK_ASSERT_EQUAL(barrier.wait(), 0u);
+    ZIK_ASSERT_EQUAL(barrier.blockedCount(), 0u);
+    // Marking ready without starting is ignored
+    barrier.markReady();
+    ZIK_ASSERT_EQUAL(barrier.state(), ReadinessBarrier::Idle);
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testStartOnce) {
+    ReadinessBarrier barrier;
+    ZIK_ASSERT_TRUE(barrier.start());
+    ZIK_ASSERT_FALSE(barrier.start());
+    ZIK_ASSERT_EQUAL(barrier.state(), ReadinessBarrier::Running);
+    barrier.markReady();
+    ZIK_ASSERT_EQUAL(barrier.state(), ReadinessBarrier::Ready);
+    ZIK_ASSERT_FALSE(barrier.start());
+    ZIK_ASSERT_EQUAL(barrier.wait(), 0u);
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testWorkerDoesNotBlockOnItself) {
+    ReadinessBarrier barrier;
+    ZIK_ASSERT_TRUE(barrier.start());
+    barrier.enterWorkerThread();
+    // Such as a router looking up another router when it's registering
+    ZIK_ASSERT_EQUAL(barrier.wait(), 0u);
+    ZIK_ASSERT_EQUAL(barrier.blockedCount(), 0u);
+    barrier.markReady();
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testWaitersSeeWork) {
+    ReadinessBarrier barrier;
+    std::vector<int> routes;
+    // Started before the worker runs, so waiters never miss it
+    ZIK_ASSERT_TRUE(barrier.start());
+    std::thread worker([&] {
+        barrier.enterWorkerThread();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 1000; i++) {
+            routes.push_back(i);
+        }
+        barrier.markReady();
+    });
+    const size_t waiterCount = 4;
+    std::vector<size_t> seenCounts(waiterCount, 0);
+    std::vector<std::thread> waiters;
+    for (size_t i = 0; i < waiterCount; i++) {
+        waiters.push_back(std::thread([&, i] {
+            barrier.wait();
+            seenCounts[i] = routes.size();
+        }));
+    }
+    for (std::thread &waiter : waiters) {
+        waiter.join();
+    }
+    worker.join();
+    for (size_t i = 0; i < waiterCount; i++) {
+        ZIK_ASSERT_EQUAL(seenCounts[i], 1000u);
+    }
+    // Waiters arriving after the work is done don't block
+    ZIK_ASSERT_LESS_THAN_OR_EQUAL(barrier.blockedCount(), waiterCount);
+    // Later waits only load the state
+    size_t blockedCount = barrier.blockedCount();
+    ZIK_ASSERT_EQUAL(barrier.wait(), 0u);
+    ZIK_ASSERT_EQUAL(barrier.blockedCount(), blockedCount);
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testStartingThreadWaits) {
+    ReadinessBarrier barrier;
+    ZIK_ASSERT_TRUE(barrier.start());
+    std::atomic<bool> done(false);
+    std::thread worker([&] {
+        barrier.enterWorkerThread();
+        ZIK_ASSERT_EQUAL(barrier.wait(), 0u);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        done.store(true);
+        barrier.markReady();
+    });
+    // Thread starting the work is not the worker, such as main thread dispatching registration
+    barrier.wait();
+    ZIK_ASSERT_TRUE(done.load());
+    worker.join();
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testCAPI) {
+    ZIKReadinessBarrierRef barrier = ZIKReadinessBarrierCreate();
+    ZIK_ASSERT_FALSE(ZIKReadinessBarrierIsRunning(barrier));
+    ZIK_ASSERT_TRUE(ZIKReadinessBarrierStart(barrier));
+    ZIK_ASSERT_TRUE(ZIKReadinessBarrierIsRunning(barrier));
+    ZIKReadinessBarrierEnterWorkerThread(barrier);
+    ZIK_ASSERT_EQUAL(ZIKReadinessBarrierWait(barrier), 0u);
+    std::atomic<bool> ready(false);
+    std::thread waiter([&] {
+        ZIKReadinessBarrierWait(barrier);
+        ready.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ZIK_ASSERT_FALSE(ready.load());
+    ZIKReadinessBarrierMarkReady(barrier);
+    waiter.join();
+    ZIK_ASSERT_TRUE(ready.load());
+    ZIK_ASSERT_FALSE(ZIKReadinessBarrierIsRunning(barrier));
+    size_t blockedCount = 0;
+    uint64_t blockedTime = 0;
+    ZIKReadinessBarrierGetBlockedStatistics(barrier, &blockedCount, &blockedTime);
+    ZIK_ASSERT_LESS_THAN_OR_EQUAL(blockedCount, 1u);
+    ZIKReadinessBarrierDestroy(barrier);
+
+    ZIK_ASSERT_FALSE(ZIKReadinessBarrierStart(NULL));
+    ZIK_ASSERT_EQUAL(ZIKReadinessBarrierWait(NULL), 0u);
+    ZIKReadinessBarrierGetBlockedStatistics(NULL, &blockedCount, &blockedTime);
+    ZIK_ASSERT_EQUAL(blockedCount, 0u);
+}
+
+ZIK_TEST(ZIKReadinessBarrierTests, testFastPathCost) {
+    ReadinessBarrier barrier;
+    barrier.start();
+    barrier.markReady();
+    const size_t count = 10000000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint64_t blocked = 0;
+    for (size_t i = 0; i < count; i++) {
+        blocked += barrier.wait();
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    ZIK_ASSERT_EQUAL(blocked, 0u);
+    fprintf(stderr, "Ready barrier wait: %.2f ns\n", nanoseconds / count);
+}
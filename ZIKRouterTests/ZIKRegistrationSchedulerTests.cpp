@@ -0,0 +1,181 @@
+//
+//  ZIKRegistrationSchedulerTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKRegistrationScheduler.h"
+#include <vector>
+
+using namespace zix;
+
+/// Fake clock advanced by work items, so slices are deterministic.
+struct FakeRegistration {
+    uint64_t time = 0;
+    std::vector<uint64_t> costs;
+    std::vector<size_t> order;
+    RegistrationScheduler *scheduler = nullptr;
+    /// Index of the work item calling finish(), like a router looking up a deferred router while registering.
+    size_t finishingIndex = SIZE_MAX;
+    size_t finishedCount = 0;
+};
+
+static uint64_t fakeClock(void *context) {
+    return static_cast<FakeRegistration *>(context)->time;
+}
+
+static void fakeWork(void *context, size_t index) {
+    FakeRegistration *registration = static_cast<FakeRegistration *>(context);
+    registration->order.push_back(index);
+    registration->time += registration->costs[index];
+    if (index == registration->finishingIndex) {
+        registration->finishedCount = registration->scheduler->finish();
+    }
+}
+
+/// Count of work items run in each slice until finished.
+static std::vector<size_t> sliceSizes(FakeRegistration &registration, RegistrationScheduler &scheduler) {
+    std::vector<size_t> sizes;
+    while (!scheduler.isFinished()) {
+        size_t before = registration.order.size();
+        scheduler.runSlice();
+        sizes.push_back(registration.order.size() - before);
+    }
+    return sizes;
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testSlicesFitBudget) {
+    FakeRegistration registration;
+    registration.costs.assign(10, 3);
+    RegistrationScheduler scheduler(10, 10, fakeWork, &registration, fakeClock, &registration);
+    std::vector<size_t> sizes = sliceSizes(registration, scheduler);
+    // 3 items cost 9, a 4th item would exceed the budget of 10
+    std::vector<size_t> expected = {3, 3, 3, 1};
+    ZIK_ASSERT_TRUE(sizes == expected);
+    ZIK_ASSERT_EQUAL(scheduler.sliceCount(), 4u);
+    ZIK_ASSERT_EQUAL(scheduler.pendingCount(), 0u);
+    for (size_t i = 0; i < registration.order.size(); i++) {
+        ZIK_ASSERT_EQUAL(registration.order[i], i);
+    }
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testExpensiveItemRunsAlone) {
+    FakeRegistration registration;
+    registration.costs = {25, 1, 1, 1};
+    RegistrationScheduler scheduler(4, 10, fakeWork, &registration, fakeClock, &registration);
+    // First item always runs even when it's over budget. Then the average cost is too high for the rest of the slice.
+    ZIK_ASSERT_FALSE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.order.size(), 1u);
+    ZIK_ASSERT_EQUAL(registration.time, 25u);
+    // Average is (25 + 1) / 2 = 13 after the second item, still over budget
+    ZIK_ASSERT_FALSE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.order.size(), 2u);
+    ZIK_ASSERT_TRUE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.order.size(), 4u);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testSliceStopsAtBudget) {
+    FakeRegistration registration;
+    registration.costs = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    RegistrationScheduler scheduler(registration.costs.size(), 5, fakeWork, &registration, fakeClock, &registration);
+    uint64_t start = registration.time;
+    ZIK_ASSERT_FALSE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.time - start, 5u);
+    ZIK_ASSERT_EQUAL(scheduler.pendingCount(), 7u);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testZeroBudget) {
+    FakeRegistration registration;
+    registration.costs.assign(3, 0);
+    RegistrationScheduler scheduler(3, 0, fakeWork, &registration, fakeClock, &registration);
+    std::vector<size_t> sizes = sliceSizes(registration, scheduler);
+    std::vector<size_t> expected = {1, 1, 1};
+    ZIK_ASSERT_TRUE(sizes == expected);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testFinishRunsPendingItems) {
+    FakeRegistration registration;
+    registration.costs.assign(8, 4);
+    RegistrationScheduler scheduler(8, 10, fakeWork, &registration, fakeClock, &registration);
+    ZIK_ASSERT_FALSE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.order.size(), 2u);
+    // A lookup misses, pending items are registered at once regardless of budget
+    ZIK_ASSERT_EQUAL(scheduler.finish(), 6u);
+    ZIK_ASSERT_TRUE(scheduler.isFinished());
+    ZIK_ASSERT_EQUAL(registration.order.size(), 8u);
+    ZIK_ASSERT_EQUAL(scheduler.finish(), 0u);
+    ZIK_ASSERT_TRUE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(scheduler.sliceCount(), 1u);
+    for (size_t i = 0; i < registration.order.size(); i++) {
+        ZIK_ASSERT_EQUAL(registration.order[i], i);
+    }
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testFinishInWorkItem) {
+    FakeRegistration registration;
+    registration.costs.assign(6, 1);
+    RegistrationScheduler scheduler(6, 100, fakeWork, &registration, fakeClock, &registration);
+    registration.scheduler = &scheduler;
+    registration.finishingIndex = 1;
+    ZIK_ASSERT_TRUE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(registration.finishedCount, 4u);
+    // Every item runs exactly once, in order
+    std::vector<size_t> expected = {0, 1, 2, 3, 4, 5};
+    ZIK_ASSERT_TRUE(registration.order == expected);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testFinishInWorkItemOfFinish) {
+    FakeRegistration registration;
+    registration.costs.assign(5, 1);
+    RegistrationScheduler scheduler(5, 1, fakeWork, &registration, fakeClock, &registration);
+    registration.scheduler = &scheduler;
+    registration.finishingIndex = 2;
+    ZIK_ASSERT_FALSE(scheduler.runSlice());
+    // Items 1 and 2 run in the outer call, items 3 and 4 in the nested call
+    ZIK_ASSERT_EQUAL(scheduler.finish(), 2u);
+    ZIK_ASSERT_EQUAL(registration.finishedCount, 2u);
+    std::vector<size_t> expected = {0, 1, 2, 3, 4};
+    ZIK_ASSERT_TRUE(registration.order == expected);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testEmptyScheduler) {
+    RegistrationScheduler scheduler(0, 10, fakeWork, nullptr, fakeClock, nullptr);
+    ZIK_ASSERT_TRUE(scheduler.isFinished());
+    ZIK_ASSERT_TRUE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(scheduler.sliceCount(), 0u);
+    ZIK_ASSERT_EQUAL(scheduler.finish(), 0u);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testCAPI) {
+    FakeRegistration registration;
+    registration.costs.assign(5, 2);
+    ZIKRegistrationSchedulerRef scheduler = ZIKRegistrationSchedulerCreate(5, 4, fakeWork, &registration, fakeClock, &registration);
+    ZIK_ASSERT_EQUAL(ZIKRegistrationSchedulerPendingCount(scheduler), 5u);
+    ZIK_ASSERT_FALSE(ZIKRegistrationSchedulerRunSlice(scheduler));
+    ZIK_ASSERT_EQUAL(ZIKRegistrationSchedulerPendingCount(scheduler), 3u);
+    ZIK_ASSERT_EQUAL(ZIKRegistrationSchedulerFinish(scheduler), 3u);
+    ZIK_ASSERT_TRUE(ZIKRegistrationSchedulerRunSlice(scheduler));
+    ZIKRegistrationSchedulerDestroy(scheduler);
+
+    // NULL work has nothing to do
+    scheduler = ZIKRegistrationSchedulerCreate(5, 4, NULL, NULL, NULL, NULL);
+    ZIK_ASSERT_EQUAL(ZIKRegistrationSchedulerPendingCount(scheduler), 0u);
+    ZIK_ASSERT_TRUE(ZIKRegistrationSchedulerRunSlice(scheduler));
+    ZIKRegistrationSchedulerDestroy(scheduler);
+
+    ZIK_ASSERT_TRUE(ZIKRegistrationSchedulerRunSlice(NULL));
+    ZIK_ASSERT_EQUAL(ZIKRegistrationSchedulerFinish(NULL), 0u);
+}
+
+ZIK_TEST(ZIKRegistrationSchedulerTests, testSystemClock) {
+    FakeRegistration registration;
+    registration.costs.assign(1000, 0);
+    // Real clock with a huge budget runs everything in one slice
+    RegistrationScheduler scheduler(1000, UINT64_MAX, fakeWork, &registration);
+    ZIK_ASSERT_TRUE(scheduler.runSlice());
+    ZIK_ASSERT_EQUAL(scheduler.sliceCount(), 1u);
+    ZIK_ASSERT_EQUAL(registration.order.size(), 1000u);
+}
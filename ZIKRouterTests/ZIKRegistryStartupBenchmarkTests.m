@@ -0,0 +1,149 @@
+//
+//  ZIKRegistryStartupBenchmarkTests.m
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+@import ZIKRouter.Private;
+#import <objc/runtime.h>
+#import <mach/mach_time.h>
+
+@interface ZIKRouteRegistry (StartupBenchmark)
++ (void)_registerRouterClassLately:(Class)routerClass;
+@end
+
+static uint64_t _nowNanoseconds(void) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return (uint64_t)((double)mach_absolute_time() * timebase.numer / timebase.denom);
+}
+
+/**
+ Measure startup cost of registry with synthetic service routers created at runtime. Each router registers a destination class and a destination protocol in +registerRoutableDestination, like most routers in apps.
+
+ Registration is finished when tests run, so +registerAll can't run again. Its cost is measured with the same steps: searching router classes in all classes, then registering each router class. Results are written as JSON to the path in environment variable `ZIKROUTER_BENCHMARK_OUTPUT`, or `ZIKRegistryStartupBenchmark.json` in the temporary directory.
+ */
+@interface ZIKRegistryStartupBenchmarkTests : XCTestCase
+@end
+
+@implementation ZIKRegistryStartupBenchmarkTests
+
+/// Create routers subclassing a new base router, so searching only finds routers of this run. The base router itself is never registered.
+- (Class)makeRouterBaseWithName:(NSString *)name routerCount:(NSUInteger)count protocols:(NSMutableArray<Protocol *> *)protocols {
+    Class base = objc_allocateClassPair([ZIKServiceRouter class], name.UTF8String, 0);
+    objc_registerClassPair(base);
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *protocolName = [NSString stringWithFormat:@"%@Service%lu", name, (unsigned long)i];
+        Protocol *protocol = objc_allocateProtocol(protocolName.UTF8String);
+        protocol_addProtocol(protocol, @protocol(ZIKServiceRoutable));
+        objc_registerProtocol(protocol);
+        [protocols addObject:protocol];
+
+        NSString *serviceName = [NSString stringWithFormat:@"%@ServiceImpl%lu", name, (unsigned long)i];
+        Class serviceClass = objc_allocateClassPair([NSObject class], serviceName.UTF8String, 0);
+        class_addProtocol(serviceClass, @protocol(ZIKRoutableService));
+        class_addProtocol(serviceClass, protocol);
+        objc_registerClassPair(serviceClass);
+
+        NSString *routerName = [NSString stringWithFormat:@"%@Router%lu", name, (unsigned long)i];
+        Class routerClass = objc_allocateClassPair(base, routerName.UTF8String, 0);
+        IMP registerImp = imp_implementationWithBlock(^(Class router) {
+            [router registerService:serviceClass];
+            [router registerServiceProtocol:protocol];
+        });
+        class_addMethod(object_getClass(routerClass), @selector(registerRoutableDestination), registerImp, "v@:");
+        objc_registerClassPair(routerClass);
+    }
+    return base;
+}
+
+- (NSDictionary *)benchmarkWithRouterCount:(NSUInteger)count {
+    static NSUInteger runIndex = 0;
+    NSString *name = [NSString stringWithFormat:@"ZIKStartupBenchmark%lu_%lu_", (unsigned long)count, (unsigned long)runIndex++];
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray arrayWithCapacity:count];
+    Class base = [self makeRouterBaseWithName:name routerCount:count protocols:protocols];
+
+    // Search router classes in all classes, like +registerAll
+    NSMutableArray<Class> *routerClasses = [NSMutableArray arrayWithCapacity:count];
+    uint64_t start = _nowNanoseconds();
+    zix_enumerateClassListForParentClass(base, ^(__unsafe_unretained Class aClass) {
+        [routerClasses addObject:aClass];
+    });
+    uint64_t searchTime = _nowNanoseconds() - start;
+    XCTAssertEqual(routerClasses.count, count);
+
+    // Call +registerRoutableDestination of each router
+    uint64_t registrationTime = 0;
+    uint64_t maxRegistrationTime = 0;
+    for (Class routerClass in routerClasses) {
+        uint64_t routerStart = _nowNanoseconds();
+        [ZIKRouteRegistry _registerRouterClassLately:routerClass];
+        uint64_t routerTime = _nowNanoseconds() - routerStart;
+        registrationTime += routerTime;
+        maxRegistrationTime = MAX(maxRegistrationTime, routerTime);
+    }
+
+    // Insert the same keys into maps with the same callbacks as registry, without registry's checks
+    CFMutableDictionaryRef protocolMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    CFMutableDictionaryRef classMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    start = _nowNanoseconds();
+    for (NSUInteger i = 0; i < count; i++) {
+        CFDictionarySetValue(protocolMap, (__bridge const void *)protocols[i], (__bridge const void *)routerClasses[i]);
+        CFDictionarySetValue(classMap, (__bridge const void *)routerClasses[i], (__bridge const void *)protocols[i]);
+    }
+    uint64_t insertionTime = _nowNanoseconds() - start;
+    CFRelease(protocolMap);
+    CFRelease(classMap);
+
+    // First lookup of each protocol, then lookup again
+    uint64_t firstLookupTime = 0;
+    uint64_t maxFirstLookupTime = 0;
+    for (Protocol *protocol in protocols) {
+        uint64_t lookupStart = _nowNanoseconds();
+        ZIKServiceRouterType *routerType = _ZIKServiceRouterToService(protocol);
+        uint64_t lookupTime = _nowNanoseconds() - lookupStart;
+        XCTAssertNotNil(routerType);
+        firstLookupTime += lookupTime;
+        maxFirstLookupTime = MAX(maxFirstLookupTime, lookupTime);
+    }
+    start = _nowNanoseconds();
+    for (Protocol *protocol in protocols) {
+        _ZIKServiceRouterToService(protocol);
+    }
+    uint64_t repeatedLookupTime = _nowNanoseconds() - start;
+
+    return @{@"routers": @(count),
+             @"registerAllMs": @((searchTime + registrationTime) / 1e6),
+             @"searchMs": @(searchTime / 1e6),
+             @"registrationMs": @(registrationTime / 1e6),
+             @"perRouterRegistrationUs": @(registrationTime / 1e3 / count),
+             @"maxRouterRegistrationUs": @(maxRegistrationTime / 1e3),
+             @"mapInsertionNs": @((double)insertionTime / (count * 2)),
+             @"firstLookupUs": @(firstLookupTime / 1e3 / count),
+             @"maxFirstLookupUs": @(maxFirstLookupTime / 1e3),
+             @"repeatedLookupUs": @(repeatedLookupTime / 1e3 / count)};
+}
+
+- (void)testPerformanceStartupWithSyntheticRouters {
+    NSMutableArray<NSDictionary *> *results = [NSMutableArray array];
+    for (NSNumber *count in @[@100, @1000, @10000]) {
+        [results addObject:[self benchmarkWithRouterCount:count.unsignedIntegerValue]];
+    }
+    NSData *json = [NSJSONSerialization dataWithJSONObject:@{@"benchmark": @"ZIKRegistryStartup", @"results": results} options:NSJSONWritingPrettyPrinted error:nil];
+    XCTAssertNotNil(json);
+    NSString *path = [NSProcessInfo processInfo].environment[@"ZIKROUTER_BENCHMARK_OUTPUT"];
+    if (path.length == 0) {
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"ZIKRegistryStartupBenchmark.json"];
+    }
+    XCTAssertTrue([json writeToFile:path atomically:YES]);
+    NSLog(@"Registry startup benchmark (%@):\n%@", path, [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding]);
+}
+
+@end
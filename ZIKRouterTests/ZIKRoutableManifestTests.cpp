@@ -0,0 +1,247 @@
+//
+//  ZIKRoutableManifestTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKRoutableManifest.h"
+#include "ZIKRoutableSymbolParser.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t N_SECT_EXT = macho::N_SECT | macho::N_EXT;
+static const uint8_t N_UNDF_EXT = macho::N_UNDF | macho::N_EXT;
+/// N_FUN debug symbol.
+static const uint8_t N_FUN = 0x24;
+
+// Mangled names of routable declarations and usages, in the form emitted by swift 5 compiler.
+
+/// type metadata accessor for ZRouter.RoutableService<__C.ZIKLoginServiceInput>
+static const char *const ObjCRoutingTypeSymbol = "_$s7ZRouter15RoutableServiceVySo08ZIKLoginC5Input_pGMa";
+/// type metadata accessor for ZRouter.RoutableService<MyApp.LoginServiceInput>
+static const char *const SwiftRoutingTypeSymbol = "_$s7ZRouter15RoutableServiceVy5MyApp05LoginC5Input_pGMa";
+/// type metadata accessor for ZRouter.RoutableViewModule<MyApp.LoginViewModuleInput>
+static const char *const ViewModuleRoutingTypeSymbol = "_$s7ZRouter18RoutableViewModuleVy5MyApp05LogincD5Input_pGMa";
+/// type metadata accessor for ZRouter.RoutableService<MyApp.Foo & MyApp.Bar>
+static const char *const CompositionRoutingTypeSymbol = "_$s7ZRouter15RoutableServiceVy5MyApp3Foo_AD3BarpGMa";
+/// (extension in MyApp):ZRouter.RoutableService<A where A == MyApp.LoginServiceInput>.init() -> ZRouter.RoutableService<MyApp.LoginServiceInput>
+static const char *const DeclarationSymbol = "_$s7ZRouter15RoutableServiceV5MyAppAD05LoginC5Input_pRszlEACyAdE_pGycfC";
+/// (extension in ZRouter):ZRouter.RoutableService<A where A: __C.NSObject, A: __C.ZIKServiceRoutable>.init() -> ZRouter.RoutableService<A>
+static const char *const ConstrainedInitializerSymbol = "_$s7ZRouter15RoutableServiceVAASo8NSObjectCRbzSo010ZIKServiceB0RzlEACyxGycfC";
+/// ZRouter.RoutableService.init(declaredProtocol: A.Type) -> ZRouter.RoutableService<A>
+static const char *const DeclaredProtocolInitializerSymbol = "_$s7ZRouter15RoutableServiceV16declaredProtocolACyxGxm_tcfC";
+/// ZRouter.RoutableService.init(declaredTypeName: Swift.String) -> ZRouter.RoutableService<A>
+static const char *const DeclaredTypeNameInitializerSymbol = "_$s7ZRouter15RoutableServiceV16declaredTypeNameACyxGSS_tcfC";
+/// type metadata accessor for ZRouter.RoutableService
+static const char *const UnboundTypeSymbol = "_$s7ZRouter15RoutableServiceVMa";
+/// type metadata accessor for ZRouter.RoutableService<some opaque type>, not supported by the parser
+static const char *const OpaqueRoutingTypeSymbol = "_$s7ZRouter15RoutableServiceVy5MyApp3FooQo_GMa";
+
+static RoutableSymbolParser::Result parseSymbol(const char *name, RoutableSymbol &symbol) {
+    return RoutableSymbolParser::parse(name, symbol);
+}
+
+static std::vector<uint8_t> manifestImage(const std::vector<MachOFixtureBuilder::Symbol> &symbols, uint8_t uuidByte, int32_t cpuType = 0x0100000c) {
+    MachOFixtureBuilder builder(true, macho::MH_EXECUTE, cpuType);
+    uint8_t uuid[16];
+    for (int i = 0; i < 16; i++) {
+        uuid[i] = static_cast<uint8_t>(uuidByte + i);
+    }
+    builder.setUUID(uuid);
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, symbol.value, symbol.desc);
+    }
+    return builder.build();
+}
+
+static std::vector<MachOFixtureBuilder::Symbol> appSymbols() {
+    return {
+        {DeclarationSymbol, N_SECT_EXT, 1, 0, 0x100004000},
+        {SwiftRoutingTypeSymbol, N_SECT_EXT, 1, 0, 0x100004100},
+        {ObjCRoutingTypeSymbol, N_SECT_EXT, 1, 0, 0x100004200},
+        {ConstrainedInitializerSymbol, N_UNDF_EXT, 0, 0, 0},
+        {DeclaredProtocolInitializerSymbol, N_UNDF_EXT, 0, 0, 0},
+        {UnboundTypeSymbol, N_UNDF_EXT, 0, 0, 0},
+        {SwiftRoutingTypeSymbol, N_FUN, 1, 0, 0x100004100},
+        {"_$s5MyApp13LoginServiceC4nameSSvg", N_SECT_EXT, 1, 0, 0x100004300},
+        {"_objc_msgSend", N_UNDF_EXT, 0, 0, 0},
+    };
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testParseRoutingTypes) {
+    RoutableSymbol symbol;
+    ZIK_ASSERT_EQUAL(parseSymbol(ObjCRoutingTypeSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_EQUAL(symbol.kind, RoutableSymbol::RoutingType);
+    ZIK_ASSERT_TRUE(symbol.routable == "RoutableService");
+    ZIK_ASSERT_TRUE(symbol.protocolName == "__C.ZIKLoginServiceInput");
+    ZIK_ASSERT_TRUE(symbol.module.empty());
+    ZIK_ASSERT_TRUE(symbol.signature.empty());
+
+    ZIK_ASSERT_EQUAL(parseSymbol(SwiftRoutingTypeSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_EQUAL(symbol.kind, RoutableSymbol::RoutingType);
+    ZIK_ASSERT_TRUE(symbol.protocolName == "MyApp.LoginServiceInput");
+
+    ZIK_ASSERT_EQUAL(parseSymbol(ViewModuleRoutingTypeSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_TRUE(symbol.routable == "RoutableViewModule");
+    ZIK_ASSERT_TRUE(symbol.protocolName == "MyApp.LoginViewModuleInput");
+
+    ZIK_ASSERT_EQUAL(parseSymbol(CompositionRoutingTypeSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_TRUE(symbol.protocolName == "MyApp.Foo & MyApp.Bar");
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testParseDeclarations) {
+    RoutableSymbol symbol;
+    ZIK_ASSERT_EQUAL(parseSymbol(DeclarationSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_EQUAL(symbol.kind, RoutableSymbol::Declaration);
+    ZIK_ASSERT_TRUE(symbol.routable == "RoutableService");
+    ZIK_ASSERT_TRUE(symbol.protocolName == "MyApp.LoginServiceInput");
+    ZIK_ASSERT_TRUE(symbol.module == "MyApp");
+    ZIK_ASSERT_TRUE(symbol.signature == "<A where A == MyApp.LoginServiceInput>");
+
+    ZIK_ASSERT_EQUAL(parseSymbol(ConstrainedInitializerSymbol, symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_EQUAL(symbol.kind, RoutableSymbol::ConstrainedInitializer);
+    ZIK_ASSERT_TRUE(symbol.routable == "RoutableService");
+    ZIK_ASSERT_TRUE(symbol.protocolName.empty());
+    ZIK_ASSERT_TRUE(symbol.module == "ZRouter");
+    ZIK_ASSERT_TRUE((symbol.signature == "<A where A: __C.NSObject, A: __C.ZIKServiceRoutable>"));
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testIgnoredAndUnsupportedSymbols) {
+    RoutableSymbol symbol;
+    ZIK_ASSERT_EQUAL(parseSymbol(DeclaredProtocolInitializerSymbol, symbol), RoutableSymbolParser::Ignored);
+    ZIK_ASSERT_EQUAL(parseSymbol(DeclaredTypeNameInitializerSymbol, symbol), RoutableSymbolParser::Ignored);
+    ZIK_ASSERT_EQUAL(parseSymbol(UnboundTypeSymbol, symbol), RoutableSymbolParser::Ignored);
+    ZIK_ASSERT_EQUAL(parseSymbol("_$s5MyApp7ServiceVyAA3FooCGMa", symbol), RoutableSymbolParser::Ignored);
+    // Swift 4 mangling, with argument labels in the parameter tuple
+    ZIK_ASSERT_EQUAL(parseSymbol("__T07ZRouter15RoutableServiceVACyxGxm16declaredProtocol_tcfC", symbol), RoutableSymbolParser::Ignored);
+    ZIK_ASSERT_EQUAL(parseSymbol("__T07ZRouter15RoutableServiceVy5MyApp05LoginC5Input_pGMa", symbol), RoutableSymbolParser::Parsed);
+    ZIK_ASSERT_TRUE(symbol.protocolName == "MyApp.LoginServiceInput");
+    // Suffixes are ignored
+    std::string suffixed = std::string(SwiftRoutingTypeSymbol) + ".cold.1";
+    ZIK_ASSERT_EQUAL(parseSymbol(suffixed.c_str(), symbol), RoutableSymbolParser::Parsed);
+
+    ZIK_ASSERT_EQUAL(parseSymbol(OpaqueRoutingTypeSymbol, symbol), RoutableSymbolParser::Unsupported);
+    ZIK_ASSERT_EQUAL(parseSymbol("_objc_msgSend", symbol), RoutableSymbolParser::Unsupported);
+    ZIK_ASSERT_EQUAL(parseSymbol(nullptr, symbol), RoutableSymbolParser::Unsupported);
+    // Broken names
+    const char *brokenNames[] = {
+        "_$s", "_$s7ZRouter", "_$s7ZRouter15Routable", "_$s7ZRouter15RoutableServiceVyGMa", "_$s7ZRouter15RoutableServiceVyAZ_pGMa",
+        "_$s7ZRouter15RoutableServiceVy0z_pGMa", "_$s7ZRouter15RoutableServiceVy5MyApp00LoginC5Input_pGMa", "_$sMa", "_$s7ZRouter15RoutableServiceVAA99RzlEACyxGycfC",
+    };
+    for (const char *name : brokenNames) {
+        ZIK_ASSERT_EQUAL(parseSymbol(name, symbol), RoutableSymbolParser::Unsupported);
+    }
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testManifestOfImage) {
+    RoutableManifest manifest;
+    std::vector<uint8_t> file = manifestImage(appSymbols(), 0x10);
+    std::string error;
+    ZIK_ASSERT_TRUE(manifest.addFile(file.data(), file.size(), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/App", error));
+    ZIK_ASSERT_TRUE(manifest.isComplete());
+    ZIK_ASSERT_EQUAL(manifest.images().size(), (size_t)1);
+    ZIK_ASSERT_TRUE(manifest.images()[0].path == "App.app/App");
+    ZIK_ASSERT_TRUE(manifest.images()[0].uuid == "10111213-1415-1617-1819-1A1B1C1D1E1F");
+
+    const std::vector<RoutableManifestEntry> &entries = manifest.entries();
+    ZIK_ASSERT_EQUAL(entries.size(), (size_t)4);
+    if (entries.size() != 4) {
+        return;
+    }
+    ZIK_ASSERT_EQUAL(entries[0].symbol.kind, RoutableSymbol::Declaration);
+    ZIK_ASSERT_TRUE(entries[0].symbolName == DeclarationSymbol);
+    ZIK_ASSERT_TRUE(entries[0].image == "App.app/App");
+    ZIK_ASSERT_TRUE(entries[0].defined);
+    ZIK_ASSERT_EQUAL(entries[0].address, 0x100004000ULL);
+    ZIK_ASSERT_EQUAL(entries[1].symbol.kind, RoutableSymbol::RoutingType);
+    ZIK_ASSERT_TRUE(entries[1].symbol.protocolName == "MyApp.LoginServiceInput");
+    ZIK_ASSERT_EQUAL(entries[2].symbol.kind, RoutableSymbol::RoutingType);
+    ZIK_ASSERT_TRUE(entries[2].symbol.protocolName == "__C.ZIKLoginServiceInput");
+    ZIK_ASSERT_EQUAL(entries[3].symbol.kind, RoutableSymbol::ConstrainedInitializer);
+    ZIK_ASSERT_FALSE(entries[3].defined);
+    ZIK_ASSERT_EQUAL(entries[3].address, 0ULL);
+
+    std::string json = manifest.json();
+    ZIK_ASSERT_TRUE(json.find("\"complete\": true") != std::string::npos);
+    ZIK_ASSERT_TRUE(json.find("{\"path\": \"App.app/App\", \"uuid\": \"10111213-1415-1617-1819-1A1B1C1D1E1F\"}") != std::string::npos);
+    ZIK_ASSERT_TRUE(json.find("{\"kind\": \"declaration\", \"routable\": \"RoutableService\", \"protocol\": \"MyApp.LoginServiceInput\", \"module\": \"MyApp\", \"signature\": \"<A where A == MyApp.LoginServiceInput>\", \"image\": \"App.app/App\", \"symbol\": \"_$s7ZRouter15RoutableServiceV5MyAppAD05LoginC5Input_pRszlEACyAdE_pGycfC\", \"address\": \"0x100004000\"}") != std::string::npos);
+    ZIK_ASSERT_TRUE(json.find("{\"kind\": \"constrainedInitializer\", \"routable\": \"RoutableService\", \"module\": \"ZRouter\", \"signature\": \"<A where A: __C.NSObject, A: __C.ZIKServiceRoutable>\", \"image\": \"App.app/App\", \"symbol\": \"_$s7ZRouter15RoutableServiceVAASo8NSObjectCRbzSo010ZIKServiceB0RzlEACyxGycfC\"}") != std::string::npos);
+    ZIK_ASSERT_TRUE(json.find("\"unsupportedSymbols\": []") != std::string::npos);
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testIncompleteManifest) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = appSymbols();
+    MachOFixtureBuilder::Symbol opaque = {OpaqueRoutingTypeSymbol, N_SECT_EXT, 1, 0, 0x100004400};
+    symbols.push_back(opaque);
+    RoutableManifest manifest;
+    std::vector<uint8_t> file = manifestImage(symbols, 0x20);
+    std::string error;
+    ZIK_ASSERT_TRUE(manifest.addFile(file.data(), file.size(), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/App", error));
+    ZIK_ASSERT_FALSE(manifest.isComplete());
+    ZIK_ASSERT_EQUAL(manifest.entries().size(), (size_t)4);
+    ZIK_ASSERT_TRUE(manifest.unsupportedSymbols() == std::vector<std::string>{OpaqueRoutingTypeSymbol});
+    std::string json = manifest.json();
+    ZIK_ASSERT_TRUE(json.find("\"complete\": false") != std::string::npos);
+    ZIK_ASSERT_TRUE(json.find(std::string("\"unsupportedSymbols\": [\n    \"") + OpaqueRoutingTypeSymbol + "\"\n  ]") != std::string::npos);
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testFatFile) {
+    std::vector<uint8_t> arm64 = manifestImage(appSymbols(), 0x30, 0x0100000c);
+    std::vector<uint8_t> x86_64 = manifestImage(appSymbols(), 0x40, 0x01000007);
+    std::vector<uint8_t> fat = MachOFixtureBuilder::fat({{0x0100000c, arm64}, {0x01000007, x86_64}});
+    std::string error;
+
+    RoutableManifest manifest;
+    ZIK_ASSERT_TRUE(manifest.addFile(fat.data(), fat.size(), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/App", error));
+    // Each slice has its uuid, and symbols are only added once
+    ZIK_ASSERT_EQUAL(manifest.images().size(), (size_t)2);
+    ZIK_ASSERT_TRUE(manifest.images()[0].uuid == "30313233-3435-3637-3839-3A3B3C3D3E3F");
+    ZIK_ASSERT_TRUE(manifest.images()[1].uuid == "40414243-4445-4647-4849-4A4B4C4D4E4F");
+    ZIK_ASSERT_EQUAL(manifest.entries().size(), (size_t)4);
+
+    RoutableManifest x86Manifest;
+    ZIK_ASSERT_TRUE(x86Manifest.addFile(fat.data(), fat.size(), 0x01000007, RoutableManifest::AnyCPU, "App.app/App", error));
+    ZIK_ASSERT_EQUAL(x86Manifest.images().size(), (size_t)1);
+    ZIK_ASSERT_TRUE(x86Manifest.images()[0].uuid == "40414243-4445-4647-4849-4A4B4C4D4E4F");
+
+    RoutableManifest missingManifest;
+    ZIK_ASSERT_FALSE(missingManifest.addFile(fat.data(), fat.size(), 7, RoutableManifest::AnyCPU, "App.app/App", error));
+    ZIK_ASSERT_TRUE(error == "no slice matches the architecture");
+    uint8_t garbage[8] = {0};
+    ZIK_ASSERT_FALSE(missingManifest.addFile(garbage, sizeof(garbage), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/App", error));
+}
+
+ZIK_TEST(ZIKRoutableManifestTests, testSeveralImages) {
+    // The framework defines constrained initializers, and the app references them
+    std::vector<MachOFixtureBuilder::Symbol> frameworkSymbols = {
+        {ConstrainedInitializerSymbol, N_SECT_EXT, 1, 0, 0x4000},
+        {DeclaredProtocolInitializerSymbol, N_SECT_EXT, 1, 0, 0x4100},
+        {UnboundTypeSymbol, N_SECT_EXT, 1, 0, 0x4200},
+    };
+    std::vector<uint8_t> framework = manifestImage(frameworkSymbols, 0x50);
+    std::vector<uint8_t> app = manifestImage(appSymbols(), 0x60);
+    RoutableManifest manifest;
+    std::string error;
+    ZIK_ASSERT_TRUE(manifest.addFile(app.data(), app.size(), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/App", error));
+    ZIK_ASSERT_TRUE(manifest.addFile(framework.data(), framework.size(), RoutableManifest::AnyCPU, RoutableManifest::AnyCPU, "App.app/Frameworks/ZRouter.framework/ZRouter", error));
+    ZIK_ASSERT_EQUAL(manifest.images().size(), (size_t)2);
+    ZIK_ASSERT_EQUAL(manifest.entries().size(), (size_t)5);
+    if (manifest.entries().size() != 5) {
+        return;
+    }
+    const RoutableManifestEntry &entry = manifest.entries()[4];
+    ZIK_ASSERT_EQUAL(entry.symbol.kind, RoutableSymbol::ConstrainedInitializer);
+    ZIK_ASSERT_TRUE(entry.image == "App.app/Frameworks/ZRouter.framework/ZRouter");
+    ZIK_ASSERT_TRUE(entry.defined);
+    ZIK_ASSERT_EQUAL(entry.address, 0x4000ULL);
+}
@@ -0,0 +1,274 @@
+//
+//  ZIKRouteRegistryTests.m
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+@import ZIKRouter.Private;
+#import <objc/runtime.h>
+#import "ZIKFrozenRouteTable.h"
+
+@interface ZIKRouteRegistry (Tests)
++ (BOOL)_scheduleDeferredRouterClasses:(nullable NSArray<Class> *)routerClasses;
++ (void)_runDeferredRegistrationSlice;
++ (void)_registerRouterClassLately:(Class)routerClass;
++ (void)_useFrozenRouteTable:(ZIKFrozenRouteTableRef)table images:(const void *_Nullable *_Nonnull)images;
++ (void)_closeFrozenRouteTable;
++ (nullable NSArray<Class> *)_eagerRouterClassesInFrozenImage:(const void *)imageHeader;
+@end
+
+/// Headers of images in frozen route tables of tests. Router classes created at runtime are not in any image, so tests only use the addresses.
+static const char kFrozenImage = 0;
+static const char kNotFrozenImage = 0;
+static const uint8_t kFrozenImageUUID[16] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+
+/// Registration is finished when tests run, so routers are created at runtime and registered with private methods of registry, in the same way as routers registered after +registerAll.
+@interface ZIKRouteRegistryTests : XCTestCase
+@end
+
+@implementation ZIKRouteRegistryTests
+
+/// Create service routers registering a service class and a protocol. Registration count of each router is recorded in `registrationCounts`.
+- (NSArray<Class> *)makeRoutersWithName:(NSString *)name count:(NSUInteger)count protocols:(NSMutableArray<Protocol *> *)protocols registrationCounts:(NSCountedSet *)registrationCounts {
+    NSMutableArray<Class> *routers = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *protocolName = [NSString stringWithFormat:@"%@Service%lu", name, (unsigned long)i];
+        Protocol *protocol = objc_allocateProtocol(protocolName.UTF8String);
+        protocol_addProtocol(protocol, @protocol(ZIKServiceRoutable));
+        objc_registerProtocol(protocol);
+        [protocols addObject:protocol];
+
+        NSString *serviceName = [NSString stringWithFormat:@"%@ServiceImpl%lu", name, (unsigned long)i];
+        Class serviceClass = objc_allocateClassPair([NSObject class], serviceName.UTF8String, 0);
+        class_addProtocol(serviceClass, @protocol(ZIKRoutableService));
+        class_addProtocol(serviceClass, protocol);
+        objc_registerClassPair(serviceClass);
+
+        NSString *routerName = [NSString stringWithFormat:@"%@Router%lu", name, (unsigned long)i];
+        Class routerClass = objc_allocateClassPair([ZIKServiceRouter class], routerName.UTF8String, 0);
+        IMP registerImp = imp_implementationWithBlock(^(Class router) {
+            @synchronized (registrationCounts) {
+                [registrationCounts addObject:router];
+            }
+            [router registerService:serviceClass];
+            [router registerServiceProtocol:protocol];
+        });
+        class_addMethod(object_getClass(routerClass), @selector(registerRoutableDestination), registerImp, "v@:");
+        objc_registerClassPair(routerClass);
+        [routers addObject:routerClass];
+    }
+    return routers;
+}
+
+/// Use a frozen route table with entries of the builder. The first image in the table is loaded as `kFrozenImage`, the second one is not loaded.
+- (void)useFrozenRouteTableWithBuilder:(ZIKFrozenRouteTableBuilderRef)builder {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"ZIKRouteRegistryTests.table"];
+    XCTAssert(ZIKFrozenRouteTableBuilderWriteToFile(builder, path.fileSystemRepresentation));
+    ZIKFrozenRouteTableBuilderDestroy(builder);
+    ZIKFrozenRouteTableRef table = ZIKFrozenRouteTableOpen(path.fileSystemRepresentation, NULL);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    XCTAssert(table != NULL);
+    const void **images = calloc(ZIKFrozenRouteTableImageCount(table) + 1, sizeof(void *));
+    images[0] = &kFrozenImage;
+    [ZIKRouteRegistry _useFrozenRouteTable:table images:images];
+}
+
+- (void)testConcurrentMissesDuringDeferredRegistration {
+    const NSUInteger routerCount = 200;
+    const NSUInteger threadCount = 8;
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray arrayWithCapacity:routerCount];
+    NSCountedSet *registrationCounts = [NSCountedSet set];
+    NSArray<Class> *routers = [self makeRoutersWithName:@"ZIKConcurrentMiss_" count:routerCount protocols:protocols registrationCounts:registrationCounts];
+
+    NSTimeInterval sliceBudget = ZIKRouteRegistry.deferredRegistrationSliceBudget;
+    // Each slice registers one router, so main thread keeps running slices while other threads miss
+    ZIKRouteRegistry.deferredRegistrationSliceBudget = 0;
+    XCTAssertTrue([ZIKRouteRegistry _scheduleDeferredRouterClasses:routers]);
+    XCTAssertTrue(ZIKRouteRegistry.hasPendingDeferredRegistration);
+
+    dispatch_group_t group = dispatch_group_create();
+    NSMutableArray<NSNumber *> *missingCounts = [NSMutableArray array];
+    for (NSUInteger thread = 0; thread < threadCount; thread++) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            NSUInteger missing = 0;
+            // Threads look up routers from different positions, so they miss routers registered by slices and by each other
+            for (NSUInteger i = 0; i < routerCount; i++) {
+                Protocol *protocol = protocols[(i + thread * routerCount / threadCount) % routerCount];
+                if (_ZIKServiceRouterToService(protocol) == nil) {
+                    missing++;
+                }
+            }
+            @synchronized (missingCounts) {
+                [missingCounts addObject:@(missing)];
+            }
+        });
+    }
+    while (dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0) {
+        [ZIKRouteRegistry _runDeferredRegistrationSlice];
+    }
+    ZIKRouteRegistry.deferredRegistrationSliceBudget = sliceBudget;
+
+    XCTAssertFalse(ZIKRouteRegistry.hasPendingDeferredRegistration);
+    XCTAssertFalse([ZIKRouteRegistry completeDeferredRegistration]);
+    XCTAssertEqual(missingCounts.count, threadCount);
+    for (NSNumber *missing in missingCounts) {
+        XCTAssertEqual(missing.unsignedIntegerValue, 0);
+    }
+    for (Class router in routers) {
+        XCTAssertEqual([registrationCounts countForObject:router], 1, @"Router (%@) should be registered once.", router);
+    }
+    // Slices after finishing do nothing
+    [ZIKRouteRegistry _runDeferredRegistrationSlice];
+    XCTAssertEqual(registrationCounts.count, routerCount);
+}
+
+- (void)testLookupsFoundInRegisteredRoutesKeepDeferredRegistration {
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
+    NSCountedSet *registrationCounts = [NSCountedSet set];
+    NSArray<Class> *routers = [self makeRoutersWithName:@"ZIKDeferredUntilMiss_" count:2 protocols:protocols registrationCounts:registrationCounts];
+    [ZIKRouteRegistry _registerRouterClassLately:routers[0]];
+    XCTAssertTrue([ZIKRouteRegistry _scheduleDeferredRouterClasses:@[routers[1]]]);
+
+    // Registered routes answer the lookup without registering deferred routers
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:protocols[0]]);
+    XCTAssertTrue(ZIKRouteRegistry.hasPendingDeferredRegistration);
+    XCTAssertEqual([registrationCounts countForObject:routers[1]], 0);
+
+    // Deferred routers are registered once when a lookup misses all registered routes
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:protocols[1]]);
+    XCTAssertFalse(ZIKRouteRegistry.hasPendingDeferredRegistration);
+    XCTAssertEqual([registrationCounts countForObject:routers[1]], 1);
+}
+
+- (void)testLateRegistrationOnlyReopensRegistrationInRegisteringThread {
+    XCTAssertTrue(ZIKRouteRegistry.registrationFinished);
+    Class routerClass = objc_allocateClassPair([ZIKServiceRouter class], "ZIKLateRegistrationThreadRouter", 0);
+    dispatch_semaphore_t registering = dispatch_semaphore_create(0);
+    dispatch_semaphore_t checked = dispatch_semaphore_create(0);
+    __block BOOL finishedInRegisteringThread = YES;
+    IMP registerImp = imp_implementationWithBlock(^(Class router) {
+        finishedInRegisteringThread = ZIKRouteRegistry.registrationFinished;
+        dispatch_semaphore_signal(registering);
+        dispatch_semaphore_wait(checked, DISPATCH_TIME_FOREVER);
+    });
+    class_addMethod(object_getClass(routerClass), @selector(registerRoutableDestination), registerImp, "v@:");
+    objc_registerClassPair(routerClass);
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        [ZIKRouteRegistry _registerRouterClassLately:routerClass];
+    });
+    dispatch_semaphore_wait(registering, DISPATCH_TIME_FOREVER);
+    // Other threads still see registration as finished when a router is registering lately
+    XCTAssertTrue(ZIKRouteRegistry.registrationFinished);
+    XCTAssertTrue(ZIKServiceRouteRegistry.registrationFinished);
+    dispatch_semaphore_signal(checked);
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    XCTAssertFalse(finishedInRegisteringThread);
+    XCTAssertTrue(ZIKRouteRegistry.registrationFinished);
+}
+
+- (void)testDestinationClassesAreNotifiedInRegisteringThread {
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
+    NSCountedSet *registrationCounts = [NSCountedSet set];
+    Class routerClass = [self makeRoutersWithName:@"ZIKOffMainRegistration_" count:1 protocols:protocols registrationCounts:registrationCounts].firstObject;
+    Class destinationClass = NSClassFromString(@"ZIKOffMainRegistration_ServiceImpl0");
+
+    SEL selector = @selector(didRegisterDestinationClass:);
+    Class registryMetaClass = object_getClass([ZIKServiceRouteRegistry class]);
+    Method method = class_getClassMethod([ZIKServiceRouteRegistry class], selector);
+    IMP originalIMP = method_getImplementation(method);
+    NSMutableArray<Class> *notifiedClasses = [NSMutableArray array];
+    __block BOOL notifiedInOtherThread = NO;
+    __block NSThread *registeringThread = nil;
+    IMP recordingIMP = imp_implementationWithBlock(^(Class registry, Class registeredClass) {
+        if ([NSThread currentThread] != registeringThread) {
+            notifiedInOtherThread = YES;
+        }
+        [notifiedClasses addObject:registeredClass];
+    });
+    class_replaceMethod(registryMetaClass, selector, recordingIMP, method_getTypeEncoding(method));
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        registeringThread = [NSThread currentThread];
+        [ZIKRouteRegistry _registerRouterClassLately:routerClass];
+        // Hooks are installed before registration returns, without waiting for main queue
+        XCTAssertEqualObjects(notifiedClasses, @[destinationClass]);
+    });
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    class_replaceMethod(registryMetaClass, selector, originalIMP, method_getTypeEncoding(method));
+
+    XCTAssertFalse(notifiedInOtherThread);
+    XCTAssertEqualObjects(notifiedClasses, @[destinationClass]);
+    XCTAssertEqual([registrationCounts countForObject:routerClass], 1);
+}
+
+- (void)testFrozenRoutesAreRegisteredWhenTheyAreFound {
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
+    NSCountedSet *registrationCounts = [NSCountedSet set];
+    NSArray<Class> *routers = [self makeRoutersWithName:@"ZIKFrozenBinding_" count:2 protocols:protocols registrationCounts:registrationCounts];
+    ZIKFrozenRouteTableBuilderRef builder = ZIKFrozenRouteTableBuilderCreate();
+    uint32_t image = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/ZIKFrozenBinding.framework/ZIKFrozenBinding", kFrozenImageUUID);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindDestinationProtocol, "ZIKServiceRouteRegistry", protocol_getName(protocols[0]), class_getName(routers[0]), image);
+    // The second router has no key in the table, like routers registering pure swift protocols
+    for (Class router in routers) {
+        ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindRouterClass, "ZIKServiceRouteRegistry", class_getName(router), class_getName(router), image);
+    }
+    [self useFrozenRouteTableWithBuilder:builder];
+
+    XCTAssertEqual(registrationCounts.count, 0);
+    // Lookup with a key in the table registers the router
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:protocols[0]]);
+    XCTAssertEqual([registrationCounts countForObject:routers[0]], 1);
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:protocols[0]]);
+    XCTAssertEqual([registrationCounts countForObject:routers[0]], 1);
+    XCTAssertNil([ZIKServiceRouteRegistry routerToDestination:protocols[1]]);
+    XCTAssertEqual([registrationCounts countForObject:routers[1]], 0);
+
+    // Lookups without keys register all routers in the table
+    XCTAssertTrue([ZIKRouteRegistry completeRegistration]);
+    XCTAssertNotNil([ZIKServiceRouteRegistry routerToDestination:protocols[1]]);
+    XCTAssertFalse([ZIKRouteRegistry completeRegistration]);
+    for (Class router in routers) {
+        XCTAssertEqual([registrationCounts countForObject:router], 1, @"Router (%@) should be registered once.", router);
+    }
+    [ZIKRouteRegistry _closeFrozenRouteTable];
+}
+
+- (void)testEagerRoutersInFrozenRouteTableAreRegisteredAtLaunch {
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
+    NSCountedSet *registrationCounts = [NSCountedSet set];
+    NSArray<Class> *routers = [self makeRoutersWithName:@"ZIKFrozenEager_" count:3 protocols:protocols registrationCounts:registrationCounts];
+    ZIKFrozenRouteTableBuilderRef builder = ZIKFrozenRouteTableBuilderCreate();
+    uint32_t image = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/ZIKFrozenEager.framework/ZIKFrozenEager", kFrozenImageUUID);
+    uint32_t unloadedImage = ZIKFrozenRouteTableBuilderAddImage(builder, "@rpath/ZIKFrozenUnloaded.framework/ZIKFrozenUnloaded", kFrozenImageUUID);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindEagerRouterClass, "ZIKRouteRegistry", class_getName(routers[0]), class_getName(routers[0]), image);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindEagerRouterClass, "ZIKRouteRegistry", class_getName(routers[2]), class_getName(routers[2]), unloadedImage);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindRouterClass, "ZIKServiceRouteRegistry", class_getName(routers[0]), class_getName(routers[0]), image);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindRouterClass, "ZIKServiceRouteRegistry", class_getName(routers[1]), class_getName(routers[1]), image);
+    ZIKFrozenRouteTableBuilderAddEntry(builder, ZIKFrozenRouteKindRouterClass, "ZIKServiceRouteRegistry", class_getName(routers[2]), class_getName(routers[2]), unloadedImage);
+    [self useFrozenRouteTableWithBuilder:builder];
+
+    // +registerAll registers eager routers when searching the image, and searches images not in the table as usual
+    XCTAssertEqualObjects([ZIKRouteRegistry _eagerRouterClassesInFrozenImage:&kFrozenImage], @[routers[0]]);
+    XCTAssertNil([ZIKRouteRegistry _eagerRouterClassesInFrozenImage:&kNotFrozenImage]);
+    [ZIKRouteRegistry _registerRouterClassLately:routers[0]];
+
+    // Eager routers are not registered again, and routers in images not loaded are never registered
+    XCTAssertTrue([ZIKRouteRegistry completeRegistration]);
+    XCTAssertEqual([registrationCounts countForObject:routers[0]], 1);
+    XCTAssertEqual([registrationCounts countForObject:routers[1]], 1);
+    XCTAssertEqual([registrationCounts countForObject:routers[2]], 0);
+    XCTAssertNil([ZIKServiceRouteRegistry routerToDestination:protocols[2]]);
+    [ZIKRouteRegistry _closeFrozenRouteTable];
+    XCTAssertNil([ZIKRouteRegistry _eagerRouterClassesInFrozenImage:&kFrozenImage]);
+}
+
+@end
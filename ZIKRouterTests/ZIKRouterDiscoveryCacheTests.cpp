@@ -0,0 +1,214 @@
+//
+//  ZIKRouterDiscoveryCacheTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKRouterDiscoveryCache.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t kUUIDA[16] = {0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf};
+static const uint8_t kUUIDB[16] = {0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf};
+static const uint8_t kUUIDC[16] = {0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf};
+
+static std::vector<uint8_t> cacheBytes(ZIKRouterDiscoveryCacheRef cache) {
+    size_t size = 0;
+    uint8_t *bytes = (uint8_t *)ZIKRouterDiscoveryCacheCopyBytes(cache, &size);
+    std::vector<uint8_t> result(bytes, bytes + size);
+    free(bytes);
+    return result;
+}
+
+static bool lookupNames(ZIKRouterDiscoveryCacheRef cache, const uint8_t uuid[16], std::vector<std::string> &names) {
+    const char *const *classNames = NULL;
+    uint32_t count = 0;
+    names.clear();
+    if (!ZIKRouterDiscoveryCacheLookup(cache, uuid, &classNames, &count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        names.push_back(classNames[i]);
+    }
+    return true;
+}
+
+static std::vector<uint8_t> sampleBytes() {
+    ZIKRouterDiscoveryCacheRef cache = ZIKRouterDiscoveryCacheCreate();
+    const char *namesA[] = {"AServiceRouter", "AViewRouter", "_TtC7ModuleA12ASwiftRouter"};
+    const char *namesB[] = {"BRouter"};
+    ZIKRouterDiscoveryCacheSetImage(cache, kUUIDB, namesB, 1);
+    ZIKRouterDiscoveryCacheSetImage(cache, kUUIDA, namesA, 3);
+    // Image without routers is cached too
+    ZIKRouterDiscoveryCacheSetImage(cache, kUUIDC, NULL, 0);
+    std::vector<uint8_t> bytes = cacheBytes(cache);
+    ZIKRouterDiscoveryCacheDestroy(cache);
+    return bytes;
+}
+
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testLookup) {
+    std::vector<uint8_t> bytes = sampleBytes();
+    ZIKRouterDiscoveryCacheError error;
+    ZIKRouterDiscoveryCacheRef cache = ZIKRouterDiscoveryCacheCreateWithBytes(bytes.data(), bytes.size(), &error);
+    ZIK_ASSERT_TRUE(cache != NULL);
+    ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorNone);
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheImageCount(cache) == 3);
+
+    std::vector<std::string> names;
+    ZIK_ASSERT_TRUE(lookupNames(cache, kUUIDA, names));
+    ZIK_ASSERT_TRUE(names.size() == 3);
+    ZIK_ASSERT_TRUE(names[0] == "AServiceRouter");
+    ZIK_ASSERT_TRUE(names[2] == "_TtC7ModuleA12ASwiftRouter");
+    ZIK_ASSERT_TRUE(lookupNames(cache, kUUIDB, names));
+    ZIK_ASSERT_TRUE(names.size() == 1 && names[0] == "BRouter");
+    ZIK_ASSERT_TRUE(lookupNames(cache, kUUIDC, names));
+    ZIK_ASSERT_TRUE(names.empty());
+
+    uint8_t unknown[16] = {0};
+    ZIK_ASSERT_TRUE(!lookupNames(cache, unknown, names));
+
+    // Serializing is deterministic
+    ZIK_ASSERT_TRUE(cacheBytes(cache) == bytes);
+    ZIKRouterDiscoveryCacheDestroy(cache);
+}
+
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testUpdateImages) {
+    std::vector<uint8_t> bytes = sampleBytes();
+    ZIKRouterDiscoveryCacheRef cache = ZIKRouterDiscoveryCacheCreateWithBytes(bytes.data(), bytes.size(), NULL);
+    const char *names[] = {"BRouter", "BSubRouter"};
+    ZIKRouterDiscoveryCacheSetImage(cache, kUUIDB, names, 2);
+    ZIKRouterDiscoveryCacheRemoveImage(cache, kUUIDC);
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheImageCount(cache) == 2);
+
+    // Empty name is rejected
+    const char *invalidNames[] = {"ARouter", ""};
+    ZIKRouterDiscoveryCacheSetImage(cache, kUUIDA, invalidNames, 2);
+
+    std::vector<uint8_t> updated = cacheBytes(cache);
+    ZIKRouterDiscoveryCacheDestroy(cache);
+    cache = ZIKRouterDiscoveryCacheCreateWithBytes(updated.data(), updated.size(), NULL);
+    ZIK_ASSERT_TRUE(cache != NULL);
+    std::vector<std::string> result;
+    ZIK_ASSERT_TRUE(lookupNames(cache, kUUIDB, result));
+    ZIK_ASSERT_TRUE(result.size() == 2 && result[1] == "BSubRouter");
+    ZIK_ASSERT_TRUE(lookupNames(cache, kUUIDA, result));
+    ZIK_ASSERT_TRUE(result.size() == 3);
+    ZIK_ASSERT_TRUE(!lookupNames(cache, kUUIDC, result));
+    ZIKRouterDiscoveryCacheDestroy(cache);
+}
+
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testWriteAndOpenFile) {
+    std::string path = temporaryPath("ZIKRouterDiscoveryCacheTests.cache");
+    std::vector<uint8_t> bytes = sampleBytes();
+    ZIKRouterDiscoveryCacheRef cache = ZIKRouterDiscoveryCacheCreateWithBytes(bytes.data(), bytes.size(), NULL);
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheWriteToFile(cache, path.c_str()));
+    ZIKRouterDiscoveryCacheDestroy(cache);
+
+    ZIKRouterDiscoveryCacheError error;
+    cache = ZIKRouterDiscoveryCacheOpen(path.c_str(), &error);
+    ZIK_ASSERT_TRUE(cache != NULL);
+    ZIK_ASSERT_TRUE(cacheBytes(cache) == bytes);
+    ZIKRouterDiscoveryCacheDestroy(cache);
+    remove(path.c_str());
+
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheOpen(path.c_str(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorIO);
+}
+
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testInvalidBytes) {
+    std::vector<uint8_t> bytes = sampleBytes();
+    ZIKRouterDiscoveryCacheError error;
+    for (size_t size : {(size_t)0, (size_t)31, bytes.size() - 1}) {
+        ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheCreateWithBytes(bytes.data(), size, &error) == NULL);
+        ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorTruncated);
+    }
+    // Flipping any byte after header breaks checksum.
+    for (size_t i = 32; i < bytes.size(); i++) {
+        std::vector<uint8_t> corrupted = bytes;
+        corrupted[i] ^= 0x5a;
+        ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheCreateWithBytes(corrupted.data(), corrupted.size(), &error) == NULL);
+        ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorCorrupted);
+    }
+    // Image count out of bounds is rejected even with valid checksum.
+    std::vector<uint8_t> invalidCount = bytes;
+    uint32_t imageCount = 4;
+    memcpy(&invalidCount[16], &imageCount, sizeof(imageCount));
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheCreateWithBytes(invalidCount.data(), invalidCount.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorCorrupted);
+
+    std::vector<uint8_t> newer = bytes;
+    uint32_t version = ZIKRouterDiscoveryCacheVersion + 1;
+    memcpy(&newer[4], &version, sizeof(version));
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheCreateWithBytes(newer.data(), newer.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorVersionMismatch);
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] ^= 0xff;
+    ZIK_ASSERT_TRUE(ZIKRouterDiscoveryCacheCreateWithBytes(badMagic.data(), badMagic.size(), &error) == NULL);
+    ZIK_ASSERT_TRUE(error == ZIKRouterDiscoveryCacheErrorBadMagic);
+}
+
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testUUIDExtraction) {
+    const bool architectures[] = {true, false};
+    for (bool is64Bit : architectures) {
+        MachOFixtureBuilder builder(is64Bit);
+        builder.setUUID(kUUIDA);
+        builder.setInstallName("@rpath/A.framework/A");
+        builder.reserveSection("__DATA", "__objc_classlist", 16);
+        std::vector<uint8_t> file = builder.build();
+
+        uint8_t uuid[16];
+        ZIK_ASSERT_TRUE(ZIKMachOImageCopyUUID(file.data(), uuid));
+        ZIK_ASSERT_TRUE(memcmp(uuid, kUUIDA, 16) == 0);
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+        memset(uuid, 0, sizeof(uuid));
+        ZIK_ASSERT_TRUE(image.copyUUID(uuid));
+        ZIK_ASSERT_TRUE(memcmp(uuid, kUUIDA, 16) == 0);
+    }
+
+    // FAT file should be parsed by slices
+    MachOFixtureBuilder slice;
+    slice.setUUID(kUUIDB);
+    std::vector<uint8_t> fat = MachOFixtureBuilder::fat({std::make_pair(0x0100000c, slice.build())});
+    uint8_t uuid[16];
+    ZIK_ASSERT_TRUE(!ZIKMachOImageCopyUUID(fat.data(), uuid));
+
+    // LC_UUID smaller than uuid_command
+    MachOFixtureBuilder truncated;
+    truncated.addRawLoadCommand(macho::LC_UUID, std::vector<uint8_t>(8, 0xee));
+    std::vector<uint8_t> truncatedFile = truncated.build();
+    ZIK_ASSERT_TRUE(!ZIKMachOImageCopyUUID(truncatedFile.data(), uuid));
+}
+
+/// Rebuilding a binary changes its uuid, so cached router classes of the old binary are not used.
+ZIK_TEST(ZIKRouterDiscoveryCacheTests, testImageChanged) {
+    MachOFixtureBuilder oldBuilder;
+    oldBuilder.setUUID(kUUIDA);
+    std::vector<uint8_t> oldImage = oldBuilder.build();
+    MachOFixtureBuilder newBuilder;
+    newBuilder.setUUID(kUUIDB);
+    std::vector<uint8_t> newImage = newBuilder.build();
+
+    ZIKRouterDiscoveryCacheRef cache = ZIKRouterDiscoveryCacheCreate();
+    uint8_t uuid[16];
+    ZIK_ASSERT_TRUE(ZIKMachOImageCopyUUID(oldImage.data(), uuid));
+    const char *names[] = {"ARouter"};
+    ZIKRouterDiscoveryCacheSetImage(cache, uuid, names, 1);
+
+    std::vector<std::string> result;
+    ZIK_ASSERT_TRUE(ZIKMachOImageCopyUUID(oldImage.data(), uuid));
+    ZIK_ASSERT_TRUE(lookupNames(cache, uuid, result));
+    ZIK_ASSERT_TRUE(ZIKMachOImageCopyUUID(newImage.data(), uuid));
+    ZIK_ASSERT_TRUE(!lookupNames(cache, uuid, result));
+    ZIKRouterDiscoveryCacheDestroy(cache);
+}
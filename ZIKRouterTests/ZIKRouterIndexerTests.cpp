@@ -0,0 +1,272 @@
+//
+//  ZIKRouterIndexerTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKRouterIndexer.h"
+#include "ZIKMachOFixups.h"
+#include "ZIKMachOImage.h"
+#include "ZIKObjCFixtureBuilder.h"
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+/// An image with routers inherited from external classes, local classes and a swift class.
+static std::vector<uint8_t> sampleImage(ObjCFixtureBuilder::PointerFormat format, uint32_t fileType = macho::MH_DYLIB) {
+    ObjCFixtureBuilder builder(format, fileType);
+    size_t base = builder.addClass("BaseViewRouter", "ZIKViewRouter");
+    size_t login = builder.addClass("LoginViewRouter", base);
+    builder.addClass("_TtC6Module15SwiftViewRouter", login, true);
+    builder.addClass("ModuleHelper", "NSObject");
+    builder.addClass("TimeServiceRouter", "ZIKServiceRouter");
+    builder.addClass("RootObject", "");
+    return builder.build();
+}
+
+static std::vector<std::string> routerNames(const std::vector<IndexedRouter> &routers, IndexedRouter::Kind kind) {
+    std::vector<std::string> names;
+    for (const IndexedRouter &router : routers) {
+        if (router.kind == kind) {
+            names.push_back(router.className);
+        }
+    }
+    return names;
+}
+
+static bool indexFile(RouterIndexer &indexer, const std::vector<uint8_t> &file, int32_t cpuType = RouterIndexer::AnyCPU) {
+    std::string error;
+    return indexer.addFile(file.data(), file.size(), cpuType, RouterIndexer::AnyCPU, error);
+}
+
+static void checkSampleRoutersWithFormat(ObjCFixtureBuilder::PointerFormat format) {
+    for (uint32_t fileType : {macho::MH_DYLIB, macho::MH_EXECUTE}) {
+        RouterIndexer indexer;
+        std::vector<uint8_t> file = sampleImage(format, fileType);
+        ZIK_ASSERT_TRUE(indexFile(indexer, file));
+        std::vector<IndexedRouter> routers = indexer.routers();
+        std::vector<std::string> viewRouters = {"BaseViewRouter", "LoginViewRouter", "_TtC6Module15SwiftViewRouter"};
+        ZIK_ASSERT_TRUE(routerNames(routers, IndexedRouter::View) == viewRouters);
+        ZIK_ASSERT_TRUE(routerNames(routers, IndexedRouter::Service) == std::vector<std::string>{"TimeServiceRouter"});
+        ZIK_ASSERT_EQUAL(routers.size(), (size_t)4);
+        ZIK_ASSERT_TRUE(routers[0].kind == IndexedRouter::View);
+    }
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testClassicBindOpcodes) {
+    checkSampleRoutersWithFormat(ObjCFixtureBuilder::Classic);
+
+    std::vector<uint8_t> file = sampleImage(ObjCFixtureBuilder::Classic);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOFixups fixups;
+    ZIK_ASSERT_TRUE(fixups.parse(image));
+    ZIK_ASSERT_FALSE(fixups.hasChainedFixups());
+    ZIK_ASSERT_EQUAL(fixups.imports().size(), (size_t)3);
+    ZIK_ASSERT_TRUE(fixups.imports()[0].name == "_OBJC_CLASS_$_ZIKViewRouter");
+    ZIK_ASSERT_EQUAL(fixups.imports()[0].libraryOrdinal, 1);
+    ZIK_ASSERT_EQUAL(fixups.fixups().size(), (size_t)3);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testChainedFixups64) {
+    checkSampleRoutersWithFormat(ObjCFixtureBuilder::Chained64);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testChainedFixups64Offset) {
+    checkSampleRoutersWithFormat(ObjCFixtureBuilder::Chained64Offset);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testChainedFixupsARM64E) {
+    checkSampleRoutersWithFormat(ObjCFixtureBuilder::ChainedARM64E);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testChainedFixups32) {
+    checkSampleRoutersWithFormat(ObjCFixtureBuilder::Chained32);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testChainedPointers) {
+    const ObjCFixtureBuilder::PointerFormat formats[] = {ObjCFixtureBuilder::Chained64, ObjCFixtureBuilder::Chained64Offset, ObjCFixtureBuilder::ChainedARM64E, ObjCFixtureBuilder::Chained32};
+    const uint16_t pointerFormats[] = {macho::DYLD_CHAINED_PTR_64, macho::DYLD_CHAINED_PTR_64_OFFSET, macho::DYLD_CHAINED_PTR_ARM64E, macho::DYLD_CHAINED_PTR_32};
+    for (size_t i = 0; i < 4; i++) {
+        std::vector<uint8_t> file = sampleImage(formats[i], macho::MH_EXECUTE);
+        MachOImage image;
+        ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+        MachOFixups fixups;
+        ZIK_ASSERT_TRUE(fixups.parse(image));
+        ZIK_ASSERT_TRUE(fixups.hasChainedFixups());
+        ZIK_ASSERT_EQUAL(fixups.chainedPointerFormat(), pointerFormats[i]);
+        ZIK_ASSERT_EQUAL(fixups.imports().size(), (size_t)3);
+        ZIK_ASSERT_TRUE(fixups.imports()[2].name == "_OBJC_CLASS_$_ZIKServiceRouter");
+        // 6 entries in class list, 6 class data, 6 names and 5 superclasses
+        ZIK_ASSERT_EQUAL(fixups.fixups().size(), (size_t)23);
+
+        // Class list entries point into __objc_data
+        MachOSection classList;
+        MachOSection classData;
+        ZIK_ASSERT_TRUE(image.findSection("__DATA_CONST", "__objc_classlist", classList));
+        ZIK_ASSERT_TRUE(image.findSection("__DATA", "__objc_data", classData));
+        MachOFixup fixup;
+        ZIK_ASSERT_TRUE(fixups.readPointer(classList.addr, fixup));
+        ZIK_ASSERT_TRUE(fixup.kind == MachOFixup::Rebase);
+        ZIK_ASSERT_EQUAL(fixup.target, classData.addr);
+        ZIK_ASSERT_FALSE(fixups.readPointer(0x7fffffff0000ULL, fixup));
+    }
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testMultipleBinaries) {
+    // Router classes inherit from classes in other frameworks
+    ObjCFixtureBuilder library(ObjCFixtureBuilder::Chained64);
+    size_t router = library.addClass("ZIKRouter", "NSObject");
+    library.addClass("ZIKViewRouter", router);
+    library.addClass("ZIKServiceRouter", router);
+    ObjCFixtureBuilder framework(ObjCFixtureBuilder::Classic);
+    framework.addClass("BaseServiceRouter", "ZIKServiceRouter");
+    framework.addClass("NetworkManager", "NSObject");
+    ObjCFixtureBuilder app(ObjCFixtureBuilder::Chained64Offset, macho::MH_EXECUTE);
+    app.addClass("AppServiceRouter", "BaseServiceRouter");
+    app.addClass("AppManager", "NetworkManager");
+    app.addClass("AppViewRouter", "ZIKViewRouter");
+
+    RouterIndexer indexer;
+    ZIK_ASSERT_TRUE(indexFile(indexer, app.build()));
+    ZIK_ASSERT_TRUE(indexFile(indexer, framework.build()));
+    ZIK_ASSERT_TRUE(indexFile(indexer, library.build()));
+    std::vector<IndexedRouter> routers = indexer.routers();
+    ZIK_ASSERT_TRUE(routerNames(routers, IndexedRouter::View) == std::vector<std::string>{"AppViewRouter"});
+    std::vector<std::string> serviceRouters = {"AppServiceRouter", "BaseServiceRouter"};
+    ZIK_ASSERT_TRUE(routerNames(routers, IndexedRouter::Service) == serviceRouters);
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testFatFile) {
+    ObjCFixtureBuilder arm64(ObjCFixtureBuilder::Chained64);
+    arm64.addClass("ARMViewRouter", "ZIKViewRouter");
+    arm64.addClass("SharedServiceRouter", "ZIKServiceRouter");
+    ObjCFixtureBuilder x86(ObjCFixtureBuilder::Classic, macho::MH_DYLIB, 0x01000007);
+    x86.addClass("IntelViewRouter", "ZIKViewRouter");
+    x86.addClass("SharedServiceRouter", "ZIKServiceRouter");
+    std::vector<uint8_t> fat = MachOFixtureBuilder::fat({std::make_pair(0x0100000c, arm64.build()), std::make_pair(0x01000007, x86.build())});
+
+    RouterIndexer all;
+    ZIK_ASSERT_TRUE(indexFile(all, fat));
+    std::vector<std::string> viewRouters = {"ARMViewRouter", "IntelViewRouter"};
+    ZIK_ASSERT_TRUE(routerNames(all.routers(), IndexedRouter::View) == viewRouters);
+    ZIK_ASSERT_TRUE(routerNames(all.routers(), IndexedRouter::Service) == std::vector<std::string>{"SharedServiceRouter"});
+
+    RouterIndexer x86Only;
+    ZIK_ASSERT_TRUE(indexFile(x86Only, fat, 0x01000007));
+    ZIK_ASSERT_TRUE(routerNames(x86Only.routers(), IndexedRouter::View) == std::vector<std::string>{"IntelViewRouter"});
+
+    RouterIndexer mismatched;
+    std::string error;
+    ZIK_ASSERT_FALSE(mismatched.addFile(fat.data(), fat.size(), 7, RouterIndexer::AnyCPU, error));
+    ZIK_ASSERT_FALSE(error.empty());
+    // Subtype of arm64e doesn't match arm64 slice
+    ZIK_ASSERT_FALSE(mismatched.addFile(fat.data(), fat.size(), 0x0100000c, 2, error));
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testInvalidFiles) {
+    RouterIndexer indexer;
+    std::string error;
+    std::vector<uint8_t> empty(16, 0);
+    ZIK_ASSERT_FALSE(indexer.addFile(empty.data(), empty.size(), RouterIndexer::AnyCPU, RouterIndexer::AnyCPU, error));
+
+    // Class list entry points out of the image
+    ObjCFixtureBuilder builder(ObjCFixtureBuilder::Classic);
+    builder.addClass("AViewRouter", "ZIKViewRouter");
+    std::vector<uint8_t> file = builder.build();
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSection classList;
+    ZIK_ASSERT_TRUE(image.findSection("__DATA_CONST", "__objc_classlist", classList));
+    uint64_t invalidClass = 0x7fff0000;
+    memcpy(&file[classList.offset], &invalidClass, sizeof(invalidClass));
+    ZIK_ASSERT_FALSE(indexFile(indexer, file));
+
+    // Truncated FAT file
+    ObjCFixtureBuilder slice(ObjCFixtureBuilder::Chained64);
+    std::vector<uint8_t> fat = MachOFixtureBuilder::fat({std::make_pair(0x0100000c, slice.build())});
+    fat.resize(fat.size() - 1);
+    ZIK_ASSERT_FALSE(indexFile(indexer, fat));
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testInvalidChainedFixups) {
+    ObjCFixtureBuilder builder(ObjCFixtureBuilder::Chained64);
+    builder.addClass("AViewRouter", "ZIKViewRouter");
+    std::vector<uint8_t> file = builder.build();
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    const macho::linkedit_data_command *command = reinterpret_cast<const macho::linkedit_data_command *>(image.findLoadCommand(macho::LC_DYLD_CHAINED_FIXUPS, sizeof(macho::linkedit_data_command)));
+    ZIK_ASSERT_TRUE(command != NULL);
+    uint32_t dataoff = command->dataoff;
+
+    // Bind ordinal out of imports
+    MachOSection classData;
+    ZIK_ASSERT_TRUE(image.findSection("__DATA", "__objc_data", classData));
+    std::vector<uint8_t> invalidOrdinal = file;
+    uint64_t superclass;
+    memcpy(&superclass, &invalidOrdinal[classData.offset + 8], 8);
+    superclass |= 5;
+    memcpy(&invalidOrdinal[classData.offset + 8], &superclass, 8);
+    MachOImage invalidOrdinalImage;
+    ZIK_ASSERT_TRUE(invalidOrdinalImage.parse(invalidOrdinal.data(), invalidOrdinal.size(), MachOImage::LayoutFile));
+    MachOFixups fixups;
+    ZIK_ASSERT_FALSE(fixups.parse(invalidOrdinalImage));
+
+    // Unknown pointer format
+    std::vector<uint8_t> unknownFormat = file;
+    uint32_t startsOffset;
+    memcpy(&startsOffset, &unknownFormat[dataoff + 4], 4);
+    uint32_t segmentInfoOffset;
+    memcpy(&segmentInfoOffset, &unknownFormat[dataoff + startsOffset + 4 + 4 * 2], 4);
+    uint16_t format = 0x7f;
+    memcpy(&unknownFormat[dataoff + startsOffset + segmentInfoOffset + 6], &format, 2);
+    MachOImage unknownFormatImage;
+    ZIK_ASSERT_TRUE(unknownFormatImage.parse(unknownFormat.data(), unknownFormat.size(), MachOImage::LayoutFile));
+    ZIK_ASSERT_FALSE(fixups.parse(unknownFormatImage));
+
+    // Compressed symbols are not supported
+    std::vector<uint8_t> compressed = file;
+    uint32_t symbolsFormat = 1;
+    memcpy(&compressed[dataoff + 24], &symbolsFormat, 4);
+    MachOImage compressedImage;
+    ZIK_ASSERT_TRUE(compressedImage.parse(compressed.data(), compressed.size(), MachOImage::LayoutFile));
+    ZIK_ASSERT_FALSE(fixups.parse(compressedImage));
+}
+
+ZIK_TEST(ZIKRouterIndexerTests, testGenerateRegistrationSource) {
+    std::vector<IndexedRouter> routers;
+    routers.push_back(IndexedRouter{"AViewRouter", IndexedRouter::View});
+    routers.push_back(IndexedRouter{"_TtC6Module7BRouter", IndexedRouter::View});
+    routers.push_back(IndexedRouter{"CServiceRouter", IndexedRouter::Service});
+    std::string source = RouterIndexer::generateRegistrationSource(routers, "RegisterAppRouters");
+    std::string expected =
+    "//\n"
+    "//  Generated by ZIKRouterIndexer. Do not edit.\n"
+    "//\n\n"
+    "#import <Foundation/Foundation.h>\n"
+    "#import <ZIKRouter/ZIKRouteRegistry.h>\n\n"
+    "/// Register routers found at build time. Set `ZIKRouteRegistry.autoRegister` to NO, and call it before UIApplicationMain.\n"
+    "void RegisterAppRouters(void);\n\n"
+    "static const char *const kZIKIndexedRouterClassNames[] = {\n"
+    "    // View routers\n"
+    "    \"AViewRouter\",\n"
+    "    \"_TtC6Module7BRouter\",\n"
+    "    // Service routers\n"
+    "    \"CServiceRouter\",\n"
+    "    NULL\n"
+    "};\n\n"
+    "void RegisterAppRouters(void) {\n"
+    "    [ZIKRouteRegistry registerRouterClassesWithNames:kZIKIndexedRouterClassNames count:3];\n"
+    "}\n";
+    ZIK_ASSERT_TRUE(source == expected);
+
+    // Empty table is still valid C
+    std::string empty = RouterIndexer::generateRegistrationSource(std::vector<IndexedRouter>(), "RegisterAppRouters");
+    ZIK_ASSERT_TRUE(empty.find("    NULL\n};") != std::string::npos);
+    ZIK_ASSERT_TRUE(empty.find("count:0]") != std::string::npos);
+}
@@ -0,0 +1,320 @@
+//
+//  ZIKStringTableScannerTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKStringTableScanner.h"
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+/// Offsets of all occurrences, found with std::string.
+static std::vector<uint32_t> naiveOffsets(const std::string &bytes, const std::string &pattern) {
+    std::vector<uint32_t> offsets;
+    for (size_t position = bytes.find(pattern); position != std::string::npos; position = bytes.find(pattern, position + 1)) {
+        offsets.push_back(static_cast<uint32_t>(position));
+    }
+    return offsets;
+}
+
+/// A string table and nlists built in memory, where a symbol can point into the middle of another string, like tail merged strings.
+class SyntheticSymbolTable {
+public:
+    explicit SyntheticSymbolTable(bool is64Bit) : is64Bit_(is64Bit), strings_(" ", 2) {}
+
+    /// Add a name to the string table and a symbol for it. Return its string offset.
+    uint32_t addSymbol(const std::string &name, uint8_t type = macho::N_SECT | macho::N_EXT) {
+        uint32_t strx = static_cast<uint32_t>(strings_.size());
+        strings_ += name;
+        strings_.push_back('\0');
+        addSymbolAtOffset(strx, type);
+        return strx;
+    }
+
+    /// Add a symbol pointing to any string offset.
+    void addSymbolAtOffset(uint32_t strx, uint8_t type = macho::N_SECT | macho::N_EXT) {
+        if (is64Bit_) {
+            macho::nlist_64 symbol = {strx, type, 1, 0, 0x1000 + symbols64_.size() * 16};
+            symbols64_.push_back(symbol);
+        } else {
+            macho::nlist symbol = {strx, type, 1, 0, static_cast<uint32_t>(0x1000 + symbols32_.size() * 16)};
+            symbols32_.push_back(symbol);
+        }
+    }
+
+    MachOSymbolTable table() const {
+        MachOSymbolTable table;
+        table.symbols = is64Bit_ ? static_cast<const void *>(symbols64_.data()) : static_cast<const void *>(symbols32_.data());
+        table.count = static_cast<uint32_t>(is64Bit_ ? symbols64_.size() : symbols32_.size());
+        table.is64Bit = is64Bit_;
+        table.strings = strings_.data();
+        table.stringsSize = static_cast<uint32_t>(strings_.size());
+        return table;
+    }
+
+private:
+    bool is64Bit_;
+    std::string strings_;
+    std::vector<macho::nlist_64> symbols64_;
+    std::vector<macho::nlist> symbols32_;
+};
+
+/// Fetch each nlist and compare its name.
+static std::vector<uint32_t> scalarSymbols(const MachOSymbolTable &table, const SymbolNameMatcher &matcher) {
+    std::vector<uint32_t> indexes;
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        if (matcher.matches(name)) {
+            indexes.push_back(i);
+        }
+    }
+    return indexes;
+}
+
+/// Swift symbols of several modules, with router symbols among them.
+static SyntheticSymbolTable syntheticTable(size_t count) {
+    SyntheticSymbolTable symbols(true);
+    for (size_t i = 0; i < count; i++) {
+        std::string module = "Module" + std::to_string(i % 16);
+        std::string number = std::to_string(i);
+        if (i % 97 == 0) {
+            symbols.addSymbol("_$s" + std::to_string(module.size()) + module + "15RoutableServiceV" + number);
+        } else if (i % 5 == 0) {
+            symbols.addSymbol("_OBJC_CLASS_$_Class" + number);
+        } else if (i % 7 == 0) {
+            symbols.addSymbol("_$S" + std::to_string(module.size()) + module + "4TypeC" + number + "fMa");
+        } else {
+            symbols.addSymbol("_$s" + std::to_string(module.size()) + module + "4TypeC" + number + "SSvg");
+        }
+    }
+    return symbols;
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testFindPatternOffsets) {
+    std::string bytes("_$s7ZRouter\0_$s7ZRouter4TypeC\0_T0\0__$s\0_$", 41);
+    std::vector<uint32_t> offsets;
+    findPatternOffsets(bytes.data(), bytes.size(), "_$s", 3, offsets);
+    ZIK_ASSERT_TRUE(offsets == std::vector<uint32_t>({0, 12, 35}));
+    offsets.clear();
+    findPatternOffsets(bytes.data(), bytes.size(), "_", 1, offsets);
+    ZIK_ASSERT_TRUE(offsets == std::vector<uint32_t>({0, 12, 30, 34, 35, 39}));
+    offsets.clear();
+    // Occurrences can overlap
+    findPatternOffsets("aaaaa", 5, "aaa", 3, offsets);
+    ZIK_ASSERT_TRUE(offsets == std::vector<uint32_t>({0, 1, 2}));
+    offsets.clear();
+    findPatternOffsets("abc", 3, "abcd", 4, offsets);
+    findPatternOffsets("abc", 3, "", 0, offsets);
+    findPatternOffsets(nullptr, 3, "a", 1, offsets);
+    ZIK_ASSERT_TRUE(offsets.empty());
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testVectorizedMatchesScalar) {
+    fprintf(stderr, "String scan vectorized: %d\n", stringScanVectorized());
+    std::mt19937 random(7);
+    const char alphabet[] = {'_', '$', 's', 'S', 'T', '0', 'a', '\0'};
+    for (size_t round = 0; round < 3000; round++) {
+        std::string bytes(random() % 100, '\0');
+        for (char &c : bytes) {
+            c = alphabet[random() % sizeof(alphabet)];
+        }
+        std::string pattern(1 + random() % 20, '\0');
+        for (char &c : pattern) {
+            c = alphabet[random() % (sizeof(alphabet) - 1)];
+        }
+        if (random() % 2 == 0 && bytes.size() >= pattern.size()) {
+            // Put the pattern at the end, where blocks can't be loaded
+            bytes.replace(bytes.size() - pattern.size(), pattern.size(), pattern);
+        }
+        std::vector<uint32_t> expected = naiveOffsets(bytes, pattern);
+        std::vector<uint32_t> vectorized;
+        std::vector<uint32_t> scalar;
+        findPatternOffsets(bytes.data(), bytes.size(), pattern.data(), pattern.size(), vectorized, true);
+        findPatternOffsets(bytes.data(), bytes.size(), pattern.data(), pattern.size(), scalar, false);
+        ZIK_ASSERT_TRUE(vectorized == expected);
+        ZIK_ASSERT_TRUE(scalar == expected);
+    }
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testPrefix) {
+    for (bool is64Bit : {true, false}) {
+        SyntheticSymbolTable symbols(is64Bit);
+        uint32_t swift = symbols.addSymbol("_$s7ZRouter15RoutableServiceV");
+        symbols.addSymbol("_T07ZRouter12RoutableViewV");
+        symbols.addSymbol("_objc_msgSend");
+        symbols.addSymbol("_$S7ZRouter4TypeC");
+        // Tail merged strings
+        symbols.addSymbolAtOffset(swift + 1);
+        symbols.addSymbolAtOffset(swift + 13);
+        symbols.addSymbol("__$s7ZRouter");
+        symbols.addSymbol("_$s", macho::N_STAB);
+        symbols.addSymbol("");
+        symbols.addSymbolAtOffset(0xffffff);
+        MachOSymbolTable table = symbols.table();
+
+        SymbolNameMatcher matcher({"_$s", "_$S", "_T0"}, ZIKSymbolNameMatchPrefix);
+        for (bool vectorized : {true, false}) {
+            std::vector<uint32_t> indexes;
+            matcher.findSymbols(table, indexes, vectorized);
+            ZIK_ASSERT_TRUE(indexes == std::vector<uint32_t>({0, 1, 3, 7}));
+            ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, matcher));
+        }
+        SymbolNameMatcher module({"_$s7ZRouter", "Routable"}, ZIKSymbolNameMatchPrefix);
+        std::vector<uint32_t> indexes;
+        module.findSymbols(table, indexes);
+        ZIK_ASSERT_TRUE(indexes == std::vector<uint32_t>({0, 5}));
+        ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, module));
+        SymbolNameMatcher missing({"_$s8ZIKRouter"}, ZIKSymbolNameMatchPrefix);
+        indexes.clear();
+        missing.findSymbols(table, indexes);
+        ZIK_ASSERT_TRUE(indexes.empty());
+    }
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testSubstring) {
+    for (bool is64Bit : {true, false}) {
+        SyntheticSymbolTable symbols(is64Bit);
+        uint32_t service = symbols.addSymbol("_$s7ZRouter15RoutableServiceV");
+        symbols.addSymbol("_T07ZRouter12RoutableViewV");
+        symbols.addSymbol("_RoutableServiceRoutableService");
+        symbols.addSymbolAtOffset(service + 3);
+        symbols.addSymbolAtOffset(service + 13);
+        // After the start of the occurrence, not matched
+        symbols.addSymbolAtOffset(service + 14);
+        symbols.addSymbol("_objc_msgSend");
+        MachOSymbolTable table = symbols.table();
+
+        SymbolNameMatcher matcher({"RoutableService"}, ZIKSymbolNameMatchSubstring);
+        for (bool vectorized : {true, false}) {
+            std::vector<uint32_t> indexes;
+            matcher.findSymbols(table, indexes, vectorized);
+            ZIK_ASSERT_TRUE(indexes == std::vector<uint32_t>({0, 2, 3, 4}));
+            ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, matcher));
+        }
+        SymbolNameMatcher both({"RoutableView", "msgSend", "RoutableView"}, ZIKSymbolNameMatchSubstring);
+        std::vector<uint32_t> indexes;
+        both.findSymbols(table, indexes);
+        ZIK_ASSERT_TRUE(indexes == std::vector<uint32_t>({1, 6}));
+        ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, both));
+    }
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testEmptyPattern) {
+    SyntheticSymbolTable symbols(true);
+    symbols.addSymbol("_a");
+    symbols.addSymbol("");
+    symbols.addSymbolAtOffset(0xffffff);
+    symbols.addSymbol("_b");
+    MachOSymbolTable table = symbols.table();
+    for (ZIKSymbolNameMatch match : {ZIKSymbolNameMatchPrefix, ZIKSymbolNameMatchSubstring}) {
+        SymbolNameMatcher matcher({"_x", ""}, match);
+        std::vector<uint32_t> indexes;
+        matcher.findSymbols(table, indexes);
+        // Names out of the string table never match
+        ZIK_ASSERT_TRUE(indexes == std::vector<uint32_t>({0, 1, 3}));
+        ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, matcher));
+        ZIK_ASSERT_FALSE(matcher.matches(nullptr));
+    }
+    SymbolNameMatcher none({}, ZIKSymbolNameMatchPrefix);
+    std::vector<uint32_t> indexes;
+    none.findSymbols(table, indexes);
+    ZIK_ASSERT_TRUE(indexes.empty());
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testRandomTables) {
+    std::mt19937 random(11);
+    const char *pieces[] = {"_$s", "_$S", "_T0", "7ZRouter", "Routable", "Service", "View", "_", "$", "s"};
+    for (size_t round = 0; round < 200; round++) {
+        SyntheticSymbolTable symbols(round % 2 == 0);
+        std::vector<uint32_t> offsets;
+        size_t count = random() % 60;
+        for (size_t i = 0; i < count; i++) {
+            if (!offsets.empty() && random() % 4 == 0) {
+                symbols.addSymbolAtOffset(offsets[random() % offsets.size()] + random() % 4);
+                continue;
+            }
+            std::string name;
+            for (size_t piece = random() % 5; piece > 0; piece--) {
+                name += pieces[random() % 10];
+            }
+            offsets.push_back(symbols.addSymbol(name));
+        }
+        MachOSymbolTable table = symbols.table();
+        std::vector<std::string> patterns;
+        for (size_t i = 1 + random() % 3; i > 0; i--) {
+            patterns.push_back(std::string(pieces[random() % 10]) + (random() % 2 ? pieces[random() % 10] : ""));
+        }
+        for (ZIKSymbolNameMatch match : {ZIKSymbolNameMatchPrefix, ZIKSymbolNameMatchSubstring}) {
+            SymbolNameMatcher matcher(patterns, match);
+            std::vector<uint32_t> expected = scalarSymbols(table, matcher);
+            std::vector<uint32_t> vectorized;
+            std::vector<uint32_t> scalar;
+            matcher.findSymbols(table, vectorized, true);
+            matcher.findSymbols(table, scalar, false);
+            ZIK_ASSERT_TRUE(vectorized == expected);
+            ZIK_ASSERT_TRUE(scalar == expected);
+        }
+    }
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testSyntheticTable) {
+    SyntheticSymbolTable symbols = syntheticTable(20000);
+    MachOSymbolTable table = symbols.table();
+    SymbolNameMatcher swift({"_$s", "_$S", "_T0"}, ZIKSymbolNameMatchPrefix);
+    std::vector<uint32_t> indexes;
+    swift.findSymbols(table, indexes);
+    ZIK_ASSERT_EQUAL(indexes.size(), 20000 - 20000 / 5 + 20000 / (5 * 97) + 1);
+    ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, swift));
+    SymbolNameMatcher router({"RoutableService"}, ZIKSymbolNameMatchSubstring);
+    indexes.clear();
+    router.findSymbols(table, indexes);
+    ZIK_ASSERT_EQUAL(indexes.size(), 20000 / 97 + 1);
+    ZIK_ASSERT_TRUE(indexes == scalarSymbols(table, router));
+}
+
+// MARK: Performance
+
+static const size_t kBenchmarkSymbolCount = 500000;
+
+static void measureMatcher(const SymbolNameMatcher &matcher, bool scanning, bool vectorized, size_t expectedCount) {
+    SyntheticSymbolTable symbols = syntheticTable(kBenchmarkSymbolCount);
+    MachOSymbolTable table = symbols.table();
+    measure([&] {
+        std::vector<uint32_t> indexes;
+        if (scanning) {
+            matcher.findSymbols(table, indexes, vectorized);
+        } else {
+            indexes = scalarSymbols(table, matcher);
+        }
+        ZIK_ASSERT_EQUAL(indexes.size(), expectedCount);
+    });
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testPerformancePrefixCompareEachName) {
+    measureMatcher(SymbolNameMatcher({"_$s7Module3", "_$S7Module3"}, ZIKSymbolNameMatchPrefix), false, false, 25064);
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testPerformancePrefixCompareStart) {
+    measureMatcher(SymbolNameMatcher({"_$s7Module3", "_$S7Module3"}, ZIKSymbolNameMatchPrefix), true, true, 25064);
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testPerformanceSubstringCompareEachName) {
+    measureMatcher(SymbolNameMatcher({"RoutableService"}, ZIKSymbolNameMatchSubstring), false, false, kBenchmarkSymbolCount / 97 + 1);
+}
+
+ZIK_TEST(ZIKStringTableScannerTests, testPerformanceSubstringVectorizedScan) {
+    measureMatcher(SymbolNameMatcher({"RoutableService"}, ZIKSymbolNameMatchSubstring), true, true, kBenchmarkSymbolCount / 97 + 1);
+}
@@ -0,0 +1,129 @@
+//
+//  ZIKSymbolBenchmarkTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKSymbolBenchmark.h"
+#include "ZIKMachOFile.h"
+#include "ZIKSymbolIndex.h"
+#include "ZIKExportTrie.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::macho;
+using namespace zix::test;
+
+ZIK_TEST(ZIKSymbolBenchmarkTests, testSymbolsAreOrderedLikeLinkedImage) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = SymbolBenchmark::makeSymbols(2000, 2018);
+    ZIK_ASSERT_EQUAL(symbols.size(), 2000);
+
+    // Locals, then exported and undefined symbols sorted by name
+    int group = 0;
+    std::string previous;
+    std::set<std::string> names;
+    size_t swift = 0;
+    uint64_t address = 0;
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        int symbolGroup = (symbol.type & N_TYPE) == N_UNDF ? 2 : ((symbol.type & N_EXT) != 0 ? 1 : 0);
+        ZIK_ASSERT_GREATER_THAN_OR_EQUAL(symbolGroup, group);
+        if (symbolGroup != group) {
+            group = symbolGroup;
+            previous.clear();
+        }
+        if (group > 0) {
+            ZIK_ASSERT_TRUE(previous < symbol.name);
+        }
+        previous = symbol.name;
+        ZIK_ASSERT_TRUE(names.insert(symbol.name).second);
+        if (symbol.name.compare(0, 3, "_$s") == 0 || symbol.name.compare(0, 3, "_$S") == 0 || symbol.name.compare(0, 3, "_T0") == 0) {
+            swift++;
+        }
+        if (group == 0) {
+            ZIK_ASSERT_GREATER_THAN(symbol.value, address);
+            address = symbol.value;
+        }
+    }
+    ZIK_ASSERT_EQUAL(group, 2);
+    // Mostly Swift, like an app with Swift modules
+    ZIK_ASSERT_GREATER_THAN(swift, symbols.size() / 2);
+    ZIK_ASSERT_LESS_THAN(swift, symbols.size());
+
+    // The same seed generates the same symbols
+    std::vector<MachOFixtureBuilder::Symbol> again = SymbolBenchmark::makeSymbols(2000, 2018);
+    ZIK_ASSERT_EQUAL(again.size(), symbols.size());
+    for (size_t i = 0; i < symbols.size() && i < again.size(); i++) {
+        ZIK_ASSERT_TRUE(again[i].name == symbols[i].name);
+        ZIK_ASSERT_EQUAL(again[i].value, symbols[i].value);
+    }
+}
+
+ZIK_TEST(ZIKSymbolBenchmarkTests, testImageIsReadable) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = SymbolBenchmark::makeSymbols(1000, 7);
+    std::vector<uint8_t> bytes = SymbolBenchmark::makeImage(symbols);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(bytes.data(), bytes.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    ZIK_ASSERT_EQUAL(table.count, symbols.size());
+
+    ExportTrie trie;
+    ZIK_ASSERT_TRUE(trie.parse(image));
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        MachONameListItem item = {};
+        item.name = symbol.name.c_str();
+        ZIK_ASSERT_EQUAL(machONameList(table, 0, &item, 1), 0);
+        ZIK_ASSERT_EQUAL(item.value, symbol.value);
+
+        MachOExport found;
+        bool exported = (symbol.type & N_TYPE) != N_UNDF && (symbol.type & N_EXT) != 0;
+        ZIK_ASSERT_EQUAL(trie.find(symbol.name.c_str(), found), exported);
+        if (exported) {
+            ZIK_ASSERT_EQUAL(found.address, symbol.value);
+        }
+    }
+}
+
+ZIK_TEST(ZIKSymbolBenchmarkTests, testRun) {
+    SymbolBenchmark benchmark;
+    benchmark.setIterations(1);
+    SymbolBenchmarkResult result;
+    std::string error;
+    ZIK_ASSERT_TRUE(benchmark.run(3000, result, error));
+    ZIK_ASSERT_TRUE(error.empty());
+    ZIK_ASSERT_EQUAL(result.symbols, 3000);
+    ZIK_ASSERT_EQUAL(result.enumeratedNames, 3000);
+    ZIK_ASSERT_GREATER_THAN(result.prefixNames, 0);
+    ZIK_ASSERT_LESS_THAN(result.prefixNames, result.enumeratedNames);
+    ZIK_ASSERT_GREATER_THAN(result.substringNames, 0);
+    ZIK_ASSERT_EQUAL(result.swiftNames + result.skippedDemangles, result.enumeratedNames);
+    ZIK_ASSERT_GREATER_THAN(result.skippedDemangles, 0);
+    ZIK_ASSERT_GREATER_THAN(result.validatorCandidates, 0);
+    ZIK_ASSERT_GREATER_THAN(result.skippedValidatorDemangles, 0);
+    ZIK_ASSERT_EQUAL(result.validatorCandidates + result.skippedValidatorDemangles, result.substringNames);
+    ZIK_ASSERT_GREATER_THAN(result.exportedSymbols, 0);
+    ZIK_ASSERT_GREATER_THAN(result.undefinedSymbols, 0);
+    ZIK_ASSERT_GREATER_THAN(result.stringTableBytes, 0);
+    ZIK_ASSERT_LESS_THAN(result.stringTableBytes, result.fileBytes);
+
+    std::string json = benchmark.json({result});
+    const char *keys[] = {"\"benchmark\": \"ZIKSymbolBenchmark\"", "\"iterations\": 1", "\"results\"", "\"symbols\": 3000", "\"nlistLookupUs\"", "\"trieLookupNs\"", "\"indexLookupNs\"", "\"batchFindSymbolsMs\"", "\"enumerateMs\"", "\"skippedDemangles\"", "\"validatorCandidates\"", "\"reverseLookupUs\""};
+    for (const char *key : keys) {
+        ZIK_ASSERT_TRUE(json.find(key) != std::string::npos);
+    }
+}
+
+ZIK_TEST(ZIKSymbolBenchmarkTests, testRunFailsInMissingDirectory) {
+    SymbolBenchmark benchmark;
+    benchmark.setIterations(1);
+    benchmark.setDirectory("/ZIKSymbolBenchmark/missing");
+    SymbolBenchmarkResult result;
+    std::string error;
+    ZIK_ASSERT_FALSE(benchmark.run(100, result, error));
+    ZIK_ASSERT_FALSE(error.empty());
+}
@@ -0,0 +1,383 @@
+//
+//  ZIKSymbolEnumeratorTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKSymbolEnumerator.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t N_SECT_EXT = macho::N_SECT | macho::N_EXT;
+
+/// A dylib with symbols in __TEXT. Its vm addresses start from 0, so it's also a loaded image at its own address.
+static std::vector<uint8_t> symbolImage(const std::vector<MachOFixtureBuilder::Symbol> &symbols) {
+    MachOFixtureBuilder builder(sizeof(void *) == 8);
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, symbol.value, symbol.desc);
+    }
+    return builder.build();
+}
+
+/// Swift symbols of an image, with some router symbols among them.
+static std::vector<MachOFixtureBuilder::Symbol> syntheticSymbols(size_t image, size_t count) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    symbols.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string module = "Module" + std::to_string(image);
+        std::string name = i % 64 == 0 ? "_$s" + std::to_string(module.size()) + module + "15RoutableServiceV" + std::to_string(i) : "_$s" + std::to_string(module.size()) + module + "4TypeC" + std::to_string(i) + "SSvg";
+        MachOFixtureBuilder::Symbol symbol = {name, N_SECT_EXT, 1, 0, 0x4000 + i * 16};
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
+static void reverseApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    for (size_t i = iterations; i > 0; i--) {
+        work(context, i - 1);
+    }
+}
+
+static void threadApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    size_t threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) {
+        threadCount = 2;
+    }
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++) {
+        threads.push_back(std::thread([=]() {
+            for (size_t i = t; i < iterations; i += threadCount) {
+                work(context, i);
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+/// Like dispatch_apply, the calling thread runs workers too.
+static void callerApply(size_t iterations, void *context, void (*work)(void *context, size_t index)) {
+    std::thread thread([=]() {
+        for (size_t i = 1; i < iterations; i += 2) {
+            work(context, i);
+        }
+    });
+    for (size_t i = 0; i < iterations; i += 2) {
+        work(context, i);
+    }
+    thread.join();
+}
+
+/// Simulate demangling in workers, which costs much more than reading the symbol table.
+static bool expensiveFilter(const char *name) {
+    if (strstr(name, "RoutableService") == nullptr) {
+        return false;
+    }
+    std::string demangled;
+    for (int round = 0; round < 64; round++) {
+        demangled.assign(name);
+        for (char &c : demangled) {
+            c = static_cast<char>(c ^ round);
+        }
+    }
+    return !demangled.empty();
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testDeliverInOrder) {
+    std::vector<std::vector<uint8_t>> files;
+    for (size_t i = 0; i < 9; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 1000 + i * 300)));
+    }
+    files.push_back(symbolImage({
+        {"_main", N_SECT_EXT, 1, 0, 0x1000},
+        {"_debug.o", macho::N_STAB, 0, 0, 0x1010},
+        {"", N_SECT_EXT, 1, 0, 0x1020},
+        {"_last", macho::N_SECT, 1, 0, 0x1030},
+    }));
+    SymbolNameEnumerator enumerator;
+    for (const std::vector<uint8_t> &file : files) {
+        MachOImage image;
+        MachOSymbolTable table;
+        ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+        ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+        enumerator.addSymbolTable(table);
+    }
+    ZIK_ASSERT_EQUAL(enumerator.imageCount(), files.size());
+
+    std::vector<std::pair<size_t, std::string>> expected;
+    ZIK_ASSERT_TRUE(enumerator.enumerate(nullptr, SymbolNameEnumerator::Filter(), [&](size_t imageIndex, const char *name) {
+        expected.push_back(std::make_pair(imageIndex, std::string(name)));
+        return true;
+    }));
+    ZIK_ASSERT_EQUAL(expected.size(), 9 * 1000 + 300 * 36 + 2);
+    ZIK_ASSERT_EQUAL(expected.back().first, 9);
+    ZIK_ASSERT_EQUAL(expected.back().second, "_last");
+    ZIK_ASSERT_EQUAL(expected[expected.size() - 2].second, "_main");
+
+    ZIKApplyFunction applies[] = {reverseApply, threadApply, callerApply};
+    std::thread::id caller = std::this_thread::get_id();
+    for (ZIKApplyFunction apply : applies) {
+        std::vector<std::pair<size_t, std::string>> names;
+        bool otherThread = false;
+        ZIK_ASSERT_TRUE(enumerator.enumerate(apply, SymbolNameEnumerator::Filter(), [&](size_t imageIndex, const char *name) {
+            // Handler is only called on the calling thread
+            if (std::this_thread::get_id() != caller) {
+                otherThread = true;
+            }
+            names.push_back(std::make_pair(imageIndex, std::string(name)));
+            return true;
+        }));
+        ZIK_ASSERT_FALSE(otherThread);
+        ZIK_ASSERT_TRUE(names == expected);
+    }
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testFilterInWorkers) {
+    std::vector<std::vector<uint8_t>> files;
+    SymbolNameEnumerator enumerator;
+    for (size_t i = 0; i < 6; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 2000)));
+        MachOImage image;
+        MachOSymbolTable table;
+        ZIK_ASSERT_TRUE(image.parse(files.back().data(), files.back().size(), MachOImage::LayoutFile));
+        ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+        enumerator.addSymbolTable(table);
+    }
+    std::mutex mutex;
+    bool mismatchedImage = false;
+    std::vector<std::string> names;
+    ZIK_ASSERT_TRUE(enumerator.enumerate(threadApply, [&](size_t imageIndex, const char *name) {
+        std::string module = "Module" + std::to_string(imageIndex);
+        if (strstr(name, module.c_str()) == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            mismatchedImage = true;
+        }
+        return strstr(name, "RoutableService") != nullptr;
+    }, [&](size_t, const char *name) {
+        names.push_back(name);
+        return true;
+    }));
+    ZIK_ASSERT_FALSE(mismatchedImage);
+    ZIK_ASSERT_EQUAL(names.size(), 6 * 32);
+    ZIK_ASSERT_EQUAL(names.front(), "_$s7Module015RoutableServiceV0");
+    ZIK_ASSERT_EQUAL(names.back(), "_$s7Module515RoutableServiceV1984");
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testStopEarly) {
+    std::vector<std::vector<uint8_t>> files;
+    SymbolNameEnumerator enumerator;
+    for (size_t i = 0; i < 32; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 20000)));
+        MachOImage image;
+        MachOSymbolTable table;
+        ZIK_ASSERT_TRUE(image.parse(files.back().data(), files.back().size(), MachOImage::LayoutFile));
+        ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+        enumerator.addSymbolTable(table);
+    }
+    ZIKApplyFunction applies[] = {nullptr, reverseApply, threadApply, callerApply};
+    for (ZIKApplyFunction apply : applies) {
+        std::atomic<size_t> filtered(0);
+        size_t handled = 0;
+        std::string lastName;
+        ZIK_ASSERT_FALSE(enumerator.enumerate(apply, [&](size_t, const char *) {
+            filtered++;
+            return true;
+        }, [&](size_t imageIndex, const char *name) {
+            handled++;
+            lastName = name;
+            return !(imageIndex == 1 && strcmp(name, "_$s7Module14TypeC10SSvg") == 0);
+        }));
+        ZIK_ASSERT_EQUAL(handled, 20000 + 11);
+        ZIK_ASSERT_EQUAL(lastName, "_$s7Module14TypeC10SSvg");
+        if (apply == nullptr) {
+            // Later images are never scanned
+            ZIK_ASSERT_EQUAL(filtered.load(), 2 * 20000);
+        } else {
+            ZIK_ASSERT_LESS_THAN_OR_EQUAL(filtered.load(), 32 * 20000);
+        }
+    }
+    // Enumerate again after stopping
+    size_t count = 0;
+    ZIK_ASSERT_TRUE(enumerator.enumerate(threadApply, SymbolNameEnumerator::Filter(), [&](size_t, const char *) {
+        count++;
+        return true;
+    }));
+    ZIK_ASSERT_EQUAL(count, 32 * 20000);
+}
+
+static bool filterRouterSymbol(void *, size_t, const char *name) {
+    return strstr(name, "RoutableService") != nullptr;
+}
+
+static bool recordSymbol(void *context, size_t imageIndex, const char *name) {
+    std::vector<std::pair<size_t, std::string>> *names = static_cast<std::vector<std::pair<size_t, std::string>> *>(context);
+    names->push_back(std::make_pair(imageIndex, std::string(name)));
+    return true;
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testLoadedImages) {
+    std::vector<std::vector<uint8_t>> files;
+    for (size_t i = 0; i < 4; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 256)));
+    }
+    // Not a mach-o, it's skipped but its index is kept for later images
+    std::vector<uint8_t> garbage(256, 0);
+    const void *headers[] = {files[0].data(), garbage.data(), files[1].data(), files[2].data(), files[3].data()};
+
+    std::vector<std::pair<size_t, std::string>> names;
+    ZIK_ASSERT_TRUE(ZIKEnumerateSymbolNamesInLoadedImages(headers, 5, threadApply, &names, filterRouterSymbol, recordSymbol));
+    ZIK_ASSERT_EQUAL(names.size(), 16);
+    ZIK_ASSERT_EQUAL(names[0].first, 0);
+    ZIK_ASSERT_EQUAL(names[4].first, 2);
+    ZIK_ASSERT_EQUAL(names[4].second, "_$s7Module115RoutableServiceV0");
+    ZIK_ASSERT_EQUAL(names[15].first, 4);
+    ZIK_ASSERT_EQUAL(names[15].second, "_$s7Module315RoutableServiceV192");
+
+    names.clear();
+    ZIK_ASSERT_TRUE(ZIKEnumerateSymbolNamesInLoadedImages(headers, 5, NULL, &names, NULL, recordSymbol));
+    ZIK_ASSERT_EQUAL(names.size(), 4 * 256);
+    ZIK_ASSERT_EQUAL(names[256].first, 2);
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testMatchedNames) {
+    std::vector<std::vector<uint8_t>> files;
+    SymbolNameEnumerator enumerator;
+    for (size_t i = 0; i < 6; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 2000)));
+        MachOImage image;
+        MachOSymbolTable table;
+        ZIK_ASSERT_TRUE(image.parse(files.back().data(), files.back().size(), MachOImage::LayoutFile));
+        ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+        enumerator.addSymbolTable(table);
+    }
+    std::vector<std::string> expected;
+    ZIK_ASSERT_TRUE(enumerator.enumerate(nullptr, [](size_t, const char *name) {
+        return strstr(name, "RoutableService") != nullptr || strncmp(name, "_$s7Module2", 11) == 0;
+    }, [&](size_t, const char *name) {
+        expected.push_back(name);
+        return true;
+    }));
+    ZIK_ASSERT_EQUAL(expected.size(), 5 * 32 + 2000);
+
+    SymbolNameMatcher substring({"RoutableService"}, ZIKSymbolNameMatchSubstring);
+    SymbolNameMatcher prefix({"_$s7Module2"}, ZIKSymbolNameMatchPrefix);
+    std::vector<std::string> names;
+    for (ZIKApplyFunction apply : {(ZIKApplyFunction)nullptr, threadApply}) {
+        names.clear();
+        ZIK_ASSERT_TRUE(enumerator.enumerate(apply, &substring, [](size_t, const char *) {
+            return true;
+        }, [&](size_t, const char *name) {
+            names.push_back(name);
+            return true;
+        }));
+        ZIK_ASSERT_EQUAL(names.size(), 6 * 32);
+        ZIK_ASSERT_EQUAL(names.front(), "_$s7Module015RoutableServiceV0");
+    }
+    // Filter still works with the matcher
+    names.clear();
+    ZIK_ASSERT_TRUE(enumerator.enumerate(threadApply, &prefix, [](size_t, const char *name) {
+        return strstr(name, "RoutableService") == nullptr;
+    }, [&](size_t, const char *name) {
+        names.push_back(name);
+        return true;
+    }));
+    ZIK_ASSERT_EQUAL(names.size(), 2000 - 32);
+    ZIK_ASSERT_EQUAL(names.front(), "_$s7Module24TypeC1SSvg");
+
+    // Both patterns with the C function
+    const void *headers[6];
+    for (size_t i = 0; i < 6; i++) {
+        headers[i] = files[i].data();
+    }
+    std::vector<std::pair<size_t, std::string>> matched;
+    const char *patterns[] = {"RoutableService", "Module2"};
+    ZIK_ASSERT_TRUE(ZIKEnumerateMatchedSymbolNamesInLoadedImages(headers, 6, threadApply, patterns, 2, ZIKSymbolNameMatchSubstring, &matched, NULL, recordSymbol));
+    ZIK_ASSERT_EQUAL(matched.size(), expected.size());
+    for (size_t i = 0; i < matched.size() && i < expected.size(); i++) {
+        ZIK_ASSERT_EQUAL(matched[i].second, expected[i]);
+    }
+    matched.clear();
+    const char *prefixes[] = {"_$s7Module3", "_$s7Module215RoutableService"};
+    ZIK_ASSERT_TRUE(ZIKEnumerateMatchedSymbolNamesInLoadedImages(headers, 6, NULL, prefixes, 2, ZIKSymbolNameMatchPrefix, &matched, filterRouterSymbol, recordSymbol));
+    ZIK_ASSERT_EQUAL(matched.size(), 64);
+    ZIK_ASSERT_EQUAL(matched[0].first, 2);
+    ZIK_ASSERT_EQUAL(matched[32].first, 3);
+}
+
+// MARK: Performance
+
+static std::vector<std::vector<uint8_t>> benchmarkImages() {
+    std::vector<std::vector<uint8_t>> files;
+    for (size_t i = 0; i < 24; i++) {
+        files.push_back(symbolImage(syntheticSymbols(i, 40000)));
+    }
+    return files;
+}
+
+static void addImages(SymbolNameEnumerator &enumerator, const std::vector<std::vector<uint8_t>> &files) {
+    for (const std::vector<uint8_t> &file : files) {
+        MachOImage image;
+        MachOSymbolTable table;
+        image.parse(file.data(), file.size(), MachOImage::LayoutFile);
+        readSymbolTable(image, table);
+        enumerator.addSymbolTable(table);
+    }
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testSerialAndParallelScanning) {
+    std::vector<std::vector<uint8_t>> files = benchmarkImages();
+    SymbolNameEnumerator enumerator;
+    addImages(enumerator, files);
+    SymbolNameEnumerator::Filter filter = [](size_t, const char *name) {
+        return expensiveFilter(name);
+    };
+    double durations[2];
+    size_t counts[2];
+    ZIKApplyFunction applies[] = {nullptr, threadApply};
+    for (size_t i = 0; i < 2; i++) {
+        size_t count = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        enumerator.enumerate(applies[i], filter, [&](size_t, const char *) {
+            count++;
+            return true;
+        });
+        durations[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        counts[i] = count;
+    }
+    ZIK_ASSERT_EQUAL(counts[0], counts[1]);
+    fprintf(stderr, "Scan %zu images: serial %.2f ms, parallel %.2f ms\n", files.size(), durations[0], durations[1]);
+}
+
+ZIK_TEST(ZIKSymbolEnumeratorTests, testPerformanceParallelScanning) {
+    std::vector<std::vector<uint8_t>> files = benchmarkImages();
+    SymbolNameEnumerator enumerator;
+    addImages(enumerator, files);
+    measure([&] {
+        size_t count = 0;
+        enumerator.enumerate(threadApply, [](size_t, const char *name) {
+            return expensiveFilter(name);
+        }, [&](size_t, const char *) {
+            count++;
+            return true;
+        });
+        ZIK_ASSERT_EQUAL(count, 24 * 40000 / 64);
+    });
+}
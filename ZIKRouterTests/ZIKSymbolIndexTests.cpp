@@ -0,0 +1,375 @@
+//
+//  ZIKSymbolIndexTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKSymbolIndex.h"
+#include "ZIKMachOImage.h"
+#include "ZIKMachOFixtureBuilder.h"
+#include <string.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace zix;
+using namespace zix::test;
+
+static const uint8_t N_SECT_EXT = macho::N_SECT | macho::N_EXT;
+
+/// A dylib with symbols in __TEXT. It can also be used as a loaded image at its own address, because its vm addresses start from 0.
+static std::vector<uint8_t> symbolImage(bool is64Bit, const std::vector<MachOFixtureBuilder::Symbol> &symbols) {
+    MachOFixtureBuilder builder(is64Bit);
+    builder.reserveSection("__TEXT", "__text", 0x100);
+    builder.layout();
+    for (const MachOFixtureBuilder::Symbol &symbol : symbols) {
+        builder.addSymbol(symbol.name, symbol.type, symbol.sect, symbol.value, symbol.desc);
+    }
+    return builder.build();
+}
+
+static std::vector<MachOFixtureBuilder::Symbol> syntheticSymbols(size_t count) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols;
+    symbols.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        MachOFixtureBuilder::Symbol symbol = {"_$s12SyntheticApp6Module" + std::to_string(i) + "C4nameSSvg", N_SECT_EXT, 1, 0, 0x4000 + i * 16};
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
+/// Scan every nlist for each name, like ZIKFindSymbol without index.
+static uint64_t linearFind(const MachOSymbolTable &table, const char *target) {
+    for (uint32_t i = 0; i < table.count; i++) {
+        const char *name;
+        uint8_t type, sect;
+        uint16_t desc;
+        uint64_t value;
+        table.symbolAtIndex(i, name, type, sect, desc, value);
+        if (name == nullptr || name == table.strings || (type & macho::N_STAB) != 0) {
+            continue;
+        }
+        if (strcmp(name, target) == 0) {
+            return value;
+        }
+    }
+    return 0;
+}
+
+static void checkIndexWith64Bit(bool is64Bit) {
+    std::vector<uint8_t> file = symbolImage(is64Bit, {
+        {"_main", N_SECT_EXT, 1, 0, 0x1000},
+        {"_static_function", macho::N_SECT, 1, 0, 0x1010},
+        {"_thumb", N_SECT_EXT, 1, 0x0008, 0x1020},
+        {"_debug.o", macho::N_STAB, 0, 0, 0x1030},
+        {"_undefined", macho::N_UNDF | macho::N_EXT, 0, 0x0100, 0},
+        {"_duplicate", macho::N_SECT, 1, 0, 0x1040},
+        {"_duplicate", N_SECT_EXT, 1, 0, 0x1050},
+    });
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    SymbolIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), 5);
+    ZIK_ASSERT_EQUAL(index.slide(), 0);
+
+    const SymbolIndex::Entry *entry = index.find("_main");
+    ZIK_ASSERT_TRUE(entry != nullptr);
+    ZIK_ASSERT_EQUAL(entry->value, 0x1000);
+    ZIK_ASSERT_EQUAL(entry->type, N_SECT_EXT);
+    ZIK_ASSERT_EQUAL(entry->sect, 1);
+    entry = index.find("_static_function");
+    ZIK_ASSERT_TRUE(entry != nullptr);
+    ZIK_ASSERT_EQUAL(entry->value, 0x1010);
+    entry = index.find("_thumb");
+    ZIK_ASSERT_TRUE(entry != nullptr);
+    ZIK_ASSERT_EQUAL(entry->desc, 0x0008);
+    entry = index.find("_undefined");
+    ZIK_ASSERT_TRUE(entry != nullptr);
+    ZIK_ASSERT_EQUAL(entry->value, 0);
+    // The first one in symbol table
+    entry = index.find("_duplicate");
+    ZIK_ASSERT_TRUE(entry != nullptr);
+    ZIK_ASSERT_EQUAL(entry->value, 0x1040);
+
+    ZIK_ASSERT_TRUE(index.find("_debug.o") == nullptr);
+    ZIK_ASSERT_TRUE(index.find("main") == nullptr);
+    ZIK_ASSERT_TRUE(index.find("_mai") == nullptr);
+    ZIK_ASSERT_TRUE(index.find("") == nullptr);
+    ZIK_ASSERT_TRUE(index.find(nullptr) == nullptr);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testIndex64Bit) {
+    checkIndexWith64Bit(true);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testIndex32Bit) {
+    checkIndexWith64Bit(false);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testImageWithoutSymbolTable) {
+    std::vector<uint8_t> file = symbolImage(true, {});
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_FALSE(readSymbolTable(image, table));
+    SymbolIndex index;
+    ZIK_ASSERT_FALSE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), 0);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testSymbolTableOutOfFile) {
+    std::vector<uint8_t> file = symbolImage(true, syntheticSymbols(100));
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    size_t stringsEnd = static_cast<size_t>(table.strings - reinterpret_cast<const char *>(file.data())) + table.stringsSize;
+
+    std::vector<uint8_t> truncated(file.begin(), file.begin() + stringsEnd - 1);
+    ZIK_ASSERT_TRUE(image.parse(truncated.data(), truncated.size(), MachOImage::LayoutFile));
+    SymbolIndex index;
+    ZIK_ASSERT_FALSE(index.build(image));
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testStringIndexOutOfStringTable) {
+    std::vector<uint8_t> file = symbolImage(true, {{"_first", N_SECT_EXT, 1, 0, 0x1000}, {"_second", N_SECT_EXT, 1, 0, 0x1010}});
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    macho::nlist_64 *symbols = const_cast<macho::nlist_64 *>(static_cast<const macho::nlist_64 *>(table.symbols));
+    symbols[0].n_strx = table.stringsSize + 100;
+    // Unterminated tail of the string table is cut, so "_second" is out of it
+    char *strings = const_cast<char *>(table.strings);
+    memset(strings + symbols[1].n_strx, 'x', table.stringsSize - symbols[1].n_strx);
+
+    SymbolIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), 0);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testIndexMatchesLinearScan) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = syntheticSymbols(5000);
+    std::vector<uint8_t> file = symbolImage(true, symbols);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    SymbolIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    ZIK_ASSERT_EQUAL(index.count(), symbols.size());
+    for (size_t i = 0; i < symbols.size(); i += 97) {
+        const SymbolIndex::Entry *entry = index.find(symbols[i].name.c_str());
+        ZIK_ASSERT_TRUE(entry != nullptr);
+        ZIK_ASSERT_EQUAL(entry->value, linearFind(table, symbols[i].name.c_str()));
+    }
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testLoadedImageCache) {
+    std::vector<uint8_t> file = symbolImage(sizeof(void *) == 8, {{"_main", N_SECT_EXT, 1, 0, 0x1000}, {"_undefined", macho::N_UNDF | macho::N_EXT, 0, 0, 0}});
+    const void *header = file.data();
+    SymbolIndexCache cache;
+    std::shared_ptr<const SymbolIndex> index = cache.indexForLoadedImage(header);
+    ZIK_ASSERT_TRUE(index != nullptr);
+    ZIK_ASSERT_EQUAL(index->slide(), reinterpret_cast<intptr_t>(header));
+    ZIK_ASSERT_TRUE(index->find("_main") != nullptr);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 1);
+    // Built only once
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(header) == index);
+
+    // Another image is loaded at the same address after unloading
+    cache.removeImage(header);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 0);
+    std::vector<uint8_t> other = symbolImage(sizeof(void *) == 8, {{"_other", N_SECT_EXT, 1, 0, 0x1000}});
+    ZIK_ASSERT_TRUE(other.size() <= file.size());
+    memcpy(file.data(), other.data(), other.size());
+    std::shared_ptr<const SymbolIndex> newIndex = cache.indexForLoadedImage(header);
+    ZIK_ASSERT_TRUE(newIndex != nullptr);
+    ZIK_ASSERT_TRUE(newIndex->find("_main") == nullptr);
+    ZIK_ASSERT_TRUE(newIndex->find("_other") != nullptr);
+
+    // Images without symbol table are cached too
+    std::vector<uint8_t> stripped = symbolImage(sizeof(void *) == 8, {});
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(stripped.data()) == nullptr);
+    ZIK_ASSERT_EQUAL(cache.imageCount(), 2);
+    uint32_t garbage = 0;
+    ZIK_ASSERT_TRUE(cache.indexForLoadedImage(&garbage) == nullptr);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testFindInLoadedImage) {
+    std::vector<uint8_t> file = symbolImage(sizeof(void *) == 8, {{"_main", N_SECT_EXT, 1, 0x0008, 0x1000}, {"_undefined", macho::N_UNDF | macho::N_EXT, 0, 0, 0}});
+    const void *header = file.data();
+    ZIKSymbolIndexEntry entry;
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(header, "_main", &entry), ZIKSymbolIndexStatusFound);
+    ZIK_ASSERT_EQUAL(entry.address, reinterpret_cast<uintptr_t>(header) + 0x1000);
+    ZIK_ASSERT_EQUAL(entry.type, N_SECT_EXT);
+    ZIK_ASSERT_EQUAL(entry.desc, 0x0008);
+    // Undefined symbols are not slid
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(header, "_undefined", &entry), ZIKSymbolIndexStatusFound);
+    ZIK_ASSERT_EQUAL(entry.address, 0);
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(header, "_missing", &entry), ZIKSymbolIndexStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(header, NULL, &entry), ZIKSymbolIndexStatusNotFound);
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(header, "_main", NULL), ZIKSymbolIndexStatusFound);
+
+    std::vector<uint8_t> stripped = symbolImage(sizeof(void *) == 8, {});
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindInLoadedImage(stripped.data(), "_main", &entry), ZIKSymbolIndexStatusUnavailable);
+    ZIKSymbolIndexRemoveLoadedImage(header);
+    ZIKSymbolIndexRemoveLoadedImage(stripped.data());
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testFindSymbolsInOnePass) {
+    std::vector<uint8_t> file = symbolImage(true, {
+        {"_main", N_SECT_EXT, 1, 0, 0x1000},
+        {"_debug.o", macho::N_STAB, 0, 0, 0x1010},
+        {"_duplicate", macho::N_SECT, 1, 0, 0x1020},
+        {"_duplicate", N_SECT_EXT, 1, 0, 0x1030},
+        {"_thumb", N_SECT_EXT, 1, 0x0008, 0x1040},
+    });
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+
+    const char *names[] = {"_thumb", "_missing", "_main", "_duplicate", "_debug.o", NULL, "_main", "_mai"};
+    const size_t count = sizeof(names) / sizeof(names[0]);
+    SymbolIndex::Entry entries[count];
+    bool found[count];
+    ZIK_ASSERT_EQUAL(findSymbols(table, names, count, entries, found), 4);
+    ZIK_ASSERT_TRUE(found[0]);
+    ZIK_ASSERT_EQUAL(entries[0].value, 0x1040);
+    ZIK_ASSERT_EQUAL(entries[0].desc, 0x0008);
+    ZIK_ASSERT_FALSE(found[1]);
+    ZIK_ASSERT_TRUE(found[2]);
+    ZIK_ASSERT_EQUAL(entries[2].value, 0x1000);
+    // The first one in symbol table
+    ZIK_ASSERT_TRUE(found[3]);
+    ZIK_ASSERT_EQUAL(entries[3].value, 0x1020);
+    ZIK_ASSERT_FALSE(found[4]);
+    ZIK_ASSERT_FALSE(found[5]);
+    ZIK_ASSERT_TRUE(found[6]);
+    ZIK_ASSERT_EQUAL(entries[6].value, 0x1000);
+    ZIK_ASSERT_FALSE(found[7]);
+
+    ZIK_ASSERT_EQUAL(findSymbols(table, names, 0, entries, found), 0);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testFindSymbolsMatchesIndex) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = syntheticSymbols(5000);
+    std::vector<uint8_t> file = symbolImage(true, symbols);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    SymbolIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    std::vector<const char *> names;
+    for (size_t i = 0; i < symbols.size(); i += 97) {
+        names.push_back(symbols[i].name.c_str());
+    }
+    std::vector<SymbolIndex::Entry> entries(names.size());
+    std::unique_ptr<bool[]> found(new bool[names.size()]);
+    ZIK_ASSERT_EQUAL(findSymbols(table, names.data(), names.size(), entries.data(), found.get()), names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        ZIK_ASSERT_EQUAL(entries[i].value, index.find(names[i])->value);
+    }
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testFindSymbolsInLoadedImage) {
+    std::vector<uint8_t> file = symbolImage(sizeof(void *) == 8, {{"_main", N_SECT_EXT, 1, 0, 0x1000}, {"_other", N_SECT_EXT, 1, 0, 0x1010}});
+    const void *header = file.data();
+    const char *names[] = {"_other", "_missing", "_main"};
+    ZIKSymbolIndexEntry entries[3];
+    bool found[3];
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindSymbolsInLoadedImage(header, names, 3, entries, found), ZIKSymbolIndexStatusNotFound);
+    ZIK_ASSERT_TRUE(found[0]);
+    ZIK_ASSERT_EQUAL(entries[0].address, reinterpret_cast<uintptr_t>(header) + 0x1010);
+    ZIK_ASSERT_FALSE(found[1]);
+    ZIK_ASSERT_TRUE(found[2]);
+    ZIK_ASSERT_EQUAL(entries[2].address, reinterpret_cast<uintptr_t>(header) + 0x1000);
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindSymbolsInLoadedImage(header, names + 2, 1, entries, found), ZIKSymbolIndexStatusFound);
+
+    std::vector<uint8_t> stripped = symbolImage(sizeof(void *) == 8, {});
+    ZIK_ASSERT_EQUAL(ZIKSymbolIndexFindSymbolsInLoadedImage(stripped.data(), names, 3, entries, found), ZIKSymbolIndexStatusUnavailable);
+    ZIK_ASSERT_FALSE(found[0]);
+    ZIKSymbolIndexRemoveLoadedImage(header);
+    ZIKSymbolIndexRemoveLoadedImage(stripped.data());
+}
+
+// MARK: Benchmark
+
+/// 200k symbols, about the size of a large app binary.
+static std::vector<uint8_t> benchmarkImage(std::vector<std::string> &lookupNames) {
+    std::vector<MachOFixtureBuilder::Symbol> symbols = syntheticSymbols(200000);
+    std::mt19937 random(1);
+    for (size_t i = 0; i < 1000; i++) {
+        lookupNames.push_back(symbols[random() % symbols.size()].name);
+    }
+    return symbolImage(true, symbols);
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testPerformanceBuildIndex) {
+    std::vector<std::string> names;
+    std::vector<uint8_t> file = benchmarkImage(names);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    measure([&] {
+        SymbolIndex index;
+        ZIK_ASSERT_TRUE(index.build(image));
+        ZIK_ASSERT_EQUAL(index.count(), 200000);
+    });
+}
+
+/// Only 20 lookups, because each one scans all symbols.
+ZIK_TEST(ZIKSymbolIndexTests, testPerformanceLinearLookup) {
+    std::vector<std::string> names;
+    std::vector<uint8_t> file = benchmarkImage(names);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    measure([&] {
+        for (size_t i = 0; i < 20; i++) {
+            ZIK_ASSERT_TRUE(linearFind(table, names[i].c_str()) != 0);
+        }
+    });
+}
+
+ZIK_TEST(ZIKSymbolIndexTests, testPerformanceIndexedLookup) {
+    std::vector<std::string> names;
+    std::vector<uint8_t> file = benchmarkImage(names);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    SymbolIndex index;
+    ZIK_ASSERT_TRUE(index.build(image));
+    measure([&] {
+        for (size_t round = 0; round < 100; round++) {
+            for (const std::string &name : names) {
+                ZIK_ASSERT_TRUE(index.find(name.c_str()) != nullptr);
+            }
+        }
+    });
+}
+
+/// Resolve 20 names in one pass, against testPerformanceLinearLookup resolving them one by one.
+ZIK_TEST(ZIKSymbolIndexTests, testPerformanceBatchLookup) {
+    std::vector<std::string> names;
+    std::vector<uint8_t> file = benchmarkImage(names);
+    MachOImage image;
+    ZIK_ASSERT_TRUE(image.parse(file.data(), file.size(), MachOImage::LayoutFile));
+    MachOSymbolTable table;
+    ZIK_ASSERT_TRUE(readSymbolTable(image, table));
+    std::vector<const char *> batch;
+    for (size_t i = 0; i < 20; i++) {
+        batch.push_back(names[i].c_str());
+    }
+    std::vector<SymbolIndex::Entry> entries(batch.size());
+    std::unique_ptr<bool[]> found(new bool[batch.size()]);
+    measure([&] {
+        ZIK_ASSERT_EQUAL(findSymbols(table, batch.data(), batch.size(), entries.data(), found.get()), batch.size());
+    });
+}
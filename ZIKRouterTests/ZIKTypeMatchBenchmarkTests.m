@@ -0,0 +1,127 @@
+//
+//  ZIKTypeMatchBenchmarkTests.m
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+@import ZIKRouter.Private;
+#import <objc/runtime.h>
+#import <mach/mach_time.h>
+
+#if DEBUG
+
+static uint64_t _nowNanoseconds(void) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return (uint64_t)((double)mach_absolute_time() * timebase.numer / timebase.denom);
+}
+
+/**
+ Measure `_swift_typeIsTargetType` in validation of synthetic routes created at runtime. Each route has a destination class conforming to its destination protocol. Validation checks each destination against its own protocol, and against the protocol of the next route, which fails.
+
+ The first validation after removing cached results computes each pair, like validation before results were cached. Later validations only look up cached results. Results are written as JSON to the path in environment variable `ZIKROUTER_BENCHMARK_OUTPUT`, or `ZIKTypeMatchBenchmark.json` in the temporary directory.
+ */
+@interface ZIKTypeMatchBenchmarkTests : XCTestCase
+@end
+
+@implementation ZIKTypeMatchBenchmarkTests
+
+- (void)makeRoutesWithName:(NSString *)name count:(NSUInteger)count classes:(NSMutableArray<Class> *)classes protocols:(NSMutableArray<Protocol *> *)protocols {
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *protocolName = [NSString stringWithFormat:@"%@Service%lu", name, (unsigned long)i];
+        Protocol *protocol = objc_allocateProtocol(protocolName.UTF8String);
+        protocol_addProtocol(protocol, @protocol(ZIKServiceRoutable));
+        objc_registerProtocol(protocol);
+        [protocols addObject:protocol];
+
+        NSString *serviceName = [NSString stringWithFormat:@"%@ServiceImpl%lu", name, (unsigned long)i];
+        Class serviceClass = objc_allocateClassPair([NSObject class], serviceName.UTF8String, 0);
+        class_addProtocol(serviceClass, @protocol(ZIKRoutableService));
+        class_addProtocol(serviceClass, protocol);
+        objc_registerClassPair(serviceClass);
+        [classes addObject:serviceClass];
+    }
+}
+
+/// Check each route, return count of wrong results.
+- (NSUInteger)validateClasses:(NSArray<Class> *)classes protocols:(NSArray<Protocol *> *)protocols {
+    NSUInteger count = classes.count;
+    NSUInteger wrongResults = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        if (!_swift_typeIsTargetType(classes[i], protocols[i])) {
+            wrongResults++;
+        }
+        if (_swift_typeIsTargetType(classes[i], protocols[(i + 1) % count])) {
+            wrongResults++;
+        }
+    }
+    return wrongResults;
+}
+
+- (NSDictionary *)benchmarkWithRouteCount:(NSUInteger)count iterations:(NSUInteger)iterations {
+    static NSUInteger runIndex = 0;
+    NSString *name = [NSString stringWithFormat:@"ZIKTypeMatchBenchmark%lu_%lu_", (unsigned long)count, (unsigned long)runIndex++];
+    NSMutableArray<Class> *classes = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray arrayWithCapacity:count];
+    [self makeRoutesWithName:name count:count classes:classes protocols:protocols];
+
+    uint64_t uncachedTime = 0;
+    uint64_t cachedTime = 0;
+    for (NSUInteger i = 0; i < iterations; i++) {
+        zix_removeCachedTypeMatches();
+        uint64_t start = _nowNanoseconds();
+        XCTAssertEqual([self validateClasses:classes protocols:protocols], 0);
+        uncachedTime += _nowNanoseconds() - start;
+
+        start = _nowNanoseconds();
+        XCTAssertEqual([self validateClasses:classes protocols:protocols], 0);
+        cachedTime += _nowNanoseconds() - start;
+    }
+    double uncachedMs = uncachedTime / 1e6 / iterations;
+    double cachedMs = cachedTime / 1e6 / iterations;
+    return @{@"routes": @(count),
+             @"checks": @(count * 2),
+             @"uncachedValidationMs": @(uncachedMs),
+             @"cachedValidationMs": @(cachedMs),
+             @"uncachedCheckNs": @(uncachedMs * 1e6 / (count * 2)),
+             @"cachedCheckNs": @(cachedMs * 1e6 / (count * 2)),
+             @"speedup": @(cachedMs > 0 ? uncachedMs / cachedMs : 0)};
+}
+
+- (void)testResultsAreRemovedAfterAddingProtocol {
+    NSMutableArray<Class> *classes = [NSMutableArray array];
+    NSMutableArray<Protocol *> *protocols = [NSMutableArray array];
+    [self makeRoutesWithName:@"ZIKTypeMatchAddProtocol" count:2 classes:classes protocols:protocols];
+    XCTAssertFalse(_swift_typeIsTargetType(classes[0], protocols[1]));
+    XCTAssertFalse(_swift_typeIsTargetType(classes[0], protocols[1]));
+
+    class_addProtocol(classes[0], protocols[1]);
+    zix_removeCachedTypeMatches();
+    XCTAssertTrue(_swift_typeIsTargetType(classes[0], protocols[1]));
+    XCTAssertTrue(_swift_typeIsTargetType(classes[0], protocols[1]));
+    XCTAssertTrue(_swift_typeIsTargetType(classes[1], protocols[1]));
+    XCTAssertFalse(_swift_typeIsTargetType(classes[1], protocols[0]));
+}
+
+- (void)testPerformanceValidationWithSyntheticRoutes {
+    NSDictionary *result = [self benchmarkWithRouteCount:2000 iterations:5];
+    XCTAssertLessThan([result[@"cachedValidationMs"] doubleValue], [result[@"uncachedValidationMs"] doubleValue]);
+    NSData *json = [NSJSONSerialization dataWithJSONObject:@{@"benchmark": @"ZIKTypeMatch", @"results": @[result]} options:NSJSONWritingPrettyPrinted error:nil];
+    XCTAssertNotNil(json);
+    NSString *path = [NSProcessInfo processInfo].environment[@"ZIKROUTER_BENCHMARK_OUTPUT"];
+    if (path.length == 0) {
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"ZIKTypeMatchBenchmark.json"];
+    }
+    XCTAssertTrue([json writeToFile:path atomically:YES]);
+    NSLog(@"Type match benchmark (%@):\n%@", path, [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding]);
+}
+
+@end
+
+#endif
@@ -0,0 +1,153 @@
+//
+//  ZIKTypeMatchCacheTests.cpp
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#include "ZIKCoreTest.h"
+#include "ZIKTypeMatchCache.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace zix;
+
+/// Fake types, only their addresses are used as keys.
+static uint64_t fakeTypes[4096];
+
+ZIK_TEST(ZIKTypeMatchCacheTests, testGetAndSet) {
+    TypeMatchCache cache;
+    bool isTargetType = true;
+    ZIK_ASSERT_FALSE(cache.get(&fakeTypes[0], &fakeTypes[1], isTargetType));
+    ZIK_ASSERT_TRUE(isTargetType);
+
+    cache.set(&fakeTypes[0], &fakeTypes[1], false);
+    cache.set(&fakeTypes[0], &fakeTypes[2], true);
+    ZIK_ASSERT_TRUE(cache.get(&fakeTypes[0], &fakeTypes[1], isTargetType));
+    ZIK_ASSERT_FALSE(isTargetType);
+    ZIK_ASSERT_TRUE(cache.get(&fakeTypes[0], &fakeTypes[2], isTargetType));
+    ZIK_ASSERT_TRUE(isTargetType);
+    // Pairs are ordered
+    ZIK_ASSERT_FALSE(cache.get(&fakeTypes[1], &fakeTypes[0], isTargetType));
+    ZIK_ASSERT_FALSE(cache.get(&fakeTypes[2], &fakeTypes[0], isTargetType));
+
+    // Setting again replaces the result
+    cache.set(&fakeTypes[0], &fakeTypes[1], true);
+    ZIK_ASSERT_TRUE(cache.get(&fakeTypes[0], &fakeTypes[1], isTargetType));
+    ZIK_ASSERT_TRUE(isTargetType);
+
+    ZIKTypeMatchCacheStatistics statistics = cache.statistics();
+    ZIK_ASSERT_EQUAL(statistics.hits, 3);
+    ZIK_ASSERT_EQUAL(statistics.misses, 3);
+    ZIK_ASSERT_EQUAL(statistics.count, 2);
+
+    cache.removeAll();
+    ZIK_ASSERT_EQUAL(cache.statistics().count, 0);
+    ZIK_ASSERT_FALSE(cache.get(&fakeTypes[0], &fakeTypes[1], isTargetType));
+}
+
+ZIK_TEST(ZIKTypeMatchCacheTests, testTaggedPointers) {
+    // Swift type metadata is tagged in the lowest bit, it's a different key from the untagged pointer
+    TypeMatchCache cache;
+    const void *type = &fakeTypes[0];
+    const void *taggedType = reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(type) | 1);
+    cache.set(type, &fakeTypes[1], true);
+    cache.set(taggedType, &fakeTypes[1], false);
+    bool isTargetType = false;
+    ZIK_ASSERT_TRUE(cache.get(type, &fakeTypes[1], isTargetType));
+    ZIK_ASSERT_TRUE(isTargetType);
+    ZIK_ASSERT_TRUE(cache.get(taggedType, &fakeTypes[1], isTargetType));
+    ZIK_ASSERT_FALSE(isTargetType);
+    ZIK_ASSERT_EQUAL(cache.statistics().count, 2);
+}
+
+ZIK_TEST(ZIKTypeMatchCacheTests, testManyPairs) {
+    // Registered types checked against their protocols and against other protocols
+    TypeMatchCache cache;
+    const size_t count = 2048;
+    for (size_t i = 0; i < count; i++) {
+        cache.set(&fakeTypes[i], &fakeTypes[count + i], true);
+        cache.set(&fakeTypes[i], &fakeTypes[count + (i + 1) % count], false);
+    }
+    ZIK_ASSERT_EQUAL(cache.statistics().count, count * 2);
+    size_t wrongResults = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool isTargetType = false;
+        if (!cache.get(&fakeTypes[i], &fakeTypes[count + i], isTargetType) || !isTargetType) {
+            wrongResults++;
+        }
+        if (!cache.get(&fakeTypes[i], &fakeTypes[count + (i + 1) % count], isTargetType) || isTargetType) {
+            wrongResults++;
+        }
+        if (cache.get(&fakeTypes[i], &fakeTypes[count + (i + 2) % count], isTargetType)) {
+            wrongResults++;
+        }
+    }
+    ZIK_ASSERT_EQUAL(wrongResults, 0);
+}
+
+ZIK_TEST(ZIKTypeMatchCacheTests, testCFunctions) {
+    ZIKTypeMatchCacheRef cache = ZIKTypeMatchCacheCreate();
+    bool isTargetType = false;
+    ZIK_ASSERT_FALSE(ZIKTypeMatchCacheGet(cache, &fakeTypes[0], &fakeTypes[1], &isTargetType));
+    ZIKTypeMatchCacheSet(cache, &fakeTypes[0], &fakeTypes[1], true);
+    ZIK_ASSERT_TRUE(ZIKTypeMatchCacheGet(cache, &fakeTypes[0], &fakeTypes[1], &isTargetType));
+    ZIK_ASSERT_TRUE(isTargetType);
+    ZIK_ASSERT_TRUE(ZIKTypeMatchCacheGet(cache, &fakeTypes[0], &fakeTypes[1], NULL));
+
+    ZIKTypeMatchCacheStatistics statistics = ZIKTypeMatchCacheGetStatistics(cache);
+    ZIK_ASSERT_EQUAL(statistics.hits, 2);
+    ZIK_ASSERT_EQUAL(statistics.misses, 1);
+    ZIK_ASSERT_EQUAL(statistics.count, 1);
+
+    ZIKTypeMatchCacheRemoveAll(cache);
+    ZIK_ASSERT_FALSE(ZIKTypeMatchCacheGet(cache, &fakeTypes[0], &fakeTypes[1], &isTargetType));
+    ZIKTypeMatchCacheDestroy(cache);
+
+    // NULL cache caches nothing
+    ZIKTypeMatchCacheSet(NULL, &fakeTypes[0], &fakeTypes[1], true);
+    ZIK_ASSERT_FALSE(ZIKTypeMatchCacheGet(NULL, &fakeTypes[0], &fakeTypes[1], &isTargetType));
+    ZIKTypeMatchCacheRemoveAll(NULL);
+    ZIK_ASSERT_EQUAL(ZIKTypeMatchCacheGetStatistics(NULL).count, 0);
+}
+
+ZIK_TEST(ZIKTypeMatchCacheTests, testConcurrentChecks) {
+    // Threads check the same pairs, computing results of missed pairs like _swift_typeIsTargetType
+    TypeMatchCache cache;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> wrongResults(0);
+    std::atomic<size_t> computations(0);
+    const size_t checksPerThread = 20000;
+    const size_t pairs = 500;
+    for (size_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&cache, &wrongResults, &computations, t, checksPerThread, pairs]() {
+            for (size_t i = 0; i < checksPerThread; i++) {
+                size_t index = (i * 31 + t) % pairs;
+                const void *source = &fakeTypes[index];
+                const void *target = &fakeTypes[pairs + index / 2];
+                bool expected = index % 3 != 0;
+                bool isTargetType;
+                if (!cache.get(source, target, isTargetType)) {
+                    computations++;
+                    isTargetType = expected;
+                    cache.set(source, target, isTargetType);
+                }
+                if (isTargetType != expected) {
+                    wrongResults++;
+                }
+            }
+        }));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    ZIK_ASSERT_EQUAL(wrongResults.load(), 0);
+    ZIKTypeMatchCacheStatistics statistics = cache.statistics();
+    ZIK_ASSERT_EQUAL(statistics.count, pairs);
+    ZIK_ASSERT_EQUAL(statistics.hits + statistics.misses, 4 * checksPerThread);
+    ZIK_ASSERT_EQUAL(statistics.misses, computations.load());
+    // Each pair is computed at most once in each thread
+    ZIK_ASSERT_LESS_THAN_OR_EQUAL(computations.load(), 4 * pairs);
+}
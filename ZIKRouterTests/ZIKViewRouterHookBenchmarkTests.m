@@ -0,0 +1,92 @@
+//
+//  ZIKViewRouterHookBenchmarkTests.m
+//  ZIKRouterTests
+//
+//  Created by zuik on 2026/10/18.
+//  Copyright © 2026 zuik. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+@import ZIKRouter;
+@import ZIKRouter.Internal;
+#import <objc/runtime.h>
+#import <mach/mach_time.h>
+
+/// Not routable, like most view controllers in apps.
+@interface ZIKHookBenchmarkViewController : UIViewController
+@end
+
+@implementation ZIKHookBenchmarkViewController
+
+- (void)viewWillAppear:(BOOL)animated {
+    [super viewWillAppear:animated];
+}
+
+@end
+
+static uint64_t _nowNanoseconds(void) {
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return (uint64_t)((double)mach_absolute_time() * timebase.numer / timebase.denom);
+}
+
+/// Headless harness: dispatch -viewWillAppear: directly without window or transition, so only the dispatch and the hook are measured.
+static double _nanosecondsPerViewWillAppear(UIViewController *viewController, NSUInteger count) {
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [viewController viewWillAppear:NO];
+    }
+    uint64_t start = _nowNanoseconds();
+    for (NSUInteger i = 0; i < count; i++) {
+        [viewController viewWillAppear:NO];
+    }
+    return (double)(_nowNanoseconds() - start) / count;
+}
+
+@interface ZIKViewRouterHookBenchmarkTests : XCTestCase
+@end
+
+@implementation ZIKViewRouterHookBenchmarkTests
+
+- (void)testInstallingHooksIsIdempotent {
+    _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupViewController);
+    XCTAssertTrue(_ZIKViewRouterInstalledHookGroups() & ZIKViewRouterHookGroupViewController);
+    IMP hookedIMP = method_getImplementation(class_getInstanceMethod([UIViewController class], @selector(viewWillAppear:)));
+    IMP originalIMP = method_getImplementation(class_getInstanceMethod([UIViewController class], NSSelectorFromString(@"ZIKViewRouter_hook_viewWillAppear:")));
+    XCTAssertTrue(originalIMP != NULL);
+    XCTAssertTrue(hookedIMP != originalIMP);
+
+    // Swizzling again would restore the original implementation
+    _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupViewController);
+    _ZIKViewRouterInstallHooksForDestinationClass([ZIKHookBenchmarkViewController class]);
+    XCTAssertTrue(method_getImplementation(class_getInstanceMethod([UIViewController class], @selector(viewWillAppear:))) == hookedIMP);
+}
+
+- (void)testViewDestinationInstallsViewControllerHooks {
+    _ZIKViewRouterInstallHooksForDestinationClass([UIView class]);
+    ZIKViewRouterHookGroup groups = _ZIKViewRouterInstalledHookGroups();
+    XCTAssertTrue(groups & ZIKViewRouterHookGroupView);
+    XCTAssertTrue(groups & ZIKViewRouterHookGroupViewController);
+}
+
+- (void)testPerformanceViewWillAppearHookOverhead {
+    _ZIKViewRouterInstallHooks(ZIKViewRouterHookGroupViewController);
+    Method method = class_getInstanceMethod([UIViewController class], @selector(viewWillAppear:));
+    Method hookMethod = class_getInstanceMethod([UIViewController class], NSSelectorFromString(@"ZIKViewRouter_hook_viewWillAppear:"));
+    XCTAssertTrue(hookMethod != NULL);
+    IMP hookedIMP = method_getImplementation(method);
+
+    const NSUInteger count = 100000;
+    ZIKHookBenchmarkViewController *viewController = [ZIKHookBenchmarkViewController new];
+    double hooked = _nanosecondsPerViewWillAppear(viewController, count);
+    // Exchange back to measure the original implementation, like before hooks are installed
+    method_exchangeImplementations(method, hookMethod);
+    double original = _nanosecondsPerViewWillAppear(viewController, count);
+    method_exchangeImplementations(method, hookMethod);
+    XCTAssertTrue(method_getImplementation(method) == hookedIMP);
+
+    NSLog(@"-viewWillAppear: without hooks: %.1f ns, with hooks: %.1f ns, overhead: %.1f ns per call", original, hooked, hooked - original);
+}
+
+@end
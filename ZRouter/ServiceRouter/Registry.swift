@@ -154,6 +154,7 @@ internal class Registry {
         _addToValidateList(for: routableService, router: router)
         #endif
         serviceProtocolContainer[_RouteKey(routable: routableService)] = router
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKServiceRouter subclass.  Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -176,6 +177,7 @@ internal class Registry {
         assert(router.defaultRouteConfiguration() is Protocol, "The module config protocol (\(configProtocol)) should be conformed by the router (\(router))'s defaultRouteConfiguration (\(Swift.type(of: router.defaultRouteConfiguration()))).")
         assert(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] == nil, "service config protocol (\(configProtocol)) was already registered with router (\(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)]!)).")
         serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] = router
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for your service with a ZIKServiceRoute. Router will check whether the registered service protocol is conformed by the registered service.
@@ -199,6 +201,7 @@ internal class Registry {
         _addTovalidateList(for: routableService, route: route)
         #endif
         serviceProtocolContainer[_RouteKey(routable: routableService)] = route
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKServiceRoute. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -219,6 +222,7 @@ internal class Registry {
         }
         assert(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] == nil, "service config protocol (\(configProtocol)) was already registered with router (\(serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)]!)).")
         serviceModuleProtocolContainer[_RouteKey(routable: routableServiceModule)] = route
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableService<Adapter>, forAdaptee adaptee: RoutableService<Adaptee>) {
@@ -247,6 +251,7 @@ internal class Registry {
         }
         
         serviceAdapterContainer[adapterKey] = adapteeKey
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableServiceModule<Adapter>, forAdaptee adaptee: RoutableServiceModule<Adaptee>) {
@@ -275,6 +280,7 @@ internal class Registry {
         }
         
         serviceModuleAdapterContainer[adapterKey] = adapteeKey
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static let makingDestinationIdentifierPrefix = "~SwiftMakingDestination~"
@@ -436,9 +442,15 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The service router class for the service protocol.
     static func _router(toService serviceProtocol: Any.Type, name: String) -> ZIKAnyServiceRouterType? {
+        // Swift containers may still be written by +registerAllInBackground
+        ZIKRouteRegistry.waitForRegistration()
         if let routerType = _swiftRouter(toServiceKey: _RouteKey(type: serviceProtocol, name: name)) {
             return routerType
         }
+        // Pure Swift routes may be registered by deferred routers, or routers not registered yet from frozen route table
+        if ZIKRouteRegistry.completeRegistration(), let routerType = _swiftRouter(toServiceKey: _RouteKey(type: serviceProtocol, name: name)) {
+            return routerType
+        }
         if let routableProtocol = _routableServiceProtocolFromObject(serviceProtocol), let routerType = _ZIKServiceRouterToService(routableProtocol) {
             return routerType
         }
@@ -501,9 +513,15 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The service router class for the config protocol.
     static func _router(toServiceModule configProtocol: Any.Type, name: String) -> ZIKAnyServiceRouterType? {
+        // Swift containers may still be written by +registerAllInBackground
+        ZIKRouteRegistry.waitForRegistration()
         if let routerType = _swiftRouter(toServiceModuleKey: _RouteKey(type: configProtocol, name: name)) {
             return routerType
         }
+        // Pure Swift routes may be registered by deferred routers, or routers not registered yet from frozen route table
+        if ZIKRouteRegistry.completeRegistration(), let routerType = _swiftRouter(toServiceModuleKey: _RouteKey(type: configProtocol, name: name)) {
+            return routerType
+        }
         
         if let routableProtocol = _routableServiceModuleProtocolFromObject(configProtocol), let routerType = _ZIKServiceRouterToModule(routableProtocol) {
             return routerType
@@ -625,6 +643,52 @@ internal extension String {
     }
 }
 
+/// Routable declarations and usages in ZIKRoutableManifest.json, generated from app's binaries by Tools/ZIKRoutableManifest. Validaters read it instead of enumerating and demangling symbols. Nil when there is no valid manifest.
+internal struct _RoutableManifest {
+    static let shared: _RoutableManifest? = {
+        guard let entries = zix_routableManifestEntries() else {
+            return nil
+        }
+        return _RoutableManifest(entries: entries)
+    }()
+
+    let entries: [[String: String]]
+
+    /// Undotted protocols declared in extensions of the routable type, such as "SomeServiceProtocol" for `extension RoutableService where Protocol == SomeServiceProtocol`.
+    func declaredProtocols(of routable: String) -> [String] {
+        var protocols = [String]()
+        for entry in entries where entry["kind"] == "declaration" && entry["routable"] == routable {
+            if let declaredProtocol = entry["protocol"] {
+                protocols.append(declaredProtocol.undotted)
+            }
+        }
+        return protocols
+    }
+
+    /// Generic types used with the routable type, as (full name, undotted name).
+    func routingTypes(of routable: String) -> [(String, String)] {
+        var routingTypes = [(String, String)]()
+        for entry in entries where entry["kind"] == "routingType" && entry["routable"] == routable {
+            if let routingType = entry["protocol"] {
+                routingTypes.append((routingType, routingType.undotted))
+            }
+        }
+        return routingTypes
+    }
+
+    /// Generic signatures of initializers in constrained extensions in ZRouter, and paths of images using them.
+    func constrainedInitializers(of routables: [String]) -> [(String, String)] {
+        var initializers = [(String, String)]()
+        for entry in entries where entry["kind"] == "constrainedInitializer" {
+            if let routable = entry["routable"], routables.contains(routable),
+                let signature = entry["signature"], let image = entry["image"] {
+                initializers.append((signature, image))
+            }
+        }
+        return initializers
+    }
+}
+
 /// Make sure all registered service classes conform to their registered service protocols.
 private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
     override class func isAbstractRouter() -> Bool {
@@ -634,102 +698,121 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         
         var errorDescription = ""
         // Declared protocol in extension of RoutableService and RoutableServiceModule should be registered
-        var declaredRoutableTypes = [String]()
+        var declaredDestinationProtocols = [String]()
+        var declaredModuleProtocols = [String]()
         // Types in method signature used as RoutableService<Type>(), RoutableService<Type>(declaredProtocol: Type.self) and RoutableService<Type>(declaredTypeName: typeName), maybe not declared yet
         var serviceRoutingTypes = [(String, String)]()
         // Types in method signature used as RoutableServiceModule<Type>(), RoutableServiceModule<Type>(declaredProtocol: Type.self) and RoutableServiceModule<Type>(declaredTypeName: typeName), maybe not declared yet
         var serviceModuleRoutingTypes = [(String, String)]()
         
-        let serviceRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableService<).*(?=>$)", options: [.anchorsMatchLines])
-        let serviceModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableServiceModule<).*(?=>$)", options: [.anchorsMatchLines])
-        zix_enumerateSymbolName { (name, demangledAsSwift) -> Bool in
-            if (strstr(name, "RoutableService") != nil) {
-                let symbolName = demangledAsSwift(name, false)
-                if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
-                    if symbolName.contains("(extension in ZRouter)") == false {
-                        let simplifiedName = demangledAsSwift(name, true)
-                        declaredRoutableTypes.append(simplifiedName)
-                    } else if symbolName.contains(".NSObject"), symbolName.contains(".ZIKServiceRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a Class type as generic parameter of RoutableService:
-                            ```
-                            @objc protocol SomeServiceProtocol: ZIKServiceRoutable {
-
-                            }
-                            class SomeClassType: NSObject, SomeServiceProtocol {
+        // Initializers in constrained extensions of ZRouter are only used by invalid generic parameters
+        func checkConstrainedInitializer(_ symbolName: String, imagePath image: () -> String) {
+            if symbolName.contains(".NSObject"), symbolName.contains(".ZIKServiceRoutable") {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use a Class type as generic parameter of RoutableService:
+                    ```
+                    @objc protocol SomeServiceProtocol: ZIKServiceRoutable {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableService<SomeClassType>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<SomeClassType>()` to `RoutableService<SomeServiceProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableService<A where A: __ObjC.NSObject, A: __ObjC.ZIKServiceRoutable>.init() -> ZRouter.RoutableService<A>
-                            """)
-                    } else if symbolName.contains(".ZIKPerformRouteConfiguration"), symbolName.contains(".ZIKServiceModuleRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a ZIKPerformRouteConfiguration as generic parameter of RoutableServiceModule:
-                            ```
-                            @objc protocol SomeServiceModuleProtocol: ZIKServiceModuleRoutable {
-
-                            }
-                            class SomeServiceRouteConfiguration: ZIKPerformRouteConfiguration, SomeServiceModuleProtocol {
+                    }
+                    class SomeClassType: NSObject, SomeServiceProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableServiceModule<SomeServiceRouteConfiguration>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableServiceModule<SomeServiceRouteConfiguration>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableServiceModule<A where A: __ObjC.ZIKPerformRouteConfiguration, A: __ObjC.ZIKServiceModuleRoutable>.init() -> ZRouter.RoutableServiceModule<A>
-                            """)
-                    } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKServiceRoutable>") || symbolName.contains(".ZIKServiceModuleRoutable>")) {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use ZIKServiceRoutable or ZIKServiceModuleRoutable as generic parameter:
-                            ```
-                            // Invalid usage
-                            RoutableService<ZIKServiceRoutable>()
-                            RoutableServiceModule<ZIKServiceModuleRoutable>()
-                            ```
-                            You should use the explicit protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<ZIKServiceRoutable>()` to `RoutableService<SomeServiceProtocol>()` or `RoutableServiceModule<ZIKServiceModuleRoutable>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
-                            """)
                     }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableService<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: serviceRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceRoutingTypeRegex) {
-                        serviceRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                    ```
+                    ```
+                    // Invalid usage
+                    RoutableService<SomeClassType>()
+                    ```
+                    You should use the protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<SomeClassType>()` to `RoutableService<SomeServiceProtocol>()`
+                    If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                    (extension in ZRouter):ZRouter.RoutableService<A where A: __ObjC.NSObject, A: __ObjC.ZIKServiceRoutable>.init() -> ZRouter.RoutableService<A>
+                    """)
+            } else if symbolName.contains(".ZIKPerformRouteConfiguration"), symbolName.contains(".ZIKServiceModuleRoutable") {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use a ZIKPerformRouteConfiguration as generic parameter of RoutableServiceModule:
+                    ```
+                    @objc protocol SomeServiceModuleProtocol: ZIKServiceModuleRoutable {
+
                     }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableServiceModule<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: serviceModuleRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceModuleRoutingTypeRegex) {
-                        serviceModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                    class SomeServiceRouteConfiguration: ZIKPerformRouteConfiguration, SomeServiceModuleProtocol {
+
                     }
-                }
+                    ```
+                    ```
+                    // Invalid usage
+                    RoutableServiceModule<SomeServiceRouteConfiguration>()
+                    ```
+                    You should use the protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableServiceModule<SomeServiceRouteConfiguration>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
+                    If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                    (extension in ZRouter):ZRouter.RoutableServiceModule<A where A: __ObjC.ZIKPerformRouteConfiguration, A: __ObjC.ZIKServiceModuleRoutable>.init() -> ZRouter.RoutableServiceModule<A>
+                    """)
+            } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKServiceRoutable>") || symbolName.contains(".ZIKServiceModuleRoutable>")) {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use ZIKServiceRoutable or ZIKServiceModuleRoutable as generic parameter:
+                    ```
+                    // Invalid usage
+                    RoutableService<ZIKServiceRoutable>()
+                    RoutableServiceModule<ZIKServiceModuleRoutable>()
+                    ```
+                    You should use the explicit protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableService<ZIKServiceRoutable>()` to `RoutableService<SomeServiceProtocol>()` or `RoutableServiceModule<ZIKServiceModuleRoutable>()` to `RoutableServiceModule<SomeServiceModuleProtocol>()`
+                    """)
             }
-            return true
         }
         
-        let destinationProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableService<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
-        let moduleProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableServiceModule<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
-        var declaredDestinationProtocols = [String]()
-        var declaredModuleProtocols = [String]()
-        for declaration in declaredRoutableTypes {
-            if let declaredProtocol = declaration.subString(forRegex: destinationProtocolRegex) {
-                declaredDestinationProtocols.append(declaredProtocol.undotted)
-            } else if let declaredProtocol = declaration.subString(forRegex: moduleProtocolRegex) {
-                declaredModuleProtocols.append(declaredProtocol.undotted)
+        if let manifest = _RoutableManifest.shared {
+            // Read symbols found at build time
+            for (signature, image) in manifest.constrainedInitializers(of: ["RoutableService", "RoutableServiceModule"]) {
+                checkConstrainedInitializer(signature, imagePath: { image })
+            }
+            declaredDestinationProtocols = manifest.declaredProtocols(of: "RoutableService")
+            declaredModuleProtocols = manifest.declaredProtocols(of: "RoutableServiceModule")
+            serviceRoutingTypes = manifest.routingTypes(of: "RoutableService")
+            serviceModuleRoutingTypes = manifest.routingTypes(of: "RoutableServiceModule")
+        } else {
+            var declaredRoutableTypes = [String]()
+            let serviceRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableService<).*(?=>$)", options: [.anchorsMatchLines])
+            let serviceModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableServiceModule<).*(?=>$)", options: [.anchorsMatchLines])
+            // Only initializers in extensions and type metadata accessors of RoutableService<Type> are checked, other symbols are not demangled
+            zix_enumerateSwiftSymbolNameContaining("RoutableService", "ZRouter", [.initializer, .typeMetadataAccessor]) { (name, demangledAsSwift) -> Bool in
+                if (strstr(name, "RoutableService") != nil) {
+                    let symbolName = demangledAsSwift(name, false)
+                    if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
+                        if symbolName.contains("(extension in ZRouter)") == false {
+                            let simplifiedName = demangledAsSwift(name, true)
+                            declaredRoutableTypes.append(simplifiedName)
+                        } else {
+                            checkConstrainedInitializer(symbolName, imagePath: { imagePathOfAddress(name) })
+                        }
+                    } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableService<") {
+                        let simplifiedName = demangledAsSwift(name, true)
+                        if let routingType = symbolName.subString(forRegex: serviceRoutingTypeRegex),
+                            let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceRoutingTypeRegex) {
+                            serviceRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                        }
+                    } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableServiceModule<") {
+                        let simplifiedName = demangledAsSwift(name, true)
+                        if let routingType = symbolName.subString(forRegex: serviceModuleRoutingTypeRegex),
+                            let simplifiedRoutingType = simplifiedName.subString(forRegex: serviceModuleRoutingTypeRegex) {
+                            serviceModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                        }
+                    }
+                }
+                return true
+            }
+            
+            let destinationProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableService<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
+            let moduleProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableServiceModule<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
+            for declaration in declaredRoutableTypes {
+                if let declaredProtocol = declaration.subString(forRegex: destinationProtocolRegex) {
+                    declaredDestinationProtocols.append(declaredProtocol.undotted)
+                } else if let declaredProtocol = declaration.subString(forRegex: moduleProtocolRegex) {
+                    declaredModuleProtocols.append(declaredProtocol.undotted)
+                }
             }
         }
         
@@ -751,7 +834,7 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         for (routingType, simplifiedName) in serviceRoutingTypes {
             var routingTypeName = routingType
             var routableProtocol: Protocol?
-            if routingTypeName.hasPrefix("__ObjC.") {
+            if routingTypeName.hasPrefix("__ObjC.") || routingTypeName.hasPrefix("__C.") {
                 routingTypeName = simplifiedName
             }
             if let objcProtocol = NSProtocolFromString(routingTypeName) {
@@ -764,7 +847,7 @@ private class _ServiceRouterValidater: ZIKServiceRouteAdapter {
         for (routingType, simplifiedName) in serviceModuleRoutingTypes {
             var routingTypeName = routingType
             var routableProtocol: Protocol?
-            if routingTypeName.hasPrefix("__ObjC.") {
+            if routingTypeName.hasPrefix("__ObjC.") || routingTypeName.hasPrefix("__C.") {
                 routingTypeName = simplifiedName
             }
             if let objcProtocol = NSProtocolFromString(routingTypeName) {
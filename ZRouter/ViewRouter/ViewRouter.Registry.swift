@@ -63,6 +63,7 @@ extension Registry {
         _addToValidateList(for: routableView, router: router)
         #endif
         viewProtocolContainer[_RouteKey(routable: routableView)] = router
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKViewRouter subclass. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -85,6 +86,7 @@ extension Registry {
         assert(router.defaultRouteConfiguration() is Protocol, "The module config protocol (\(configProtocol)) should be conformed by the router (\(router))'s defaultRouteConfiguration (\(Swift.type(of: router.defaultRouteConfiguration()))).")
         assert(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] == nil, "view config protocol (\(configProtocol)) was already registered with router (\(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)]!)).")
         viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] = router
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for view with a ZIKViewRoute. Router will check whether the registered view protocol is conformed by the registered view.
@@ -108,6 +110,7 @@ extension Registry {
         _addTovalidateList(for: routableView, route: route)
         #endif
         viewProtocolContainer[_RouteKey(routable: routableView)] = route
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     /// Register pure Swift protocol or objc protocol for your custom configuration with a ZIKViewRoute. Router will check whether the registered config protocol is conformed by the defaultRouteConfiguration of the router.
@@ -128,6 +131,7 @@ extension Registry {
         }
         assert(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] == nil, "view config protocol (\(configProtocol)) was already registered with router (\(viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)]!)).")
         viewModuleProtocolContainer[_RouteKey(routable: routableViewModule)] = route
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableView<Adapter>, forAdaptee adaptee: RoutableView<Adaptee>) {
@@ -156,6 +160,7 @@ extension Registry {
         }
         
         viewAdapterContainer[adapterKey] = adapteeKey
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static func register<Adapter, Adaptee>(adapter: RoutableViewModule<Adapter>, forAdaptee adaptee: RoutableViewModule<Adaptee>) {
@@ -184,6 +189,7 @@ extension Registry {
         }
         
         viewModuleAdapterContainer[adapterKey] = adapteeKey
+        ZIKRouteRegistry.markRegisteringRouterEager()
     }
     
     internal static func register<Protocol>(_ routableView: RoutableView<Protocol>, forMakingView destinationClass: AnyClass) {
@@ -343,9 +349,15 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The view router class for the view protocol.
     static func _router(toView viewProtocol: Any.Type, name: String) -> ZIKAnyViewRouterType? {
+        // Swift containers may still be written by +registerAllInBackground
+        ZIKRouteRegistry.waitForRegistration()
         if let routerType = _swiftRouter(toViewKey: _RouteKey(type: viewProtocol, name: name)) {
             return routerType
         }
+        // Pure Swift routes may be registered by deferred routers, or routers not registered yet from frozen route table
+        if ZIKRouteRegistry.completeRegistration(), let routerType = _swiftRouter(toViewKey: _RouteKey(type: viewProtocol, name: name)) {
+            return routerType
+        }
         if let routableProtocol = _routableViewProtocolFromObject(viewProtocol), let routerType = _ZIKViewRouterToView(routableProtocol) {
             return routerType
         }
@@ -408,9 +420,15 @@ fileprivate extension Registry {
     /// - Parameter name: The name of the protocol.
     /// - Returns: The view router class for the config protocol.
     static func _router(toViewModule configProtocol: Any.Type, name: String) -> ZIKAnyViewRouterType? {
+        // Swift containers may still be written by +registerAllInBackground
+        ZIKRouteRegistry.waitForRegistration()
         if let routerType = _swiftRouter(toViewModuleKey: _RouteKey(type: configProtocol, name: name)) {
             return routerType
         }
+        // Pure Swift routes may be registered by deferred routers, or routers not registered yet from frozen route table
+        if ZIKRouteRegistry.completeRegistration(), let routerType = _swiftRouter(toViewModuleKey: _RouteKey(type: configProtocol, name: name)) {
+            return routerType
+        }
         if let routableProtocol = _routableViewModuleProtocolFromObject(configProtocol), let routerType = _ZIKViewRouterToModule(routableProtocol) {
             return routerType
         }
@@ -504,122 +522,142 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         
         var errorDescription = ""
         // Declared protocols in extension of RoutableView and RoutableViewModule should be registered
-        var declaredRoutableTypes = [String]()
+        var declaredDestinationProtocols = [String]()
+        var declaredModuleProtocols = [String]()
         // Types in method signature used as RoutableView<Type>(), RoutableView<Type>(declaredProtocol: Type.self) and RoutableView<Type>(declaredTypeName: typeName), maybe not declared yet
         var viewRoutingTypes = [(String, String)]()
         // Types in method signature used as RoutableViewModule<Type>(), RoutableViewModule<Type>(declaredProtocol: Type.self) and RoutableViewModule<Type>(declaredTypeName: typeName), maybe not declared yet
         var viewModuleRoutingTypes = [(String, String)]()
-        let viewRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableView<).*(?=>$)", options: [.anchorsMatchLines])
-        let viewModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableViewModule<).*(?=>$)", options: [.anchorsMatchLines])
-        zix_enumerateSymbolName { (name, demangledAsSwift) -> Bool in            
-            if (strstr(name, "RoutableView") != nil) {
-                let symbolName = demangledAsSwift(name, false)
-                if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
-                    if symbolName.contains("(extension in ZRouter)") == false {
-                        let simplifiedName = demangledAsSwift(name, true)
-                        declaredRoutableTypes.append(simplifiedName)
-                    } else if symbolName.contains("." + String(describing: ViewController.self)), symbolName.contains(".ZIKViewRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use an UIViewController as generic parameter of RoutableView:
-                            ```
-                            @objc protocol SomeViewProtocol: ZIKViewRoutable {
-
-                            }
-                            class SomeViewController: \(String(describing: ViewController.self)), SomeViewProtocol {
-
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableView<SomeViewController>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeViewController>()` to `RoutableView<SomeViewProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: ViewController.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
-                            """)
-                    } else if symbolName.contains("." + String(describing: View.self)), symbolName.contains(".ZIKViewRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use an UIViewController as generic parameter of RoutableView:
-                            ```
-                            @objc protocol SomeViewProtocol: ZIKViewRoutable {
-                            
-                            }
-                            class SomeView: \(String(describing: View.self)), SomeViewProtocol {
-                            
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableView<SomeView>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeView>()` to `RoutableView<SomeViewProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: View.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
-                            """)
-                    } else if symbolName.contains(".ZIKViewRouteConfiguration"), symbolName.contains(".ZIKViewModuleRoutable") {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use a ZIKViewRouteConfiguration as generic parameter of RoutableViewModule:
-                            ```
-                            @objc protocol SomeViewModuleProtocol: ZIKViewModuleRoutable {
+        
+        // Initializers in constrained extensions of ZRouter are only used by invalid generic parameters
+        func checkConstrainedInitializer(_ symbolName: String, imagePath image: () -> String) {
+            if symbolName.contains("." + String(describing: ViewController.self)), symbolName.contains(".ZIKViewRoutable") {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use an UIViewController as generic parameter of RoutableView:
+                    ```
+                    @objc protocol SomeViewProtocol: ZIKViewRoutable {
 
-                            }
-                            class SomeViewRouteConfiguration: ZIKViewRouteConfiguration, SomeViewModuleProtocol {
+                    }
+                    class SomeViewController: \(String(describing: ViewController.self)), SomeViewProtocol {
 
-                            }
-                            ```
-                            ```
-                            // Invalid usage
-                            RoutableViewModule<SomeViewRouteConfiguration>()
-                            ```
-                            You should use the protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableViewModule<SomeViewRouteConfiguration>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
-                            If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
-                            (extension in ZRouter):ZRouter.RoutableViewModule<A where A: __ObjC.ZIKViewRouteConfiguration, A: __ObjC.ZIKViewModuleRoutable>.init() -> ZRouter.RoutableViewModule<A>
-                            """)
-                    } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKViewRoutable>") || symbolName.contains(".ZIKViewModuleRoutable>")) {
-                        let imagePath = imagePathOfAddress(name)
-                        assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
-                            Don't use ZIKViewRoutable or ZIKViewModuleRoutable as generic parameter:
-                            ```
-                            // Invalid usage
-                            RoutableView<ZIKViewRoutable>()
-                            RoutableViewModule<ZIKViewModuleRoutable>()
-                            ```
-                            You should use the explicit protocol to get its router.
-                            How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<ZIKViewRoutable>()` to `RoutableView<SomeViewProtocol>()` or `RoutableViewModule<ZIKViewModuleRoutable>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
-                            """)
                     }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableView<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: viewRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: viewRoutingTypeRegex) {
-                        viewRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                    ```
+                    ```
+                    // Invalid usage
+                    RoutableView<SomeViewController>()
+                    ```
+                    You should use the protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeViewController>()` to `RoutableView<SomeViewProtocol>()`
+                    If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                    (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: ViewController.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
+                    """)
+            } else if symbolName.contains("." + String(describing: View.self)), symbolName.contains(".ZIKViewRoutable") {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use an UIViewController as generic parameter of RoutableView:
+                    ```
+                    @objc protocol SomeViewProtocol: ZIKViewRoutable {
+                    
                     }
-                } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableViewModule<") {
-                    let simplifiedName = demangledAsSwift(name, true)
-                    if let routingType = symbolName.subString(forRegex: viewModuleRoutingTypeRegex),
-                        let simplifiedRoutingType = simplifiedName.subString(forRegex: viewModuleRoutingTypeRegex) {
-                        viewModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                    class SomeView: \(String(describing: View.self)), SomeViewProtocol {
+                    
                     }
-                }
+                    ```
+                    ```
+                    // Invalid usage
+                    RoutableView<SomeView>()
+                    ```
+                    You should use the protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<SomeView>()` to `RoutableView<SomeViewProtocol>()`
+                    If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                    (extension in ZRouter):ZRouter.RoutableView<A where A: __ObjC.\(String(describing: View.self)), A: __ObjC.ZIKViewRoutable>.init() -> ZRouter.RoutableView<A>
+                    """)
+            } else if symbolName.contains(".ZIKViewRouteConfiguration"), symbolName.contains(".ZIKViewModuleRoutable") {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use a ZIKViewRouteConfiguration as generic parameter of RoutableViewModule:
+                    ```
+                    @objc protocol SomeViewModuleProtocol: ZIKViewModuleRoutable {
+
+                    }
+                    class SomeViewRouteConfiguration: ZIKViewRouteConfiguration, SomeViewModuleProtocol {
+
+                    }
+                    ```
+                    ```
+                    // Invalid usage
+                    RoutableViewModule<SomeViewRouteConfiguration>()
+                    ```
+                    You should use the protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableViewModule<SomeViewRouteConfiguration>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
+                    If it's hard to find out the bad code, you can use `Hopper Disassembler` to analyze your app and see references to this symbol:
+                    (extension in ZRouter):ZRouter.RoutableViewModule<A where A: __ObjC.ZIKViewRouteConfiguration, A: __ObjC.ZIKViewModuleRoutable>.init() -> ZRouter.RoutableViewModule<A>
+                    """)
+            } else if symbolName.contains("where"), symbolName.contains("=="), (symbolName.contains(".ZIKViewRoutable>") || symbolName.contains(".ZIKViewModuleRoutable>")) {
+                let imagePath = image()
+                assert(imagePath.contains("/ZRouter.framework/") || !zix_hasDynamicLibrary("ZRouter"), """
+                    Don't use ZIKViewRoutable or ZIKViewModuleRoutable as generic parameter:
+                    ```
+                    // Invalid usage
+                    RoutableView<ZIKViewRoutable>()
+                    RoutableViewModule<ZIKViewModuleRoutable>()
+                    ```
+                    You should use the explicit protocol to get its router.
+                    How to resolve: search code in \((imagePath as NSString).lastPathComponent), fix `RoutableView<ZIKViewRoutable>()` to `RoutableView<SomeViewProtocol>()` or `RoutableViewModule<ZIKViewModuleRoutable>()` to `RoutableViewModule<SomeViewModuleProtocol>()`
+                    """)
             }
-            return true
         }
         
-        let destinationProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableView<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
-        let moduleProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableViewModule<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
-        var declaredDestinationProtocols = [String]()
-        var declaredModuleProtocols = [String]()
-        for declaration in declaredRoutableTypes {
-            if let declaredProtocol = declaration.subString(forRegex: destinationProtocolRegex) {
-                declaredDestinationProtocols.append(declaredProtocol.undotted)
-            } else if let declaredProtocol = declaration.subString(forRegex: moduleProtocolRegex) {
-                declaredModuleProtocols.append(declaredProtocol.undotted)
+        if let manifest = _RoutableManifest.shared {
+            // Read symbols found at build time
+            for (signature, image) in manifest.constrainedInitializers(of: ["RoutableView", "RoutableViewModule"]) {
+                checkConstrainedInitializer(signature, imagePath: { image })
+            }
+            declaredDestinationProtocols = manifest.declaredProtocols(of: "RoutableView")
+            declaredModuleProtocols = manifest.declaredProtocols(of: "RoutableViewModule")
+            viewRoutingTypes = manifest.routingTypes(of: "RoutableView")
+            viewModuleRoutingTypes = manifest.routingTypes(of: "RoutableViewModule")
+        } else {
+            var declaredRoutableTypes = [String]()
+            let viewRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableView<).*(?=>$)", options: [.anchorsMatchLines])
+            let viewModuleRoutingTypeRegex = try! NSRegularExpression(pattern: "(?<=RoutableViewModule<).*(?=>$)", options: [.anchorsMatchLines])
+            // Only initializers in extensions and type metadata accessors of RoutableView<Type> are checked, other symbols are not demangled
+            zix_enumerateSwiftSymbolNameContaining("RoutableView", "ZRouter", [.initializer, .typeMetadataAccessor]) { (name, demangledAsSwift) -> Bool in
+                if (strstr(name, "RoutableView") != nil) {
+                    let symbolName = demangledAsSwift(name, false)
+                    if symbolName.hasPrefix("(extension in"), symbolName.contains(">.init") {
+                        if symbolName.contains("(extension in ZRouter)") == false {
+                            let simplifiedName = demangledAsSwift(name, true)
+                            declaredRoutableTypes.append(simplifiedName)
+                        } else {
+                            checkConstrainedInitializer(symbolName, imagePath: { imagePathOfAddress(name) })
+                        }
+                    } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableView<") {
+                        let simplifiedName = demangledAsSwift(name, true)
+                        if let routingType = symbolName.subString(forRegex: viewRoutingTypeRegex),
+                            let simplifiedRoutingType = simplifiedName.subString(forRegex: viewRoutingTypeRegex) {
+                            viewRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                        }
+                    } else if symbolName.hasPrefix("type metadata accessor for ZRouter.RoutableViewModule<") {
+                        let simplifiedName = demangledAsSwift(name, true)
+                        if let routingType = symbolName.subString(forRegex: viewModuleRoutingTypeRegex),
+                            let simplifiedRoutingType = simplifiedName.subString(forRegex: viewModuleRoutingTypeRegex) {
+                            viewModuleRoutingTypes.append((routingType, simplifiedRoutingType.undotted))
+                        }
+                    }
+                }
+                return true
+            }
+            
+            let destinationProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableView<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
+            let moduleProtocolRegex = try! NSRegularExpression(pattern: "(?<=-> ZRouter.RoutableViewModule<)(.)*.*(?=>$)", options: [.anchorsMatchLines])
+            for declaration in declaredRoutableTypes {
+                if let declaredProtocol = declaration.subString(forRegex: destinationProtocolRegex) {
+                    declaredDestinationProtocols.append(declaredProtocol.undotted)
+                } else if let declaredProtocol = declaration.subString(forRegex: moduleProtocolRegex) {
+                    declaredModuleProtocols.append(declaredProtocol.undotted)
+                }
             }
         }
         
@@ -641,7 +679,7 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         for (routingType, simplifiedName) in viewRoutingTypes {
             var routingTypeName = routingType
             var routableProtocol: Protocol?
-            if routingTypeName.hasPrefix("__ObjC.") {
+            if routingTypeName.hasPrefix("__ObjC.") || routingTypeName.hasPrefix("__C.") {
                 routingTypeName = simplifiedName
             }
             if let objcProtocol = NSProtocolFromString(routingTypeName) {
@@ -654,7 +692,7 @@ private class _ViewRouterValidater: ZIKViewRouteAdapter {
         for (routingType, simplifiedName) in viewModuleRoutingTypes {
             var routingTypeName = routingType
             var routableProtocol: Protocol?
-            if routingTypeName.hasPrefix("__ObjC.") {
+            if routingTypeName.hasPrefix("__ObjC.") || routingTypeName.hasPrefix("__C.") {
                 routingTypeName = simplifiedName
             }
             if let objcProtocol = NSProtocolFromString(routingTypeName) {
@@ -616,7 +616,28 @@ class UtilityTests: XCTestCase {
             }
         }
     }
-    
+
+    func testRepeatedTypeChecking() {
+        // Results are cached, checking again should get the same results
+        let types: [Any] = [SwiftClass.self, SwiftSubclass.self, ObjcClass.self, ObjcSubclass.self,
+                            SwiftStruct.self, SwiftStruct(), SwiftEnum.self, type(of: SwiftStruct.self),
+                            SwiftClassProtocol.self, ObjcClassProtocol.self, ComposedProtocol.self,
+                            SwiftStructProtocol.self, (SwiftClass & ProtocolA).self, Encodable.self]
+        func check() -> [Bool] {
+            return types.flatMap { source in types.map { target in _swift_typeIsTargetType(source, target) } }
+        }
+        zix_removeCachedTypeMatches()
+        let results = check()
+        XCTAssertEqual(check(), results)
+        zix_removeCachedTypeMatches()
+        XCTAssertEqual(check(), results)
+
+        XCTAssertEqual(results[1 * types.count + 0], true) // SwiftSubclass is SwiftClass
+        XCTAssertEqual(results[0 * types.count + 1], false) // SwiftClass is not SwiftSubclass
+        XCTAssertEqual(results[4 * types.count + 11], true) // SwiftStruct is SwiftStructProtocol
+        XCTAssertEqual(results[7 * types.count + 11], false) // SwiftStruct.Type is not SwiftStructProtocol
+    }
+
     func testEnumerateDeclaredProtocol() {
         measure {
             var symbolNames = [String]()